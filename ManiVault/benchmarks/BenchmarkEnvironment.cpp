@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include "private/Core.h"
+
+#include <CoreInterface.h>
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#ifdef _DEBUG
+    //#define BENCHMARK_ENVIRONMENT_VERBOSE
+#endif
+
+using namespace mv;
+
+const std::vector<std::int64_t> BenchmarkEnvironment::pointScales = { 1'000'000, 10'000'000, 50'000'000 };
+
+BenchmarkEnvironment* BenchmarkEnvironment::current = nullptr;
+
+BenchmarkEnvironment::BenchmarkEnvironment(int& argc, char** argv) :
+    _application(),
+    _core(),
+    _cachedDatasets(),
+    _datasets()
+{
+    if (current != nullptr)
+        throw std::runtime_error("Only one benchmark environment can exist at a time");
+
+    // Run without a display server and keep the benchmark settings apart from the user settings
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QCoreApplication::setOrganizationName("BioVault");
+    QCoreApplication::setOrganizationDomain("LUMC (LKEB) & TU Delft (CGV)");
+    QCoreApplication::setApplicationName("ManiVault Benchmarks");
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts, true);
+
+    _application    = std::make_unique<Application>(argc, argv);
+    _core           = std::make_unique<Core>();
+
+    _application->setCore(_core.get());
+
+    _core->createManagers();
+    _core->initialize();
+
+    _application->initialize();
+
+    current = this;
+
+#ifdef BENCHMARK_ENVIRONMENT_VERBOSE
+    qDebug() << "ManiVault benchmark environment initialized";
+#endif
+}
+
+BenchmarkEnvironment::~BenchmarkEnvironment()
+{
+    releaseDatasets();
+
+    current = nullptr;
+}
+
+BenchmarkEnvironment& BenchmarkEnvironment::instance()
+{
+    if (current == nullptr)
+        throw std::runtime_error("No benchmark environment");
+
+    return *current;
+}
+
+Dataset<Points> BenchmarkEnvironment::getPoints(std::uint32_t numberOfPoints)
+{
+    return getCachedDataset(QString("Points/%1").arg(numberOfPoints), [numberOfPoints]() -> Dataset<DatasetImpl> {
+        std::vector<float> data(static_cast<std::size_t>(numberOfPoints) * numberOfDimensions);
+
+        std::mt19937 randomNumberEngine(numberOfPoints);
+        std::uniform_real_distribution<float> distribution(0.f, 1.f);
+
+        std::generate(data.begin(), data.end(), [&]() -> float { return distribution(randomNumberEngine); });
+
+        auto points = mv::data().createDataset<Points>("Points", QString("Benchmark points (%1)").arg(numberOfPoints));
+
+        std::vector<QString> dimensionNames;
+
+        for (std::uint32_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++)
+            dimensionNames.push_back(QString("Dimension %1").arg(dimensionIndex));
+
+        points->setData(std::move(data), numberOfDimensions);
+        points->setDimensionNames(dimensionNames);
+
+        events().notifyDatasetDataChanged(points);
+
+        return points;
+    });
+}
+
+Dataset<Points> BenchmarkEnvironment::getNestedSubset(std::uint32_t numberOfPoints)
+{
+    return getCachedDataset(QString("NestedSubset/%1").arg(numberOfPoints), [this, numberOfPoints]() -> Dataset<DatasetImpl> {
+        auto points = getPoints(numberOfPoints);
+
+        const auto createSubset = [this](Dataset<Points> source, const QString& guiName) -> Dataset<Points> {
+            std::vector<std::uint32_t> globalIndices;
+
+            source->getGlobalIndices(globalIndices);
+
+            // Select every other point of the source
+            std::vector<std::uint32_t> selectionIndices(globalIndices.size() / 2);
+
+            for (std::size_t index = 0; index < selectionIndices.size(); index++)
+                selectionIndices[index] = globalIndices[2 * index];
+
+            source->setSelectionIndices(selectionIndices);
+
+            Dataset<Points> subset = source->createSubsetFromVisibleSelection(guiName, source, false);
+
+            addDataset(subset);
+
+            return subset;
+        };
+
+        auto subset         = createSubset(points, "Benchmark subset");
+        auto nestedSubset   = createSubset(subset, "Benchmark nested subset");
+
+        points->setSelectionIndices({});
+
+        return nestedSubset;
+    });
+}
+
+Dataset<DatasetImpl> BenchmarkEnvironment::getCachedDataset(const QString& key, const std::function<Dataset<DatasetImpl>()>& create)
+{
+    if (_cachedDatasets.contains(key))
+        return _cachedDatasets[key];
+
+    auto dataset = create();
+
+    if (!_datasets.contains(dataset))
+        addDataset(dataset);
+
+    _cachedDatasets[key] = dataset;
+
+    return dataset;
+}
+
+std::vector<std::uint32_t> BenchmarkEnvironment::getRandomIndices(std::uint32_t numberOfPoints, float fraction)
+{
+    std::vector<std::uint32_t> indices;
+
+    indices.reserve(static_cast<std::size_t>(numberOfPoints * fraction) + 1);
+
+    std::mt19937 randomNumberEngine(numberOfPoints);
+    std::bernoulli_distribution distribution(fraction);
+
+    for (std::uint32_t index = 0; index < numberOfPoints; index++)
+        if (distribution(randomNumberEngine))
+            indices.push_back(index);
+
+    return indices;
+}
+
+void BenchmarkEnvironment::addDataset(const Dataset<DatasetImpl>& dataset)
+{
+    _datasets << dataset;
+}
+
+void BenchmarkEnvironment::releaseDatasets()
+{
+    _cachedDatasets.clear();
+
+    // Remove in reverse order of creation so that derived datasets and subsets go before their sources
+    for (auto it = _datasets.rbegin(); it != _datasets.rend(); ++it)
+        if (it->isValid())
+            mv::data().removeDataset(*it);
+
+    _datasets.clear();
+
+    QCoreApplication::processEvents();
+}
+
+void BenchmarkEnvironment::applyPointScales(benchmark::internal::Benchmark* benchmark)
+{
+    for (const auto& pointScale : pointScales)
+        benchmark->Arg(pointScale);
+
+    benchmark->Unit(benchmark::kMillisecond);
+}
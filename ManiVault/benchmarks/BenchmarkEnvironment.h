@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <Application.h>
+#include <Dataset.h>
+
+#include <PointData/PointData.h>
+
+#include <benchmark/benchmark.h>
+
+#include <QMap>
+#include <QString>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mv {
+    class Core;
+}
+
+/**
+ * Benchmark environment class
+ *
+ * Boots a headless ManiVault core (offscreen Qt platform, no main window) so that benchmarks exercise the
+ * same data, selection, serialization and event code paths as the application. Synthetic datasets are
+ * created on demand and cached for the lifetime of the environment, so that the (expensive) setup of
+ * multi-million point datasets is not part of the measurements.
+ *
+ * @author Thomas Kroes
+ */
+class BenchmarkEnvironment final
+{
+public:
+
+    /** Point scales at which the data benchmarks are run */
+    static const std::vector<std::int64_t> pointScales;
+
+    /** Number of dimensions of the synthetic points datasets */
+    static constexpr std::uint32_t numberOfDimensions = 4;
+
+public:
+
+    /**
+     * Construct with command line arguments (after the benchmark arguments have been removed)
+     * @param argc Number of command line arguments
+     * @param argv Command line arguments
+     */
+    BenchmarkEnvironment(int& argc, char** argv);
+
+    /** Shut down the core */
+    ~BenchmarkEnvironment();
+
+    /**
+     * Get the benchmark environment instance (only valid during the lifetime of the environment)
+     * @return Reference to the benchmark environment
+     */
+    static BenchmarkEnvironment& instance();
+
+    /**
+     * Get (and create if needed) a full points dataset with \p numberOfPoints uniformly random points
+     * @param numberOfPoints Number of points
+     * @return Points dataset
+     */
+    mv::Dataset<Points> getPoints(std::uint32_t numberOfPoints);
+
+    /**
+     * Get (and create if needed) a subset of a subset of the full points dataset with \p numberOfPoints points
+     * The first subset contains every other point, the second every other point of the first subset (both are
+     * created from the visible selection, like the data hierarchy does)
+     * @param numberOfPoints Number of points of the full dataset
+     * @return Points subset
+     */
+    mv::Dataset<Points> getNestedSubset(std::uint32_t numberOfPoints);
+
+    /**
+     * Get unique sorted random indices in [0, \p numberOfPoints)
+     * @param numberOfPoints Size of the index range
+     * @param fraction Fraction of the index range to select
+     * @return Random indices
+     */
+    static std::vector<std::uint32_t> getRandomIndices(std::uint32_t numberOfPoints, float fraction);
+
+    /**
+     * Get the dataset cached under \p key, or create it with \p create and cache it (datasets are removed by releaseDatasets())
+     * @param key Cache key
+     * @param create Creates the dataset
+     * @return Cached dataset
+     */
+    mv::Dataset<mv::DatasetImpl> getCachedDataset(const QString& key, const std::function<mv::Dataset<mv::DatasetImpl>()>& create);
+
+    /**
+     * Register \p dataset so that it is removed by releaseDatasets()
+     * @param dataset Dataset created by a benchmark
+     */
+    void addDataset(const mv::Dataset<mv::DatasetImpl>& dataset);
+
+    /** Remove all datasets created by the environment and the benchmarks */
+    void releaseDatasets();
+
+    /**
+     * Apply the point scales to \p benchmark (one argument per scale)
+     * @param benchmark Benchmark to configure
+     */
+    static void applyPointScales(benchmark::internal::Benchmark* benchmark);
+
+private:
+    std::unique_ptr<mv::Application>            _application;       /** Headless application */
+    std::unique_ptr<mv::Core>                   _core;              /** ManiVault core */
+    QMap<QString, mv::Dataset<mv::DatasetImpl>> _cachedDatasets;    /** Cached datasets by key */
+    mv::Datasets                                _datasets;          /** All datasets created by the environment (in order of creation) */
+
+    static BenchmarkEnvironment* current;       /** Current benchmark environment */
+};
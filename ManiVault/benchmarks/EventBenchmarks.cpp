@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <event/Event.h>
+#include <event/EventListener.h>
+
+#include <memory>
+#include <vector>
+
+using namespace mv;
+
+namespace
+{
+    /** Number of points of the dataset whose events are dispatched (the dispatch cost does not depend on it) */
+    constexpr std::uint32_t numberOfEventPoints = 1000;
+
+    /** Dispatch a dataset data changed event to a variable number of (additional) listeners */
+    void BM_NotifyDatasetDataChanged(benchmark::State& state)
+    {
+        auto points = BenchmarkEnvironment::instance().getPoints(numberOfEventPoints);
+
+        std::vector<std::unique_ptr<EventListener>> eventListeners;
+
+        std::uint64_t numberOfHandledEvents = 0;
+
+        for (std::int64_t listenerIndex = 0; listenerIndex < state.range(0); listenerIndex++) {
+            auto& eventListener = eventListeners.emplace_back(std::make_unique<EventListener>());
+
+            eventListener->addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetDataChanged));
+            eventListener->registerDataEvent([&numberOfHandledEvents](DatasetEvent*) -> void {
+                numberOfHandledEvents++;
+            });
+        }
+
+        for (auto _ : state)
+            events().notifyDatasetDataChanged(points);
+
+        benchmark::DoNotOptimize(numberOfHandledEvents);
+
+        state.SetItemsProcessed(state.iterations());
+        state.counters["Listeners"] = static_cast<double>(state.range(0));
+    }
+}
+
+BENCHMARK(BM_NotifyDatasetDataChanged)->RangeMultiplier(10)->Range(10, 10'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <ManiVaultVersion.h>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+/**
+ * ManiVault benchmark suite entry point
+ *
+ * Accepts all Google Benchmark command line arguments (e.g. --benchmark_filter=GlobalIndices). Unless
+ * --benchmark_out is specified, results are (also) written as JSON to mv_benchmarks.json in the working
+ * directory, so that successive runs can be collected for trend tracking.
+ */
+int main(int argc, char** argv)
+{
+    std::vector<char*> arguments(argv, argv + argc);
+
+    const auto hasOutputArgument = std::any_of(arguments.begin(), arguments.end(), [](const char* argument) -> bool {
+        return std::strncmp(argument, "--benchmark_out=", std::strlen("--benchmark_out=")) == 0;
+    });
+
+    std::string outputArgument          = "--benchmark_out=mv_benchmarks.json";
+    std::string outputFormatArgument    = "--benchmark_out_format=json";
+
+    if (!hasOutputArgument) {
+        arguments.push_back(outputArgument.data());
+        arguments.push_back(outputFormatArgument.data());
+    }
+
+    auto numberOfArguments = static_cast<int>(arguments.size());
+
+    arguments.push_back(nullptr);
+
+    benchmark::Initialize(&numberOfArguments, arguments.data());
+
+    try {
+        BenchmarkEnvironment benchmarkEnvironment(numberOfArguments, arguments.data());
+
+        benchmark::AddCustomContext("mv_version", std::to_string(MV_VERSION_MAJOR) + "." + std::to_string(MV_VERSION_MINOR) + "." + std::to_string(MV_VERSION_PATCH));
+        benchmark::AddCustomContext("mv_version_suffix", MV_VERSION_SUFFIX.data());
+
+        benchmark::RunSpecifiedBenchmarks();
+    }
+    catch (std::exception& e)
+    {
+        qCritical() << "Unable to run benchmarks:" << e.what();
+
+        return 1;
+    }
+
+    benchmark::Shutdown();
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <graphics/Vector2f.h>
+
+#include <numeric>
+#include <vector>
+
+using namespace mv;
+
+namespace
+{
+    /** Extract two dimensions of all points of a full dataset (scatterplot position update) */
+    void BM_ExtractFullDataForDimensions(benchmark::State& state)
+    {
+        auto points = BenchmarkEnvironment::instance().getPoints(static_cast<std::uint32_t>(state.range(0)));
+
+        std::vector<Vector2f> positions;
+
+        for (auto _ : state) {
+            points->extractDataForDimensions(positions, 0, 1);
+
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /** Extract two dimensions of all points of a nested subset */
+    void BM_ExtractSubsetDataForDimensions(benchmark::State& state)
+    {
+        auto subset = BenchmarkEnvironment::instance().getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        std::vector<Vector2f> positions;
+
+        for (auto _ : state) {
+            subset->extractDataForDimensions(positions, 0, 1);
+
+            benchmark::DoNotOptimize(positions.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * subset->getNumPoints());
+    }
+
+    /** Populate all dimensions of a nested subset into a flat buffer */
+    void BM_PopulateSubsetDataForDimensions(benchmark::State& state)
+    {
+        auto subset = BenchmarkEnvironment::instance().getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        std::vector<std::uint32_t> dimensionIndices(BenchmarkEnvironment::numberOfDimensions);
+        std::iota(dimensionIndices.begin(), dimensionIndices.end(), 0);
+
+        std::vector<float> data(static_cast<std::size_t>(subset->getNumPoints()) * dimensionIndices.size());
+
+        for (auto _ : state) {
+            subset->populateDataForDimensions(data, dimensionIndices);
+
+            benchmark::DoNotOptimize(data.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * subset->getNumPoints());
+    }
+
+    /** Global indices of a nested subset when the chain has changed (the global index map is rebuilt every iteration) */
+    void BM_GetGlobalIndicesCold(benchmark::State& state)
+    {
+        auto subset = BenchmarkEnvironment::instance().getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        std::vector<std::uint32_t> globalIndices;
+
+        for (auto _ : state) {
+            subset->invalidateGlobalIndexMap();
+            subset->getGlobalIndices(globalIndices);
+
+            benchmark::DoNotOptimize(globalIndices.data());
+        }
+
+        state.SetItemsProcessed(state.iterations() * subset->getNumPoints());
+    }
+
+    /** Global index map of a nested subset when the chain is unchanged (cached) */
+    void BM_GetGlobalIndexMapWarm(benchmark::State& state)
+    {
+        auto subset = BenchmarkEnvironment::instance().getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(subset->getGlobalIndexMap());
+    }
+
+    /** Local selection indices of a nested subset for a random 10% global selection */
+    void BM_GetLocalSelectionIndices(benchmark::State& state)
+    {
+        auto& environment   = BenchmarkEnvironment::instance();
+        auto points         = environment.getPoints(static_cast<std::uint32_t>(state.range(0)));
+        auto subset         = environment.getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        points->getSelection<Points>()->setIndices(BenchmarkEnvironment::getRandomIndices(points->getNumPoints(), 0.1f));
+
+        std::vector<std::uint32_t> localSelectionIndices;
+
+        for (auto _ : state) {
+            subset->getLocalSelectionIndices(localSelectionIndices);
+
+            benchmark::DoNotOptimize(localSelectionIndices.data());
+        }
+
+        points->getSelection<Points>()->setIndices({});
+
+        state.SetItemsProcessed(state.iterations() * subset->getNumPoints());
+    }
+
+    /** Invert the selection of a nested subset */
+    void BM_SelectInvert(benchmark::State& state)
+    {
+        auto& environment   = BenchmarkEnvironment::instance();
+        auto points         = environment.getPoints(static_cast<std::uint32_t>(state.range(0)));
+        auto subset         = environment.getNestedSubset(static_cast<std::uint32_t>(state.range(0)));
+
+        points->getSelection<Points>()->setIndices(BenchmarkEnvironment::getRandomIndices(points->getNumPoints(), 0.1f));
+
+        for (auto _ : state)
+            subset->selectInvert();
+
+        points->getSelection<Points>()->setIndices({});
+
+        state.SetItemsProcessed(state.iterations() * subset->getNumPoints());
+    }
+}
+
+BENCHMARK(BM_ExtractFullDataForDimensions)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_ExtractSubsetDataForDimensions)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_PopulateSubsetDataForDimensions)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_GetGlobalIndicesCold)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_GetGlobalIndexMapWarm)->Apply(BenchmarkEnvironment::applyPointScales)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GetLocalSelectionIndices)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_SelectInvert)->Apply(BenchmarkEnvironment::applyPointScales);
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <renderers/PointRasterizer.h>
+#include <renderers/PointRenderer.h>
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QSurfaceFormat>
+
+#include <random>
+#include <vector>
+
+using namespace mv;
+using namespace mv::gui;
+
+namespace
+{
+    /** Size of the rendered scatterplot images */
+    const QSize imageSize(1024, 1024);
+
+    /**
+     * Get uniformly random positions in [-1, 1] x [-1, 1]
+     * @param numberOfPoints Number of positions
+     * @return Positions
+     */
+    std::vector<Vector2f> getRandomPositions(std::uint32_t numberOfPoints)
+    {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+        std::vector<Vector2f> positions(numberOfPoints);
+
+        for (auto& position : positions)
+            position = Vector2f(distribution(generator), distribution(generator));
+
+        return positions;
+    }
+
+    /** Apply the (smaller) point scales of the render benchmarks to \p benchmark */
+    void applyRenderPointScales(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(100'000)->Arg(1'000'000)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+    }
+
+    /** Rasterize a scatterplot image on the CPU (headless batch runs) */
+    void BM_PointRasterizer(benchmark::State& state)
+    {
+        PointRasterizer pointRasterizer;
+
+        pointRasterizer.setBounds(Bounds(-1, 1, -1, 1));
+        pointRasterizer.setPointSize(10.0f);
+        pointRasterizer.setAlpha(0.5f);
+        pointRasterizer.setData(getRandomPositions(static_cast<std::uint32_t>(state.range(0))));
+
+        for (auto _ : state)
+            benchmark::DoNotOptimize(pointRasterizer.rasterize(imageSize));
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    /** Render the same scatterplot image with the point renderer into an offscreen framebuffer and read it back (reference for the rasterizer) */
+    void BM_PointRendererOpenGL(benchmark::State& state)
+    {
+        QSurfaceFormat surfaceFormat;
+
+        surfaceFormat.setVersion(3, 3);
+        surfaceFormat.setProfile(QSurfaceFormat::CoreProfile);
+
+        QOffscreenSurface offscreenSurface;
+
+        offscreenSurface.setFormat(surfaceFormat);
+        offscreenSurface.create();
+
+        QOpenGLContext openGLContext;
+
+        openGLContext.setFormat(surfaceFormat);
+
+        if (!openGLContext.create() || !openGLContext.makeCurrent(&offscreenSurface)) {
+            state.SkipWithError("No OpenGL 3.3 core context available (the offscreen platform may not support OpenGL)");
+            return;
+        }
+
+        {
+            QOpenGLFramebufferObject framebufferObject(imageSize);
+
+            framebufferObject.bind();
+
+            PointRenderer pointRenderer;
+
+            pointRenderer.init();
+            pointRenderer.resize(imageSize);
+            pointRenderer.setBounds(Bounds(-1, 1, -1, 1));
+            pointRenderer.setPointSize(10.0f);
+            pointRenderer.setAlpha(0.5f);
+            pointRenderer.setData(getRandomPositions(static_cast<std::uint32_t>(state.range(0))));
+
+            auto openGLFunctions = openGLContext.functions();
+
+            // Upload the point buffers outside of the measurement
+            pointRenderer.render();
+            openGLFunctions->glFinish();
+
+            for (auto _ : state) {
+                openGLFunctions->glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+                openGLFunctions->glClear(GL_COLOR_BUFFER_BIT);
+
+                pointRenderer.render();
+
+                benchmark::DoNotOptimize(framebufferObject.toImage());
+            }
+
+            pointRenderer.destroy();
+
+            framebufferObject.release();
+        }
+
+        openGLContext.doneCurrent();
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_PointRasterizer)->Apply(applyRenderPointScales);
+BENCHMARK(BM_PointRendererOpenGL)->Apply(applyRenderPointScales);
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <LinkedData.h>
+
+#include <ClusterData/ClusterData.h>
+
+#include <QColor>
+
+#include <vector>
+
+using namespace mv;
+
+namespace
+{
+    /** Number of source points that map to the same target point in the linked selection benchmark */
+    constexpr std::uint32_t linkedAggregation = 16;
+
+    /** Number of clusters in the cluster selection benchmark */
+    constexpr std::uint32_t numberOfClusters = 1000;
+
+    /**
+     * Get (and create if needed) a points dataset with \p numberOfPoints points that is linked to a target points dataset
+     * Each source point maps to target point (index / linkedAggregation), like pixels that are linked to super pixels
+     * @param numberOfPoints Number of source points
+     * @return Source points dataset
+     */
+    Dataset<Points> getLinkedSource(std::uint32_t numberOfPoints)
+    {
+        auto& environment = BenchmarkEnvironment::instance();
+
+        return environment.getCachedDataset(QString("LinkedSource/%1").arg(numberOfPoints), [&environment, numberOfPoints]() -> Dataset<DatasetImpl> {
+            auto source = environment.getPoints(numberOfPoints);
+            auto target = environment.getPoints(numberOfPoints / linkedAggregation);
+
+            SelectionMap selectionMap;
+
+            auto& map = selectionMap.getMap();
+
+            for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+                map.emplace_hint(map.end(), pointIndex, SelectionMap::Indices{ pointIndex / linkedAggregation });
+
+            source->addLinkedData(target, std::move(selectionMap));
+
+            return source;
+        });
+    }
+
+    /**
+     * Get (and create if needed) a clusters dataset of points with \p numberOfPoints points, point i is in cluster i % numberOfClusters
+     * @param numberOfPoints Number of points
+     * @return Clusters dataset
+     */
+    Dataset<Clusters> getClusters(std::uint32_t numberOfPoints)
+    {
+        auto& environment = BenchmarkEnvironment::instance();
+
+        return environment.getCachedDataset(QString("Clusters/%1").arg(numberOfPoints), [&environment, numberOfPoints]() -> Dataset<DatasetImpl> {
+            auto points     = environment.getPoints(numberOfPoints);
+            auto clusters   = mv::data().createDataset<Clusters>("Cluster", "Benchmark clusters", points);
+
+            std::vector<std::vector<std::uint32_t>> clusterIndices(numberOfClusters);
+
+            for (auto& indices : clusterIndices)
+                indices.reserve(numberOfPoints / numberOfClusters + 1);
+
+            for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++)
+                clusterIndices[pointIndex % numberOfClusters].push_back(pointIndex);
+
+            for (std::uint32_t clusterIndex = 0; clusterIndex < numberOfClusters; clusterIndex++) {
+                Cluster cluster(QString("Cluster %1").arg(clusterIndex), QColor::fromHsv(clusterIndex % 360, 255, 255), clusterIndices[clusterIndex]);
+
+                clusters->addCluster(cluster);
+            }
+
+            events().notifyDatasetDataChanged(clusters);
+
+            return clusters;
+        });
+    }
+
+    /** Resolve the linked selection of a random 10% source selection */
+    void BM_ResolveLinkedSelection(benchmark::State& state)
+    {
+        auto source = getLinkedSource(static_cast<std::uint32_t>(state.range(0)));
+
+        source->getSelection<Points>()->setIndices(BenchmarkEnvironment::getRandomIndices(source->getNumPoints(), 0.1f));
+
+        for (auto _ : state)
+            source->resolveLinkedData(true);
+
+        state.SetItemsProcessed(state.iterations() * source->getSelection<Points>()->getIndices().size());
+
+        source->getSelection<Points>()->setIndices({});
+    }
+
+    /** Select half of the clusters, which selects the points of those clusters (with selection events) */
+    void BM_ClusterSelection(benchmark::State& state)
+    {
+        auto clusters = getClusters(static_cast<std::uint32_t>(state.range(0)));
+
+        std::vector<std::uint32_t> clusterSelectionIndices;
+
+        for (std::uint32_t clusterIndex = 0; clusterIndex < numberOfClusters; clusterIndex += 2)
+            clusterSelectionIndices.push_back(clusterIndex);
+
+        for (auto _ : state)
+            clusters->setSelectionIndices(clusterSelectionIndices);
+
+        state.SetItemsProcessed(state.iterations() * state.range(0) / 2);
+
+        clusters->setSelectionIndices({});
+    }
+
+    /** Point scales for the linked selection benchmark (the selection map holds an entry per point) */
+    void applyLinkedSelectionScales(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->Arg(1'000'000)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+    }
+}
+
+BENCHMARK(BM_ResolveLinkedSelection)->Apply(applyLinkedSelectionScales);
+BENCHMARK(BM_ClusterSelection)->Apply(BenchmarkEnvironment::applyPointScales);
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BenchmarkEnvironment.h"
+
+#include <util/Serialization.h>
+
+#include <vector>
+
+using namespace mv;
+using namespace mv::util;
+
+namespace
+{
+    /**
+     * Get one dimension of the benchmark points as serialization input (random floats compress like real data)
+     * @param numberOfPoints Number of points
+     * @return Scalar values
+     */
+    std::vector<float> getScalars(std::uint32_t numberOfPoints)
+    {
+        std::vector<float> scalars;
+
+        BenchmarkEnvironment::instance().getPoints(numberOfPoints)->extractDataForDimension(scalars, 0);
+
+        return scalars;
+    }
+
+    /** Serialize a raw data buffer inline (compressed and base64 encoded) */
+    void BM_RawDataToVariantMap(benchmark::State& state)
+    {
+        const auto scalars          = getScalars(static_cast<std::uint32_t>(state.range(0)));
+        const auto numberOfBytes    = static_cast<std::uint64_t>(scalars.size() * sizeof(float));
+
+        for (auto _ : state) {
+            auto variantMap = rawDataToVariantMap(reinterpret_cast<const char*>(scalars.data()), numberOfBytes);
+
+            benchmark::DoNotOptimize(variantMap);
+        }
+
+        state.SetBytesProcessed(state.iterations() * numberOfBytes);
+    }
+
+    /** Deserialize a raw data buffer from an inline variant map */
+    void BM_PopulateDataBufferFromVariantMap(benchmark::State& state)
+    {
+        const auto scalars          = getScalars(static_cast<std::uint32_t>(state.range(0)));
+        const auto numberOfBytes    = static_cast<std::uint64_t>(scalars.size() * sizeof(float));
+        const auto variantMap       = rawDataToVariantMap(reinterpret_cast<const char*>(scalars.data()), numberOfBytes);
+
+        std::vector<float> output(scalars.size());
+
+        for (auto _ : state) {
+            populateDataBufferFromVariantMap(variantMap, reinterpret_cast<char*>(output.data()));
+
+            benchmark::DoNotOptimize(output.data());
+        }
+
+        if (output != scalars)
+            state.SkipWithError("Deserialized data does not match the serialized data");
+
+        state.SetBytesProcessed(state.iterations() * numberOfBytes);
+    }
+}
+
+BENCHMARK(BM_RawDataToVariantMap)->Apply(BenchmarkEnvironment::applyPointScales);
+BENCHMARK(BM_PopulateDataBufferFromVariantMap)->Apply(BenchmarkEnvironment::applyPointScales);
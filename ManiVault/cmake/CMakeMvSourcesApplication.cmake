@@ -79,11 +79,13 @@ set(PRIVATE_WORKSPACE_MANAGER_FILES
 set(PRIVATE_PLUGIN_MANAGER_HEADERS
     src/private/PluginManager.h
     src/private/PluginManagerDialog.h
+    src/private/PluginMetadataCache.h
 )
 
 set(PRIVATE_PLUGIN_MANAGER_SOURCES
     src/private/PluginManager.cpp
     src/private/PluginManagerDialog.cpp
+    src/private/PluginMetadataCache.cpp
 )
 
 set(PRIVATE_PLUGIN_MANAGER_FILES
@@ -211,6 +213,19 @@ set(PRIVATE_HELP_MANAGER_FILES
     ${PRIVATE_HELP_MANAGER_SOURCES}
 )
 
+set(PRIVATE_MEMORY_MANAGER_HEADERS
+    src/private/MemoryManager.h
+)
+
+set(PRIVATE_MEMORY_MANAGER_SOURCES
+    src/private/MemoryManager.cpp
+)
+
+set(PRIVATE_MEMORY_MANAGER_FILES
+    ${PRIVATE_MEMORY_MANAGER_HEADERS}
+    ${PRIVATE_MEMORY_MANAGER_SOURCES}
+)
+
 set(PRIVATE_MANAGER_HEADERS
     ${PRIVATE_WORKSPACE_MANAGER_HEADERS}
     ${PRIVATE_PLUGIN_MANAGER_HEADERS}
@@ -222,6 +237,7 @@ set(PRIVATE_MANAGER_HEADERS
     ${PRIVATE_SETTINGS_MANAGER_HEADERS}
     ${PRIVATE_TASK_MANAGER_HEADERS}
     ${PRIVATE_HELP_MANAGER_HEADERS}
+    ${PRIVATE_MEMORY_MANAGER_HEADERS}
 )
 
 set(PRIVATE_MANAGER_SOURCES
@@ -236,6 +252,7 @@ set(PRIVATE_MANAGER_SOURCES
     ${PRIVATE_SETTINGS_MANAGER_SOURCES}
     ${PRIVATE_TASK_MANAGER_SOURCES}
     ${PRIVATE_HELP_MANAGER_SOURCES}
+    ${PRIVATE_MEMORY_MANAGER_SOURCES}
 )
 
 set(PRIVATE_MANAGER_FILES
@@ -366,10 +383,12 @@ set(PRIVATE_LEARNING_PAGE_FILES
 
 set(PRIVATE_MISCELLANEOUS_HEADERS
     src/private/Archiver.h
+    src/private/BatchRunner.h
 )
 
 set(PRIVATE_MISCELLANEOUS_SOURCES
     src/private/Archiver.cpp
+    src/private/BatchRunner.cpp
 )
 
 set(PRIVATE_MISCELLANEOUS_FILES
@@ -420,6 +439,7 @@ source_group(Managers\\Workspace FILES ${PRIVATE_WORKSPACE_MANAGER_FILES})
 source_group(Managers\\Settings FILES ${PRIVATE_SETTINGS_MANAGER_FILES})
 source_group(Managers\\Task FILES ${PRIVATE_TASK_MANAGER_FILES})
 source_group(Managers\\Help FILES ${PRIVATE_HELP_MANAGER_FILES})
+source_group(Managers\\Memory FILES ${PRIVATE_MEMORY_MANAGER_FILES})
 source_group(Pages\\Common FILES ${PRIVATE_PAGES_COMMON_FILES})
 source_group(Pages\\StartPage FILES ${PRIVATE_START_PAGE_FILES})
 source_group(Pages\\Learning FILES ${PRIVATE_LEARNING_PAGE_FILES})
@@ -16,6 +16,7 @@ set(PUBLIC_CORE_INTERFACE_HEADERS
     src/AbstractSettingsManager.h
     src/AbstractTaskManager.h
     src/AbstractHelpManager.h
+    src/AbstractMemoryManager.h
 )
 
 set(PUBLIC_CORE_INTERFACE_SOURCES
@@ -458,12 +459,14 @@ set(PUBLIC_WIDGETS_INTERNAL_FILES
 set(PUBLIC_RENDERERS_HEADERS
     src/renderers/Renderer.h
     src/renderers/PointRenderer.h
+    src/renderers/PointRasterizer.h
     src/renderers/DensityRenderer.h
     src/renderers/ImageRenderer.h
 )
 
 set(PUBLIC_RENDERERS_SOURCES
     src/renderers/PointRenderer.cpp
+    src/renderers/PointRasterizer.cpp
     src/renderers/DensityRenderer.cpp
     src/renderers/ImageRenderer.cpp
 )
@@ -509,6 +512,11 @@ set(PUBLIC_UTIL_HEADERS
     src/util/Exception.h
     src/util/Math.h
     src/util/Timer.h
+    src/util/Trace.h
+    src/util/MpscRingBuffer.h
+    src/util/MemoryAccounting.h
+    src/util/DerivedDataCache.h
+    src/util/Spillable.h
     src/util/Icon.h
     src/util/IconFont.h
     src/util/IconFonts.h
@@ -520,6 +528,9 @@ set(PUBLIC_UTIL_HEADERS
     src/util/ColorSpace.h
     src/util/PixelSelectionTool.h
     src/util/PixelSelection.h
+    src/util/SpatialIndex2D.h
+    src/util/Histogram.h
+    src/util/DualHistogram.h
     src/util/Preset.h
     src/util/PresetsModel.h
     src/util/PresetsFilterModel.h
@@ -562,6 +573,10 @@ set(PUBLIC_UTIL_SOURCES
     src/util/Exception.cpp
     src/util/Math.cpp
     src/util/Timer.cpp
+    src/util/Trace.cpp
+    src/util/MemoryAccounting.cpp
+    src/util/DerivedDataCache.cpp
+    src/util/Spillable.cpp
     src/util/Icon.cpp
     src/util/IconFont.cpp
     src/util/IconFonts.cpp
@@ -573,6 +588,9 @@ set(PUBLIC_UTIL_SOURCES
     src/util/ColorSpace.cpp
     src/util/PixelSelectionTool.cpp
     src/util/PixelSelection.cpp
+    src/util/SpatialIndex2D.cpp
+    src/util/Histogram.cpp
+    src/util/DualHistogram.cpp
     src/util/Preset.cpp
     src/util/PresetsModel.cpp
     src/util/PresetsFilterModel.cpp
@@ -949,6 +967,7 @@ set(PUBLIC_GLOBAL_SETTINGS_HEADERS
     src/TasksSettingsAction.h
     src/ApplicationSettingsAction.h
     src/TemporaryDirectoriesSettingsAction.h
+    src/MemorySettingsAction.h
     src/PluginGlobalSettingsGroupAction.h
 )
 
@@ -959,6 +978,7 @@ set(PUBLIC_GLOBAL_SETTINGS_SOURCES
     src/TasksSettingsAction.cpp
     src/ApplicationSettingsAction.cpp
     src/TemporaryDirectoriesSettingsAction.cpp
+    src/MemorySettingsAction.cpp
     src/PluginGlobalSettingsGroupAction.cpp
 )
 
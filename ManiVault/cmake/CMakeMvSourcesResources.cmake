@@ -25,6 +25,8 @@ set(SHADERS
     res/shaders/Color.frag
     res/shaders/DensityCompute.frag
     res/shaders/DensityCompute.vert
+    res/shaders/DensityComputeLabels.frag
+    res/shaders/DensityComputeLabels.vert
     res/shaders/DensityDraw.frag
     res/shaders/GradientCompute.frag
     res/shaders/GradientDraw.frag
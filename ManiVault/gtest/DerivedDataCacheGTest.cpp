@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <util/DerivedDataCache.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <cstdint>
+#include <vector>
+
+using mv::util::DerivedDataCache;
+
+namespace
+{
+    /** Create \p numberOfBytes bytes of artefact data which depend on \p seed */
+    QByteArray createData(qsizetype numberOfBytes, char seed = 0)
+    {
+        QByteArray data(numberOfBytes, Qt::Uninitialized);
+
+        for (qsizetype byteIndex = 0; byteIndex < numberOfBytes; ++byteIndex)
+            data[byteIndex] = static_cast<char>(byteIndex * 31 + seed);
+
+        return data;
+    }
+
+    /** Stores artefacts in a temporary directory and restores the default cache settings afterwards */
+    class DerivedDataCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(_cacheDirectory.isValid());
+
+            DerivedDataCache::setDirectory(_cacheDirectory.path());
+        }
+
+        void TearDown() override
+        {
+            DerivedDataCache::clear();
+            DerivedDataCache::setDirectory({});
+            DerivedDataCache::setEnabled(true);
+            DerivedDataCache::setMaximumSize(DerivedDataCache::defaultMaximumSize);
+        }
+
+        /** Get the file path of the artefact with \p key */
+        QString getArtefactFilePath(const QString& key) const
+        {
+            return QDir(_cacheDirectory.path()).filePath(key + ".mvdc");
+        }
+
+        /** Set the last modification time of the artefact with \p key to \p secondsAgo seconds ago */
+        void touchArtefact(const QString& key, std::int32_t secondsAgo) const
+        {
+            QFile artefactFile(getArtefactFilePath(key));
+
+            ASSERT_TRUE(artefactFile.open(QIODevice::ReadWrite));
+            ASSERT_TRUE(artefactFile.setFileTime(QDateTime::currentDateTime().addSecs(-secondsAgo), QFileDevice::FileModificationTime));
+        }
+
+        QTemporaryDir   _cacheDirectory;    /** Directory of the cached artefacts */
+    };
+}
+
+TEST(DerivedDataCache, computesContentHashesOverAllBlocks)
+{
+    // Spans multiple (parallel hashed) blocks with a partial last block
+    const auto numberOfBytes = 2 * DerivedDataCache::contentHashBlockSize + 13;
+
+    std::vector<unsigned char> data(numberOfBytes);
+
+    for (std::size_t byteIndex = 0; byteIndex < numberOfBytes; ++byteIndex)
+        data[byteIndex] = static_cast<unsigned char>(byteIndex * 7);
+
+    const auto contentHash = DerivedDataCache::computeContentHash(data.data(), data.size());
+
+    EXPECT_EQ(contentHash.size(), 32);
+    EXPECT_EQ(contentHash, DerivedDataCache::computeContentHash(data.data(), data.size()));
+
+    // A change in any block (including the last partial one) or of the size changes the content hash
+    for (const auto byteIndex : { std::size_t{ 0 }, DerivedDataCache::contentHashBlockSize + 5, numberOfBytes - 1 }) {
+        auto changedData = data;
+
+        changedData[byteIndex] ^= 1;
+
+        EXPECT_NE(contentHash, DerivedDataCache::computeContentHash(changedData.data(), changedData.size())) << "at byte " << byteIndex;
+    }
+
+    EXPECT_NE(contentHash, DerivedDataCache::computeContentHash(data.data(), data.size() - 1));
+}
+
+TEST(DerivedDataCache, createsKeysFromProducerParametersAndInput)
+{
+    const auto inputHash    = DerivedDataCache::computeContentHash("input", 5);
+    const auto key          = DerivedDataCache::createKey("Producer", { { "Parameter", 1 } }, inputHash);
+
+    EXPECT_EQ(key, DerivedDataCache::createKey("Producer", { { "Parameter", 1 } }, inputHash));
+    EXPECT_NE(key, DerivedDataCache::createKey("Other producer", { { "Parameter", 1 } }, inputHash));
+    EXPECT_NE(key, DerivedDataCache::createKey("Producer", { { "Parameter", 2 } }, inputHash));
+    EXPECT_NE(key, DerivedDataCache::createKey("Producer", { { "Parameter", 1 } }, DerivedDataCache::computeContentHash("other", 5)));
+}
+
+TEST_F(DerivedDataCacheTest, storesAndLoadsArtefacts)
+{
+    const auto data = createData(1000);
+
+    QByteArray loadedData;
+
+    EXPECT_FALSE(DerivedDataCache::load("artefact", loadedData));
+    ASSERT_TRUE(DerivedDataCache::store("artefact", data));
+    ASSERT_TRUE(DerivedDataCache::load("artefact", loadedData));
+    EXPECT_EQ(loadedData, data);
+
+    loadedData.clear();
+
+    ASSERT_TRUE(DerivedDataCache::load("artefact", loadedData, 1000));
+    EXPECT_EQ(loadedData, data);
+    EXPECT_GT(DerivedDataCache::getSize(), 1000u);
+
+    DerivedDataCache::remove("artefact");
+
+    EXPECT_FALSE(DerivedDataCache::load("artefact", loadedData));
+    EXPECT_EQ(DerivedDataCache::getSize(), 0u);
+}
+
+TEST_F(DerivedDataCacheTest, rejectsArtefactsOfAnotherSize)
+{
+    ASSERT_TRUE(DerivedDataCache::store("artefact", createData(1000)));
+
+    QByteArray loadedData;
+
+    EXPECT_FALSE(DerivedDataCache::load("artefact", loadedData, 1200));
+    EXPECT_TRUE(loadedData.isEmpty());
+
+    // The mismatching artefact is removed, so that it is recomputed (and stored) by the consumer
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("artefact")));
+    EXPECT_FALSE(DerivedDataCache::load("artefact", loadedData));
+}
+
+TEST_F(DerivedDataCacheTest, rejectsCorruptArtefacts)
+{
+    ASSERT_TRUE(DerivedDataCache::store("corrupt", createData(1000)));
+    ASSERT_TRUE(DerivedDataCache::store("truncated", createData(1000)));
+
+    {
+        QFile artefactFile(getArtefactFilePath("corrupt"));
+
+        ASSERT_TRUE(artefactFile.open(QIODevice::ReadWrite));
+
+        auto contents = artefactFile.readAll();
+
+        contents[contents.size() - 10] = static_cast<char>(contents[contents.size() - 10] ^ 0x40);
+
+        ASSERT_TRUE(artefactFile.seek(0));
+        ASSERT_EQ(artefactFile.write(contents), contents.size());
+    }
+
+    {
+        QFile artefactFile(getArtefactFilePath("truncated"));
+
+        ASSERT_TRUE(artefactFile.resize(artefactFile.size() - 100));
+    }
+
+    QByteArray loadedData;
+
+    EXPECT_FALSE(DerivedDataCache::load("corrupt", loadedData));
+    EXPECT_FALSE(DerivedDataCache::load("truncated", loadedData));
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("corrupt")));
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("truncated")));
+}
+
+TEST_F(DerivedDataCacheTest, evictsLeastRecentlyUsedArtefacts)
+{
+    // Room for two artefacts (and their headers), but not for three
+    DerivedDataCache::setMaximumSize(2200);
+
+    ASSERT_TRUE(DerivedDataCache::store("first", createData(1000, 1)));
+    ASSERT_TRUE(DerivedDataCache::store("second", createData(1000, 2)));
+
+    touchArtefact("first", 20);
+    touchArtefact("second", 10);
+
+    // Loading the first artefact makes the second one the least recently used
+    QByteArray loadedData;
+
+    ASSERT_TRUE(DerivedDataCache::load("first", loadedData));
+    ASSERT_TRUE(DerivedDataCache::store("third", createData(1000, 3)));
+
+    EXPECT_TRUE(QFile::exists(getArtefactFilePath("first")));
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("second")));
+    EXPECT_TRUE(QFile::exists(getArtefactFilePath("third")));
+    EXPECT_LE(DerivedDataCache::getSize(), DerivedDataCache::getMaximumSize());
+
+    // Artefacts which exceed the maximum size on their own are not stored
+    EXPECT_FALSE(DerivedDataCache::store("fourth", createData(3000)));
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("fourth")));
+}
+
+TEST_F(DerivedDataCacheTest, neitherLoadsNorStoresWhenDisabled)
+{
+    ASSERT_TRUE(DerivedDataCache::store("artefact", createData(100)));
+
+    DerivedDataCache::setEnabled(false);
+
+    QByteArray loadedData;
+
+    EXPECT_FALSE(DerivedDataCache::isEnabled());
+    EXPECT_FALSE(DerivedDataCache::load("artefact", loadedData));
+    EXPECT_FALSE(DerivedDataCache::store("other", createData(100)));
+    EXPECT_FALSE(QFile::exists(getArtefactFilePath("other")));
+
+    DerivedDataCache::setEnabled(true);
+
+    EXPECT_TRUE(DerivedDataCache::load("artefact", loadedData));
+}
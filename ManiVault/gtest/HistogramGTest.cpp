@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The files to be tested:
+#include <util/DualHistogram.h>
+#include <util/Histogram.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using mv::util::DualHistogram;
+using mv::util::Histogram;
+
+namespace
+{
+    constexpr std::uint32_t numberOfValues = 200000;
+
+    /** Deterministic value at \p index in [-1, 11), so that some values are outside the [0, 10] range of the tests */
+    float getValue(std::size_t index)
+    {
+        return static_cast<float>((index * 7919) % 1200) / 100.f - 1.f;
+    }
+
+    /** Get the bins of a histogram with \p numberOfBins over [0, 10] of the values at \p indices, counted one by one */
+    Histogram::Bins countValues(std::uint32_t numberOfBins, const std::vector<std::uint32_t>& indices)
+    {
+        Histogram histogram(numberOfBins, 0.f, 10.f);
+
+        for (const auto index : indices)
+            histogram.add(getValue(index));
+
+        return histogram.getBins();
+    }
+
+    /** Get every \p step th index in [\p first, \p last) */
+    std::vector<std::uint32_t> getIndices(std::uint32_t first, std::uint32_t last, std::uint32_t step = 1)
+    {
+        std::vector<std::uint32_t> indices;
+
+        for (auto index = first; index < last; index += step)
+            indices.push_back(index);
+
+        return indices;
+    }
+}
+
+TEST(Histogram, countsValuesInRangeOnly)
+{
+    Histogram histogram(4, 0.f, 4.f);
+
+    for (const auto value : { 0.f, 1.5f, 3.9f, 4.f, -0.1f, 4.1f, std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity() })
+        histogram.add(value);
+
+    // The maximum is counted in the last bin, values outside the range (and NaN) are not counted
+    EXPECT_EQ(histogram.getBins(), Histogram::Bins({ 1, 1, 0, 2 }));
+    EXPECT_EQ(histogram.getBinIndex(-0.1f), histogram.getNumberOfBins());
+    EXPECT_EQ(histogram.getBinIndex(std::numeric_limits<float>::quiet_NaN()), histogram.getNumberOfBins());
+}
+
+TEST(Histogram, addValuesMatchesAddingOneByOne)
+{
+    Histogram histogram(32, 0.f, 10.f);
+
+    histogram.addValues(numberOfValues, getValue);
+
+    EXPECT_EQ(histogram.getBins(), countValues(32, getIndices(0, numberOfValues)));
+}
+
+TEST(Histogram, removeClampsAtZero)
+{
+    Histogram histogram(4, 0.f, 4.f);
+
+    histogram.add(0.5f);
+    histogram.add(0.5f);
+
+    histogram.remove(0.5f);
+
+    EXPECT_EQ(histogram.getBins(), Histogram::Bins({ 1, 0, 0, 0 }));
+
+    // Removing from an empty bin and removing values outside the range leave the counts unchanged
+    histogram.remove(2.5f);
+    histogram.remove(-1.f);
+    histogram.remove(5.f);
+    histogram.remove(std::numeric_limits<float>::quiet_NaN());
+
+    EXPECT_EQ(histogram.getBins(), Histogram::Bins({ 1, 0, 0, 0 }));
+
+    histogram.remove(0.5f);
+    histogram.remove(0.5f);
+
+    EXPECT_EQ(histogram.getBins(), Histogram::Bins({ 0, 0, 0, 0 }));
+}
+
+TEST(DualHistogram, computesAllAndSelectedValues)
+{
+    const auto selectionIndices = getIndices(0, numberOfValues, 3);
+
+    DualHistogram dualHistogram(16, 0.f, 10.f);
+
+    dualHistogram.compute(numberOfValues, selectionIndices, getValue);
+
+    EXPECT_EQ(dualHistogram.getAll().getBins(), countValues(16, getIndices(0, numberOfValues)));
+    EXPECT_EQ(dualHistogram.getSelected().getBins(), countValues(16, selectionIndices));
+}
+
+TEST(DualHistogram, updateSelectionMatchesRecomputing)
+{
+    const auto previousSelectionIndices = getIndices(0, numberOfValues, 2);
+
+    // Small delta (applied value by value): grow and shrink the selection at both ends, including out-of-range values
+    auto selectionIndices = getIndices(1000, numberOfValues - 1000, 2);
+
+    for (const auto index : getIndices(1, 200, 2))
+        selectionIndices.insert(std::lower_bound(selectionIndices.begin(), selectionIndices.end(), index), index);
+
+    DualHistogram dualHistogram(16, 0.f, 10.f);
+
+    dualHistogram.compute(numberOfValues, previousSelectionIndices, getValue);
+    dualHistogram.updateSelection(previousSelectionIndices, selectionIndices, getValue);
+
+    EXPECT_EQ(dualHistogram.getSelected().getBins(), countValues(16, selectionIndices));
+
+    // Large delta (recomputed)
+    const auto otherSelectionIndices = getIndices(1, 1000, 2);
+
+    dualHistogram.updateSelection(selectionIndices, otherSelectionIndices, getValue);
+
+    EXPECT_EQ(dualHistogram.getSelected().getBins(), countValues(16, otherSelectionIndices));
+
+    // Empty selection
+    dualHistogram.updateSelection(otherSelectionIndices, {}, getValue);
+
+    EXPECT_EQ(dualHistogram.getSelected().getBins(), Histogram::Bins(16, 0));
+
+    // The histogram of all values is not affected by the selection
+    EXPECT_EQ(dualHistogram.getAll().getBins(), countValues(16, getIndices(0, numberOfValues)));
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <util/MeanShift.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using mv::MeanShift;
+using mv::Vector2f;
+
+namespace
+{
+    constexpr std::uint32_t numberOfPointsPerBlob = 1000;
+
+    /**
+     * Create two separated blobs of points (deterministic spirals which fill a disk of radius one, centered at x = -5 and x = 5)
+     * @return Points of the left blob followed by the points of the right blob
+     */
+    std::vector<Vector2f> createTwoBlobs()
+    {
+        std::vector<Vector2f> points;
+
+        points.reserve(2 * numberOfPointsPerBlob);
+
+        for (const auto centerX : { -5.f, 5.f }) {
+            for (std::uint32_t pointIndex = 0; pointIndex < numberOfPointsPerBlob; ++pointIndex) {
+                const auto radius   = std::sqrt((pointIndex + 0.5f) / numberOfPointsPerBlob);
+                const auto angle    = pointIndex * 2.39996323f;
+
+                points.emplace_back(centerX + radius * std::cos(angle), radius * std::sin(angle));
+            }
+        }
+
+        return points;
+    }
+
+    /** Cluster \p points with the CPU backend at \p resolution */
+    std::vector<std::vector<unsigned int>> cluster(const std::vector<Vector2f>& points, std::uint32_t resolution)
+    {
+        MeanShift meanShift;
+
+        meanShift.setBackend(MeanShift::Backend::CPU);
+        meanShift.setResolution(resolution);
+        meanShift.setData(&points);
+
+        std::vector<std::vector<unsigned int>> clusters;
+
+        meanShift.cluster(points, clusters);
+
+        return clusters;
+    }
+
+    /** Get the point indices of the blob which starts at \p firstPointIndex */
+    std::vector<unsigned int> getBlobIndices(unsigned int firstPointIndex)
+    {
+        std::vector<unsigned int> blobIndices(numberOfPointsPerBlob);
+
+        std::iota(blobIndices.begin(), blobIndices.end(), firstPointIndex);
+
+        return blobIndices;
+    }
+}
+
+TEST(MeanShift, twoSeparatedBlobsGiveTwoModes)
+{
+    const auto points   = createTwoBlobs();
+    const auto clusters = cluster(points, MeanShift::defaultResolution);
+
+    ASSERT_EQ(clusters.size(), 2u);
+
+    // Clusters are numbered in the order of their first point
+    EXPECT_EQ(clusters[0], getBlobIndices(0));
+    EXPECT_EQ(clusters[1], getBlobIndices(numberOfPointsPerBlob));
+}
+
+TEST(MeanShift, assignsPointsStablyAtNonDefaultResolution)
+{
+    constexpr std::uint32_t resolution = 100;
+
+    const auto points = createTwoBlobs();
+
+    MeanShift meanShift;
+
+    meanShift.setBackend(MeanShift::Backend::CPU);
+    meanShift.setResolution(resolution);
+    meanShift.setData(&points);
+
+    ASSERT_EQ(meanShift.getResolution(), resolution);
+
+    std::vector<std::vector<unsigned int>> clusters;
+
+    meanShift.cluster(points, clusters);
+
+    ASSERT_EQ(clusters.size(), 2u);
+
+    EXPECT_EQ(clusters[0], getBlobIndices(0));
+    EXPECT_EQ(clusters[1], getBlobIndices(numberOfPointsPerBlob));
+
+    // Clustering again (with the same and with another instance) assigns every point to the same cluster
+    std::vector<std::vector<unsigned int>> clustersAgain;
+
+    meanShift.cluster(points, clustersAgain);
+
+    EXPECT_EQ(clustersAgain, clusters);
+    EXPECT_EQ(cluster(points, resolution), clusters);
+}
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <private/PluginMetadataCache.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+using mv::PluginMetadataCache;
+
+namespace
+{
+    /** Provides a (dummy) plugin file and a cache file in a temporary directory */
+    class PluginMetadataCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ASSERT_TRUE(_directory.isValid());
+
+            _pluginFilePath = QDir(_directory.path()).filePath("Plugin.dll");
+            _cacheFilePath  = QDir(_directory.path()).filePath("PluginMetadataCache.json");
+
+            writePluginFile("plugin");
+            setPluginFileLastModified(QDateTime::currentDateTime().addSecs(-60));
+        }
+
+        /** Overwrite the dummy plugin file with \p contents */
+        void writePluginFile(const QByteArray& contents) const
+        {
+            QFile pluginFile(_pluginFilePath);
+
+            ASSERT_TRUE(pluginFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            ASSERT_EQ(pluginFile.write(contents), contents.size());
+        }
+
+        /** Set the last modification time of the dummy plugin file to \p lastModified */
+        void setPluginFileLastModified(const QDateTime& lastModified) const
+        {
+            QFile pluginFile(_pluginFilePath);
+
+            ASSERT_TRUE(pluginFile.open(QIODevice::ReadWrite));
+            ASSERT_TRUE(pluginFile.setFileTime(lastModified, QFileDevice::FileModificationTime));
+        }
+
+        QTemporaryDir   _directory;         /** Directory of the dummy plugin and the cache file */
+        QString         _pluginFilePath;    /** Location of the dummy plugin file */
+        QString         _cacheFilePath;     /** Location of the persisted cache file */
+    };
+}
+
+TEST_F(PluginMetadataCacheTest, servesMetaDataFromTheCache)
+{
+    PluginMetadataCache pluginMetadataCache;
+
+    // The dummy file is not a plugin, so its metadata is empty (but cached nonetheless)
+    EXPECT_TRUE(pluginMetadataCache.getMetaData(_pluginFilePath).isEmpty());
+    EXPECT_TRUE(pluginMetadataCache.getMetaData(_pluginFilePath).isEmpty());
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 1u);
+    EXPECT_EQ(pluginMetadataCache.getNumberOfHits(), 1u);
+}
+
+TEST_F(PluginMetadataCacheTest, invalidatesEntriesWhenThePluginChanges)
+{
+    PluginMetadataCache pluginMetadataCache;
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+    pluginMetadataCache.setFactoryTraits(_pluginFilePath, { 2, false });
+
+    ASSERT_TRUE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    // Same size, other last modified time
+    setPluginFileLastModified(QDateTime::currentDateTime().addSecs(-30));
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 2u);
+
+    // Re-reading the metadata does not restore the traits of the previous library
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.setFactoryTraits(_pluginFilePath, { 2, false });
+
+    // Other size, same last modified time
+    const auto lastModified = QFileInfo(_pluginFilePath).lastModified();
+
+    writePluginFile("changed plugin");
+    setPluginFileLastModified(lastModified);
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 3u);
+
+    // Removed plugin
+    ASSERT_TRUE(QFile::remove(_pluginFilePath));
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+}
+
+TEST_F(PluginMetadataCacheTest, persistsEntriesAndFactoryTraits)
+{
+    {
+        PluginMetadataCache pluginMetadataCache(_cacheFilePath);
+
+        PluginMetadataCache::FactoryTraits factoryTraits;
+
+        factoryTraits._type                         = 3;
+        factoryTraits._hasStatusBarAction           = true;
+        factoryTraits._guiName                      = "Plugin";
+        factoryTraits._icon                         = QByteArray("\x89PNG\r\n\x1a\n", 8);
+        factoryTraits._readmeMarkdownUrl            = "https://example.org/README.md";
+        factoryTraits._producesSystemViewPlugins    = true;
+        factoryTraits._preferredDockArea            = 2;
+
+        pluginMetadataCache.load();
+        pluginMetadataCache.getMetaData(_pluginFilePath);
+        pluginMetadataCache.setFactoryTraits(_pluginFilePath, factoryTraits);
+        pluginMetadataCache.save();
+    }
+
+    ASSERT_TRUE(QFile::exists(_cacheFilePath));
+
+    PluginMetadataCache pluginMetadataCache(_cacheFilePath);
+
+    pluginMetadataCache.load();
+
+    const auto factoryTraits = pluginMetadataCache.getFactoryTraits(_pluginFilePath);
+
+    EXPECT_EQ(factoryTraits._type, 3);
+    EXPECT_TRUE(factoryTraits._hasStatusBarAction);
+    EXPECT_EQ(factoryTraits._guiName, "Plugin");
+    EXPECT_EQ(factoryTraits._icon, QByteArray("\x89PNG\r\n\x1a\n", 8));
+    EXPECT_TRUE(factoryTraits._repositoryUrl.isEmpty());
+    EXPECT_EQ(factoryTraits._readmeMarkdownUrl, "https://example.org/README.md");
+    EXPECT_TRUE(factoryTraits._allowPluginCreationFromStandardGui);
+    EXPECT_TRUE(factoryTraits._producesSystemViewPlugins);
+    EXPECT_EQ(factoryTraits._preferredDockArea, 2);
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfHits(), 1u);
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 0u);
+
+    // A plugin which changed between two runs is read again
+    writePluginFile("changed plugin");
+
+    pluginMetadataCache.load();
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 1u);
+}
+
+TEST_F(PluginMetadataCacheTest, discardsMalformedCaches)
+{
+    {
+        QFile cacheFile(_cacheFilePath);
+
+        ASSERT_TRUE(cacheFile.open(QIODevice::WriteOnly));
+        ASSERT_GT(cacheFile.write("{ malformed"), 0);
+    }
+
+    PluginMetadataCache pluginMetadataCache(_cacheFilePath);
+
+    pluginMetadataCache.load();
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 1u);
+}
+
+TEST_F(PluginMetadataCacheTest, ignoresFactoryTraitsOfUnknownPlugins)
+{
+    PluginMetadataCache pluginMetadataCache;
+
+    // No entry yet (the metadata has not been requested)
+    pluginMetadataCache.setFactoryTraits(_pluginFilePath, { 2, false });
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    // Stale entry
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    writePluginFile("changed plugin");
+
+    pluginMetadataCache.setFactoryTraits(_pluginFilePath, { 2, false });
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+}
+
+TEST_F(PluginMetadataCacheTest, prunesUninstalledPlugins)
+{
+    PluginMetadataCache pluginMetadataCache;
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+    pluginMetadataCache.setFactoryTraits(_pluginFilePath, { 2, false });
+    pluginMetadataCache.prune({ _pluginFilePath });
+
+    EXPECT_TRUE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.prune({});
+
+    EXPECT_FALSE(pluginMetadataCache.getFactoryTraits(_pluginFilePath).isValid());
+
+    pluginMetadataCache.getMetaData(_pluginFilePath);
+
+    EXPECT_EQ(pluginMetadataCache.getNumberOfMisses(), 2u);
+}
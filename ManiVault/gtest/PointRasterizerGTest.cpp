@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <renderers/PointRasterizer.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+using mv::Bounds;
+using mv::Vector2f;
+using mv::Vector3f;
+using mv::gui::PointEffect;
+using mv::gui::PointRasterizer;
+using mv::gui::PointSelectionDisplayMode;
+
+namespace
+{
+    /** Width and height of the test images (two by two tiles), the view bounds [-1, 1] map onto the whole image */
+    constexpr std::int32_t imageSize = 2 * PointRasterizer::tileSize;
+
+    /** Get a rasterizer with opaque points of \p pointSize pixels at \p positions (without selection outlines) */
+    PointRasterizer createRasterizer(const std::vector<Vector2f>& positions, float pointSize = 16.0f)
+    {
+        PointRasterizer pointRasterizer;
+
+        pointRasterizer.setBounds(Bounds(-1, 1, -1, 1));
+        pointRasterizer.setSelectionDisplayMode(PointSelectionDisplayMode::Override);
+        pointRasterizer.setPointSize(pointSize);
+        pointRasterizer.setAlpha(1.0f);
+        pointRasterizer.setData(positions);
+
+        return pointRasterizer;
+    }
+
+    /** Get the number of pixels of \p image which are covered for at least half */
+    std::int32_t getNumberOfCoveredPixels(const QImage& image)
+    {
+        std::int32_t numberOfCoveredPixels = 0;
+
+        for (std::int32_t y = 0; y < image.height(); y++)
+            for (std::int32_t x = 0; x < image.width(); x++)
+                if (qAlpha(image.pixel(x, y)) >= 128)
+                    numberOfCoveredPixels++;
+
+        return numberOfCoveredPixels;
+    }
+
+    /** Expect that \p image covers a disc of \p radius pixels (give or take the anti-aliased rim) */
+    void expectDiscArea(const QImage& image, float radius, float fraction = 1.0f)
+    {
+        const auto expectedArea = fraction * std::numbers::pi_v<float> * radius * radius;
+        const auto tolerance    = fraction * 2.0f * std::numbers::pi_v<float> * radius;
+
+        EXPECT_NEAR(static_cast<float>(getNumberOfCoveredPixels(image)), expectedArea, tolerance) << "radius " << radius;
+    }
+}
+
+TEST(PointRasterizer, returnsANullImageForAnEmptySize)
+{
+    EXPECT_TRUE(createRasterizer({ Vector2f(0, 0) }).rasterize(QSize(0, imageSize)).isNull());
+}
+
+TEST(PointRasterizer, clearsToTheBackgroundColor)
+{
+    const auto image = createRasterizer({}).rasterize(QSize(imageSize + 3, imageSize - 5), QColor(255, 0, 0, 255));
+
+    ASSERT_EQ(image.size(), QSize(imageSize + 3, imageSize - 5));
+    ASSERT_EQ(image.format(), QImage::Format_ARGB32_Premultiplied);
+
+    for (std::int32_t y = 0; y < image.height(); y++)
+        for (std::int32_t x = 0; x < image.width(); x++)
+            ASSERT_EQ(image.pixel(x, y), qRgba(255, 0, 0, 255)) << "at " << x << ", " << y;
+}
+
+TEST(PointRasterizer, coversTheAreaOfThePointSize)
+{
+    for (const auto pointSize : { 8.0f, 16.0f, 32.0f }) {
+        expectDiscArea(createRasterizer({ Vector2f(0.25f, 0.25f) }, pointSize).rasterize(QSize(imageSize, imageSize)), 0.5f * pointSize);
+
+        // In outline mode the quad is enlarged for the outline, but non-highlighted points keep their size
+        auto pointRasterizer = createRasterizer({ Vector2f(0.25f, 0.25f) }, pointSize);
+
+        pointRasterizer.setSelectionDisplayMode(PointSelectionDisplayMode::Outline);
+
+        expectDiscArea(pointRasterizer.rasterize(QSize(imageSize, imageSize)), 0.5f * pointSize);
+    }
+}
+
+TEST(PointRasterizer, scalesPointsWithTheSizeScalars)
+{
+    auto pointRasterizer = createRasterizer({ Vector2f(-0.5f, 0.0f), Vector2f(0.5f, 0.0f) });
+
+    pointRasterizer.setSizeChannelScalars({ 10.0f, 30.0f });
+
+    const auto image = pointRasterizer.rasterize(QSize(imageSize, imageSize));
+
+    const auto expectedArea = std::numbers::pi_v<float> * (5.0f * 5.0f + 15.0f * 15.0f);
+
+    EXPECT_NEAR(static_cast<float>(getNumberOfCoveredPixels(image)), expectedArea, 2.0f * std::numbers::pi_v<float> * (5.0f + 15.0f));
+}
+
+TEST(PointRasterizer, shadesPointsWithTheirColor)
+{
+    auto pointRasterizer = createRasterizer({ Vector2f(-0.5f, 0.5f), Vector2f(0.5f, -0.5f) });
+
+    pointRasterizer.setColors({ Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f) });
+
+    const auto image = pointRasterizer.rasterize(QSize(imageSize, imageSize));
+
+    // Point (x, y) is centered at pixel ((x + 1) * 64, (1 - y) * 64)
+    EXPECT_EQ(image.pixel(32, 32), qRgba(255, 0, 0, 255));
+    EXPECT_EQ(image.pixel(96, 96), qRgba(0, 255, 0, 255));
+    EXPECT_EQ(image.pixel(96, 32), qRgba(0, 0, 0, 0));
+    EXPECT_EQ(image.pixel(32, 96), qRgba(0, 0, 0, 0));
+
+    // Points without colors are gray
+    EXPECT_EQ(createRasterizer({ Vector2f(0.0f, 0.0f) }).rasterize(QSize(imageSize, imageSize)).pixel(64, 64), qRgba(128, 128, 128, 255));
+}
+
+TEST(PointRasterizer, blendsPointsInOrderWithTheirOpacity)
+{
+    auto pointRasterizer = createRasterizer({ Vector2f(0.0f, 0.0f), Vector2f(0.0f, 0.0f) });
+
+    pointRasterizer.setColors({ Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 0.0f, 1.0f) });
+
+    // The point which comes last is drawn on top
+    EXPECT_EQ(pointRasterizer.rasterize(QSize(imageSize, imageSize)).pixel(64, 64), qRgba(0, 0, 255, 255));
+
+    pointRasterizer.setOpacityChannelScalars({ 1.0f, 0.5f });
+
+    // Blue at half opacity over red
+    const auto pixel = pointRasterizer.rasterize(QSize(imageSize, imageSize), Qt::black).pixel(64, 64);
+
+    EXPECT_NEAR(qRed(pixel), 128, 1);
+    EXPECT_EQ(qGreen(pixel), 0);
+    EXPECT_NEAR(qBlue(pixel), 128, 1);
+    EXPECT_EQ(qAlpha(pixel), 255);
+}
+
+TEST(PointRasterizer, mapsColorScalarsThroughTheColormap)
+{
+    QImage colormap(2, 1, QImage::Format_ARGB32);
+
+    colormap.setPixel(0, 0, qRgb(0, 0, 255));
+    colormap.setPixel(1, 0, qRgb(255, 0, 0));
+
+    auto pointRasterizer = createRasterizer({ Vector2f(-0.5f, 0.0f), Vector2f(0.5f, 0.0f) });
+
+    pointRasterizer.setColormap(colormap);
+    pointRasterizer.setScalarEffect(PointEffect::Color);
+    pointRasterizer.setColorChannelScalars({ 10.0f, 20.0f });
+
+    EXPECT_EQ(pointRasterizer.getColorMapRange().x, 10.0f);
+    EXPECT_EQ(pointRasterizer.getColorMapRange().y, 20.0f);
+
+    const auto image = pointRasterizer.rasterize(QSize(imageSize, imageSize));
+
+    EXPECT_EQ(image.pixel(32, 64), qRgba(0, 0, 255, 255));
+    EXPECT_EQ(image.pixel(96, 64), qRgba(255, 0, 0, 255));
+}
+
+TEST(PointRasterizer, clipsPointsToTheImage)
+{
+    // Points outside the view bounds do not touch the image
+    EXPECT_EQ(getNumberOfCoveredPixels(createRasterizer({ Vector2f(2.0f, 0.0f), Vector2f(0.0f, -3.0f) }).rasterize(QSize(imageSize, imageSize))), 0);
+
+    // Points on the edge are cut in half and do not wrap around to the other side of the image
+    const auto image = createRasterizer({ Vector2f(-1.0f, 0.0f) }, 32.0f).rasterize(QSize(imageSize, imageSize));
+
+    expectDiscArea(image, 16.0f, 0.5f);
+
+    for (std::int32_t y = 0; y < image.height(); y++)
+        EXPECT_EQ(qAlpha(image.pixel(image.width() - 1, y)), 0) << "at " << y;
+
+    // Non-finite positions are skipped
+    EXPECT_EQ(getNumberOfCoveredPixels(createRasterizer({ Vector2f(std::nanf(""), 0.0f) }).rasterize(QSize(imageSize, imageSize))), 0);
+}
+
+TEST(PointRasterizer, drawsInTheCenteredSquareViewport)
+{
+    // The image is twice as wide as high, so the viewport is the centered square [64, 192) x [0, 128)
+    auto pointRasterizer = createRasterizer({ Vector2f(-1.0f, 1.0f), Vector2f(0.0f, 0.0f) }, 4.0f);
+
+    pointRasterizer.setColors({ Vector3f(1.0f, 0.0f, 0.0f), Vector3f(0.0f, 1.0f, 0.0f) });
+
+    const auto image = pointRasterizer.rasterize(QSize(2 * imageSize, imageSize));
+
+    EXPECT_EQ(image.pixel(64, 0), qRgba(255, 0, 0, 255));
+    EXPECT_EQ(image.pixel(128, 64), qRgba(0, 255, 0, 255));
+}
+
+TEST(PointRasterizer, outlinesHighlightedPoints)
+{
+    auto pointRasterizer = createRasterizer({ Vector2f(0.0f, 0.0f) }, 20.0f);
+
+    pointRasterizer.setColors({ Vector3f(1.0f, 0.0f, 0.0f) });
+    pointRasterizer.setHighlights({ 1 });
+    pointRasterizer.setSelectionDisplayMode(PointSelectionDisplayMode::Outline);
+    pointRasterizer.setSelectionOutlineColor(Vector3f(0.0f, 0.0f, 1.0f));
+    pointRasterizer.setSelectionOutlineOverrideColor(true);
+    pointRasterizer.setSelectionOutlineScale(2.0f);
+    pointRasterizer.setSelectionOutlineOpacity(1.0f);
+
+    const auto image = pointRasterizer.rasterize(QSize(imageSize, imageSize));
+
+    // The point keeps its color, the ring between its radius (10) and the outline radius (20) has the outline color
+    EXPECT_EQ(image.pixel(64, 64), qRgba(255, 0, 0, 255));
+    EXPECT_EQ(image.pixel(64 + 15, 64), qRgba(0, 0, 255, 255));
+    EXPECT_EQ(image.pixel(64, 64 - 15), qRgba(0, 0, 255, 255));
+    EXPECT_EQ(image.pixel(64 + 25, 64), qRgba(0, 0, 0, 0));
+
+    expectDiscArea(image, 20.0f);
+
+    // In override mode highlighted points are drawn in the selection color
+    pointRasterizer.setSelectionDisplayMode(PointSelectionDisplayMode::Override);
+
+    EXPECT_EQ(pointRasterizer.rasterize(QSize(imageSize, imageSize)).pixel(64, 64), qRgba(0, 0, 255, 255));
+}
+
+TEST(PointRasterizer, isIndependentOfTheTiles)
+{
+    // A point on the corner of four tiles is drawn exactly like a point in the middle of a tile
+    const auto cornerImage = createRasterizer({ Vector2f(0.0f, 0.0f) }, 24.0f).rasterize(QSize(imageSize, imageSize));
+    const auto centerImage = createRasterizer({ Vector2f(-0.5f, 0.5f) }, 24.0f).rasterize(QSize(imageSize, imageSize));
+
+    for (std::int32_t y = -20; y < 20; y++)
+        for (std::int32_t x = -20; x < 20; x++)
+            ASSERT_EQ(cornerImage.pixel(64 + x, 64 + y), centerImage.pixel(32 + x, 32 + y)) << "at " << x << ", " << y;
+
+    EXPECT_EQ(getNumberOfCoveredPixels(cornerImage), getNumberOfCoveredPixels(centerImage));
+}
+
+TEST(PointRasterizer, keepsThePointOrderAcrossPartitions)
+{
+    // Enough points to shade and bin them in several partitions, cycling over four positions with a color per point
+    constexpr std::uint32_t numberOfPoints = 300000;
+
+    const Vector2f cornerPositions[4] = { Vector2f(-0.5f, 0.5f), Vector2f(0.5f, 0.5f), Vector2f(-0.5f, -0.5f), Vector2f(0.5f, -0.5f) };
+
+    std::vector<Vector2f> positions(numberOfPoints);
+    std::vector<Vector3f> colors(numberOfPoints);
+
+    for (std::uint32_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        positions[pointIndex]   = cornerPositions[pointIndex % 4];
+        colors[pointIndex]      = Vector3f(static_cast<float>(pointIndex % 251) / 250.0f, static_cast<float>(pointIndex % 4) / 3.0f, 0.0f);
+    }
+
+    auto pointRasterizer = createRasterizer(positions);
+
+    pointRasterizer.setColors(colors);
+
+    const auto image = pointRasterizer.rasterize(QSize(imageSize, imageSize));
+
+    // The last point at each position is on top
+    const std::int32_t pixelCoordinates[4][2] = { { 32, 32 }, { 96, 32 }, { 32, 96 }, { 96, 96 } };
+
+    for (std::uint32_t cornerIndex = 0; cornerIndex < 4; cornerIndex++) {
+        const auto lastPointIndex   = numberOfPoints - 4 + cornerIndex;
+        const auto& color           = colors[lastPointIndex];
+
+        EXPECT_EQ(image.pixel(pixelCoordinates[cornerIndex][0], pixelCoordinates[cornerIndex][1]), qRgba(static_cast<int>(color.x * 255.0f + 0.5f), static_cast<int>(color.y * 255.0f + 0.5f), 0, 255)) << "corner " << cornerIndex;
+    }
+}
@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <util/SpatialIndex2D.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <random>
+#include <vector>
+
+using mv::Bounds;
+using mv::Vector2f;
+using mv::util::SpatialIndex2D;
+
+namespace
+{
+    std::vector<Vector2f> createRandomPositions(std::size_t numberOfPoints, std::uint32_t seed = 1)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+
+        std::vector<Vector2f> positions(numberOfPoints);
+
+        for (auto& position : positions)
+            position = Vector2f(distribution(generator), distribution(generator));
+
+        return positions;
+    }
+
+    template<typename IsInside>
+    SpatialIndex2D::Indices bruteForce(const std::vector<Vector2f>& positions, IsInside isInside)
+    {
+        SpatialIndex2D::Indices indices;
+
+        for (std::uint32_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex)
+            if (std::isfinite(positions[pointIndex].x) && std::isfinite(positions[pointIndex].y) && isInside(positions[pointIndex]))
+                indices.push_back(pointIndex);
+
+        return indices;
+    }
+
+    SpatialIndex2D::Indices bruteForceRectangle(const std::vector<Vector2f>& positions, const Bounds& rectangle)
+    {
+        return bruteForce(positions, [&rectangle](const Vector2f& position) -> bool {
+            return position.x >= rectangle.getLeft() && position.x <= rectangle.getRight() && position.y >= rectangle.getBottom() && position.y <= rectangle.getTop();
+        });
+    }
+
+    SpatialIndex2D::Indices bruteForceCircle(const std::vector<Vector2f>& positions, const Vector2f& center, float radius)
+    {
+        return bruteForce(positions, [&center, radius](const Vector2f& position) -> bool {
+            const auto dx = position.x - center.x;
+            const auto dy = position.y - center.y;
+
+            return dx * dx + dy * dy <= radius * radius;
+        });
+    }
+
+    SpatialIndex2D::Indices bruteForcePolygon(const std::vector<Vector2f>& positions, const std::vector<Vector2f>& polygon)
+    {
+        return bruteForce(positions, [&polygon](const Vector2f& position) -> bool {
+            return SpatialIndex2D::isInsidePolygon(polygon, position);
+        });
+    }
+
+    /** Concave (star shaped) polygon */
+    const std::vector<Vector2f> star{
+        { 0.f, 8.f }, { 2.f, 2.f }, { 8.f, 2.f }, { 3.f, -2.f }, { 5.f, -8.f }, { 0.f, -4.f }, { -5.f, -8.f }, { -3.f, -2.f }, { -8.f, 2.f }, { -2.f, 2.f }
+    };
+}
+
+
+TEST(SpatialIndex2D, queriesMatchLinearScan)
+{
+    const auto positions = createRandomPositions(20000);
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(positions);
+
+    ASSERT_TRUE(spatialIndex.isBuilt());
+    EXPECT_EQ(spatialIndex.getNumberOfPoints(), positions.size());
+
+    for (const auto& rectangle : { Bounds(-3.f, 4.f, -2.f, 5.f), Bounds(-20.f, 20.f, -20.f, 20.f), Bounds(9.5f, 30.f, 9.5f, 30.f), Bounds(11.f, 12.f, 11.f, 12.f) })
+        EXPECT_EQ(spatialIndex.queryRectangle(rectangle), bruteForceRectangle(positions, rectangle));
+
+    for (const auto radius : { 0.1f, 1.f, 4.5f, 30.f })
+        EXPECT_EQ(spatialIndex.queryCircle(Vector2f(1.f, -2.f), radius), bruteForceCircle(positions, Vector2f(1.f, -2.f), radius));
+
+    EXPECT_EQ(spatialIndex.queryPolygon(star), bruteForcePolygon(positions, star));
+}
+
+
+TEST(SpatialIndex2D, selectionMasksMatchQueries)
+{
+    const auto positions = createRandomPositions(5000);
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(positions);
+
+    SpatialIndex2D::Mask mask;
+
+    spatialIndex.selectRectangle(Bounds(-3.f, 0.f, -3.f, 0.f), mask);
+    spatialIndex.selectCircle(Vector2f(5.f, 5.f), 2.f, mask);
+    spatialIndex.selectPolygon(star, mask);
+
+    ASSERT_EQ(mask.size(), positions.size());
+
+    auto expected = bruteForceRectangle(positions, Bounds(-3.f, 0.f, -3.f, 0.f));
+
+    for (const auto indices : { bruteForceCircle(positions, Vector2f(5.f, 5.f), 2.f), bruteForcePolygon(positions, star) })
+        expected.insert(expected.end(), indices.begin(), indices.end());
+
+    SpatialIndex2D::Mask expectedMask(positions.size(), false);
+
+    for (const auto pointIndex : expected)
+        expectedMask[pointIndex] = true;
+
+    EXPECT_EQ(mask, expectedMask);
+}
+
+
+TEST(SpatialIndex2D, neverSelectsNonFinitePoints)
+{
+    auto positions = createRandomPositions(1000);
+
+    positions[3]    = Vector2f(std::numeric_limits<float>::quiet_NaN(), 0.f);
+    positions[7]    = Vector2f(0.f, std::numeric_limits<float>::infinity());
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(positions);
+
+    const auto indices = spatialIndex.queryRectangle(Bounds(-100.f, 100.f, -100.f, 100.f));
+
+    EXPECT_EQ(indices.size(), positions.size() - 2);
+    EXPECT_EQ(indices, bruteForceRectangle(positions, Bounds(-100.f, 100.f, -100.f, 100.f)));
+}
+
+
+TEST(SpatialIndex2D, handlesDegenerateEmbeddings)
+{
+    // All points on a vertical line, and all points at the same position
+    std::vector<Vector2f> line, coincident(100, Vector2f(1.f, 1.f));
+
+    for (int pointIndex = 0; pointIndex < 100; ++pointIndex)
+        line.emplace_back(2.f, static_cast<float>(pointIndex));
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(line);
+
+    EXPECT_EQ(spatialIndex.queryRectangle(Bounds(1.f, 3.f, 10.f, 19.5f)), bruteForceRectangle(line, Bounds(1.f, 3.f, 10.f, 19.5f)));
+
+    spatialIndex.build(coincident);
+
+    EXPECT_EQ(spatialIndex.queryCircle(Vector2f(1.f, 1.f), 0.5f).size(), coincident.size());
+    EXPECT_TRUE(spatialIndex.queryCircle(Vector2f(3.f, 1.f), 0.5f).empty());
+}
+
+
+TEST(SpatialIndex2D, rebuildReplacesThePoints)
+{
+    const auto positions = createRandomPositions(2000, 1);
+    const auto otherPositions = createRandomPositions(500, 2);
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(positions);
+    spatialIndex.build(otherPositions);
+
+    EXPECT_EQ(spatialIndex.getNumberOfPoints(), otherPositions.size());
+    EXPECT_EQ(spatialIndex.queryCircle(Vector2f(0.f, 0.f), 5.f), bruteForceCircle(otherPositions, Vector2f(0.f, 0.f), 5.f));
+}
+
+
+TEST(SpatialIndex2D, clearRemovesAllPoints)
+{
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(createRandomPositions(1000));
+    spatialIndex.clear();
+
+    EXPECT_FALSE(spatialIndex.isBuilt());
+    EXPECT_EQ(spatialIndex.getNumberOfPoints(), 0U);
+    EXPECT_TRUE(spatialIndex.queryRectangle(Bounds(-100.f, 100.f, -100.f, 100.f)).empty());
+
+    SpatialIndex2D::Mask mask;
+
+    spatialIndex.selectCircle(Vector2f(0.f, 0.f), 100.f, mask);
+
+    EXPECT_TRUE(mask.empty());
+}
+
+
+TEST(SpatialIndex2D, asyncBuildAnswersQueriesCorrectly)
+{
+    const auto positions = createRandomPositions(200000);
+
+    SpatialIndex2D spatialIndex;
+
+    spatialIndex.build(positions, true);
+
+    // Queries issued while the grid is built fall back to a linear scan
+    EXPECT_EQ(spatialIndex.queryPolygon(star), bruteForcePolygon(positions, star));
+
+    spatialIndex.waitForBuild();
+
+    EXPECT_TRUE(spatialIndex.isBuilt());
+    EXPECT_EQ(spatialIndex.queryPolygon(star), bruteForcePolygon(positions, star));
+}
+
+
+TEST(SpatialIndex2D, waitForBuildReturnsWhenAsyncBuildIsSuperseded)
+{
+    const auto positions = createRandomPositions(200000);
+
+    // Superseded by a synchronous build, by another background build and by clearing the index
+    for (const auto supersede : { 0, 1, 2 }) {
+        SpatialIndex2D spatialIndex;
+
+        spatialIndex.build(positions, true);
+
+        auto waiter = std::async(std::launch::async, [&spatialIndex]() -> void { spatialIndex.waitForBuild(); });
+
+        switch (supersede) {
+            case 0:
+                spatialIndex.build(createRandomPositions(100));
+                break;
+
+            case 1:
+                spatialIndex.build(createRandomPositions(100), true);
+                break;
+
+            default:
+                spatialIndex.clear();
+                break;
+        }
+
+        ASSERT_EQ(waiter.wait_for(std::chrono::seconds(30)), std::future_status::ready);
+
+        spatialIndex.waitForBuild();
+
+        if (supersede != 2) {
+            EXPECT_TRUE(spatialIndex.isBuilt());
+            EXPECT_EQ(spatialIndex.getNumberOfPoints(), 100U);
+        }
+    }
+}
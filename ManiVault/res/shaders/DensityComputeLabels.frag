@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#version 330 core
+
+uniform sampler2D gaussSampler;
+
+in vec2 pass_texCoord;
+flat in float pass_weight;
+flat in int pass_channel;
+
+// Four labels per render target (one per color channel)
+layout(location = 0) out vec4 value0;
+layout(location = 1) out vec4 value1;
+layout(location = 2) out vec4 value2;
+layout(location = 3) out vec4 value3;
+layout(location = 4) out vec4 value4;
+layout(location = 5) out vec4 value5;
+layout(location = 6) out vec4 value6;
+layout(location = 7) out vec4 value7;
+
+void main() {
+    float density = texture(gaussSampler, pass_texCoord).r;
+
+    int target = pass_channel / 4;
+
+    // Splat the density in the channel of the label, the other channels are left unchanged (additive blending)
+    vec4 value = vec4(equal(ivec4(pass_channel % 4), ivec4(0, 1, 2, 3))) * density * pass_weight;
+
+    value0 = target == 0 ? value : vec4(0);
+    value1 = target == 1 ? value : vec4(0);
+    value2 = target == 2 ? value : vec4(0);
+    value3 = target == 3 ? value : vec4(0);
+    value4 = target == 4 ? value : vec4(0);
+    value5 = target == 5 ? value : vec4(0);
+    value6 = target == 6 ? value : vec4(0);
+    value7 = target == 7 ? value : vec4(0);
+}
@@ -89,6 +89,12 @@ public:
      */
     virtual void notifyDatasetUnlocked(const Dataset<DatasetImpl>& dataset) = 0;
 
+    /**
+     * Notify all listeners that linked data of a dataset changed (linked data added, removed or its mapping changed)
+     * @param dataset Smart pointer to the source dataset of the linked data
+     */
+    virtual void notifyDatasetLinkedDataChanged(const Dataset<DatasetImpl>& dataset) = 0;
+
     /**
      * Register an event listener
      * @param eventListener Pointer to event listener to register
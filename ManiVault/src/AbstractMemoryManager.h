@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "AbstractManager.h"
+
+#include "actions/StringAction.h"
+
+#include "util/MemoryAccounting.h"
+#include "util/Spillable.h"
+
+#include <QObject>
+
+namespace mv
+{
+
+/**
+ * Abstract memory manager class
+ *
+ * Base abstract memory manager class, which presents the memory accounting (see util::MemoryAccounting), enforces
+ * the memory budget (see gui::MemorySettingsAction) and spills the least recently used spillable memory (see
+ * util::Spillable) to disk when the budget is exceeded.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT AbstractMemoryManager : public AbstractManager
+{
+    Q_OBJECT
+
+public:
+
+    /**
+     * Construct manager with pointer to \p parent object
+     * @param parent Pointer to parent object
+     */
+    AbstractMemoryManager(QObject* parent) :
+        AbstractManager(parent, "Memory")
+    {
+    }
+
+    /**
+     * Get the number of bytes in \p category
+     * @param category Memory category
+     * @return Number of bytes
+     */
+    std::uint64_t getNumberOfBytes(const util::MemoryAccounting::Category& category) const {
+        return util::MemoryAccounting::getNumberOfBytes(category);
+    }
+
+    /**
+     * Get the number of bytes in host memory (which counts towards the memory budget)
+     * @return Number of bytes
+     */
+    std::uint64_t getNumberOfHostBytes() const {
+        return util::MemoryAccounting::getNumberOfHostBytes();
+    }
+
+    /**
+     * Get the number of bytes that are spilled to disk
+     * @return Number of bytes
+     */
+    virtual std::uint64_t getNumberOfSpilledBytes() const = 0;
+
+    /**
+     * Get whether the spillable with \p spillName (e.g. raw data name) is spilled to disk
+     * @param spillName Spill name
+     * @return Boolean determining whether the spillable is spilled to disk
+     */
+    virtual bool isSpilled(const QString& spillName) const = 0;
+
+    /**
+     * Get the memory budget
+     * @return Memory budget in bytes (zero when the budget is not enforced)
+     */
+    virtual std::uint64_t getBudget() const = 0;
+
+    /**
+     * Get the directory in which spillables are spilled
+     * @return Spill directory
+     */
+    virtual QString getSpillDirectory() const = 0;
+
+    /** Update the memory accounting and enforce the memory budget (also done periodically) */
+    virtual void update() = 0;
+
+public: // Action getters
+
+    virtual gui::StringAction& getSummaryAction() = 0;
+
+signals:
+
+    /** Signals that the memory accounting changed */
+    void accountingChanged();
+
+    /**
+     * Signals that the spillable with \p spillName was spilled to disk
+     * @param spillName Spill name
+     * @param numberOfBytes Number of bytes that were freed
+     */
+    void spilled(const QString& spillName, std::uint64_t numberOfBytes);
+};
+
+}
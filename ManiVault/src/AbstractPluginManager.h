@@ -10,9 +10,11 @@
 
 #include "util/DockArea.h"
 
+#include <QIcon>
 #include <QObject>
 #include <QString>
 #include <QStringList>
+#include <QUrl>
 
 namespace mv
 {
@@ -37,6 +39,27 @@ class CORE_EXPORT AbstractPluginManager : public AbstractManager
 {
     Q_OBJECT
 
+public:
+
+    /** Plugin factory properties which are known without loading the plugin shared library (see getPluginFactoryInfos()) */
+    struct PluginFactoryInfo
+    {
+        QString             _kind;                                  /** Plugin kind */
+        plugin::Type        _type;                                  /** Plugin type */
+        QString             _version;                               /** Plugin version */
+        QString             _guiName;                               /** Plugin GUI name */
+        QString             _menuName;                              /** Menu name from the plugin metadata, empty if none */
+        QIcon               _icon;                                  /** Plugin icon */
+        QUrl                _repositoryUrl;                         /** Plugin repository URL, invalid if none */
+        QUrl                _readmeMarkdownUrl;                     /** Plugin readme markdown URL, invalid if none */
+        bool                _allowPluginCreationFromStandardGui;    /** Whether plugin instances may be created from the standard GUI */
+        bool                _producesSystemViewPlugins;             /** Whether the factory produces system view plugins (view plugins only) */
+        gui::DockAreaFlag   _preferredDockArea;                     /** Preferred dock area (view plugins only) */
+        bool                _isLoaded;                              /** Whether the plugin shared library is loaded */
+    };
+
+    using PluginFactoryInfos = std::vector<PluginFactoryInfo>;
+
 public:
 
     /**
@@ -52,16 +75,36 @@ public:
     virtual void loadPluginFactories() = 0;
 
     /**
-     * Determine whether a plugin of \p kind is loaded
+     * Determine whether the shared library of the plugin of \p kind is loaded
      * @param kind Plugin kind
      * @return Boolean determining whether a plugin of \p kind is loaded
      */
     virtual bool isPluginLoaded(const QString& kind) const = 0;
 
+    /**
+     * Determine whether the plugin of \p kind is registered, but its shared library is only loaded on first use (it might still fail to load)
+     * @param kind Plugin kind
+     * @return Boolean determining whether the plugin of \p kind is deferred
+     */
+    virtual bool isPluginDeferred(const QString& kind) const = 0;
+
+    /**
+     * Load the deferred shared library of the plugin of \p pluginKind (no-op if the plugin is not deferred)
+     * @param pluginKind Kind of plugin
+     * @return Plugin factory of \p pluginKind, nullptr if not found or if loading failed
+     */
+    virtual plugin::PluginFactory* loadDeferredPluginFactory(const QString& pluginKind) = 0;
+
+    /**
+     * Load the deferred shared libraries of the plugins of \p pluginTypes
+     * @param pluginTypes Plugin types
+     */
+    virtual void loadDeferredPluginFactories(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) = 0;
+
 public: // Plugin creation/destruction
 
     /**
-     * Create a plugin of \p kind with input \p datasets
+     * Create a plugin of \p kind with input \p datasets (loads the plugin shared library if it was deferred)
      * @param kind Kind of plugin (name of the plugin)
      * @param datasets Zero or more datasets upon which the plugin is based (e.g. analysis plugin)
      * @return Pointer to created plugin, nullptr if creation failed
@@ -125,26 +168,39 @@ public: // Destroy
 public: // Plugin factory
 
     /**
-     * Get plugin factory from \p pluginKind
+     * Get plugin factory from \p pluginKind (deferred plugins are not loaded, see loadDeferredPluginFactory())
      * @param pluginKind Kind of plugin
-     * @return Plugin factory of \p pluginKind, nullptr if not found
+     * @return Plugin factory of \p pluginKind, nullptr if not found or not loaded
      */
     virtual plugin::PluginFactory* getPluginFactory(const QString& pluginKind) const = 0;
 
     /**
-     * Get plugin factories for \p pluginType
+     * Get the loaded plugin factories for \p pluginType (deferred plugins are not loaded, see loadDeferredPluginFactories())
      * @param pluginType Plugin type
      * @return Vector of pointers to plugin factories
      */
     virtual std::vector<plugin::PluginFactory*> getPluginFactoriesByType(const plugin::Type& pluginType) const = 0;
 
     /**
-     * Get plugin factories for \p pluginTypes (by default it gets all plugins factories for all types)
+     * Get the loaded plugin factories for \p pluginTypes (by default it gets all plugins factories for all types, deferred plugins are not loaded)
      * @param pluginTypes Plugin types
      * @return Vector of pointers to plugin factories of \p pluginTypes
      */
     virtual std::vector<plugin::PluginFactory*> getPluginFactoriesByTypes(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const = 0;
 
+    /**
+     * Get the plugin factories of which the shared library is loaded
+     * @return Vector of pointers to loaded plugin factories, ordered by type and kind
+     */
+    virtual std::vector<plugin::PluginFactory*> getLoadedPluginFactories() const = 0;
+
+    /**
+     * Get the properties of the loaded and deferred plugin factories for \p pluginTypes (without loading deferred plugins)
+     * @param pluginTypes Plugin types
+     * @return Plugin factory properties, ordered by type and kind
+     */
+    virtual PluginFactoryInfos getPluginFactoryInfos(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const = 0;
+
     /**
      * Get plugin instances for \p pluginFactory
      * @param pluginFactory Pointer to plugin factory
@@ -169,13 +225,13 @@ public: // Plugin getters
     virtual std::vector<plugin::Plugin*> getPluginsByTypes(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const = 0;
 
     /**
-     * Get plugin kinds by plugin type(s)
+     * Get plugin kinds by plugin type(s), including the kinds of deferred plugins
      * @param pluginTypes Plugin type(s)
      * @return Plugin kinds
      */
     virtual QStringList getPluginKindsByPluginTypes(const plugin::Types& pluginTypes) const = 0;
 
-public: // Plugin trigger actions
+public: // Plugin trigger actions (of loaded plugins only, see loadDeferredPluginFactories())
 
     /**
      * Get plugin trigger actions by \p pluginType
@@ -219,14 +275,14 @@ public: // Plugin trigger actions
 public: // Plugin query
 
     /**
-     * Get plugin GUI name from plugin kind
+     * Get plugin GUI name from plugin kind (deferred plugins are not loaded)
      * @param pluginKind Kind of plugin
      * @param GUI name of the plugin, empty if the plugin kind was not found
      */
     virtual QString getPluginGuiName(const QString& pluginKind) const = 0;
 
     /**
-     * Get plugin icon from plugin kind
+     * Get plugin icon from plugin kind (deferred plugins are not loaded)
      * @param pluginKind Kind of plugin
      * @return Plugin icon name of the plugin, null icon if the plugin kind was not found
      */
@@ -275,9 +331,15 @@ signals:
      */
     void pluginDestroyed(const QString& id);
 
-    /** Signals that all plugin factories have been loaded */
+    /** Signals that all plugin factories have been loaded (or registered, deferred plugin shared libraries are loaded on first use) */
     void pluginFactoriesLoaded();
 
+    /**
+     * Signals that the shared library of \p pluginFactory has been loaded and the factory is initialized
+     * @param pluginFactory Pointer to the loaded plugin factory
+     */
+    void pluginFactoryLoaded(plugin::PluginFactory* pluginFactory);
+
     friend class gui::PluginTriggerAction;
 };
 
@@ -13,6 +13,7 @@
 #include "TasksSettingsAction.h"
 #include "ApplicationSettingsAction.h"
 #include "TemporaryDirectoriesSettingsAction.h"
+#include "MemorySettingsAction.h"
 #include "PluginGlobalSettingsGroupAction.h"
 
 namespace mv {
@@ -60,6 +61,7 @@ public: // Global settings actions
     virtual gui::TasksSettingsAction& getTasksSettingsAction() = 0;
     virtual gui::ApplicationSettingsAction& getApplicationSettings() = 0;
     virtual gui::TemporaryDirectoriesSettingsAction& getTemporaryDirectoriesSettingsAction() = 0;
+    virtual gui::MemorySettingsAction& getMemorySettingsAction() = 0;
 
     /**
      * Get plugin global settings for plugin \p kind
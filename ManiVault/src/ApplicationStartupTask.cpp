@@ -8,6 +8,7 @@
 #include "ModalTask.h"
 #include "ModalTaskHandler.h"
 
+#include <QDebug>
 #include <QFileInfo>
 
 namespace mv {
@@ -17,7 +18,8 @@ ApplicationStartupTask::ApplicationStartupTask(QObject* parent, const QString& n
     _loadCoreTask(this, "Load core"),
     _loadCoreManagersTask(this, "Load core managers"),
     _loadGuiTask(this, "Load GUI"),
-    _loadProjectTask(this, "Load project")
+    _loadProjectTask(this, "Load project"),
+    _timings()
 {
     _loadCoreTask.setParentTask(this);
     _loadCoreManagersTask.setParentTask(&_loadCoreTask);
@@ -33,6 +35,9 @@ ApplicationStartupTask::ApplicationStartupTask(QObject* parent, const QString& n
     _loadGuiTask.setAlwaysProcessEvents(true);
 
     connect(this, &Task::statusChangedToFinished, this, [this]() -> void {
+        if (!_timings.empty())
+            qDebug().noquote() << getTimingsReport();
+
         if (Application::current()->shouldOpenProjectAtStartup())
             setProgressDescription("Loaded " + QFileInfo(Application::current()->getStartupProjectFilePath()).fileName());
         else
@@ -70,4 +75,26 @@ ProjectSerializationTask& ApplicationStartupTask::getLoadProjectTask()
     return _loadProjectTask;
 }
 
+void ApplicationStartupTask::addTiming(const QString& name, float duration)
+{
+    _timings.emplace_back(name, duration);
+
+    emit timingAdded(name, duration);
+}
+
+const ApplicationStartupTask::Timings& ApplicationStartupTask::getTimings() const
+{
+    return _timings;
+}
+
+QString ApplicationStartupTask::getTimingsReport() const
+{
+    QStringList lines{ "Startup timing breakdown:" };
+
+    for (const auto& [name, duration] : _timings)
+        lines << QString("    %1: %2 ms").arg(name, QString::number(duration, 'f', 2));
+
+    return lines.join("\n");
+}
+
 }
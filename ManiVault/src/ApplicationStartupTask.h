@@ -7,6 +7,9 @@
 #include "Task.h"
 #include "ProjectSerializationTask.h"
 
+#include <utility>
+#include <vector>
+
 namespace mv {
 
 /**
@@ -31,6 +34,10 @@ public:
     */
     ApplicationStartupTask(QObject* parent, const QString& name, const Status& status = Status::Undefined, bool mayKill = false);
 
+    /** Timing record: (name, duration in milliseconds) */
+    using Timing    = std::pair<QString, float>;
+    using Timings   = std::vector<Timing>;
+
 public: // Task getters
 
     Task& getLoadCoreTask();                            /** Get aggregate task for loading the core */
@@ -38,11 +45,42 @@ public: // Task getters
     Task& getLoadGuiTask();                             /** Get task for loading the GUI */
     ProjectSerializationTask& getLoadProjectTask();     /** Get task for loading a project */
 
+public: // Timing breakdown
+
+    /**
+     * Record that startup phase \p name took \p duration milliseconds
+     * @param name Name of the startup phase (e.g. "Plugins: load libraries")
+     * @param duration Duration in milliseconds
+     */
+    void addTiming(const QString& name, float duration);
+
+    /**
+     * Get the startup timing breakdown in the order the phases were recorded
+     * @return Vector of (name, duration in milliseconds) pairs
+     */
+    const Timings& getTimings() const;
+
+    /**
+     * Get human-readable startup timing breakdown
+     * @return Multi-line report with one phase per line
+     */
+    QString getTimingsReport() const;
+
+signals:
+
+    /**
+     * Signals that a startup phase timing with \p name and \p duration was added
+     * @param name Name of the startup phase
+     * @param duration Duration in milliseconds
+     */
+    void timingAdded(const QString& name, float duration);
+
 private:
     Task                        _loadCoreTask;              /** Aggregate task for loading the core */
     Task                        _loadCoreManagersTask;      /** Aggregate task for loading the core managers */
     Task                        _loadGuiTask;               /** Task for loading the GUI */
     ProjectSerializationTask    _loadProjectTask;           /** Task for possibly loading a project at application startup */
+    Timings                     _timings;                   /** Startup timing breakdown */
 };
 
 }
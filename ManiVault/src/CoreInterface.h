@@ -20,6 +20,7 @@
 #include "AbstractProjectManager.h"
 #include "AbstractSettingsManager.h"
 #include "AbstractHelpManager.h"
+#include "AbstractMemoryManager.h"
 
 #include <QString>
 #include <QObject>
@@ -67,6 +68,7 @@ public:
         Projects,           /** Manager for loading/saving projects */
         Settings,           /** Manager for managing global settings */
         Help,               /** Manager for getting help */
+        Memory,             /** Manager for memory accounting and the memory budget */
 
         Count
     };
@@ -122,6 +124,7 @@ public: // Managers
     virtual AbstractProjectManager& getProjectManager() = 0;
     virtual AbstractSettingsManager& getSettingsManager() = 0;
     virtual AbstractHelpManager& getHelpManager() = 0;
+    virtual AbstractMemoryManager& getMemoryManager() = 0;
 
 signals:
 
@@ -227,4 +230,12 @@ CORE_EXPORT inline AbstractHelpManager& help() {
     return core()->getHelpManager();
 }
 
+/**
+ * Convenience function to obtain access to the memory manager in the core
+ * @return Reference to abstract memory manager
+ */
+CORE_EXPORT inline AbstractMemoryManager& memory() {
+    return core()->getMemoryManager();
+}
+
 }
@@ -113,6 +113,9 @@ void DatasetPrivate::connectNotify(const QMetaMethod& signal)
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged))
         _eventListener.addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
 
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::linkedDataChanged))
+        _eventListener.addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetLinkedDataChanged));
+
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::childAdded))
         _eventListener.addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetChildAdded));
 
@@ -131,6 +134,9 @@ void DatasetPrivate::disconnectNotify(const QMetaMethod& signal)
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::dataSelectionChanged))
         _eventListener.removeSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
 
+    if (signal == QMetaMethod::fromSignal(&DatasetPrivate::linkedDataChanged))
+        _eventListener.removeSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetLinkedDataChanged));
+
     if (signal == QMetaMethod::fromSignal(&DatasetPrivate::childAdded))
         _eventListener.removeSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetChildAdded));
 
@@ -202,6 +208,16 @@ void DatasetPrivate::registerDatasetEvents()
                     break;
                 }
 
+                case EventType::DatasetLinkedDataChanged:
+                {
+                    if (dataEvent->getDataset().getDatasetId() != getDatasetId())
+                        break;
+
+                    emit linkedDataChanged();
+
+                    break;
+                }
+
                 case EventType::DatasetChildAdded:
                 {
                     if (dataEvent->getDataset().getDatasetId() != getDatasetId())
@@ -133,6 +133,9 @@ signals:
     /** Signals that the dataset selection changed */
     void dataSelectionChanged();
 
+    /** Signals that the linked data of the dataset changed (linked data added, removed or its mapping changed) */
+    void linkedDataChanged();
+
     /** Signals that the dataset GUI name changed */
     void guiNameChanged();
 
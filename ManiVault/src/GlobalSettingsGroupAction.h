@@ -28,6 +28,7 @@ namespace mv::gui
  *     - ParametersSettingsAction::addAction(...)
  *     - TasksSettingsAction::addAction(...)
  *     - TemporaryDirectoriesSettingsAction::addAction(...)
+ *     - MemorySettingsAction::addAction(...)
  * b. Create a new settings action derived from GlobalSettingsGroupAction, add it to the SettingsManager
  *    class and add actions to it: MySettingsAction::addAction(...)
  * 
@@ -6,14 +6,69 @@
 
 #include "Set.h"
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
 using namespace mv::util;
 
 namespace mv
 {
 
+namespace
+{
+    /** Inputs smaller than this are mapped on the calling thread */
+    constexpr std::size_t minimumNumberOfIndicesPerPartition = 65536;
+
+    /**
+     * Get the number of partitions for mapping \p numberOfIndices point indices
+     * @param numberOfIndices Number of point indices
+     * @return Number of partitions
+     */
+    std::size_t getNumberOfPartitions(std::size_t numberOfIndices)
+    {
+        const auto numberOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+        return std::clamp<std::size_t>(numberOfIndices / minimumNumberOfIndicesPerPartition, 1, numberOfThreads);
+    }
+
+    /**
+     * Sort \p indices and remove duplicates
+     * @param indices Indices to sort
+     */
+    void sortUnique(SelectionMap::Indices& indices)
+    {
+        if (!std::is_sorted(indices.begin(), indices.end())) {
+#ifndef __APPLE__
+            if (indices.size() >= minimumNumberOfIndicesPerPartition)
+                std::sort(std::execution::par_unseq, indices.begin(), indices.end());
+            else
+                std::sort(indices.begin(), indices.end());
+#else
+            std::sort(indices.begin(), indices.end());
+#endif
+        }
+
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+}
+
 SelectionMap::SelectionMap(Type type /*= Indexed*/) :
     Serializable("SelectionMapping"),
-    _type(type)
+    _type(type),
+    _numberOfPoints(0),
+    _sourceOffset(0),
+    _targetOffset(0)
 {
 }
 
@@ -24,55 +79,229 @@ SelectionMap::SelectionMap(const QSize& sourceImageSize, const QSize& targetImag
     _targetImageSize = targetImageSize;
 }
 
+SelectionMap::SelectionMap(std::uint32_t numberOfPoints, std::uint32_t sourceOffset /*= 0*/, std::uint32_t targetOffset /*= 0*/) :
+    SelectionMap(sourceOffset == 0 && targetOffset == 0 ? Type::Identity : Type::Offset)
+{
+    _numberOfPoints = numberOfPoints;
+    _sourceOffset   = sourceOffset;
+    _targetOffset   = targetOffset;
+}
+
+SelectionMap::Type SelectionMap::getType() const
+{
+    return _type;
+}
+
 void SelectionMap::populateMappingIndices(std::uint32_t pointIndex, Indices& indices) const
+{
+    if (_type == Type::Indexed) {
+        indices = _map.at(pointIndex);
+        return;
+    }
+
+    indices.clear();
+
+    if (hasMappingForPointIndex(pointIndex))
+        appendProceduralMapping(pointIndex, indices);
+}
+
+void SelectionMap::mapIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const
+{
+    mappedIndices.clear();
+
+    if (_type != Type::Indexed) {
+        mapIndicesProcedurally(pointIndices, mappedIndices);
+    }
+    else {
+        mappedIndices.reserve(pointIndices.size());
+
+        for (const auto pointIndex : pointIndices) {
+            const auto it = _map.find(pointIndex);
+
+            if (it != _map.end())
+                mappedIndices.insert(mappedIndices.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    sortUnique(mappedIndices);
+}
+
+void SelectionMap::populateTargetIndices(Indices& targetIndices) const
+{
+    targetIndices.clear();
+
+    switch (_type)
+    {
+        case Type::Indexed:
+        {
+            for (const auto& [pointIndex, mappedIndices] : _map)
+                targetIndices.insert(targetIndices.end(), mappedIndices.begin(), mappedIndices.end());
+
+            sortUnique(targetIndices);
+            break;
+        }
+
+        case Type::ImagePyramid:
+        {
+            const auto sourceWidth  = static_cast<std::uint32_t>(std::max(_sourceImageSize.width(), 0));
+            const auto sourceHeight = static_cast<std::uint32_t>(std::max(_sourceImageSize.height(), 0));
+            const auto targetWidth  = static_cast<std::uint32_t>(std::max(_targetImageSize.width(), 0));
+            const auto targetHeight = static_cast<std::uint32_t>(std::max(_targetImageSize.height(), 0));
+
+            if (sourceWidth == 0 || sourceHeight == 0 || targetWidth == 0)
+                break;
+
+            if (targetWidth == sourceWidth) {
+                targetIndices.resize(static_cast<std::size_t>(sourceWidth) * sourceHeight);
+
+                std::iota(targetIndices.begin(), targetIndices.end(), 0u);
+                break;
+            }
+
+            // The source image covers a rectangle at the origin of the target image (clipped like in SelectionMap::appendProceduralMapping())
+            std::uint64_t coveredWidth = 0, coveredHeight = 0;
+
+            if (targetWidth < sourceWidth) {
+                const auto levelFactor = sourceWidth / targetWidth;
+
+                coveredWidth    = std::min<std::uint64_t>(targetWidth, (sourceWidth + levelFactor - 1) / levelFactor);
+                coveredHeight   = std::min<std::uint64_t>(targetHeight, (sourceHeight + levelFactor - 1) / levelFactor);
+            }
+            else {
+                const auto levelFactor = targetWidth / sourceWidth;
+
+                coveredWidth    = std::min<std::uint64_t>(targetWidth, static_cast<std::uint64_t>(sourceWidth) * levelFactor);
+                coveredHeight   = std::min<std::uint64_t>(targetHeight, static_cast<std::uint64_t>(sourceHeight) * levelFactor);
+            }
+
+            targetIndices.resize(coveredWidth * coveredHeight);
+
+            for (std::uint64_t targetY = 0; targetY < coveredHeight; ++targetY)
+                std::iota(targetIndices.begin() + static_cast<std::ptrdiff_t>(targetY * coveredWidth), targetIndices.begin() + static_cast<std::ptrdiff_t>((targetY + 1) * coveredWidth), static_cast<std::uint32_t>(targetY * targetWidth));
+
+            break;
+        }
+
+        case Type::Identity:
+        case Type::Offset:
+        {
+            targetIndices.resize(_numberOfPoints);
+
+            std::iota(targetIndices.begin(), targetIndices.end(), _targetOffset);
+            break;
+        }
+    }
+}
+
+void SelectionMap::mapIndicesProcedurally(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const
+{
+    const auto mapPartition = [this](std::span<const std::uint32_t> partitionPointIndices, Indices& partitionMappedIndices) -> void {
+        partitionMappedIndices.reserve(partitionMappedIndices.size() + partitionPointIndices.size());
+
+        for (const auto pointIndex : partitionPointIndices)
+            if (hasMappingForPointIndex(pointIndex))
+                appendProceduralMapping(pointIndex, partitionMappedIndices);
+    };
+
+    const auto numberOfPartitions = getNumberOfPartitions(pointIndices.size());
+
+    if (numberOfPartitions == 1) {
+        mapPartition(pointIndices, mappedIndices);
+        return;
+    }
+
+    const auto partitionSize = (pointIndices.size() + numberOfPartitions - 1) / numberOfPartitions;
+
+    std::vector<Indices> partitionsMappedIndices(numberOfPartitions);
+    std::vector<std::size_t> partitionIndices(numberOfPartitions);
+
+    std::iota(partitionIndices.begin(), partitionIndices.end(), 0);
+
+    const auto mapPartitionIndex = [&](std::size_t partitionIndex) -> void {
+        const auto first = std::min(partitionIndex * partitionSize, pointIndices.size());
+        const auto last  = std::min(first + partitionSize, pointIndices.size());
+
+        mapPartition(pointIndices.subspan(first, last - first), partitionsMappedIndices[partitionIndex]);
+    };
+
+#ifndef __APPLE__
+    std::for_each(std::execution::par, partitionIndices.begin(), partitionIndices.end(), mapPartitionIndex);
+#else
+    std::for_each(partitionIndices.begin(), partitionIndices.end(), mapPartitionIndex);
+#endif
+
+    std::size_t numberOfMappedIndices = 0;
+
+    for (const auto& partitionMappedIndices : partitionsMappedIndices)
+        numberOfMappedIndices += partitionMappedIndices.size();
+
+    mappedIndices.reserve(numberOfMappedIndices);
+
+    for (const auto& partitionMappedIndices : partitionsMappedIndices)
+        mappedIndices.insert(mappedIndices.end(), partitionMappedIndices.begin(), partitionMappedIndices.end());
+}
+
+void SelectionMap::appendProceduralMapping(std::uint32_t pointIndex, Indices& mappedIndices) const
 {
     switch (_type)
     {
         case Type::Indexed:
-            indices = _map.at(pointIndex);
             break;
 
         case Type::ImagePyramid:
         {
-            const QPoint sourcePixelPosition(pointIndex % _sourceImageSize.width(), static_cast<std::int32_t>(floorf(static_cast<float>(pointIndex) / static_cast<float>(_sourceImageSize.width()))));
+            const auto sourceWidth  = static_cast<std::uint32_t>(_sourceImageSize.width());
+            const auto targetWidth  = static_cast<std::uint32_t>(_targetImageSize.width());
+            const auto targetHeight = static_cast<std::uint32_t>(_targetImageSize.height());
 
-            const auto scaleFactor = static_cast<float>(_targetImageSize.width()) / static_cast<float>(_sourceImageSize.width());
+            if (sourceWidth == 0 || targetWidth == 0)
+                break;
 
-            if (scaleFactor == 1.0f)
-                indices = Indices({ pointIndex });
+            const auto sourceX = pointIndex % sourceWidth;
+            const auto sourceY = pointIndex / sourceWidth;
 
-            if (scaleFactor < 1.0f) {
-                const auto levelFactor = static_cast<std::uint32_t>(floorf(1.0f / scaleFactor));
+            if (targetWidth == sourceWidth) {
+                mappedIndices.push_back(pointIndex);
+                break;
+            }
 
-                const QPoint targetPixelPosition(
-                    static_cast<std::int32_t>(floorf(static_cast<float>(sourcePixelPosition.x()) / static_cast<float>(levelFactor))),
-                    static_cast<std::int32_t>(floorf(static_cast<float>(sourcePixelPosition.y()) / static_cast<float>(levelFactor)))
-                );
+            // Lower resolution target: a block of level factor x level factor source pixels maps to one target pixel
+            if (targetWidth < sourceWidth) {
+                const auto levelFactor  = sourceWidth / targetWidth;
+                const auto targetX      = sourceX / levelFactor;
+                const auto targetY      = sourceY / levelFactor;
 
-                indices = Indices({ static_cast<std::uint32_t>(targetPixelPosition.y() * _targetImageSize.width() + targetPixelPosition.x()) });
+                if (targetX < targetWidth && targetY < targetHeight)
+                    mappedIndices.push_back(targetY * targetWidth + targetX);
+
+                break;
             }
 
-            if (scaleFactor > 1.0f) {
-                const auto levelFactor = static_cast<std::uint32_t>(floorf(scaleFactor));
+            // Higher resolution target: a source pixel maps to level factor rows of level factor contiguous target pixels (clipped at the borders)
+            const auto levelFactor  = targetWidth / sourceWidth;
+            const auto targetX      = sourceX * levelFactor;
+            const auto targetY      = sourceY * levelFactor;
 
-                const QPoint targetPixelPositionStart(sourcePixelPosition.x() * levelFactor, sourcePixelPosition.y() * levelFactor);
-                const QPoint targetPixelPositionEnd(targetPixelPositionStart + QPoint(levelFactor, levelFactor));
+            if (targetX >= targetWidth || targetY >= targetHeight)
+                break;
 
-                indices.clear();
-                indices.reserve(static_cast<size_t>(levelFactor) * static_cast<size_t>(levelFactor));
+            const auto spanWidth    = std::min(levelFactor, targetWidth - targetX);
+            const auto spanHeight   = std::min(levelFactor, targetHeight - targetY);
 
-                for (std::int32_t targetPixelX = targetPixelPositionStart.x(); targetPixelX < targetPixelPositionEnd.x(); ++targetPixelX) {
-                    for (std::int32_t targetPixelY = targetPixelPositionStart.y(); targetPixelY < targetPixelPositionEnd.y(); ++targetPixelY) {
-                        if (targetPixelX >= _targetImageSize.width() || targetPixelY >= _targetImageSize.height())
-                            break;
+            for (std::uint32_t spanY = 0; spanY < spanHeight; ++spanY) {
+                const auto rowStart = (targetY + spanY) * targetWidth + targetX;
 
-                        indices.push_back(targetPixelY * _targetImageSize.width() + targetPixelX);
-                    }
-                }
+                for (std::uint32_t spanX = 0; spanX < spanWidth; ++spanX)
+                    mappedIndices.push_back(rowStart + spanX);
             }
 
             break;
         }
+
+        case Type::Identity:
+        case Type::Offset:
+            mappedIndices.push_back(_targetOffset + (pointIndex - _sourceOffset));
+            break;
     }
 }
 
@@ -84,7 +313,11 @@ bool SelectionMap::hasMappingForPointIndex(std::uint32_t pointIndex) const
             return _map.find(pointIndex) != _map.end();
 
         case Type::ImagePyramid:
-            return pointIndex < static_cast<std::uint32_t>(_sourceImageSize.width() * _sourceImageSize.height());
+            return pointIndex < static_cast<std::uint64_t>(std::max(_sourceImageSize.width(), 0)) * static_cast<std::uint64_t>(std::max(_sourceImageSize.height(), 0));
+
+        case Type::Identity:
+        case Type::Offset:
+            return pointIndex >= _sourceOffset && pointIndex - _sourceOffset < _numberOfPoints;
     }
 
     return false;
@@ -106,10 +339,14 @@ void SelectionMap::fromVariantMap(const QVariantMap& variantMap)
     _sourceImageSize.setWidth(SourceImageSizeMap["Width"].toInt());
     _sourceImageSize.setHeight(SourceImageSizeMap["Height"].toInt());
 
-    auto TargetImageSizeMap = variantMap["SourceImageSize"].toMap();
+    auto TargetImageSizeMap = variantMap["TargetImageSize"].toMap();
     _targetImageSize.setWidth(TargetImageSizeMap["Width"].toInt());
     _targetImageSize.setHeight(TargetImageSizeMap["Height"].toInt());
 
+    _numberOfPoints = variantMap.value("NumberOfPoints", 0).toUInt();
+    _sourceOffset   = variantMap.value("SourceOffset", 0).toUInt();
+    _targetOffset   = variantMap.value("TargetOffset", 0).toUInt();
+
     std::vector<std::uint32_t> serializedMap;
     serializedMap.resize(static_cast<size_t>(variantMap["SerializedMapSize"].toInt()));
     populateDataBufferFromVariantMap(variantMap["SerializedMap"].toMap(), (char*)serializedMap.data());
@@ -155,6 +392,9 @@ QVariantMap SelectionMap::toVariantMap() const
     variantMap["SerializedMapSize"] = QVariant::fromValue(serializedMap.size());
     variantMap["SourceImageSize"] = QVariant::fromValue(sourceImageSize);
     variantMap["TargetImageSize"] = QVariant::fromValue(targetImageSize);
+    variantMap["NumberOfPoints"] = QVariant::fromValue(_numberOfPoints);
+    variantMap["SourceOffset"] = QVariant::fromValue(_sourceOffset);
+    variantMap["TargetOffset"] = QVariant::fromValue(_targetOffset);
 
     return variantMap;
 }
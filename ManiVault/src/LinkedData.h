@@ -8,7 +8,10 @@
 
 #include "util/Serializable.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
+#include <span>
 #include <vector>
 
 namespace mv
@@ -24,7 +27,9 @@ public:
     enum class Type
     {
         Indexed,            /** Using mapped indices */
-        ImagePyramid        /** Using image pyramids */
+        ImagePyramid,       /** Using image pyramids */
+        Identity,           /** Each point index maps to itself */
+        Offset              /** A contiguous range of point indices maps to a contiguous range at another offset */
     };
 
     using Indices   = std::vector<std::uint32_t>;
@@ -45,6 +50,21 @@ public:
      */
     SelectionMap(const QSize& sourceImageSize, const QSize& targetImageSize);
 
+    /**
+     * Constructs an identity (when both offsets are zero) or offset selection mapping, which maps point
+     * index \p sourceOffset + i to \p targetOffset + i for i in [0, \p numberOfPoints)
+     * @param numberOfPoints Number of mapped points
+     * @param sourceOffset Index of the first mapped source point
+     * @param targetOffset Index of the target point of the first mapped source point
+     */
+    SelectionMap(std::uint32_t numberOfPoints, std::uint32_t sourceOffset = 0, std::uint32_t targetOffset = 0);
+
+    /**
+     * Get the type of selection mapping
+     * @return Type of selection mapping
+     */
+    Type getType() const;
+
     /**
      * Populate mapping \p indices for \p pointIndex
      * @param pointIndex Point index for which to populate
@@ -52,6 +72,24 @@ public:
      */
     void populateMappingIndices(std::uint32_t pointIndex, Indices& indices) const;
 
+    /**
+     * Map \p pointIndices in one batch (point indices without mapping are skipped)
+     *
+     * Procedural mappings (image pyramid, identity and offset) are computed in closed form with integer
+     * arithmetic, in parallel for large inputs. Since several points may map to the same index (e.g. when
+     * the image pyramid target is at a lower resolution), the mapped indices are sorted and unique.
+     *
+     * @param pointIndices Point indices to map
+     * @param mappedIndices Mapped indices, sorted and unique (output, replaces the contents)
+     */
+    void mapIndices(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const;
+
+    /**
+     * Populate all indices to which the selection map can map (sorted and unique)
+     * @param targetIndices Target indices (output, replaces the contents)
+     */
+    void populateTargetIndices(Indices& targetIndices) const;
+
     /**
      * Get map for indexed pixels
      * @return Index map
@@ -84,10 +122,29 @@ public:
     QVariantMap toVariantMap() const override;
 
 private:
-    Type    _type;              /** The type of selection map */
-    Map     _map;               /** Map contents (when mapping type is indexed) */
-    QSize   _sourceImageSize;   /** Source image size (when mapping type is image pyramid) */
-    QSize   _targetImageSize;   /** Target image size (when mapping type is image pyramid) */
+
+    /**
+     * Map \p pointIndices with a procedural (image pyramid, identity or offset) mapping
+     * @param pointIndices Point indices to map
+     * @param mappedIndices Mapped indices (output, replaces the contents)
+     */
+    void mapIndicesProcedurally(std::span<const std::uint32_t> pointIndices, Indices& mappedIndices) const;
+
+    /**
+     * Map \p pointIndex with a procedural mapping and append the mapped indices to \p mappedIndices
+     * @param pointIndex Point index to map (assumed to have a mapping)
+     * @param mappedIndices Mapped indices to append to
+     */
+    void appendProceduralMapping(std::uint32_t pointIndex, Indices& mappedIndices) const;
+
+private:
+    Type            _type;              /** The type of selection map */
+    Map             _map;               /** Map contents (when mapping type is indexed) */
+    QSize           _sourceImageSize;   /** Source image size (when mapping type is image pyramid) */
+    QSize           _targetImageSize;   /** Target image size (when mapping type is image pyramid) */
+    std::uint32_t   _numberOfPoints;    /** Number of mapped points (when mapping type is identity or offset) */
+    std::uint32_t   _sourceOffset;      /** Index of the first mapped source point (when mapping type is offset) */
+    std::uint32_t   _targetOffset;      /** Index of the target point of the first mapped source point (when mapping type is offset) */
 };
 
 class CORE_EXPORT LinkedData : public util::Serializable
@@ -45,6 +45,11 @@ public:
      * Should be implemented by loader plugins to parse their specific data.
      * This function will be called when the user clicks on the menu item for this loader.
      * The implementation is free to create file dialogs if desired.
+     *
+     * Loaders of large files need not buffer the entire file: they may create the dataset, reserve its points
+     * (e.g. Points::reservePoints()), append chunks of points from worker threads (e.g. Points::appendPoints())
+     * and commit when done (e.g. Points::commitAppendedPoints()). As long as this function returns control to the
+     * event loop while the workers run, views show the data which is loaded so far.
      */
     virtual void loadData() = 0;
 
@@ -4,14 +4,19 @@
 
 #include "private/MainWindow.h"
 #include "private/Archiver.h"
+#include "private/BatchRunner.h"
 #include "private/Core.h"
 #include "private/StartupProjectSelectorDialog.h"
 
 #include <Application.h>
+#include <ModalTask.h>
+#include <ModalTaskHandler.h>
 #include <ProjectMetaAction.h>
 #include <ManiVaultVersion.h>
 
+#include <util/Exception.h>
 #include <util/Icon.h>
+#include <util/Trace.h>
 
 #include <QSurfaceFormat>
 #include <QStyleFactory>
@@ -72,6 +77,22 @@ QSharedPointer<ProjectMetaAction> getStartupProjectMetaAction(const QString& sta
     return nullptr;
 }
 
+void exportTrace(const QString& traceFilePath)
+{
+    if (traceFilePath.isEmpty())
+        return;
+
+    try {
+        Tracer::exportChromeTrace(traceFilePath);
+
+        qDebug() << "Trace exported to" << traceFilePath;
+    }
+    catch (std::exception& e)
+    {
+        qDebug() << "Unable to export trace:" << e.what();
+    }
+}
+
 int main(int argc, char *argv[])
 {
     // Create a temporary core application to be able to read command line arguments without implicit interfacing with settings
@@ -87,17 +108,28 @@ int main(int argc, char *argv[])
     QCommandLineOption organizationNameOption({ "org_name", "organization_name" }, "Name of the organization", "organization_name", "BioVault");
     QCommandLineOption organizationDomainOption({ "org_dom", "organization_domain" }, "Domain of the organization", "organization_domain", "LUMC (LKEB) & TU Delft (CGV)");
     QCommandLineOption applicationNameOption({ "app_name", "application_name" }, "Name of the application", "application_name", "ManiVault");
+    QCommandLineOption traceOption({ "t", "trace" }, "Record trace spans and export them (Chrome trace JSON) to this file upon exit", "trace");
+    QCommandLineOption batchOption({ "b", "batch" }, "Run the analyses of this batch file (JSON) headless, without a display, and exit (see BatchRunner)", "batch");
+    QCommandLineOption outputOption({ "o", "output" }, "File path to save the project to after running the batch (defaults to the output of the batch file)", "output");
 
     commandLineParser.addOption(projectOption);
     commandLineParser.addOption(organizationNameOption);
     commandLineParser.addOption(organizationDomainOption);
     commandLineParser.addOption(applicationNameOption);
+    commandLineParser.addOption(traceOption);
+    commandLineParser.addOption(batchOption);
+    commandLineParser.addOption(outputOption);
 
     commandLineParser.process(QCoreApplication::arguments());
 
     // Remove the temporary application
     coreApplication.reset();
 
+    const auto traceFilePath = commandLineParser.value("trace");
+
+    if (!traceFilePath.isEmpty())
+        Tracer::setEnabled(true);
+
     QCoreApplication::setOrganizationName(commandLineParser.value("organization_name"));
     QCoreApplication::setOrganizationDomain(commandLineParser.value("organization_domain"));
     QCoreApplication::setApplicationName(commandLineParser.value("application_name"));
@@ -105,6 +137,38 @@ int main(int argc, char *argv[])
     // Necessary to instantiate QWebEngine from a plugin
     QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts, true);
 
+    // Headless batch mode: no display, no main window, no dialogs
+    if (commandLineParser.isSet("batch")) {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+
+        qDebug() << "Starting ManiVault in batch mode" << QString("%1.%2").arg(QString::number(MV_VERSION_MAJOR), QString::number(MV_VERSION_MINOR));
+
+        setExceptionMessageBoxesEnabled(false);
+
+        Application application(argc, argv);
+
+        Core core;
+
+        application.setCore(&core);
+
+        core.createManagers();
+        core.initialize();
+
+        application.initialize();
+
+        if (auto modalTaskHandler = ModalTask::getGlobalHandler())
+            modalTaskHandler->setEnabled(false);
+
+        BatchRunner batchRunner(commandLineParser.value("batch"), commandLineParser.value("project"), commandLineParser.value("output"));
+
+        const auto exitCode = batchRunner.run();
+
+        exportTrace(traceFilePath);
+
+        return exitCode;
+    }
+
 #ifdef __APPLE__
     QSurfaceFormat defaultFormat;
     
@@ -268,5 +332,9 @@ int main(int argc, char *argv[])
 
     loadGuiTask.setSubtaskFinished("Create main window");
 
-    return application.exec();
+    const auto exitCode = application.exec();
+
+    exportTrace(traceFilePath);
+
+    return exitCode;
 }
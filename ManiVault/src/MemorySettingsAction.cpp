@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "MemorySettingsAction.h"
+#include "Application.h"
+
+#include <QDir>
+
+namespace mv::gui
+{
+
+MemorySettingsAction::MemorySettingsAction(QObject* parent) :
+    GlobalSettingsGroupAction(parent, "Memory"),
+    _enforceBudgetAction(this, "Enforce memory budget", false),
+    _budgetAction(this, "Memory budget", 256, 1024 * 1024, defaultBudget),
+    _spillToDiskAction(this, "Spill to disk", true),
+    _spillDirectoryAction(this, "Spill directory", QDir(Application::current()->getTemporaryDir().path()).filePath("Spill"))
+{
+    _enforceBudgetAction.setToolTip("Keep the host memory occupied by raw data, selections and caches within the memory budget");
+    _budgetAction.setToolTip("Maximum amount of host memory occupied by raw data, selections and caches");
+    _budgetAction.setSuffix(" MB");
+    _spillToDiskAction.setToolTip("Spill the least recently used raw data to disk when the memory budget is exceeded (reloaded automatically when accessed)");
+    _spillDirectoryAction.setToolTip("Directory in which raw data is spilled (in the application temporary directory)");
+    _spillDirectoryAction.setEnabled(false);
+
+    addAction(&_enforceBudgetAction);
+    addAction(&_budgetAction);
+    addAction(&_spillToDiskAction);
+    addAction(&_spillDirectoryAction);
+
+    const auto updateReadOnly = [this]() -> void {
+        _budgetAction.setEnabled(_enforceBudgetAction.isChecked());
+        _spillToDiskAction.setEnabled(_enforceBudgetAction.isChecked());
+    };
+
+    updateReadOnly();
+
+    connect(&_enforceBudgetAction, &ToggleAction::toggled, this, updateReadOnly);
+}
+
+std::uint64_t MemorySettingsAction::getBudget() const
+{
+    if (!_enforceBudgetAction.isChecked())
+        return 0;
+
+    return static_cast<std::uint64_t>(_budgetAction.getValue()) * 1024ull * 1024ull;
+}
+
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "GlobalSettingsGroupAction.h"
+
+#include "actions/IntegralAction.h"
+#include "actions/StringAction.h"
+#include "actions/ToggleAction.h"
+
+namespace mv::gui
+{
+
+/**
+ * Memory settings action class
+ *
+ * Action class which groups all memory budget global settings
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT MemorySettingsAction final : public GlobalSettingsGroupAction
+{
+public:
+
+    /** Default memory budget in megabytes */
+    static constexpr std::int32_t defaultBudget = 8192;
+
+    /**
+     * Constructor
+     * @param parent Pointer to parent object
+     */
+    MemorySettingsAction(QObject* parent);
+
+    /**
+     * Get the memory budget
+     * @return Memory budget in bytes (zero when the budget is not enforced)
+     */
+    std::uint64_t getBudget() const;
+
+public: // Action getters
+
+    ToggleAction& getEnforceBudgetAction() { return _enforceBudgetAction; }
+    IntegralAction& getBudgetAction() { return _budgetAction; }
+    ToggleAction& getSpillToDiskAction() { return _spillToDiskAction; }
+    StringAction& getSpillDirectoryAction() { return _spillDirectoryAction; }
+
+private:
+    ToggleAction    _enforceBudgetAction;       /** Toggle enforcement of the memory budget on/off */
+    IntegralAction  _budgetAction;              /** Memory budget in megabytes */
+    ToggleAction    _spillToDiskAction;         /** Toggle spilling of least recently used raw data to disk on/off */
+    StringAction    _spillDirectoryAction;      /** Directory in which raw data is spilled */
+};
+
+}
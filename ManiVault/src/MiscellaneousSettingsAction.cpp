@@ -4,6 +4,7 @@
 // Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
 
 #include "MiscellaneousSettingsAction.h"
+#include "Application.h"
 #include "actions/StatusBarAction.h"
 
 namespace mv::gui
@@ -16,7 +17,8 @@ MiscellaneousSettingsAction::MiscellaneousSettingsAction(QObject* parent) :
     _keepDescendantsAfterRemovalAction(this, "Keep descendants after removal", true),
     _showSimplifiedGuidsAction(this, "Show simplified GUID's", true),
     _statusBarVisibleAction(this, "Show status bar", true),
-    _statusBarOptionsAction(this, "Status bar options", {}, { "Example View OpenGL", "Start Page", "Version", "Plugins", "Logging", "Background Tasks", "Foreground Tasks", "Settings", "Workspace" })
+    _statusBarOptionsAction(this, "Status bar options", {}, { "Example View OpenGL", "Start Page", "Version", "Plugins", "Logging", "Background Tasks", "Foreground Tasks", "Settings", "Workspace" }),
+    _logRetentionAction(this, "Log retention", 1000, 1000000, static_cast<std::int32_t>(util::Logger::defaultMaximumNumberOfRecords))
 {
     _statusBarOptionsAction.setDefaultWidgetFlag(OptionsAction::WidgetFlag::Selection);
     _statusBarOptionsAction.setEnabled(false);
@@ -24,6 +26,8 @@ MiscellaneousSettingsAction::MiscellaneousSettingsAction(QObject* parent) :
     _askConfirmationBeforeRemovingDatasetsAction.setToolTip("Ask confirmation prior to removal of datasets");
     _keepDescendantsAfterRemovalAction.setToolTip("If checked, descendants will not be removed and become orphans (placed at the root of the hierarchy)");
     _showSimplifiedGuidsAction.setToolTip("If checked, views will show a truncated version of a globally unique identifier");
+    _logRetentionAction.setToolTip("Maximum number of log messages kept in memory (the log file keeps all messages)");
+    _logRetentionAction.setSuffix(" messages");
 
     /* TODO: Fix plugin status bar action visibility
     const auto updateStatusBarOptionsActionReadOnly = [this]() -> void {
@@ -42,6 +46,15 @@ MiscellaneousSettingsAction::MiscellaneousSettingsAction(QObject* parent) :
     addAction(&_statusBarVisibleAction);
     addAction(&_statusBarOptionsAction);
     addAction(&_showSimplifiedGuidsAction);
+    addAction(&_logRetentionAction);
+
+    const auto updateLogRetention = [this]() -> void {
+        Application::getLogger().setMaximumNumberOfRecords(static_cast<std::size_t>(_logRetentionAction.getValue()));
+    };
+
+    updateLogRetention();
+
+    connect(&_logRetentionAction, &IntegralAction::valueChanged, this, updateLogRetention);
 }
 
 void MiscellaneousSettingsAction::updateStatusBarOptionsAction()
@@ -6,6 +6,7 @@
 
 #include "GlobalSettingsGroupAction.h"
 
+#include "actions/IntegralAction.h"
 #include "actions/OptionsAction.h"
 #include "actions/ToggleAction.h"
 
@@ -40,6 +41,7 @@ public: // Action getters
     ToggleAction& getShowSimplifiedGuidsAction() { return _showSimplifiedGuidsAction; }
     ToggleAction& getStatusBarVisibleAction() { return _statusBarVisibleAction; }
     OptionsAction& getStatusBarOptionsAction() { return _statusBarOptionsAction; }
+    IntegralAction& getLogRetentionAction() { return _logRetentionAction; }
 
 private:
     ToggleAction    _ignoreLoadingErrorsAction;                     /** Toggle between asking for ignoring loading errors or not */
@@ -48,6 +50,7 @@ private:
     ToggleAction    _showSimplifiedGuidsAction;                     /** Toggle between showing long or short GUIDS */
     ToggleAction    _statusBarVisibleAction;                        /** Action for toggling the status bar visibility */
     OptionsAction   _statusBarOptionsAction;                        /** Options action for toggling status bar items on/off */
+    IntegralAction  _logRetentionAction;                            /** Maximum number of log records kept in memory */
 };
 
 }
@@ -98,7 +98,7 @@ namespace mv
             {
                 std::vector<uint32_t> indices = _biMaps[i].getValuesByKeys(keys);
                 
-                d->setSelectionIndices(indices);
+                d->setSelectionIndices(std::move(indices));
 
                 d->markSelectionDirty(true);
             }
@@ -89,6 +89,11 @@ std::int32_t DatasetImpl::getSelectionSize() const
     return static_cast<std::int32_t>(const_cast<DatasetImpl*>(this)->getSelectionIndices().size());
 }
 
+void DatasetImpl::setSelectionIndices(std::vector<std::uint32_t>&& indices)
+{
+    setSelectionIndices(static_cast<const std::vector<std::uint32_t>&>(indices));
+}
+
 void DatasetImpl::lock(bool cache /*= false*/)
 {
     if (cache)
@@ -336,34 +341,53 @@ void DatasetImpl::addLinkedData(const mv::Dataset<DatasetImpl>& targetDataSet, m
 {
     _linkedData.emplace_back(toSmartPointer(), targetDataSet);
     _linkedData.back().setMapping(mapping);
+
+    events().notifyDatasetLinkedDataChanged(toSmartPointer());
 }
 
 void DatasetImpl::addLinkedData(const mv::Dataset<DatasetImpl>& targetDataSet, mv::SelectionMap&& mapping)
 {
     _linkedData.emplace_back(toSmartPointer(), targetDataSet);
     _linkedData.back().setMapping(std::move(mapping));
+
+    events().notifyDatasetLinkedDataChanged(toSmartPointer());
 }
 
 void DatasetImpl::removeAllLinkedData()
 {
+    if (_linkedData.empty())
+        return;
+
     _linkedData.clear();
+
+    events().notifyDatasetLinkedDataChanged(toSmartPointer());
 }
 
 void DatasetImpl::removeLinkedDataset(const mv::Dataset<DatasetImpl>& targetDataSet)
 {
     // Erase-remove idiom (https://en.wikibooks.org/wiki/More_C++_Idioms/Erase-Remove) 
     // Removes all mappings to targetDataSet from _linkedData
+    const auto numberOfLinkedDataBefore = _linkedData.size();
+
     _linkedData.erase(std::remove_if(_linkedData.begin(), _linkedData.end(), [targetDataSet](const mv::LinkedData& linkedSel) {
         return linkedSel.getTargetDataset() == targetDataSet;
     }), _linkedData.end());
+
+    if (_linkedData.size() != numberOfLinkedDataBefore)
+        events().notifyDatasetLinkedDataChanged(toSmartPointer());
 }
 
 void DatasetImpl::removeLinkedDataMapping(const QString& mappingID)
 {
     // Removes specific mapping from _linkedData
+    const auto numberOfLinkedDataBefore = _linkedData.size();
+
     _linkedData.erase(std::remove_if(_linkedData.begin(), _linkedData.end(), [mappingID](const mv::LinkedData& linkedSel) {
         return linkedSel.getId() == mappingID;
     }), _linkedData.end());
+
+    if (_linkedData.size() != numberOfLinkedDataBefore)
+        events().notifyDatasetLinkedDataChanged(toSmartPointer());
 }
 
 DatasetImpl::DatasetImpl(const QString& rawDataName, bool mayUnderive /*= true*/, const QString& id /*= ""*/) :
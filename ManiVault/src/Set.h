@@ -309,6 +309,17 @@ public: // Selection
      */
     virtual void setSelectionIndices(const std::vector<std::uint32_t>& indices) = 0;
 
+    /**
+     * Select by \p indices which are moved in, so that large selections are not copied (by default the indices are
+     * passed on to the copying overload, override to take ownership of them)
+     *
+     * Note: this virtual was added after ManiVault 1.2 and changes the layout of the DatasetImpl vtable, so data plugins
+     * built against an earlier core need to be recompiled. Derived classes which only override the copying overload
+     * should add "using DatasetImpl::setSelectionIndices;" so that this overload is not hidden.
+     * @param indices Selection indices
+     */
+    virtual void setSelectionIndices(std::vector<std::uint32_t>&& indices);
+
     /** Get size of the selection */
     std::int32_t getSelectionSize() const;
 
@@ -487,8 +498,18 @@ public: // Actions
 
 public: // Linked data
 
+    /**
+     * Adds linked data from this dataset to \p targetDataSet and notifies listeners that the linked data changed
+     * @param targetDataSet Target dataset
+     * @param mapping Selection mapping from this dataset to \p targetDataSet
+     */
     void addLinkedData(const mv::Dataset<DatasetImpl>& targetDataSet, mv::SelectionMap& mapping);
 
+    /**
+     * Adds linked data from this dataset to \p targetDataSet and notifies listeners that the linked data changed
+     * @param targetDataSet Target dataset
+     * @param mapping Selection mapping from this dataset to \p targetDataSet (moved)
+     */
     void addLinkedData(const mv::Dataset<DatasetImpl>& targetDataSet, mv::SelectionMap&& mapping);
 
     /**
@@ -510,6 +531,10 @@ public: // Linked data
 
     const std::vector<mv::LinkedData>& getLinkedData() const;
 
+    /**
+     * Get mutable linked data, callers that modify it in place are responsible for calling mv::events().notifyDatasetLinkedDataChanged(...) afterwards
+     * @return Reference to the linked data
+     */
     std::vector<mv::LinkedData>& getLinkedData();
 
     /**
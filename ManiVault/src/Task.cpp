@@ -5,6 +5,8 @@
 #include "Task.h"
 #include "CoreInterface.h"
 
+#include "util/Trace.h"
+
 #ifdef _DEBUG
     //#define TASK_VERBOSE
 #endif
@@ -65,7 +67,8 @@ Task::Task(QObject* parent, const QString& name, const GuiScopes& guiScopes /*=
     _parentTask(nullptr),
     _childTasks(),
     _progressText(),
-    _progressTextFormatter()
+    _progressTextFormatter(),
+    _traceStart(-1)
 {
     privateAddToTaskManager();
     
@@ -1148,6 +1151,19 @@ void Task::privateSetStatus(const Status& status, bool recursive /*= false*/)
             break;
     }
 
+    const auto wasRunning   = previousStatus == Status::Running || previousStatus == Status::RunningIndeterminate;
+    const auto isRunning    = _status == Status::Running || _status == Status::RunningIndeterminate;
+
+    // Trace the period in which the task runs
+    if (!wasRunning && isRunning)
+        _traceStart = Tracer::isEnabled() ? Tracer::now() : -1;
+
+    if (wasRunning && !isRunning && _traceStart >= 0) {
+        Tracer::recordSpan("task", "Task", getName(), _traceStart, Tracer::now());
+
+        _traceStart = -1;
+    }
+
     updateProgress();
 
     emit statusChanged(previousStatus, _status);
@@ -982,6 +982,7 @@ private:
     TasksPtrs               _childTasks;                                    /** Pointers to child tasks */
     QString                 _progressText;                                  /** Progress text */
     ProgressTextFormatter   _progressTextFormatter;                         /** Progress text formatter function (overrides Task::getProgressText() when set) */
+    std::int64_t            _traceStart;                                    /** Trace time at which the task started running (negative when not traced) */
 
 private:
     static constexpr std::uint32_t EMIT_CHANGED_TIMER_INTERVAL      = 100;      /** Single shot task progress and description timer interval */
@@ -113,6 +113,27 @@ void ColorMapEditor1DAction::setHistogram(const Histogram& histogram)
     emit histogramChanged(_histogram);
 }
 
+const mv::gui::ColorMapEditor1DAction::Histogram& ColorMapEditor1DAction::getSelectionHistogram() const
+{
+    return _selectionHistogram;
+}
+
+void ColorMapEditor1DAction::setSelectionHistogram(const Histogram& selectionHistogram)
+{
+    if (selectionHistogram == _selectionHistogram)
+        return;
+
+    _selectionHistogram = selectionHistogram;
+
+    emit selectionHistogramChanged(_selectionHistogram);
+}
+
+void ColorMapEditor1DAction::setHistogram(const util::DualHistogram& dualHistogram)
+{
+    setHistogram(dualHistogram.getAll().getBins());
+    setSelectionHistogram(dualHistogram.getSelected().getBins());
+}
+
 void ColorMapEditor1DAction::sortNodes()
 {
     std::sort(_nodes.begin(), _nodes.end(), [](auto nodeA, auto nodeB) -> bool {
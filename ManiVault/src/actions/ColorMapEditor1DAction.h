@@ -10,6 +10,8 @@
 
 #include "TriggerAction.h"
 
+#include "util/DualHistogram.h"
+
 namespace mv::gui {
 
 class ColorMapAction;
@@ -27,7 +29,7 @@ class CORE_EXPORT ColorMapEditor1DAction : public WidgetAction
 
 public:
 
-    using Histogram = QVector<std::uint32_t>;
+    using Histogram = util::Histogram::Bins;
 
 public:
 
@@ -129,6 +131,24 @@ public: // Histogram
      */
     void setHistogram(const Histogram& histogram);
 
+    /**
+     * Get one-dimensional histogram of the selected points
+     * @return One-dimensional histogram of the selected points (empty when not set)
+     */
+    const Histogram& getSelectionHistogram() const;
+
+    /**
+     * Set background one-dimensional histogram of the selected points (drawn on top of the histogram of all points)
+     * @param selectionHistogram One-dimensional histogram of the selected points
+     */
+    void setSelectionHistogram(const Histogram& selectionHistogram);
+
+    /**
+     * Set background one-dimensional histograms of all points and of the selected points (e.g. from mv::Points::getHistogram())
+     * @param dualHistogram Histograms of all points and of the selected points
+     */
+    void setHistogram(const util::DualHistogram& dualHistogram);
+
 protected:
 
     /** Sort nodes and update their index */
@@ -197,12 +217,19 @@ signals:
      */
     void histogramChanged(const Histogram& histogram);
 
+    /**
+     * Signals that the histogram of the selected points changed
+     * @param selectionHistogram Histogram of the selected points
+     */
+    void selectionHistogramChanged(const Histogram& selectionHistogram);
+
 protected:
-    ColorMapAction&                 _colorMapAction;    /** Reference to color map action */
-    QVector<ColorMapEditor1DNode*>  _nodes;             /** All sorted nodes */
-    ColorMapEditor1DNodeAction      _nodeAction;        /** Node action */
-    QImage                          _colorMapImage;     /** Output color map image */
-    Histogram                       _histogram;         /** Histogram */
+    ColorMapAction&                 _colorMapAction;        /** Reference to color map action */
+    QVector<ColorMapEditor1DNode*>  _nodes;                 /** All sorted nodes */
+    ColorMapEditor1DNodeAction      _nodeAction;            /** Node action */
+    QImage                          _colorMapImage;         /** Output color map image */
+    Histogram                       _histogram;             /** Histogram */
+    Histogram                       _selectionHistogram;    /** Histogram of the selected points */
 
     static constexpr QSize colorMapImageSize = QSize(256, 1);
 
@@ -33,6 +33,10 @@ ColorMapEditor1DHistogramGraphicsItem::ColorMapEditor1DHistogramGraphicsItem(Col
     connect(&colorMapEditor1DWidget.getColorMapEditor1DAction(), &ColorMapEditor1DAction::histogramChanged, this, [this]() -> void {
         update();
     });
+
+    connect(&colorMapEditor1DWidget.getColorMapEditor1DAction(), &ColorMapEditor1DAction::selectionHistogramChanged, this, [this]() -> void {
+        update();
+    });
 }
 
 bool ColorMapEditor1DHistogramGraphicsItem::eventFilter(QObject* target, QEvent* event)
@@ -65,44 +69,54 @@ void ColorMapEditor1DHistogramGraphicsItem::paint(QPainter* painter, const QStyl
     qDebug() << __FUNCTION__;
 #endif
 
-    QVector<QPointF> points;
-
-    const auto graphRectangle   = _colorMapEditor1DWidget.getGraphRectangle();
-    const auto histogram        = _colorMapEditor1DWidget.getColorMapEditor1DAction().getHistogram();
+    const auto graphRectangle       = _colorMapEditor1DWidget.getGraphRectangle();
+    const auto histogram            = _colorMapEditor1DWidget.getColorMapEditor1DAction().getHistogram();
+    const auto selectionHistogram   = _colorMapEditor1DWidget.getColorMapEditor1DAction().getSelectionHistogram();
 
     if (histogram.isEmpty())
         return;
 
+    // Both histograms are scaled to the maximum of the histogram of all points, so that the selection reads as a part of it
     const auto binMax = 1.1f * *std::max_element(histogram.begin(), histogram.end());
 
-    std::uint32_t binIndex = 0;
+    const auto drawHistogram = [painter, &graphRectangle, binMax](const ColorMapEditor1DAction::Histogram& histogram, const QColor& lineColor, const QColor& fillColor) -> void {
+        QVector<QPointF> points;
 
-    for (const auto& bin : histogram) {
-        const auto binNormalized = QPointF(static_cast<float>(binIndex) / (histogram.count() - 1), static_cast<float>(bin) / binMax);
+        std::uint32_t binIndex = 0;
 
-        points << graphRectangle.bottomLeft() + QPointF(binNormalized.x() * graphRectangle.width(), -binNormalized.y() * graphRectangle.height());
+        for (const auto& bin : histogram) {
+            const auto binNormalized = QPointF(static_cast<float>(binIndex) / (histogram.count() - 1), static_cast<float>(bin) / binMax);
 
-        binIndex++;
-    }
+            points << graphRectangle.bottomLeft() + QPointF(binNormalized.x() * graphRectangle.width(), -binNormalized.y() * graphRectangle.height());
 
-    QStyleOption styleOption;
+            binIndex++;
+        }
+
+        QPen pen;
+
+        pen.setWidthF(1.5f);
+        pen.setColor(lineColor);
 
-    styleOption.initFrom(&_colorMapEditor1DWidget);
+        painter->setPen(pen);
+        painter->drawPolyline(points.data(), points.count());
 
-    QPen pen;
+        points.insert(0, graphRectangle.bottomLeft());
+        points << graphRectangle.bottomRight();
 
-    pen.setWidthF(1.5f);
-    pen.setColor(_colorMapEditor1DWidget.isEnabled() ? QColor(150, 150, 150, 100) : QColor(150, 150, 150, 40));
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(fillColor);
+        painter->drawPolygon(points.data(), points.count());
+    };
 
-    painter->setPen(pen);
-    painter->drawPolyline(points.data(), points.count());
+    const auto isEnabled = _colorMapEditor1DWidget.isEnabled();
 
-    points.insert(0, graphRectangle.bottomLeft());
-    points << graphRectangle.bottomRight();
+    drawHistogram(histogram, isEnabled ? QColor(150, 150, 150, 100) : QColor(150, 150, 150, 40), QColor(150, 150, 150, isEnabled ? 50 : 20));
 
-    painter->setPen(Qt::NoPen);
-    painter->setBrush(QColor(150, 150, 150, _colorMapEditor1DWidget.isEnabled() ? 50 : 20));
-    painter->drawPolygon(points.data(), points.count());
+    if (selectionHistogram.count() == histogram.count()) {
+        const auto selectionColor = _colorMapEditor1DWidget.palette().color(QPalette::Highlight);
+
+        drawHistogram(selectionHistogram, QColor(selectionColor.red(), selectionColor.green(), selectionColor.blue(), isEnabled ? 150 : 60), QColor(selectionColor.red(), selectionColor.green(), selectionColor.blue(), isEnabled ? 60 : 20));
+    }
 }
 
 }
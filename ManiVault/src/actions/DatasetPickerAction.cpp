@@ -67,6 +67,11 @@ DatasetPickerAction::DatasetPickerAction(QObject* parent, const QString& title)
     connect(&_datasetsFilterModel, &QSortFilterProxyModel::dataChanged, this, filterModelChanged);
     connect(&_datasetsFilterModel, &QSortFilterProxyModel::layoutChanged, this, filterModelChanged);
 
+    connect(&_datasetsFilterModel, &QSortFilterProxyModel::rowsInserted, this, [this]() -> void {
+        if (!_pendingCurrentDatasetId.isEmpty())
+            setCurrentDataset(QString(_pendingCurrentDatasetId));
+    });
+
     populationModeChanged();
 }
 
@@ -173,8 +178,14 @@ void DatasetPickerAction::setCurrentDataset(Dataset<DatasetImpl> currentDataset)
         }
     }
 
-    if (!datasetIndex.isValid())
+    if (!datasetIndex.isValid()) {
+        if (currentDataset.isValid() && getDatasetsModel().isDatasetPending(currentDataset->getId()))
+            _pendingCurrentDatasetId = currentDataset->getId();
+
         return;
+    }
+
+    _pendingCurrentDatasetId.clear();
 
     setCurrentIndex(_datasetsFilterModel.mapFromSource(datasetIndex).row());
 }
@@ -197,8 +208,14 @@ void DatasetPickerAction::setCurrentDataset(const QString& datasetId)
             break;
     }
 
-    if (!datasetIndex.isValid())
+    if (!datasetIndex.isValid()) {
+        if (getDatasetsModel().isDatasetPending(datasetId))
+            _pendingCurrentDatasetId = datasetId;
+
         return;
+    }
+
+    _pendingCurrentDatasetId.clear();
 
     setCurrentIndex(_datasetsFilterModel.mapFromSource(datasetIndex).row());
 }
@@ -250,6 +267,14 @@ void DatasetPickerAction::populationModeChanged()
     }
 }
 
+const AbstractDatasetsModel& DatasetPickerAction::getDatasetsModel() const
+{
+    if (_populationMode == AbstractDatasetsModel::PopulationMode::Manual)
+        return _datasetsListModel;
+
+    return mv::data().getDatasetsListModel();
+}
+
 void DatasetPickerAction::blockDatasetsChangedSignal()
 {
     _blockDatasetsChangedSignal = true;
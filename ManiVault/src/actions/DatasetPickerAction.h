@@ -78,13 +78,13 @@ public:
     }
 
     /**
-     * Set current dataset to \p currentDataset
+     * Set current dataset to \p currentDataset (when the dataset was just added, it is selected once it is inserted in the datasets model)
      * @param currentDataset Smart pointer to current dataset
      */
     void setCurrentDataset(mv::Dataset<mv::DatasetImpl> currentDataset);
 
     /**
-     * Set current dataset by \p datasetId
+     * Set current dataset by \p datasetId (when the dataset was just added, it is selected once it is inserted in the datasets model)
      * @param datasetId Current dataset globally unique identifier
      */
     void setCurrentDataset(const QString& datasetId);
@@ -114,6 +114,12 @@ private:
     /** Handle changes to the population mode */
     void populationModeChanged();
 
+    /**
+     * Get the datasets model from which the picker is populated
+     * @return Reference to the datasets model (mv::data().getDatasetsListModel() in automatic population mode)
+     */
+    const AbstractDatasetsModel& getDatasetsModel() const;
+
     /** Blocks the DatasetPickerAction::datasetsChanged() signal from being emitted */
     void blockDatasetsChangedSignal();
 
@@ -200,6 +206,7 @@ private:
     DatasetsFilterModel                     _datasetsFilterModel;           /** Filter model for the datasets model above */
     bool                                    _blockDatasetsChangedSignal;    /** Boolean determining whether the DatasetPickerAction::datasetsChanged(...) signal may be engaged in reponse to change in the DatasetPickerAction#_filterModel */
     QStringList                             _currentDatasetsIds;            /** Keep a list of current datasets identifiers so that we can avoid unnecessary emits of the DatasetPickerAction::datasetsChanged(...) signal */
+    QString                                 _pendingCurrentDatasetId;       /** Globally unique identifier of the dataset which is selected once it is inserted in the datasets model */
 
     static bool noValueSerialization;   /** Prevent the value from being serialized (used by preset serialization) */
 
@@ -36,6 +36,8 @@ QWidget* PluginTriggerPickerAction::getWidget(QWidget* parent, const std::int32_
 
 void PluginTriggerPickerAction::initialize(const plugin::Type& pluginType, const Datasets& datasets)
 {
+    Application::core()->getPluginManager().loadDeferredPluginFactories({ pluginType });
+
     _pluginTriggerActions = Application::core()->getPluginManager().getPluginTriggerActions(pluginType, datasets);
 
     emit pluginTriggerActionsChanged(_pluginTriggerActions);
@@ -43,6 +45,8 @@ void PluginTriggerPickerAction::initialize(const plugin::Type& pluginType, const
 
 void PluginTriggerPickerAction::initialize(const plugin::Type& pluginType, const DataTypes& dataTypes)
 {
+    Application::core()->getPluginManager().loadDeferredPluginFactories({ pluginType });
+
     _pluginTriggerActions = Application::core()->getPluginManager().getPluginTriggerActions(pluginType, dataTypes);
 
     emit pluginTriggerActionsChanged(_pluginTriggerActions);
@@ -50,6 +54,8 @@ void PluginTriggerPickerAction::initialize(const plugin::Type& pluginType, const
 
 void PluginTriggerPickerAction::initialize(const QString& pluginKind, const Datasets& datasets)
 {
+    Application::core()->getPluginManager().loadDeferredPluginFactory(pluginKind);
+
     _pluginTriggerActions = Application::core()->getPluginManager().getPluginTriggerActions(pluginKind, datasets);
 
     emit pluginTriggerActionsChanged(_pluginTriggerActions);
@@ -57,6 +63,8 @@ void PluginTriggerPickerAction::initialize(const QString& pluginKind, const Data
 
 void PluginTriggerPickerAction::initialize(const QString& pluginKind, const DataTypes& dataTypes)
 {
+    Application::core()->getPluginManager().loadDeferredPluginFactory(pluginKind);
+
     _pluginTriggerActions = Application::core()->getPluginManager().getPluginTriggerActions(pluginKind, dataTypes);
 
     emit pluginTriggerActionsChanged(_pluginTriggerActions);
@@ -137,7 +137,10 @@ TasksTreeAction::TasksTreeAction(QObject* parent, const QString& title) :
 
         widget->layout()->setContentsMargins(0, 0, 0, 0);
 
-        _loadTasksPluginAction.setEnabled(mv::plugins().getPluginFactory("Tasks")->getNumberOfInstances() == 0);
+        // A deferred plugin has no instances yet
+        const auto tasksPluginFactory = mv::plugins().getPluginFactory("Tasks");
+
+        _loadTasksPluginAction.setEnabled(tasksPluginFactory ? tasksPluginFactory->getNumberOfInstances() == 0 : mv::plugins().isPluginDeferred("Tasks"));
 
         auto hierarchyWidget = widget->findChild<HierarchyWidget*>("HierarchyWidget");
 
@@ -35,7 +35,8 @@ enum class EventType
     DatasetChildAdded,
     DatasetChildRemoved,
     DatasetLocked,
-    DatasetUnlocked
+    DatasetUnlocked,
+    DatasetLinkedDataChanged
 };
 
 class CORE_EXPORT ManiVaultEvent
@@ -351,6 +352,24 @@ public:
     }
 };
 
+/**
+ * Dataset linked data changed event class
+ * Dataset event which is emitted by the core when linked data of a dataset is added, removed or when its mapping changes
+ */
+class CORE_EXPORT DatasetLinkedDataChangedEvent : public DatasetEvent
+{
+public:
+
+    /**
+     * Constructor
+     * @param dataset Smart pointer to the dataset
+     */
+    DatasetLinkedDataChangedEvent(const Dataset<DatasetImpl>& dataset) :
+        DatasetEvent(EventType::DatasetLinkedDataChanged, dataset)
+    {
+    }
+};
+
 /**
  * Dataset grouping event class
  * Event container class for datasets grouping events
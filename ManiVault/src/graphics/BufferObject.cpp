@@ -4,6 +4,8 @@
 
 #include "BufferObject.h"
 
+#include "util/MemoryAccounting.h"
+
 namespace mv
 {
 
@@ -15,7 +17,7 @@ BufferObject::BufferObject() :
 
 BufferObject::~BufferObject()
 {
-
+    setNumberOfBytes(0);
 }
 
 void BufferObject::create()
@@ -32,6 +34,13 @@ void BufferObject::bind()
 void BufferObject::destroy()
 {
     glDeleteBuffers(1, &_object);
+
+    setNumberOfBytes(0);
+}
+
+void BufferObject::setNumberOfBytes(std::uint64_t numberOfBytes)
+{
+    util::MemoryAccounting::setAllocation(util::MemoryAccounting::Category::GpuBuffer, QString("Buffer object %1").arg(reinterpret_cast<quintptr>(this), 0, 16), numberOfBytes);
 }
 
 } // namespace mv
@@ -8,6 +8,7 @@
 
 #include <QOpenGLFunctions_3_3_Core>
 
+#include <cstdint>
 #include <vector>
 
 namespace mv
@@ -25,9 +26,20 @@ public:
     void setData(const std::vector<T>& data)
     {
         glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(T), data.data(), GL_STATIC_DRAW);
+
+        setNumberOfBytes(data.size() * sizeof(T));
     }
 
     void destroy();
+
+private:
+
+    /**
+     * Report the size of the buffer storage to the memory accounting (see util::MemoryAccounting)
+     * @param numberOfBytes Number of bytes
+     */
+    void setNumberOfBytes(std::uint64_t numberOfBytes);
+
 private:
     GLuint _object;
 };
@@ -99,7 +99,9 @@ ShaderProgram::ShaderProgram() :
 }
 
 ShaderProgram::~ShaderProgram() {
-    glDeleteProgram(_handle);
+    // The OpenGL functions are only resolved once the program is created (a CPU-only mean shift never creates its programs)
+    if (_handle != 0)
+        glDeleteProgram(_handle);
 }
 
 void ShaderProgram::bind() {
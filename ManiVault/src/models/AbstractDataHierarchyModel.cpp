@@ -243,11 +243,8 @@ QVariant AbstractDataHierarchyModel::RawDataSizeItem::data(int role /*= Qt::User
 }
 
 AbstractDataHierarchyModel::ProgressItem::ProgressItem(Dataset<DatasetImpl> dataset) :
-    Item(dataset),
-    _taskAction(this, "Task")
+    Item(dataset)
 {
-    _taskAction.setTask(&getDatasetTask());
-
     connect(&getDatasetTask(), &Task::progressChanged, this, [this]() -> void {
         emitDataChanged();
     });
@@ -280,9 +277,20 @@ QVariant AbstractDataHierarchyModel::ProgressItem::data(int role /*= Qt::UserRol
     return Item::data(role);
 }
 
+gui::TaskAction& AbstractDataHierarchyModel::ProgressItem::getTaskAction()
+{
+    if (!_taskAction) {
+        _taskAction = std::make_unique<gui::TaskAction>(this, "Task");
+
+        _taskAction->setTask(&getDatasetTask());
+    }
+
+    return *_taskAction;
+}
+
 QWidget* AbstractDataHierarchyModel::ProgressItem::createDelegateEditorWidget(QWidget* parent)
 {
-    return _taskAction.getProgressAction().createWidget(parent);
+    return getTaskAction().getProgressAction().createWidget(parent);
 }
 
 AbstractDataHierarchyModel::SelectionGroupIndexItem::SelectionGroupIndexItem(Dataset<DatasetImpl> dataset) :
@@ -640,12 +648,42 @@ QMimeData* AbstractDataHierarchyModel::mimeData(const QModelIndexList& indexes)
 
 QModelIndex AbstractDataHierarchyModel::getModelIndex(const QString& datasetId, Column column /*= Column::Name*/) const
 {
-    const auto matches = match(index(0, static_cast<int>(AbstractDataHierarchyModel::Column::Name)), Qt::EditRole, datasetId, 1, Qt::MatchRecursive | Qt::MatchExactly);
+    const auto it = _modelIndices.constFind(datasetId);
 
-    if (matches.isEmpty())
+    if (it == _modelIndices.constEnd())
         return {};
 
-    return matches.first().siblingAtColumn(static_cast<int>(column));
+    // Persistent indices are invalidated when an ancestor row is removed
+    if (!it->isValid()) {
+        _modelIndices.erase(it);
+        return {};
+    }
+
+    return it->sibling(it->row(), static_cast<int>(column));
+}
+
+void AbstractDataHierarchyModel::appendDatasetRow(Dataset<DatasetImpl> dataset, QStandardItem* parentItem /*= nullptr*/)
+{
+    const auto row = Row(dataset);
+
+    if (parentItem)
+        parentItem->appendRow(row);
+    else
+        appendRow(row);
+
+    _modelIndices[dataset->getId()] = QPersistentModelIndex(row.first()->index());
+}
+
+bool AbstractDataHierarchyModel::removeDatasetRow(const QString& datasetId)
+{
+    const auto modelIndex = getModelIndex(datasetId);
+
+    _modelIndices.remove(datasetId);
+
+    if (!modelIndex.isValid())
+        return false;
+
+    return removeRows(modelIndex.row(), 1, modelIndex.parent());
 }
 
 void AbstractDataHierarchyModel::hideItem(const QModelIndex& index)
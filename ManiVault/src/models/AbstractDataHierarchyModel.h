@@ -13,9 +13,13 @@
 
 #include "actions/TaskAction.h"
 
+#include <QHash>
 #include <QList>
 #include <QStandardItem>
 #include <QMimeData>
+#include <QPersistentModelIndex>
+
+#include <memory>
 
 namespace mv {
 
@@ -350,12 +354,10 @@ public:
         }
 
         /**
-         * Get task action
+         * Get task action (created on first use, so that rows which are never edited do not own one)
          * @return Task action for use in item delegate (its built-in progress action)
          */
-        gui::TaskAction& getTaskAction() {
-            return _taskAction;
-        }
+        gui::TaskAction& getTaskAction();
 
         /**
          * Create delegate editor widget as child of \p parent
@@ -365,7 +367,7 @@ public:
         QWidget* createDelegateEditorWidget(QWidget* parent);
 
     private:
-        gui::TaskAction     _taskAction;    /** Task action for use in item delegate (uses its built-in progress action) */
+        std::unique_ptr<gui::TaskAction>    _taskAction;    /** Task action for use in item delegate (uses its built-in progress action), created on demand */
     };
 
     /** Standard model item class for displaying the selection group index */
@@ -706,6 +708,25 @@ public:
      * @param index Index of the item to un-hide (column index must be zero)
      */
     void unhideItem(const QModelIndex& index);
+
+protected:
+
+    /**
+     * Append a row for \p dataset to \p parentItem and register its model index
+     * @param dataset Smart pointer to the dataset to append a row for
+     * @param parentItem Pointer to the parent item (the row is appended to the root when nullptr)
+     */
+    void appendDatasetRow(Dataset<DatasetImpl> dataset, QStandardItem* parentItem = nullptr);
+
+    /**
+     * Remove the row of \p datasetId (and the rows of its descendants)
+     * @param datasetId Globally unique identifier of the dataset
+     * @return Whether the row was found and removed
+     */
+    bool removeDatasetRow(const QString& datasetId);
+
+private:
+    mutable QHash<QString, QPersistentModelIndex>   _modelIndices;  /** Model index (name column) by dataset identifier, so that rows are found without searching the whole model */
 };
 
 }
\ No newline at end of file
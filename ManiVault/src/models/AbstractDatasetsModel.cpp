@@ -12,6 +12,9 @@
 
 #include <actions/WidgetAction.h>
 
+#include <algorithm>
+#include <functional>
+
 #ifdef _DEBUG
     #define ABSTRACT_DATASETS_MODEL_VERBOSE
 #endif
@@ -22,191 +25,190 @@ namespace mv
 using namespace util;
 using namespace gui;
 
-AbstractDatasetsModel::HeaderItem::HeaderItem(const ColumHeaderInfo& columHeaderInfo) :
-    QStandardItem(),
-    _columHeaderInfo(columHeaderInfo)
-{
-}
+QMap<AbstractDatasetsModel::Column, AbstractDatasetsModel::ColumHeaderInfo> AbstractDatasetsModel::columnInfo = QMap<AbstractDatasetsModel::Column, AbstractDatasetsModel::ColumHeaderInfo>({
+    { AbstractDatasetsModel::Column::Name, { "Name" , "Name", "Name of the dataset" } },
+    { AbstractDatasetsModel::Column::Location, { "" , "Enabled", "Whether the dataset is enabled or not" } },
+    { AbstractDatasetsModel::Column::ID, { "ID",  "ID", "Globally unique identifier of the dataset" } },
+    { AbstractDatasetsModel::Column::RawDataName, { "Raw data name",  "Raw data name", "Name of the raw data" } },
+    { AbstractDatasetsModel::Column::SourceDatasetID, { "Source dataset ID",  "Source dataset ID", "Globally unique identifier of the source dataset" } }
+});
 
-QVariant AbstractDatasetsModel::HeaderItem::data(int role /*= Qt::UserRole + 1*/) const
+AbstractDatasetsModel::AbstractDatasetsModel(PopulationMode populationMode /*= PopulationMode::Automatic*/, QObject* parent /*= nullptr*/) :
+    QAbstractTableModel(parent),
+    _populationMode(),
+    _showIconAction(this, "Show icon", true),
+    _numberOfRowsAction(nullptr, "Number of rows"),
+    _rowIndicesDirty(false)
 {
-    switch (role)
-    {
-        case Qt::DisplayRole:
-            return _columHeaderInfo._display;
+    _numberOfRowsAction.initialize(this);
 
-        case Qt::EditRole:
-            return _columHeaderInfo._edit;
+    _batchTimer.setSingleShot(true);
+    _batchTimer.setInterval(0);
 
-        case Qt::ToolTipRole:
-            return _columHeaderInfo._tooltip;
+    connect(&_batchTimer, &QTimer::timeout, this, &AbstractDatasetsModel::insertPendingDatasets);
 
-        default:
-            break;
-    }
+    connect(&_showIconAction, &ToggleAction::toggled, this, [this](bool toggled) -> void {
+        if (!_datasets.isEmpty())
+            emit dataChanged(index(0, static_cast<int>(Column::Name)), index(rowCount() - 1, static_cast<int>(Column::Name)), { Qt::DecorationRole });
+    });
 
-    return QVariant();
+    setPopulationMode(populationMode);
 }
 
-AbstractDatasetsModel::Item::Item(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset, bool editable /*= false*/) :
-    QStandardItem(),
-    QObject(),
-    _datasetsModel(datasetsModel),
-    _dataset(dataset)
+int AbstractDatasetsModel::rowCount(const QModelIndex& parent /*= QModelIndex()*/) const
 {
-    Q_ASSERT(_dataset.isValid());
+    if (parent.isValid())
+        return 0;
 
-    setEditable(editable);
-    setDropEnabled(true);
+    return static_cast<int>(_datasets.count());
 }
 
-AbstractDatasetsModel& AbstractDatasetsModel::Item::getDatasetsModel()
+int AbstractDatasetsModel::columnCount(const QModelIndex& parent /*= QModelIndex()*/) const
 {
-    return _datasetsModel;
-}
+    if (parent.isValid())
+        return 0;
 
-Dataset<DatasetImpl>& AbstractDatasetsModel::Item::getDataset()
-{
-    return _dataset;
+    return static_cast<int>(Column::Count);
 }
 
-AbstractDatasetsModel::NameItem::NameItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset) :
-    Item(datasetsModel, dataset)
+QVariant AbstractDatasetsModel::data(const QModelIndex& index, int role /*= Qt::DisplayRole*/) const
 {
-    connect(&datasetsModel.getShowIconAction(), &ToggleAction::toggled, this, [this](bool toggled) -> void {
-        emitDataChanged();
-    });
+    if (!index.isValid() || index.row() >= _datasets.count())
+        return {};
 
-    connect(getDataset().get(), &DatasetImpl::textChanged, this, [this](const QString& name) -> void {
-        emitDataChanged();
-    });
-}
+    const auto& dataset = _datasets[index.row()];
 
-QVariant AbstractDatasetsModel::NameItem::data(int role /*= Qt::UserRole + 1*/) const
-{
-    auto nonConstThis = const_cast<AbstractDatasetsModel::NameItem*>(this);
+    if (!dataset.isValid())
+        return {};
 
-    switch (role) {
-        case Qt::EditRole:
-        case Qt::DisplayRole:
-            return nonConstThis->getDataset()->getGuiName();
+    switch (static_cast<Column>(index.column()))
+    {
+        case Column::Name:
+        {
+            switch (role) {
+                case Qt::EditRole:
+                case Qt::DisplayRole:
+                    return dataset.get()->getGuiName();
 
-        case Qt::ToolTipRole:
-            return "Dataset name: " + data(Qt::DisplayRole).toString();
+                case Qt::ToolTipRole:
+                    return "Dataset name: " + dataset.get()->getGuiName();
 
-        case Qt::DecorationRole:
-            return nonConstThis->getDatasetsModel().getShowIconAction().isChecked() ? nonConstThis->getDataset()->getIcon() : QIcon();
+                case Qt::DecorationRole:
+                    return _showIconAction.isChecked() ? dataset.get()->getIcon() : QIcon();
+
+                default:
+                    break;
+            }
 
-        default:
             break;
-    }
+        }
 
-    return Item::data(role);
-}
+        case Column::Location:
+        {
+            switch (role) {
+                case Qt::EditRole:
+                case Qt::DisplayRole:
+                    return dataset.get()->getLocation();
 
-AbstractDatasetsModel::LocationItem::LocationItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset) :
-    Item(datasetsModel, dataset)
-{
-    connect(getDataset().get(), &DatasetImpl::locationChanged, this, [this](const QString& location) -> void {
-        emitDataChanged();
-    });
-}
-
-QVariant AbstractDatasetsModel::LocationItem::data(int role /*= Qt::UserRole + 1*/) const
-{
-    switch (role) {
-        case Qt::EditRole:
-        case Qt::DisplayRole:
-            return const_cast<AbstractDatasetsModel::LocationItem*>(this)->getDataset()->getLocation();
+                case Qt::ToolTipRole:
+                    return "Dataset location: " + dataset.get()->getLocation();
 
-        case Qt::ToolTipRole:
-            return "Dataset location: " + data(Qt::DisplayRole).toString();
+                default:
+                    break;
+            }
 
-        default:
             break;
-    }
+        }
 
-    return Item::data(role);
-}
+        case Column::ID:
+        {
+            switch (role) {
+                case Qt::EditRole:
+                case Qt::DisplayRole:
+                    return dataset.get()->getId();
 
-AbstractDatasetsModel::IdItem::IdItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset) :
-    Item(datasetsModel, dataset)
-{
-    connect(getDataset().get(), &DatasetImpl::idChanged, this, [this](const QString& id) -> void {
-        emitDataChanged();
-    });
-}
+                case Qt::ToolTipRole:
+                    return "Dataset globally unique identifier: " + dataset.get()->getId();
 
-QVariant AbstractDatasetsModel::IdItem::data(int role /*= Qt::UserRole + 1*/) const
-{
-    switch (role) {
-        case Qt::EditRole:
-        case Qt::DisplayRole:
-            return const_cast<AbstractDatasetsModel::IdItem*>(this)->getDataset()->getId();
+                default:
+                    break;
+            }
 
-        case Qt::ToolTipRole:
-            return "Dataset globally unique identifier: " + data(Qt::DisplayRole).toString();
+            break;
+        }
+
+        case Column::RawDataName:
+        {
+            switch (role) {
+                case Qt::EditRole:
+                case Qt::DisplayRole:
+                    return dataset.get()->getRawDataName();
+
+                case Qt::ToolTipRole:
+                    return "Raw data name: " + dataset.get()->getRawDataName();
+
+                default:
+                    break;
+            }
 
-        default:
             break;
-    }
+        }
 
-    return Item::data(role);
-}
+        case Column::SourceDatasetID:
+        {
+            switch (role) {
+                case Qt::EditRole:
+                case Qt::DisplayRole:
+                    return dataset.get()->getSourceDataset<DatasetImpl>()->getId();
 
-QVariant AbstractDatasetsModel::RawDataNameItem::data(int role /*= Qt::UserRole + 1*/) const
-{
-    switch (role) {
-        case Qt::EditRole:
-        case Qt::DisplayRole:
-            return const_cast<AbstractDatasetsModel::RawDataNameItem*>(this)->getDataset()->getRawDataName();
+                case Qt::ToolTipRole:
+                    return "Source dataset ID: " + data(index, Qt::DisplayRole).toString();
 
-        case Qt::ToolTipRole:
-            return "Raw data name: " + data(Qt::DisplayRole).toString();
+                default:
+                    break;
+            }
+
+            break;
+        }
 
         default:
             break;
     }
 
-    return Item::data(role);
+    return {};
 }
 
-QVariant AbstractDatasetsModel::SourceDatasetIdItem::data(int role /*= Qt::UserRole + 1*/) const
+QVariant AbstractDatasetsModel::headerData(int section, Qt::Orientation orientation, int role /*= Qt::DisplayRole*/) const
 {
-    switch (role) {
-        case Qt::EditRole:
+    if (orientation != Qt::Horizontal || !columnInfo.contains(static_cast<Column>(section)))
+        return {};
+
+    const auto& columHeaderInfo = columnInfo[static_cast<Column>(section)];
+
+    switch (role)
+    {
         case Qt::DisplayRole:
-            return const_cast<AbstractDatasetsModel::SourceDatasetIdItem*>(this)->getDataset()->getSourceDataset<DatasetImpl>()->getId();
+            return columHeaderInfo._display;
+
+        case Qt::EditRole:
+            return columHeaderInfo._edit;
 
         case Qt::ToolTipRole:
-            return "Source dataset ID: " + data(Qt::DisplayRole).toString();
+            return columHeaderInfo._tooltip;
 
         default:
             break;
     }
 
-    return Item::data(role);
+    return {};
 }
 
-QMap<AbstractDatasetsModel::Column, AbstractDatasetsModel::ColumHeaderInfo> AbstractDatasetsModel::columnInfo = QMap<AbstractDatasetsModel::Column, AbstractDatasetsModel::ColumHeaderInfo>({
-    { AbstractDatasetsModel::Column::Name, { "Name" , "Name", "Name of the dataset" } },
-    { AbstractDatasetsModel::Column::Location, { "" , "Enabled", "Whether the dataset is enabled or not" } },
-    { AbstractDatasetsModel::Column::ID, { "ID",  "ID", "Globally unique identifier of the dataset" } },
-    { AbstractDatasetsModel::Column::RawDataName, { "Raw data name",  "Raw data name", "Name of the raw data" } },
-    { AbstractDatasetsModel::Column::SourceDatasetID, { "Source dataset ID",  "Source dataset ID", "Globally unique identifier of the source dataset" } }
-});
-
-AbstractDatasetsModel::AbstractDatasetsModel(PopulationMode populationMode /*= PopulationMode::Automatic*/, QObject* parent /*= nullptr*/) :
-    StandardItemModel(parent),
-    _populationMode(),
-    _showIconAction(this, "Show icon", true)
+Qt::ItemFlags AbstractDatasetsModel::flags(const QModelIndex& index) const
 {
-    setColumnCount(static_cast<int>(Column::Count));
+    if (!index.isValid())
+        return Qt::ItemIsDropEnabled;
 
-    for (auto column : columnInfo.keys())
-        setHorizontalHeaderItem(static_cast<int>(column), new HeaderItem(columnInfo[column]));
-
-    setPopulationMode(populationMode);
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled;
 }
 
 QModelIndex AbstractDatasetsModel::getIndexFromDataset(Dataset<DatasetImpl> dataset) const
@@ -215,7 +217,16 @@ QModelIndex AbstractDatasetsModel::getIndexFromDataset(Dataset<DatasetImpl> data
         if (!dataset.isValid())
             throw std::runtime_error("Dataset is not valid");
 
-        return getItemFromDataset(dataset)->index();
+        // Datasets which were just added are not in the model until the next batch is inserted
+        if (isDatasetPending(dataset->getId()))
+            return {};
+
+        const auto rowIndex = getRowIndex(dataset->getId());
+
+        if (rowIndex < 0)
+            throw std::runtime_error(QString("%1 (%2) not found").arg(dataset->getGuiName(), dataset->getId()).toStdString());
+
+        return index(rowIndex, static_cast<int>(Column::Name));
     }
     catch (std::exception& e)
     {
@@ -246,29 +257,6 @@ QModelIndex AbstractDatasetsModel::getIndexFromDataset(const QString& datasetId)
     return {};
 }
 
-QStandardItem* AbstractDatasetsModel::getItemFromDataset(const QString& datasetId) const
-{
-    const auto matches = match(index(0, static_cast<int>(Column::ID)), Qt::EditRole, datasetId, 1, Qt::MatchExactly | Qt::MatchRecursive);
-
-    if (matches.isEmpty())
-        throw std::runtime_error(QString("Dataset with id %1 not found").arg(datasetId).toStdString());
-
-    return itemFromIndex(matches.first().siblingAtColumn(static_cast<int>(Column::Name)));
-}
-
-QStandardItem* AbstractDatasetsModel::getItemFromDataset(Dataset<DatasetImpl> dataset) const
-{
-    if (!dataset.isValid())
-        throw std::runtime_error("Supplied dataset is not valid");
-
-    const auto matches = match(index(0, static_cast<int>(Column::ID)), Qt::EditRole, dataset->getId(), 1, Qt::MatchExactly | Qt::MatchRecursive);
-
-    if (matches.isEmpty())
-        throw std::runtime_error(QString("%1 (%2) not found").arg(dataset->getGuiName(), dataset->getId()).toStdString());
-
-    return itemFromIndex(matches.first().siblingAtColumn(static_cast<int>(Column::Name)));
-}
-
 AbstractDatasetsModel::PopulationMode AbstractDatasetsModel::getPopulationMode() const
 {
     return _populationMode;
@@ -309,49 +297,110 @@ void AbstractDatasetsModel::setPopulationMode(PopulationMode populationMode)
 
 Datasets AbstractDatasetsModel::getDatasets() const
 {
-    return _datasets;
+    Datasets datasets;
+
+    datasets.reserve(_datasets.count() + _pendingDatasets.count());
+
+    for (const auto& dataset : _datasets)
+        if (dataset.isValid())
+            datasets << dataset;
+
+    datasets << _pendingDatasets;
+
+    return datasets;
 }
 
 Dataset<DatasetImpl> AbstractDatasetsModel::getDataset(std::int32_t rowIndex) const
 {
-    auto nameItem = dynamic_cast<Item*>(itemFromIndex(index(rowIndex, static_cast<int>(Column::Name))));
-
-    if (!nameItem)
+    if (rowIndex < 0 || rowIndex >= _datasets.count())
         return {};
 
-    return nameItem->getDataset();
+    return _datasets[rowIndex];
+}
+
+bool AbstractDatasetsModel::isDatasetPending(const QString& datasetId) const
+{
+    return _pendingDatasetIds.contains(datasetId);
 }
 
 void AbstractDatasetsModel::setDatasets(mv::Datasets datasets)
 {
-    for (const auto& dataset : _datasets)
-        removeDataset(dataset);
+    beginResetModel();
+    {
+        _batchTimer.stop();
+
+        for (const auto& dataset : _datasets)
+            if (dataset.isValid())
+                disconnect(dataset.get(), nullptr, this, nullptr);
+
+        for (const auto& dataset : _pendingDatasets)
+            disconnect(dataset.get(), nullptr, this, nullptr);
+
+        _datasets.clear();
+        _pendingDatasets.clear();
+        _pendingDatasetIds.clear();
+
+        for (auto& dataset : datasets) {
+            if (!dataset.isValid() || _datasets.contains(dataset))
+                continue;
 
-    for (const auto& dataset : datasets)
-        addDataset(dataset);
+            connectToDataset(dataset);
+
+            _datasets << dataset;
+        }
+
+        _rowIndicesDirty = true;
+    }
+    endResetModel();
 }
 
 void AbstractDatasetsModel::addDataset(Dataset<DatasetImpl> dataset)
 {
-    _datasets << dataset;
+    if (!dataset.isValid())
+        return;
+
+    if (isDatasetPending(dataset->getId()) || getRowIndex(dataset->getId()) >= 0)
+        return;
+
+    connectToDataset(dataset);
+
+    _pendingDatasets << dataset;
+    _pendingDatasetIds << dataset->getId();
+
+    _batchTimer.start();
 }
 
 void AbstractDatasetsModel::removeDataset(Dataset<DatasetImpl> dataset)
 {
     try {
-        auto datasetItem = getItemFromDataset(dataset);
+        if (!dataset.isValid())
+            throw std::runtime_error("Dataset is not valid");
 
 #ifdef ABSTRACT_DATASETS_MODEL_VERBOSE
         qDebug() << __FUNCTION__ << dataset->getLocation();
 #endif
 
-        if (!removeRow(datasetItem->row()))
-            throw std::runtime_error("Remove row failed");
+        disconnect(dataset.get(), nullptr, this, nullptr);
 
-        if (!_datasets.contains(dataset))
+        // Datasets which were never inserted can be dropped without notifying views
+        if (_pendingDatasetIds.remove(dataset->getId())) {
+            _pendingDatasets.removeOne(dataset);
+            return;
+        }
+
+        const auto rowIndex = getRowIndex(dataset->getId());
+
+        if (rowIndex < 0)
             throw std::runtime_error("Dataset no found");
 
-        _datasets.removeOne(dataset);
+        // Remove the row right away, so that the model never refers to a dataset which is being removed
+        beginRemoveRows(QModelIndex(), rowIndex, rowIndex);
+        {
+            _datasets.remove(rowIndex);
+        }
+        endRemoveRows();
+
+        _rowIndicesDirty = true;
     }
     catch (std::exception& e)
     {
@@ -363,4 +412,87 @@ void AbstractDatasetsModel::removeDataset(Dataset<DatasetImpl> dataset)
     }
 }
 
+void AbstractDatasetsModel::insertPendingDatasets()
+{
+    _batchTimer.stop();
+
+    if (_pendingDatasets.isEmpty())
+        return;
+
+    const auto firstRowIndex = static_cast<std::int32_t>(_datasets.count());
+
+#ifdef ABSTRACT_DATASETS_MODEL_VERBOSE
+    qDebug() << __FUNCTION__ << "insert" << _pendingDatasets.count() << "rows";
+#endif
+
+    beginInsertRows(QModelIndex(), firstRowIndex, firstRowIndex + static_cast<std::int32_t>(_pendingDatasets.count()) - 1);
+    {
+        _datasets << _pendingDatasets;
+
+        if (!_rowIndicesDirty)
+            for (std::int32_t rowIndex = firstRowIndex; rowIndex < _datasets.count(); ++rowIndex)
+                _rowIndices[_datasets[rowIndex].getDatasetId()] = rowIndex;
+
+        _pendingDatasets.clear();
+        _pendingDatasetIds.clear();
+    }
+    endInsertRows();
+}
+
+std::int32_t AbstractDatasetsModel::getRowIndex(const QString& datasetId) const
+{
+    if (_rowIndicesDirty)
+        updateRowIndices();
+
+    return _rowIndices.value(datasetId, -1);
+}
+
+void AbstractDatasetsModel::updateRowIndices() const
+{
+    _rowIndices.clear();
+    _rowIndices.reserve(_datasets.count());
+
+    for (std::int32_t rowIndex = 0; rowIndex < _datasets.count(); ++rowIndex)
+        if (_datasets[rowIndex].isValid())
+            _rowIndices[_datasets[rowIndex].getDatasetId()] = rowIndex;
+
+    _rowIndicesDirty = false;
+}
+
+void AbstractDatasetsModel::connectToDataset(Dataset<DatasetImpl>& dataset)
+{
+    const auto datasetPointer = dataset.get();
+
+    connect(datasetPointer, &DatasetImpl::textChanged, this, [this, datasetPointer](const QString& name) -> void {
+        emitDatasetDataChanged(datasetPointer);
+    });
+
+    connect(datasetPointer, &WidgetAction::locationChanged, this, [this, datasetPointer](const QString& location) -> void {
+        emitDatasetDataChanged(datasetPointer);
+    });
+
+    connect(datasetPointer, &WidgetAction::idChanged, this, [this, datasetPointer](const QString& id) -> void {
+        _rowIndicesDirty = true;
+
+        if (!_pendingDatasets.isEmpty()) {
+            _pendingDatasetIds.clear();
+
+            for (const auto& pendingDataset : _pendingDatasets)
+                _pendingDatasetIds << pendingDataset.getDatasetId();
+        }
+
+        emitDatasetDataChanged(datasetPointer);
+    });
+}
+
+void AbstractDatasetsModel::emitDatasetDataChanged(const DatasetImpl* dataset)
+{
+    const auto rowIndex = getRowIndex(dataset->getId());
+
+    if (rowIndex < 0)
+        return;
+
+    emit dataChanged(index(rowIndex, 0), index(rowIndex, static_cast<int>(Column::Count) - 1));
+}
+
 }
@@ -7,12 +7,14 @@
 #include "ManiVaultGlobals.h"
 
 #include "Dataset.h"
-#include "StandardItemModel.h"
+#include "NumberOfRowsAction.h"
 
 #include "actions/ToggleAction.h"
 
-#include <QList>
-#include <QStandardItem>
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
 
 namespace mv
 {
@@ -20,11 +22,22 @@ namespace mv
 /**
  * Datasets model class
  *
- * Standard item model class for datasets
+ * Flat table model for datasets which does not allocate items per cell: each row refers to a dataset in the model
+ * and the cell data is computed on demand in data(). Rows are looked up by dataset identifier in a hash table and
+ * datasets which are added to the data manager in quick succession are inserted in one batch on the next event loop
+ * iteration, so that attached views and proxy models process one signal per batch instead of one per dataset. Rows
+ * of datasets which are about to be removed are removed right away.
+ *
+ * Note: up to ManiVault 1.2 this model derived from StandardItemModel and exposed its rows as standard items. Since
+ * there are no items anymore, code which used the item API needs to be migrated as follows:
+ *  - getItemFromDataset(...) -> getIndexFromDataset(...) (and QModelIndex::data() for the cell data)
+ *  - Item::getDataset() / itemFromIndex(index) -> getDataset(index.row())
+ *  - Row, NameItem, LocationItem, IdItem, RawDataNameItem and SourceDatasetIdItem -> data() for the respective Column
+ *  - StandardItemModel::getNumberOfRowsAction() -> getNumberOfRowsAction() (unchanged, now provided by this class)
  *
  * @author Thomas Kroes
  */
-class CORE_EXPORT AbstractDatasetsModel : public StandardItemModel
+class CORE_EXPORT AbstractDatasetsModel : public QAbstractTableModel
 {
     Q_OBJECT
 
@@ -59,200 +72,68 @@ public:
     /** Column name and tooltip */
     static QMap<Column, ColumHeaderInfo> columnInfo;
 
-protected:
-
-    /** Header standard model item class */
-    class HeaderItem : public QStandardItem {
-    public:
-
-        /**
-         * Construct with \p columHeaderInfo
-         * @param columHeaderInfo Column header info
-         */
-        HeaderItem(const ColumHeaderInfo& columHeaderInfo);
-
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-
-    private:
-        ColumHeaderInfo     _columHeaderInfo;   /** Column header info */
-    };
-
 public:
 
-    /** Base standard model item class for a dataset */
-    class CORE_EXPORT Item : public QStandardItem, public QObject {
-    public:
-
-        /**
-         * Construct with reference to the owning \p datasetsModel and smart pointer to the \p dataset
-         * @param datasetsModel Reference to the datasets model
-         * @param dataset Smart pointer to the dataset to display item for
-         * @param editable Whether the model item is editable or not
-         */
-        Item(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset, bool editable = false);
-
-        /**
-         * Get datasets model
-         * return Reference to datasets model
-         */
-        AbstractDatasetsModel& getDatasetsModel();
-
-        /**
-         * Get dataset
-         * return Reference to smart pointer to dataset to display item for
-         */
-        Dataset<DatasetImpl>& getDataset();
-
-    private:
-        AbstractDatasetsModel&  _datasetsModel;     /** Reference to the owing dataset model */
-        Dataset<DatasetImpl>    _dataset;           /** Smart pointer to the dataset to display item for */
-    };
-
-    /** Standard model item class for displaying the dataset name */
-    class CORE_EXPORT NameItem final : public Item {
-    public:
-
-        /**
-         * Construct with reference to the owning \p datasetsModel and smart pointer to the \p dataset
-         * @param datasetsModel Reference to the owning datasets model
-         * @param dataset Smart pointer to the dataset to display item for
-         */
-        NameItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset);
-
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-    };
-
-    /** Standard model item class for displaying the dataset location */
-    class CORE_EXPORT LocationItem final : public Item{
-    public:
-
-        /**
-         * Construct with reference to the owning \p datasetsModel and smart pointer to the \p dataset
-         * @param datasetsModel Reference to the owning datasets model
-         * @param dataset Smart pointer to the dataset to display item for
-         */
-        LocationItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset);
-
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-    };
-
-    /** Standard model item class for displaying the dataset identifier */
-    class CORE_EXPORT IdItem final : public Item {
-    public:
-
-        /**
-         * Construct with reference to the owning \p datasetsModel and smart pointer to the \p dataset
-         * @param datasetsModel Reference to the owning datasets model
-         * @param dataset Smart pointer to the dataset to display item for
-         */
-        IdItem(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset);
-
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-    };
-
-    /** Standard model item class for displaying the raw data name */
-    class CORE_EXPORT RawDataNameItem final : public Item {
-    public:
-
-        /** No need for custom constructor */
-        using Item::Item;
-
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-    };
-
-    /** Standard model item class for displaying the source dataset identifier name */
-    class CORE_EXPORT SourceDatasetIdItem final : public Item {
-    public:
+    /**
+     * Construct with \p populationMode and pointer to \p parent object
+     * @param populationMode Population mode
+     * @param parent Pointer to parent object
+     */
+    AbstractDatasetsModel(PopulationMode populationMode = PopulationMode::Automatic, QObject* parent = nullptr);
 
-        /** No need for custom constructor */
-        using Item::Item;
+    /**
+     * Get the number of rows
+     * @param parent Parent model index
+     * @return Number of rows in the model
+     */
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
 
-        /**
-         * Get model data for \p role
-         * @return Data for \p role in variant form
-         */
-        QVariant data(int role = Qt::UserRole + 1) const override;
-    };
+    /**
+     * Get the number of columns
+     * @param parent Parent model index
+     * @return Number of columns in the model
+     */
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
 
-    /** Convenience class for combining dataset items in a row */
-    class Row final : public QList<QStandardItem*>
-    {
-    public:
-
-        /**
-         * Construct with reference to the owning \p datasetsModel and smart pointer to the \p dataset
-         * @param datasetsModel Reference to the owning datasets model
-         * @param dataset Smart pointer to the dataset to display item for
-         */
-        Row(AbstractDatasetsModel& datasetsModel, Dataset<DatasetImpl> dataset) :
-            QList<QStandardItem*>()
-        {
-            append(new NameItem(datasetsModel, dataset));
-            append(new LocationItem(datasetsModel, dataset));
-            append(new IdItem(datasetsModel, dataset));
-            append(new RawDataNameItem(datasetsModel, dataset));
-            append(new SourceDatasetIdItem(datasetsModel, dataset));
-        }
-    };
+    /**
+     * Get data for \p index and \p role (computed on demand)
+     * @param index Model index to query
+     * @param role Data role
+     * @return Data for \p role in variant form
+     */
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
 
-public:
+    /**
+     * Get header data
+     * @param section Section
+     * @param orientation Orientation
+     * @param role Data role
+     * @return Header
+     */
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
     /**
-     * Construct with \p populationMode and pointer to \p parent object
-     * @param populationMode Population mode
-     * @param parent Pointer to parent object
+     * Get item flags
+     * @param index Model index
+     * @return Item flags
      */
-    AbstractDatasetsModel(PopulationMode populationMode = PopulationMode::Automatic, QObject* parent = nullptr);
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
 
     /**
      * Get index from \p dataset smart pointer
      * @param dataset Dataset to retrieve the index for
-     * @return Model index (invalid if not found)
+     * @return Model index (invalid if not found or not inserted yet, see AbstractDatasetsModel::isDatasetPending())
      */
     QModelIndex getIndexFromDataset(Dataset<DatasetImpl> dataset) const;
 
     /**
      * Get index from \p datasetId
      * @param datasetId Dataset globally unique identifier to retrieve the row index for
-     * @return Model index (invalid if not found)
+     * @return Model index (invalid if not found or not inserted yet, see AbstractDatasetsModel::isDatasetPending())
      */
     QModelIndex getIndexFromDataset(const QString& datasetId) const;
 
     /**
-     * Get item from \p datasetId
-     * @param datasetId Globally unique identifier of the dataset
-     * @return Pointer to found item, nullptr otherwise
-     */
-    QStandardItem* getItemFromDataset(const QString& datasetId) const;
-
-    /**
-     * Get item dataset smart pointer to \p dataset
-     * @param dataset Smart pointer to the dataset
-     * @return Pointer to found item, nullptr otherwise
-     */
-    QStandardItem* getItemFromDataset(Dataset<DatasetImpl> dataset) const;
-
-    /** 
      * Get current population mode
      * @return Population mode
      */
@@ -273,10 +154,17 @@ public:
     /**
      * Get dataset for \p rowIndex
      * @param rowIndex Index of the row to retrieve
-     * @return Dataset
+     * @return Dataset (invalid if \p rowIndex is out of range)
      */
     Dataset<DatasetImpl> getDataset(std::int32_t rowIndex) const;
 
+    /**
+     * Get whether the dataset with \p datasetId was added but is not inserted in the model yet (it is inserted with the next batch)
+     * @param datasetId Globally unique identifier of the dataset
+     * @return Boolean determining whether the dataset is pending
+     */
+    bool isDatasetPending(const QString& datasetId) const;
+
     /**
      * Set the datasets from which can be picked (mode is set to StorageMode::Manual)
      * @param datasets Datasets
@@ -297,16 +185,49 @@ protected:
      */
     virtual void removeDataset(Dataset<DatasetImpl> dataset) final;
 
+    /** Insert the pending datasets (in one batch) */
+    void insertPendingDatasets();
+
+private:
+
+    /**
+     * Get the row index of \p datasetId (the row index hash table is rebuilt when it is out of date)
+     * @param datasetId Globally unique identifier of the dataset
+     * @return Row index, -1 if not found
+     */
+    std::int32_t getRowIndex(const QString& datasetId) const;
+
+    /** Rebuild the row index hash table */
+    void updateRowIndices() const;
+
+    /**
+     * Connect to the signals of \p dataset which affect the displayed data
+     * @param dataset Smart pointer to the dataset
+     */
+    void connectToDataset(Dataset<DatasetImpl>& dataset);
+
+    /**
+     * Emit the data changed signal for the row of \p dataset
+     * @param dataset Pointer to the dataset
+     */
+    void emitDatasetDataChanged(const DatasetImpl* dataset);
+
 public: // Action getters
 
     gui::ToggleAction& getShowIconAction() { return _showIconAction; }
+    gui::NumberOfRowsAction& getNumberOfRowsAction() { return _numberOfRowsAction; }
+    const gui::NumberOfRowsAction& getNumberOfRowsAction() const { return _numberOfRowsAction; }
 
 private:
-    PopulationMode      _populationMode;    /** Population mode (e.g. manual or automatic) */
-    gui::ToggleAction   _showIconAction;    /** Whether to show the dataset icon */
-    Datasets            _datasets;          /** Datasets in the model */
-
-    friend class Item;
+    PopulationMode                          _populationMode;        /** Population mode (e.g. manual or automatic) */
+    gui::ToggleAction                       _showIconAction;        /** Whether to show the dataset icon */
+    gui::NumberOfRowsAction                 _numberOfRowsAction;    /** String action for displaying the number of rows */
+    Datasets                                _datasets;              /** Datasets in the model (one per row) */
+    Datasets                                _pendingDatasets;       /** Datasets which are added to the model in the next batch */
+    QSet<QString>                           _pendingDatasetIds;     /** Identifiers of the pending datasets */
+    mutable QHash<QString, std::int32_t>    _rowIndices;            /** Row index by dataset identifier */
+    mutable bool                            _rowIndicesDirty;       /** Whether the row indices need to be rebuilt */
+    QTimer                                  _batchTimer;            /** Coalesces dataset additions into batches */
 };
 
 }
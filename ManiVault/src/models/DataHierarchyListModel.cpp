@@ -55,14 +55,14 @@ void DataHierarchyListModel::addDataHierarchyModelItem(DataHierarchyItem* dataHi
         if (!dataHierarchyItem)
             throw std::runtime_error("Data hierarchy item pointer is invalid");
 
-        if (!match(index(0, static_cast<int>(Column::DatasetId), QModelIndex()), Qt::EditRole, dataHierarchyItem->getDataset()->getId(), -1, Qt::MatchFlag::MatchExactly | Qt::MatchFlag::MatchRecursive).isEmpty())
+        if (getModelIndex(dataHierarchyItem->getDataset()->getId()).isValid())
             return;
 
 #ifdef DATA_HIERARCHY_LIST_MODEL_VERBOSE
         qDebug() << "Add dataset" << dataHierarchyItem->getDataset()->getGuiName() << "to the data hierarchy list model";
 #endif
 
-        appendRow(Row(dataHierarchyItem->getDataset()));
+        appendDatasetRow(dataHierarchyItem->getDataset());
 
         for (auto childDataHierarchyItem : dataHierarchyItem->getChildren(true))
             addDataHierarchyModelItem(childDataHierarchyItem);
@@ -84,21 +84,14 @@ void DataHierarchyListModel::removeDataHierarchyModelItem(DataHierarchyItem* dat
         if (!dataHierarchyItem)
             throw std::runtime_error("Data hierarchy item pointer is invalid");
 
-        const auto matches = match(index(0, static_cast<int>(Column::DatasetId), QModelIndex()), Qt::EditRole, dataHierarchyItem->getDataset()->getId(), -1, Qt::MatchFlag::MatchExactly | Qt::MatchFlag::MatchRecursive);
-
-        if (matches.isEmpty())
+        if (!getModelIndex(dataHierarchyItem->getDataset()->getId()).isValid())
             throw std::runtime_error(QString("%1 not found in model").arg(dataHierarchyItem->getDataset()->getGuiName()).toStdString());
 
-        auto item = itemFromIndex(matches.first().siblingAtColumn(static_cast<int>(Column::Name)));
-
-        if (!item)
-            throw std::runtime_error("QStandardItemModel::itemFromIndex() returned nullptr");
-
 #ifdef DATA_HIERARCHY_LIST_MODEL_VERBOSE
         qDebug() << "Remove dataset" << dataHierarchyItem->getDataset()->getGuiName() << "from the data hierarchy list model";
 #endif
 
-        if (!removeRows(item->row(), 1))
+        if (!removeDatasetRow(dataHierarchyItem->getDataset()->getId()))
             throw std::runtime_error("QStandardItemModel::removeRows() failed");
     }
     catch (std::exception& e)
@@ -51,7 +51,7 @@ void DataHierarchyTreeModel::addDataHierarchyModelItem(DataHierarchyItem* dataHi
         if (!dataHierarchyItem)
             throw std::runtime_error("Data hierarchy item pointer is invalid");
 
-        if (!match(index(0, static_cast<int>(Column::DatasetId), QModelIndex()), Qt::EditRole, dataHierarchyItem->getDataset()->getId(), -1, Qt::MatchFlag::MatchExactly | Qt::MatchFlag::MatchRecursive).isEmpty())
+        if (getModelIndex(dataHierarchyItem->getDataset()->getId()).isValid())
             return;
 
 #ifdef DATA_HIERARCHY_TREE_MODEL_VERBOSE
@@ -59,15 +59,15 @@ void DataHierarchyTreeModel::addDataHierarchyModelItem(DataHierarchyItem* dataHi
 #endif
 
         if (dataHierarchyItem->hasParent()) {
-            const auto matches = match(index(0, static_cast<int>(Column::DatasetId), QModelIndex()), Qt::EditRole, dataHierarchyItem->getParent()->getDataset()->getId(), -1, Qt::MatchFlag::MatchExactly | Qt::MatchFlag::MatchRecursive);
+            const auto parentModelIndex = getModelIndex(dataHierarchyItem->getParent()->getDataset()->getId());
 
-            if (matches.isEmpty())
+            if (!parentModelIndex.isValid())
                 throw std::runtime_error("Parent data hierarchy item not found in model");
 
-            itemFromIndex(matches.first().siblingAtColumn(static_cast<int>(Column::Name)))->appendRow(Row(dataHierarchyItem->getDataset()));
+            appendDatasetRow(dataHierarchyItem->getDataset(), itemFromIndex(parentModelIndex));
         }
         else {
-            appendRow(Row(dataHierarchyItem->getDataset()));
+            appendDatasetRow(dataHierarchyItem->getDataset());
         }
 
         for (auto childDataHierarchyItem : dataHierarchyItem->getChildren(true))
@@ -90,28 +90,14 @@ void DataHierarchyTreeModel::removeDataHierarchyModelItem(DataHierarchyItem* dat
         if (!dataHierarchyItem)
             throw std::runtime_error("Data hierarchy item pointer is invalid");
 
-        const auto matches = match(index(0, static_cast<int>(Column::DatasetId), QModelIndex()), Qt::EditRole, dataHierarchyItem->getDataset()->getId(), -1, Qt::MatchFlag::MatchExactly | Qt::MatchFlag::MatchRecursive);
-
-        if (matches.isEmpty())
+        if (!getModelIndex(dataHierarchyItem->getDataset()->getId()).isValid())
             throw std::runtime_error(QString("%1 not found in model").arg(dataHierarchyItem->getDataset()->getGuiName()).toStdString());
 
-        auto item = itemFromIndex(matches.first().siblingAtColumn(static_cast<int>(Column::Name)));
-
-        if (!item)
-            throw std::runtime_error("QStandardItemModel::itemFromIndex() returned nullptr");
-
 #ifdef DATA_HIERARCHY_TREE_MODEL_VERBOSE
         qDebug() << "Remove dataset" << dataHierarchyItem->getDataset()->getGuiName() << "from the data hierarchy tree model";
 #endif
 
-        bool removeRowsResult = false;
-
-        if (item->parent())
-            removeRowsResult = removeRows(item->row(), 1, item->parent()->index());
-        else
-            removeRowsResult = removeRows(item->row(), 1);
-
-        if (!removeRowsResult)
+        if (!removeDatasetRow(dataHierarchyItem->getDataset()->getId()))
             throw std::runtime_error("QStandardItemModel::removeRows() failed");
     }
     catch (std::exception& e)
@@ -40,8 +40,14 @@ bool DatasetsFilterModel::filterAcceptsRow(int row, const QModelIndex& parent) c
 
     auto abstractDatasetsModel = static_cast<AbstractDatasetsModel*>(sourceModel());
 
-    if (_useFilterFunctionAction.isChecked() && _filterFunction)
-        return _filterFunction(static_cast<AbstractDatasetsModel::Item*>(abstractDatasetsModel->itemFromIndex(index))->getDataset());
+    if (_useFilterFunctionAction.isChecked() && _filterFunction) {
+        const auto dataset = abstractDatasetsModel->getDataset(index.row());
+
+        if (!dataset.isValid())
+            return false;
+
+        return _filterFunction(dataset);
+    }
 
     return true;
 }
@@ -12,7 +12,7 @@ namespace mv
 /**
  * Datasets list model class
  *
- * Standard item model class for datasets as a list
+ * Model class for datasets as a list
  *
  * @author Thomas Kroes
  */
@@ -26,14 +26,6 @@ public:
      * @param parent Pointer to parent object
      */
     DatasetsListModel(PopulationMode populationMode = PopulationMode::Automatic, QObject* parent = nullptr);
-
-private:
-
-    /**
-     * Add \p dataset to the model (this method is called when a dataset is added to the manager)
-     * @param dataset Smart pointer to dataset to add
-     */
-    void addDataset(Dataset<DatasetImpl> dataset) override;
 };
 
 }
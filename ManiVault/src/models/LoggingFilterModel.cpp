@@ -32,7 +32,7 @@ bool LoggingFilterModel::filterAcceptsRow(int row, const QModelIndex& parent) co
     if (!index.isValid())
         return true;
 
-    const auto* messageRecord = static_cast<MessageRecord*>(index.internalPointer());
+    const auto messageType = static_cast<QtMsgType>(sourceModel()->data(index.siblingAtColumn(static_cast<int>(LoggingModel::Column::Type)), Qt::EditRole).toInt());
 
     if (filterRegularExpression().isValid()) {
         const auto key = sourceModel()->data(index.siblingAtColumn(filterKeyColumn()), filterRole()).toString();
@@ -43,7 +43,7 @@ bool LoggingFilterModel::filterAcceptsRow(int row, const QModelIndex& parent) co
 
     const auto selectedFilterTypeOptions = _filterTypeAction.getSelectedOptions();
 
-    switch (messageRecord->type)
+    switch (messageType)
     {
         case QtMsgType::QtDebugMsg:
         {
@@ -13,7 +13,7 @@
 #include <QFileInfo>
 #include <QRegularExpression>
 #include <QStringList>
-#include <QAbstractEventDispatcher>
+#include <QSignalBlocker>
 
 #include <algorithm>
 #include <cassert>
@@ -27,7 +27,7 @@ namespace mv {
 using namespace util;
 using namespace gui;
 
-LoggingModel::Item::Item(LoggingModel& loggingModel, const MessageRecord& messageRecord) :
+LoggingModel::Item::Item(LoggingModel& loggingModel, const std::shared_ptr<const MessageRecord>& messageRecord) :
     QStandardItem(),
     QObject(),
     _loggingModel(loggingModel),
@@ -48,7 +48,7 @@ const LoggingModel& LoggingModel::Item::getLoggingModel() const
 
 const MessageRecord& LoggingModel::Item::getMessageRecord() const
 {
-    return _messageRecord;
+    return *_messageRecord;
 }
 
 QVariant LoggingModel::Item::data(int role /*= Qt::UserRole + 1*/) const
@@ -56,7 +56,7 @@ QVariant LoggingModel::Item::data(int role /*= Qt::UserRole + 1*/) const
     switch (role) {
         case Qt::ForegroundRole:
         {
-            switch (_messageRecord.type)
+            switch (_messageRecord->type)
             {
                 case QtDebugMsg:
                 case QtWarningMsg:
@@ -116,7 +116,7 @@ QVariant LoggingModel::TypeItem::data(int role /*= Qt::UserRole + 1*/) const
     return Item::data(role);
 }
 
-LoggingModel::MessageItem::MessageItem(LoggingModel& loggingModel, const util::MessageRecord& messageRecord) :
+LoggingModel::MessageItem::MessageItem(LoggingModel& loggingModel, const std::shared_ptr<const util::MessageRecord>& messageRecord) :
     Item(loggingModel, messageRecord)
 {
     connect(&getLoggingModel().getWordWrapAction(), &ToggleAction::toggled, this, [this](bool toggled) -> void {
@@ -201,13 +201,19 @@ QVariant LoggingModel::CategoryItem::data(int role /*= Qt::UserRole + 1*/) const
 
 LoggingModel::LoggingModel(QObject* parent /*= nullptr*/) :
     StandardItemModel(parent),
-    _messageRecords(),
+    _nextRecordIndex(0),
     _wordWrapAction(this, "Word wrap", true),
-    _idleUpdateConnection()
+    _updateTimer()
 {
     _wordWrapAction.setToolTip("Enables/disables word wrapping");
 
-    _idleUpdateConnection = connect(QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::awake, this, &LoggingModel::populateFromLogger);
+    setColumnCount(static_cast<int>(Column::Count));
+
+    _updateTimer.setInterval(updateInterval);
+
+    connect(&_updateTimer, &QTimer::timeout, this, &LoggingModel::populateFromLogger);
+
+    _updateTimer.start();
 
     populateFromLogger();
 }
@@ -245,15 +251,34 @@ void LoggingModel::populateFromLogger()
 {
     auto& logger = Application::current()->getLogger();
 
-    const auto previousNumberOfMessages = _messageRecords.size();
-    const auto numberOfAddedMessages    = logger.getMessageRecords().size() - previousNumberOfMessages;
+    MessageRecords messageRecords;
 
-    if (numberOfAddedMessages >= 1) {
-        logger.updateMessageRecords(_messageRecords);
+    logger.getMessageRecords(_nextRecordIndex, messageRecords, maximumNumberOfRowsPerUpdate);
+
+    if (!messageRecords.empty()) {
+        const auto firstRow         = rowCount();
+        const auto numberOfRows     = static_cast<int>(messageRecords.size());
+
+        // Insert all rows at once and populate them silently, views are updated with a single data changed signal
+        insertRows(firstRow, numberOfRows);
+        {
+            const QSignalBlocker signalBlocker(this);
 
-        for (size_t recordIndex = previousNumberOfMessages; recordIndex < (previousNumberOfMessages + numberOfAddedMessages); ++recordIndex)
-            appendRow(Row(*this, *_messageRecords[recordIndex]));
+            for (int rowIndex = 0; rowIndex < numberOfRows; ++rowIndex) {
+                Row row(*this, std::move(messageRecords[rowIndex]));
+
+                for (int columnIndex = 0; columnIndex < row.count(); ++columnIndex)
+                    setItem(firstRow + rowIndex, columnIndex, row[columnIndex]);
+            }
+        }
+        emit dataChanged(index(firstRow, 0), index(firstRow + numberOfRows - 1, columnCount() - 1));
     }
+
+    // Apply the retention of the logger to the model as well
+    const auto maximumNumberOfRows = static_cast<int>(logger.getMaximumNumberOfRecords());
+
+    if (rowCount() > maximumNumberOfRows)
+        removeRows(0, rowCount() - maximumNumberOfRows);
 }
 
 }
\ No newline at end of file
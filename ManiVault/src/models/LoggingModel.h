@@ -14,9 +14,10 @@
 
 #include <QList>
 #include <QStandardItem>
+#include <QTimer>
 
-#include <deque>
 #include <cstdint>
+#include <memory>
 
 namespace mv {
 
@@ -53,9 +54,9 @@ public:
         /**
          * Construct with \p messageRecord
          * @param loggingModel Reference to owning logging model
-         * @param messageRecord Reference to message record
+         * @param messageRecord Message record (shared by the items in a row)
          */
-        Item(LoggingModel& loggingModel, const util::MessageRecord& messageRecord);
+        Item(LoggingModel& loggingModel, const std::shared_ptr<const util::MessageRecord>& messageRecord);
 
         /**
          * Get model data for \p role
@@ -82,8 +83,8 @@ public:
         const util::MessageRecord& getMessageRecord() const;
 
     private:
-        LoggingModel&                   _loggingModel;      /** Reference to owning logging model */
-        const util::MessageRecord&      _messageRecord;     /** Reference to message record to display item for */
+        LoggingModel&                                   _loggingModel;      /** Reference to owning logging model */
+        std::shared_ptr<const util::MessageRecord>      _messageRecord;     /** Message record to display item for (a copy, so that it is independent of the logger record store) */
     };
 
     /** Standard model item class for interacting with the message number */
@@ -161,7 +162,7 @@ public:
          * @param loggingModel Reference to owning logging model
          * @param messageRecord Reference to message record
          */
-        MessageItem(LoggingModel& loggingModel, const util::MessageRecord& messageRecord);
+        MessageItem(LoggingModel& loggingModel, const std::shared_ptr<const util::MessageRecord>& messageRecord);
 
         /**
          * Get model data for \p role
@@ -298,16 +299,18 @@ protected:
         /**
          * Construct with reference to owning \p loggingModel and \p messageRecord
          * @param loggingModel Reference to owning logging model
-         * @param MessageRecord Reference to message record
+         * @param messageRecord Message record
          */
-        Row(LoggingModel& loggingModel, const util::MessageRecord& messageRecord) : QList<QStandardItem*>()
+        Row(LoggingModel& loggingModel, util::MessageRecord&& messageRecord) : QList<QStandardItem*>()
         {
-            append(new NumberItem(loggingModel, messageRecord));
-            append(new TypeItem(loggingModel, messageRecord));
-            append(new MessageItem(loggingModel, messageRecord));
-            append(new FileAndLineItem(loggingModel, messageRecord));
-            append(new FunctionItem(loggingModel, messageRecord));
-            append(new CategoryItem(loggingModel, messageRecord));
+            const auto sharedMessageRecord = std::make_shared<const util::MessageRecord>(std::move(messageRecord));
+
+            append(new NumberItem(loggingModel, sharedMessageRecord));
+            append(new TypeItem(loggingModel, sharedMessageRecord));
+            append(new MessageItem(loggingModel, sharedMessageRecord));
+            append(new FileAndLineItem(loggingModel, sharedMessageRecord));
+            append(new FunctionItem(loggingModel, sharedMessageRecord));
+            append(new CategoryItem(loggingModel, sharedMessageRecord));
         }
 
     };
@@ -346,13 +349,21 @@ public: // Action getters
 
 private:
 
-    /** Synchronizes the model with the log records from the core logger */
+    /** Inserts the records which were added to the core logger since the last update in one batch, and removes rows beyond the logger retention */
     void populateFromLogger();
 
+public:
+
+    /** Interval at which the model is synchronized with the logger */
+    static constexpr std::int32_t updateInterval = 100;
+
+    /** Maximum number of rows inserted per update (keeps the user interface responsive during bursts of messages) */
+    static constexpr std::size_t maximumNumberOfRowsPerUpdate = 5000;
+
 private:
-    std::deque<const mv::util::MessageRecord*>  _messageRecords;            /** Logged message records */
+    std::uint64_t                               _nextRecordIndex;           /** Logger sequence index of the next record to insert */
     mv::gui::ToggleAction                       _wordWrapAction;            /** Action for toggling word wrap */
-    QMetaObject::Connection                     _idleUpdateConnection;      /** Update the logging widget when idle */
+    QTimer                                      _updateTimer;               /** Periodically synchronizes the model with the logger */
 };
 
 }
\ No newline at end of file
@@ -25,6 +25,7 @@ NumberOfRowsAction::~NumberOfRowsAction()
     disconnect(_model, &QAbstractItemModel::rowsInserted, this, nullptr);
     disconnect(_model, &QAbstractItemModel::rowsRemoved, this, nullptr);
     disconnect(_model, &QAbstractItemModel::layoutChanged, this, nullptr);
+    disconnect(_model, &QAbstractItemModel::modelReset, this, nullptr);
 }
 
 void NumberOfRowsAction::initialize(QAbstractItemModel* model)
@@ -41,6 +42,7 @@ void NumberOfRowsAction::initialize(QAbstractItemModel* model)
         disconnect(_model, &QAbstractItemModel::rowsInserted, this, nullptr);
         disconnect(_model, &QAbstractItemModel::rowsRemoved, this, nullptr);
         disconnect(_model, &QAbstractItemModel::layoutChanged, this, nullptr);
+        disconnect(_model, &QAbstractItemModel::modelReset, this, nullptr);
     }
 
     _model = model;
@@ -49,6 +51,7 @@ void NumberOfRowsAction::initialize(QAbstractItemModel* model)
     connect(_model, &QAbstractItemModel::rowsInserted, this, &NumberOfRowsAction::numberOfRowsChanged);
     connect(_model, &QAbstractItemModel::rowsRemoved, this, &NumberOfRowsAction::numberOfRowsChanged);
     connect(_model, &QAbstractItemModel::layoutChanged, this, &NumberOfRowsAction::numberOfRowsChanged);
+    connect(_model, &QAbstractItemModel::modelReset, this, &NumberOfRowsAction::numberOfRowsChanged);
 
     updateString();
 }
@@ -18,18 +18,13 @@ namespace mv {
 PluginFactoriesListModel::PluginFactoriesListModel(QObject* parent /*= nullptr*/) :
     AbstractPluginFactoriesModel(parent)
 {
-    const auto pluginTypes = plugin::Types{
-        plugin::Type::ANALYSIS,
-        plugin::Type::DATA,
-        plugin::Type::LOADER,
-        plugin::Type::WRITER,
-        plugin::Type::TRANSFORMATION,
-        plugin::Type::VIEW
-    };
-
-    for (auto pluginType : pluginTypes)
-        for (auto pluginFactory : plugins().getPluginFactoriesByType(pluginType))
-            appendRow(Row(pluginFactory));
+    // Deferred plugin shared libraries are not loaded for the model, their factories are added once they are loaded
+    for (auto pluginFactory : plugins().getLoadedPluginFactories())
+        appendRow(Row(pluginFactory));
+
+    connect(&plugins(), &AbstractPluginManager::pluginFactoryLoaded, this, [this](plugin::PluginFactory* pluginFactory) -> void {
+        appendRow(Row(pluginFactory));
+    });
 }
 
 }
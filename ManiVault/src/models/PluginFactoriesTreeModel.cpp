@@ -32,10 +32,35 @@ PluginFactoriesTreeModel::PluginFactoriesTreeModel(QObject* parent /*= nullptr*/
 
         appendRow(pluginTypeRow);
 
-        for (auto pluginFactory : plugins().getPluginFactoriesByType(pluginType))
-            pluginTypeRow.first()->appendRow(Row(pluginFactory));
+        pluginTypeRow.first()->setEnabled(false);
+    }
+
+    // Deferred plugin shared libraries are not loaded for the model, their factories are added once they are loaded
+    for (auto pluginFactory : plugins().getLoadedPluginFactories())
+        addPluginFactory(pluginFactory);
+
+    connect(&plugins(), &AbstractPluginManager::pluginFactoryLoaded, this, &PluginFactoriesTreeModel::addPluginFactory);
+}
+
+void PluginFactoriesTreeModel::addPluginFactory(plugin::PluginFactory* pluginFactory)
+{
+    Q_ASSERT(pluginFactory);
+
+    if (!pluginFactory)
+        return;
+
+    const auto pluginTypeName = getPluginTypeName(pluginFactory->getType());
+
+    for (int rowIndex = 0; rowIndex < rowCount(); rowIndex++) {
+        auto pluginTypeItem = item(rowIndex, static_cast<int>(Column::Name));
+
+        if (pluginTypeItem->data(Qt::DisplayRole).toString() != pluginTypeName)
+            continue;
+
+        pluginTypeItem->appendRow(Row(pluginFactory));
+        pluginTypeItem->setEnabled(true);
 
-        pluginTypeRow.first()->setEnabled(pluginTypeRow.first()->hasChildren());
+        break;
     }
 }
 
@@ -24,6 +24,14 @@ public:
      * @param parent Pointer to parent object
      */
     PluginFactoriesTreeModel(QObject* parent = nullptr);
+
+private:
+
+    /**
+     * Add a row for \p pluginFactory under the row of its plugin type
+     * @param pluginFactory Pointer to plugin factory
+     */
+    void addPluginFactory(plugin::PluginFactory* pluginFactory);
 };
 
 }
\ No newline at end of file
@@ -20,6 +20,8 @@ PluginsTreeModel::PluginsTreeModel(PopulationMode populationMode /*= PopulationM
     setColumnCount(static_cast<int>(AbstractPluginsModel::Column::Count));
 
     PluginsTreeModel::populateFromPluginManager();
+
+    connect(&mv::plugins(), &AbstractPluginManager::pluginFactoryLoaded, this, &PluginsTreeModel::addPluginFactory);
 }
 
 plugin::Plugins PluginsTreeModel::getPlugins() const
@@ -47,23 +49,35 @@ void PluginsTreeModel::populateFromPluginManager()
         plugin::Type::VIEW
     };
 
-    for (auto pluginType : pluginTypes) {
-        auto pluginTypeRow = Row(nullptr, QString("%1 plugins").arg(getPluginTypeName(pluginType)), "Type", "", getPluginTypeIcon(pluginType));
+    for (auto pluginType : pluginTypes)
+        appendRow(Row(nullptr, QString("%1 plugins").arg(getPluginTypeName(pluginType)), "Type", "", getPluginTypeIcon(pluginType)));
+
+    // Deferred plugin shared libraries are not loaded for the model, their factories are added once they are loaded
+    for (auto pluginFactory : plugins().getLoadedPluginFactories())
+        addPluginFactory(pluginFactory);
+}
+
+void PluginsTreeModel::addPluginFactory(plugin::PluginFactory* pluginFactory)
+{
+    Q_ASSERT(pluginFactory);
+
+    if (!pluginFactory)
+        return;
+
+    const auto matches = match(index(0, static_cast<int>(AbstractPluginsModel::Column::Name)), Qt::EditRole, QString("%1 plugins").arg(getPluginTypeName(pluginFactory->getType())), 1, Qt::MatchExactly);
 
-        appendRow(pluginTypeRow);
+    if (matches.isEmpty())
+        return;
 
-        for (auto pluginFactory : plugins().getPluginFactoriesByType(pluginType)) {
-            auto pluginFactoryRow = Row(nullptr, pluginFactory->getKind(), "Factory", "", pluginFactory->getIcon());
+    auto pluginFactoryRow = Row(nullptr, pluginFactory->getKind(), "Factory", "", pluginFactory->getIcon());
 
-            pluginFactoryRow.first()->setEnabled(false);
-            pluginFactoryRow.first()->setEditable(false);
+    pluginFactoryRow.first()->setEnabled(false);
+    pluginFactoryRow.first()->setEditable(false);
 
-            pluginTypeRow.first()->appendRow(pluginFactoryRow);
+    itemFromIndex(matches.first())->appendRow(pluginFactoryRow);
 
-            for (auto plugin : plugins().getPluginsByFactory(pluginFactory))
-                pluginFactoryRow.first()->appendRow(Row(plugin, plugin->getGuiName(), "Instance", plugin->getId(), plugin->getIcon()));
-        }
-    }
+    for (auto plugin : plugins().getPluginsByFactory(pluginFactory))
+        pluginFactoryRow.first()->appendRow(Row(plugin, plugin->getGuiName(), "Instance", plugin->getId(), plugin->getIcon()));
 }
 
 void PluginsTreeModel::addPlugin(plugin::Plugin* plugin)
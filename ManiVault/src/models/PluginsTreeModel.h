@@ -59,6 +59,14 @@ public:
      * @param plugin Pointer to plugin
      */
     void removePlugin(plugin::Plugin* plugin) override;
+
+private:
+
+    /**
+     * Add a row for \p pluginFactory (and its plugin instances) under the row of its plugin type
+     * @param pluginFactory Pointer to plugin factory
+     */
+    void addPluginFactory(plugin::PluginFactory* pluginFactory);
 };
 
 }
\ No newline at end of file
@@ -83,6 +83,25 @@ QVariant RawDataModel::RawDataSizeItem::data(int role /*= Qt::UserRole + 1*/) co
     return {};
 }
 
+QVariant RawDataModel::RawDataStatusItem::data(int role /*= Qt::UserRole + 1*/) const
+{
+    switch (role) {
+        case Qt::EditRole:
+            return mv::memory().isSpilled(getRawDataName());
+
+        case Qt::DisplayRole:
+            return data(Qt::EditRole).toBool() ? "Spilled to disk" : "Resident";
+
+        case Qt::ToolTipRole:
+            return "Status: " + data(Qt::DisplayRole).toString();
+
+        default:
+            break;
+    }
+
+    return {};
+}
+
 RawDataModel::RawDataModel(QObject* parent) :
     StandardItemModel(parent),
     _overallSizeAction(this, "Overall size")
@@ -91,8 +110,14 @@ RawDataModel::RawDataModel(QObject* parent) :
 
     _overallSizeAction.setEnabled(false);
 
-    connect(&mv::data(), &AbstractDataManager::rawDataAdded, this, &RawDataModel::populateFromDataManager);
-    connect(&mv::data(), &AbstractDataManager::rawDataRemoved, this, &RawDataModel::populateFromDataManager);
+    _updateSizesTimer.setSingleShot(true);
+    _updateSizesTimer.setInterval(0);
+
+    connect(&_updateSizesTimer, &QTimer::timeout, this, &RawDataModel::updateSizes);
+
+    connect(&mv::data(), &AbstractDataManager::rawDataAdded, this, &RawDataModel::addRawData);
+    connect(&mv::data(), &AbstractDataManager::rawDataRemoved, this, &RawDataModel::removeRawData);
+    connect(&mv::memory(), &AbstractMemoryManager::accountingChanged, this, &RawDataModel::updateSizes);
 }
 
 QVariant RawDataModel::headerData(int section, Qt::Orientation orientation, int role /*= Qt::DisplayRole*/) const
@@ -108,6 +133,9 @@ QVariant RawDataModel::headerData(int section, Qt::Orientation orientation, int
         case Column::Size:
             return RawDataSizeItem::headerData(orientation, role);
 
+        case Column::Status:
+            return RawDataStatusItem::headerData(orientation, role);
+
         default:
             break;
     }
@@ -126,8 +154,60 @@ void RawDataModel::populateFromDataManager()
 
     setRowCount(0);
 
-    for (const auto& rawDataName : mv::data().getRawDataNames())
-        appendRow(Row(rawDataName));
+    _nameItems.clear();
+
+    for (const auto& rawDataName : mv::data().getRawDataNames()) {
+        const auto row = Row(rawDataName);
+
+        appendRow(row);
+
+        _nameItems[rawDataName] = row.first();
+    }
+
+    updateSizes();
+}
+
+void RawDataModel::addRawData(plugin::RawData* rawData)
+{
+    if (mv::projects().isOpeningProject() || mv::projects().isImportingProject())
+        return;
+
+    if (!rawData || _nameItems.contains(rawData->getName()))
+        return;
+
+#ifdef RAW_DATA_MODEL_VERBOSE
+    qDebug() << __FUNCTION__ << rawData->getName();
+#endif
+
+    const auto row = Row(rawData->getName());
+
+    appendRow(row);
+
+    _nameItems[rawData->getName()] = row.first();
+
+    _updateSizesTimer.start();
+}
+
+void RawDataModel::removeRawData(const QString& rawDataName)
+{
+    const auto nameItem = _nameItems.take(rawDataName);
+
+    if (!nameItem)
+        return;
+
+#ifdef RAW_DATA_MODEL_VERBOSE
+    qDebug() << __FUNCTION__ << rawDataName;
+#endif
+
+    removeRow(nameItem->row());
+
+    _updateSizesTimer.start();
+}
+
+void RawDataModel::updateSizes()
+{
+    if (rowCount() > 0)
+        emit dataChanged(index(0, static_cast<int>(Column::Size)), index(rowCount() - 1, static_cast<int>(Column::Status)));
 
     _overallSizeAction.setString(QString("Overall size: %1").arg(util::getNoBytesHumanReadable(mv::data().getOverallRawDataSize())));
 }
@@ -12,8 +12,10 @@
 
 #include "actions/StringAction.h"
 
+#include <QHash>
 #include <QList>
 #include <QStandardItem>
+#include <QTimer>
 
 namespace mv {
 
@@ -33,6 +35,7 @@ public:
         Name,       /** Name of the raw data */
         Type,       /** Data type of the raw data */
         Size,       /** Size of the raw data */
+        Status,     /** Memory status of the raw data (resident or spilled to disk) */
 
         Count
     };
@@ -158,6 +161,39 @@ private:
         }
     };
 
+    /** Standard model item class for displaying the raw data memory status */
+    class RawDataStatusItem final : public Item {
+    public:
+
+        /** Use base item constructor */
+        using Item::Item;
+
+        /**
+         * Get model data for \p role
+         * @return Data for \p role in variant form
+         */
+        QVariant data(int role = Qt::UserRole + 1) const override;
+
+        /**
+         * Get header data for \p orientation and \p role
+         * @param orientation Horizontal/vertical
+         * @param role Data role
+         * @return Header data
+         */
+        static QVariant headerData(Qt::Orientation orientation, int role) {
+            switch (role) {
+                case Qt::DisplayRole:
+                case Qt::EditRole:
+                    return "Status";
+
+                case Qt::ToolTipRole:
+                    return "Whether the raw data resides in memory or is spilled to disk";
+            }
+
+            return {};
+        }
+    };
+
 public:
 
     /**
@@ -191,6 +227,7 @@ protected:
             append(new RawDataNameItem(rawDataName));
             append(new RawDataTypeItem(rawDataName));
             append(new RawDataSizeItem(rawDataName));
+            append(new RawDataStatusItem(rawDataName));
         }
 
     };
@@ -212,12 +249,31 @@ public:
     /** Populate the model with raw data from the data manager */
     void populateFromDataManager();
 
+    /** Update the size and status columns and the overall size (e.g. when the memory accounting changed) */
+    void updateSizes();
+
+private:
+
+    /**
+     * Append a row for \p rawData (this method is called when raw data is added to the manager)
+     * @param rawData Pointer to the raw data
+     */
+    void addRawData(plugin::RawData* rawData);
+
+    /**
+     * Remove the row of \p rawDataName (this method is called when raw data is removed from the manager)
+     * @param rawDataName Name of the raw data
+     */
+    void removeRawData(const QString& rawDataName);
+
 public: // Action getters
 
     gui::StringAction& getOverallSizeAction() { return _overallSizeAction; }
 
 private:
-    gui::StringAction   _overallSizeAction;     /** String action for displaying the overall raw data size */
+    gui::StringAction               _overallSizeAction;     /** String action for displaying the overall raw data size */
+    QHash<QString, QStandardItem*>  _nameItems;             /** Name item (first column) by raw data name, for constant time row lookup */
+    QTimer                          _updateSizesTimer;      /** Coalesces size updates when many rows are added or removed at once */
 };
 
 }
\ No newline at end of file
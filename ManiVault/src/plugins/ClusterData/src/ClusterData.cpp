@@ -347,7 +347,12 @@ std::vector<std::uint32_t>& Clusters::getSelectionIndices()
 
 void Clusters::setSelectionIndices(const std::vector<std::uint32_t>& indices)
 {
-    getSelection<Clusters>()->indices = indices;
+    setSelectionIndices(std::vector<std::uint32_t>(indices));
+}
+
+void Clusters::setSelectionIndices(std::vector<std::uint32_t>&& indices)
+{
+    getSelection<Clusters>()->indices = std::move(indices);
 
     events().notifyDatasetDataSelectionChanged(this);
 
@@ -355,20 +360,23 @@ void Clusters::setSelectionIndices(const std::vector<std::uint32_t>& indices)
         return;
 
     // Get reference to input dataset
-    auto points             = getDataHierarchyItem().getParent()->getDataset<Points>();
-    auto selection          = points->getSelection<Points>();
-    auto selectionIndices   = selection->indices;
+    auto points = getDataHierarchyItem().getParent()->getDataset<Points>();
 
-    selectionIndices.clear();
-    selectionIndices.reserve(indices.size());
+    const auto& clusters                = getClusters();
+    const auto& clusterSelectionIndices = getSelection<Clusters>()->indices;
 
-    std::vector<std::uint32_t> globalIndices;
+    std::size_t numberOfSelectedPoints = 0;
+
+    for (auto clusterSelectionIndex : clusterSelectionIndices)
+        numberOfSelectedPoints += clusters.at(clusterSelectionIndex).getIndices().size();
+
+    std::vector<std::uint32_t> selectionIndices;
 
-    points->getGlobalIndices(globalIndices);
+    selectionIndices.reserve(numberOfSelectedPoints);
 
     // Append point indices per cluster
-    for (auto clusterSelectionIndex : getSelection<Clusters>()->indices) {
-        const auto cluster = getClusters().at(clusterSelectionIndex);
+    for (auto clusterSelectionIndex : clusterSelectionIndices) {
+        const auto& cluster = clusters.at(clusterSelectionIndex);
         selectionIndices.insert(selectionIndices.end(), cluster.getIndices().begin(), cluster.getIndices().end());
     }
 
@@ -376,7 +384,7 @@ void Clusters::setSelectionIndices(const std::vector<std::uint32_t>& indices)
     std::sort(selectionIndices.begin(), selectionIndices.end());
     selectionIndices.erase(unique(selectionIndices.begin(), selectionIndices.end()), selectionIndices.end());
 
-    points->setSelectionIndices(selectionIndices);
+    points->setSelectionIndices(std::move(selectionIndices));
 
     events().notifyDatasetDataSelectionChanged(points);
 }
@@ -410,7 +418,7 @@ void Clusters::setSelectionNames(const QStringList& clusterNames)
     }
 
     // Set the selection
-    setSelectionIndices(selectionIndices);
+    setSelectionIndices(std::move(selectionIndices));
 }
 
 bool Clusters::canSelect() const
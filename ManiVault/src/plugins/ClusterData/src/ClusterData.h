@@ -228,6 +228,12 @@ public: // Selection
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /**
+     * Select by \p indices, which are moved into the selection
+     * @param indices Selection indices
+     */
+    void setSelectionIndices(std::vector<std::uint32_t>&& indices) override;
+
     /**
      * Get selection names
      * @return Selected cluster names
@@ -184,7 +184,7 @@ void ClustersActionWidget::setupSelectionSynchronization()
             selectedClustersIndices.push_back(_filterModel.mapToSource(selectedIndex).row());
 
         // Select clusters
-        _clustersAction.getClustersDataset()->setSelectionIndices(selectedClustersIndices);
+        _clustersAction.getClustersDataset()->setSelectionIndices(std::move(selectedClustersIndices));
     });
 
     // Highlight selected clusters (selection made elsewhere)
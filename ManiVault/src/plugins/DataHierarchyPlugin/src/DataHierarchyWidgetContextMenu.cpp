@@ -105,6 +105,9 @@ void DataHierarchyWidgetContextMenu::addMenusForPluginType(plugin::Type pluginTy
 {
     QMap<QString, QMenu*> menus;
 
+    // Trigger actions are only available for loaded plugins
+    Application::core()->getPluginManager().loadDeferredPluginFactories({ pluginType });
+
     for (const auto& pluginTriggerAction : Application::core()->getPluginManager().getPluginTriggerActions(pluginType, _selectedDatasets)) {
         const auto titleSegments = pluginTriggerAction->getMenuLocation().split("/");
 
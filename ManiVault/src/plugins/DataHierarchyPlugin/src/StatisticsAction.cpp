@@ -99,6 +99,7 @@ StatisticsAction::StatisticsAction(QObject* parent, const QString& title) :
 
     _rawDataGroupAction.addAction(&_rawDataCountGroupAction);
     _rawDataGroupAction.addAction(&_rawDataModel.getOverallSizeAction());
+    _rawDataGroupAction.addAction(&mv::memory().getSummaryAction());
 
     _datasetsGroupAction.addAction(const_cast<NumberOfRowsAction*>(&mv::data().getDatasetsListModel().getNumberOfRowsAction()));
     _datasetsGroupAction.addAction(&_datasetsTreeAction, -1, [this](WidgetAction* action, QWidget* widget) -> void {
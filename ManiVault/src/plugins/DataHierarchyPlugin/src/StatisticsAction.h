@@ -25,6 +25,7 @@
  * Action class for showing datasets statistics:
  * - Raw data overview
  * - Overall raw data size
+ * - Memory usage
  * - Datasets overview
  * - Selection sets
  *
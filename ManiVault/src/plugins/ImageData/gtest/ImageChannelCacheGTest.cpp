@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <ImageChannelCache.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /** Analytic pixel value of channel \p key, exactly representable as a float for the image sizes used in the tests */
+    float getPixelValue(std::int32_t x, std::int32_t y, std::int32_t width, std::uint32_t key)
+    {
+        return static_cast<float>(x + y * width) + 0.5f * static_cast<float>(key);
+    }
+
+    /** Get a channel populator for channel \p key of an image of \p imageSize which counts its invocations in \p numberOfCalls */
+    ImageChannelCache::ChannelPopulator createChannelPopulator(const QSize& imageSize, std::uint32_t key, std::uint32_t& numberOfCalls)
+    {
+        return [imageSize, key, &numberOfCalls](std::vector<float>& scalars) -> void {
+            numberOfCalls++;
+
+            for (std::int32_t y = 0; y < imageSize.height(); y++)
+                for (std::int32_t x = 0; x < imageSize.width(); x++)
+                    scalars[static_cast<std::size_t>(y) * imageSize.width() + x] = getPixelValue(x, y, imageSize.width(), key);
+        };
+    }
+
+    /** Number of bytes of a full resolution channel of \p imageSize */
+    std::uint64_t getNumberOfChannelBytes(const QSize& imageSize)
+    {
+        return static_cast<std::uint64_t>(imageSize.width()) * imageSize.height() * sizeof(float);
+    }
+}
+
+TEST(ImageChannelCache, cachesChannelsAndTheirRange)
+{
+    const QSize imageSize(16, 8);
+
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(imageSize);
+
+    std::uint32_t numberOfCalls = 0;
+
+    const auto channel = imageChannelCache.getChannel(3, createChannelPopulator(imageSize, 3, numberOfCalls));
+
+    ASSERT_TRUE(channel);
+    EXPECT_EQ(numberOfCalls, 1u);
+    EXPECT_TRUE(imageChannelCache.hasChannel(3));
+    EXPECT_FALSE(imageChannelCache.hasChannel(2));
+    EXPECT_EQ(channel->_minimum, getPixelValue(0, 0, imageSize.width(), 3));
+    EXPECT_EQ(channel->_maximum, getPixelValue(imageSize.width() - 1, imageSize.height() - 1, imageSize.width(), 3));
+
+    EXPECT_EQ(imageChannelCache.getChannel(3, createChannelPopulator(imageSize, 3, numberOfCalls)), channel);
+    EXPECT_EQ(numberOfCalls, 1u);
+    EXPECT_EQ(imageChannelCache.getNumberOfBytes(), getNumberOfChannelBytes(imageSize));
+}
+
+TEST(ImageChannelCache, cachesThePixelMapUntilInvalidated)
+{
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(QSize(4, 4));
+
+    std::uint32_t numberOfCalls = 0;
+
+    const auto populatePixelMap = [&numberOfCalls](ImageChannelCache::PixelMap& pixelMap) -> void {
+        numberOfCalls++;
+
+        pixelMap._offsets       = { 0, 2, 3 };
+        pixelMap._pixelIndices  = { 5, 7, 9 };
+    };
+
+    EXPECT_EQ(imageChannelCache.getPixelMap(populatePixelMap).getNumberOfPoints(), 2u);
+    EXPECT_EQ(imageChannelCache.getPixelMap(populatePixelMap)._pixelIndices, (std::vector<std::uint32_t>{ 5, 7, 9 }));
+    EXPECT_EQ(numberOfCalls, 1u);
+
+    imageChannelCache.invalidate();
+
+    imageChannelCache.getPixelMap(populatePixelMap);
+
+    EXPECT_EQ(numberOfCalls, 2u);
+}
+
+TEST(ImageChannelCache, invalidatesWhenTheImageSizeChanges)
+{
+    QSize imageSize(8, 8);
+
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(imageSize);
+
+    std::uint32_t numberOfChannelCalls  = 0;
+    std::uint32_t numberOfPixelMapCalls = 0;
+
+    const auto populatePixelMap = [&numberOfPixelMapCalls](ImageChannelCache::PixelMap& pixelMap) -> void {
+        numberOfPixelMapCalls++;
+
+        pixelMap._offsets       = { 0, 1 };
+        pixelMap._pixelIndices  = { 0 };
+    };
+
+    imageChannelCache.getChannel(0, createChannelPopulator(imageSize, 0, numberOfChannelCalls));
+    imageChannelCache.getPixelMap(populatePixelMap);
+
+    // Setting the same size keeps the cache
+    imageChannelCache.setImageSize(imageSize);
+
+    EXPECT_TRUE(imageChannelCache.hasChannel(0));
+
+    imageChannelCache.getPixelMap(populatePixelMap);
+
+    EXPECT_EQ(numberOfPixelMapCalls, 1u);
+
+    imageSize = QSize(4, 8);
+
+    imageChannelCache.setImageSize(imageSize);
+
+    EXPECT_FALSE(imageChannelCache.hasChannel(0));
+    EXPECT_EQ(imageChannelCache.getNumberOfBytes(), 0u);
+
+    imageChannelCache.getPixelMap(populatePixelMap);
+
+    EXPECT_EQ(numberOfPixelMapCalls, 2u);
+
+    const auto channel = imageChannelCache.getChannel(0, createChannelPopulator(imageSize, 0, numberOfChannelCalls));
+
+    EXPECT_EQ(numberOfChannelCalls, 2u);
+    EXPECT_EQ(channel->_levels.front().size(), 32u);
+}
+
+TEST(ImageChannelCache, evictsLeastRecentlyUsedChannelsWithinTheBudget)
+{
+    const QSize imageSize(8, 8);
+
+    ImageChannelCache imageChannelCache(2 * getNumberOfChannelBytes(imageSize));
+
+    imageChannelCache.setImageSize(imageSize);
+
+    std::uint32_t numberOfCalls = 0;
+
+    imageChannelCache.getChannel(0, createChannelPopulator(imageSize, 0, numberOfCalls));
+    imageChannelCache.getChannel(1, createChannelPopulator(imageSize, 1, numberOfCalls));
+
+    // Touch channel zero so that channel one becomes the least recently used
+    imageChannelCache.getChannel(0, createChannelPopulator(imageSize, 0, numberOfCalls));
+    imageChannelCache.getChannel(2, createChannelPopulator(imageSize, 2, numberOfCalls));
+
+    EXPECT_EQ(numberOfCalls, 3u);
+    EXPECT_TRUE(imageChannelCache.hasChannel(0));
+    EXPECT_FALSE(imageChannelCache.hasChannel(1));
+    EXPECT_TRUE(imageChannelCache.hasChannel(2));
+    EXPECT_LE(imageChannelCache.getNumberOfBytes(), imageChannelCache.getMaximumNumberOfBytes());
+
+    // Shrinking the budget evicts down to (at least) the most recently used channel
+    imageChannelCache.setMaximumNumberOfBytes(0);
+
+    EXPECT_FALSE(imageChannelCache.hasChannel(0));
+    EXPECT_TRUE(imageChannelCache.hasChannel(2));
+}
+
+TEST(ImageChannelCache, evictedChannelsRemainValidForTheirHolders)
+{
+    const QSize imageSize(8, 8);
+
+    ImageChannelCache imageChannelCache(getNumberOfChannelBytes(imageSize));
+
+    imageChannelCache.setImageSize(imageSize);
+
+    std::uint32_t numberOfCalls = 0;
+
+    const auto channel = imageChannelCache.getChannel(0, createChannelPopulator(imageSize, 0, numberOfCalls));
+
+    imageChannelCache.getChannel(1, createChannelPopulator(imageSize, 1, numberOfCalls));
+
+    EXPECT_FALSE(imageChannelCache.hasChannel(0));
+    ASSERT_EQ(channel->_levels.front().size(), 64u);
+    EXPECT_EQ(channel->_levels.front()[63], getPixelValue(7, 7, imageSize.width(), 0));
+}
+
+TEST(ImageChannelCache, computesPyramidLevels)
+{
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(QSize(32, 32));
+
+    EXPECT_EQ(imageChannelCache.getNumberOfLevels(), 1u);
+
+    imageChannelCache.setImageSize(QSize(256, 128));
+
+    EXPECT_EQ(imageChannelCache.getNumberOfLevels(), 2u);
+    EXPECT_EQ(imageChannelCache.getLevelSize(1), QSize(128, 64));
+
+    imageChannelCache.setImageSize(QSize(515, 259));
+
+    EXPECT_EQ(imageChannelCache.getNumberOfLevels(), 3u);
+    EXPECT_EQ(imageChannelCache.getLevelSize(1), QSize(258, 130));
+    EXPECT_EQ(imageChannelCache.getLevelSize(2), QSize(129, 65));
+}
+
+TEST(ImageChannelCache, buildsLevelsWithABoxFilter)
+{
+    const QSize imageSize(129, 130);
+
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(imageSize);
+
+    ASSERT_EQ(imageChannelCache.getNumberOfLevels(), 2u);
+
+    const auto levelSize = imageChannelCache.getLevelSize(1);
+
+    ASSERT_EQ(levelSize, QSize(65, 65));
+
+    std::uint32_t numberOfCalls = 0;
+
+    QVector<float> regionScalars;
+
+    const auto region = imageChannelCache.getRegion(0, 1, QRect(QPoint(0, 0), levelSize), regionScalars, createChannelPopulator(imageSize, 0, numberOfCalls));
+
+    ASSERT_EQ(region, QRect(QPoint(0, 0), levelSize));
+    ASSERT_EQ(regionScalars.size(), 65 * 65);
+
+    const auto getSourceValue = [&imageSize](std::int32_t x, std::int32_t y) -> float {
+        return getPixelValue(std::min(x, imageSize.width() - 1), std::min(y, imageSize.height() - 1), imageSize.width(), 0);
+    };
+
+    for (std::int32_t y = 0; y < levelSize.height(); y++) {
+        for (std::int32_t x = 0; x < levelSize.width(); x++) {
+            const auto expectedValue = 0.25f * (getSourceValue(2 * x, 2 * y) + getSourceValue(2 * x + 1, 2 * y) + getSourceValue(2 * x, 2 * y + 1) + getSourceValue(2 * x + 1, 2 * y + 1));
+
+            ASSERT_FLOAT_EQ(regionScalars[y * levelSize.width() + x], expectedValue) << "at " << x << ", " << y;
+        }
+    }
+
+    // The level is accounted for in the memory usage
+    EXPECT_EQ(imageChannelCache.getNumberOfBytes(), getNumberOfChannelBytes(imageSize) + getNumberOfChannelBytes(levelSize));
+}
+
+TEST(ImageChannelCache, clipsRegionsToTheLevel)
+{
+    const QSize imageSize(16, 8);
+
+    ImageChannelCache imageChannelCache;
+
+    imageChannelCache.setImageSize(imageSize);
+
+    std::uint32_t numberOfCalls = 0;
+
+    QVector<float> regionScalars;
+
+    const auto region = imageChannelCache.getRegion(1, 0, QRect(12, -2, 8, 5), regionScalars, createChannelPopulator(imageSize, 1, numberOfCalls));
+
+    ASSERT_EQ(region, QRect(12, 0, 4, 3));
+    ASSERT_EQ(regionScalars.size(), 12);
+
+    for (std::int32_t y = 0; y < region.height(); y++)
+        for (std::int32_t x = 0; x < region.width(); x++)
+            EXPECT_EQ(regionScalars[y * region.width() + x], getPixelValue(region.left() + x, region.top() + y, imageSize.width(), 1));
+
+    // Regions outside the level are empty, levels beyond the pyramid are clamped to the coarsest level
+    EXPECT_TRUE(imageChannelCache.getRegion(1, 0, QRect(20, 20, 4, 4), regionScalars, createChannelPopulator(imageSize, 1, numberOfCalls)).isEmpty());
+    EXPECT_TRUE(regionScalars.isEmpty());
+    EXPECT_EQ(imageChannelCache.getRegion(1, 7, QRect(QPoint(0, 0), imageSize), regionScalars, createChannelPopulator(imageSize, 1, numberOfCalls)), QRect(QPoint(0, 0), imageSize));
+    EXPECT_EQ(numberOfCalls, 1u);
+}
@@ -0,0 +1,229 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "ImageChannelCache.h"
+
+#include <algorithm>
+#include <limits>
+
+ImageChannelCache::ImageChannelCache(std::uint64_t maximumNumberOfBytes /*= defaultMaximumNumberOfBytes*/) :
+    _imageSize(),
+    _maximumNumberOfBytes(maximumNumberOfBytes),
+    _entries(),
+    _pixelMap(),
+    _usageCounter(0)
+{
+}
+
+void ImageChannelCache::setImageSize(const QSize& imageSize)
+{
+    if (imageSize == _imageSize)
+        return;
+
+    _imageSize = imageSize;
+
+    invalidate();
+}
+
+QSize ImageChannelCache::getImageSize() const
+{
+    return _imageSize;
+}
+
+std::uint64_t ImageChannelCache::getMaximumNumberOfBytes() const
+{
+    return _maximumNumberOfBytes;
+}
+
+void ImageChannelCache::setMaximumNumberOfBytes(std::uint64_t maximumNumberOfBytes)
+{
+    _maximumNumberOfBytes = maximumNumberOfBytes;
+
+    evict();
+}
+
+std::uint64_t ImageChannelCache::getNumberOfBytes() const
+{
+    std::uint64_t numberOfBytes = 0;
+
+    for (const auto& [key, entry] : _entries)
+        numberOfBytes += getNumberOfBytes(*entry._channel);
+
+    return numberOfBytes;
+}
+
+void ImageChannelCache::invalidate()
+{
+    _entries.clear();
+
+    _pixelMap = PixelMap();
+}
+
+const ImageChannelCache::PixelMap& ImageChannelCache::getPixelMap(const PixelMapPopulator& populator)
+{
+    if (!_pixelMap.isValid())
+        populator(_pixelMap);
+
+    return _pixelMap;
+}
+
+std::shared_ptr<const ImageChannelCache::Channel> ImageChannelCache::getChannel(std::uint32_t key, const ChannelPopulator& populator)
+{
+    auto it = _entries.find(key);
+
+    if (it != _entries.end()) {
+        it->second._lastUsed = ++_usageCounter;
+
+        return it->second._channel;
+    }
+
+    const auto numberOfLevels = getNumberOfLevels();
+
+    auto channel = std::make_shared<Channel>();
+
+    // Allocate all levels up front so that references to existing levels remain valid when levels are built lazily
+    channel->_levels.resize(numberOfLevels);
+    channel->_levelSizes.resize(numberOfLevels);
+
+    for (std::uint32_t level = 0; level < numberOfLevels; level++)
+        channel->_levelSizes[level] = getLevelSize(level);
+
+    auto& scalars = channel->_levels.front();
+
+    scalars.assign(static_cast<std::size_t>(_imageSize.width()) * _imageSize.height(), 0.f);
+
+    populator(scalars);
+
+    channel->_minimum = std::numeric_limits<float>::max();
+    channel->_maximum = std::numeric_limits<float>::lowest();
+
+    for (const auto& scalar : scalars) {
+        channel->_minimum = std::min(channel->_minimum, scalar);
+        channel->_maximum = std::max(channel->_maximum, scalar);
+    }
+
+    _entries[key] = { channel, ++_usageCounter };
+
+    evict();
+
+    return channel;
+}
+
+bool ImageChannelCache::hasChannel(std::uint32_t key) const
+{
+    return _entries.find(key) != _entries.end();
+}
+
+QRect ImageChannelCache::getRegion(std::uint32_t key, std::uint32_t level, const QRect& region, QVector<float>& regionScalars, const ChannelPopulator& populator)
+{
+    const auto channel = std::const_pointer_cast<Channel>(getChannel(key, populator));
+
+    level = std::min(level, static_cast<std::uint32_t>(channel->_levels.size() - 1));
+
+    buildLevels(*channel, level);
+
+    evict();
+
+    const auto& levelSize       = channel->_levelSizes[level];
+    const auto& levelScalars    = channel->_levels[level];
+    const auto clippedRegion    = region.intersected(QRect(QPoint(0, 0), levelSize));
+
+    regionScalars.resize(static_cast<qsizetype>(clippedRegion.width()) * clippedRegion.height());
+
+    if (clippedRegion.isEmpty())
+        return clippedRegion;
+
+    for (std::int32_t y = 0; y < clippedRegion.height(); y++) {
+        const auto sourceBegin = levelScalars.begin() + static_cast<std::size_t>(clippedRegion.top() + y) * levelSize.width() + clippedRegion.left();
+
+        std::copy(sourceBegin, sourceBegin + clippedRegion.width(), regionScalars.begin() + static_cast<qsizetype>(y) * clippedRegion.width());
+    }
+
+    return clippedRegion;
+}
+
+std::uint32_t ImageChannelCache::getNumberOfLevels() const
+{
+    std::uint32_t numberOfLevels = 1;
+
+    auto levelSize = _imageSize;
+
+    while (levelSize.width() / 2 >= minimumLevelSize && levelSize.height() / 2 >= minimumLevelSize) {
+        levelSize = QSize((levelSize.width() + 1) / 2, (levelSize.height() + 1) / 2);
+
+        numberOfLevels++;
+    }
+
+    return numberOfLevels;
+}
+
+QSize ImageChannelCache::getLevelSize(std::uint32_t level) const
+{
+    auto levelSize = _imageSize;
+
+    for (std::uint32_t levelIndex = 0; levelIndex < level; levelIndex++)
+        levelSize = QSize((levelSize.width() + 1) / 2, (levelSize.height() + 1) / 2);
+
+    return levelSize;
+}
+
+void ImageChannelCache::buildLevels(Channel& channel, std::uint32_t level)
+{
+    for (std::uint32_t levelIndex = 1; levelIndex <= level; levelIndex++) {
+        auto& levelScalars = channel._levels[levelIndex];
+
+        if (!levelScalars.empty())
+            continue;
+
+        const auto& sourceScalars   = channel._levels[levelIndex - 1];
+        const auto& sourceSize      = channel._levelSizes[levelIndex - 1];
+        const auto& targetSize      = channel._levelSizes[levelIndex];
+
+        levelScalars.resize(static_cast<std::size_t>(targetSize.width()) * targetSize.height());
+
+        // 2x2 box filter, odd source sizes average the available pixels at the border
+        for (std::int32_t targetY = 0; targetY < targetSize.height(); targetY++) {
+            const auto sourceY0 = 2 * targetY;
+            const auto sourceY1 = std::min(sourceY0 + 1, sourceSize.height() - 1);
+
+            for (std::int32_t targetX = 0; targetX < targetSize.width(); targetX++) {
+                const auto sourceX0 = 2 * targetX;
+                const auto sourceX1 = std::min(sourceX0 + 1, sourceSize.width() - 1);
+
+                const auto sum = sourceScalars[static_cast<std::size_t>(sourceY0) * sourceSize.width() + sourceX0] +
+                                 sourceScalars[static_cast<std::size_t>(sourceY0) * sourceSize.width() + sourceX1] +
+                                 sourceScalars[static_cast<std::size_t>(sourceY1) * sourceSize.width() + sourceX0] +
+                                 sourceScalars[static_cast<std::size_t>(sourceY1) * sourceSize.width() + sourceX1];
+
+                levelScalars[static_cast<std::size_t>(targetY) * targetSize.width() + targetX] = 0.25f * sum;
+            }
+        }
+    }
+}
+
+void ImageChannelCache::evict()
+{
+    auto numberOfBytes = getNumberOfBytes();
+
+    // Always keep the most recently used channel, even when it exceeds the budget on its own
+    while (numberOfBytes > _maximumNumberOfBytes && _entries.size() > 1) {
+        const auto leastRecentlyUsed = std::min_element(_entries.begin(), _entries.end(), [](const auto& lhs, const auto& rhs) -> bool {
+            return lhs.second._lastUsed < rhs.second._lastUsed;
+        });
+
+        numberOfBytes -= getNumberOfBytes(*leastRecentlyUsed->second._channel);
+
+        _entries.erase(leastRecentlyUsed);
+    }
+}
+
+std::uint64_t ImageChannelCache::getNumberOfBytes(const Channel& channel)
+{
+    std::uint64_t numberOfBytes = 0;
+
+    for (const auto& levelScalars : channel._levels)
+        numberOfBytes += levelScalars.size() * sizeof(float);
+
+    return numberOfBytes;
+}
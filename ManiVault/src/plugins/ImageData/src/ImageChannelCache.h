@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "Common.h"
+
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+/**
+ * Image channel cache class
+ *
+ * Caches scalar image channels (one per source dimension) so that switching the displayed channel does not rebuild
+ * the scalar data from the source dataset every time. Each cached channel stores its full resolution scalars, its
+ * scalar range and a lazily built multi-resolution pyramid (each level halves the resolution using a 2x2 box filter),
+ * so that views can request only the visible region at the current zoom level.
+ *
+ * The cache also owns the pixel map: for each (local) point of the source dataset the pixel indices it covers
+ * (its global index plus the linked data mappings), which is the expensive part of producing a channel.
+ *
+ * Channels are evicted in least-recently-used order when the memory budget is exceeded. The owner is responsible
+ * for calling invalidate() when the source data, its dimensions or the linked data (selection mappings) the pixel
+ * map was built from change; the images dataset does so on the corresponding dataset events.
+ *
+ * @author Thomas Kroes
+ */
+class IMAGEDATA_EXPORT ImageChannelCache
+{
+public:
+
+    /** Maps each local point of the source dataset to the pixels it covers (compressed sparse row layout) */
+    struct PixelMap
+    {
+        std::vector<std::uint32_t>  _offsets;       /** Offset into the pixel indices for each local point (size is number of points + 1) */
+        std::vector<std::uint32_t>  _pixelIndices;  /** Pixel indices covered by the points */
+
+        /** Get whether the pixel map is populated */
+        bool isValid() const {
+            return !_offsets.empty();
+        }
+
+        /**
+         * Get number of points in the map
+         * @return Number of points
+         */
+        std::uint32_t getNumberOfPoints() const {
+            return _offsets.empty() ? 0 : static_cast<std::uint32_t>(_offsets.size() - 1);
+        }
+    };
+
+    /** Cached scalar channel */
+    struct Channel
+    {
+        std::vector<std::vector<float>>     _levels;        /** Pyramid levels, level zero is the full resolution channel */
+        std::vector<QSize>                  _levelSizes;    /** Size of each pyramid level */
+        float                               _minimum;       /** Minimum scalar value */
+        float                               _maximum;       /** Maximum scalar value */
+    };
+
+    /** Populates full resolution scalars (sized to the number of pixels and zero-initialized) */
+    using ChannelPopulator  = std::function<void(std::vector<float>& scalars)>;
+
+    /** Populates the pixel map */
+    using PixelMapPopulator = std::function<void(PixelMap& pixelMap)>;
+
+    /** Default memory budget for cached channels (including their pyramid levels) */
+    static constexpr std::uint64_t defaultMaximumNumberOfBytes = 512ull * 1024ull * 1024ull;
+
+    /** Pyramid levels are not reduced below this width/height */
+    static constexpr std::int32_t minimumLevelSize = 64;
+
+public:
+
+    /**
+     * Construct with \p maximumNumberOfBytes memory budget
+     * @param maximumNumberOfBytes Memory budget for the cached channels
+     */
+    explicit ImageChannelCache(std::uint64_t maximumNumberOfBytes = defaultMaximumNumberOfBytes);
+
+    /**
+     * Set the image size to \p imageSize (invalidates the cache when it changes)
+     * @param imageSize Size of the image
+     */
+    void setImageSize(const QSize& imageSize);
+
+    /**
+     * Get the image size
+     * @return Size of the image
+     */
+    QSize getImageSize() const;
+
+    /**
+     * Get the memory budget
+     * @return Memory budget in bytes
+     */
+    std::uint64_t getMaximumNumberOfBytes() const;
+
+    /**
+     * Set the memory budget to \p maximumNumberOfBytes (evicts channels when exceeded)
+     * @param maximumNumberOfBytes Memory budget in bytes
+     */
+    void setMaximumNumberOfBytes(std::uint64_t maximumNumberOfBytes);
+
+    /**
+     * Get the number of bytes occupied by the cached channels
+     * @return Number of bytes
+     */
+    std::uint64_t getNumberOfBytes() const;
+
+    /** Remove all cached channels and the pixel map */
+    void invalidate();
+
+    /**
+     * Get the pixel map, populated with \p populator when not cached
+     * @param populator Populates the pixel map
+     * @return Reference to the pixel map
+     */
+    const PixelMap& getPixelMap(const PixelMapPopulator& populator);
+
+    /**
+     * Get channel with \p key, populated with \p populator when not cached
+     * @param key Channel key (e.g. dimension index)
+     * @param populator Populates the full resolution scalars
+     * @return Shared pointer to the channel (remains valid when the channel is evicted)
+     */
+    std::shared_ptr<const Channel> getChannel(std::uint32_t key, const ChannelPopulator& populator);
+
+    /**
+     * Get whether channel with \p key is cached
+     * @param key Channel key
+     * @return Boolean determining whether the channel is cached
+     */
+    bool hasChannel(std::uint32_t key) const;
+
+    /**
+     * Copy \p region of pyramid \p level of channel \p key to \p regionScalars (row-major, region width x region height)
+     * @param key Channel key
+     * @param level Pyramid level (clamped to the available levels)
+     * @param region Region in level pixel coordinates (clipped to the level)
+     * @param regionScalars Scalars of the region (resized to the clipped region)
+     * @param populator Populates the full resolution scalars when the channel is not cached
+     * @return Clipped region
+     */
+    QRect getRegion(std::uint32_t key, std::uint32_t level, const QRect& region, QVector<float>& regionScalars, const ChannelPopulator& populator);
+
+    /**
+     * Get the number of pyramid levels for the image size
+     * @return Number of levels (at least one)
+     */
+    std::uint32_t getNumberOfLevels() const;
+
+    /**
+     * Get size of pyramid \p level
+     * @param level Pyramid level
+     * @return Size of the level
+     */
+    QSize getLevelSize(std::uint32_t level) const;
+
+private:
+
+    /**
+     * Build missing pyramid levels up to and including \p level for \p channel
+     * @param channel Channel to build the levels for
+     * @param level Pyramid level
+     */
+    void buildLevels(Channel& channel, std::uint32_t level);
+
+    /** Evict least recently used channels until the cache fits the memory budget */
+    void evict();
+
+    /**
+     * Get the number of bytes occupied by \p channel
+     * @param channel Channel
+     * @return Number of bytes
+     */
+    static std::uint64_t getNumberOfBytes(const Channel& channel);
+
+private:
+
+    /** Cache entry */
+    struct Entry
+    {
+        std::shared_ptr<Channel>    _channel;   /** Cached channel */
+        std::uint64_t               _lastUsed;  /** Usage stamp for least-recently-used eviction */
+    };
+
+    QSize                           _imageSize;             /** Size of the image */
+    std::uint64_t                   _maximumNumberOfBytes;  /** Memory budget for the cached channels */
+    std::map<std::uint32_t, Entry>  _entries;               /** Cached channels by key */
+    PixelMap                        _pixelMap;              /** Cached pixel map */
+    std::uint64_t                   _usageCounter;          /** Incremented on each channel access */
+};
@@ -8,7 +8,8 @@
 #include "InfoAction.h"
 
 #include <util/Exception.h>
-#include <util/Timer.h>
+#include <util/MemoryAccounting.h>
+#include <util/Trace.h>
 
 #include <DataHierarchyItem.h>
 #include <Dataset.h>
@@ -22,6 +23,7 @@
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <utility>
 
 #include <QDebug>
 
@@ -34,13 +36,21 @@ Images::Images(QString dataName, bool mayUnderive /*= false*/, const QString& gu
     _infoAction(),
     _visibleRectangle(),
     _maskData(),
-    _maskDataGiven(false)
+    _maskDataGiven(false),
+    _scalarDataCache(),
+    _scalarDataSource(),
+    _linkedDataSource()
 {
     _imageData = getRawData<ImageData>();
 
     setLinkedDataFlags(0);
 }
 
+Images::~Images()
+{
+    MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getId());
+}
+
 void Images::init()
 {
     DatasetImpl::init();
@@ -54,6 +64,20 @@ void Images::init()
         !(getDataHierarchyItem().getParent()->getDataType() == PointType || getDataHierarchyItem().getParent()->getDataType() == ClusterType))
         qCritical() << "Images: warning: image data set must be derived from points or clusters.";
 
+    _scalarDataSource = getParent();
+
+    // Cached channels are derived from the parent data, so discard them when it changes
+    if (_scalarDataSource.isValid()) {
+        connect(&_scalarDataSource, &Dataset<DatasetImpl>::dataChanged, this, &Images::invalidateScalarDataCache);
+        connect(&_scalarDataSource, &Dataset<DatasetImpl>::dataDimensionsChanged, this, &Images::invalidateScalarDataCache);
+
+        // The pixel map (and thus every cached channel) also depends on the selection mappings of the linked data: of the points
+        // themselves, or of the embedding in case of clusters
+        _linkedDataSource = _scalarDataSource->getDataType() == ClusterType ? _scalarDataSource->getParent() : _scalarDataSource;
+
+        if (_linkedDataSource.isValid())
+            connect(&_linkedDataSource, &Dataset<DatasetImpl>::linkedDataChanged, this, &Images::invalidateScalarDataCache);
+    }
 }
 
 std::tuple<mv::Dataset<mv::DatasetImpl>, mv::Dataset<Images>> Images::addImageDataset(QString datasetGuiName, const mv::Dataset<mv::DatasetImpl>& parentDataSet /*= Dataset<DatasetImpl>()*/, const QString pluginKind /*= "Points"*/)
@@ -227,7 +251,9 @@ void Images::getScalarData(const std::uint32_t& dimensionIndex, QVector<float>&
 
             case ImageData::Stack:
                 getScalarDataForImageStack(dimensionIndex, scalarData, scalarDataRange);
-                break;
+
+                // The scalar data range is cached alongside the channel
+                return;
 
             case ImageData::MultiPartSequence:
                 break;
@@ -293,16 +319,23 @@ void Images::getScalarData(const std::vector<std::uint32_t>& dimensionIndices, Q
             {
                 std::int32_t componentIndex = 0;
 
+                scalarDataRange = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+
+                // Interleave directly from the cached channels, no intermediate copy is needed
                 for (const auto& dimensionIndex : dimensionIndices) {
-                    getScalarDataForImageStack(dimensionIndex, tempScalarData, tempScalarDataRange);
+                    const auto channel  = getImageStackChannel(dimensionIndex);
+                    const auto& scalars = channel->_levels.front();
 
                     for (std::int32_t pixelIndex = 0; pixelIndex < numberOfPixels; pixelIndex++)
-                        scalarData[static_cast<size_t>(pixelIndex * numberOfComponentsPerPixel) + componentIndex] = tempScalarData[pixelIndex];
+                        scalarData[static_cast<size_t>(pixelIndex * numberOfComponentsPerPixel) + componentIndex] = scalars[pixelIndex];
+
+                    scalarDataRange.first   = std::min(channel->_minimum, scalarDataRange.first);
+                    scalarDataRange.second  = std::max(channel->_maximum, scalarDataRange.second);
 
                     componentIndex++;
                 }
 
-                break;
+                return;
             }
 
             case ImageData::MultiPartSequence:
@@ -357,6 +390,64 @@ void Images::getImageScalarData(std::uint32_t imageIndex, QVector<float>& scalar
     }
 }
 
+std::uint32_t Images::getNumberOfScalarDataLevels()
+{
+    _scalarDataCache.setImageSize(getImageSize());
+
+    return _scalarDataCache.getNumberOfLevels();
+}
+
+QSize Images::getScalarDataLevelSize(std::uint32_t level)
+{
+    _scalarDataCache.setImageSize(getImageSize());
+
+    return _scalarDataCache.getLevelSize(level);
+}
+
+QRect Images::getScalarDataForRegion(std::uint32_t dimensionIndex, std::uint32_t level, const QRect& region, QVector<float>& regionScalarData, QPair<float, float>& scalarDataRange)
+{
+    try
+    {
+        if (_imageData->getType() != ImageData::Stack)
+            throw std::runtime_error("Region scalar data is only available for image stacks");
+
+        const auto channel = getImageStackChannel(dimensionIndex);
+
+        scalarDataRange = { channel->_minimum, channel->_maximum };
+
+        const auto clippedRegion = _scalarDataCache.getRegion(dimensionIndex, level, region, regionScalarData, [this, dimensionIndex](std::vector<float>& scalars) -> void {
+            computeImageStackScalarData(dimensionIndex, scalars);
+        });
+
+        updateScalarDataCacheAccounting();
+
+        return clippedRegion;
+    }
+    catch (std::exception& e)
+    {
+        exceptionMessageBox("Unable to get scalar data for the given region", e);
+    }
+    catch (...) {
+        exceptionMessageBox("Unable to get scalar data for the given region");
+    }
+
+    regionScalarData.clear();
+
+    return {};
+}
+
+void Images::invalidateScalarDataCache()
+{
+    _scalarDataCache.invalidate();
+
+    updateScalarDataCacheAccounting();
+}
+
+ImageChannelCache& Images::getScalarDataCache()
+{
+    return _scalarDataCache;
+}
+
 void Images::getMaskData(std::vector<std::uint8_t>& maskData)
 {
     if (_maskData.empty())
@@ -400,7 +491,7 @@ void Images::getSelectionData(std::vector<std::uint8_t>& selectionImageData, std
             auto points = Dataset<Points>(parentDataset);
 
             // Get selection indices from points dataset
-            auto& selectionIndices = points->getSelection<Points>()->indices;
+            const auto& selectionIndices = points->getSelection<Points>()->getIndices();
 
             // Clear the selected indices
             selectedIndices.clear();
@@ -412,12 +503,6 @@ void Images::getSelectionData(std::vector<std::uint8_t>& selectionImageData, std
             // Computes and caches the mask data
             computeMaskData();
 
-            // Global indices into data
-            std::vector<std::uint32_t> globalIndices;
-
-            // Get global indices from points
-            points->getGlobalIndices(globalIndices);
-
             // Iterate over selection indices and modify the selection boundaries when not masked
             for (const auto& selectionIndex : selectionIndices) {
 
@@ -452,11 +537,11 @@ void Images::getSelectionData(std::vector<std::uint8_t>& selectionImageData, std
             // Get clusters input points dataset
             auto points = parentDataset->getParent()->getSourceDataset<Points>();
 
-            // Global indices into data
-            std::vector<std::uint32_t> globalIndices;
+            // Cached global index map of the points
+            const auto globalIndexMap = points->getGlobalIndexMap();
 
-            // Get global indices from points
-            points->getGlobalIndices(globalIndices);
+            // Global indices into data
+            const auto& globalIndices = globalIndexMap->getLocalToGlobal();
 
             // Iterate over all clusters and populate the selection data
             for (const auto& clusterIndex : sourceClusters->indices) {
@@ -526,12 +611,12 @@ void Images::getScalarDataForImageSequence(const std::uint32_t& dimensionIndex,
         targetImageSize.setWidth(static_cast<int>(floorf(sourceImageSize.width())));
         targetImageSize.setHeight(static_cast<int>(floorf(sourceImageSize.height())));
 
-        points->visitData([this, points, dimensionIndex, &scalarData, sourceImageSize, targetImageSize](auto pointData) {
+        std::as_const(*points).visitData([this, points, dimensionIndex, &scalarData, sourceImageSize, targetImageSize](auto pointData) {
             const auto dimensionId       = dimensionIndex;
             const auto imageSize         = _imageData->getImageSize();
             const auto noPixels          = getNumberOfPixels();
             const auto selection         = points->getSelection<Points>();
-            const auto& selectionIndices = selection->indices;
+            const auto& selectionIndices = selection->getIndices();
             const auto selectionSize     = selectionIndices.size();
 
             if (!selectionIndices.empty()) {
@@ -567,49 +652,89 @@ void Images::getScalarDataForImageSequence(const std::uint32_t& dimensionIndex,
 
 void Images::getScalarDataForImageStack(const std::uint32_t& dimensionIndex, QVector<float>& scalarData, QPair<float, float>& scalarDataRange)
 {
-    //Timer timer(__FUNCTION__);
+    MV_TRACE_SCOPE("data", "Images::getScalarDataForImageStack");
+
+    const auto channel  = getImageStackChannel(dimensionIndex);
+    const auto& scalars = channel->_levels.front();
+
+    std::copy(scalars.begin(), scalars.end(), scalarData.begin());
+
+    scalarDataRange = { channel->_minimum, channel->_maximum };
+}
+
+std::shared_ptr<const ImageChannelCache::Channel> Images::getImageStackChannel(const std::uint32_t& dimensionIndex)
+{
+    _scalarDataCache.setImageSize(getImageSize());
+
+    auto channel = _scalarDataCache.getChannel(dimensionIndex, [this, dimensionIndex](std::vector<float>& scalars) -> void {
+        computeImageStackScalarData(dimensionIndex, scalars);
+    });
+
+    updateScalarDataCacheAccounting();
+
+    return channel;
+}
+
+void Images::computeImageStackScalarData(const std::uint32_t& dimensionIndex, std::vector<float>& scalars)
+{
+    MV_TRACE_SCOPE("data", "Images::computeImageStackScalarData");
 
     auto parent = getParent();
 
     if (parent->getDataType() == PointType) {
         auto points = Dataset<Points>(parent);
 
-        std::vector<std::uint32_t> globalIndices;
+        // The pixels covered by each point (the global index plus linked data) do not depend on the dimension, so they are resolved once and shared by all channels
+        const auto& pixelMap = _scalarDataCache.getPixelMap([&points](ImageChannelCache::PixelMap& pixelMap) -> void {
+            const auto globalIndexMap   = points->getGlobalIndexMap();
+            const auto& globalIndices   = globalIndexMap->getLocalToGlobal();
 
-        points->getGlobalIndices(globalIndices);
+            // Only linked data which has the same original full data applies, because we don't want to add data here that belongs to a different dataset
+            std::vector<const LinkedData*> applicableLinkedData;
 
-        if (points->isFull()) {
-            points->visitData([this, &points, dimensionIndex, &globalIndices, &scalarData](auto pointData) {
-                for (std::int32_t localPointIndex = 0; localPointIndex < globalIndices.size(); localPointIndex++) {
-                    const auto targetPixelIndex = globalIndices[localPointIndex];
+            if (points->isFull()) {
+                const auto fullDataset = points->getSourceDataset<Points>()->getFullDataset<Points>();
 
-                    // If the data has any linked data
-                    for (LinkedData& linkedData : points->getLinkedData())
-                    {
-                        // Check if the linked data has the same original full data, because we don't want to
-                        // add data here that belongs to a different dataset
-                        if (linkedData.getTargetDataset()->getFullDataset<Points>() == points->getSourceDataset<Points>()->getFullDataset<Points>())
-                        {
-                            SelectionMap::Indices linkedIndices;
-                    
-                            linkedData.getMapping().populateMappingIndices(targetPixelIndex, linkedIndices);
-                            
-                            // Fill in the data for all the linked data indices based on the location of the original id
-                            for (unsigned int linkedIndex : linkedIndices)
-                                scalarData[linkedIndex] = pointData[localPointIndex][dimensionIndex];
-                        }
-                    }
+                for (const LinkedData& linkedData : points->getLinkedData())
+                    if (linkedData.getTargetDataset()->getFullDataset<Points>() == fullDataset)
+                        applicableLinkedData.push_back(&linkedData);
+            }
+
+            pixelMap._offsets.resize(globalIndices.size() + 1);
+            pixelMap._pixelIndices.clear();
+            pixelMap._pixelIndices.reserve(globalIndices.size());
+
+            SelectionMap::Indices linkedIndices;
 
-                    scalarData[targetPixelIndex] = pointData[localPointIndex][dimensionIndex];
+            for (std::size_t localPointIndex = 0; localPointIndex < globalIndices.size(); localPointIndex++) {
+                const auto targetPixelIndex = globalIndices[localPointIndex];
+
+                pixelMap._offsets[localPointIndex] = static_cast<std::uint32_t>(pixelMap._pixelIndices.size());
+
+                for (const auto linkedData : applicableLinkedData) {
+                    linkedIndices.clear();
+
+                    linkedData->getMapping().populateMappingIndices(targetPixelIndex, linkedIndices);
+
+                    pixelMap._pixelIndices.insert(pixelMap._pixelIndices.end(), linkedIndices.begin(), linkedIndices.end());
                 }
-            });
-        }
-        else {
-            points->visitData([this, dimensionIndex, &globalIndices, &scalarData](auto pointData) {
-                for (std::uint32_t pointIndex = 0; pointIndex < pointData.size(); pointIndex++)
-                    scalarData[globalIndices[pointIndex]] = pointData[pointIndex][dimensionIndex];
-            });
-        }
+
+                pixelMap._pixelIndices.push_back(targetPixelIndex);
+            }
+
+            pixelMap._offsets.back() = static_cast<std::uint32_t>(pixelMap._pixelIndices.size());
+        });
+
+        std::as_const(*points).visitData([&pixelMap, dimensionIndex, &scalars](auto pointData) {
+            const auto numberOfPoints = std::min(pixelMap.getNumberOfPoints(), static_cast<std::uint32_t>(pointData.size()));
+
+            for (std::uint32_t localPointIndex = 0; localPointIndex < numberOfPoints; localPointIndex++) {
+                const auto scalar = static_cast<float>(pointData[localPointIndex][dimensionIndex]);
+
+                for (auto offset = pixelMap._offsets[localPointIndex]; offset < pixelMap._offsets[localPointIndex + 1]; offset++)
+                    scalars[pixelMap._pixelIndices[offset]] = scalar;
+            }
+        });
     }
 
     // Generate scalars for clusters
@@ -618,56 +743,49 @@ void Images::getScalarDataForImageStack(const std::uint32_t& dimensionIndex, QVe
         // Obtain reference to the clusters dataset
         auto clusters = Dataset<Clusters>(parent);
 
-        // All masked by default
-        //std::fill(scalarData.begin(), scalarData.end(), -1.0f);
-
-        // Get clusters input points dataset
-        auto points = parent->getParent()->getSourceDataset<Points>();
         auto embedding = parent->getParent();
 
-        // Global indices into data
-        //std::vector<std::uint32_t> globalIndices;
+        // Only linked data which has the same original full data applies, because we don't want to add data here that belongs to a different dataset
+        std::vector<const LinkedData*> applicableLinkedData;
 
-        // Get global indices from points
-        //points->getGlobalIndices(globalIndices);
+        const auto fullDataset = embedding->getSourceDataset<Points>()->getFullDataset<Points>();
+
+        for (const LinkedData& linkedData : embedding->getLinkedData())
+            if (linkedData.getTargetDataset()->getFullDataset<Points>() == fullDataset)
+                applicableLinkedData.push_back(&linkedData);
+
+        SelectionMap::Indices linkedIndices;
 
-        auto clusterIndex = 0;
+        auto clusterIndex = 0.f;
 
         // Iterate over all clusters
         for (auto& cluster : clusters->getClusters()) {
 
-            // If the data has any linked data
-            for (LinkedData& linkedData : embedding->getLinkedData())
-            {
-                // Check if the linked data has the same original full data, because we don't want to
-                // add data here that belongs to a different dataset
-                if (linkedData.getTargetDataset()->getFullDataset<Points>() == embedding->getSourceDataset<Points>()->getFullDataset<Points>())
-                {
-                    for (const auto globalPointIndex : cluster.getIndices())
-                    {
-                        SelectionMap::Indices linkedIndices;
-                            
-                        linkedData.getMapping().populateMappingIndices(globalPointIndex, linkedIndices);
+            // Fill in the data for all the linked data indices based on the location of the original id
+            for (const auto linkedData : applicableLinkedData) {
+                linkedData->getMapping().mapIndices(cluster.getIndices(), linkedIndices);
 
-                        // Fill in the data for all the linked data indices based on the location of the original id
-                        for (unsigned int linkedIndex : linkedIndices)
-                            scalarData[linkedIndex] = clusterIndex;
-                    }
-                }
+                for (unsigned int linkedIndex : linkedIndices)
+                    scalars[linkedIndex] = clusterIndex;
             }
 
             // Iterate over all indices in the cluster and assign cluster index to scalar data
             for (const auto globalPointIndex : cluster.getIndices())
-                scalarData[globalPointIndex] = clusterIndex;
+                scalars[globalPointIndex] = clusterIndex;
 
             clusterIndex++;
         }
     }
 }
 
+void Images::updateScalarDataCacheAccounting()
+{
+    MemoryAccounting::setAllocation(MemoryAccounting::Category::Cache, getId(), _scalarDataCache.getNumberOfBytes());
+}
+
 void Images::computeMaskData()
 {
-    //Timer timer(__FUNCTION__);
+    MV_TRACE_SCOPE("data", "Images::computeMaskData");
 
     // Only compute if necessary
     if (_maskDataGiven)
@@ -689,14 +807,14 @@ void Images::computeMaskData()
         // Obtain reference to the points dataset
         auto points = Dataset<Points>(inputDataset);
 
-        // Global indices into data
-        std::vector<std::uint32_t> globalIndices;
+        // Cached global index map of the points
+        const auto globalIndexMap = points->getGlobalIndexMap();
 
-        // Get global indices from points
-        points->getGlobalIndices(globalIndices);
+        // Global indices into data
+        const auto& globalIndices = globalIndexMap->getLocalToGlobal();
 
         // Loop over all point indices and unmask them
-        points->visitData([this, &points, &globalIndices](auto pointData) {
+        std::as_const(*points).visitData([this, &points, &globalIndices](auto pointData) {
             for (std::int32_t localPointIndex = 0; localPointIndex < globalIndices.size(); localPointIndex++) {
                 const auto targetPixelIndex = globalIndices[localPointIndex];
 
@@ -753,16 +871,13 @@ void Images::computeMaskData()
                     // add data here that belongs to a different dataset
                     if (linkedData.getTargetDataset()->getFullDataset<Points>() == embedding->getSourceDataset<Points>()->getFullDataset<Points>())
                     {
-                        for (const auto globalPointIndex : cluster.getIndices())
-                        {
-                            SelectionMap::Indices linkedIndices;
+                        SelectionMap::Indices linkedIndices;
 
-                            linkedData.getMapping().populateMappingIndices(globalPointIndex, linkedIndices);
+                        linkedData.getMapping().mapIndices(cluster.getIndices(), linkedIndices);
 
-                            // Fill in the data for all the linked data indices based on the location of the original id
-                            for (unsigned int linkedIndex : linkedIndices)
-                                _maskData[linkedIndex] = 255;
-                        }
+                        // Fill in the data for all the linked data indices based on the location of the original id
+                        for (unsigned int linkedIndex : linkedIndices)
+                            _maskData[linkedIndex] = 255;
                     }
                 }
             }
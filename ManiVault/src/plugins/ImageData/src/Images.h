@@ -6,6 +6,7 @@
 
 #include "Common.h"
 #include "Image.h"
+#include "ImageChannelCache.h"
 #include "ImageData.h"
 
 #include <Set.h>
@@ -41,6 +42,9 @@ public: // Construction
      */
     Images(QString dataName, bool mayUnderive = false, const QString& guid = "");
 
+    /** Withdraws the scalar data cache from the memory accounting */
+    ~Images() override;
+
     /** Initializes the dataset */
     void init() override;
 
@@ -152,6 +156,9 @@ public: // Selection
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /** Do not hide the move overload of the base class (which forwards to the copying overload above) */
+    using DatasetImpl::setSelectionIndices;
+
     /** Determines whether items can be selected */
     bool canSelect() const override;
 
@@ -199,6 +206,40 @@ public:
      */
     void getImageScalarData(std::uint32_t imageIndex, QVector<float>& scalarData, QPair<float, float>& scalarDataRange);
 
+    /**
+     * Get the number of resolution levels available through getScalarDataForRegion()
+     * @return Number of resolution levels (level zero is the full resolution)
+     */
+    std::uint32_t getNumberOfScalarDataLevels();
+
+    /**
+     * Get the image size at resolution \p level
+     * @param level Resolution level
+     * @return Image size at the level
+     */
+    QSize getScalarDataLevelSize(std::uint32_t level);
+
+    /**
+     * Get scalar image data for \p dimensionIndex restricted to \p region at resolution \p level (only for image stacks)
+     * Scalar data is served from the channel cache, so only the visible region at the current zoom level needs to be copied
+     * @param dimensionIndex Dimension index
+     * @param level Resolution level (each level halves the image size)
+     * @param region Region in pixel coordinates of the level
+     * @param regionScalarData Scalar data of the region in row-major order (resized to the clipped region)
+     * @param scalarDataRange Scalar data range of the entire channel
+     * @return Region clipped to the level image, empty when the scalar data is not available
+     */
+    QRect getScalarDataForRegion(std::uint32_t dimensionIndex, std::uint32_t level, const QRect& region, QVector<float>& regionScalarData, QPair<float, float>& scalarDataRange);
+
+    /** Discard cached scalar channels and pixel maps (done automatically when the source data changes) */
+    void invalidateScalarDataCache();
+
+    /**
+     * Get the scalar channel cache
+     * @return Reference to the scalar channel cache
+     */
+    ImageChannelCache& getScalarDataCache();
+
     /**
      * Get mask image data (for subsets)
      * @param maskData Mask scalar data
@@ -248,6 +289,23 @@ protected:
      */
     void getScalarDataForImageStack(const std::uint32_t& dimensionIndex, QVector<float>& scalarData, QPair<float, float>& scalarDataRange);
 
+    /**
+     * Get cached image stack channel for \p dimensionIndex, computed when not cached
+     * @param dimensionIndex Dimension index
+     * @return Shared pointer to the cached channel
+     */
+    std::shared_ptr<const ImageChannelCache::Channel> getImageStackChannel(const std::uint32_t& dimensionIndex);
+
+    /**
+     * Compute image stack scalar data for \p dimensionIndex
+     * @param dimensionIndex Dimension index
+     * @param scalars Scalar data with one element per pixel
+     */
+    void computeImageStackScalarData(const std::uint32_t& dimensionIndex, std::vector<float>& scalars);
+
+    /** Report the size of the scalar data cache to the memory accounting (see mv::util::MemoryAccounting) */
+    void updateScalarDataCacheAccounting();
+
     /** Computes and caches the mask data, if mask data is not set by setMaskData, based on linked data set to parent's points */
     void computeMaskData();
 
@@ -291,4 +349,7 @@ private:
     QRect                           _visibleRectangle;      /** Rectangle which bounds the visible pixels */
     std::vector<std::uint8_t>       _maskData;              /** Mask data */
     bool                            _maskDataGiven;         /** Whether mask data was set externally */
+    ImageChannelCache               _scalarDataCache;       /** Cached scalar channels for image stacks */
+    mv::Dataset<mv::DatasetImpl>    _scalarDataSource;      /** Parent dataset, its data changes invalidate the scalar data cache */
+    mv::Dataset<mv::DatasetImpl>    _linkedDataSource;      /** Dataset whose linked data the pixel map is built from, its linked data changes invalidate the scalar data cache */
 };
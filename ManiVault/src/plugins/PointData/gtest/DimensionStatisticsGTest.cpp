@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <DimensionStatistics.h>
+
+#include <util/DerivedDataCache.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+using mv::DimensionStatistics;
+
+namespace
+{
+    // Row-major test data with a sparse (mostly zero) and an offset dimension, to exercise the numerical stability
+    std::vector<float> generateData(std::size_t numberOfPoints, std::size_t numberOfDimensions)
+    {
+        std::mt19937 generator(42);
+        std::normal_distribution<float> distribution(0.0f, 1.0f);
+
+        std::vector<float> data(numberOfPoints * numberOfDimensions);
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+            for (std::size_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++) {
+                auto& value = data[pointIndex * numberOfDimensions + dimensionIndex];
+
+                switch (dimensionIndex % 3) {
+                    case 0: value = distribution(generator); break;
+                    case 1: value = (pointIndex % 7 == 0) ? distribution(generator) : 0.0f; break;
+                    case 2: value = 1e4f + distribution(generator); break;
+                }
+            }
+        }
+
+        return data;
+    }
+
+    // Reference: the original two-pass computation of the dimensions picker
+    DimensionStatistics::Statistics computeReference(const std::vector<float>& data, std::size_t numberOfDimensions, const std::vector<std::size_t>& rows)
+    {
+        constexpr auto quiet_NaN = std::numeric_limits<double>::quiet_NaN();
+
+        const auto numberOfRows = rows.size();
+
+        DimensionStatistics::Statistics statistics(numberOfDimensions);
+
+        for (std::size_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++) {
+            double sum{};
+            std::size_t numberOfNonZeroValues{};
+
+            for (const auto row : rows) {
+                const double value = data[row * numberOfDimensions + dimensionIndex];
+
+                if (value != 0.0) {
+                    sum += value;
+                    ++numberOfNonZeroValues;
+                }
+            }
+
+            const auto mean = sum / numberOfRows;
+
+            double sumOfSquares{};
+
+            for (const auto row : rows) {
+                const auto value = data[row * numberOfDimensions + dimensionIndex] - mean;
+                sumOfSquares += value * value;
+            }
+
+            statistics[dimensionIndex] = {
+                { mean, (numberOfNonZeroValues == 0) ? quiet_NaN : (sum / numberOfNonZeroValues) },
+                { std::sqrt(sumOfSquares / (numberOfRows - 1)), (numberOfNonZeroValues == 0) ? quiet_NaN : std::sqrt(sumOfSquares / numberOfNonZeroValues) }
+            };
+        }
+
+        return statistics;
+    }
+
+    void expectNear(const DimensionStatistics::Statistics& actual, const DimensionStatistics::Statistics& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+
+        for (std::size_t dimensionIndex = 0; dimensionIndex < actual.size(); dimensionIndex++) {
+            for (std::size_t i = 0; i < 2; i++) {
+                EXPECT_NEAR(actual[dimensionIndex].mean[i], expected[dimensionIndex].mean[i], 1e-9 * (1.0 + std::abs(expected[dimensionIndex].mean[i])));
+                EXPECT_NEAR(actual[dimensionIndex].standardDeviation[i], expected[dimensionIndex].standardDeviation[i], 1e-9 * (1.0 + expected[dimensionIndex].standardDeviation[i]));
+            }
+        }
+    }
+}
+
+
+TEST(DimensionStatistics, matchesTwoPassComputation)
+{
+    // Enough rows for multiple partitions and tiles, enough dimensions for multiple dimension blocks
+    constexpr std::size_t numberOfPoints        = 3 * DimensionStatistics::minimumNumberOfRowsPerPartition + 17;
+    constexpr std::size_t numberOfDimensions    = DimensionStatistics::numberOfDimensionsPerBlock + 5;
+
+    const auto data = generateData(numberOfPoints, numberOfDimensions);
+
+    std::vector<std::size_t> rows(numberOfPoints);
+
+    for (std::size_t row = 0; row < numberOfPoints; row++)
+        rows[row] = row;
+
+    const auto statistics = DimensionStatistics::compute(data.cbegin(), numberOfDimensions, numberOfPoints, [](std::size_t row) { return row; });
+
+    expectNear(statistics, computeReference(data, numberOfDimensions, rows));
+}
+
+
+TEST(DimensionStatistics, restrictsToRows)
+{
+    constexpr std::size_t numberOfPoints        = 1000;
+    constexpr std::size_t numberOfDimensions    = 6;
+
+    const auto data = generateData(numberOfPoints, numberOfDimensions);
+
+    // E.g. the points of a subset, or the selected points
+    std::vector<std::size_t> rows;
+
+    for (std::size_t row = 3; row < numberOfPoints; row += 5)
+        rows.push_back(row);
+
+    const auto statistics = DimensionStatistics::compute(data.data(), numberOfDimensions, rows.size(), [&rows](std::size_t row) { return rows[row]; });
+
+    expectNear(statistics, computeReference(data, numberOfDimensions, rows));
+}
+
+
+TEST(DimensionStatistics, handlesFewRows)
+{
+    const std::vector<float> data{ 0.0f, 2.0f };
+
+    const auto noRows = DimensionStatistics::compute(data.data(), 2, 0, [](std::size_t row) { return row; });
+
+    ASSERT_EQ(noRows.size(), 2u);
+    EXPECT_TRUE(std::isnan(noRows[0].mean[0]));
+
+    const auto oneRow = DimensionStatistics::compute(data.data(), 2, 1, [](std::size_t row) { return row; });
+
+    ASSERT_EQ(oneRow.size(), 2u);
+    EXPECT_EQ(oneRow[1].mean[0], 2.0);
+    EXPECT_EQ(oneRow[1].mean[1], 2.0);
+    EXPECT_TRUE(std::isnan(oneRow[1].standardDeviation[0]));
+}
+
+
+TEST(DimensionStatistics, cachesBySignature)
+{
+    auto statistics = std::make_shared<const DimensionStatistics::Statistics>(1);
+
+    DimensionStatistics::cacheStatistics("Dataset", { 1, 2 }, statistics);
+
+    EXPECT_EQ(DimensionStatistics::getCachedStatistics("Dataset", { 1, 2 }), statistics);
+    EXPECT_EQ(DimensionStatistics::getCachedStatistics("Dataset", { 1, 3 }), nullptr);
+    EXPECT_EQ(DimensionStatistics::getCachedStatistics("Other dataset", { 1, 2 }), nullptr);
+}
+
+TEST(DimensionStatistics, storesDerivedData)
+{
+    using mv::util::DerivedDataCache;
+
+    const QTemporaryDir cacheDirectory;
+
+    ASSERT_TRUE(cacheDirectory.isValid());
+
+    DerivedDataCache::setDirectory(cacheDirectory.path());
+
+    const auto data         = generateData(1000, 6);
+    const auto contentHash  = DerivedDataCache::computeContentHash(data.data(), data.size() * sizeof(float));
+
+    // The content hash changes with the data
+    auto changedData = data;
+
+    changedData[17] += 1.0f;
+
+    EXPECT_EQ(contentHash, DerivedDataCache::computeContentHash(data.data(), data.size() * sizeof(float)));
+    EXPECT_NE(contentHash, DerivedDataCache::computeContentHash(changedData.data(), changedData.size() * sizeof(float)));
+
+    const auto key          = DerivedDataCache::createKey("DimensionStatistics", { { "SelectedPointsOnly", false } }, contentHash);
+    const auto otherKey     = DerivedDataCache::createKey("DimensionStatistics", { { "SelectedPointsOnly", true } }, contentHash);
+    const auto statistics   = DimensionStatistics::compute(data.data(), 6, 1000, [](std::size_t row) { return row; });
+
+    EXPECT_NE(key, otherKey);
+    EXPECT_EQ(DimensionStatistics::loadDerivedData(key, 6), nullptr);
+
+    DimensionStatistics::storeDerivedData(key, statistics);
+
+    const auto loadedStatistics = DimensionStatistics::loadDerivedData(key, 6);
+
+    ASSERT_NE(loadedStatistics, nullptr);
+    ASSERT_EQ(loadedStatistics->size(), statistics.size());
+
+    for (std::size_t dimension = 0; dimension < statistics.size(); ++dimension) {
+        EXPECT_EQ((*loadedStatistics)[dimension].mean[0], statistics[dimension].mean[0]);
+        EXPECT_EQ((*loadedStatistics)[dimension].standardDeviation[1], statistics[dimension].standardDeviation[1]);
+    }
+
+    EXPECT_EQ(DimensionStatistics::loadDerivedData(otherKey, 6), nullptr);
+
+    // Statistics of another number of dimensions are rejected (and removed from the cache)
+    EXPECT_EQ(DimensionStatistics::loadDerivedData(key, 5), nullptr);
+    EXPECT_EQ(DimensionStatistics::loadDerivedData(key, 6), nullptr);
+
+    DimensionStatistics::storeDerivedData(key, statistics);
+
+    DerivedDataCache::clear();
+
+    EXPECT_EQ(DimensionStatistics::loadDerivedData(key, 6), nullptr);
+
+    DerivedDataCache::setDirectory({});
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <PointDataBuffer.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+
+TEST(PointDataBuffer, ownsMovedVector)
+{
+    std::vector<float> values{ 1.f, 2.f, 3.f };
+
+    const auto data = values.data();
+
+    const PointDataBuffer<float> buffer(std::move(values));
+
+    EXPECT_FALSE(buffer.isAdopted());
+    EXPECT_EQ(buffer.size(), 3U);
+    EXPECT_EQ(buffer.data(), data);
+}
+
+
+TEST(PointDataBuffer, modifiesWritableAdoptedMemoryInPlace)
+{
+    auto released = false;
+
+    auto values = new float[3] { 1.f, 2.f, 3.f };
+
+    {
+        PointDataBuffer<float> buffer(values, 3, std::shared_ptr<float>(values, [&released](float* data) { delete[] data; released = true; }), true);
+
+        EXPECT_TRUE(buffer.isAdopted());
+        EXPECT_EQ(buffer.data(), values);
+
+        buffer[1] = 20.f;
+
+        EXPECT_EQ(values[1], 20.f);
+        EXPECT_FALSE(released);
+    }
+
+    EXPECT_TRUE(released);
+}
+
+
+TEST(PointDataBuffer, copiesReadOnlyAdoptedMemoryOnMutableAccess)
+{
+    const std::vector<float> values{ 1.f, 2.f, 3.f };
+
+    PointDataBuffer<float> buffer(values.data(), values.size(), std::shared_ptr<const void>(values.data(), [](const void*) {}), false);
+
+    const auto& constBuffer = buffer;
+
+    EXPECT_EQ(constBuffer.data(), values.data());
+
+    *buffer.begin() = 10.f;
+
+    EXPECT_FALSE(buffer.isAdopted());
+    EXPECT_NE(constBuffer.data(), values.data());
+    EXPECT_EQ(buffer[0], 10.f);
+    EXPECT_EQ(values[0], 1.f);
+}
+
+
+TEST(PointDataBuffer, releasesAdoptedMemoryWhenResized)
+{
+    auto released = false;
+
+    auto values = new float[2] { 1.f, 2.f };
+
+    PointDataBuffer<float> buffer(values, 2, std::shared_ptr<float>(values, [&released](float* data) { delete[] data; released = true; }), true);
+
+    buffer.resize(4);
+
+    EXPECT_TRUE(released);
+    EXPECT_FALSE(buffer.isAdopted());
+    EXPECT_EQ(buffer.size(), 4U);
+    EXPECT_EQ(buffer[1], 2.f);
+}
+
+
+TEST(PointDataBuffer, appendsToReservedStorage)
+{
+    const std::vector<float> values{ 1.f, 2.f, 3.f };
+
+    PointDataBuffer<float> buffer(values.data(), 1, std::shared_ptr<const void>(values.data(), [](const void*) {}), false);
+
+    buffer.reserve(5);
+
+    EXPECT_FALSE(buffer.isAdopted());
+
+    const auto data = buffer.data();
+
+    buffer.append(values.data() + 1, 2);
+    buffer.append(values.data(), 2);
+
+    EXPECT_EQ(buffer.data(), data);
+    EXPECT_EQ(std::vector<float>(buffer.begin(), buffer.end()), std::vector<float>({ 1.f, 2.f, 3.f, 1.f, 2.f }));
+}
+
+
+TEST(PointDataBuffer, growsGeometricallyWhenAppending)
+{
+    const std::vector<float> chunk{ 1.f, 2.f };
+
+    PointDataBuffer<float> buffer;
+
+    buffer.reserve(4);
+
+    std::size_t numberOfReallocations = 0;
+
+    for (int chunkIndex = 0; chunkIndex < 1000; chunkIndex++) {
+        const auto capacity = buffer.capacity();
+
+        buffer.reserveForAppend(buffer.size() + chunk.size());
+
+        if (buffer.capacity() != capacity)
+            numberOfReallocations++;
+
+        buffer.append(chunk.data(), chunk.size());
+    }
+
+    EXPECT_EQ(buffer.size(), 2000U);
+    EXPECT_EQ(buffer[1999], 2.f);
+
+    // Growing from 4 to 2000 elements by doubling takes 9 reallocations (instead of one per append)
+    EXPECT_LE(numberOfReallocations, 9U);
+}
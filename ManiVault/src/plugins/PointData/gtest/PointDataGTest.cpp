@@ -8,14 +8,235 @@
 // GoogleTest header file:
 #include <gtest/gtest.h>
 
+#include <QTemporaryDir>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+    /** Produces point data without a running core (point data only needs its factory for bookkeeping) */
+    class TestPointDataFactory : public mv::plugin::RawDataFactory
+    {
+    public:
+        mv::plugin::RawData* produce() override
+        {
+            return new PointData(this);
+        }
+    };
+
+    std::unique_ptr<PointData> createPointData()
+    {
+        static TestPointDataFactory pointDataFactory;
+
+        return std::unique_ptr<PointData>(static_cast<PointData*>(pointDataFactory.produce()));
+    }
+
+    /** Sum of the elements in [\p begin, \p end) (the visitors are instantiated for every element type) */
+    template <typename Iterator>
+    float sum(Iterator begin, Iterator end)
+    {
+        return std::accumulate(begin, end, 0.f, [](const float partialSum, const auto value) -> float {
+            return partialSum + static_cast<float>(value);
+        });
+    }
+
+    constexpr std::size_t numberOfQuantizedPoints       = 64;
+    constexpr std::size_t numberOfQuantizedDimensions   = 2;
+
+    /** Values in [0, 1] which can be quantized within the default maximum error */
+    std::vector<float> createQuantizableValues()
+    {
+        std::vector<float> values(numberOfQuantizedPoints * numberOfQuantizedDimensions);
+
+        for (std::size_t index = 0; index < values.size(); index++)
+            values[index] = static_cast<float>(index % 17) / 16.f;
+
+        return values;
+    }
+
+    std::unique_ptr<PointData> createQuantizedPointData()
+    {
+        auto pointData = createPointData();
+
+        pointData->setData(createQuantizableValues(), numberOfQuantizedDimensions);
+        pointData->quantize();
+
+        return pointData;
+    }
+
+    /** Spill \p pointData when the memory manager would consider it a candidate (as when the memory budget is exceeded) */
+    bool sweep(PointData& pointData, const QTemporaryDir& spillDirectory)
+    {
+        if (pointData.isPinned() || pointData.getNumberOfResidentBytes() == 0)
+            return false;
+
+        return pointData.spill(spillDirectory.filePath("PointData.spill"));
+    }
+}
+
 
 GTEST_TEST(PointData, hasZeroPointsByDefault)
 {
-    ASSERT_EQ(PointData{}.getNumPoints(), 0);
+    ASSERT_EQ(createPointData()->getNumPoints(), 0);
 }
 
 
 GTEST_TEST(PointData, hasOneDimensionByDefault)
 {
-    ASSERT_EQ(PointData{}.getNumDimensions(), 1);
+    ASSERT_EQ(createPointData()->getNumDimensions(), 1);
+}
+
+
+GTEST_TEST(PointData, isNotSpilledWhileDataPointersAreHeld)
+{
+    QTemporaryDir spillDirectory;
+
+    ASSERT_TRUE(spillDirectory.isValid());
+
+    auto pointData = createPointData();
+
+    pointData->setData(std::vector<float>{ 0.f, 1.f, 2.f, 3.f, 4.f, 5.f }, 2);
+
+    const auto data = static_cast<const float*>(pointData->getDataConstVoidPtr());
+
+    EXPECT_FALSE(sweep(*pointData, spillDirectory));
+    EXPECT_FALSE(pointData->spill(spillDirectory.filePath("PointData.spill")));
+    EXPECT_FALSE(pointData->isSpilled());
+    EXPECT_EQ(data[5], 5.f);
+
+    // Replacing the data invalidates the pointers, so the data may be spilled again
+    pointData->setData(std::vector<float>{ 6.f, 7.f }, 2);
+
+    EXPECT_TRUE(sweep(*pointData, spillDirectory));
+    EXPECT_TRUE(pointData->isSpilled());
+    EXPECT_EQ(pointData->getValueAt(1), 7.f);
+    EXPECT_FALSE(pointData->isSpilled());
+}
+
+
+GTEST_TEST(PointData, isNotSpilledDuringVisits)
+{
+    QTemporaryDir spillDirectory;
+
+    ASSERT_TRUE(spillDirectory.isValid());
+
+    auto pointData = createPointData();
+
+    pointData->setData(std::vector<float>{ 0.f, 1.f, 2.f, 3.f, 4.f, 5.f }, 2);
+
+    pointData->constVisitFromBeginToEnd([&pointData, &spillDirectory](const auto begin, const auto end) -> void {
+        EXPECT_FALSE(sweep(*pointData, spillDirectory));
+        EXPECT_EQ(sum(begin, end), 15.f);
+    });
+
+    EXPECT_FALSE(pointData->isPinned());
+    EXPECT_TRUE(sweep(*pointData, spillDirectory));
+
+    std::vector<float> values(3);
+
+    pointData->populateFullDataForDimensions(values, std::vector<int>{ 1 });
+
+    EXPECT_EQ(values, (std::vector<float>{ 1.f, 3.f, 5.f }));
+    EXPECT_FALSE(pointData->isSpilled());
+}
+
+
+GTEST_TEST(PointData, reportsQuantizedDataAsFloatValues)
+{
+    const auto values       = createQuantizableValues();
+    const auto pointData    = createQuantizedPointData();
+
+    ASSERT_TRUE(pointData->isQuantized());
+
+    // The codes are only handed out explicitly
+    EXPECT_EQ(pointData->getElementType(), PointData::ElementTypeSpecifier::float32);
+    EXPECT_NE(pointData->getStorageElementType(), PointData::ElementTypeSpecifier::float32);
+    EXPECT_THROW(pointData->getDataConstVoidPtr(), std::runtime_error);
+    EXPECT_NE(pointData->getStorageConstVoidPtr(), nullptr);
+
+    // Read-only accessors reconstruct the values and keep the data quantized
+    const auto& constPointData = std::as_const(*pointData);
+
+    EXPECT_NEAR(constPointData.getValueAt(5), values[5], PointData::defaultMaximumQuantizationError);
+
+    std::vector<float> column(numberOfQuantizedPoints);
+
+    constPointData.populateFullDataForDimensions(column, std::vector<int>{ 1 });
+
+    for (std::size_t pointIndex = 0; pointIndex < numberOfQuantizedPoints; pointIndex++)
+        EXPECT_NEAR(column[pointIndex], values[pointIndex * numberOfQuantizedDimensions + 1], PointData::defaultMaximumQuantizationError);
+
+    const auto valuesSum = constPointData.constVisitFromBeginToEnd<float>([](const auto begin, const auto end) -> float {
+        return sum(begin, end);
+    });
+
+    EXPECT_NEAR(valuesSum, std::accumulate(values.begin(), values.end(), 0.f), values.size() * PointData::defaultMaximumQuantizationError);
+
+    // Setting the (float32) element type keeps the values
+    pointData->setElementType(PointData::ElementTypeSpecifier::float32);
+
+    EXPECT_TRUE(pointData->isQuantized());
+    EXPECT_EQ(pointData->getNumPoints(), numberOfQuantizedPoints);
+}
+
+
+GTEST_TEST(PointData, restoresFloatStorageOnMutableAccess)
+{
+    const auto values = createQuantizableValues();
+
+    const std::vector<std::function<void(PointData&)>> mutableAccesses{
+        [](PointData& pointData) { pointData.getDataVoidPtr(); },
+        [](PointData& pointData) { pointData.setValueAt(0, 0.f); },
+        [](PointData& pointData) { pointData.visitFromBeginToEnd([](auto, auto) {}); }
+    };
+
+    for (const auto& mutableAccess : mutableAccesses) {
+        auto pointData = createQuantizedPointData();
+
+        ASSERT_TRUE(pointData->isQuantized());
+
+        mutableAccess(*pointData);
+
+        EXPECT_FALSE(pointData->isQuantized());
+        EXPECT_EQ(pointData->getStorageElementType(), PointData::ElementTypeSpecifier::float32);
+
+        const auto data = static_cast<const float*>(pointData->getDataConstVoidPtr());
+
+        for (std::size_t index = 1; index < values.size(); index++)
+            EXPECT_NEAR(data[index], values[index], PointData::defaultMaximumQuantizationError);
+    }
+}
+
+
+GTEST_TEST(PointData, commitsAppendedPointsBeyondTheReservation)
+{
+    auto pointData = createPointData();
+
+    pointData->reservePoints<float>(2, 2);
+
+    constexpr std::size_t numberOfChunks = 100;
+
+    for (std::size_t chunkIndex = 0; chunkIndex < numberOfChunks; chunkIndex++) {
+        const auto value = static_cast<float>(chunkIndex);
+
+        pointData->appendPoints(std::vector<float>{ value, -value, value + .5f, -value - .5f });
+
+        EXPECT_TRUE(pointData->commitAppendedPoints());
+    }
+
+    EXPECT_FALSE(pointData->commitAppendedPoints());
+
+    ASSERT_EQ(pointData->getNumPoints(), 2 * numberOfChunks);
+
+    for (std::size_t chunkIndex = 0; chunkIndex < numberOfChunks; chunkIndex++) {
+        EXPECT_EQ(pointData->getValueAt(4 * chunkIndex), static_cast<float>(chunkIndex));
+        EXPECT_EQ(pointData->getValueAt(4 * chunkIndex + 3), -static_cast<float>(chunkIndex) - .5f);
+    }
 }
@@ -139,3 +139,34 @@ TEST(PointDataIterator, satisfiesRandomAccessIteratorRequirements)
     }
 }
 
+
+
+TEST(PointDataIterator, supportsRelocatedPointIndices)
+{
+    // Rows 3 and 1 of a two-dimensional data set, gathered into a contiguous buffer
+    const std::vector<float> gatheredData{ 3.0f, 3.5f, 1.0f, 1.5f };
+    const std::vector<unsigned> indices{ 3U, 1U };
+    constexpr auto numberOfDimensions = 2U;
+
+    const auto indexFunction = [&indices](const unsigned index)
+    {
+        return mv::RelocatedPointIndex{ index, indices[index] };
+    };
+
+    const auto range = mv::makePointDataRangeOfFullSet(gatheredData.cbegin(), gatheredData.cend(), numberOfDimensions, indexFunction);
+
+    ASSERT_EQ(range.size(), indices.size());
+
+    std::size_t rowIndex = 0;
+
+    for (const auto pointView : range)
+    {
+        EXPECT_EQ(pointView.index(), indices[rowIndex]);
+        EXPECT_EQ(pointView[0], static_cast<float>(indices[rowIndex]));
+        EXPECT_EQ(pointView[1], static_cast<float>(indices[rowIndex]) + 0.5f);
+
+        rowIndex++;
+    }
+
+    EXPECT_EQ(index(range.begin() + 1), indices[1]);
+}
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The files to be tested:
+#include <DequantizingIterator.h>
+#include <PointDataQuantization.h>
+#include <PointDataRange.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t numberOfPoints        = 64;
+    constexpr std::size_t numberOfDimensions    = 3;
+
+    // Row-major test data: an increasing, a decreasing and a constant dimension
+    std::vector<float> generateData()
+    {
+        std::vector<float> data(numberOfPoints * numberOfDimensions);
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+            data[pointIndex * numberOfDimensions + 0] = 0.25f * pointIndex;
+            data[pointIndex * numberOfDimensions + 1] = 100.0f - 1.5f * pointIndex;
+            data[pointIndex * numberOfDimensions + 2] = 7.0f;
+        }
+
+        return data;
+    }
+
+    template <typename CodeType>
+    PointDataQuantization createQuantization(const std::vector<float>& data)
+    {
+        std::vector<float> minima(numberOfDimensions, data[0]), maxima(numberOfDimensions, data[0]);
+
+        for (std::size_t elementIndex = 0; elementIndex < data.size(); elementIndex++) {
+            minima[elementIndex % numberOfDimensions] = std::min(minima[elementIndex % numberOfDimensions], data[elementIndex]);
+            maxima[elementIndex % numberOfDimensions] = std::max(maxima[elementIndex % numberOfDimensions], data[elementIndex]);
+        }
+
+        return PointDataQuantization::fromRanges<CodeType>(minima, maxima);
+    }
+}
+
+
+TEST(PointDataQuantization, isDisabledByDefault)
+{
+    EXPECT_FALSE(PointDataQuantization().isEnabled());
+}
+
+
+TEST(PointDataQuantization, reconstructsWithinErrorBound)
+{
+    const auto data = generateData();
+
+    const auto quantization8    = createQuantization<std::int8_t>(data);
+    const auto quantization16   = createQuantization<std::uint16_t>(data);
+
+    std::vector<std::int8_t> codes8(data.size());
+    std::vector<std::uint16_t> codes16(data.size());
+    std::vector<float> values8(data.size()), values16(data.size());
+
+    quantization8.quantize(data.data(), codes8.data(), numberOfPoints);
+    quantization8.dequantize(codes8.data(), values8.data(), numberOfPoints);
+
+    quantization16.quantize(data.data(), codes16.data(), numberOfPoints);
+    quantization16.dequantize(codes16.data(), values16.data(), numberOfPoints);
+
+    EXPECT_LT(quantization16.getMaximumError(), quantization8.getMaximumError());
+
+    for (std::size_t elementIndex = 0; elementIndex < data.size(); elementIndex++) {
+        EXPECT_NEAR(values8[elementIndex], data[elementIndex], quantization8.getMaximumError() * 1.01f);
+        EXPECT_NEAR(values16[elementIndex], data[elementIndex], quantization16.getMaximumError() * 1.01f + 1e-5f);
+    }
+
+    // Constant dimensions are reconstructed exactly
+    EXPECT_EQ(values8[2], 7.0f);
+    EXPECT_EQ(values16[2], 7.0f);
+}
+
+
+TEST(PointDataQuantization, dequantizesSelectedDimensionsOfSelectedPoints)
+{
+    const auto data         = generateData();
+    const auto quantization = createQuantization<std::uint16_t>(data);
+
+    std::vector<std::uint16_t> codes(data.size());
+
+    quantization.quantize(data.data(), codes.data(), numberOfPoints);
+
+    const std::vector<int> dimensionIndices{ 1, 0 };
+    const std::vector<unsigned> indices{ 5, 0, 63 };
+
+    std::vector<float> result(indices.size() * dimensionIndices.size());
+
+    quantization.dequantizeDimensions(codes.data(), dimensionIndices, indices.size(), [&indices](std::size_t pointIndex) { return indices[pointIndex]; }, result);
+
+    for (std::size_t pointIndex = 0; pointIndex < indices.size(); pointIndex++)
+        for (std::size_t index = 0; index < dimensionIndices.size(); index++)
+            EXPECT_NEAR(result[pointIndex * dimensionIndices.size() + index], data[indices[pointIndex] * numberOfDimensions + dimensionIndices[index]], quantization.getMaximumError() * 1.01f + 1e-5f);
+}
+
+
+TEST(DequantizingIterator, visitsReconstructedValuesOfSubset)
+{
+    const auto data         = generateData();
+    const auto quantization = createQuantization<std::int8_t>(data);
+
+    std::vector<std::int8_t> codes(data.size());
+
+    quantization.quantize(data.data(), codes.data(), numberOfPoints);
+
+    const auto begin = mv::DequantizingIterator<std::int8_t>(codes.data(), 0, quantization);
+    const auto end   = mv::DequantizingIterator<std::int8_t>(codes.data(), static_cast<std::ptrdiff_t>(codes.size()), quantization);
+
+    EXPECT_EQ(end - begin, static_cast<std::ptrdiff_t>(data.size()));
+
+    const std::vector<unsigned> indices{ 3, 1, 60 };
+
+    const auto range = mv::makePointDataRangeOfSubset(begin, indices, numberOfDimensions, [](const auto indexIterator) { return *indexIterator; });
+
+    std::size_t pointIndex = 0;
+
+    for (const auto pointView : range) {
+        ASSERT_EQ(pointView.size(), numberOfDimensions);
+        EXPECT_EQ(pointView.index(), indices[pointIndex]);
+
+        for (std::size_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++)
+            EXPECT_NEAR(pointView[dimensionIndex], data[indices[pointIndex] * numberOfDimensions + dimensionIndex], quantization.getMaximumError() * 1.01f);
+
+        pointIndex++;
+    }
+
+    EXPECT_EQ(pointIndex, indices.size());
+}
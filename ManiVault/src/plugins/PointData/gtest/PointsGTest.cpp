@@ -81,8 +81,8 @@ GTEST_TEST(Points, visitDataAllowsAccessToAnyRandomSubset)
 
             // Create a (pseudo) random subset, having half the number of points a s the full set:
             auto& subsetPoints = dynamic_cast<Points&>(core.requestData(fullPoints.createSubset()));
-            subsetPoints.indices =
-                generateRandomData<numberOfDataElements / 2, unsigned>(0, numberOfPoints - 1);
+            subsetPoints.setIndices(
+                generateRandomData<numberOfDataElements / 2, unsigned>(0, numberOfPoints - 1));
 
             // Create an output buffer for the same number of data elements as the full input set. 
             std::vector<double> outputData(inputData.size());
@@ -105,8 +105,8 @@ GTEST_TEST(Points, visitDataAllowsAccessToAnyRandomSubset)
                 }
             });
 
-            const auto beginOfIndices = begin(subsetPoints.indices);
-            const auto endOfIndices = end(subsetPoints.indices);
+            const auto beginOfIndices = begin(subsetPoints.getIndices());
+            const auto endOfIndices = end(subsetPoints.getIndices());
 
             // Assert that for each point in the subset, its values are copied
             // to the corresponding location in the output, while each other
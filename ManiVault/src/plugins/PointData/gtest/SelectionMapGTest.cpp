@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <LinkedData.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using mv::SelectionMap;
+
+namespace
+{
+    // Reference: map point by point, as the selection resolving used to do
+    SelectionMap::Indices mapReference(const SelectionMap& selectionMap, const SelectionMap::Indices& pointIndices)
+    {
+        SelectionMap::Indices mappedIndices, pointMappedIndices;
+
+        for (const auto pointIndex : pointIndices) {
+            if (!selectionMap.hasMappingForPointIndex(pointIndex))
+                continue;
+
+            selectionMap.populateMappingIndices(pointIndex, pointMappedIndices);
+
+            mappedIndices.insert(mappedIndices.end(), pointMappedIndices.begin(), pointMappedIndices.end());
+        }
+
+        std::sort(mappedIndices.begin(), mappedIndices.end());
+
+        mappedIndices.erase(std::unique(mappedIndices.begin(), mappedIndices.end()), mappedIndices.end());
+
+        return mappedIndices;
+    }
+
+    SelectionMap::Indices iota(std::uint32_t count, std::uint32_t first = 0)
+    {
+        SelectionMap::Indices indices(count);
+
+        std::iota(indices.begin(), indices.end(), first);
+
+        return indices;
+    }
+}
+
+TEST(SelectionMap, ImagePyramidDownsample)
+{
+    const SelectionMap selectionMap(QSize(640, 480), QSize(160, 120));
+
+    SelectionMap::Indices mappedIndices;
+
+    selectionMap.mapIndices(std::vector<std::uint32_t>{ 0, 1, 2, 3, 4, 640 * 4 + 4 }, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, (SelectionMap::Indices{ 0, 1, 161 }));
+
+    const auto pointIndices = iota(640 * 480);
+
+    selectionMap.mapIndices(pointIndices, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, iota(160 * 120));
+    EXPECT_EQ(mappedIndices, mapReference(selectionMap, pointIndices));
+}
+
+TEST(SelectionMap, ImagePyramidUpsample)
+{
+    const SelectionMap selectionMap(QSize(5, 3), QSize(10, 6));
+
+    SelectionMap::Indices mappedIndices;
+
+    selectionMap.mapIndices(std::vector<std::uint32_t>{ 6 }, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, (SelectionMap::Indices{ 22, 23, 32, 33 }));
+
+    const SelectionMap::Indices pointIndices{ 14, 0, 7, 7, 3, 100 };
+
+    selectionMap.mapIndices(pointIndices, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, mapReference(selectionMap, pointIndices));
+    EXPECT_TRUE(std::is_sorted(mappedIndices.begin(), mappedIndices.end()));
+}
+
+TEST(SelectionMap, ImagePyramidSameResolution)
+{
+    const SelectionMap selectionMap(QSize(4, 4), QSize(4, 4));
+
+    SelectionMap::Indices mappedIndices;
+
+    selectionMap.mapIndices(std::vector<std::uint32_t>{ 5, 1, 15, 16 }, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, (SelectionMap::Indices{ 1, 5, 15 }));
+}
+
+TEST(SelectionMap, Identity)
+{
+    const SelectionMap selectionMap(1000);
+
+    EXPECT_EQ(selectionMap.getType(), SelectionMap::Type::Identity);
+    EXPECT_TRUE(selectionMap.hasMappingForPointIndex(999));
+    EXPECT_FALSE(selectionMap.hasMappingForPointIndex(1000));
+
+    SelectionMap::Indices mappedIndices;
+
+    selectionMap.mapIndices(std::vector<std::uint32_t>{ 3, 999, 1000, 1 }, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, (SelectionMap::Indices{ 1, 3, 999 }));
+}
+
+TEST(SelectionMap, Offset)
+{
+    const SelectionMap selectionMap(300000, 100, 5000);
+
+    EXPECT_EQ(selectionMap.getType(), SelectionMap::Type::Offset);
+    EXPECT_FALSE(selectionMap.hasMappingForPointIndex(99));
+
+    // Large enough to be mapped in parallel
+    const auto pointIndices = iota(400000);
+
+    SelectionMap::Indices mappedIndices;
+
+    selectionMap.mapIndices(pointIndices, mappedIndices);
+
+    EXPECT_EQ(mappedIndices, iota(300000, 5000));
+    EXPECT_EQ(mappedIndices, mapReference(selectionMap, pointIndices));
+
+    SelectionMap::Indices targetIndices;
+
+    selectionMap.populateTargetIndices(targetIndices);
+
+    EXPECT_EQ(targetIndices, iota(300000, 5000));
+}
+
+TEST(SelectionMap, Indexed)
+{
+    SelectionMap selectionMap;
+
+    selectionMap.getMap()[0] = { 7, 3 };
+    selectionMap.getMap()[2] = { 3 };
+
+    SelectionMap::Indices mappedIndices, targetIndices;
+
+    selectionMap.mapIndices(std::vector<std::uint32_t>{ 2, 1, 0 }, mappedIndices);
+    selectionMap.populateTargetIndices(targetIndices);
+
+    EXPECT_EQ(mappedIndices, (SelectionMap::Indices{ 3, 7 }));
+    EXPECT_EQ(targetIndices, (SelectionMap::Indices{ 3, 7 }));
+}
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "PointDataQuantization.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace mv
+{
+    /* Read-only random access iterator over quantized point data, which yields the reconstructed (float) values.
+    * The position of the iterator in the data determines the dimension, and thus the scale and offset.
+    */
+    template <typename CodeType>
+    class DequantizingIterator
+    {
+        // Its data members:
+        const CodeType* _codes{};
+        std::ptrdiff_t _position{};
+        std::uint32_t _numberOfDimensions{};
+        const PointDataQuantization* _quantization{};
+
+    public:
+        // Types conforming the iterator requirements of the C++ standard library:
+        using difference_type = std::ptrdiff_t;
+        using value_type = float;
+        using reference = float;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        /* Explicitly defaulted default-constructor
+        */
+        DequantizingIterator() = default;
+
+        DequantizingIterator(
+            const CodeType* const codes,
+            const std::ptrdiff_t position,
+            const PointDataQuantization& quantization)
+            :
+            _codes{ codes },
+            _position{ position },
+            _numberOfDimensions{ quantization.getNumberOfDimensions() },
+            _quantization{ &quantization }
+        {
+        }
+
+        /** Returns the reconstructed value at the current position.
+        */
+        float operator*() const
+        {
+            return _quantization->dequantize(_codes[_position], static_cast<std::uint32_t>(_position % _numberOfDimensions));
+        }
+
+        /** Returns it[n] for iterator 'it' and integer value 'n'.
+        */
+        float operator[](const difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        /** Prefix increment ('++it').
+        */
+        auto& operator++()
+        {
+            ++_position;
+            return *this;
+        }
+
+        /** Postfix increment ('it++').
+        */
+        auto operator++(int)
+        {
+            auto result = *this;
+            ++(*this);
+            return result;
+        }
+
+        /** Prefix decrement ('--it').
+        */
+        auto& operator--()
+        {
+            --_position;
+            return *this;
+        }
+
+        /** Postfix decrement ('it--').
+        */
+        auto operator--(int)
+        {
+            auto result = *this;
+            --(*this);
+            return result;
+        }
+
+        /** Does (it += n) for iterator 'it' and integer value 'n'.
+        */
+        friend auto& operator+=(DequantizingIterator& it, const difference_type n)
+        {
+            it._position += n;
+            return it;
+        }
+
+        /** Does (it -= n) for iterator 'it' and integer value 'n'.
+        */
+        friend auto& operator-=(DequantizingIterator& it, const difference_type n)
+        {
+            it._position -= n;
+            return it;
+        }
+
+        /** Returns (it + n) for iterator 'it' and integer value 'n'.
+        */
+        friend auto operator+(DequantizingIterator it, const difference_type n)
+        {
+            return it += n;
+        }
+
+        /** Returns (n + it) for iterator 'it' and integer value 'n'.
+        */
+        friend auto operator+(const difference_type n, DequantizingIterator it)
+        {
+            return it += n;
+        }
+
+        /** Returns (it - n) for iterator 'it' and integer value 'n'.
+        */
+        friend auto operator-(DequantizingIterator it, const difference_type n)
+        {
+            return it -= n;
+        }
+
+        /** Returns (it1 - it2) for iterators it1 and it2.
+        */
+        friend difference_type operator-(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return it1._position - it2._position;
+        }
+
+        /** Returns (it1 == it2) for iterators it1 and it2.
+        */
+        friend bool operator==(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return it1._position == it2._position;
+        }
+
+        /** Returns (it1 != it2) for iterators it1 and it2.
+        */
+        friend bool operator!=(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return !(it1 == it2);
+        }
+
+        /** Returns (it1 < it2) for iterators it1 and it2.
+        */
+        friend bool operator<(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return it1._position < it2._position;
+        }
+
+        /** Returns (it1 > it2) for iterators it1 and it2.
+        */
+        friend bool operator>(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return it2 < it1;
+        }
+
+        /** Returns (it1 <= it2) for iterators it1 and it2.
+        */
+        friend bool operator<=(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return !(it2 < it1);
+        }
+
+        /** Returns (it1 >= it2) for iterators it1 and it2.
+        */
+        friend bool operator>=(const DequantizingIterator& it1, const DequantizingIterator& it2)
+        {
+            return !(it1 < it2);
+        }
+    };
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "DimensionStatistics.h"
+
+#include <util/DerivedDataCache.h>
+
+#include <QMap>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
+namespace mv
+{
+
+namespace
+{
+    /** Cached statistics of a single key */
+    struct CacheEntry
+    {
+        std::vector<std::uint64_t>                              _signature;     /** Signature of the data version */
+        std::shared_ptr<const DimensionStatistics::Statistics>  _statistics;    /** Cached statistics */
+        std::uint64_t                                           _stamp;         /** Order in which the entry was cached */
+    };
+
+    std::mutex                  cacheMutex;         /** Guards the cache */
+    QMap<QString, CacheEntry>   cache;              /** Cached statistics by key */
+    std::uint64_t               cacheStamp = 0;     /** Incremented each time statistics are cached */
+}
+
+void DimensionStatistics::Partial::merge(const Partial& other)
+{
+    if (other._numberOfRows == 0)
+        return;
+
+    if (_numberOfRows == 0) {
+        *this = other;
+        return;
+    }
+
+    const auto numberOfRows         = static_cast<double>(_numberOfRows);
+    const auto otherNumberOfRows    = static_cast<double>(other._numberOfRows);
+    const auto totalNumberOfRows    = numberOfRows + otherNumberOfRows;
+
+    for (std::size_t dimension = 0; dimension < _means.size(); ++dimension)
+    {
+        const auto delta = other._means[dimension] - _means[dimension];
+
+        _means[dimension] += delta * otherNumberOfRows / totalNumberOfRows;
+        _sumsOfSquaredDeviations[dimension] += other._sumsOfSquaredDeviations[dimension] + delta * delta * numberOfRows * otherNumberOfRows / totalNumberOfRows;
+        _numbersOfNonZeroValues[dimension] += other._numbersOfNonZeroValues[dimension];
+    }
+
+    _numberOfRows += other._numberOfRows;
+}
+
+DimensionStatistics::Statistics DimensionStatistics::Partial::getStatistics() const
+{
+    constexpr static auto quiet_NaN = std::numeric_limits<double>::quiet_NaN();
+
+    const auto numberOfDimensions = _means.size();
+
+    if (_numberOfRows == 0)
+        return Statistics(numberOfDimensions, { { quiet_NaN, quiet_NaN }, { quiet_NaN, quiet_NaN } });
+
+    Statistics statistics(numberOfDimensions);
+
+    const auto numberOfRows = static_cast<double>(_numberOfRows);
+
+    for (std::size_t dimension = 0; dimension < numberOfDimensions; ++dimension)
+    {
+        const auto mean = _means[dimension];
+
+        if (_numberOfRows == 1)
+        {
+            statistics[dimension] = { { mean, mean }, { quiet_NaN, quiet_NaN } };
+            continue;
+        }
+
+        const auto numberOfNonZeroValues    = static_cast<double>(_numbersOfNonZeroValues[dimension]);
+        const auto sumOfSquaredDeviations   = _sumsOfSquaredDeviations[dimension];
+
+        statistics[dimension] = StatisticsPerDimension
+        {
+            {
+                mean,
+                (numberOfNonZeroValues == 0) ? quiet_NaN : (mean * numberOfRows / numberOfNonZeroValues)
+            },
+            {
+                std::sqrt(sumOfSquaredDeviations / (numberOfRows - 1)),
+                (numberOfNonZeroValues == 0) ? quiet_NaN : std::sqrt(sumOfSquaredDeviations / numberOfNonZeroValues)
+            }
+        };
+    }
+
+    return statistics;
+}
+
+std::shared_ptr<const DimensionStatistics::Statistics> DimensionStatistics::getCachedStatistics(const QString& key, const std::vector<std::uint64_t>& signature)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    const auto it = cache.constFind(key);
+
+    if (it == cache.constEnd() || it->_signature != signature)
+        return nullptr;
+
+    return it->_statistics;
+}
+
+void DimensionStatistics::cacheStatistics(const QString& key, const std::vector<std::uint64_t>& signature, std::shared_ptr<const Statistics> statistics)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    if (!cache.contains(key) && static_cast<std::size_t>(cache.size()) >= maximumNumberOfCachedStatistics)
+    {
+        const auto leastRecentlyCached = std::min_element(cache.begin(), cache.end(), [](const CacheEntry& lhs, const CacheEntry& rhs) -> bool {
+            return lhs._stamp < rhs._stamp;
+        });
+
+        cache.erase(leastRecentlyCached);
+    }
+
+    cache[key] = { signature, std::move(statistics), ++cacheStamp };
+}
+
+std::shared_ptr<const DimensionStatistics::Statistics> DimensionStatistics::loadDerivedData(const QString& derivedDataKey, std::size_t numberOfDimensions)
+{
+    QByteArray data;
+
+    if (!util::DerivedDataCache::load(derivedDataKey, data, numberOfDimensions * sizeof(StatisticsPerDimension)))
+        return nullptr;
+
+    auto statistics = std::make_shared<Statistics>(numberOfDimensions);
+
+    std::memcpy(statistics->data(), data.constData(), numberOfDimensions * sizeof(StatisticsPerDimension));
+
+    return statistics;
+}
+
+void DimensionStatistics::storeDerivedData(const QString& derivedDataKey, const Statistics& statistics)
+{
+    const auto data = QByteArray(reinterpret_cast<const char*>(statistics.data()), static_cast<qsizetype>(statistics.size() * sizeof(StatisticsPerDimension)));
+
+    util::DerivedDataCache::store(derivedDataKey, data);
+}
+
+std::size_t DimensionStatistics::getNumberOfPartitions(std::size_t numberOfRows)
+{
+    const auto numberOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    return std::clamp<std::size_t>(numberOfRows / minimumNumberOfRowsPerPartition, 1, numberOfThreads);
+}
+
+void DimensionStatistics::forEachPartition(std::size_t numberOfPartitions, const std::function<void(std::size_t)>& function)
+{
+    std::vector<std::size_t> partitionIndices(numberOfPartitions);
+
+    std::iota(partitionIndices.begin(), partitionIndices.end(), 0);
+
+#ifndef __APPLE__
+    std::for_each(std::execution::par, partitionIndices.begin(), partitionIndices.end(), function);
+#else
+    std::for_each(partitionIndices.begin(), partitionIndices.end(), function);
+#endif
+}
+
+}
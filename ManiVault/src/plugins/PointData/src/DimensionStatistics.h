@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "pointdata_export.h"
+
+#include "DimensionsPickerHolder.h"
+
+#include <QString>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mv
+{
+
+/**
+ * Dimension statistics class
+ *
+ * Computes the statistics of all dimensions (see StatisticsPerDimension) in a single pass over row-major point data.
+ * Rows are processed in tiles across blocks of dimensions, so that the running statistics of a block stay in cache
+ * while the values of a tile are read sequentially. Each partition of the rows is accumulated by a worker (Welford)
+ * and the partials are merged (Chan et al.) in partition order, so the result does not depend on the scheduling.
+ *
+ * Computed statistics may be cached by key (e.g. dataset ID), with a signature which identifies the version of the
+ * data they were computed from. Statistics of large datasets may also be kept in the derived data cache (see
+ * mv::util::DerivedDataCache), so that they do not have to be recomputed when the project is reopened.
+ *
+ * @author Thomas Kroes
+ */
+class POINTDATA_EXPORT DimensionStatistics
+{
+public:
+
+    using Statistics = std::vector<StatisticsPerDimension>;
+
+    static constexpr std::size_t numberOfRowsPerTile                = 64;       /** Number of rows which are processed per dimension block */
+    static constexpr std::size_t numberOfDimensionsPerBlock         = 2048;     /** Number of dimensions whose running statistics are updated together */
+    static constexpr std::size_t minimumNumberOfRowsPerPartition    = 4096;     /** Minimum number of rows per worker */
+    static constexpr std::size_t maximumNumberOfCachedStatistics    = 32;       /** Maximum number of cached statistics */
+    static constexpr std::uint64_t minimumNumberOfDerivedDataValues = 1 << 22;  /** Statistics over fewer values are not kept in the derived data cache */
+
+    /** Running statistics of all dimensions over a number of rows */
+    class Partial
+    {
+    public:
+
+        /**
+         * Construct with \p numberOfDimensions
+         * @param numberOfDimensions Number of dimensions
+         */
+        explicit Partial(std::size_t numberOfDimensions = 0) :
+            _numberOfRows(0),
+            _means(numberOfDimensions, 0.0),
+            _sumsOfSquaredDeviations(numberOfDimensions, 0.0),
+            _numbersOfNonZeroValues(numberOfDimensions, 0)
+        {
+        }
+
+        /**
+         * Add the rows in [\p firstRow, \p lastRow)
+         * @param beginOfData Iterator to the first value of the (row-major) data
+         * @param firstRow First row
+         * @param lastRow One past the last row
+         * @param rowIndexFunction Maps a row to the index of the point in the data
+         */
+        template <typename ValueIterator, typename RowIndexFunction>
+        void addRows(const ValueIterator beginOfData, const std::size_t firstRow, const std::size_t lastRow, const RowIndexFunction& rowIndexFunction)
+        {
+            const auto numberOfDimensions = _means.size();
+
+            for (auto firstTileRow = firstRow; firstTileRow < lastRow; firstTileRow += numberOfRowsPerTile)
+            {
+                const auto lastTileRow = std::min(firstTileRow + numberOfRowsPerTile, lastRow);
+
+                for (std::size_t firstDimension = 0; firstDimension < numberOfDimensions; firstDimension += numberOfDimensionsPerBlock)
+                {
+                    const auto lastDimension = std::min(firstDimension + numberOfDimensionsPerBlock, numberOfDimensions);
+
+                    auto numberOfRows = _numberOfRows;
+
+                    for (auto row = firstTileRow; row < lastTileRow; ++row)
+                    {
+                        const auto reciprocal   = 1.0 / static_cast<double>(++numberOfRows);
+                        const auto beginOfRow   = beginOfData + static_cast<std::ptrdiff_t>(rowIndexFunction(row)) * static_cast<std::ptrdiff_t>(numberOfDimensions);
+
+                        for (auto dimension = firstDimension; dimension < lastDimension; ++dimension)
+                        {
+                            const double value = beginOfRow[static_cast<std::ptrdiff_t>(dimension)];
+                            const auto delta = value - _means[dimension];
+
+                            _means[dimension] += delta * reciprocal;
+                            _sumsOfSquaredDeviations[dimension] += delta * (value - _means[dimension]);
+                            _numbersOfNonZeroValues[dimension] += (value != 0.0) ? 1 : 0;
+                        }
+                    }
+                }
+
+                _numberOfRows += lastTileRow - firstTileRow;
+            }
+        }
+
+        /**
+         * Merge with the running statistics of \p other (over different rows)
+         * @param other Running statistics to merge with
+         */
+        void merge(const Partial& other);
+
+        /**
+         * Get the statistics of the rows added so far
+         * @return Statistics per dimension
+         */
+        Statistics getStatistics() const;
+
+    private:
+        std::uint64_t               _numberOfRows;              /** Number of rows added so far */
+        std::vector<double>         _means;                     /** Running mean per dimension */
+        std::vector<double>         _sumsOfSquaredDeviations;   /** Running sum of squared deviations from the mean per dimension */
+        std::vector<std::uint64_t>  _numbersOfNonZeroValues;    /** Number of non-zero values per dimension */
+    };
+
+public:
+
+    /**
+     * Compute the statistics of \p numberOfRows rows of row-major data (in parallel)
+     * @param beginOfData Iterator to the first value of the data
+     * @param numberOfDimensions Number of dimensions
+     * @param numberOfRows Number of rows (e.g. the number of points of a subset or of the selection)
+     * @param rowIndexFunction Maps a row to the index of the point in the data
+     * @return Statistics per dimension
+     */
+    template <typename ValueIterator, typename RowIndexFunction>
+    static Statistics compute(const ValueIterator beginOfData, const std::size_t numberOfDimensions, const std::size_t numberOfRows, const RowIndexFunction rowIndexFunction)
+    {
+        const auto numberOfPartitions = getNumberOfPartitions(numberOfRows);
+
+        std::vector<Partial> partials(numberOfPartitions, Partial(numberOfDimensions));
+
+        forEachPartition(numberOfPartitions, [&](const std::size_t partitionIndex) -> void {
+            const auto firstRow = numberOfRows * partitionIndex / numberOfPartitions;
+            const auto lastRow  = numberOfRows * (partitionIndex + 1) / numberOfPartitions;
+
+            partials[partitionIndex].addRows(beginOfData, firstRow, lastRow, rowIndexFunction);
+        });
+
+        for (std::size_t partitionIndex = 1; partitionIndex < numberOfPartitions; ++partitionIndex)
+            partials.front().merge(partials[partitionIndex]);
+
+        return partials.front().getStatistics();
+    }
+
+public: // Cache
+
+    /**
+     * Get cached statistics
+     * @param key Cache key (e.g. dataset ID)
+     * @param signature Signature of the data version the statistics should have been computed from
+     * @return Shared pointer to the cached statistics (nullptr when not cached or computed from another version)
+     */
+    static std::shared_ptr<const Statistics> getCachedStatistics(const QString& key, const std::vector<std::uint64_t>& signature);
+
+    /**
+     * Cache \p statistics (evicts the least recently cached statistics when the cache is full)
+     * @param key Cache key (e.g. dataset ID)
+     * @param signature Signature of the data version the statistics were computed from
+     * @param statistics Statistics to cache
+     */
+    static void cacheStatistics(const QString& key, const std::vector<std::uint64_t>& signature, std::shared_ptr<const Statistics> statistics);
+
+public: // Derived data cache
+
+    /**
+     * Load statistics of \p numberOfDimensions dimensions from the derived data cache
+     * @param derivedDataKey Derived data cache key (see mv::util::DerivedDataCache::createKey())
+     * @param numberOfDimensions Number of dimensions the statistics are expected for
+     * @return Shared pointer to the statistics (nullptr when not in the derived data cache or of another number of dimensions)
+     */
+    static std::shared_ptr<const Statistics> loadDerivedData(const QString& derivedDataKey, std::size_t numberOfDimensions);
+
+    /**
+     * Store \p statistics in the derived data cache
+     * @param derivedDataKey Derived data cache key (see mv::util::DerivedDataCache::createKey())
+     * @param statistics Statistics to store
+     */
+    static void storeDerivedData(const QString& derivedDataKey, const Statistics& statistics);
+
+private:
+
+    /**
+     * Get the number of partitions (workers) for \p numberOfRows
+     * @param numberOfRows Number of rows
+     * @return Number of partitions (at least one)
+     */
+    static std::size_t getNumberOfPartitions(std::size_t numberOfRows);
+
+    /**
+     * Invoke \p function for each partition in parallel
+     * @param numberOfPartitions Number of partitions
+     * @param function Function which is invoked with the partition index
+     */
+    static void forEachPartition(std::size_t numberOfPartitions, const std::function<void(std::size_t)>& function);
+};
+
+}
@@ -3,28 +3,24 @@
 // Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
 
 #include "DimensionsPickerAction.h"
+#include "DimensionStatistics.h"
 
 #include "Application.h"
 
+#include <util/DerivedDataCache.h>
+
 #include <QTableView>
 #include <QHeaderView>
 #include <QTime>
 #include <QAbstractEventDispatcher>
 #include <QVBoxLayout>
 
+#include <cmath>
 #include <deque>
+#include <limits>
+#include <memory>
 #include <set>
 
-#if !defined(Q_OS_MAC)
-#ifndef Q_MOC_RUN
-#if defined(emit) // tbb defines emit which clashes with Qt's emit
-    #undef emit
-    #include <execution>
-    #define emit
-#endif
-#endif
-#endif
-
 using namespace mv;
 using namespace mv::gui;
 
@@ -382,98 +378,79 @@ void DimensionsPickerAction::computeStatistics()
         {
             QTime time = time.currentTime();
             
-            const auto& pointData = *_points;
+            const auto& points              = *_points;
+            const auto selectedPointsOnly   = _selectAction.getSelectedPointsOnlyAction().isChecked();
+
+            // The statistics are computed over all points of the dataset, or over its selected points (local indices)
+            std::vector<unsigned int> localSelectionIndices;
+
+            if (selectedPointsOnly)
+                points.getLocalSelectionIndices(localSelectionIndices);
+
+            const auto numberOfRows = selectedPointsOnly ? localSelectionIndices.size() : static_cast<std::size_t>(points.getNumPoints());
+
+            // Statistics are cached per dataset, and remain valid as long as the data and the subset (and selection) do not change
+            const auto cacheKey = selectedPointsOnly ? QString("%1/SelectedPointsOnly").arg(points.getId()) : points.getId();
+
+            std::vector<std::uint64_t> signature{
+                points.getDataVersion(),
+                points.getNumPoints(),
+                points.getNumDimensions(),
+                points.getIndicesVersion()
+            };
 
-            pointData.visitFromBeginToEnd([&statistics, &pointData](auto beginOfData, auto endOfData)
+            if (selectedPointsOnly)
+                signature.push_back(qHashBits(localSelectionIndices.data(), localSelectionIndices.size() * sizeof(unsigned int)));
+
+            auto cachedStatistics = DimensionStatistics::getCachedStatistics(cacheKey, signature);
+
+            // Statistics of large datasets are also kept in the derived data cache, keyed by the content of the points (and selection)
+            QString derivedDataKey;
+
+            if (!cachedStatistics && static_cast<std::uint64_t>(numberOfRows) * points.getNumDimensions() >= DimensionStatistics::minimumNumberOfDerivedDataValues)
             {
-                const auto numberOfDimensions = pointData.getNumDimensions();
-                const auto numberOfPoints = pointData.getNumPoints();
+                QVariantMap parameters{
+                    { "NumberOfRows", QVariant::fromValue(static_cast<qulonglong>(numberOfRows)) },
+                    { "NumberOfDimensions", points.getNumDimensions() },
+                    { "SelectedPointsOnly", selectedPointsOnly }
+                };
 
-                constexpr static auto quiet_NaN = std::numeric_limits<double>::quiet_NaN();
+                if (selectedPointsOnly)
+                    parameters["Selection"] = mv::util::DerivedDataCache::computeContentHash(localSelectionIndices.data(), localSelectionIndices.size() * sizeof(unsigned int));
 
-                if (numberOfPoints == 0)
-                {
-                    statistics.resize(numberOfDimensions, { quiet_NaN, quiet_NaN, quiet_NaN, quiet_NaN });
-                }
-                else
+                derivedDataKey      = mv::util::DerivedDataCache::createKey("DimensionStatistics", parameters, points.getContentHash());
+                cachedStatistics    = DimensionStatistics::loadDerivedData(derivedDataKey, points.getNumDimensions());
+
+                if (cachedStatistics)
+                    DimensionStatistics::cacheStatistics(cacheKey, signature, cachedStatistics);
+            }
+
+            if (!cachedStatistics)
+            {
+                cachedStatistics = std::make_shared<const DimensionStatistics::Statistics>(points.visitFromBeginToEnd<DimensionStatistics::Statistics>([&points, &localSelectionIndices, selectedPointsOnly, numberOfRows](auto beginOfData, auto endOfData)
                 {
-                    statistics.resize(numberOfDimensions);
-                    const auto* const statisticsData = statistics.data();
+                    const auto isFull   = points.isFull();
+                    const auto& indices = points.getIndices();
 
-                    if (numberOfPoints == 1)
-                    {
-#ifndef __APPLE__
-                        (void)std::for_each_n(std::execution::par_unseq, statistics.begin(), numberOfDimensions,
-#else
-                        (void)std::for_each_n(statistics.begin(), numberOfDimensions,
-#endif
-                            [statisticsData, beginOfData](auto& statisticsPerDimension)
-                        {
-                            const auto i = &statisticsPerDimension - statisticsData;
-
-                            const double dataValue = beginOfData[i];
-                            statisticsPerDimension = { {dataValue, dataValue}, {quiet_NaN, quiet_NaN} };
-                        });
-                    }
-                    else
+                    // Map each row to the index of its point in the (full) point data
+                    const auto rowIndexFunction = [&localSelectionIndices, &indices, selectedPointsOnly, isFull](const std::size_t row) -> std::size_t
                     {
-#ifndef __APPLE__
-                        (void)std::for_each_n(std::execution::par_unseq, statistics.begin(), numberOfDimensions,
-#else
-                        (void)std::for_each_n(statistics.begin(), numberOfDimensions,
-#endif
-                            [statisticsData, numberOfDimensions, numberOfPoints, beginOfData](auto& statisticsPerDimension)
-                        {
-                            const std::unique_ptr<double[]> data(new double[numberOfPoints]);
-                            {
-                                const auto i = &statisticsPerDimension - statisticsData;
-
-                                for (unsigned j{}; j < numberOfPoints; ++j)
-                                {
-                                    data[j] = beginOfData[j * numberOfDimensions + i];
-                                }
-                            }
-
-                            double sum{};
-                            unsigned numberOfNonZeroValues{};
-
-                            for (unsigned j{}; j < numberOfPoints; ++j)
-                            {
-                                const auto value = data[j];
-
-                                if (value != 0.0)
-                                {
-                                    sum += value;
-                                    ++numberOfNonZeroValues;
-                                }
-                            }
-                            const auto mean = sum / numberOfPoints;
-
-                            double sumOfSquares{};
-
-                            for (unsigned j{}; j < numberOfPoints; ++j)
-                            {
-                                const auto value = data[j] - mean;
-                                sumOfSquares += value * value;
-                            }
-
-                            static_assert(quiet_NaN != quiet_NaN);
-
-                            statisticsPerDimension = StatisticsPerDimension
-                            {
-                                {
-                                    mean,
-                                    (numberOfNonZeroValues == 0) ? quiet_NaN : (sum / numberOfNonZeroValues)
-                                },
-                                {
-                                    std::sqrt(sumOfSquares / (numberOfPoints - 1)),
-                                    (numberOfNonZeroValues == 0) ? quiet_NaN : std::sqrt(sumOfSquares / numberOfNonZeroValues)
-                                }
-                            };
-                        });
-                    }
-                }
-            });
+                        const auto localIndex = selectedPointsOnly ? std::size_t{ localSelectionIndices[row] } : row;
+
+                        return isFull ? localIndex : std::size_t{ indices[localIndex] };
+                    };
+
+                    return DimensionStatistics::compute(beginOfData, points.getNumDimensions(), numberOfRows, rowIndexFunction);
+                }));
+
+                DimensionStatistics::cacheStatistics(cacheKey, signature, cachedStatistics);
+
+                if (!derivedDataKey.isEmpty())
+                    DimensionStatistics::storeDerivedData(derivedDataKey, *cachedStatistics);
+            }
+
+            statistics = *cachedStatistics;
+
             qDebug()
                 << " Duration: " << QTime::currentTime().msecsTo(time) << " microsecond(s)";
 
@@ -19,6 +19,7 @@ DimensionsPickerSelectAction::DimensionsPickerSelectAction(DimensionsPickerActio
     _dimensionsPickerAction(dimensionsPickerAction),
     _selectionThresholdAction(this, "Selection threshold", 0),
     _computeStatisticsAction(this, "Compute statistics"),
+    _selectedPointsOnlyAction(this, "Selected points only"),
     _selectVisibleAction(this, "Select visible"),
     _selectNonVisibleAction(this, "Select non-visible"),
     _loadSelectionAction(this, "Load selection"),
@@ -32,6 +33,7 @@ DimensionsPickerSelectAction::DimensionsPickerSelectAction(DimensionsPickerActio
 
     _selectionThresholdAction.setToolTip("Threshold for selecting dimensions");
     _computeStatisticsAction.setToolTip("Compute the dimension statistics");
+    _selectedPointsOnlyAction.setToolTip("Compute the dimension statistics of the selected points only");
     _selectVisibleAction.setToolTip("Select visible dimensions");
     _selectNonVisibleAction.setToolTip("Select non-visible dimensions");
     _loadSelectionAction.setToolTip("Load dimension selection from file");
@@ -168,7 +170,12 @@ DimensionsPickerSelectAction::Widget::Widget(QWidget* parent, DimensionsPickerSe
 
     layout->addLayout(selectionThresholdLayout);
 
-    layout->addWidget(dimensionsPickerSelectAction->getComputeStatisticsAction().createWidget(this));
+    auto computeStatisticsLayout = new QHBoxLayout();
+
+    computeStatisticsLayout->addWidget(dimensionsPickerSelectAction->getComputeStatisticsAction().createWidget(this), 1);
+    computeStatisticsLayout->addWidget(dimensionsPickerSelectAction->getSelectedPointsOnlyAction().createWidget(this));
+
+    layout->addLayout(computeStatisticsLayout);
 
     auto selectLayout = new QHBoxLayout();
 
@@ -7,6 +7,7 @@
 #include <actions/WidgetAction.h>
 #include <actions/WidgetActionWidget.h>
 #include <actions/IntegralAction.h>
+#include <actions/ToggleAction.h>
 #include <actions/TriggerAction.h>
 
 class DimensionsPickerAction;
@@ -66,6 +67,7 @@ public: // Action getters
 
     IntegralAction& getSelectionThresholdAction() { return _selectionThresholdAction; }
     TriggerAction& getComputeStatisticsAction() { return _computeStatisticsAction; }
+    ToggleAction& getSelectedPointsOnlyAction() { return _selectedPointsOnlyAction; }
     TriggerAction& getSelectVisibleAction() { return _selectVisibleAction; }
     TriggerAction& getSelectNonVisibleAction() { return _selectNonVisibleAction; }
     TriggerAction& getLoadSelectionAction() { return _loadSelectionAction; }
@@ -77,6 +79,7 @@ protected:
     IntegralAction              _selectionThresholdAction;      /** Selection threshold action */
     TriggerAction               _selectVisibleAction;           /** Select visible dimensions action */
     TriggerAction               _computeStatisticsAction;       /** Compute statistics action */
+    ToggleAction                _selectedPointsOnlyAction;      /** Compute the statistics of the selected points only action */
     TriggerAction               _selectNonVisibleAction;        /** Select non visible dimensions action */
     TriggerAction               _loadSelectionAction;           /** Load selection action */
     TriggerAction               _saveSelectionAction;           /** Save selection action */
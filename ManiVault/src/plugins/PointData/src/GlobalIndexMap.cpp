@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "GlobalIndexMap.h"
+
+#include <algorithm>
+
+GlobalIndexMap::GlobalIndexMap(std::vector<std::uint32_t>&& localToGlobal, std::uint32_t numberOfGlobalIndices, bool identity) :
+    _localToGlobal(std::move(localToGlobal)),
+    _numberOfGlobalIndices(numberOfGlobalIndices),
+    _identity(identity),
+    _inverseBuilt(),
+    _inverseDense(true),
+    _duplicates(false),
+    _denseGlobalToLocal(),
+    _sparseGlobalToLocal()
+{
+}
+
+const std::vector<std::uint32_t>& GlobalIndexMap::getLocalToGlobal() const
+{
+    return _localToGlobal;
+}
+
+std::uint32_t GlobalIndexMap::getNumberOfLocalIndices() const
+{
+    return static_cast<std::uint32_t>(_localToGlobal.size());
+}
+
+std::uint32_t GlobalIndexMap::getNumberOfGlobalIndices() const
+{
+    return _numberOfGlobalIndices;
+}
+
+std::uint32_t GlobalIndexMap::getGlobalIndex(std::uint32_t localIndex) const
+{
+    return _localToGlobal[localIndex];
+}
+
+std::int64_t GlobalIndexMap::getLocalIndex(std::uint32_t globalIndex) const
+{
+    if (_identity)
+        return globalIndex < _localToGlobal.size() ? static_cast<std::int64_t>(globalIndex) : -1;
+
+    buildInverse();
+
+    if (_inverseDense)
+        return globalIndex < _denseGlobalToLocal.size() ? _denseGlobalToLocal[globalIndex] : -1;
+
+    const auto it = _sparseGlobalToLocal.find(globalIndex);
+
+    return it == _sparseGlobalToLocal.end() ? -1 : static_cast<std::int64_t>(it->second);
+}
+
+bool GlobalIndexMap::isIdentity() const
+{
+    return _identity;
+}
+
+bool GlobalIndexMap::hasDuplicates() const
+{
+    if (_identity)
+        return false;
+
+    buildInverse();
+
+    return _duplicates;
+}
+
+bool GlobalIndexMap::isInverseDense() const
+{
+    if (_identity)
+        return true;
+
+    buildInverse();
+
+    return _inverseDense;
+}
+
+void GlobalIndexMap::buildInverse() const
+{
+    std::call_once(_inverseBuilt, [this]() -> void {
+        const auto numberOfLocalIndices = static_cast<std::uint64_t>(_localToGlobal.size());
+
+        _inverseDense = static_cast<std::uint64_t>(_numberOfGlobalIndices) <= maximumDenseSparsity * std::max<std::uint64_t>(numberOfLocalIndices, 1);
+
+        if (_inverseDense) {
+            _denseGlobalToLocal.assign(_numberOfGlobalIndices, -1);
+
+            for (std::uint32_t localIndex = 0; localIndex < numberOfLocalIndices; localIndex++) {
+                const auto globalIndex = _localToGlobal[localIndex];
+
+                if (globalIndex >= _denseGlobalToLocal.size())
+                    continue;
+
+                auto& inverse = _denseGlobalToLocal[globalIndex];
+
+                if (inverse >= 0)
+                    _duplicates = true;
+                else
+                    inverse = static_cast<std::int32_t>(localIndex);
+            }
+        }
+        else {
+            _sparseGlobalToLocal.reserve(numberOfLocalIndices);
+
+            for (std::uint32_t localIndex = 0; localIndex < numberOfLocalIndices; localIndex++)
+                if (!_sparseGlobalToLocal.emplace(_localToGlobal[localIndex], localIndex).second)
+                    _duplicates = true;
+        }
+    });
+}
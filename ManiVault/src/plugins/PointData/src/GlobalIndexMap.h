@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "pointdata_export.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Global index map class
+ *
+ * Immutable snapshot of the flattened local to global index mapping of a points dataset (the composition of all
+ * subset indices in its derived/subset chain). The global to local inverse is built on first use, as a dense array
+ * when the local indices cover a reasonable fraction of the global index space, and as a hash map otherwise.
+ *
+ * Instances are shared between callers with std::shared_ptr and are thread-safe.
+ *
+ * @author Thomas Kroes
+ */
+class POINTDATA_EXPORT GlobalIndexMap
+{
+public:
+
+    /** Global indices are stored densely when there are at most this many global indices per local index */
+    static constexpr std::uint64_t maximumDenseSparsity = 8;
+
+public:
+
+    /**
+     * Construct with \p localToGlobal indices
+     * @param localToGlobal Global index for each local index
+     * @param numberOfGlobalIndices Size of the global index space (number of raw points of the source dataset)
+     * @param identity Whether the local indices equal the global indices
+     */
+    GlobalIndexMap(std::vector<std::uint32_t>&& localToGlobal, std::uint32_t numberOfGlobalIndices, bool identity);
+
+    /**
+     * Get the global index for each local index
+     * @return Local to global indices
+     */
+    const std::vector<std::uint32_t>& getLocalToGlobal() const;
+
+    /**
+     * Get the number of local indices
+     * @return Number of local indices
+     */
+    std::uint32_t getNumberOfLocalIndices() const;
+
+    /**
+     * Get the size of the global index space
+     * @return Number of global indices
+     */
+    std::uint32_t getNumberOfGlobalIndices() const;
+
+    /**
+     * Get the global index of \p localIndex
+     * @param localIndex Local index
+     * @return Global index
+     */
+    std::uint32_t getGlobalIndex(std::uint32_t localIndex) const;
+
+    /**
+     * Get the (first) local index of \p globalIndex
+     * @param globalIndex Global index
+     * @return Local index, -1 when the global index is not part of the dataset
+     */
+    std::int64_t getLocalIndex(std::uint32_t globalIndex) const;
+
+    /**
+     * Get whether the local indices equal the global indices
+     * @return Boolean determining whether the mapping is the identity
+     */
+    bool isIdentity() const;
+
+    /**
+     * Get whether multiple local indices map to the same global index (in which case getLocalIndex() only returns the first)
+     * @return Boolean determining whether there are duplicate global indices
+     */
+    bool hasDuplicates() const;
+
+    /**
+     * Get whether the global to local inverse is stored densely
+     * @return Boolean determining whether the inverse is dense
+     */
+    bool isInverseDense() const;
+
+private:
+
+    /** Build the global to local inverse (once) */
+    void buildInverse() const;
+
+private:
+    const std::vector<std::uint32_t>                        _localToGlobal;             /** Global index for each local index */
+    const std::uint32_t                                     _numberOfGlobalIndices;     /** Size of the global index space */
+    const bool                                              _identity;                  /** Whether the local indices equal the global indices */
+    mutable std::once_flag                                  _inverseBuilt;              /** Guards the lazy construction of the inverse */
+    mutable bool                                            _inverseDense;              /** Whether the inverse is stored in the dense array */
+    mutable bool                                            _duplicates;                /** Whether multiple local indices map to the same global index */
+    mutable std::vector<std::int32_t>                       _denseGlobalToLocal;        /** Dense global to local inverse (-1 for absent global indices) */
+    mutable std::unordered_map<std::uint32_t, std::uint32_t> _sparseGlobalToLocal;      /** Sparse global to local inverse */
+};
@@ -4,6 +4,7 @@
 
 #include "InfoAction.h"
 
+#include <util/MemoryAccounting.h>
 #include <util/Miscellaneous.h>
 
 using namespace mv;
@@ -18,6 +19,7 @@ InfoAction::InfoAction(QObject* parent, const Dataset<Points>& points) :
     _numberOfPointsAction(this, "Number of points"),
     _numberOfDimensionsAction(this, "Number of dimensions"),
     _rawDataSizeAction(this, "Raw data size"),
+    _memoryStatusAction(this, "Memory status"),
     _numberOfSelectedPointsAction(this, points),
     _selectedIndicesAction(this, points),
     _createSetFromSelection(this, points)
@@ -29,6 +31,7 @@ InfoAction::InfoAction(QObject* parent, const Dataset<Points>& points) :
     addAction(&_numberOfPointsAction);
     addAction(&_numberOfDimensionsAction);
     addAction(&_rawDataSizeAction);
+    addAction(&_memoryStatusAction);
     addAction(&_numberOfSelectedPointsAction);
     addAction(&_selectedIndicesAction);
     addAction(&_createSetFromSelection);
@@ -37,12 +40,14 @@ InfoAction::InfoAction(QObject* parent, const Dataset<Points>& points) :
     _numberOfPointsAction.setEnabled(false);
     _numberOfDimensionsAction.setEnabled(false);
     _rawDataSizeAction.setEnabled(false);
+    _memoryStatusAction.setEnabled(false);
 
     _dataStorageAction.setToolTip("The type of data storage (e.g. owner or proxy)");
     _proxyDatasetsAction.setToolTip("Proxy datasets");
     _numberOfPointsAction.setToolTip("The number of points");
     _numberOfDimensionsAction.setToolTip("The number of dimensions in the point data");
     _rawDataSizeAction.setToolTip("The amount of memory occupied for raw data by the dataset");
+    _memoryStatusAction.setToolTip("Whether the raw data resides in memory or is spilled to disk (reloaded on access), and the memory occupied by the selection");
 
     _createSetFromSelection.setVisible(false);
 
@@ -56,7 +61,19 @@ InfoAction::InfoAction(QObject* parent, const Dataset<Points>& points) :
         _rawDataSizeAction.setString(_points->getRawDataSizeHumanReadable());
     };
 
+    const auto updateMemoryStatusAction = [this]() -> void {
+        if (!_points.isValid())
+            return;
+
+        const auto rawDataName          = _points->getRawDataName();
+        const auto numberOfSelectedBytes = MemoryAccounting::getAllocation(MemoryAccounting::Category::Selection, rawDataName);
+
+        _memoryStatusAction.setString(QString("%1, selection %2").arg(mv::memory().isSpilled(rawDataName) ? QString("Spilled to disk") : QString("Resident"), getNoBytesHumanReadable(numberOfSelectedBytes)));
+    };
+
     connect(&_points, &Dataset<Points>::dataChanged, this, updateActions);
+    connect(&mv::memory(), &AbstractMemoryManager::accountingChanged, this, updateMemoryStatusAction);
 
     updateActions();
+    updateMemoryStatusAction();
 }
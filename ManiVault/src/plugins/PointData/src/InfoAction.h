@@ -42,6 +42,7 @@ public: // Action getters
     StringAction& getNumberOfPointsAction() { return _numberOfPointsAction; }
     StringAction& getNumberOfDimensionsAction() { return _numberOfDimensionsAction; }
     StringAction& getRawDataSizeAction() { return _rawDataSizeAction; }
+    StringAction& getMemoryStatusAction() { return _memoryStatusAction; }
     NumberOfSelectedPointsAction& getNumberOfSelectedPointsAction() { return _numberOfSelectedPointsAction; }
     SelectedIndicesAction& getSelectedIndicesAction() { return _selectedIndicesAction; }
     CreateSetFromSelectionAction& getCreateSetFromSelection() { return _createSetFromSelection; }
@@ -53,6 +54,7 @@ protected:
     StringAction                    _numberOfPointsAction;              /** Number of points action */
     StringAction                    _numberOfDimensionsAction;          /** Number of dimensions action */
     StringAction                    _rawDataSizeAction;                 /** Amount of memory for raw data */    
+    StringAction                    _memoryStatusAction;                /** Memory status of the raw data and selection */
     NumberOfSelectedPointsAction    _numberOfSelectedPointsAction;      /** Number of selected points action */
     SelectedIndicesAction           _selectedIndicesAction;             /** Selected indices action */
     CreateSetFromSelectionAction    _createSetFromSelection;            /** Create set from selection action */
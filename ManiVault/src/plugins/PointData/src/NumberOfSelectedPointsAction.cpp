@@ -49,15 +49,15 @@ NumberOfSelectedPointsAction::Widget::Widget(QWidget* parent, NumberOfSelectedPo
         std::vector<std::uint32_t> selectedIndices;
 
         if (points->isFull()) {
-            selectedIndices = selection->indices;
+            selectedIndices = selection->getIndices();
         }
         else {
             selectedIndices.clear();
-            selectedIndices.reserve(points->indices.size());
+            selectedIndices.reserve(points->getIndices().size());
 
-            QSet<std::uint32_t> indicesSet(points->indices.begin(), points->indices.end());
+            QSet<std::uint32_t> indicesSet(points->getIndices().begin(), points->getIndices().end());
 
-            for (const auto& selectionIndex : selection->indices)
+            for (const auto& selectionIndex : selection->getIndices())
                 if (indicesSet.contains(selectionIndex))
                     selectedIndices.push_back(selectionIndex);
         }
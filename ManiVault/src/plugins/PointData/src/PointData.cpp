@@ -13,17 +13,42 @@
 #include <actions/GroupAction.h>
 #include <event/Event.h>
 #include <graphics/Vector2f.h>
+#include <util/DerivedDataCache.h>
+#include <util/Exception.h>
+#include <util/MemoryAccounting.h>
 #include <util/Serialization.h>
-#include <util/Timer.h>
+#include <util/Trace.h>
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDebug>
+#include <QFile>
 #include <QPainter>
 #include <QtCore>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <set>
+#include <thread>
 #include <type_traits>
 
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
 Q_PLUGIN_METADATA(IID "studio.manivault.PointData")
 
 // =============================================================================
@@ -34,12 +59,13 @@ using namespace mv::util;
 
 PointData::~PointData(void)
 {
-    
+    unregisterSpillable();
+    discardSpill();
 }
 
 void PointData::init()
 {
-
+    registerSpillable();
 }
 
 mv::Dataset<DatasetImpl> PointData::createDataSet(const QString& guid /*= ""*/) const
@@ -76,7 +102,7 @@ std::uint64_t  PointData::getRawDataSize() const
 {
     if (_isDense)
     {
-        std::uint64_t elementSize = std::visit([](auto& vec) { return vec.empty() ? 0u : sizeof(vec[0]); }, _variantOfVectors);
+        std::uint64_t elementSize = std::visit([](const auto& vec) -> std::uint64_t { return sizeof(typename std::decay_t<decltype(vec)>::value_type); }, _variantOfVectors);
         return elementSize * getNumberOfElements();
     }
     else
@@ -87,10 +113,31 @@ std::uint64_t  PointData::getRawDataSize() const
 
 void* PointData::getDataVoidPtr()
 {
-    return std::visit([](auto& vec) { return (void*)vec.data(); }, _variantOfVectors);
+    dequantize();
+
+    return const_cast<void*>(getDataConstVoidPtr());
 }
 
 const void* PointData::getDataConstVoidPtr() const
+{
+    // The elements of quantized data are codes, readers of the element type (float32) would misinterpret them
+    if (_quantization.isEnabled())
+        throw std::runtime_error("The point data is quantized, use getStorageConstVoidPtr() to access the quantization codes");
+
+    return getStorageConstVoidPtr();
+}
+
+const void* PointData::getStorageConstVoidPtr() const
+{
+    const auto pin = pinResident();
+
+    // The pointer outlives the pin, so the data may no longer be spilled
+    _isResidencyRetained.store(true, std::memory_order_release);
+
+    return getPinnedDataPtr();
+}
+
+const void* PointData::getPinnedDataPtr() const
 {
     return std::visit([](const auto& vec) { return (const void*)vec.data(); }, _variantOfVectors);
 }
@@ -106,6 +153,11 @@ void PointData::setData(const std::nullptr_t, const std::size_t numPoints, const
     _numDimensions = static_cast<unsigned int>(numDimensions);
 }
 
+bool PointData::isAdopted() const
+{
+    return std::visit([](const auto& vec) { return vec.isAdopted(); }, _variantOfVectors);
+}
+
 void PointData::setDimensionNames(const std::vector<QString>& dimNames)
 {
     if (dimNames.empty())
@@ -119,8 +171,16 @@ void PointData::setDimensionNames(const std::vector<QString>& dimNames)
 
 float PointData::getValueAt(const std::size_t index) const
 {
-    return std::visit([index](const auto& vec)
+    const auto pin = pinResident();
+
+    return std::visit([this, index](const auto& vec)
         {
+            using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+            if constexpr (PointDataQuantization::isCodeType<CodeType>)
+                if (_quantization.isEnabled())
+                    return _quantization.dequantize(vec[index], static_cast<std::uint32_t>(index % _numDimensions));
+
             return static_cast<float>(vec[index]);
         },
         _variantOfVectors);
@@ -128,6 +188,10 @@ float PointData::getValueAt(const std::size_t index) const
 
 void PointData::setValueAt(const std::size_t index, const float newValue)
 {
+    dequantize();
+
+    const auto pin = pinResident();
+
     std::visit([index, newValue](auto& vec)
         {
             using value_type = typename std::remove_reference_t<decltype(vec)>::value_type;
@@ -149,6 +213,10 @@ void PointData::fromVariantMap(const QVariantMap& variantMap)
     const auto elementTypeIndex     = static_cast<PointData::ElementTypeSpecifier>(data["TypeIndex"].toInt());
     const auto rawData              = data["Raw"].toMap();
 
+    discardSpill();
+
+    _quantization = {};
+
     bool isDense = true;
     if (variantMap.contains("Dense"))
         isDense = variantMap["Dense"].toBool();;
@@ -160,7 +228,13 @@ void PointData::fromVariantMap(const QVariantMap& variantMap)
     {
         setElementTypeSpecifier(elementTypeIndex);
         resizeVector(numberOfElements);
-        populateDataBufferFromVariantMap(rawData, (char*)getDataVoidPtr());
+
+        const auto pin = pinResident();
+
+        populateDataBufferFromVariantMap(rawData, (char*)getPinnedDataPtr());
+
+        if (data.contains("Quantization"))
+            _quantization.fromVariantMap(data["Quantization"].toMap());
     }
     else
     {
@@ -191,6 +265,44 @@ void PointData::fromVariantMap(const QVariantMap& variantMap)
     }
 }
 
+QByteArray PointData::computeContentHash() const
+{
+    MV_TRACE_SCOPE_DETAIL("data", "Compute point data content hash", getName());
+
+    QByteArray header;
+
+    QDataStream headerDataStream(&header, QIODevice::WriteOnly);
+
+    headerDataStream << _isDense << static_cast<qint32>(getElementTypeSpecifier()) << getNumPoints() << getNumDimensions();
+
+    if (_quantization.isEnabled())
+        headerDataStream << _quantization.toVariantMap();
+
+    QCryptographicHash contentHash(QCryptographicHash::Sha256);
+
+    contentHash.addData(header);
+
+    if (_isDense)
+    {
+        // Prevent spilling while the data is hashed
+        const auto pin = pinResident();
+
+        contentHash.addData(DerivedDataCache::computeContentHash(getPinnedDataPtr(), getRawDataSize()));
+    }
+    else
+    {
+        const auto& indexPointers   = _sparseData.getIndexPointers();
+        const auto& colIndices      = _sparseData.getColIndices();
+        const auto& values          = _sparseData.getValues();
+
+        contentHash.addData(DerivedDataCache::computeContentHash(indexPointers.data(), indexPointers.size() * sizeof(size_t)));
+        contentHash.addData(DerivedDataCache::computeContentHash(colIndices.data(), colIndices.size() * sizeof(size_t)));
+        contentHash.addData(DerivedDataCache::computeContentHash(values.data(), values.size() * sizeof(float)));
+    }
+
+    return contentHash.result();
+}
+
 QVariantMap PointData::toVariantMap() const
 {
     const auto numberOfElements = getNumberOfElements();
@@ -201,14 +313,23 @@ QVariantMap PointData::toVariantMap() const
         const auto typeSpecifierName = getElementTypeNames()[static_cast<std::int32_t>(typeSpecifier)];
         const auto typeIndex = static_cast<std::int32_t>(typeSpecifier);
 
-        QVariantMap rawData = rawDataToVariantMap((const char*)getDataConstVoidPtr(), getRawDataSize(), true);
+        // Prevent spilling while the data is serialized
+        const auto pin = pinResident();
 
-        return {
+        QVariantMap rawData = rawDataToVariantMap((const char*)getPinnedDataPtr(), getRawDataSize(), true);
+
+        QVariantMap variantMap = {
             { "TypeIndex", QVariant::fromValue(typeIndex) },
             { "TypeName", QVariant(typeSpecifierName) },
             { "Raw", QVariant::fromValue(rawData) },
             { "NumberOfElements", QVariant::fromValue(numberOfElements) }
         };
+
+        // Quantized data is saved as codes, with the per-dimension scales and offsets
+        if (_quantization.isEnabled())
+            variantMap["Quantization"] = _quantization.toVariantMap();
+
+        return variantMap;
     }
     else
     {
@@ -234,10 +355,340 @@ QVariantMap PointData::toVariantMap() const
     }
 }
 
+QString PointData::getSpillName() const
+{
+    return getName();
+}
+
+std::uint64_t PointData::getNumberOfResidentBytes() const
+{
+    // Adopted memory is owned (and possibly file-backed) elsewhere, so spilling it does not free anything
+    if (!_isDense || _isSpilled.load(std::memory_order_acquire) || _isResidencyRetained.load(std::memory_order_acquire) || isAdopted())
+        return 0;
+
+    return getRawDataSize();
+}
+
+bool PointData::isSpilled() const
+{
+    return _isSpilled.load(std::memory_order_acquire);
+}
+
+bool PointData::spill(const QString& filePath)
+{
+    MV_TRACE_SCOPE_DETAIL("data", "Spill point data", getName());
+
+    std::lock_guard<std::mutex> lock(_residencyMutex);
+
+    // Pins are checked while holding the residency mutex: a pin which is taken after this check waits in reload() until the data is spilled, and then reloads it
+    if (!_isDense || _isSpilled.load(std::memory_order_relaxed) || isPinned() || _isResidencyRetained.load(std::memory_order_acquire) || isAdopted())
+        return false;
+
+    const auto numberOfElements = getSizeOfVector();
+    const auto numberOfBytes    = static_cast<qint64>(getRawDataSize());
+
+    if (numberOfElements == 0)
+        return false;
+
+    QFile spillFile(filePath);
+
+    if (!spillFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        throw std::runtime_error(QString("Unable to open %1 for writing: %2").arg(filePath, spillFile.errorString()).toStdString());
+
+    const auto data = std::visit([](const auto& vec) { return reinterpret_cast<const char*>(vec.data()); }, _variantOfVectors);
+
+    if (spillFile.write(data, numberOfBytes) != numberOfBytes) {
+        const auto errorString = spillFile.errorString();
+
+        spillFile.remove();
+
+        throw std::runtime_error(QString("Unable to write %1: %2").arg(filePath, errorString).toStdString());
+    }
+
+    spillFile.close();
+
+    _spillFilePath              = filePath;
+    _numberOfSpilledElements    = numberOfElements;
+
+    // Release the memory (keeps the element type)
+    std::visit([](auto& vec) { std::remove_reference_t<decltype(vec)>().swap(vec); }, _variantOfVectors);
+
+    _isSpilled.store(true, std::memory_order_release);
+
+    return true;
+}
+
+void PointData::reload()
+{
+    // Always take the residency mutex, so that a pin which is taken during a spill waits for it (see spill())
+    std::lock_guard<std::mutex> lock(_residencyMutex);
+
+    if (!_isSpilled.load(std::memory_order_relaxed))
+        return;
+
+    MV_TRACE_SCOPE_DETAIL("data", "Reload point data", getName());
+
+    QFile spillFile(_spillFilePath);
+
+    if (!spillFile.open(QIODevice::ReadOnly))
+        throw std::runtime_error(QString("Unable to open %1 for reading: %2").arg(_spillFilePath, spillFile.errorString()).toStdString());
+
+    std::visit([this, &spillFile](auto& vec) -> void {
+        vec.resize(_numberOfSpilledElements);
+
+        const auto numberOfBytes = static_cast<qint64>(vec.size() * sizeof(typename std::remove_reference_t<decltype(vec)>::value_type));
+
+        if (spillFile.read(reinterpret_cast<char*>(vec.data()), numberOfBytes) != numberOfBytes)
+            throw std::runtime_error(QString("Unable to read %1: %2").arg(_spillFilePath, spillFile.errorString()).toStdString());
+    }, _variantOfVectors);
+
+    spillFile.close();
+    spillFile.remove();
+
+    _spillFilePath.clear();
+
+    _numberOfSpilledElements = 0;
+
+    _isSpilled.store(false, std::memory_order_release);
+}
+
+void PointData::discardSpill()
+{
+    // The data vector is about to be replaced, so pointers into the current data are no longer valid anyway
+    _isResidencyRetained.store(false, std::memory_order_release);
+
+    if (!_isSpilled.load(std::memory_order_acquire))
+        return;
+
+    std::lock_guard<std::mutex> lock(_residencyMutex);
+
+    if (!_isSpilled.load(std::memory_order_relaxed))
+        return;
+
+    QFile::remove(_spillFilePath);
+
+    _spillFilePath.clear();
+
+    _numberOfSpilledElements = 0;
+
+    _isSpilled.store(false, std::memory_order_release);
+}
+
+bool PointData::commitAppendedPoints()
+{
+    std::vector<VariantOfVectors> appendedChunks;
+
+    {
+        std::lock_guard<std::mutex> lock(_appendMutex);
+
+        appendedChunks.swap(_appendedChunks);
+    }
+
+    if (appendedChunks.empty())
+        return false;
+
+    MV_TRACE_SCOPE_DETAIL("data", "Commit appended points", getName());
+
+    dequantize();
+
+    const auto pin = pinResident();
+
+    std::visit([this, &appendedChunks](auto& vec) -> void {
+        using BufferType = std::remove_reference_t<decltype(vec)>;
+
+        // Validate all chunks first, so that a mismatching chunk leaves the data untouched
+        auto numberOfElements = vec.size();
+
+        for (const auto& appendedChunk : appendedChunks) {
+            const auto chunk = std::get_if<BufferType>(&appendedChunk);
+
+            if (chunk == nullptr)
+                throw std::runtime_error("Appended points differ in data type from the reserved points");
+
+            if (chunk->size() % _numDimensions != 0)
+                throw std::runtime_error("Number of appended elements is not a multiple of the number of dimensions");
+
+            numberOfElements += chunk->size();
+        }
+
+        vec.reserveForAppend(numberOfElements);
+
+        for (const auto& appendedChunk : appendedChunks) {
+            const auto& chunk = std::get<BufferType>(appendedChunk);
+
+            vec.append(chunk.data(), chunk.size());
+        }
+    }, _variantOfVectors);
+
+    return true;
+}
+
+bool PointData::quantize(const float maximumError)
+{
+    MV_TRACE_SCOPE_DETAIL("data", "Quantize point data", getName());
+
+    if (!_isDense || _quantization.isEnabled() || getElementTypeSpecifier() != ElementTypeSpecifier::float32 || !(maximumError > 0.f))
+        return false;
+
+    const auto numberOfPoints = static_cast<std::size_t>(getNumPoints());
+
+    if (numberOfPoints == 0)
+        return false;
+
+    const auto pin = pinResident();
+
+    const auto& values = std::get<PointDataBuffer<float>>(_variantOfVectors);
+
+    // Establish the value range per dimension
+    std::vector<float> minima(_numDimensions, std::numeric_limits<float>::max());
+    std::vector<float> maxima(_numDimensions, std::numeric_limits<float>::lowest());
+
+    for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        const auto pointValues = values.data() + pointIndex * _numDimensions;
+
+        for (std::size_t dimensionIndex = 0; dimensionIndex < _numDimensions; dimensionIndex++) {
+            minima[dimensionIndex] = std::min(minima[dimensionIndex], pointValues[dimensionIndex]);
+            maxima[dimensionIndex] = std::max(maxima[dimensionIndex], pointValues[dimensionIndex]);
+        }
+    }
+
+    float maximumRange = 0.f, maximumMagnitude = 0.f;
+
+    for (std::size_t dimensionIndex = 0; dimensionIndex < _numDimensions; dimensionIndex++) {
+        maximumRange        = std::max(maximumRange, maxima[dimensionIndex] - minima[dimensionIndex]);
+        maximumMagnitude    = std::max({ maximumMagnitude, std::abs(minima[dimensionIndex]), std::abs(maxima[dimensionIndex]) });
+    }
+
+    // Non-finite values end up in the range (or break the comparisons) and cannot be quantized
+    const auto finite = std::isfinite(maximumRange) && std::all_of(values.begin(), values.end(), [](float value) { return std::isfinite(value); });
+
+    if (!finite)
+        return false;
+
+    const auto numberOfElements = values.size();
+
+    // Reconstruction in single precision adds a few ulps on top of the quantization error
+    const auto roundingError = 4.f * std::numeric_limits<float>::epsilon() * maximumMagnitude;
+
+    if (PointDataQuantization::getMaximumError<std::int8_t>(maximumRange) + roundingError <= maximumError) {
+        auto quantization = PointDataQuantization::fromRanges<std::int8_t>(minima, maxima);
+
+        std::vector<std::int8_t> codes(numberOfElements);
+
+        quantization.quantize(values.data(), codes.data(), numberOfPoints);
+
+        _variantOfVectors   = std::move(codes);
+        _quantization       = std::move(quantization);
+
+        return true;
+    }
+
+    if (PointDataQuantization::getMaximumError<std::uint16_t>(maximumRange) + roundingError <= maximumError) {
+        auto quantization = PointDataQuantization::fromRanges<std::uint16_t>(minima, maxima);
+
+        std::vector<std::uint16_t> codes(numberOfElements);
+
+        quantization.quantize(values.data(), codes.data(), numberOfPoints);
+
+        _variantOfVectors   = std::move(codes);
+        _quantization       = std::move(quantization);
+
+        return true;
+    }
+
+    return false;
+}
+
+void PointData::dequantize()
+{
+    if (!_quantization.isEnabled())
+        return;
+
+    MV_TRACE_SCOPE_DETAIL("data", "Dequantize point data", getName());
+
+    const auto pin = pinResident();
+
+    const auto numberOfPoints = static_cast<std::size_t>(getNumPoints());
+
+    std::vector<float> values(getSizeOfVector());
+
+    std::visit([this, &values, numberOfPoints](const auto& vec) -> void {
+        using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+        if constexpr (PointDataQuantization::isCodeType<CodeType>)
+            _quantization.dequantize(vec.data(), values.data(), numberOfPoints);
+        else
+            throw std::runtime_error("Quantized point data does not hold quantization codes");
+    }, _variantOfVectors);
+
+    _variantOfVectors   = std::move(values);
+    _quantization       = {};
+}
+
+bool PointData::isQuantized() const
+{
+    return _quantization.isEnabled();
+}
+
+const PointDataQuantization& PointData::getQuantization() const
+{
+    return _quantization;
+}
+
+std::shared_ptr<const PointData::GatheredPoints> PointData::gatherPoints(const std::vector<unsigned int>& indices) const
+{
+    MV_TRACE_SCOPE("data", "PointData::gatherPoints");
+
+    if (!_isDense)
+        return nullptr;
+
+    // Prevent spilling while the rows are gathered
+    const auto pin = pinResident();
+
+    auto gatheredPoints = std::make_shared<GatheredPoints>();
+
+    gatheredPoints->_quantization = _quantization;
+
+    std::visit([this, &indices, &gatheredPoints](const auto& vec) -> void
+        {
+            using ElementType = typename std::decay_t<decltype(vec)>::value_type;
+
+            // Rows are gathered in blocks, so that each task copies a reasonable amount of memory
+            constexpr std::size_t numberOfRowsPerBlock = 4096;
+
+            const auto numberOfDimensions   = static_cast<std::size_t>(_numDimensions);
+            const auto numberOfBlocks       = (indices.size() + numberOfRowsPerBlock - 1) / numberOfRowsPerBlock;
+
+            std::vector<ElementType> gathered(indices.size() * numberOfDimensions);
+            std::vector<std::size_t> blockIndices(numberOfBlocks);
+
+            std::iota(blockIndices.begin(), blockIndices.end(), 0);
+
+#ifndef __APPLE__
+            std::for_each(std::execution::par, blockIndices.begin(), blockIndices.end(), [&vec, &indices, &gathered, numberOfDimensions](const std::size_t blockIndex) -> void {
+#else
+            std::for_each(blockIndices.begin(), blockIndices.end(), [&vec, &indices, &gathered, numberOfDimensions](const std::size_t blockIndex) -> void {
+#endif
+                const auto firstRowIndex    = blockIndex * numberOfRowsPerBlock;
+                const auto lastRowIndex     = std::min(firstRowIndex + numberOfRowsPerBlock, indices.size());
+
+                for (auto rowIndex = firstRowIndex; rowIndex < lastRowIndex; rowIndex++)
+                    std::copy_n(vec.data() + indices[rowIndex] * numberOfDimensions, numberOfDimensions, gathered.data() + rowIndex * numberOfDimensions);
+            });
+
+            gatheredPoints->_variantOfVectors = VariantOfVectors(PointDataBuffer<ElementType>(std::move(gathered)));
+        },
+        _variantOfVectors);
+
+    return gatheredPoints;
+}
+
 void PointData::extractFullDataForDimension(std::vector<float>& result, const int dimensionIndex) const
 {
     CheckDimensionIndex(dimensionIndex);
 
+    const auto pin = pinResident();
+
     result.resize(getNumPoints());
 
     std::visit(
@@ -245,6 +696,23 @@ void PointData::extractFullDataForDimension(std::vector<float>& result, const in
         {
             const auto resultSize = result.size();
 
+            using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+            if constexpr (PointDataQuantization::isCodeType<CodeType>)
+            {
+                if (_quantization.isEnabled())
+                {
+                    const auto scale    = _quantization.getScales()[dimensionIndex];
+                    const auto offset   = _quantization.getOffsets()[dimensionIndex];
+                    const auto codes    = vec.data() + dimensionIndex;
+
+                    for (std::size_t i{}; i < resultSize; ++i)
+                        result[i] = offset + scale * static_cast<float>(codes[i * _numDimensions]);
+
+                    return;
+                }
+            }
+
             for (std::size_t i{}; i < resultSize; ++i)
                 result[i] = vec[i * _numDimensions + dimensionIndex];
 
@@ -260,6 +728,8 @@ void PointData::extractFullDataForDimensions(std::vector<mv::Vector2f>& result,
         CheckDimensionIndex(dimensionIndex1);
         CheckDimensionIndex(dimensionIndex2);
 
+        const auto pin = pinResident();
+
         result.resize(getNumPoints());
 
         std::visit(
@@ -267,6 +737,28 @@ void PointData::extractFullDataForDimensions(std::vector<mv::Vector2f>& result,
             {
                 const auto resultSize = result.size();
 
+                using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+                if constexpr (PointDataQuantization::isCodeType<CodeType>)
+                {
+                    if (_quantization.isEnabled())
+                    {
+                        const auto& scales  = _quantization.getScales();
+                        const auto& offsets = _quantization.getOffsets();
+
+                        const auto scale1 = scales[dimensionIndex1], offset1 = offsets[dimensionIndex1];
+                        const auto scale2 = scales[dimensionIndex2], offset2 = offsets[dimensionIndex2];
+
+                        for (std::size_t i{}; i < resultSize; ++i)
+                        {
+                            const auto n = i * _numDimensions;
+                            result[i].set(offset1 + scale1 * static_cast<float>(vec[n + dimensionIndex1]), offset2 + scale2 * static_cast<float>(vec[n + dimensionIndex2]));
+                        }
+
+                        return;
+                    }
+                }
+
                 for (std::size_t i{}; i < resultSize; ++i)
                 {
                     const auto n = i * _numDimensions;
@@ -293,13 +785,37 @@ void PointData::extractDataForDimensions(std::vector<mv::Vector2f>& result, cons
     CheckDimensionIndex(dimensionIndex1);
     CheckDimensionIndex(dimensionIndex2);
 
+    const auto pin = pinResident();
+
     result.resize(indices.size());
 
     std::visit(
-        [&result, this, dimensionIndex1, dimensionIndex2, indices](const auto& vec)
+        [&result, this, dimensionIndex1, dimensionIndex2, &indices](const auto& vec)
         {
             const auto resultSize = result.size();
 
+            using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+            if constexpr (PointDataQuantization::isCodeType<CodeType>)
+            {
+                if (_quantization.isEnabled())
+                {
+                    const auto& scales  = _quantization.getScales();
+                    const auto& offsets = _quantization.getOffsets();
+
+                    const auto scale1 = scales[dimensionIndex1], offset1 = offsets[dimensionIndex1];
+                    const auto scale2 = scales[dimensionIndex2], offset2 = offsets[dimensionIndex2];
+
+                    for (std::size_t i{}; i < resultSize; ++i)
+                    {
+                        const auto n = std::size_t{ indices[i] } *_numDimensions;
+                        result[i].set(offset1 + scale1 * static_cast<float>(vec[n + dimensionIndex1]), offset2 + scale2 * static_cast<float>(vec[n + dimensionIndex2]));
+                    }
+
+                    return;
+                }
+            }
+
             for (std::size_t i{}; i < resultSize; ++i)
             {
                 const auto n = std::size_t{ indices[i] } *_numDimensions;
@@ -309,16 +825,56 @@ void PointData::extractDataForDimensions(std::vector<mv::Vector2f>& result, cons
         _variantOfVectors);
 }
 
+// The deprecated indices reference is bound here, which is not a use of the deprecated API
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#else
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
 Points::Points(QString dataName, bool mayUnderive /*= true*/, const QString& guid /*= ""*/) :
     mv::DatasetImpl(dataName, mayUnderive, guid),
+    indices(_indices),
     _infoAction(nullptr),
     _dimensionsPickerGroupAction(nullptr),
-    _dimensionsPickerAction(nullptr)
+    _dimensionsPickerAction(nullptr),
+    _indices(),
+    _indicesVersion(0),
+    _globalIndexMapMutex(),
+    _globalIndexMap(),
+    _globalIndexMapSignature(),
+    _isCommitScheduled(false),
+    _lastDataChangedNotification(),
+    _materializationPolicy(MaterializationPolicy::Never),
+    _memoryBudget(0),
+    _numberOfVisits(0),
+    _materializedSubsetMutex(),
+    _materializedSubset(),
+    _materializedSubsetSignature(),
+    _dataVersion(0),
+    _histogramsMutex(),
+    _histograms(),
+    _histogramSelectionIndices(),
+    _histogramStamp(0),
+    _contentHashMutex(),
+    _contentHash(),
+    _contentHashIndicesVersion(0),
+    _contentHashDataVersion(0)
 {
 }
 
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#else
+#pragma GCC diagnostic pop
+#endif
+
 Points::~Points()
 {
+    MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getId());
+    MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getHistogramsAllocationOwner());
 }
 
 void Points::init()
@@ -347,11 +903,44 @@ void Points::init()
     //}
 
 
+    _memoryBudget = mv::memory().getBudget();
+
+    // Release the materialized subset when the memory budget is exceeded (the subset is visited through its indices instead)
+    connect(&mv::memory(), &mv::AbstractMemoryManager::accountingChanged, this, [this]() -> void {
+        _memoryBudget = mv::memory().getBudget();
+
+        if (_memoryBudget > 0 && mv::memory().getNumberOfHostBytes() > _memoryBudget && isMaterialized())
+            releaseMaterializedSubset();
+    });
+
+    _eventListener.addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetDataChanged));
     _eventListener.addSupportedEventType(static_cast<std::uint32_t>(EventType::DatasetDataSelectionChanged));
     _eventListener.registerDataEventByType(PointType, [this](DatasetEvent* dataEvent)
     {
         switch (dataEvent->getType())
         {
+            case EventType::DatasetDataChanged:
+            {
+                if (dataEvent->getDataset()->getRawDataName() != getRawDataName())
+                    break;
+
+                _dataVersion++;
+
+                {
+                    std::lock_guard<std::mutex> lock(_contentHashMutex);
+
+                    _contentHash.clear();
+                }
+
+                // Keep the materialized subset coherent with the point data it was gathered from
+                if (isMaterialized())
+                    releaseMaterializedSubset();
+
+                invalidateHistograms();
+
+                break;
+            }
+
             case EventType::DatasetDataSelectionChanged:
             {
                 // Do not process our own selection changes
@@ -374,15 +963,14 @@ void Points::init()
                     return;
 
                 // Get source target indices
-                auto& sourceIndices = foreignPoints->getSelection<Points>()->indices;
-                auto& targetIndices = getSelection<Points>()->indices;
+                const auto& sourceIndices = foreignPoints->getSelection<Points>()->_indices;
 
                 // Do nothing if the indices have not changed
-                if (sourceIndices == targetIndices)
+                if (sourceIndices == getSelection<Points>()->_indices)
                     return;
 
                 // Copy indices from source to target if the indices have changed
-                targetIndices = sourceIndices;
+                getSelection<Points>()->setIndices(sourceIndices);
 
                 events().notifyDatasetDataSelectionChanged(this);
 
@@ -407,30 +995,52 @@ void Points::setData(std::nullptr_t, const std::size_t numPoints, const std::siz
         events().notifyDatasetDataDimensionsChanged(this);
 }
 
-void Points::extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+void Points::commitAppendedPoints(const bool finished /*= true*/)
 {
-    // This overload assumes that the data set is "full".
-    // Please remove the assert once non-full support is implemented (if necessary).
-    assert(isFull());
+    const auto committed = getRawData<PointData>()->commitAppendedPoints();
 
-    if (isProxy()) {
-        result.resize(getNumPoints());
+    if (!committed && !finished)
+        return;
 
-        auto pointIndexOffset = 0u;
+    const auto now = std::chrono::steady_clock::now();
 
-        for (auto proxyMember : getProxyMembers()) {
-            auto points = mv::Dataset<Points>(proxyMember);
+    if (!finished && now - _lastDataChangedNotification < dataChangedNotificationInterval)
+        return;
 
-            std::vector<float> proxyPoints;
+    _lastDataChangedNotification = now;
 
-            proxyPoints.resize(points->getNumPoints());
+    events().notifyDatasetDataChanged(this);
+}
 
-            points->extractDataForDimension(proxyPoints, dimensionIndex);
+void Points::scheduleCommitAppendedPoints()
+{
+    if (_isCommitScheduled.exchange(true))
+        return;
 
-            std::copy(proxyPoints.begin(), proxyPoints.end(), result.begin() + pointIndexOffset);
+    // The queued invocation is dropped when the dataset is destroyed in the meantime
+    QMetaObject::invokeMethod(this, [this]() -> void {
+        _isCommitScheduled = false;
 
-            pointIndexOffset += points->getNumPoints();
+        try {
+            commitAppendedPoints(false);
+        }
+        catch (std::exception& e)
+        {
+            exceptionMessageBox("Unable to commit appended points", e);
         }
+    }, Qt::QueuedConnection);
+}
+
+void Points::extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const
+{
+    // This overload assumes that the data set is "full".
+    // Please remove the assert once non-full support is implemented (if necessary).
+    assert(isFull());
+
+    if (isProxy()) {
+        result.resize(getNumPoints());
+
+        populateDataForDimensions(result, std::array<int, 1>{ dimensionIndex });
     }
     else {
         getRawData<PointData>()->extractFullDataForDimension(result, dimensionIndex);
@@ -442,30 +1052,100 @@ void Points::extractDataForDimensions(std::vector<mv::Vector2f>& result, const i
     if (isProxy()) {
         result.resize(getNumPoints());
 
-        auto pointIndexOffset = 0u;
+        // Interleaved view of the two components of the result vectors
+        struct ComponentsView {
+            std::vector<mv::Vector2f>& _vectors;
+
+            float& operator[](std::size_t index) {
+                auto& vector = _vectors[index / 2];
+
+                return index % 2 == 0 ? vector.x : vector.y;
+            }
+        } componentsView{ result };
+
+        populateDataForDimensions(componentsView, std::array<int, 2>{ dimensionIndex1, dimensionIndex2 });
+    }
+    else {
+        const auto rawPointData = getRawData<PointData>();
+
+        if (isFull())
+            rawPointData->extractFullDataForDimensions(result, dimensionIndex1, dimensionIndex2);
+        else
+            rawPointData->extractDataForDimensions(result, dimensionIndex1, dimensionIndex2, _indices);
+    }
+}
 
-        for (auto proxyMember : getProxyMembers()) {
-            auto points = mv::Dataset<Points>(proxyMember);
+Points::ProxyMemberSlices Points::getProxyMemberSlices() const
+{
+    ProxyMemberSlices proxyMemberSlices;
 
-            std::vector<mv::Vector2f> proxyPoints;
+    if (!isProxy())
+        return proxyMemberSlices;
 
-            proxyPoints.resize(points->getNumPoints());
+    const auto proxyMembers = getProxyMembers();
 
-            points->extractDataForDimensions(proxyPoints, dimensionIndex1, dimensionIndex2);
+    proxyMemberSlices.reserve(proxyMembers.size());
 
-            std::copy(proxyPoints.begin(), proxyPoints.end(), result.begin() + pointIndexOffset);
+    std::size_t pointOffset = 0;
 
-            pointIndexOffset += points->getNumPoints();
-        }
+    for (const auto& proxyMember : proxyMembers) {
+        auto points = dynamic_cast<Points*>(proxyMember.get());
+
+        if (!points)
+            throw std::runtime_error(QString("Proxy member %1 is not a points dataset").arg(proxyMember->getGuiName()).toStdString());
+
+        // The raw data pointer is resolved lazily, do so before the members are read concurrently
+        points->getRawData<PointData>();
+
+        const auto numberOfPoints = static_cast<std::size_t>(points->getNumPoints());
+
+        proxyMemberSlices.push_back({ points, pointOffset, numberOfPoints });
+
+        pointOffset += numberOfPoints;
     }
-    else {
-        const auto rawPointData = getRawData<PointData>();
 
-        if (isFull())
-            rawPointData->extractFullDataForDimensions(result, dimensionIndex1, dimensionIndex2);
-        else
-            rawPointData->extractDataForDimensions(result, dimensionIndex1, dimensionIndex2, indices);
-    }
+    return proxyMemberSlices;
+}
+
+void Points::forEachInParallel(std::size_t count, const std::function<void(std::size_t)>& function)
+{
+    std::vector<std::size_t> invocationIndices(count);
+
+    std::iota(invocationIndices.begin(), invocationIndices.end(), 0);
+
+    // Exceptions may not escape a parallel algorithm, the first one is rethrown afterwards
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+
+    const auto invoke = [&function, &exception, &exceptionMutex](const std::size_t invocationIndex) -> void {
+        try {
+            function(invocationIndex);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(exceptionMutex);
+
+            if (!exception)
+                exception = std::current_exception();
+        }
+    };
+
+#ifndef __APPLE__
+    std::for_each(std::execution::par, invocationIndices.begin(), invocationIndices.end(), invoke);
+#else
+    std::for_each(invocationIndices.begin(), invocationIndices.end(), invoke);
+#endif
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+std::size_t Points::getNumberOfPartitions(std::size_t numberOfPoints)
+{
+    constexpr std::size_t minimumNumberOfPointsPerPartition = 65536;
+
+    const auto numberOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    return std::clamp<std::size_t>(numberOfPoints / minimumNumberOfPointsPerPartition, 1, numberOfThreads);
 }
 
 bool Points::mayProxy(const Datasets& proxyDatasets) const
@@ -489,7 +1169,7 @@ Dataset<DatasetImpl> Points::copy() const
     auto set = new Points(getRawDataName());
 
     set->setText(text());
-    set->indices = indices;
+    set->setIndices(_indices);
 
     return set;
 }
@@ -502,7 +1182,6 @@ Dataset<DatasetImpl> Points::createSubsetFromSelection(const QString& guiName, c
 Dataset<DatasetImpl> Points::createSubsetFromVisibleSelection(const QString& guiName, const Dataset<DatasetImpl>& parentDataSet /*= Dataset<DatasetImpl>()*/, const bool& visible /*= true*/) const
 {
     Dataset<Points> subsetSelection = getSelection()->copy();
-    std::vector<uint32_t>& selectionIndices = subsetSelection->getSelectionIndices();
 
     //// Get the global indices of the parent dataset
     //std::vector<uint32_t> globalIndices;
@@ -530,11 +1209,11 @@ Dataset<DatasetImpl> Points::createSubsetFromVisibleSelection(const QString& gui
     if (!isFull())
     {
         for (uint32_t& localIndex : localSelectionIndices)
-            localIndex = indices[localIndex];
+            localIndex = _indices[localIndex];
     }
     // If the data is full, then the locally selected points are the new subset
 
-    subsetSelection->indices = localSelectionIndices;
+    subsetSelection->setIndices(std::move(localSelectionIndices));
 
     return mv::data().createSubsetFromSelection(subsetSelection, toSmartPointer(), guiName, parentDataSet, visible);
 }
@@ -599,12 +1278,25 @@ void Points::setProxyMembers(const Datasets& proxyMembers)
 
         targetPoints->getGlobalIndices(targetGlobalIndices);
 
+        const auto numberOfMemberPoints = static_cast<std::uint32_t>(targetGlobalIndices.size());
+
+        // Members with a contiguous range of global indices (e.g. full datasets) are mapped procedurally, so no per-point maps have to be built
+        const auto firstGlobalIndex     = targetGlobalIndices.empty() ? 0u : targetGlobalIndices.front();
+        const auto hasContiguousIndices = std::adjacent_find(targetGlobalIndices.begin(), targetGlobalIndices.end(), [](std::uint32_t lhs, std::uint32_t rhs) -> bool {
+            return rhs != lhs + 1;
+        }) == targetGlobalIndices.end();
+
         // Selection map from proxy to member
         {
             SelectionMap selectionMapToTarget;
 
-            for (std::uint32_t pointIndex = 0; pointIndex < targetPoints->getNumPoints(); ++pointIndex)
-                selectionMapToTarget.getMap()[pointIndexOffset + pointIndex] = std::vector<std::uint32_t>({ targetGlobalIndices[pointIndex] });
+            if (hasContiguousIndices) {
+                selectionMapToTarget = SelectionMap(numberOfMemberPoints, pointIndexOffset, firstGlobalIndex);
+            }
+            else {
+                for (std::uint32_t pointIndex = 0; pointIndex < numberOfMemberPoints; ++pointIndex)
+                    selectionMapToTarget.getMap()[pointIndexOffset + pointIndex] = std::vector<std::uint32_t>({ targetGlobalIndices[pointIndex] });
+            }
 
             addLinkedData(targetPoints, selectionMapToTarget);
         }
@@ -613,8 +1305,13 @@ void Points::setProxyMembers(const Datasets& proxyMembers)
         {
             SelectionMap selectionMapToSource;
 
-            for (std::uint32_t pointIndex = 0; pointIndex < targetPoints->getNumPoints(); ++pointIndex)
-                selectionMapToSource.getMap()[targetGlobalIndices[pointIndex]] = std::vector<std::uint32_t>({ pointIndexOffset + pointIndex });
+            if (hasContiguousIndices) {
+                selectionMapToSource = SelectionMap(numberOfMemberPoints, firstGlobalIndex, pointIndexOffset);
+            }
+            else {
+                for (std::uint32_t pointIndex = 0; pointIndex < numberOfMemberPoints; ++pointIndex)
+                    selectionMapToSource.getMap()[targetGlobalIndices[pointIndex]] = std::vector<std::uint32_t>({ pointIndexOffset + pointIndex });
+            }
 
             targetPoints->addLinkedData(toSmartPointer(), selectionMapToSource);
 
@@ -643,120 +1340,457 @@ void Points::setProxyMembers(const Datasets& proxyMembers)
 /* -------------------------------------------------------------------------- */
 
 void Points::getGlobalIndices(std::vector<unsigned int>& globalIndices) const
+{
+    const auto globalIndexMap = getGlobalIndexMap();
+
+    globalIndices = globalIndexMap->getLocalToGlobal();
+}
+
+std::shared_ptr<const GlobalIndexMap> Points::getGlobalIndexMap() const
 {
     if (isProxy())
     {
-        globalIndices.resize(getNumPoints(), 0);
-        std::iota(globalIndices.begin(), globalIndices.end(), 0);
-        return;
-    }
+        const auto numberOfPoints = getNumPoints();
 
-    // Traverse the chain of datasets back to the original source data
-    // Any subsets traversed along the way are stored in the a subset chain
-    std::vector<Dataset<Points>> subsetChain;
-    {
-        auto currentDataset = toSmartPointer<Points>();
+        std::lock_guard<std::mutex> lock(_globalIndexMapMutex);
 
-        // Walk back in the chain of derived data until we find the original source
-        while (currentDataset->isDerivedData())
+        if (!_globalIndexMap || !_globalIndexMap->isIdentity() || _globalIndexMap->getNumberOfLocalIndices() != numberOfPoints)
         {
-            // If the current set is a subset then store it on the stack to traverse later
-            if (!currentDataset->isFull())
-                subsetChain.push_back(currentDataset);
+            std::vector<std::uint32_t> localToGlobal(numberOfPoints);
+            std::iota(localToGlobal.begin(), localToGlobal.end(), 0);
 
-            currentDataset = currentDataset->getNextSourceDataset<Points>();
+            _globalIndexMap = std::make_shared<const GlobalIndexMap>(std::move(localToGlobal), numberOfPoints, true);
+            _globalIndexMapSignature.clear();
         }
 
-        // We now have a non-derived dataset bound, push it if its also a subset
-        if (!currentDataset->isFull())
-            subsetChain.push_back(currentDataset);
+        return _globalIndexMap;
     }
 
+    const auto subsetChain  = getSubsetChain();
+    const auto signature    = getSubsetChainSignature(subsetChain);
+
+    std::lock_guard<std::mutex> lock(_globalIndexMapMutex);
+
+    if (_globalIndexMap && signature == _globalIndexMapSignature)
+        return _globalIndexMap;
+
     // Find the original global indices of this dataset by transforming them
     // step by step traversing through the chain of subsets
+    std::vector<std::uint32_t> localToGlobal(getNumPoints(), 0);
+    std::iota(localToGlobal.begin(), localToGlobal.end(), 0);
+
+    for (const Dataset<Points>& subset : subsetChain)
     {
-        globalIndices.resize(getNumPoints(), 0);
-        std::iota(globalIndices.begin(), globalIndices.end(), 0);
+        const auto& subsetIndices = subset->_indices;
 
-        for (const Dataset<Points>& subset : subsetChain)
-        {
-            for (int i = 0; i < globalIndices.size(); i++)
-                globalIndices[i] = subset->indices[globalIndices[i]];
-        }
+        for (auto& index : localToGlobal)
+            index = subsetIndices[index];
+    }
+
+    _globalIndexMap             = std::make_shared<const GlobalIndexMap>(std::move(localToGlobal), getSourceDataset<Points>()->getNumRawPoints(), subsetChain.empty());
+    _globalIndexMapSignature    = signature;
+
+    return _globalIndexMap;
+}
+
+const std::vector<unsigned int>& Points::getIndices() const
+{
+    return _indices;
+}
+
+void Points::setIndices(const std::vector<unsigned int>& indices)
+{
+    setIndices(std::vector<unsigned int>(indices));
+}
+
+void Points::setIndices(std::vector<unsigned int>&& indices)
+{
+    _indices = std::move(indices);
+
+    invalidateGlobalIndexMap();
+}
+
+void Points::invalidateGlobalIndexMap()
+{
+    // Datasets derived from this one include the version in their chain signature, so they are invalidated as well
+    _indicesVersion++;
+
+    {
+        std::lock_guard<std::mutex> lock(_globalIndexMapMutex);
+
+        _globalIndexMap.reset();
+        _globalIndexMapSignature.clear();
     }
+
+    releaseMaterializedSubset();
 }
 
-void Points::selectedLocalIndices(const std::vector<unsigned int>& selectionIndices, std::vector<bool>& selected) const
+void Points::setMaterializationPolicy(const MaterializationPolicy& materializationPolicy)
 {
-    //Timer timer(__FUNCTION__);
+    _materializationPolicy = materializationPolicy;
 
-    // Find the global indices of this dataset
-    std::vector<unsigned int> localGlobalIndices;
-    getGlobalIndices(localGlobalIndices);
+    if (materializationPolicy == MaterializationPolicy::Never)
+        releaseMaterializedSubset();
+}
 
+QByteArray Points::getContentHash() const
+{
+    // The content hash of a proxy is derived from the content hashes of its members
     if (isProxy()) {
-        selected.resize(getNumPoints(), false);
+        QCryptographicHash contentHash(QCryptographicHash::Sha256);
 
-        for (const auto& selectionIndex : selectionIndices) {
-            selected[localGlobalIndices[selectionIndex]] = true;
-        }
+        for (const auto& proxyMember : getProxyMembers())
+            contentHash.addData(Dataset<Points>(proxyMember)->getContentHash());
+
+        return contentHash.result();
+    }
+
+    std::lock_guard<std::mutex> lock(_contentHashMutex);
+
+    if (!_contentHash.isEmpty() && _contentHashIndicesVersion == _indicesVersion.load() && _contentHashDataVersion == _dataVersion.load())
+        return _contentHash;
+
+    // A data change while hashing makes the hash out of date (it is recomputed on the next request)
+    _contentHashDataVersion = _dataVersion.load();
+
+    if (isFull()) {
+        _contentHash = getRawData<PointData>()->computeContentHash();
     }
     else {
+        QCryptographicHash contentHash(QCryptographicHash::Sha256);
+
+        contentHash.addData(getFullDataset<Points>()->getContentHash());
+        contentHash.addData(DerivedDataCache::computeContentHash(_indices.data(), _indices.size() * sizeof(unsigned int)));
+
+        _contentHash = contentHash.result();
+    }
+
+    _contentHashIndicesVersion = _indicesVersion.load();
+
+    return _contentHash;
+}
+
+std::uint64_t Points::getDataVersion() const
+{
+    return _dataVersion;
+}
+
+std::uint64_t Points::getIndicesVersion() const
+{
+    return _indicesVersion;
+}
+
+mv::util::DualHistogram Points::getHistogram(std::uint32_t dimensionIndex, std::uint32_t numberOfBins, float minimum, float maximum) const
+{
+    const auto numberOfDimensions = getNumDimensions();
+
+    if (dimensionIndex >= numberOfDimensions)
+        throw std::out_of_range(QString("Dimension index %1 is out of range").arg(QString::number(dimensionIndex)).toStdString());
+
+    std::vector<std::uint32_t> selectionIndices;
+
+    getLocalSelectionIndices(selectionIndices);
+
+    // The histogram of all points remains valid as long as the data and the subset do not change
+    const std::vector<std::uint64_t> signature{
+        _dataVersion.load(),
+        _indicesVersion.load(),
+        getNumPoints(),
+        numberOfDimensions
+    };
+
+    const auto key = std::make_tuple(dimensionIndex, numberOfBins, minimum, maximum);
+
+    // Look up the cached histogram and the selection snapshot (the histograms are computed outside the lock)
+    std::optional<CachedHistogram> cachedHistogram;
+    SelectionSnapshot selectionSnapshot;
+
+    {
+        std::lock_guard<std::mutex> lock(_histogramsMutex);
+
+        if (const auto it = _histograms.find(key); it != _histograms.end() && it->second._signature == signature)
+            cachedHistogram = it->second;
+
+        selectionSnapshot = _histogramSelectionIndices;
+    }
+
+    // Share the snapshot with the other cached histograms when the selection did not change
+    if (!selectionSnapshot || *selectionSnapshot != selectionIndices)
+        selectionSnapshot = std::make_shared<const std::vector<std::uint32_t>>(std::move(selectionIndices));
+
+    auto histogram = constVisitFromBeginToEnd<mv::util::DualHistogram>([&](auto beginOfData, auto) -> mv::util::DualHistogram {
+        const auto isFull = this->isFull();
+
+        // Value of the dimension of a point (local index)
+        const auto valueFunction = [&](const std::size_t localIndex) -> float {
+            const auto index = isFull ? localIndex : std::size_t{ _indices[localIndex] };
+
+            return static_cast<float>(beginOfData[static_cast<std::ptrdiff_t>(index * numberOfDimensions + dimensionIndex)]);
+        };
+
+        if (!cachedHistogram) {
+            mv::util::DualHistogram computedHistogram(numberOfBins, minimum, maximum);
+
+            computedHistogram.compute(getNumPoints(), *selectionSnapshot, valueFunction);
+
+            return computedHistogram;
+        }
+
+        auto updatedHistogram = cachedHistogram->_histogram;
+
+        if (cachedHistogram->_selectionIndices != selectionSnapshot && *cachedHistogram->_selectionIndices != *selectionSnapshot)
+            updatedHistogram.updateSelection(*cachedHistogram->_selectionIndices, *selectionSnapshot, valueFunction);
+
+        return updatedHistogram;
+    });
+
+    std::lock_guard<std::mutex> lock(_histogramsMutex);
+
+    _histogramSelectionIndices  = selectionSnapshot;
+    _histograms[key]            = CachedHistogram{ histogram, selectionSnapshot, signature, ++_histogramStamp };
+
+    if (_histograms.size() > maximumNumberOfCachedHistograms) {
+        _histograms.erase(std::min_element(_histograms.begin(), _histograms.end(), [](const auto& lhs, const auto& rhs) -> bool {
+            return lhs.second._stamp < rhs.second._stamp;
+        }));
+    }
+
+    // Report the bins and the (shared) selection snapshots
+    std::uint64_t numberOfBytes = 0;
+    std::set<const std::vector<std::uint32_t>*> selectionSnapshots;
+
+    for (const auto& entry : _histograms) {
+        numberOfBytes += 2ull * entry.second._histogram.getAll().getNumberOfBins() * sizeof(std::uint32_t);
+
+        if (selectionSnapshots.insert(entry.second._selectionIndices.get()).second)
+            numberOfBytes += entry.second._selectionIndices->size() * sizeof(std::uint32_t);
+    }
+
+    MemoryAccounting::setAllocation(MemoryAccounting::Category::Cache, getHistogramsAllocationOwner(), numberOfBytes);
+
+    return histogram;
+}
+
+void Points::invalidateHistograms()
+{
+    std::lock_guard<std::mutex> lock(_histogramsMutex);
+
+    _histograms.clear();
+    _histogramSelectionIndices.reset();
+
+    MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getHistogramsAllocationOwner());
+}
+
+QString Points::getHistogramsAllocationOwner() const
+{
+    return QString("%1 histograms").arg(getId());
+}
+
+Points::MaterializationPolicy Points::getMaterializationPolicy() const
+{
+    return _materializationPolicy;
+}
+
+bool Points::isMaterialized() const
+{
+    std::lock_guard<std::mutex> lock(_materializedSubsetMutex);
+
+    return _materializedSubset != nullptr;
+}
+
+void Points::releaseMaterializedSubset()
+{
+    _numberOfVisits = 0;
+
+    std::lock_guard<std::mutex> lock(_materializedSubsetMutex);
+
+    if (!_materializedSubset)
+        return;
+
+    _materializedSubset.reset();
+    _materializedSubsetSignature.clear();
+
+    MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getId());
+}
+
+std::shared_ptr<const PointData::GatheredPoints> Points::getMaterializedSubset() const
+{
+    const auto materializationPolicy = _materializationPolicy.load();
+
+    if (materializationPolicy == MaterializationPolicy::Never || isFull() || isProxy())
+        return nullptr;
+
+    const auto numberOfVisits   = ++_numberOfVisits;
+    const auto rawData          = getRawData<PointData>();
+
+    // The subset indices (set or explicitly invalidated) and the size of the point data determine the signature
+    const std::vector<std::uint64_t> signature{
+        _indicesVersion.load(),
+        rawData->getNumberOfElements()
+    };
+
+    std::lock_guard<std::mutex> lock(_materializedSubsetMutex);
+
+    if (_materializedSubset && signature == _materializedSubsetSignature)
+        return _materializedSubset;
+
+    if (materializationPolicy == MaterializationPolicy::Automatic && numberOfVisits < materializationVisitThreshold)
+        return nullptr;
+
+    // Fall back to visiting the subset through its indices when the gathered rows would exceed the memory budget
+    const auto numberOfBytes    = static_cast<std::uint64_t>(_indices.size()) * rawData->getNumDimensions() * (rawData->getRawDataSize() / std::max<std::uint64_t>(rawData->getNumberOfElements(), 1));
+    const auto memoryBudget     = _memoryBudget.load();
+    const auto previousBytes    = _materializedSubset ? _materializedSubset->getNumberOfBytes() : 0;
+
+    if (memoryBudget > 0 && MemoryAccounting::getNumberOfHostBytes() - previousBytes + numberOfBytes > memoryBudget)
+    {
+        _materializedSubset.reset();
+        _materializedSubsetSignature.clear();
+
+        MemoryAccounting::removeAllocation(MemoryAccounting::Category::Cache, getId());
+
+        return nullptr;
+    }
+
+    _materializedSubset             = rawData->gatherPoints(_indices);
+    _materializedSubsetSignature    = signature;
+
+    MemoryAccounting::setAllocation(MemoryAccounting::Category::Cache, getId(), _materializedSubset ? _materializedSubset->getNumberOfBytes() : 0);
+
+    return _materializedSubset;
+}
+
+std::vector<Dataset<Points>> Points::getSubsetChain() const
+{
+    // Traverse the chain of datasets back to the original source data
+    // Any subsets traversed along the way are stored in the a subset chain
+    std::vector<Dataset<Points>> subsetChain;
+
+    auto currentDataset = toSmartPointer<Points>();
+
+    // Walk back in the chain of derived data until we find the original source
+    while (currentDataset->isDerivedData())
+    {
+        // If the current set is a subset then store it on the stack to traverse later
+        if (!currentDataset->isFull())
+            subsetChain.push_back(currentDataset);
+
+        currentDataset = currentDataset->getNextSourceDataset<Points>();
+    }
+
+    // We now have a non-derived dataset bound, push it if its also a subset
+    if (!currentDataset->isFull())
+        subsetChain.push_back(currentDataset);
+
+    return subsetChain;
+}
+
+std::vector<std::uint64_t> Points::getSubsetChainSignature(const std::vector<Dataset<Points>>& subsetChain) const
+{
+    std::vector<std::uint64_t> signature;
+
+    signature.reserve(2 + 2 * subsetChain.size());
+
+    signature.push_back(getNumPoints());
+    signature.push_back(getSourceDataset<Points>()->getNumRawPoints());
+
+    // Subset indices that are set or explicitly invalidated change the signature
+    for (const Dataset<Points>& subset : subsetChain)
+    {
+        signature.push_back(reinterpret_cast<std::uintptr_t>(subset.get()));
+        signature.push_back(subset->_indicesVersion.load());
+    }
+
+    return signature;
+}
+
+void Points::selectedLocalIndices(const std::vector<unsigned int>& selectionIndices, std::vector<bool>& selected) const
+{
+    MV_TRACE_SCOPE("data", "Points::selectedLocalIndices");
+
+    const auto globalIndexMap = getGlobalIndexMap();
+
+    selected.assign(globalIndexMap->getNumberOfLocalIndices(), false);
+
+    // When several local points share a global index, all of them have to be visited
+    if (globalIndexMap->hasDuplicates())
+    {
         // In an array the size of the full raw data, mark selected points as true
-        std::vector<bool> globalSelection(getSourceDataset<Points>()->getNumRawPoints(), false);
+        std::vector<bool> globalSelection(globalIndexMap->getNumberOfGlobalIndices(), false);
 
         for (const unsigned int& selectionIndex : selectionIndices)
             globalSelection[selectionIndex] = true;
 
         // For all local points find out which are selected
-        selected.resize(localGlobalIndices.size(), false);
-        for (int i = 0; i < localGlobalIndices.size(); i++)
+        const auto& localGlobalIndices = globalIndexMap->getLocalToGlobal();
+
+        for (std::size_t i = 0; i < localGlobalIndices.size(); i++)
         {
             if (globalSelection[localGlobalIndices[i]])
                 selected[i] = true;
         }
+
+        return;
+    }
+
+    for (const auto& selectionIndex : selectionIndices)
+    {
+        const auto localIndex = globalIndexMap->getLocalIndex(selectionIndex);
+
+        if (localIndex >= 0)
+            selected[localIndex] = true;
     }
 }
 
 void Points::getLocalSelectionIndices(std::vector<unsigned int>& localSelectionIndices) const
 {
+    auto selection = getSelection<Points>();
+
+    // The selection of a proxy is expressed in its own (local) indices already, so it only needs to be brought in ascending order
     if (isProxy())
     {
-        localSelectionIndices = getSelection<Points>()->indices;
+        localSelectionIndices.assign(selection->_indices.begin(), selection->_indices.end());
+
+        if (!std::is_sorted(localSelectionIndices.begin(), localSelectionIndices.end()))
+            std::sort(localSelectionIndices.begin(), localSelectionIndices.end());
+
+        localSelectionIndices.erase(std::unique(localSelectionIndices.begin(), localSelectionIndices.end()), localSelectionIndices.end());
+
         return;
     }
 
+    const auto globalIndexMap = getGlobalIndexMap();
 
-    auto selection = getSelection<Points>();
+    localSelectionIndices.clear();
 
-    // Find the global indices of this dataset
-    std::vector<unsigned int> localGlobalIndices;
-    getGlobalIndices(localGlobalIndices);
+    if (globalIndexMap->hasDuplicates())
+    {
+        std::vector<bool> selected;
 
-    // In an array the size of the full raw data, mark selected points as true
-    std::vector<bool> globalSelection(getSourceDataset<Points>()->getNumRawPoints(), false);
-    for (const unsigned int& selectionIndex : selection->indices)
-        globalSelection[selectionIndex] = true;
+        selectedLocalIndices(selection->_indices, selected);
 
-    // For all local points find out which are selected
-    std::vector<bool> selected(localGlobalIndices.size(), false);
-    int indexCount = 0;
-    for (int i = 0; i < localGlobalIndices.size(); i++)
-    {
-        if (globalSelection[localGlobalIndices[i]])
+        for (std::uint32_t i = 0; i < selected.size(); i++)
         {
-            selected[i] = true;
-            indexCount++;
+            if (selected[i])
+                localSelectionIndices.push_back(i);
         }
+
+        return;
     }
 
-    localSelectionIndices.resize(indexCount);
-    int c = 0;
-    for (int i = 0; i < selected.size(); i++)
+    localSelectionIndices.reserve(std::min<std::size_t>(selection->_indices.size(), globalIndexMap->getNumberOfLocalIndices()));
+
+    for (const auto& selectionIndex : selection->_indices)
     {
-        if (selected[i])
-            localSelectionIndices[c++] = i;
+        const auto localIndex = globalIndexMap->getLocalIndex(selectionIndex);
+
+        if (localIndex >= 0)
+            localSelectionIndices.push_back(static_cast<unsigned int>(localIndex));
     }
+
+    // Local selection indices are in ascending order
+    std::sort(localSelectionIndices.begin(), localSelectionIndices.end());
+    localSelectionIndices.erase(std::unique(localSelectionIndices.begin(), localSelectionIndices.end()), localSelectionIndices.end());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -790,7 +1824,17 @@ DimensionsPickerAction& Points::getDimensionsPickerAction()
 
 std::vector<std::uint32_t>& Points::getSelectionIndices()
 {
-    return getSelection<Points>()->indices;
+    auto selection = getSelection<Points>();
+
+    // The indices might be edited through the returned reference, so the caches keyed by them are invalidated up front
+    selection->invalidateGlobalIndexMap();
+
+    return selection->_indices;
+}
+
+const std::vector<std::uint32_t>& Points::getSelectionIndices() const
+{
+    return getSelection<Points>()->_indices;
 }
 
 const std::vector<QString>& Points::getDimensionNames() const
@@ -817,6 +1861,8 @@ float Points::getValueAt(const std::size_t index) const
 
 void Points::setValueAt(const std::size_t index, const float newValue)
 {
+    releaseMaterializedSubset();
+
     getRawData<PointData>()->setValueAt(index, newValue);
 }
 
@@ -841,40 +1887,42 @@ static void resolveLinkedPointData(const LinkedData& linkedData, const std::vect
     //qDebug() << QString("%1, %2, %3").arg(__FUNCTION__, sourceDataset->getGuiName(), targetDataset->getGuiName());
 
     {
-        //Timer timer("Creating maps");
+        MV_TRACE_SCOPE_DETAIL("selection", "Resolve linked point data", targetDataset->getGuiName());
 
         const SelectionMap& mapping = linkedData.getMapping();
 
-        // Create separate vector of additional linked selected points
-        std::vector<unsigned int> linkedIndices;
-
-        // Reserve at least as much space as required for a 1-1 mapping
-        linkedIndices.reserve(indices.size());
+        // Map the selection in one batch (sorted and unique)
+        std::vector<std::uint32_t> linkedIndices;
 
-        for (const auto& selectionIndex : indices)
-        {
-            if (mapping.hasMappingForPointIndex(selectionIndex))
-            {
-                std::vector<std::uint32_t> mappedSelection;
-                mapping.populateMappingIndices(selectionIndex, mappedSelection);
-                linkedIndices.insert(linkedIndices.end(), mappedSelection.begin(), mappedSelection.end());
-            }
-        }
+        mapping.mapIndices(indices, linkedIndices);
 
         if (targetDataset->isProxy()) {
-            std::set<std::uint32_t> targetIndicesSet(targetSelection->indices.begin(), targetSelection->indices.end());
 
-            for (auto& [key, value] : const_cast<SelectionMap&>(mapping).getMap())
-                for (const auto& v : value)
-                    targetIndicesSet.erase(v);
+            // Replace the part of the proxy selection which is covered by the mapping with the linked indices
+            std::vector<std::uint32_t> mappingTargetIndices, targetIndices, unaffectedTargetIndices;
 
-            for (const auto& linkedIndex : linkedIndices)
-                targetIndicesSet.insert(linkedIndex);
+            mapping.populateTargetIndices(mappingTargetIndices);
 
-            targetSelection->indices = std::vector<std::uint32_t>(targetIndicesSet.begin(), targetIndicesSet.end());
+            targetIndices = targetSelection->getIndices();
+
+            if (!std::is_sorted(targetIndices.begin(), targetIndices.end()))
+                std::sort(targetIndices.begin(), targetIndices.end());
+
+            targetIndices.erase(std::unique(targetIndices.begin(), targetIndices.end()), targetIndices.end());
+
+            unaffectedTargetIndices.reserve(targetIndices.size());
+
+            std::set_difference(targetIndices.begin(), targetIndices.end(), mappingTargetIndices.begin(), mappingTargetIndices.end(), std::back_inserter(unaffectedTargetIndices));
+
+            targetIndices.clear();
+            targetIndices.reserve(unaffectedTargetIndices.size() + linkedIndices.size());
+
+            std::set_union(unaffectedTargetIndices.begin(), unaffectedTargetIndices.end(), linkedIndices.begin(), linkedIndices.end(), std::back_inserter(targetIndices));
+
+            targetSelection->setIndices(std::move(targetIndices));
         }
         else {
-            targetSelection->indices = linkedIndices;
+            targetSelection->setIndices(std::move(linkedIndices));
         }
     }
     
@@ -884,7 +1932,7 @@ static void resolveLinkedPointData(const LinkedData& linkedData, const std::vect
 
     // Recursively resolve linked point data
     for (const mv::LinkedData& targetLd : targetDataset->getLinkedData())
-        resolveLinkedPointData(targetLd, targetSelection->indices, ignoreDatasets);
+        resolveLinkedPointData(targetLd, targetSelection->getIndices(), ignoreDatasets);
 }
 
 void Points::resolveLinkedData(bool force /*= false*/)
@@ -892,9 +1940,11 @@ void Points::resolveLinkedData(bool force /*= false*/)
     if (isLocked())
         return;
 
+    MV_TRACE_SCOPE_DETAIL("selection", "Resolve linked data", getGuiName());
+
     // Check for linked data in this dataset and resolve them
     for (const mv::LinkedData& linkedData : getLinkedData())
-        resolveLinkedPointData(linkedData, getSelection<Points>()->indices, nullptr);
+        resolveLinkedPointData(linkedData, getSelection<Points>()->_indices, nullptr);
 
     // Check for linked data in all source datasets and resolve them
     // This and all source data share the same selection indices
@@ -906,7 +1956,7 @@ void Points::resolveLinkedData(bool force /*= false*/)
         if (dataset.isValid())
         {
             for (const mv::LinkedData& linkedData : dataset->getLinkedData())
-                resolveLinkedPointData(linkedData, getSelection<Points>()->indices, nullptr);
+                resolveLinkedPointData(linkedData, getSelection<Points>()->_indices, nullptr);
 
         }
         else
@@ -916,15 +1966,25 @@ void Points::resolveLinkedData(bool force /*= false*/)
 }
 
 void Points::setSelectionIndices(const std::vector<std::uint32_t>& indices)
+{
+    if (isLocked())
+        return;
+
+    setSelectionIndices(std::vector<std::uint32_t>(indices));
+}
+
+void Points::setSelectionIndices(std::vector<std::uint32_t>&& indices)
 {
     //qDebug() << QString("%1, %2").arg(__FUNCTION__, getGuiName());
 
     if (isLocked())
         return;
 
+    MV_TRACE_SCOPE_DETAIL("selection", "Set selection indices", getGuiName());
+
     auto selection = getSelection<Points>();
 
-    selection->indices = indices;
+    selection->setIndices(std::move(indices));
 
     resolveLinkedData();
 
@@ -943,7 +2003,7 @@ bool Points::canSelectAll() const
 
 bool Points::canSelectNone() const
 {
-    return getSelection<Points>()->indices.size() >= 1;
+    return getSelection<Points>()->_indices.size() >= 1;
 }
 
 bool Points::canSelectInvert() const
@@ -955,14 +2015,16 @@ void Points::selectAll()
 {
     std::vector<unsigned int> selectionIndices;
 
-    selectionIndices.resize(getNumPoints());
+    if (isFull()) {
+        selectionIndices.resize(getNumPoints());
 
-    if (isFull())
         std::iota(selectionIndices.begin(), selectionIndices.end(), 0);
-    else
-        selectionIndices = indices;
+    }
+    else {
+        selectionIndices = _indices;
+    }
 
-    setSelectionIndices(selectionIndices);
+    setSelectionIndices(std::move(selectionIndices));
 
     events().notifyDatasetDataSelectionChanged(this);
 }
@@ -980,27 +2042,28 @@ void Points::selectInvert()
     std::vector<unsigned int> localSelectionIndices;
     getLocalSelectionIndices(localSelectionIndices);
 
+    const auto globalIndexMap = getGlobalIndexMap();
+
     // Compute the inverse of this
-    const auto numberOfPoints = getNumPoints();
-    std::set<std::uint32_t> selectionSet(localSelectionIndices.begin(), localSelectionIndices.end());
+    const auto numberOfPoints = globalIndexMap->getNumberOfLocalIndices();
 
-    std::vector<unsigned int> selectionIndices;
-    selectionIndices.reserve(numberOfPoints - selectionSet.size());
+    std::vector<bool> selected(numberOfPoints, false);
 
-    for (std::uint32_t i = 0; i < numberOfPoints; i++)
-        if (selectionSet.find(i) == selectionSet.end())
-            selectionIndices.push_back(i);
+    for (const auto& localSelectionIndex : localSelectionIndices)
+        if (localSelectionIndex < numberOfPoints)
+            selected[localSelectionIndex] = true;
+
+    std::vector<unsigned int> selectionIndices;
+    selectionIndices.reserve(numberOfPoints - std::min<std::size_t>(localSelectionIndices.size(), numberOfPoints));
 
     // Convert the inverted indices back to global indices
-    std::vector<unsigned int> globalIndices;
-    getGlobalIndices(globalIndices);
+    const auto& globalIndices = globalIndexMap->getLocalToGlobal();
 
-    for (unsigned int& index : selectionIndices)
-    {
-        index = globalIndices[index];
-    }
+    for (std::uint32_t i = 0; i < numberOfPoints; i++)
+        if (!selected[i])
+            selectionIndices.push_back(globalIndices[i]);
 
-    setSelectionIndices(selectionIndices);
+    setSelectionIndices(std::move(selectionIndices));
 
     events().notifyDatasetDataSelectionChanged(this);
 }
@@ -1031,9 +2094,11 @@ void Points::fromVariantMap(const QVariantMap& variantMap)
     
         const auto& indicesMap = variantMap["Indices"].toMap();
     
-        indices.resize(indicesMap["Count"].toInt());
+        std::vector<unsigned int> indices(indicesMap["Count"].toInt());
     
         populateDataBufferFromVariantMap(indicesMap["Raw"].toMap(), (char*)indices.data());
+
+        setIndices(std::move(indices));
     }
 
     // Load dimension names
@@ -1082,8 +2147,24 @@ void Points::fromVariantMap(const QVariantMap& variantMap)
         _dimensionsPickerAction->fromParentVariantMap(variantMap);
     }
 
+    if (variantMap.contains("MaterializationPolicy"))
+        setMaterializationPolicy(static_cast<MaterializationPolicy>(variantMap["MaterializationPolicy"].toInt()));
+
+    // The data changed notification below increments the data version once, any other increment means that the data
+    // changed after it was loaded (e.g. by a listener of the notification) and the saved content hash no longer applies
+    const auto loadedDataVersion = _dataVersion.load() + 1;
+
     events().notifyDatasetDataChanged(this);
 
+    // Adopt the content hash which was computed when the project was saved, so that derived data can be looked up right away
+    if (isFull() && variantMap.contains("ContentHash")) {
+        std::lock_guard<std::mutex> lock(_contentHashMutex);
+
+        _contentHash                = QByteArray::fromHex(variantMap["ContentHash"].toString().toLatin1());
+        _contentHashIndicesVersion  = _indicesVersion.load();
+        _contentHashDataVersion     = loadedDataVersion;
+    }
+
     // Handle saved selection
     if (isFull()) {
         const auto& selectionMap = variantMap["Selection"].toMap();
@@ -1093,9 +2174,11 @@ void Points::fromVariantMap(const QVariantMap& variantMap)
         if (count > 0) {
             auto selectionSet = getSelection<Points>();
 
-            selectionSet->indices.resize(count);
+            std::vector<unsigned int> selectionIndices(count);
+
+            populateDataBufferFromVariantMap(selectionMap["Raw"].toMap(), (char*)selectionIndices.data());
 
-            populateDataBufferFromVariantMap(selectionMap["Raw"].toMap(), (char*)selectionSet->indices.data());
+            selectionSet->setIndices(std::move(selectionIndices));
 
             events().notifyDatasetDataSelectionChanged(this);
         }
@@ -1124,16 +2207,16 @@ QVariantMap Points::toVariantMap() const
 
     QVariantMap indices;
 
-    indices["Count"]    = QVariant::fromValue(this->indices.size());
-    indices["Raw"]      = rawDataToVariantMap((char*)this->indices.data(), this->indices.size() * sizeof(std::uint32_t), true);
+    indices["Count"]    = QVariant::fromValue(_indices.size());
+    indices["Raw"]      = rawDataToVariantMap((char*)_indices.data(), _indices.size() * sizeof(std::uint32_t), true);
 
     QVariantMap selection;
 
     if (isFull()) {
         auto selectionSet = getSelection<Points>();
 
-        selection["Count"]  = QVariant::fromValue(selectionSet->indices.size());
-        selection["Raw"]    = rawDataToVariantMap((char*)selectionSet->indices.data(), selectionSet->indices.size() * sizeof(std::uint32_t), true);
+        selection["Count"]  = QVariant::fromValue(selectionSet->_indices.size());
+        selection["Raw"]    = rawDataToVariantMap((char*)selectionSet->_indices.data(), selectionSet->_indices.size() * sizeof(std::uint32_t), true);
     }
 
     variantMap["Data"]                  = isFull() ? getRawData<PointData>()->toVariantMap() : QVariantMap();
@@ -1145,10 +2228,15 @@ QVariantMap Points::toVariantMap() const
     variantMap["Dimensions"]            = _dimensionsPickerAction->toVariantMap();
 
     variantMap["Dense"]                 = Experimental::isDense(this);
+    variantMap["MaterializationPolicy"] = static_cast<std::int32_t>(getMaterializationPolicy());
 
     if (!Experimental::isDense(this))
         variantMap["NumberOfNonZeroElements"] = QVariant::fromValue(Experimental::getNumNonZeroElements(this));
-    
+
+    // Saved so that the content hash is known right away when the project is reopened
+    if (isFull())
+        variantMap["ContentHash"] = QString::fromLatin1(getContentHash().toHex());
+
     return variantMap;
 }
 
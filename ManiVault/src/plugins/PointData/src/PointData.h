@@ -8,13 +8,20 @@
 
 #include "RawData.h"
 
+#include "DequantizingIterator.h"
+#include "GlobalIndexMap.h"
 #include "LinkedData.h"
+#include "PointDataBuffer.h"
+#include "PointDataQuantization.h"
 #include "PointDataRange.h"
 #include "Set.h"
 #include "SparseMatrix.h"
 
 #include "event/EventListener.h"
 
+#include "util/DualHistogram.h"
+#include "util/Spillable.h"
+
 #include <biovault_bfloat16/biovault_bfloat16.h>
 
 #include <QDebug>
@@ -22,8 +29,18 @@
 #include <QString>
 #include <QVariant>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -54,7 +71,28 @@ class ClusterAction;
 // Raw Data
 // =============================================================================
 
-class POINTDATA_EXPORT PointData : public mv::plugin::RawData
+/**
+ * Point data class
+ *
+ * Dense point data may be spilled to disk by the memory manager when the memory budget is exceeded (see
+ * mv::util::Spillable), all accessors of the data vector reload spilled data transparently. The visitors, populate
+ * and extract functions pin the data for the duration of the access. Pointers which are handed out by
+ * getDataVoidPtr() may be kept indefinitely, so the data is no longer spilled until it is replaced. Pin the point
+ * data (mv::util::Spillable::Pin) when iterators of a visit are kept beyond the visit.
+ *
+ * Dense float data may be quantized per dimension (see PointData::quantize()), in which case the data vector holds
+ * int8 or uint16 codes. The element type of quantized data remains float32 (the type of the values), the codes are
+ * only handed out explicitly (see PointData::getStorageElementType() and PointData::getStorageConstVoidPtr()), and
+ * PointData::getDataConstVoidPtr() rejects quantized data. The read-only accessors (constant visitors, populate and
+ * extract functions, getValueAt) reconstruct the values on the fly and keep the data quantized. The mutable accessors
+ * restore float storage first (see PointData::dequantize()), which permanently undoes the compaction: the non-const
+ * visitFromBeginToEnd and Points::visitData, getDataVoidPtr, setValueAt, setData(nullptr, ...) and
+ * commitAppendedPoints.
+ *
+ * Externally owned data (e.g. a memory-mapped file or an array of a foreign runtime) may be adopted without copying
+ * it (see PointData::adoptData() and PointData::adoptSharedData()), all accessors work unchanged on adopted data.
+ */
+class POINTDATA_EXPORT PointData : public mv::plugin::RawData, public mv::util::Spillable
 {
 public:
     enum class ElementTypeSpecifier
@@ -70,15 +108,16 @@ public:
     };
 
 private:
+    // Each alternative either owns its elements or adopts externally owned memory (see PointDataBuffer).
     using VariantOfVectors = std::variant <
-        std::vector<float>,
-        std::vector<biovault::bfloat16_t>,
-        std::vector<std::int32_t>,
-        std::vector<std::uint32_t>,
-        std::vector<std::int16_t>,
-        std::vector<std::uint16_t>,
-        std::vector<std::int8_t>,
-        std::vector<std::uint8_t> >;
+        PointDataBuffer<float>,
+        PointDataBuffer<biovault::bfloat16_t>,
+        PointDataBuffer<std::int32_t>,
+        PointDataBuffer<std::uint32_t>,
+        PointDataBuffer<std::int16_t>,
+        PointDataBuffer<std::uint16_t>,
+        PointDataBuffer<std::int8_t>,
+        PointDataBuffer<std::uint8_t> >;
 
     // Sets the index of the specified variant. If the new index is different from the previous one, the value will be reset. 
     // Inspired by `expand_type` from kmbeutel at
@@ -116,44 +155,64 @@ private:
     template <typename T>
     static constexpr ElementTypeSpecifier getElementTypeSpecifier()
     {
-        constexpr auto index = getIndexOfVariantAlternative<VariantOfVectors, std::vector<T>>();
+        constexpr auto index = getIndexOfVariantAlternative<VariantOfVectors, PointDataBuffer<T>>();
         return static_cast<ElementTypeSpecifier>(index);
     }
 
+    // The reference is only valid while the data is pinned (see pinResident()), the caller pins the data.
     template <typename T>
-    const std::vector<T>& getConstVector() const
+    const PointDataBuffer<T>& getConstVector() const
     {
+        assert(isPinned());
+
+        touch();
+
         // This function should only be used to access the currently selected vector.
-        assert(std::holds_alternative<std::vector<T>>(_variantOfVectors));
-        return std::get<std::vector<T>>(_variantOfVectors);
+        assert(std::holds_alternative<PointDataBuffer<T>>(_variantOfVectors));
+        return std::get<PointDataBuffer<T>>(_variantOfVectors);
     }
 
     template <typename T>
-    const std::vector<T>& getVector() const
+    const PointDataBuffer<T>& getVector() const
     {
         return getConstVector<T>();
     }
 
     template <typename T>
-    std::vector<T>& getVector()
+    PointDataBuffer<T>& getVector()
     {
-        return const_cast<std::vector<T>&>(getConstVector<T>());
+        dequantize();
+
+        return const_cast<PointDataBuffer<T>&>(getConstVector<T>());
     }
 
     /// Returns the size of the std::vector currently held by _variantOfVectors.
     std::size_t getSizeOfVector() const
     {
+        if (_isSpilled.load(std::memory_order_acquire))
+            return _numberOfSpilledElements;
+
         return std::visit([](const auto& vec) { return vec.size(); }, _variantOfVectors);
     }
 
     /// Resizes the std::vector currently held by _variantOfVectors.
     void resizeVector(const std::size_t newSize)
     {
+        dequantize();
+
+        const auto pin = pinResident();
+
         std::visit([newSize](auto& vec) { vec.resize(newSize); }, _variantOfVectors);
     }
 
     void setElementTypeSpecifier(const ElementTypeSpecifier elementTypeSpecifier)
     {
+        if (static_cast<std::size_t>(elementTypeSpecifier) != _variantOfVectors.index()) {
+            discardSpill();
+
+            _quantization = {};
+        }
+
         setIndexOfVariant(_variantOfVectors, static_cast<std::size_t>(elementTypeSpecifier));
     }
 
@@ -168,6 +227,10 @@ private:
     template <typename T>
     void convertData(const T* const data, const std::size_t numberOfElements)
     {
+        discardSpill();
+
+        _quantization = {};
+
         std::visit([data, numberOfElements](auto& vec)
         {
             vec.resize(numberOfElements);
@@ -225,11 +288,22 @@ public:
     std::uint64_t getRawDataSize() const override;
 
     /**
-     *Returns void pointer to the underlying array serving as element storage.
+     *Returns void pointer to the underlying array serving as element storage, the elements are of getElementType().
+     * The non-const overload restores float storage of quantized data first (undoing the compaction), the const overload
+     * throws std::runtime_error for quantized data (see getStorageConstVoidPtr()).
+     * The pointer may be kept indefinitely, so the data is no longer spilled to disk until it is replaced (e.g. by setData).
      */
     void* getDataVoidPtr();
     const void* getDataConstVoidPtr() const;
 
+    /**
+     * Get a pointer to the elements of the data vector as they are stored, the elements are of getStorageElementType()
+     * (the quantization codes when the data is quantized, see getQuantization()). Like getDataConstVoidPtr(), the data
+     * is no longer spilled to disk until it is replaced.
+     * @return Pointer to the stored elements
+     */
+    const void* getStorageConstVoidPtr() const;
+
     static constexpr std::array<const char*, std::variant_size_v<VariantOfVectors>> getElementTypeNames()
     {
         return
@@ -246,20 +320,24 @@ public:
     }
 
     // Similar to C++17 std::visit.
+    // Quantized data is visited with iterators which yield the reconstructed (float) values.
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType constVisitFromBeginToEnd(FunctionObject functionObject) const
     {
-        return std::visit([functionObject](const auto& vec) -> ReturnType
-            {
-                return functionObject(std::cbegin(vec), std::cend(vec));
-            },
-            _variantOfVectors);
+        const auto pin = pinResident();
+
+        return constVisitVariantOfVectors<ReturnType>(_variantOfVectors, _quantization, functionObject);
     }
 
     // Similar to C++17 std::visit.
+    // Quantized data is restored to float storage first, because the function object may modify the values.
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType visitFromBeginToEnd(FunctionObject functionObject)
     {
+        dequantize();
+
+        const auto pin = pinResident();
+
         return std::visit([functionObject](auto& vec) -> ReturnType
             {
                 return functionObject(std::begin(vec), std::end(vec));
@@ -275,8 +353,22 @@ public:
     void populateFullDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices) const
     {
         CheckDimensionIndices(dimensionIndices);
+
+        const auto pin = pinResident();
+
         std::visit([&resultContainer, this, &dimensionIndices](const auto& vec)
             {
+                using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+                if constexpr (PointDataQuantization::isCodeType<CodeType>)
+                {
+                    if (_quantization.isEnabled())
+                    {
+                        _quantization.dequantizeDimensions(vec.data(), dimensionIndices, getNumPoints(), [](const std::size_t pointIndex) { return pointIndex; }, resultContainer);
+                        return;
+                    }
+                }
+
                 const std::ptrdiff_t numPoints{ getNumPoints() };
                 std::ptrdiff_t resultIndex{};
 
@@ -299,8 +391,21 @@ public:
     {
         CheckDimensionIndices(dimensionIndices);
 
+        const auto pin = pinResident();
+
         std::visit([&resultContainer, this, &dimensionIndices, &indices](const auto& vec)
             {
+                using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+                if constexpr (PointDataQuantization::isCodeType<CodeType>)
+                {
+                    if (_quantization.isEnabled())
+                    {
+                        _quantization.dequantizeDimensions(vec.data(), dimensionIndices, indices.size(), [&indices](const std::size_t pointIndex) { return indices[pointIndex]; }, resultContainer);
+                        return;
+                    }
+                }
+
                 const std::ptrdiff_t numPoints{ static_cast<std::uint32_t>(indices.size()) };
                 std::ptrdiff_t resultIndex{};
 
@@ -326,13 +431,24 @@ public:
         return getElementTypeNames().size();
     }
 
+    /// Returns the type of the values, which is float32 for quantized data (see getStorageElementType()).
     ElementTypeSpecifier getElementType() const
+    {
+        return _quantization.isEnabled() ? ElementTypeSpecifier::float32 : getElementTypeSpecifier();
+    }
+
+    /// Returns the type of the elements of the data vector, which is the code type (int8 or uint16) for quantized data.
+    ElementTypeSpecifier getStorageElementType() const
     {
         return getElementTypeSpecifier();
     }
 
     void setElementType(const ElementTypeSpecifier elementTypSpecifier)
     {
+        // Quantized data already has float32 values, resetting the data vector would discard them
+        if (elementTypSpecifier == getElementType())
+            return;
+
         setElementTypeSpecifier(elementTypSpecifier);
     }
 
@@ -371,6 +487,8 @@ public:
     template <typename T>
     void setData(const T* const data, const std::size_t numPoints, const std::size_t numDimensions)
     {
+         discardSpill();
+         _quantization = {};
          _variantOfVectors = VariantOfVectors( std::vector<T>(data, data + numPoints * numDimensions) );
          _numDimensions = static_cast<std::uint32_t>(numDimensions);
     }
@@ -386,6 +504,8 @@ public:
     template <typename T>
     void setData(const std::vector<T>& data, const std::size_t numDimensions)
     {
+        discardSpill();
+        _quantization = {};
         _variantOfVectors = VariantOfVectors(data);
         _numDimensions = static_cast<unsigned int>(numDimensions);
     }
@@ -396,10 +516,92 @@ public:
     template <typename T>
     void setData(std::vector<T>&& data, const std::size_t numDimensions)
     {
+        discardSpill();
+        _quantization = {};
         _variantOfVectors = VariantOfVectors(std::move(data));
         _numDimensions = static_cast<unsigned int>(numDimensions);
     }
 
+    /// Adopts the specified externally owned data without copying it, sets the
+    /// number of dimensions as specified, and sets the selected internal data
+    /// type according to the specified data type T. The data is modified in
+    /// place, and released by invoking the deleter on it when the point data
+    /// no longer references it (e.g. after the next setData).
+    template <typename T, typename Deleter>
+    void adoptData(T* const data, const std::size_t numPoints, const std::size_t numDimensions, Deleter deleter)
+    {
+        std::shared_ptr<T> owner(data, std::move(deleter));
+
+        adoptBuffer(PointDataBuffer<T>(data, numPoints * numDimensions, std::move(owner), true), numDimensions);
+    }
+
+    /// Adopts the specified read-only data (e.g. a memory-mapped file) without
+    /// copying it, sets the number of dimensions as specified, and sets the
+    /// selected internal data type according to the specified data type T.
+    /// The owner keeps the data alive for as long as the point data references
+    /// it, the data is copied on the first mutable access.
+    template <typename T>
+    void adoptSharedData(const T* const data, const std::size_t numPoints, const std::size_t numDimensions, std::shared_ptr<const void> owner)
+    {
+        if (!owner)
+            throw std::runtime_error("Unable to adopt point data without an owner");
+
+        adoptBuffer(PointDataBuffer<T>(data, numPoints * numDimensions, std::move(owner), false), numDimensions);
+    }
+
+    /// Returns whether the data is adopted (externally owned) rather than owned.
+    bool isAdopted() const;
+
+    /// Starts streaming ingestion: clears the data, sets the number of
+    /// dimensions as specified, sets the selected internal data type according
+    /// to the specified data type T, and reserves memory for the expected
+    /// number of points (more points may be appended).
+    template <typename T>
+    void reservePoints(const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        discardSpill();
+        _quantization = {};
+
+        {
+            std::lock_guard<std::mutex> lock(_appendMutex);
+
+            _appendedChunks.clear();
+        }
+
+        PointDataBuffer<T> buffer;
+
+        buffer.reserve(numPoints * numDimensions);
+
+        _variantOfVectors = VariantOfVectors(std::move(buffer));
+        _numDimensions = static_cast<unsigned int>(numDimensions);
+    }
+
+    /// Appends the specified chunk of points (row-major, of the data type
+    /// passed to reservePoints) without copying it. Thread-safe, so that
+    /// worker threads may append chunks concurrently. The points become part
+    /// of the data at the next commitAppendedPoints.
+    template <typename T>
+    void appendPoints(std::vector<T>&& points)
+    {
+        std::lock_guard<std::mutex> lock(_appendMutex);
+
+        _appendedChunks.emplace_back(std::move(points));
+    }
+
+    /// Copies and appends the specified points (see above).
+    template <typename T>
+    void appendPoints(const T* const data, const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        appendPoints(std::vector<T>(data, data + numPoints * numDimensions));
+    }
+
+    /// Moves the appended points into the data, in the order in which they
+    /// were appended. Must be called from the thread which owns the data (the
+    /// readers of the data do not synchronize with it). Returns whether points
+    /// were committed, throws std::runtime_error when an appended chunk does
+    /// not match the data type or number of dimensions.
+    bool commitAppendedPoints();
+
     void setDimensionNames(const std::vector<QString>& dimNames);
 
     // Returns the value of the element at the specified position in the current
@@ -414,6 +616,34 @@ public:
     // However, may not perform well when setting a large number of values.
     void setValueAt(std::size_t index, float newValue);
 
+public: // Quantization
+
+    /** Default maximum absolute reconstruction error for PointData::quantize() */
+    static constexpr float defaultMaximumQuantizationError = 1e-3f;
+
+    /**
+     * Quantize the dense float data per dimension, using the most compact code type (int8 or uint16) for which the
+     * reconstruction error of every value stays within \p maximumError
+     * @param maximumError Maximum absolute reconstruction error
+     * @return Boolean determining whether the data was quantized (false when the error bound cannot be met, or when the data is not dense float data with finite values)
+     */
+    bool quantize(float maximumError = defaultMaximumQuantizationError);
+
+    /** Restore float storage of quantized data (with the reconstructed values), does nothing when the data is not quantized */
+    void dequantize();
+
+    /**
+     * Get whether the data is quantized
+     * @return Boolean determining whether the data vector holds quantization codes
+     */
+    bool isQuantized() const;
+
+    /**
+     * Get the per-dimension quantization
+     * @return Quantization (disabled when the data is not quantized)
+     */
+    const PointDataQuantization& getQuantization() const;
+
 public: // Sparse data, test implementation
     class Experimental {
         friend class PointData;
@@ -467,6 +697,167 @@ public: // Sparse data, test implementation
         }
     };
 
+public: // Spilling
+
+    /**
+     * Get the spill name
+     * @return Raw data name
+     */
+    QString getSpillName() const override;
+
+    /**
+     * Get the number of bytes which spilling frees
+     * @return Number of resident bytes of dense data (zero when spilled, sparse, adopted or when pointers into the data were handed out)
+     */
+    std::uint64_t getNumberOfResidentBytes() const override;
+
+    /**
+     * Get whether the data is spilled to disk
+     * @return Boolean determining whether the data is spilled
+     */
+    bool isSpilled() const override;
+
+    /**
+     * Spill the dense data to \p filePath and release it (does nothing when already spilled, pinned, sparse, adopted or when pointers into the data were handed out)
+     * @param filePath Path of the spill file
+     * @return Boolean determining whether the data was spilled
+     * @throws std::runtime_error when the spill file cannot be written
+     */
+    bool spill(const QString& filePath) override;
+
+    /**
+     * Reload the data when spilled (waits for a spill which is in progress)
+     * @throws std::runtime_error when the spill file cannot be read
+     */
+    void reload() override;
+
+public: // Gathering
+
+    /**
+     * Gathered points class
+     *
+     * Contiguous copy of a subset of the rows of point data (see PointData::gatherPoints()), in the element type
+     * (and quantization) of the point data. Gathered points are immutable, they are not updated when the point data
+     * changes.
+     *
+     * @author Thomas Kroes
+     */
+    class GatheredPoints
+    {
+    public:
+
+        /**
+         * Allows read-only access to the gathered elements, from begin to end (similar to PointData::constVisitFromBeginToEnd())
+         * @param functionObject Function object which is invoked with the begin and end iterators
+         * @return Result of the function object
+         */
+        template <typename ReturnType = void, typename FunctionObject>
+        ReturnType constVisitFromBeginToEnd(FunctionObject functionObject) const
+        {
+            return constVisitVariantOfVectors<ReturnType>(_variantOfVectors, _quantization, functionObject);
+        }
+
+        /**
+         * Get the number of bytes occupied by the gathered elements
+         * @return Number of bytes
+         */
+        std::uint64_t getNumberOfBytes() const
+        {
+            return std::visit([](const auto& vec) -> std::uint64_t {
+                return vec.size() * sizeof(typename std::decay_t<decltype(vec)>::value_type);
+            }, _variantOfVectors);
+        }
+
+    private:
+        VariantOfVectors        _variantOfVectors;  /** Gathered elements */
+        PointDataQuantization   _quantization;      /** Quantization of the gathered elements (copied from the point data) */
+
+        friend class PointData;
+    };
+
+    /**
+     * Gather the rows with \p indices into a contiguous buffer (in parallel), so that repeated visits of a subset
+     * read memory sequentially instead of rows which are scattered across the data vector
+     * @param indices Indices of the rows to gather
+     * @return Shared pointer to the gathered points (nullptr when the data is sparse)
+     */
+    std::shared_ptr<const GatheredPoints> gatherPoints(const std::vector<unsigned int>& indices) const;
+
+private:
+
+    /**
+     * Visit \p variantOfVectors from begin to end, quantized data is visited with iterators which yield the reconstructed (float) values
+     * @param variantOfVectors Elements to visit
+     * @param quantization Quantization of the elements
+     * @param functionObject Function object which is invoked with the begin and end iterators
+     * @return Result of the function object
+     */
+    template <typename ReturnType, typename FunctionObject>
+    static ReturnType constVisitVariantOfVectors(const VariantOfVectors& variantOfVectors, const PointDataQuantization& quantization, FunctionObject functionObject)
+    {
+        return std::visit([&quantization, functionObject](const auto& vec) -> ReturnType
+            {
+                using CodeType = typename std::decay_t<decltype(vec)>::value_type;
+
+                if constexpr (PointDataQuantization::isCodeType<CodeType>)
+                {
+                    if (quantization.isEnabled())
+                    {
+                        const auto numberOfElements = static_cast<std::ptrdiff_t>(vec.size());
+
+                        return functionObject(mv::DequantizingIterator<CodeType>(vec.data(), 0, quantization), mv::DequantizingIterator<CodeType>(vec.data(), numberOfElements, quantization));
+                    }
+                }
+
+                return functionObject(std::cbegin(vec), std::cend(vec));
+            },
+            variantOfVectors);
+    }
+
+    /**
+     * Mark the data as accessed, reload it when spilled and pin it (invoked by all accessors of the data vector), the
+     * data is not spilled for the lifetime of the returned pin, so pointers into the data vector remain valid
+     * @return Pin which keeps the data resident
+     */
+    mv::util::Spillable::Pin pinResident() const
+    {
+        touch();
+
+        return mv::util::Spillable::Pin(const_cast<PointData&>(*this));
+    }
+
+    /**
+     * Get a pointer to the elements of the data vector without retaining residency (see getDataVoidPtr()), the caller pins the data
+     * @return Pointer to the elements
+     */
+    const void* getPinnedDataPtr() const;
+
+    /** Discard the spilled data (invoked before the data vector is replaced) */
+    void discardSpill();
+
+    /**
+     * Replace the data vector with adopted \p buffer
+     * @param buffer Buffer which adopts externally owned memory
+     * @param numDimensions Number of dimensions
+     */
+    template <typename T>
+    void adoptBuffer(PointDataBuffer<T>&& buffer, const std::size_t numDimensions)
+    {
+        discardSpill();
+        _quantization = {};
+        _variantOfVectors = VariantOfVectors(std::move(buffer));
+        _numDimensions = static_cast<unsigned int>(numDimensions);
+    }
+
+public: // Content hash
+
+    /**
+     * Compute the content hash of the point data (in parallel, see mv::util::DerivedDataCache::computeContentHash()),
+     * which covers the values, the element type, the shape and the quantization
+     * @return Content hash
+     */
+    QByteArray computeContentHash() const;
+
 public: // Serialization
     /**
      * Load point data from variant map
@@ -483,6 +874,9 @@ public: // Serialization
 private:
     VariantOfVectors _variantOfVectors;
 
+    /** Per-dimension quantization of the data vector (disabled when the data vector holds plain values) */
+    PointDataQuantization _quantization;
+
     /** Number of features of each data point */
     unsigned int _numDimensions = 1;
 
@@ -493,6 +887,17 @@ private: // Sparse data, experimental
     SparseMatrix<size_t, size_t, float> _sparseData = {};
 
     bool _isDense = true;
+
+private: // Spilling
+    std::mutex                  _residencyMutex;                /** Guards spilling and reloading */
+    std::atomic<bool>           _isSpilled = false;             /** Whether the dense data is spilled to disk */
+    mutable std::atomic<bool>   _isResidencyRetained = false;   /** Whether pointers into the data vector were handed out (the data is not spilled until it is replaced) */
+    QString                     _spillFilePath;                 /** Path of the spill file */
+    std::size_t                 _numberOfSpilledElements = 0;   /** Number of elements of the spilled data */
+
+private: // Streaming ingestion
+    std::mutex                      _appendMutex;       /** Guards the appended chunks */
+    std::vector<VariantOfVectors>   _appendedChunks;    /** Appended chunks which are not committed yet */
 };
 
 // =============================================================================
@@ -501,13 +906,158 @@ private: // Sparse data, experimental
 
 class POINTDATA_EXPORT Points : public mv::DatasetImpl
 {
+public:
+
+    /** Member of a proxy dataset in the concatenated view of the proxy members */
+    struct ProxyMemberSlice
+    {
+        Points*         _points;            /** Member points */
+        std::size_t     _pointOffset;       /** Index of the first point of the member in the proxy */
+        std::size_t     _numberOfPoints;    /** Number of points of the member */
+    };
+
+    using ProxyMemberSlices = std::vector<ProxyMemberSlice>;
+
 private:
+
+    /**
+     * Writes to a result container from an offset, so that proxy members populate their slice of the result in place
+     */
+    template <typename ResultContainer>
+    class ResultSlice
+    {
+    public:
+
+        /**
+         * Construct with \p resultContainer and \p offset
+         * @param resultContainer Result container to write to
+         * @param offset Index of the first element of the slice in \p resultContainer
+         */
+        ResultSlice(ResultContainer& resultContainer, std::size_t offset) :
+            _resultContainer(resultContainer),
+            _offset(offset)
+        {
+        }
+
+        /** Element at \p index in the slice */
+        decltype(auto) operator[](std::size_t index)
+        {
+            return _resultContainer[_offset + index];
+        }
+
+    private:
+        ResultContainer&    _resultContainer;   /** Result container to write to */
+        std::size_t         _offset;            /** Index of the first element of the slice */
+    };
+
+    /**
+     * Invoke \p function for each index in [0, \p count) in parallel (the first exception is rethrown afterwards)
+     * @param count Number of invocations
+     * @param function Function which is invoked with the index
+     */
+    static void forEachInParallel(std::size_t count, const std::function<void(std::size_t)>& function);
+
+    /**
+     * Get the number of partitions (workers) for reading \p numberOfPoints points
+     * @param numberOfPoints Number of points
+     * @return Number of partitions (at least one)
+     */
+    static std::size_t getNumberOfPartitions(std::size_t numberOfPoints);
+
+    /**
+     * Visit the point data of the proxy member in \p proxyMemberSlice, the point views report the point indices in the proxy
+     * Note that PointsType may or may not be "const" (the const overload visits quantized data dequantized).
+     * @param proxyMemberSlice Proxy member slice
+     * @param functionObject Function object which is invoked with the point data range of the member
+     */
+    template <typename PointsType, typename FunctionObject>
+    static void privateVisitProxyMemberData(const ProxyMemberSlice& proxyMemberSlice, const FunctionObject& functionObject)
+    {
+        using MemberType = std::conditional_t<std::is_const_v<PointsType>, const Points, Points>;
+
+        MemberType& member = *proxyMemberSlice._points;
+
+        if constexpr (!std::is_const_v<PointsType>)
+            member.releaseMaterializedSubset();
+
+        const auto pointOffset = static_cast<unsigned>(proxyMemberSlice._pointOffset);
+
+        member.template visitFromBeginToEnd<void>(
+            [&member, pointOffset, &functionObject](const auto begin, const auto end) -> void
+            {
+                const auto numberOfDimensions = member.getNumDimensions();
+
+                if (member.isFull())
+                {
+                    const auto indexFunction = [pointOffset](const unsigned index)
+                    {
+                        return mv::RelocatedPointIndex{ index, pointOffset + index };
+                    };
+
+                    functionObject(mv::makePointDataRangeOfFullSet(
+                        begin, end, numberOfDimensions, indexFunction));
+                }
+                else
+                {
+                    // The values are at the member (subset) index, the point view reports the position in the proxy
+                    const auto indexFunction = [pointOffset, first = std::cbegin(member._indices)](const auto indexIterator)
+                    {
+                        return mv::RelocatedPointIndex{ *indexIterator, static_cast<unsigned>(pointOffset + (indexIterator - first)) };
+                    };
+
+                    functionObject(mv::makePointDataRangeOfSubset(
+                        begin, member._indices, numberOfDimensions, indexFunction));
+                }
+            });
+    }
+
     /* Private helper function for visitData. Helps to reduces duplicate
     * code between const and non-const overloads of visitData.
+    * Note that PointsType may or may not be "const" (the const overload visits quantized data dequantized).
     */
-    template <typename ReturnType = void, typename FunctionObject>
-    static ReturnType privateVisitData(Points& points, const FunctionObject functionObject)
+    template <typename ReturnType = void, typename PointsType, typename FunctionObject>
+    static ReturnType privateVisitData(PointsType& points, const FunctionObject functionObject)
     {
+        // A proxy has no point data of its own, its members are visited one after the other
+        if (points.isProxy())
+        {
+            if constexpr (std::is_void_v<ReturnType>)
+            {
+                for (const auto& proxyMemberSlice : points.getProxyMemberSlices())
+                    privateVisitProxyMemberData<PointsType>(proxyMemberSlice, functionObject);
+
+                return;
+            }
+            else
+            {
+                throw std::runtime_error("Proxy point data can only be visited by a function object without return value");
+            }
+        }
+
+        if constexpr (std::is_const_v<PointsType>)
+        {
+            // Visit the gathered rows of a materialized subset sequentially, the point views still report the subset indices
+            if (const auto materializedSubset = points.getMaterializedSubset())
+            {
+                return materializedSubset->template constVisitFromBeginToEnd<ReturnType>(
+                    [&points, functionObject](const auto begin, const auto end) -> ReturnType
+                    {
+                        const auto indexFunction = [&indices = points._indices](const unsigned index)
+                        {
+                            return mv::RelocatedPointIndex{ index, indices[index] };
+                        };
+
+                        return functionObject(mv::makePointDataRangeOfFullSet(
+                            begin, end, points.getNumDimensions(), indexFunction));
+                    });
+            }
+        }
+        else
+        {
+            // The values may be modified, so the materialized subset would become stale
+            points.releaseMaterializedSubset();
+        }
+
         return points.template visitFromBeginToEnd<ReturnType>(
                 [&points, functionObject](const auto begin, const auto end) -> ReturnType
                 {
@@ -534,7 +1084,7 @@ private:
                         };
 
                         return functionObject(mv::makePointDataRangeOfSubset(
-                            begin, points.indices, numberOfDimensions, indexFunction));
+                            begin, points._indices, numberOfDimensions, indexFunction));
                     }
                 });
     }
@@ -572,7 +1122,7 @@ private:
 
                         // Its source data is a full set, so it is sufficient to use its own (points) indices.
                         return functionObject(mv::makePointDataRangeOfSubset(
-                            begin, points.indices, points.getNumDimensions(), indexFunction));
+                            begin, points._indices, points.getNumDimensions(), indexFunction));
                     });
             }
             else
@@ -582,14 +1132,14 @@ private:
                 // Define an index function that translates a derived subset index to a source data index.
                 const auto indexFunction = [&sourceData](const auto indexIterator)
                 {
-                    return sourceData->indices[*indexIterator];
+                    return sourceData->_indices[*indexIterator];
                 };
 
                 return sourceData->template visitFromBeginToEnd<ReturnType>(
                     [&points, functionObject, indexFunction](const auto begin, const auto end) -> ReturnType
                     {
                         return functionObject(mv::makePointDataRangeOfSubset(
-                            begin, points.indices, points.getNumDimensions(), indexFunction));
+                            begin, points._indices, points.getNumDimensions(), indexFunction));
                     });
             }
         }
@@ -626,6 +1176,7 @@ public:
 
     /* Allows visiting the point data, which is either _all_ data (if this data
      * set is full), or (otherwise) the subset specified by its indices.
+     * Quantized data is visited with the reconstructed values, without restoring float storage.
     */
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType visitData(FunctionObject functionObject) const
@@ -635,6 +1186,7 @@ public:
 
 
     /* Non-const overload, allowing write access to the point data.
+     * Quantized data is restored to float storage first, use the const overload for read-only access.
     */
     template <typename ReturnType = void, typename FunctionObject>
     ReturnType visitData(FunctionObject functionObject)
@@ -643,6 +1195,21 @@ public:
     }
 
 
+    /* Visits the point data of the members of a proxy dataset in parallel, the function object is
+     * invoked (concurrently) with the point data range of each member. The point views report the
+     * point indices in the proxy, so the results of the members can be written to disjoint slices.
+    */
+    template <typename FunctionObject>
+    void visitProxyMemberData(const FunctionObject functionObject) const
+    {
+        const auto proxyMemberSlices = getProxyMemberSlices();
+
+        forEachInParallel(proxyMemberSlices.size(), [&proxyMemberSlices, &functionObject](const std::size_t memberIndex) -> void {
+            privateVisitProxyMemberData<const Points>(proxyMemberSlices[memberIndex], functionObject);
+        });
+    }
+
+
     /* Allows visiting the source point data.
     */
     template <typename ReturnType = void, typename FunctionObject>
@@ -721,6 +1288,92 @@ public:
             mv::events().notifyDatasetDataDimensionsChanged(this);
     }
 
+    /// Just calls the corresponding member function of its PointData.
+    template <typename T, typename Deleter>
+    void adoptData(T* const data, const std::size_t numPoints, const std::size_t numDimensions, Deleter deleter)
+    {
+        const auto notifyDimensionsChanged = numDimensions != getRawData<PointData>()->getNumDimensions();
+
+        getRawData<PointData>()->adoptData(data, numPoints, numDimensions, std::move(deleter));
+
+        if (notifyDimensionsChanged)
+            mv::events().notifyDatasetDataDimensionsChanged(this);
+    }
+
+    /// Just calls the corresponding member function of its PointData.
+    template <typename T>
+    void adoptSharedData(const T* const data, const std::size_t numPoints, const std::size_t numDimensions, std::shared_ptr<const void> owner)
+    {
+        const auto notifyDimensionsChanged = numDimensions != getRawData<PointData>()->getNumDimensions();
+
+        getRawData<PointData>()->adoptSharedData(data, numPoints, numDimensions, std::move(owner));
+
+        if (notifyDimensionsChanged)
+            mv::events().notifyDatasetDataDimensionsChanged(this);
+    }
+
+    /// Just calls the corresponding member function of its PointData.
+    template <typename T>
+    void reservePoints(const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        const auto notifyDimensionsChanged = numDimensions != getRawData<PointData>()->getNumDimensions();
+
+        getRawData<PointData>()->reservePoints<T>(numPoints, numDimensions);
+
+        if (notifyDimensionsChanged)
+            mv::events().notifyDatasetDataDimensionsChanged(this);
+    }
+
+    /// Calls the corresponding member function of its PointData, and schedules
+    /// a commit of the appended points on the thread of this dataset (so that
+    /// views show the data while it is being loaded). Thread-safe.
+    template <typename T>
+    void appendPoints(std::vector<T>&& points)
+    {
+        getRawData<PointData>()->appendPoints(std::move(points));
+
+        scheduleCommitAppendedPoints();
+    }
+
+    /// Calls the corresponding member function of its PointData, and schedules
+    /// a commit of the appended points (see above). Thread-safe.
+    template <typename T>
+    void appendPoints(const T* const data, const std::size_t numPoints, const std::size_t numDimensions)
+    {
+        getRawData<PointData>()->appendPoints(data, numPoints, numDimensions);
+
+        scheduleCommitAppendedPoints();
+    }
+
+    /** Minimum interval between data changed notifications while points are appended */
+    static constexpr std::chrono::milliseconds dataChangedNotificationInterval{ 250 };
+
+    /**
+     * Commit the appended points and notify that the data changed. While loading, the notification is throttled
+     * to at most one per dataChangedNotificationInterval, so that views do not recompute for every chunk. Loaders
+     * call this (with \p finished true) on the thread of this dataset once all points are appended.
+     * @param finished Whether all points are appended (always notifies)
+     */
+    void commitAppendedPoints(bool finished = true);
+
+    /// Just calls the corresponding member function of its PointData.
+    bool quantize(float maximumError = PointData::defaultMaximumQuantizationError)
+    {
+        return getRawData<PointData>()->quantize(maximumError);
+    }
+
+    /// Just calls the corresponding member function of its PointData.
+    void dequantize()
+    {
+        getRawData<PointData>()->dequantize();
+    }
+
+    /// Just calls the corresponding member function of its PointData.
+    bool isQuantized() const
+    {
+        return getRawData<PointData>()->isQuantized();
+    }
+
     void extractDataForDimension(std::vector<float>& result, const int dimensionIndex) const;
 
     void extractDataForDimensions(std::vector<mv::Vector2f>& result, const int dimensionIndex1, const int dimensionIndex2) const;
@@ -733,28 +1386,23 @@ public:
     void populateDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices) const
     {
         if (isProxy()) {
-            std::size_t offset = 0;
-
-            for (auto& proxyMember : getProxyMembers()) {
-                auto points = mv::Dataset<Points>(proxyMember);
+            const auto proxyMemberSlices    = getProxyMemberSlices();
+            const auto numberOfDimensions   = static_cast<std::size_t>(std::size(dimensionIndices));
 
-                ResultContainer proxyPointsData = {};
+            // Each member populates its own slice of the result (no intermediate copies). The slice is filled from the
+            // raw data of the member, re-entering this function with the slice type would recurse without bound.
+            forEachInParallel(proxyMemberSlices.size(), [&](const std::size_t memberIndex) -> void {
+                const auto& proxyMemberSlice    = proxyMemberSlices[memberIndex];
+                const auto  member              = proxyMemberSlice._points;
+                const auto  rawPointData        = member->getRawData<PointData>();
 
-                const auto numberOfElements = points->getNumPoints() * dimensionIndices.size();
+                ResultSlice<ResultContainer> resultSlice(resultContainer, proxyMemberSlice._pointOffset * numberOfDimensions);
 
-                proxyPointsData.resize(numberOfElements);
-
-                const auto rawPointData = points->getRawData<PointData>();
-
-                if (points->isFull())
-                    rawPointData->populateFullDataForDimensions(proxyPointsData, dimensionIndices);
+                if (member->isFull())
+                    rawPointData->populateFullDataForDimensions(resultSlice, dimensionIndices);
                 else
-                    rawPointData->populateDataForDimensions(proxyPointsData, dimensionIndices, points->indices);
-
-                std::copy(proxyPointsData.begin(), proxyPointsData.end(), resultContainer.begin() + offset);
-
-                offset += numberOfElements;
-            }
+                    rawPointData->populateDataForDimensions(resultSlice, dimensionIndices, member->_indices);
+            });
         }
         else {
             const auto rawPointData = getRawData<PointData>();
@@ -762,16 +1410,80 @@ public:
             if (isFull())
                 rawPointData->populateFullDataForDimensions(resultContainer, dimensionIndices);
             else
-                rawPointData->populateDataForDimensions(resultContainer, dimensionIndices, indices);
+                rawPointData->populateDataForDimensions(resultContainer, dimensionIndices, _indices);
         }
     }
 
+    /// Populates the specified result container with the data for the
+    /// dimensions specified by the dimension indices, for the points at the
+    /// specified (raw data) indices. For a proxy the indices are point indices
+    /// in the proxy, each run of indices of the same member is populated in place.
     template <typename ResultContainer, typename DimensionIndices, typename Indices>
     void populateDataForDimensions(ResultContainer& resultContainer, const DimensionIndices& dimensionIndices, const Indices& indices) const
     {
-        getRawData<PointData>()->populateDataForDimensions(resultContainer, dimensionIndices, indices);
+        if (!isProxy()) {
+            getRawData<PointData>()->populateDataForDimensions(resultContainer, dimensionIndices, indices);
+            return;
+        }
+
+        const auto proxyMemberSlices    = getProxyMemberSlices();
+        const auto numberOfDimensions   = static_cast<std::size_t>(std::size(dimensionIndices));
+        const auto numberOfIndices      = static_cast<std::size_t>(std::size(indices));
+        const auto numberOfPartitions   = getNumberOfPartitions(numberOfIndices);
+
+        const auto getMemberIndex = [&proxyMemberSlices](const std::size_t pointIndex) -> std::size_t {
+            const auto it = std::upper_bound(proxyMemberSlices.begin(), proxyMemberSlices.end(), pointIndex, [](const std::size_t pointIndex, const ProxyMemberSlice& proxyMemberSlice) -> bool {
+                return pointIndex < proxyMemberSlice._pointOffset;
+            });
+
+            return static_cast<std::size_t>(std::distance(proxyMemberSlices.begin(), it)) - 1;
+        };
+
+        forEachInParallel(numberOfPartitions, [&](const std::size_t partitionIndex) -> void {
+            const auto firstIndex   = numberOfIndices * partitionIndex / numberOfPartitions;
+            const auto lastIndex    = numberOfIndices * (partitionIndex + 1) / numberOfPartitions;
+
+            std::vector<std::uint32_t> memberIndices;
+
+            for (auto runStart = firstIndex; runStart < lastIndex;) {
+                const auto  memberIndex         = getMemberIndex(static_cast<std::size_t>(indices[runStart]));
+                const auto& proxyMemberSlice    = proxyMemberSlices[memberIndex];
+                const auto  member              = proxyMemberSlice._points;
+
+                memberIndices.clear();
+
+                auto runEnd = runStart;
+
+                // Translate the proxy point indices of the run to indices in the raw data of the member
+                for (; runEnd < lastIndex; ++runEnd) {
+                    const auto pointIndex = static_cast<std::size_t>(indices[runEnd]);
+
+                    if (pointIndex < proxyMemberSlice._pointOffset || pointIndex >= proxyMemberSlice._pointOffset + proxyMemberSlice._numberOfPoints)
+                        break;
+
+                    const auto localIndex = static_cast<std::uint32_t>(pointIndex - proxyMemberSlice._pointOffset);
+
+                    memberIndices.push_back(member->isFull() ? localIndex : member->_indices[localIndex]);
+                }
+
+                if (runEnd == runStart)
+                    throw std::out_of_range("Point index out of range of the proxy dataset");
+
+                ResultSlice<ResultContainer> resultSlice(resultContainer, runStart * numberOfDimensions);
+
+                member->getRawData<PointData>()->populateDataForDimensions(resultSlice, dimensionIndices, memberIndices);
+
+                runStart = runEnd;
+            }
+        });
     }
 
+    /**
+     * Get the concatenated view of the members of a proxy dataset
+     * @return Proxy members with the offsets of their first points in the proxy (empty if this dataset is not a proxy)
+     */
+    ProxyMemberSlices getProxyMemberSlices() const;
+
     unsigned int getNumRawPoints() const
     {
         if (isProxy()) {
@@ -801,7 +1513,7 @@ public:
         }
         else {
             if (isFull()) return getRawData<PointData>()->getNumPoints();
-                else return static_cast<std::uint32_t>(indices.size());
+                else return static_cast<std::uint32_t>(_indices.size());
         }
     }
 
@@ -922,6 +1634,36 @@ public:
      */
     void setProxyMembers(const mv::Datasets& proxyMembers) override;
 
+public: // Subset indices
+
+    /**
+     * Get the subset indices (the indices of the points of a subset in its source data, empty for a full dataset)
+     * @return Subset indices
+     */
+    const std::vector<unsigned int>& getIndices() const;
+
+    /**
+     * Set the subset indices to \p indices, the cached global index map, materialized subset, histograms and content
+     * hash (of this dataset and of the datasets derived from it) are invalidated
+     * @param indices Subset indices
+     */
+    void setIndices(const std::vector<unsigned int>& indices);
+
+    /**
+     * Set the subset indices to \p indices (moved into the dataset), the cached global index map, materialized subset,
+     * histograms and content hash (of this dataset and of the datasets derived from it) are invalidated
+     * @param indices Subset indices
+     */
+    void setIndices(std::vector<unsigned int>&& indices);
+
+    /**
+     * Subset indices, DEPRECATED: kept for source compatibility of plugins for one release, use getIndices() and setIndices() instead
+     * Assigning to it or editing it in place bypasses setIndices(), so call invalidateGlobalIndexMap() afterwards to invalidate the
+     * caches keyed by the subset
+     */
+    [[deprecated("Use Points::getIndices() and Points::setIndices() instead, to be removed in the next release")]]
+    std::vector<unsigned int>& indices;
+
 public: // Index transformation
     /**
      * Get the indices over the original source data that this dataset
@@ -930,6 +1672,104 @@ public: // Index transformation
      */
     void getGlobalIndices(std::vector<unsigned int>& globalIndices) const;
 
+    /**
+     * Get the flattened local to global index map of this dataset (with global to local inverse lookup)
+     * The map is cached and only rebuilt when the subset chain changes (subset indices set with setIndices() or
+     * explicitly invalidated with invalidateGlobalIndexMap())
+     * @return Shared pointer to the (immutable) global index map
+     */
+    std::shared_ptr<const GlobalIndexMap> getGlobalIndexMap() const;
+
+    /**
+     * Invalidate the cached global index map of this dataset and of all datasets derived from it
+     * Call this when the subset chain changes other than through setIndices() (e.g. a different source dataset)
+     */
+    void invalidateGlobalIndexMap();
+
+public: // Content hash
+
+    /**
+     * Get the content hash of the points: of the point data for a full dataset, of the point data and the subset
+     * indices for a subset, or of the members for a proxy. It is computed on demand, cached until the data (or the
+     * subset) changes, and saved with the project so that it is known right away when the project is reopened. The
+     * content hash is the input hash of artefacts in the derived data cache (see mv::util::DerivedDataCache).
+     * @return Content hash
+     */
+    QByteArray getContentHash() const;
+
+public: // Versioning
+
+    /**
+     * Get the data version, which is incremented each time the data of this dataset (or of a dataset which shares its
+     * point data) is reported as changed (see mv::AbstractEventManager::notifyDatasetDataChanged())
+     * @return Data version
+     */
+    std::uint64_t getDataVersion() const;
+
+    /**
+     * Get the indices version, which is incremented each time the subset indices are set (see setIndices()) or the
+     * global index map is invalidated, caches keyed by the subset use it in their signature
+     * @return Indices version
+     */
+    std::uint64_t getIndicesVersion() const;
+
+public: // Histograms
+
+    /** Maximum number of histograms which are cached per dataset */
+    static constexpr std::size_t maximumNumberOfCachedHistograms = 16;
+
+    /**
+     * Get the histogram of all points and of the selected points of dimension \p dimensionIndex (may be called from any thread)
+     *
+     * Histograms are cached per dimension, number of bins and range until the data changes. When the selection changed
+     * since the histogram was requested before, the histogram of the selected points is updated with the selection delta.
+     * The histograms are binned outside the cache lock, the cached histograms share one copy of the selection and their
+     * memory is reported in the cache category of the memory accounting.
+     *
+     * @param dimensionIndex Index of the dimension
+     * @param numberOfBins Number of bins
+     * @param minimum Lower bound of the range (values outside the range are not counted)
+     * @param maximum Upper bound of the range
+     * @return Histograms of all points and of the selected points
+     */
+    mv::util::DualHistogram getHistogram(std::uint32_t dimensionIndex, std::uint32_t numberOfBins, float minimum, float maximum) const;
+
+    /** Remove all cached histograms */
+    void invalidateHistograms();
+
+public: // Materialization
+
+    /** Determines when the rows of a subset are gathered into a contiguous local buffer */
+    enum class MaterializationPolicy {
+        Never,          /** Always visit the subset through its indices (default) */
+        Automatic,      /** Materialize once the subset is visited repeatedly and the memory budget allows it */
+        Always          /** Materialize on the first visit (unless the memory budget does not allow it) */
+    };
+
+    /** Number of read-only visits after which an automatically materialized subset is materialized */
+    static constexpr std::uint32_t materializationVisitThreshold = 2;
+
+    /**
+     * Set the materialization policy to \p materializationPolicy (only affects subsets)
+     * @param materializationPolicy Materialization policy
+     */
+    void setMaterializationPolicy(const MaterializationPolicy& materializationPolicy);
+
+    /**
+     * Get the materialization policy
+     * @return Materialization policy
+     */
+    MaterializationPolicy getMaterializationPolicy() const;
+
+    /**
+     * Get whether the rows of the subset are currently gathered into a contiguous local buffer
+     * @return Boolean determining whether the subset is materialized
+     */
+    bool isMaterialized() const;
+
+    /** Release the materialized rows (the subset is visited through its indices until it is materialized again) */
+    void releaseMaterializedSubset();
+
     /**
      * Passing a vector of global selection indices, returns a vector of booleans
      * describing which indices of this dataset are selected. A locally selected
@@ -939,6 +1779,10 @@ public: // Index transformation
      */
     void selectedLocalIndices(const std::vector<unsigned int>& selectionIndices, std::vector<bool>& selected) const;
 
+    /**
+     * Get the indices of the selected points in this dataset (local indices, in ascending order and without duplicates)
+     * @param localSelectionIndices Local selection indices (its capacity is reused)
+     */
     void getLocalSelectionIndices(std::vector<unsigned int>& localSelectionIndices) const;
 
 
@@ -951,17 +1795,30 @@ public: // Action getters
 public: // Selection
 
     /**
-     * Get selection indices
+     * Get mutable selection indices, the selection is considered changed (its caches keyed by the indices are invalidated)
+     * Prefer the const overload to read the selection and setSelectionIndices() to change it
      * @return Selection indices
      */
     std::vector<std::uint32_t>& getSelectionIndices() override;
 
+    /**
+     * Get selection indices (read-only)
+     * @return Selection indices
+     */
+    const std::vector<std::uint32_t>& getSelectionIndices() const;
+
     /**
      * Select by indices
      * @param indices Selection indices
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /**
+     * Select by \p indices, which are moved into the selection
+     * @param indices Selection indices
+     */
+    void setSelectionIndices(std::vector<std::uint32_t>&& indices) override;
+
     /** Determines whether items can be selected */
     bool canSelect() const override;
 
@@ -1007,12 +1864,76 @@ public: // Linked data
 
 public:
 
-    std::vector<unsigned int> indices;
-
     InfoAction*                 _infoAction;                    /** Non-owning pointer to info action */
     mv::gui::GroupAction*       _dimensionsPickerGroupAction;   /** Group action for dimensions picker action */
     DimensionsPickerAction*     _dimensionsPickerAction;        /** Non-owning pointer to dimensions picker action */
     mv::EventListener           _eventListener;                 /** Listen to HDPS events */
+
+private:
+
+    /**
+     * Get the subsets in the chain of derived datasets back to the original source data (this dataset first)
+     * @return Subset chain
+     */
+    std::vector<mv::Dataset<Points>> getSubsetChain() const;
+
+    /**
+     * Get the signature of the subset chain, the cached global index map is valid as long as the signature does not change
+     * @param subsetChain Subset chain
+     * @return Chain signature
+     */
+    std::vector<std::uint64_t> getSubsetChainSignature(const std::vector<mv::Dataset<Points>>& subsetChain) const;
+
+    /** Schedule a (single) commit of the appended points on the thread of this dataset (may be called from any thread) */
+    void scheduleCommitAppendedPoints();
+
+    /**
+     * Get the materialized subset, gathers the rows when the materialization policy and the memory budget allow it (may be called from any thread)
+     * @return Shared pointer to the gathered rows (nullptr when the subset is visited through its indices)
+     */
+    std::shared_ptr<const PointData::GatheredPoints> getMaterializedSubset() const;
+
+    /**
+     * Get the owner of the memory occupied by the cached histograms (see MemoryAccounting)
+     * @return Owner identifier
+     */
+    QString getHistogramsAllocationOwner() const;
+
+    /** Sorted local indices of the selected points, shared by the cached histograms which were computed from them */
+    using SelectionSnapshot = std::shared_ptr<const std::vector<std::uint32_t>>;
+
+    /** Cached histogram of a dimension, number of bins and range */
+    struct CachedHistogram
+    {
+        mv::util::DualHistogram     _histogram;             /** Histograms of all points and of the selected points */
+        SelectionSnapshot           _selectionIndices;      /** Selection the histogram of the selected points was computed from */
+        std::vector<std::uint64_t>  _signature;             /** Signature of the data the histogram of all points was computed from */
+        std::uint64_t               _stamp;                 /** Order in which the histogram was last requested */
+    };
+
+private:
+    std::vector<unsigned int>                                 _indices;                     /** Subset indices (set through setIndices(), so that the caches keyed by the subset are invalidated) */
+    std::atomic<std::uint64_t>                                _indicesVersion;              /** Incremented when the subset indices are changed */
+    mutable std::mutex                                        _globalIndexMapMutex;         /** Guards the cached global index map */
+    mutable std::shared_ptr<const GlobalIndexMap>             _globalIndexMap;              /** Cached global index map */
+    mutable std::vector<std::uint64_t>                        _globalIndexMapSignature;     /** Subset chain signature of the cached global index map */
+    std::atomic<bool>                                         _isCommitScheduled;           /** Whether a commit of appended points is scheduled */
+    std::chrono::steady_clock::time_point                     _lastDataChangedNotification; /** Time of the last (throttled) data changed notification while loading */
+    std::atomic<MaterializationPolicy>                        _materializationPolicy;       /** Determines when the subset is materialized */
+    std::atomic<std::uint64_t>                                _memoryBudget;                /** Cached memory budget (the memory manager settings may only be read on the main thread) */
+    mutable std::atomic<std::uint32_t>                        _numberOfVisits;              /** Number of read-only visits since the subset was (re)defined */
+    mutable std::mutex                                        _materializedSubsetMutex;     /** Guards the materialized subset */
+    mutable std::shared_ptr<const PointData::GatheredPoints>  _materializedSubset;          /** Gathered rows of the subset (nullptr when not materialized) */
+    mutable std::vector<std::uint64_t>                        _materializedSubsetSignature; /** Signature of the indices of the materialized subset */
+    std::atomic<std::uint64_t>                                _dataVersion;                 /** Incremented when the data is reported as changed */
+    mutable std::mutex                                        _histogramsMutex;             /** Guards the cached histograms */
+    mutable std::map<std::tuple<std::uint32_t, std::uint32_t, float, float>, CachedHistogram> _histograms;   /** Cached histograms by dimension index, number of bins and range */
+    mutable SelectionSnapshot                                 _histogramSelectionIndices;   /** Most recent selection snapshot of the cached histograms */
+    mutable std::uint64_t                                     _histogramStamp;              /** Incremented each time a histogram is requested */
+    mutable std::mutex                                        _contentHashMutex;            /** Guards the cached content hash */
+    mutable QByteArray                                        _contentHash;                 /** Cached content hash (empty when out of date) */
+    mutable std::uint64_t                                     _contentHashIndicesVersion;   /** Subset indices version the content hash was computed for */
+    mutable std::uint64_t                                     _contentHashDataVersion;      /** Data version the content hash was computed (or saved) for */
 };
 
 // =============================================================================
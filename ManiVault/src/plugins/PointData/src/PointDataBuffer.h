@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Point data buffer class
+ *
+ * Contiguous element storage of point data with a std::vector-like interface. The buffer either owns its elements
+ * (in a std::vector) or adopts externally owned memory (e.g. a memory-mapped file or an array of a foreign runtime)
+ * without copying it. Adopted memory is kept alive by a shared owner, which is released when the buffer no longer
+ * references the memory.
+ *
+ * Adopted memory is either writable (exclusively adopted, modified in place) or read-only (shared), in which case the
+ * elements are copied into owned storage on the first mutable access.
+ *
+ * @author Thomas Kroes
+ */
+template <typename T>
+class PointDataBuffer
+{
+public:
+    using value_type        = T;
+    using size_type         = std::size_t;
+    using iterator          = T*;
+    using const_iterator    = const T*;
+
+public:
+
+    /** Construct empty buffer */
+    PointDataBuffer() = default;
+
+    /**
+     * Construct owned buffer with a copy of \p vector
+     * @param vector Elements
+     */
+    PointDataBuffer(const std::vector<T>& vector) :
+        _vector(vector)
+    {
+        updateView();
+    }
+
+    /**
+     * Construct owned buffer by moving \p vector
+     * @param vector Elements
+     */
+    PointDataBuffer(std::vector<T>&& vector) :
+        _vector(std::move(vector))
+    {
+        updateView();
+    }
+
+    /**
+     * Construct buffer which adopts \p size elements at \p data without copying them
+     * @param data Pointer to the first element
+     * @param size Number of elements
+     * @param owner Keeps the memory alive for as long as the buffer references it
+     * @param writable Whether the memory may be modified in place (otherwise it is copied on the first mutable access)
+     */
+    PointDataBuffer(const T* data, std::size_t size, std::shared_ptr<const void> owner, bool writable) :
+        _owner(std::move(owner)),
+        _writable(writable),
+        _data(const_cast<T*>(data)),
+        _size(size)
+    {
+    }
+
+    PointDataBuffer(const PointDataBuffer& other) :
+        _vector(other._vector),
+        _owner(other._owner),
+        _writable(false),
+        _data(other._data),
+        _size(other._size)
+    {
+        // Read-only adopted memory is shared, writable adopted memory (which the other buffer may modify) is copied
+        if (other.isAdopted() && other._writable)
+            copyToOwnedStorage();
+        else if (!isAdopted())
+            updateView();
+    }
+
+    PointDataBuffer(PointDataBuffer&& other) noexcept
+    {
+        swap(other);
+    }
+
+    PointDataBuffer& operator=(PointDataBuffer other) noexcept
+    {
+        swap(other);
+
+        return *this;
+    }
+
+    /**
+     * Get whether the buffer references adopted (externally owned) memory
+     * @return Boolean determining whether the memory is adopted
+     */
+    bool isAdopted() const
+    {
+        return _owner != nullptr;
+    }
+
+    /**
+     * Get the number of elements
+     * @return Number of elements
+     */
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    /**
+     * Get whether the buffer is empty
+     * @return Boolean determining whether there are no elements
+     */
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * Get read-only access to the elements
+     * @return Pointer to the first element
+     */
+    const T* data() const
+    {
+        return _data;
+    }
+
+    /**
+     * Get mutable access to the elements (copies read-only adopted memory into owned storage first)
+     * @return Pointer to the first element
+     */
+    T* data()
+    {
+        detach();
+
+        return _data;
+    }
+
+    const T& operator[](std::size_t index) const { return _data[index]; }
+    T& operator[](std::size_t index) { detach(); return _data[index]; }
+
+    const_iterator begin() const { return _data; }
+    const_iterator end() const { return _data + _size; }
+    const_iterator cbegin() const { return _data; }
+    const_iterator cend() const { return _data + _size; }
+
+    iterator begin() { detach(); return _data; }
+    iterator end() { detach(); return _data + _size; }
+
+    /**
+     * Resize to \p size elements (adopted memory is copied into owned storage first)
+     * @param size Number of elements
+     */
+    void resize(std::size_t size)
+    {
+        if (isAdopted())
+            copyToOwnedStorage();
+
+        _vector.resize(size);
+
+        updateView();
+    }
+
+    /**
+     * Reserve owned storage for \p capacity elements (adopted memory is copied into owned storage first)
+     * @param capacity Number of elements
+     */
+    void reserve(std::size_t capacity)
+    {
+        if (isAdopted())
+            copyToOwnedStorage();
+
+        _vector.reserve(capacity);
+
+        updateView();
+    }
+
+    /**
+     * Get the number of elements for which owned storage is allocated
+     * @return Capacity of the owned storage (zero when the memory is adopted)
+     */
+    std::size_t capacity() const
+    {
+        return _vector.capacity();
+    }
+
+    /**
+     * Reserve owned storage for \p size elements before appending (adopted memory is copied into owned storage first).
+     * The capacity grows geometrically, so that appending in many steps copies each element a constant number of
+     * times on average (reserving the exact size would copy all elements on every append).
+     * @param size Number of elements after appending
+     */
+    void reserveForAppend(std::size_t size)
+    {
+        if (!isAdopted() && size <= _vector.capacity())
+            return;
+
+        reserve(std::max(size, 2 * _vector.capacity()));
+    }
+
+    /**
+     * Append \p count elements at \p elements (adopted memory is copied into owned storage first)
+     * @param elements Pointer to the first element to append
+     * @param count Number of elements to append
+     */
+    void append(const T* elements, std::size_t count)
+    {
+        if (isAdopted())
+            copyToOwnedStorage();
+
+        _vector.insert(_vector.end(), elements, elements + count);
+
+        updateView();
+    }
+
+    /**
+     * Swap with \p other
+     * @param other Buffer to swap with
+     */
+    void swap(PointDataBuffer& other) noexcept
+    {
+        _vector.swap(other._vector);
+        _owner.swap(other._owner);
+
+        std::swap(_writable, other._writable);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+    }
+
+private:
+
+    /** Copy read-only adopted memory into owned storage (before mutable access) */
+    void detach()
+    {
+        if (isAdopted() && !_writable)
+            copyToOwnedStorage();
+    }
+
+    /** Copy adopted memory into owned storage and release the owner */
+    void copyToOwnedStorage()
+    {
+        std::vector<T>(_data, _data + _size).swap(_vector);
+
+        _owner.reset();
+        _writable = false;
+
+        updateView();
+    }
+
+    /** Point the view at the owned storage */
+    void updateView()
+    {
+        _data   = _vector.data();
+        _size   = _vector.size();
+    }
+
+private:
+    std::vector<T>              _vector;            /** Owned storage (empty when the memory is adopted) */
+    std::shared_ptr<const void> _owner;             /** Owner of adopted memory (nullptr when owned) */
+    bool                        _writable = false;  /** Whether adopted memory may be modified in place */
+    T*                          _data = nullptr;    /** First element (in owned storage or adopted memory) */
+    std::size_t                 _size = 0;          /** Number of elements */
+};
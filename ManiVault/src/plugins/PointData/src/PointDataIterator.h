@@ -4,12 +4,25 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 #include "PointView.h"
 
 namespace mv
 {
+    /* Index of a point whose values are stored at another position (e.g. a subset gathered into a
+    * contiguous buffer). An index function may return it to locate the values at valueIndex while
+    * the PointView still reports the original pointIndex.
+    */
+    struct RelocatedPointIndex
+    {
+        std::size_t valueIndex;
+        unsigned pointIndex;
+    };
+
+
     template <typename ValueIteratorType, typename IndexIteratorType, typename IndexFunctionType>
     class PointDataIterator
     {
@@ -53,9 +66,19 @@ namespace mv
         auto operator*() const
         {
             const auto index = _indexFunction(_indexIterator);
-            const auto begin = _valueIterator + (index * _numberOfDimensions);
-            const auto end = begin + _numberOfDimensions;
-            return PointViewType(begin, end, index);
+
+            if constexpr (std::is_same_v<std::decay_t<decltype(index)>, RelocatedPointIndex>)
+            {
+                const auto begin = _valueIterator + (index.valueIndex * _numberOfDimensions);
+                const auto end = begin + _numberOfDimensions;
+                return PointViewType(begin, end, index.pointIndex);
+            }
+            else
+            {
+                const auto begin = _valueIterator + (index * _numberOfDimensions);
+                const auto end = begin + _numberOfDimensions;
+                return PointViewType(begin, end, index);
+            }
         }
 
 
@@ -213,7 +236,16 @@ namespace mv
         */
         friend auto index(const PointDataIterator& arg)
         {
-            return arg._indexFunction(arg._indexIterator);
+            const auto index = arg._indexFunction(arg._indexIterator);
+
+            if constexpr (std::is_same_v<std::decay_t<decltype(index)>, RelocatedPointIndex>)
+            {
+                return index.pointIndex;
+            }
+            else
+            {
+                return index;
+            }
         }
 
     };
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "PointDataQuantization.h"
+
+#include <util/Serialization.h>
+
+#include <stdexcept>
+
+using namespace mv::util;
+
+PointDataQuantization::PointDataQuantization(std::vector<float>&& scales, std::vector<float>&& offsets) :
+    _scales(std::move(scales)),
+    _offsets(std::move(offsets)),
+    _inverseScales(_scales.size())
+{
+    if (_scales.size() != _offsets.size())
+        throw std::runtime_error("Number of quantization scales and offsets differ");
+
+    for (std::size_t dimensionIndex = 0; dimensionIndex < _scales.size(); dimensionIndex++)
+        _inverseScales[dimensionIndex] = _scales[dimensionIndex] > 0.f ? 1.f / _scales[dimensionIndex] : 0.f;
+}
+
+bool PointDataQuantization::isEnabled() const
+{
+    return !_scales.empty();
+}
+
+std::uint32_t PointDataQuantization::getNumberOfDimensions() const
+{
+    return static_cast<std::uint32_t>(_scales.size());
+}
+
+const std::vector<float>& PointDataQuantization::getScales() const
+{
+    return _scales;
+}
+
+const std::vector<float>& PointDataQuantization::getOffsets() const
+{
+    return _offsets;
+}
+
+float PointDataQuantization::getMaximumError() const
+{
+    if (_scales.empty())
+        return 0.f;
+
+    return 0.5f * *std::max_element(_scales.begin(), _scales.end());
+}
+
+void PointDataQuantization::fromVariantMap(const QVariantMap& variantMap)
+{
+    variantMapMustContain(variantMap, "NumberOfDimensions");
+    variantMapMustContain(variantMap, "Scales");
+    variantMapMustContain(variantMap, "Offsets");
+
+    const auto numberOfDimensions = variantMap["NumberOfDimensions"].toUInt();
+
+    std::vector<float> scales(numberOfDimensions), offsets(numberOfDimensions);
+
+    populateDataBufferFromVariantMap(variantMap["Scales"].toMap(), reinterpret_cast<char*>(scales.data()));
+    populateDataBufferFromVariantMap(variantMap["Offsets"].toMap(), reinterpret_cast<char*>(offsets.data()));
+
+    *this = PointDataQuantization(std::move(scales), std::move(offsets));
+}
+
+QVariantMap PointDataQuantization::toVariantMap() const
+{
+    const auto numberOfBytes = static_cast<std::uint64_t>(_scales.size() * sizeof(float));
+
+    return {
+        { "NumberOfDimensions", QVariant::fromValue(getNumberOfDimensions()) },
+        { "Scales", rawDataToVariantMap(reinterpret_cast<const char*>(_scales.data()), numberOfBytes) },
+        { "Offsets", rawDataToVariantMap(reinterpret_cast<const char*>(_offsets.data()), numberOfBytes) }
+    };
+}
@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "pointdata_export.h"
+
+#include <QVariantMap>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Point data quantization class
+ *
+ * Per-dimension affine quantization of dense point data: each value is stored as an integer code and reconstructed
+ * as offset + scale * code, with the scale and offset of its dimension. Codes are either int8 (256 levels) or uint16
+ * (65536 levels), PointData::quantize() picks the most compact code type which meets the requested error bound.
+ *
+ * The (de)quantization kernels are plain loops over contiguous scales, offsets and codes so that the compiler
+ * vectorizes them (see MV_USE_AVX).
+ *
+ * @author Thomas Kroes
+ */
+class POINTDATA_EXPORT PointDataQuantization
+{
+public:
+
+    /** Whether \p CodeType is a supported code type */
+    template <typename CodeType>
+    static constexpr bool isCodeType = std::is_same_v<CodeType, std::int8_t> || std::is_same_v<CodeType, std::uint16_t>;
+
+    /**
+     * Get the number of quantization steps of \p CodeType
+     * @return Number of steps between the lowest and highest code
+     */
+    template <typename CodeType>
+    static constexpr float getNumberOfSteps()
+    {
+        static_assert(isCodeType<CodeType>, "Unsupported quantization code type");
+
+        return static_cast<float>(std::numeric_limits<CodeType>::max()) - static_cast<float>(std::numeric_limits<CodeType>::lowest());
+    }
+
+    /**
+     * Get the maximum reconstruction error when a value \p range is quantized with \p CodeType
+     * @param range Value range (maximum - minimum)
+     * @return Maximum absolute reconstruction error
+     */
+    template <typename CodeType>
+    static float getMaximumError(float range)
+    {
+        return 0.5f * range / getNumberOfSteps<CodeType>();
+    }
+
+    /**
+     * Create quantization which maps the per-dimension value ranges onto the full code range of \p CodeType
+     * @param minima Minimum value per dimension
+     * @param maxima Maximum value per dimension
+     * @return Quantization
+     */
+    template <typename CodeType>
+    static PointDataQuantization fromRanges(const std::vector<float>& minima, const std::vector<float>& maxima)
+    {
+        constexpr auto codeMinimum = static_cast<float>(std::numeric_limits<CodeType>::lowest());
+
+        std::vector<float> scales(minima.size()), offsets(minima.size());
+
+        for (std::size_t dimensionIndex = 0; dimensionIndex < minima.size(); dimensionIndex++) {
+            scales[dimensionIndex]  = (maxima[dimensionIndex] - minima[dimensionIndex]) / getNumberOfSteps<CodeType>();
+            offsets[dimensionIndex] = minima[dimensionIndex] - codeMinimum * scales[dimensionIndex];
+        }
+
+        return PointDataQuantization(std::move(scales), std::move(offsets));
+    }
+
+public:
+
+    /** No quantization */
+    PointDataQuantization() = default;
+
+    /**
+     * Construct with per-dimension \p scales and \p offsets
+     * @param scales Scale per dimension
+     * @param offsets Offset per dimension
+     */
+    PointDataQuantization(std::vector<float>&& scales, std::vector<float>&& offsets);
+
+    /**
+     * Get whether the data is quantized
+     * @return Boolean determining whether there are scales and offsets
+     */
+    bool isEnabled() const;
+
+    /**
+     * Get the number of dimensions
+     * @return Number of dimensions
+     */
+    std::uint32_t getNumberOfDimensions() const;
+
+    /**
+     * Get the scale per dimension
+     * @return Scales
+     */
+    const std::vector<float>& getScales() const;
+
+    /**
+     * Get the offset per dimension
+     * @return Offsets
+     */
+    const std::vector<float>& getOffsets() const;
+
+    /**
+     * Get the maximum reconstruction error over all dimensions
+     * @return Maximum absolute reconstruction error
+     */
+    float getMaximumError() const;
+
+    /**
+     * Reconstruct the value of \p code in dimension \p dimensionIndex
+     * @param code Quantization code
+     * @param dimensionIndex Dimension index
+     * @return Reconstructed value
+     */
+    template <typename CodeType>
+    float dequantize(CodeType code, std::uint32_t dimensionIndex) const
+    {
+        return _offsets[dimensionIndex] + _scales[dimensionIndex] * static_cast<float>(code);
+    }
+
+    /**
+     * Quantize \p numberOfPoints points of \p values (row-major) into \p codes
+     * @param values Values
+     * @param codes Codes (same layout as the values)
+     * @param numberOfPoints Number of points
+     */
+    template <typename CodeType>
+    void quantize(const float* values, CodeType* codes, std::size_t numberOfPoints) const
+    {
+        constexpr auto codeMinimum = static_cast<float>(std::numeric_limits<CodeType>::lowest());
+        constexpr auto codeMaximum = static_cast<float>(std::numeric_limits<CodeType>::max());
+
+        const auto numberOfDimensions   = static_cast<std::size_t>(getNumberOfDimensions());
+        const auto offsets              = _offsets.data();
+        const auto inverseScales        = _inverseScales.data();
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+            const auto pointValues  = values + pointIndex * numberOfDimensions;
+            const auto pointCodes   = codes + pointIndex * numberOfDimensions;
+
+            for (std::size_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++) {
+                const auto code = std::nearbyint((pointValues[dimensionIndex] - offsets[dimensionIndex]) * inverseScales[dimensionIndex]);
+
+                pointCodes[dimensionIndex] = static_cast<CodeType>(std::clamp(code, codeMinimum, codeMaximum));
+            }
+        }
+    }
+
+    /**
+     * Reconstruct \p numberOfPoints points from \p codes (row-major) into \p values
+     * @param codes Codes
+     * @param values Reconstructed values (same layout as the codes)
+     * @param numberOfPoints Number of points
+     */
+    template <typename CodeType>
+    void dequantize(const CodeType* codes, float* values, std::size_t numberOfPoints) const
+    {
+        const auto numberOfDimensions   = static_cast<std::size_t>(getNumberOfDimensions());
+        const auto scales               = _scales.data();
+        const auto offsets              = _offsets.data();
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+            const auto pointCodes   = codes + pointIndex * numberOfDimensions;
+            const auto pointValues  = values + pointIndex * numberOfDimensions;
+
+            for (std::size_t dimensionIndex = 0; dimensionIndex < numberOfDimensions; dimensionIndex++)
+                pointValues[dimensionIndex] = offsets[dimensionIndex] + scales[dimensionIndex] * static_cast<float>(pointCodes[dimensionIndex]);
+        }
+    }
+
+    /**
+     * Reconstruct dimensions \p dimensionIndices of \p numberOfPoints points into \p resultContainer (point-major)
+     * @param codes Codes of all points (row-major)
+     * @param dimensionIndices Dimensions to reconstruct
+     * @param numberOfPoints Number of points to reconstruct
+     * @param pointIndexFunction Maps the result point index to the index of the point in \p codes
+     * @param resultContainer Result container (must hold numberOfPoints * dimensionIndices.size() values)
+     */
+    template <typename CodeType, typename DimensionIndices, typename PointIndexFunction, typename ResultContainer>
+    void dequantizeDimensions(const CodeType* codes, const DimensionIndices& dimensionIndices, std::size_t numberOfPoints, PointIndexFunction pointIndexFunction, ResultContainer& resultContainer) const
+    {
+        const auto numberOfDimensions           = static_cast<std::size_t>(getNumberOfDimensions());
+        const auto numberOfSelectedDimensions   = static_cast<std::size_t>(std::size(dimensionIndices));
+
+        // Gather the scales and offsets once so that the inner loop only gathers codes
+        std::vector<std::size_t> selectedDimensions(numberOfSelectedDimensions);
+        std::vector<float> selectedScales(numberOfSelectedDimensions), selectedOffsets(numberOfSelectedDimensions);
+
+        std::size_t selectedDimensionIndex = 0;
+
+        for (const auto dimensionIndex : dimensionIndices) {
+            selectedDimensions[selectedDimensionIndex]  = static_cast<std::size_t>(dimensionIndex);
+            selectedScales[selectedDimensionIndex]      = _scales[dimensionIndex];
+            selectedOffsets[selectedDimensionIndex]     = _offsets[dimensionIndex];
+
+            selectedDimensionIndex++;
+        }
+
+        std::size_t resultIndex = 0;
+
+        for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+            const auto pointCodes = codes + static_cast<std::size_t>(pointIndexFunction(pointIndex)) * numberOfDimensions;
+
+            for (std::size_t index = 0; index < numberOfSelectedDimensions; index++)
+                resultContainer[resultIndex + index] = selectedOffsets[index] + selectedScales[index] * static_cast<float>(pointCodes[selectedDimensions[index]]);
+
+            resultIndex += numberOfSelectedDimensions;
+        }
+    }
+
+public: // Serialization
+
+    /**
+     * Load from variant map
+     * @param variantMap Variant map representation of the quantization
+     */
+    void fromVariantMap(const QVariantMap& variantMap);
+
+    /**
+     * Save to variant map
+     * @return Variant map representation of the quantization
+     */
+    QVariantMap toVariantMap() const;
+
+private:
+    std::vector<float>  _scales;            /** Scale per dimension */
+    std::vector<float>  _offsets;           /** Offset per dimension */
+    std::vector<float>  _inverseScales;     /** Inverse scale per dimension (zero for constant dimensions) */
+};
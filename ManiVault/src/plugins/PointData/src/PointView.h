@@ -42,7 +42,8 @@ namespace mv
             return _end;
         }
 
-        auto& operator[](std::size_t i) const
+        // Returns a reference for plain data iterators, and a value for dequantizing iterators.
+        decltype(auto) operator[](std::size_t i) const
         {
             return _begin[i];
         }
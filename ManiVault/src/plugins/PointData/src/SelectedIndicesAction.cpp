@@ -35,15 +35,15 @@ std::vector<std::uint32_t> SelectedIndicesAction::getSelectedIndices() const
     std::vector<std::uint32_t> selectedIndices;
 
     if (_points->isFull()) {
-        selectedIndices = selection->indices;
+        selectedIndices = selection->getIndices();
     }
     else {
         selectedIndices.clear();
-        selectedIndices.reserve(_points->indices.size());
+        selectedIndices.reserve(_points->getIndices().size());
 
-        QSet<std::uint32_t> indicesSet(_points->indices.begin(), _points->indices.end());
+        QSet<std::uint32_t> indicesSet(_points->getIndices().begin(), _points->getIndices().end());
 
-        for (const auto& selectionIndex : selection->indices)
+        for (const auto& selectionIndex : selection->getIndices())
             if (indicesSet.contains(selectionIndex))
                 selectedIndices.push_back(selectionIndex);
     }
@@ -230,6 +230,9 @@ public: // Selection
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /** Do not hide the move overload of the base class (which forwards to the copying overload above) */
+    using DatasetImpl::setSelectionIndices;
+
     /** Determines whether items can be selected */
     bool canSelect() const override;
 
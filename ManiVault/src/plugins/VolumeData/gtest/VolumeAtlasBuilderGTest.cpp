@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <VolumeAtlasBuilder.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <stdexcept>
+
+
+namespace
+{
+    /** Distinct value for each voxel and channel, so that misplaced elements are detected */
+    float getTestValue(std::uint64_t voxelIndex, std::uint32_t channel)
+    {
+        return static_cast<float>(voxelIndex) + 0.25f * static_cast<float>(channel);
+    }
+
+    std::uint64_t getVoxelIndex(const Size3D& volumeSize, std::int32_t x, std::int32_t y, std::int32_t z)
+    {
+        return (static_cast<std::uint64_t>(z) * volumeSize.height() + y) * volumeSize.width() + x;
+    }
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, placesBlocksAlongXWhenTheyFit)
+{
+    const auto layout = VolumeAtlasBuilder::computeLayout(Size3D(10, 8, 6), 9, 4, 2048);
+
+    ASSERT_EQ(layout.getNumberOfBlocks(), 3u);
+    ASSERT_EQ(layout._blockGridSize, Size3D(3, 1, 1));
+    ASSERT_EQ(layout._atlasSize, Size3D(30, 8, 6));
+    ASSERT_EQ(layout.getNumberOfElements(), 30u * 8u * 6u * 4u);
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, respectsTheMaximumTextureSize)
+{
+    // At most two blocks along x and y fit in a texture of 20 texels, so the three blocks are stacked along z
+    const auto layout = VolumeAtlasBuilder::computeLayout(Size3D(10, 8, 6), 12, 4, 20);
+
+    ASSERT_EQ(layout._blockGridSize, Size3D(1, 1, 3));
+    ASSERT_EQ(layout._atlasSize, Size3D(10, 8, 18));
+    ASSERT_LE(layout._atlasSize.width(), 20);
+    ASSERT_LE(layout._atlasSize.height(), 20);
+    ASSERT_LE(layout._atlasSize.depth(), 20);
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, usesTheLeastNumberOfBlocks)
+{
+    ASSERT_EQ(VolumeAtlasBuilder::findBlockGridSize(10, Size3D(2, 10, 10)), Size3D(2, 5, 1));
+    ASSERT_EQ(VolumeAtlasBuilder::findBlockGridSize(7, Size3D(2, 2, 2)), Size3D(2, 2, 2));
+    ASSERT_EQ(VolumeAtlasBuilder::findBlockGridSize(1, Size3D(1, 1, 1)), Size3D(1, 1, 1));
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, throwsWhenTheAtlasDoesNotFit)
+{
+    ASSERT_THROW(VolumeAtlasBuilder::computeLayout(Size3D(30, 8, 6), 4, 4, 20), std::runtime_error);
+    ASSERT_THROW(VolumeAtlasBuilder::computeLayout(Size3D(10, 10, 10), 4 * 9, 4, 20), std::runtime_error);
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, fillsChannelsAtTheirLayoutPosition)
+{
+    const Size3D volumeSize(7, 5, 3);
+
+    const auto layout = VolumeAtlasBuilder::computeLayout(volumeSize, 10, 4, 16);
+
+    std::vector<std::uint8_t> atlasData;
+
+    const auto channelRanges = VolumeAtlasBuilder::build(layout, getTestValue, VolumeAtlasBuilder::Format::Float32, atlasData);
+
+    ASSERT_EQ(atlasData.size(), layout.getNumberOfElements() * sizeof(float));
+    ASSERT_EQ(channelRanges.size(), 10u);
+
+    std::vector<float> atlas(layout.getNumberOfElements());
+
+    std::memcpy(atlas.data(), atlasData.data(), atlasData.size());
+
+    for (std::int32_t z = 0; z < volumeSize.depth(); z++) {
+        for (std::int32_t y = 0; y < volumeSize.height(); y++) {
+            for (std::int32_t x = 0; x < volumeSize.width(); x++) {
+                const auto voxelIndex = getVoxelIndex(volumeSize, x, y, z);
+
+                for (std::uint32_t channel = 0; channel < 10; channel++)
+                    ASSERT_FLOAT_EQ(atlas[layout.getElementIndex(channel, x, y, z)], getTestValue(voxelIndex, channel));
+
+                // The last block only holds two channels, the remaining texel elements are zero
+                for (std::uint32_t channel = 10; channel < 12; channel++)
+                    ASSERT_EQ(atlas[layout.getElementIndex(channel, x, y, z)], 0.f);
+            }
+        }
+    }
+
+    for (std::uint32_t channel = 0; channel < 10; channel++) {
+        ASSERT_FLOAT_EQ(channelRanges[channel].first, getTestValue(0, channel));
+        ASSERT_FLOAT_EQ(channelRanges[channel].second, getTestValue(7 * 5 * 3 - 1, channel));
+    }
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, elementIndexMatchesTheDocumentedLayout)
+{
+    const Size3D volumeSize(4, 3, 2);
+
+    const auto layout = VolumeAtlasBuilder::computeLayout(volumeSize, 4 * 6, 4, 8);
+
+    ASSERT_EQ(layout._blockGridSize, Size3D(2, 1, 3));
+
+    // Channel 21 lives in block 5, which is at block grid coordinate (1, 0, 2)
+    const auto atlasWidth   = static_cast<std::uint64_t>(layout._atlasSize.width());
+    const auto atlasHeight  = static_cast<std::uint64_t>(layout._atlasSize.height());
+    const auto expected     = (((2 * 2 + 1) * atlasHeight + (0 * 3 + 2)) * atlasWidth + (1 * 4 + 3)) * 4 + 1;
+
+    ASSERT_EQ(layout.getElementIndex(21, 3, 2, 1), expected);
+}
+
+
+GTEST_TEST(VolumeAtlasBuilder, emitsSmallerAtlasesForHalfAndNormalizedFormats)
+{
+    const Size3D volumeSize(6, 4, 2);
+
+    const auto layout = VolumeAtlasBuilder::computeLayout(volumeSize, 3, 4, 64);
+
+    std::vector<std::uint8_t> float32, float16, unorm8;
+
+    VolumeAtlasBuilder::build(layout, getTestValue, VolumeAtlasBuilder::Format::Float32, float32);
+    VolumeAtlasBuilder::build(layout, getTestValue, VolumeAtlasBuilder::Format::Float16, float16);
+
+    const auto channelRanges = VolumeAtlasBuilder::build(layout, getTestValue, VolumeAtlasBuilder::Format::UNorm8, unorm8);
+
+    ASSERT_EQ(float16.size() * 2, float32.size());
+    ASSERT_EQ(unorm8.size() * 4, float32.size());
+
+    const auto* halfAtlas = reinterpret_cast<const qfloat16*>(float16.data());
+
+    for (std::int32_t x = 0; x < volumeSize.width(); x++) {
+        const auto voxelIndex = getVoxelIndex(volumeSize, x, 3, 1);
+
+        for (std::uint32_t channel = 0; channel < 3; channel++) {
+            const auto elementIndex = layout.getElementIndex(channel, x, 3, 1);
+
+            ASSERT_NEAR(static_cast<float>(halfAtlas[elementIndex]), getTestValue(voxelIndex, channel), 0.05f);
+            ASSERT_EQ(unorm8[elementIndex], VolumeAtlasBuilder::encodeUNorm8(getTestValue(voxelIndex, channel), channelRanges[channel]));
+        }
+    }
+
+    // The channel extremes map onto the ends of the normalized range
+    ASSERT_EQ(unorm8[layout.getElementIndex(0, 0, 0, 0)], 0);
+    ASSERT_EQ(unorm8[layout.getElementIndex(0, 5, 3, 1)], 255);
+}
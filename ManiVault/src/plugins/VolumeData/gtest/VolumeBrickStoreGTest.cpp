@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+// The file to be tested:
+#include <VolumeBrickStore.h>
+
+// GoogleTest header file:
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    /** Analytic voxel value, exactly representable as a float for the volume sizes used in the tests */
+    float getVoxelValue(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t dimension)
+    {
+        return static_cast<float>(x + 100 * y + 10000 * z) + 0.5f * static_cast<float>(dimension);
+    }
+
+    /** Get a slab populator for a volume of \p volumeSize with \p numberOfDimensions */
+    VolumeBrickStore::SlabPopulator createSlabPopulator(const Size3D& volumeSize, std::uint32_t numberOfDimensions)
+    {
+        return [volumeSize, numberOfDimensions](std::int32_t zBegin, std::int32_t zEnd, float* slab) -> void {
+            for (std::int32_t z = zBegin; z < zEnd; z++)
+                for (std::int32_t y = 0; y < volumeSize.height(); y++)
+                    for (std::int32_t x = 0; x < volumeSize.width(); x++)
+                        for (std::uint32_t dimension = 0; dimension < numberOfDimensions; dimension++)
+                            slab[((static_cast<std::size_t>(z - zBegin) * volumeSize.height() + y) * volumeSize.width() + x) * numberOfDimensions + dimension] = getVoxelValue(x, y, z, dimension);
+        };
+    }
+
+    /** Expect that \p scalars of \p region (all \p numberOfDimensions interleaved) hold the analytic voxel values */
+    void expectRegionValues(const VolumeBrickStore::Region& region, std::uint32_t numberOfDimensions, const std::vector<float>& scalars)
+    {
+        ASSERT_EQ(scalars.size(), region.getNumberOfVoxels() * numberOfDimensions);
+
+        for (std::int32_t z = 0; z < region._depth; z++)
+            for (std::int32_t y = 0; y < region._height; y++)
+                for (std::int32_t x = 0; x < region._width; x++)
+                    for (std::uint32_t dimension = 0; dimension < numberOfDimensions; dimension++)
+                        ASSERT_EQ(scalars[((static_cast<std::size_t>(z) * region._height + y) * region._width + x) * numberOfDimensions + dimension], getVoxelValue(region._x + x, region._y + y, region._z + z, dimension));
+    }
+
+    /** Number of bytes of a decoded brick of \p brickSize voxels along each axis */
+    std::uint64_t getNumberOfBrickBytes(std::uint32_t brickSize, std::uint32_t numberOfDimensions)
+    {
+        return static_cast<std::uint64_t>(brickSize) * brickSize * brickSize * numberOfDimensions * sizeof(float);
+    }
+}
+
+
+TEST(VolumeBrickStore, throwsForEmptyVolume)
+{
+    VolumeBrickStore volumeBrickStore;
+
+    EXPECT_THROW(volumeBrickStore.build(Size3D(0, 4, 4), 1, createSlabPopulator(Size3D(0, 4, 4), 1)), std::runtime_error);
+    EXPECT_FALSE(volumeBrickStore.isBuilt());
+}
+
+
+TEST(VolumeBrickStore, addressesPartialBricksAtVolumeEdges)
+{
+    const Size3D volumeSize(70, 33, 5);
+
+    VolumeBrickStore volumeBrickStore(32);
+
+    volumeBrickStore.build(volumeSize, 2, createSlabPopulator(volumeSize, 2));
+
+    ASSERT_TRUE(volumeBrickStore.isBuilt());
+    EXPECT_EQ(volumeBrickStore.getBrickGridSize(0), Size3D(3, 2, 1));
+    EXPECT_EQ(volumeBrickStore.getNumberOfBricks(0), 6U);
+
+    // The last brick along each axis only covers the remainder of the volume
+    const auto& cornerRegion = volumeBrickStore.getBrickInfo(0, 5)._region;
+
+    EXPECT_EQ(cornerRegion._x, 64);
+    EXPECT_EQ(cornerRegion._y, 32);
+    EXPECT_EQ(cornerRegion._z, 0);
+    EXPECT_EQ(cornerRegion._width, 6);
+    EXPECT_EQ(cornerRegion._height, 1);
+    EXPECT_EQ(cornerRegion._depth, 5);
+
+    const auto cornerBrick = volumeBrickStore.getBrick(0, 5);
+
+    EXPECT_EQ(cornerBrick->_scalars.size(), 6U * 1U * 5U * 2U);
+    EXPECT_EQ(cornerBrick->getScalar(5, 0, 4, 1), getVoxelValue(69, 32, 4, 1));
+
+    // Regions on brick boundaries and (partially) outside the volume
+    EXPECT_EQ(volumeBrickStore.getBrickIndices(0, { 31, 31, 0, 2, 2, 1 }), (std::vector<std::uint32_t>{ 0, 1, 3, 4 }));
+    EXPECT_EQ(volumeBrickStore.getBrickIndices(0, { 60, 20, -10, 100, 100, 100 }), (std::vector<std::uint32_t>{ 1, 2, 4, 5 }));
+    EXPECT_TRUE(volumeBrickStore.getBrickIndices(0, { 70, 0, 0, 10, 10, 5 }).empty());
+    EXPECT_TRUE(volumeBrickStore.getBrickIndices(0, { 0, 0, 0, 0, 10, 5 }).empty());
+
+    EXPECT_EQ(volumeBrickStore.getRange(0), std::make_pair(getVoxelValue(0, 0, 0, 0), getVoxelValue(69, 32, 4, 0)));
+}
+
+
+TEST(VolumeBrickStore, copiesRegionsAcrossBricks)
+{
+    const Size3D volumeSize(40, 37, 19);
+
+    VolumeBrickStore volumeBrickStore(16);
+
+    volumeBrickStore.build(volumeSize, 3, createSlabPopulator(volumeSize, 3));
+
+    std::vector<float> scalars;
+
+    const auto region = volumeBrickStore.getRegion(0, { 0, 0, 0, 40, 37, 19 }, { 0, 1, 2 }, scalars);
+
+    expectRegionValues(region, 3, scalars);
+
+    // A region which crosses brick boundaries, with a subset of the dimensions
+    const auto subRegion = volumeBrickStore.getRegion(0, { 15, 14, 13, 3, 5, 4 }, { 2 }, scalars);
+
+    ASSERT_EQ(scalars.size(), subRegion.getNumberOfVoxels());
+
+    for (std::int32_t z = 0; z < subRegion._depth; z++)
+        for (std::int32_t y = 0; y < subRegion._height; y++)
+            for (std::int32_t x = 0; x < subRegion._width; x++)
+                EXPECT_EQ(scalars[(static_cast<std::size_t>(z) * subRegion._height + y) * subRegion._width + x], getVoxelValue(15 + x, 14 + y, 13 + z, 2));
+}
+
+
+TEST(VolumeBrickStore, clipsRegionsToTheVolume)
+{
+    const Size3D volumeSize(20, 10, 6);
+
+    VolumeBrickStore volumeBrickStore(8);
+
+    volumeBrickStore.build(volumeSize, 1, createSlabPopulator(volumeSize, 1));
+
+    std::vector<float> scalars;
+
+    const auto region = volumeBrickStore.getRegion(0, { -5, 7, 4, 10, 10, 10 }, { 0 }, scalars);
+
+    EXPECT_EQ(region._x, 0);
+    EXPECT_EQ(region._y, 7);
+    EXPECT_EQ(region._z, 4);
+    EXPECT_EQ(region._width, 5);
+    EXPECT_EQ(region._height, 3);
+    EXPECT_EQ(region._depth, 2);
+
+    expectRegionValues(region, 1, scalars);
+
+    const auto outsideRegion = volumeBrickStore.getRegion(0, { 20, 0, 0, 4, 4, 4 }, { 0 }, scalars);
+
+    EXPECT_TRUE(outsideRegion.isEmpty());
+    EXPECT_TRUE(scalars.empty());
+
+    EXPECT_THROW(volumeBrickStore.getRegion(0, { 0, 0, 0, 1, 1, 1 }, { 1 }, scalars), std::out_of_range);
+}
+
+
+TEST(VolumeBrickStore, buildsLevelsOfDetailWithOddSizes)
+{
+    const Size3D volumeSize(70, 33, 5);
+
+    VolumeBrickStore volumeBrickStore(32);
+
+    volumeBrickStore.build(volumeSize, 1, createSlabPopulator(volumeSize, 1));
+
+    // Each level halves (rounding up) the previous one until the volume fits in a single brick
+    ASSERT_EQ(volumeBrickStore.getNumberOfLevels(), 3U);
+    EXPECT_EQ(volumeBrickStore.getLevelSize(1), Size3D(35, 17, 3));
+    EXPECT_EQ(volumeBrickStore.getLevelSize(2), Size3D(18, 9, 2));
+    EXPECT_EQ(volumeBrickStore.getNumberOfBricks(2), 1U);
+
+    std::vector<float> scalars;
+
+    volumeBrickStore.getRegion(1, { 0, 0, 0, 35, 17, 3 }, { 0 }, scalars);
+
+    // Box filter over the (up to) 2x2x2 source voxels, the voxels at the odd edges average fewer source voxels
+    const auto getAverage = [&volumeSize](std::int32_t x, std::int32_t y, std::int32_t z) -> float {
+        float sum = 0.f;
+        std::int32_t count = 0;
+
+        for (std::int32_t sourceZ = 2 * z; sourceZ < std::min(2 * z + 2, volumeSize.depth()); sourceZ++)
+            for (std::int32_t sourceY = 2 * y; sourceY < std::min(2 * y + 2, volumeSize.height()); sourceY++)
+                for (std::int32_t sourceX = 2 * x; sourceX < std::min(2 * x + 2, volumeSize.width()); sourceX++, count++)
+                    sum += getVoxelValue(sourceX, sourceY, sourceZ, 0);
+
+        return sum / static_cast<float>(count);
+    };
+
+    EXPECT_FLOAT_EQ(scalars[0], getAverage(0, 0, 0));
+    EXPECT_FLOAT_EQ(scalars[(static_cast<std::size_t>(2) * 17 + 16) * 35 + 34], getAverage(34, 16, 2));
+    EXPECT_FLOAT_EQ(scalars[(static_cast<std::size_t>(1) * 17 + 8) * 35 + 17], getAverage(17, 8, 1));
+}
+
+
+TEST(VolumeBrickStore, evictsLeastRecentlyUsedBricksWithinTheBudget)
+{
+    const Size3D volumeSize(32, 8, 8);
+
+    VolumeBrickStore volumeBrickStore(8);
+
+    volumeBrickStore.build(volumeSize, 1, createSlabPopulator(volumeSize, 1));
+
+    const auto numberOfBrickBytes = getNumberOfBrickBytes(8, 1);
+
+    volumeBrickStore.setCacheBudget(2 * numberOfBrickBytes);
+
+    ASSERT_EQ(volumeBrickStore.getNumberOfBricks(0), 4U);
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 0U);
+
+    const auto brick0 = volumeBrickStore.getBrick(0, 0);
+    const auto brick1 = volumeBrickStore.getBrick(0, 1);
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 2 * numberOfBrickBytes);
+
+    // Cached bricks are shared, using brick 0 makes brick 1 the least recently used one
+    EXPECT_EQ(volumeBrickStore.getBrick(0, 0), brick0);
+
+    const auto brick2 = volumeBrickStore.getBrick(0, 2);
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 2 * numberOfBrickBytes);
+    EXPECT_EQ(volumeBrickStore.getBrick(0, 0), brick0);
+    EXPECT_EQ(volumeBrickStore.getBrick(0, 2), brick2);
+
+    // Brick 1 was evicted and is decoded again, the evicted brick remains valid for its holders
+    const auto reloadedBrick1 = volumeBrickStore.getBrick(0, 1);
+
+    EXPECT_NE(reloadedBrick1, brick1);
+    EXPECT_EQ(reloadedBrick1->_scalars, brick1->_scalars);
+    EXPECT_EQ(brick1->getScalar(7, 7, 7, 0), getVoxelValue(15, 7, 7, 0));
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 2 * numberOfBrickBytes);
+}
+
+
+TEST(VolumeBrickStore, shrinkingTheBudgetEvictsBricks)
+{
+    const Size3D volumeSize(32, 8, 8);
+
+    VolumeBrickStore volumeBrickStore(8);
+
+    volumeBrickStore.build(volumeSize, 1, createSlabPopulator(volumeSize, 1));
+
+    const auto numberOfBrickBytes = getNumberOfBrickBytes(8, 1);
+
+    volumeBrickStore.getBricks(0, { 0, 0, 0, 32, 8, 8 });
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 4 * numberOfBrickBytes);
+
+    volumeBrickStore.setCacheBudget(numberOfBrickBytes + 1);
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), numberOfBrickBytes);
+
+    // The most recently used brick is kept, even when it exceeds the budget on its own
+    const auto brick = volumeBrickStore.getBrick(0, 3);
+
+    volumeBrickStore.setCacheBudget(0);
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), numberOfBrickBytes);
+    EXPECT_EQ(volumeBrickStore.getBrick(0, 3), brick);
+
+    volumeBrickStore.clear();
+
+    EXPECT_EQ(volumeBrickStore.getCacheSize(), 0U);
+}
+
+
+TEST(VolumeBrickStore, storesBricksOutOfCore)
+{
+    const Size3D volumeSize(24, 20, 9);
+
+    const auto backingFilePath = (std::filesystem::temp_directory_path() / "VolumeBrickStoreGTest.bricks").string();
+
+    {
+        VolumeBrickStore volumeBrickStore(8);
+
+        volumeBrickStore.setBackingFilePath(backingFilePath);
+        volumeBrickStore.build(volumeSize, 2, createSlabPopulator(volumeSize, 2));
+
+        EXPECT_TRUE(std::filesystem::exists(backingFilePath));
+        EXPECT_EQ(std::filesystem::file_size(backingFilePath), volumeBrickStore.getNumberOfEncodedBytes());
+
+        // Decode from disk with a cache which only holds a single brick
+        volumeBrickStore.setCacheBudget(0);
+
+        std::vector<float> scalars;
+
+        const auto region = volumeBrickStore.getRegion(0, { 0, 0, 0, 24, 20, 9 }, { 0, 1 }, scalars);
+
+        expectRegionValues(region, 2, scalars);
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(backingFilePath));
+}
+
+
+TEST(VolumeBrickStore, quantizesBricksWithinTheBrickRange)
+{
+    const Size3D volumeSize(16, 16, 16);
+
+    for (const auto encoding : { VolumeBrickStore::Encoding::UInt16, VolumeBrickStore::Encoding::UInt8 }) {
+        VolumeBrickStore volumeBrickStore(8, encoding);
+
+        volumeBrickStore.build(volumeSize, 1, createSlabPopulator(volumeSize, 1), 1);
+
+        EXPECT_LT(volumeBrickStore.getNumberOfEncodedBytes(), getNumberOfBrickBytes(16, 1));
+
+        for (std::uint32_t brickIndex = 0; brickIndex < volumeBrickStore.getNumberOfBricks(0); brickIndex++) {
+            const auto& brickInfo   = volumeBrickStore.getBrickInfo(0, brickIndex);
+            const auto brick        = volumeBrickStore.getBrick(0, brickIndex);
+            const auto range        = brickInfo._maxima[0] - brickInfo._minima[0];
+            const auto tolerance    = range / (encoding == VolumeBrickStore::Encoding::UInt16 ? 65535.f : 255.f);
+            const auto& region      = brickInfo._region;
+
+            for (std::int32_t z = 0; z < region._depth; z++)
+                for (std::int32_t y = 0; y < region._height; y++)
+                    for (std::int32_t x = 0; x < region._width; x++)
+                        ASSERT_NEAR(brick->getScalar(x, y, z, 0), getVoxelValue(region._x + x, region._y + y, region._z + z, 0), tolerance);
+        }
+    }
+}
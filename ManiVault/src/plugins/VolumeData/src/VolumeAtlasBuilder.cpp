@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "VolumeAtlasBuilder.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+
+#include <stdexcept>
+#include <string>
+
+std::uint32_t VolumeAtlasBuilder::Layout::getNumberOfBlocks() const
+{
+    return (_numberOfChannels + _textureBlockDimensions - 1) / _textureBlockDimensions;
+}
+
+std::uint64_t VolumeAtlasBuilder::Layout::getNumberOfElements() const
+{
+    return static_cast<std::uint64_t>(_atlasSize.width()) * _atlasSize.height() * _atlasSize.depth() * _textureBlockDimensions;
+}
+
+std::uint64_t VolumeAtlasBuilder::Layout::getElementIndex(std::uint32_t channel, std::int32_t x, std::int32_t y, std::int32_t z) const
+{
+    const auto blockOrigin = getBlockOrigin(channel / _textureBlockDimensions);
+
+    return ((static_cast<std::uint64_t>(blockOrigin.depth() + z) * _atlasSize.height() + (blockOrigin.height() + y)) * _atlasSize.width() + (blockOrigin.width() + x)) * _textureBlockDimensions + channel % _textureBlockDimensions;
+}
+
+Size3D VolumeAtlasBuilder::Layout::getBlockOrigin(std::uint32_t block) const
+{
+    const auto blockX = static_cast<std::int32_t>(block % _blockGridSize.width());
+    const auto blockY = static_cast<std::int32_t>((block / _blockGridSize.width()) % _blockGridSize.height());
+    const auto blockZ = static_cast<std::int32_t>(block / (_blockGridSize.width() * _blockGridSize.height()));
+
+    return { blockX * _volumeSize.width(), blockY * _volumeSize.height(), blockZ * _volumeSize.depth() };
+}
+
+std::int32_t VolumeAtlasBuilder::getMaximum3DTextureSize()
+{
+    auto currentContext = QOpenGLContext::currentContext();
+
+    if (currentContext == nullptr)
+        return headlessMaximum3DTextureSize;
+
+    GLint maximum3DTextureSize = 0;
+
+    currentContext->functions()->glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE, &maximum3DTextureSize);
+
+    return maximum3DTextureSize > 0 ? static_cast<std::int32_t>(maximum3DTextureSize) : headlessMaximum3DTextureSize;
+}
+
+VolumeAtlasBuilder::Layout VolumeAtlasBuilder::computeLayout(const Size3D& volumeSize, std::uint32_t numberOfChannels, std::uint32_t textureBlockDimensions /*= 4*/, std::int32_t maximumTextureSize /*= 0*/)
+{
+    if (volumeSize.isEmpty())
+        throw std::runtime_error("Unable to compute the atlas layout of an empty volume");
+
+    if (textureBlockDimensions == 0)
+        throw std::runtime_error("Texture block dimensions must be larger than zero");
+
+    if (maximumTextureSize <= 0)
+        maximumTextureSize = getMaximum3DTextureSize();
+
+    Layout layout;
+
+    layout._volumeSize              = volumeSize;
+    layout._numberOfChannels        = numberOfChannels;
+    layout._textureBlockDimensions  = textureBlockDimensions;
+
+    const Size3D maximumBlockGridSize(maximumTextureSize / volumeSize.width(), maximumTextureSize / volumeSize.height(), maximumTextureSize / volumeSize.depth());
+
+    if (maximumBlockGridSize.isEmpty())
+        throw std::runtime_error("Volume exceeds the maximum 3D texture size of " + std::to_string(maximumTextureSize));
+
+    layout._blockGridSize   = findBlockGridSize(std::max(layout.getNumberOfBlocks(), 1u), maximumBlockGridSize);
+    layout._atlasSize       = Size3D(layout._blockGridSize.width() * volumeSize.width(), layout._blockGridSize.height() * volumeSize.height(), layout._blockGridSize.depth() * volumeSize.depth());
+
+    return layout;
+}
+
+Size3D VolumeAtlasBuilder::findBlockGridSize(std::uint32_t numberOfBlocks, const Size3D& maximumBlockGridSize)
+{
+    const auto blocks = static_cast<std::int64_t>(numberOfBlocks);
+
+    if (blocks > static_cast<std::int64_t>(maximumBlockGridSize.width()) * maximumBlockGridSize.height() * maximumBlockGridSize.depth())
+        throw std::runtime_error("Volume atlas with " + std::to_string(numberOfBlocks) + " blocks does not fit in a 3D texture");
+
+    Size3D bestBlockGridSize;
+
+    auto bestNumberOfCells = std::numeric_limits<std::int64_t>::max();
+
+    // Smallest grid wins, ties are resolved in favor of extending along x, then y
+    for (std::int64_t z = 1; z <= std::min<std::int64_t>(maximumBlockGridSize.depth(), blocks); z++) {
+        for (std::int64_t y = 1; y <= std::min<std::int64_t>(maximumBlockGridSize.height(), blocks); y++) {
+            const auto x = (blocks + y * z - 1) / (y * z);
+
+            if (x > maximumBlockGridSize.width())
+                continue;
+
+            const auto numberOfCells = x * y * z;
+
+            if (numberOfCells < bestNumberOfCells) {
+                bestNumberOfCells = numberOfCells;
+                bestBlockGridSize = Size3D(static_cast<int>(x), static_cast<int>(y), static_cast<int>(z));
+            }
+
+            if (numberOfCells == blocks)
+                return bestBlockGridSize;
+        }
+    }
+
+    return bestBlockGridSize;
+}
+
+std::uint32_t VolumeAtlasBuilder::getNumberOfBytesPerElement(Format format)
+{
+    switch (format)
+    {
+        case Format::Float32:
+            return sizeof(float);
+
+        case Format::Float16:
+            return sizeof(qfloat16);
+
+        case Format::UNorm8:
+            return sizeof(std::uint8_t);
+    }
+
+    return sizeof(float);
+}
+
+std::uint8_t VolumeAtlasBuilder::encodeUNorm8(float value, const std::pair<float, float>& range)
+{
+    const auto extent = range.second - range.first;
+
+    if (!(extent > 0.f) || !std::isfinite(value))
+        return 0;
+
+    return static_cast<std::uint8_t>(std::lround(std::clamp((value - range.first) / extent, 0.f, 1.f) * 255.f));
+}
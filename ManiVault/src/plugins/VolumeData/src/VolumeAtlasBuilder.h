@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "volumedata_export.h"
+#include "Size3D.h"
+
+#include <QFloat16>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
+/**
+ * Volume atlas builder class
+ *
+ * Packs the channels (dimensions) of a volume into a single 3D texture atlas. Channels are grouped in blocks of
+ * texture block dimensions (e.g. four channels per RGBA texel), and the blocks are tiled along x, y and z so that
+ * the atlas stays within the maximum 3D texture size of the device while wasting as few texels as possible.
+ *
+ * The atlas is filled in parallel: each work item is one z-slice of one block, and traverses the volume in z/y/x
+ * order so that voxel and texel indices are computed incrementally. Atlases can be emitted as 32-bit float,
+ * 16-bit half float or 8-bit normalized texels (normalized to the range of each channel).
+ *
+ * Atlas element of channel c at voxel (x, y, z), with block b = c / textureBlockDimensions at block grid coordinate (bx, by, bz):
+ *
+ *      (((bz * depth + z) * atlasHeight + (by * height + y)) * atlasWidth + (bx * width + x)) * textureBlockDimensions + c % textureBlockDimensions
+ *
+ * @author Thomas Kroes
+ */
+class VOLUMEDATA_EXPORT VolumeAtlasBuilder
+{
+public:
+
+    /** Atlas texel formats */
+    enum class Format {
+        Float32,    /** 32-bit float */
+        Float16,    /** 16-bit half float (halves the atlas memory) */
+        UNorm8      /** 8-bit unsigned normalized to the range of each channel (quarters the atlas memory) */
+    };
+
+    /** Atlas layout */
+    struct VOLUMEDATA_EXPORT Layout
+    {
+        Size3D          _volumeSize;                    /** Size of a single volume block in voxels */
+        std::uint32_t   _numberOfChannels = 0;          /** Number of channels to pack */
+        std::uint32_t   _textureBlockDimensions = 4;    /** Number of channels per texel */
+        Size3D          _blockGridSize;                 /** Number of blocks along each axis of the atlas */
+        Size3D          _atlasSize;                     /** Size of the atlas in texels */
+
+        /**
+         * Get the number of channel blocks
+         * @return Number of blocks
+         */
+        std::uint32_t getNumberOfBlocks() const;
+
+        /**
+         * Get the number of atlas elements (texels times texture block dimensions)
+         * @return Number of elements
+         */
+        std::uint64_t getNumberOfElements() const;
+
+        /**
+         * Get the atlas element index of \p channel at voxel (\p x, \p y, \p z)
+         * @param channel Channel index
+         * @param x Voxel x-coordinate
+         * @param y Voxel y-coordinate
+         * @param z Voxel z-coordinate
+         * @return Atlas element index
+         */
+        std::uint64_t getElementIndex(std::uint32_t channel, std::int32_t x, std::int32_t y, std::int32_t z) const;
+
+        /**
+         * Get the texel origin of \p block in the atlas
+         * @param block Block index
+         * @return Texel coordinate of the block origin (as a size triplet)
+         */
+        Size3D getBlockOrigin(std::uint32_t block) const;
+    };
+
+    /** Value range per channel */
+    using ChannelRanges = std::vector<std::pair<float, float>>;
+
+    /** Maximum 3D texture size when no OpenGL context is current (the minimum guaranteed by OpenGL 3.3+) */
+    static constexpr std::int32_t headlessMaximum3DTextureSize = 2048;
+
+public:
+
+    /**
+     * Get the maximum 3D texture size of the device, queried from the current OpenGL context (headless default when there is none)
+     * @return Maximum 3D texture size in texels along each axis
+     */
+    static std::int32_t getMaximum3DTextureSize();
+
+    /**
+     * Compute the atlas layout for \p numberOfChannels channels of a volume with \p volumeSize
+     * @param volumeSize Volume size in voxels
+     * @param numberOfChannels Number of channels to pack
+     * @param textureBlockDimensions Number of channels per texel
+     * @param maximumTextureSize Maximum 3D texture size (queried from the device when zero or negative)
+     * @return Atlas layout
+     */
+    static Layout computeLayout(const Size3D& volumeSize, std::uint32_t numberOfChannels, std::uint32_t textureBlockDimensions = 4, std::int32_t maximumTextureSize = 0);
+
+    /**
+     * Find the block grid with the least number of cells that holds \p numberOfBlocks blocks within \p maximumBlockGridSize (prefers x over y over z)
+     * @param numberOfBlocks Number of blocks to place
+     * @param maximumBlockGridSize Maximum number of blocks along each axis
+     * @return Block grid size
+     */
+    static Size3D findBlockGridSize(std::uint32_t numberOfBlocks, const Size3D& maximumBlockGridSize);
+
+    /**
+     * Get the number of bytes per atlas element for \p format
+     * @param format Texel format
+     * @return Number of bytes
+     */
+    static std::uint32_t getNumberOfBytesPerElement(Format format);
+
+    /**
+     * Encode \p value in the 8-bit normalized \p range
+     * @param value Value to encode
+     * @param range Channel range
+     * @return Encoded value
+     */
+    static std::uint8_t encodeUNorm8(float value, const std::pair<float, float>& range);
+
+public: // Building
+
+    /**
+     * Compute the value range of each channel in parallel
+     * @param layout Atlas layout
+     * @param getter Returns the value of a channel at a voxel index: float(std::uint64_t voxelIndex, std::uint32_t channel)
+     * @return Value range per channel
+     */
+    template<typename Getter>
+    static ChannelRanges computeChannelRanges(const Layout& layout, const Getter& getter)
+    {
+        const auto numberOfVoxels = static_cast<std::uint64_t>(layout._volumeSize.width()) * layout._volumeSize.height() * layout._volumeSize.depth();
+
+        ChannelRanges channelRanges(layout._numberOfChannels, { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() });
+
+        forEach(layout._numberOfChannels, [&](std::uint32_t channel) -> void {
+            auto& range = channelRanges[channel];
+
+            for (std::uint64_t voxelIndex = 0; voxelIndex < numberOfVoxels; voxelIndex++) {
+                const auto value = static_cast<float>(getter(voxelIndex, channel));
+
+                range.first     = std::min(range.first, value);
+                range.second    = std::max(range.second, value);
+            }
+        });
+
+        return channelRanges;
+    }
+
+    /**
+     * Fill \p atlas in parallel, each work item fills one z-slice of one block in z/y/x order (padding channels are set to zero)
+     * @param layout Atlas layout
+     * @param getter Returns the value of a channel at a voxel index: float(std::uint64_t voxelIndex, std::uint32_t channel)
+     * @param encoder Encodes a value into a texel element: Element(float value, std::uint32_t channel)
+     * @param atlas Atlas elements (at least Layout::getNumberOfElements() elements)
+     */
+    template<typename Element, typename Getter, typename Encoder>
+    static void fill(const Layout& layout, const Getter& getter, const Encoder& encoder, Element* atlas)
+    {
+        const auto width                    = layout._volumeSize.width();
+        const auto height                   = layout._volumeSize.height();
+        const auto depth                    = layout._volumeSize.depth();
+        const auto atlasWidth               = static_cast<std::uint64_t>(layout._atlasSize.width());
+        const auto atlasHeight              = static_cast<std::uint64_t>(layout._atlasSize.height());
+        const auto textureBlockDimensions   = layout._textureBlockDimensions;
+        const auto numberOfBlocks           = layout.getNumberOfBlocks();
+
+        forEach(numberOfBlocks * static_cast<std::uint32_t>(depth), [&](std::uint32_t workItem) -> void {
+            const auto block        = workItem / static_cast<std::uint32_t>(depth);
+            const auto z            = static_cast<std::int32_t>(workItem % static_cast<std::uint32_t>(depth));
+            const auto blockOrigin  = layout.getBlockOrigin(block);
+            const auto firstChannel = block * textureBlockDimensions;
+            const auto lastChannel  = std::min(firstChannel + textureBlockDimensions, layout._numberOfChannels);
+
+            auto voxelIndex = static_cast<std::uint64_t>(z) * height * width;
+
+            for (std::int32_t y = 0; y < height; y++) {
+                auto elementIndex = ((static_cast<std::uint64_t>(blockOrigin.depth() + z) * atlasHeight + (blockOrigin.height() + y)) * atlasWidth + blockOrigin.width()) * textureBlockDimensions;
+
+                for (std::int32_t x = 0; x < width; x++, voxelIndex++, elementIndex += textureBlockDimensions) {
+                    for (std::uint32_t channel = firstChannel; channel < lastChannel; channel++)
+                        atlas[elementIndex + channel - firstChannel] = encoder(static_cast<float>(getter(voxelIndex, channel)), channel);
+
+                    for (std::uint32_t channel = lastChannel; channel < firstChannel + textureBlockDimensions; channel++)
+                        atlas[elementIndex + channel - firstChannel] = Element{};
+                }
+            }
+        });
+    }
+
+    /**
+     * Build an atlas in \p format into \p atlasData (resized to the layout)
+     * @param layout Atlas layout
+     * @param getter Returns the value of a channel at a voxel index: float(std::uint64_t voxelIndex, std::uint32_t channel)
+     * @param format Texel format
+     * @param atlasData Atlas bytes (float, qfloat16 or std::uint8_t elements depending on the format)
+     * @return Value range per channel
+     */
+    template<typename Getter>
+    static ChannelRanges build(const Layout& layout, const Getter& getter, Format format, std::vector<std::uint8_t>& atlasData)
+    {
+        const auto channelRanges = computeChannelRanges(layout, getter);
+
+        atlasData.resize(layout.getNumberOfElements() * getNumberOfBytesPerElement(format));
+
+        switch (format)
+        {
+            case Format::Float32:
+                fill(layout, getter, [](float value, std::uint32_t) -> float { return value; }, reinterpret_cast<float*>(atlasData.data()));
+                break;
+
+            case Format::Float16:
+                fill(layout, getter, [](float value, std::uint32_t) -> qfloat16 { return qfloat16(value); }, reinterpret_cast<qfloat16*>(atlasData.data()));
+                break;
+
+            case Format::UNorm8:
+                fill(layout, getter, [&channelRanges](float value, std::uint32_t channel) -> std::uint8_t { return encodeUNorm8(value, channelRanges[channel]); }, atlasData.data());
+                break;
+        }
+
+        return channelRanges;
+    }
+
+private:
+
+    /**
+     * Invoke \p function for [0, \p count) in parallel (sequentially on macOS)
+     * @param count Number of invocations
+     * @param function Function taking the invocation index
+     */
+    template<typename Function>
+    static void forEach(std::uint32_t count, const Function& function)
+    {
+        std::vector<std::uint32_t> indices(count);
+
+        std::iota(indices.begin(), indices.end(), 0u);
+
+#ifndef __APPLE__
+        std::for_each(std::execution::par, indices.begin(), indices.end(), function);
+#else
+        std::for_each(indices.begin(), indices.end(), function);
+#endif
+    }
+};
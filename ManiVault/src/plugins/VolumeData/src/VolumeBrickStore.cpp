@@ -0,0 +1,637 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "VolumeBrickStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace
+{
+    /**
+     * Get the cache key for brick \p brickIndex at \p level
+     * @param level Level of detail
+     * @param brickIndex Brick index
+     * @return Cache key
+     */
+    std::uint64_t getCacheKey(std::uint32_t level, std::uint32_t brickIndex)
+    {
+        return (static_cast<std::uint64_t>(level) << 32) | brickIndex;
+    }
+
+    /**
+     * Get the number of bricks needed to cover \p size voxels
+     * @param size Number of voxels along an axis
+     * @param brickSize Brick size
+     * @return Number of bricks
+     */
+    std::int32_t getNumberOfBricksForSize(std::int32_t size, std::uint32_t brickSize)
+    {
+        return (size + static_cast<std::int32_t>(brickSize) - 1) / static_cast<std::int32_t>(brickSize);
+    }
+}
+
+bool VolumeBrickStore::Region::isEmpty() const
+{
+    return _width <= 0 || _height <= 0 || _depth <= 0;
+}
+
+std::uint64_t VolumeBrickStore::Region::getNumberOfVoxels() const
+{
+    if (isEmpty())
+        return 0;
+
+    return static_cast<std::uint64_t>(_width) * _height * _depth;
+}
+
+bool VolumeBrickStore::Region::intersects(const Region& other) const
+{
+    return !intersected(other).isEmpty();
+}
+
+VolumeBrickStore::Region VolumeBrickStore::Region::intersected(const Region& other) const
+{
+    Region intersection;
+
+    intersection._x         = std::max(_x, other._x);
+    intersection._y         = std::max(_y, other._y);
+    intersection._z         = std::max(_z, other._z);
+    intersection._width     = std::min(_x + _width, other._x + other._width) - intersection._x;
+    intersection._height    = std::min(_y + _height, other._y + other._height) - intersection._y;
+    intersection._depth     = std::min(_z + _depth, other._z + other._depth) - intersection._z;
+
+    if (intersection.isEmpty())
+        return {};
+
+    return intersection;
+}
+
+VolumeBrickStore::VolumeBrickStore(std::uint32_t brickSize /*= defaultBrickSize*/, Encoding encoding /*= Encoding::Float32*/) :
+    _brickSize(std::max(brickSize, 1u)),
+    _encoding(encoding),
+    _numberOfDimensions(0),
+    _levels(),
+    _ranges(),
+    _backingFilePath(),
+    _backingFile(),
+    _encodedBricks(),
+    _numberOfEncodedBytes(0),
+    _cacheBudget(defaultCacheBudget),
+    _cache(),
+    _cacheSize(0),
+    _usageCounter(0),
+    _mutex()
+{
+}
+
+VolumeBrickStore::~VolumeBrickStore()
+{
+    clear();
+}
+
+void VolumeBrickStore::setBackingFilePath(const std::string& backingFilePath)
+{
+    if (isBuilt())
+        throw std::runtime_error("Backing file path cannot be changed once the brick store is built");
+
+    _backingFilePath = backingFilePath;
+}
+
+std::string VolumeBrickStore::getBackingFilePath() const
+{
+    return _backingFilePath;
+}
+
+void VolumeBrickStore::build(const Size3D& volumeSize, std::uint32_t numberOfDimensions, const SlabPopulator& slabPopulator, std::uint32_t numberOfLevels /*= 0*/)
+{
+    clear();
+
+    if (volumeSize.isEmpty() || numberOfDimensions == 0)
+        throw std::runtime_error("Unable to build brick store for an empty volume");
+
+    if (!_backingFilePath.empty()) {
+        _backingFile.open(_backingFilePath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+
+        if (!_backingFile.is_open())
+            throw std::runtime_error("Unable to open brick store backing file " + _backingFilePath);
+    }
+
+    _numberOfDimensions = numberOfDimensions;
+    _ranges.assign(_numberOfDimensions, { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() });
+
+    // Establish the levels of detail, each level halves the previous until the volume fits in a single brick
+    const auto brickSize = static_cast<std::int32_t>(_brickSize);
+
+    auto levelSize = volumeSize;
+
+    while (true) {
+        Level level;
+
+        level._size             = levelSize;
+        level._brickGridSize    = Size3D(getNumberOfBricksForSize(levelSize.width(), _brickSize), getNumberOfBricksForSize(levelSize.height(), _brickSize), getNumberOfBricksForSize(levelSize.depth(), _brickSize));
+
+        level._bricks.resize(static_cast<std::size_t>(level._brickGridSize.width()) * level._brickGridSize.height() * level._brickGridSize.depth());
+
+        _levels.push_back(std::move(level));
+
+        const auto fitsInBrick = levelSize.width() <= brickSize && levelSize.height() <= brickSize && levelSize.depth() <= brickSize;
+
+        if (numberOfLevels > 0 ? _levels.size() >= numberOfLevels : fitsInBrick)
+            break;
+
+        if (levelSize.width() == 1 && levelSize.height() == 1 && levelSize.depth() == 1)
+            break;
+
+        levelSize = Size3D((levelSize.width() + 1) / 2, (levelSize.height() + 1) / 2, (levelSize.depth() + 1) / 2);
+    }
+
+    // Populate the full resolution level one slab (one row of bricks along z) at a time
+    auto& fullResolutionLevel = _levels.front();
+
+    const auto width    = volumeSize.width();
+    const auto height   = volumeSize.height();
+
+    std::vector<float> slab, scalars;
+
+    for (std::int32_t brickZ = 0; brickZ < fullResolutionLevel._brickGridSize.depth(); brickZ++) {
+        const auto zBegin   = brickZ * brickSize;
+        const auto zEnd     = std::min(zBegin + brickSize, volumeSize.depth());
+
+        slab.assign(static_cast<std::size_t>(zEnd - zBegin) * height * width * _numberOfDimensions, 0.f);
+
+        slabPopulator(zBegin, zEnd, slab.data());
+
+        for (std::int32_t brickY = 0; brickY < fullResolutionLevel._brickGridSize.height(); brickY++) {
+            for (std::int32_t brickX = 0; brickX < fullResolutionLevel._brickGridSize.width(); brickX++) {
+                const auto brickIndex   = (static_cast<std::size_t>(brickZ) * fullResolutionLevel._brickGridSize.height() + brickY) * fullResolutionLevel._brickGridSize.width() + brickX;
+                auto& brickInfo         = fullResolutionLevel._bricks[brickIndex];
+
+                brickInfo._region = getBrickRegion(fullResolutionLevel, brickX, brickY, brickZ);
+
+                const auto& region  = brickInfo._region;
+                const auto rowSize  = static_cast<std::size_t>(region._width) * _numberOfDimensions;
+
+                scalars.resize(region.getNumberOfVoxels() * _numberOfDimensions);
+
+                for (std::int32_t z = 0; z < region._depth; z++) {
+                    for (std::int32_t y = 0; y < region._height; y++) {
+                        const auto source   = slab.begin() + ((static_cast<std::size_t>(region._z - zBegin + z) * height + region._y + y) * width + region._x) * _numberOfDimensions;
+                        const auto target   = scalars.begin() + (static_cast<std::size_t>(z) * region._height + y) * rowSize;
+
+                        std::copy(source, source + rowSize, target);
+                    }
+                }
+
+                storeBrick(brickInfo, scalars);
+
+                for (std::uint32_t dimension = 0; dimension < _numberOfDimensions; dimension++) {
+                    _ranges[dimension].first    = std::min(_ranges[dimension].first, brickInfo._minima[dimension]);
+                    _ranges[dimension].second   = std::max(_ranges[dimension].second, brickInfo._maxima[dimension]);
+                }
+            }
+        }
+    }
+
+    for (std::uint32_t level = 1; level < _levels.size(); level++)
+        buildLevel(level);
+
+    if (_backingFile.is_open())
+        _backingFile.flush();
+}
+
+void VolumeBrickStore::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _numberOfDimensions     = 0;
+    _numberOfEncodedBytes   = 0;
+    _cacheSize              = 0;
+
+    _levels.clear();
+    _ranges.clear();
+    _encodedBricks.clear();
+    _encodedBricks.shrink_to_fit();
+    _cache.clear();
+
+    if (_backingFile.is_open()) {
+        _backingFile.close();
+
+        std::remove(_backingFilePath.c_str());
+    }
+}
+
+bool VolumeBrickStore::isBuilt() const
+{
+    return !_levels.empty();
+}
+
+std::uint32_t VolumeBrickStore::getBrickSize() const
+{
+    return _brickSize;
+}
+
+VolumeBrickStore::Encoding VolumeBrickStore::getEncoding() const
+{
+    return _encoding;
+}
+
+std::uint32_t VolumeBrickStore::getNumberOfDimensions() const
+{
+    return _numberOfDimensions;
+}
+
+std::uint32_t VolumeBrickStore::getNumberOfLevels() const
+{
+    return static_cast<std::uint32_t>(_levels.size());
+}
+
+Size3D VolumeBrickStore::getLevelSize(std::uint32_t level) const
+{
+    return _levels.at(level)._size;
+}
+
+Size3D VolumeBrickStore::getBrickGridSize(std::uint32_t level) const
+{
+    return _levels.at(level)._brickGridSize;
+}
+
+std::uint32_t VolumeBrickStore::getNumberOfBricks(std::uint32_t level) const
+{
+    return static_cast<std::uint32_t>(_levels.at(level)._bricks.size());
+}
+
+const VolumeBrickStore::BrickInfo& VolumeBrickStore::getBrickInfo(std::uint32_t level, std::uint32_t brickIndex) const
+{
+    return _levels.at(level)._bricks.at(brickIndex);
+}
+
+std::pair<float, float> VolumeBrickStore::getRange(std::uint32_t dimension) const
+{
+    return _ranges.at(dimension);
+}
+
+std::uint64_t VolumeBrickStore::getNumberOfEncodedBytes() const
+{
+    return _numberOfEncodedBytes;
+}
+
+std::vector<std::uint32_t> VolumeBrickStore::getBrickIndices(std::uint32_t level, const Region& region) const
+{
+    const auto& currentLevel    = _levels.at(level);
+    const auto clippedRegion    = region.intersected({ 0, 0, 0, currentLevel._size.width(), currentLevel._size.height(), currentLevel._size.depth() });
+
+    std::vector<std::uint32_t> brickIndices;
+
+    if (clippedRegion.isEmpty())
+        return brickIndices;
+
+    const auto brickSize = static_cast<std::int32_t>(_brickSize);
+
+    for (std::int32_t brickZ = clippedRegion._z / brickSize; brickZ <= (clippedRegion._z + clippedRegion._depth - 1) / brickSize; brickZ++)
+        for (std::int32_t brickY = clippedRegion._y / brickSize; brickY <= (clippedRegion._y + clippedRegion._height - 1) / brickSize; brickY++)
+            for (std::int32_t brickX = clippedRegion._x / brickSize; brickX <= (clippedRegion._x + clippedRegion._width - 1) / brickSize; brickX++)
+                brickIndices.push_back(static_cast<std::uint32_t>((brickZ * currentLevel._brickGridSize.height() + brickY) * currentLevel._brickGridSize.width() + brickX));
+
+    return brickIndices;
+}
+
+VolumeBrickStore::SharedBrick VolumeBrickStore::getBrick(std::uint32_t level, std::uint32_t brickIndex) const
+{
+    const auto cacheKey = getCacheKey(level, brickIndex);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _cache.find(cacheKey);
+
+        if (it != _cache.end()) {
+            it->second._lastUsed = ++_usageCounter;
+
+            return it->second._brick;
+        }
+    }
+
+    auto brick = loadBrick(level, brickIndex);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Another thread may have loaded the same brick in the meantime
+    auto [it, inserted] = _cache.insert({ cacheKey, { brick, 0 } });
+
+    it->second._lastUsed = ++_usageCounter;
+
+    if (inserted) {
+        _cacheSize += brick->_scalars.size() * sizeof(float);
+
+        evict();
+    }
+
+    return it->second._brick;
+}
+
+VolumeBrickStore::Bricks VolumeBrickStore::getBricks(std::uint32_t level, const Region& region) const
+{
+    Bricks bricks;
+
+    for (const auto& brickIndex : getBrickIndices(level, region))
+        bricks.push_back(getBrick(level, brickIndex));
+
+    return bricks;
+}
+
+VolumeBrickStore::Region VolumeBrickStore::getRegion(std::uint32_t level, const Region& region, const std::vector<std::uint32_t>& dimensions, std::vector<float>& scalars) const
+{
+    const auto& currentLevel    = _levels.at(level);
+    const auto clippedRegion    = region.intersected({ 0, 0, 0, currentLevel._size.width(), currentLevel._size.height(), currentLevel._size.depth() });
+    const auto numberOfTargetDimensions = dimensions.size();
+
+    for (const auto& dimension : dimensions)
+        if (dimension >= _numberOfDimensions)
+            throw std::out_of_range("Brick store dimension index out of range");
+
+    scalars.resize(clippedRegion.getNumberOfVoxels() * numberOfTargetDimensions);
+
+    if (clippedRegion.isEmpty())
+        return clippedRegion;
+
+    for (const auto& brick : getBricks(level, clippedRegion)) {
+        const auto overlap = brick->_region.intersected(clippedRegion);
+
+        for (std::int32_t z = overlap._z; z < overlap._z + overlap._depth; z++) {
+            for (std::int32_t y = overlap._y; y < overlap._y + overlap._height; y++) {
+                for (std::int32_t x = overlap._x; x < overlap._x + overlap._width; x++) {
+                    const auto targetIndex = ((static_cast<std::size_t>(z - clippedRegion._z) * clippedRegion._height + (y - clippedRegion._y)) * clippedRegion._width + (x - clippedRegion._x)) * numberOfTargetDimensions;
+
+                    for (std::size_t targetDimension = 0; targetDimension < numberOfTargetDimensions; targetDimension++)
+                        scalars[targetIndex + targetDimension] = brick->getScalar(x - brick->_region._x, y - brick->_region._y, z - brick->_region._z, dimensions[targetDimension]);
+                }
+            }
+        }
+    }
+
+    return clippedRegion;
+}
+
+std::uint64_t VolumeBrickStore::getCacheBudget() const
+{
+    return _cacheBudget;
+}
+
+void VolumeBrickStore::setCacheBudget(std::uint64_t cacheBudget)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _cacheBudget = cacheBudget;
+
+    evict();
+}
+
+std::uint64_t VolumeBrickStore::getCacheSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _cacheSize;
+}
+
+VolumeBrickStore::Region VolumeBrickStore::getBrickRegion(const Level& level, std::int32_t brickX, std::int32_t brickY, std::int32_t brickZ) const
+{
+    const auto brickSize = static_cast<std::int32_t>(_brickSize);
+
+    Region region;
+
+    region._x       = brickX * brickSize;
+    region._y       = brickY * brickSize;
+    region._z       = brickZ * brickSize;
+    region._width   = std::min(brickSize, level._size.width() - region._x);
+    region._height  = std::min(brickSize, level._size.height() - region._y);
+    region._depth   = std::min(brickSize, level._size.depth() - region._z);
+
+    return region;
+}
+
+void VolumeBrickStore::storeBrick(BrickInfo& brickInfo, const std::vector<float>& scalars)
+{
+    const auto numberOfVoxels = brickInfo._region.getNumberOfVoxels();
+
+    brickInfo._minima.assign(_numberOfDimensions, std::numeric_limits<float>::max());
+    brickInfo._maxima.assign(_numberOfDimensions, std::numeric_limits<float>::lowest());
+
+    for (std::uint64_t voxelIndex = 0; voxelIndex < numberOfVoxels; voxelIndex++) {
+        for (std::uint32_t dimension = 0; dimension < _numberOfDimensions; dimension++) {
+            const auto scalar = scalars[voxelIndex * _numberOfDimensions + dimension];
+
+            if (!std::isfinite(scalar))
+                continue;
+
+            brickInfo._minima[dimension] = std::min(brickInfo._minima[dimension], scalar);
+            brickInfo._maxima[dimension] = std::max(brickInfo._maxima[dimension], scalar);
+        }
+    }
+
+    // Bricks without finite values get an empty (zero) range
+    for (std::uint32_t dimension = 0; dimension < _numberOfDimensions; dimension++) {
+        if (brickInfo._minima[dimension] > brickInfo._maxima[dimension]) {
+            brickInfo._minima[dimension] = 0.f;
+            brickInfo._maxima[dimension] = 0.f;
+        }
+    }
+
+    std::vector<std::uint8_t> encoded(scalars.size() * getNumberOfBytesPerScalar());
+
+    const auto quantize = [this, &brickInfo, &scalars](auto* target, float maximumValue) -> void {
+        using Target = std::remove_pointer_t<decltype(target)>;
+
+        for (std::size_t scalarIndex = 0; scalarIndex < scalars.size(); scalarIndex++) {
+            const auto dimension    = scalarIndex % _numberOfDimensions;
+            const auto minimum      = brickInfo._minima[dimension];
+            const auto range        = brickInfo._maxima[dimension] - minimum;
+            const auto scalar       = scalars[scalarIndex];
+            const auto normalized   = (range > 0.f && std::isfinite(scalar)) ? std::clamp((scalar - minimum) / range, 0.f, 1.f) : 0.f;
+
+            target[scalarIndex] = static_cast<Target>(std::lround(normalized * maximumValue));
+        }
+    };
+
+    switch (_encoding)
+    {
+        case Encoding::Float32:
+            std::memcpy(encoded.data(), scalars.data(), encoded.size());
+            break;
+
+        case Encoding::UInt16:
+            quantize(reinterpret_cast<std::uint16_t*>(encoded.data()), 65535.f);
+            break;
+
+        case Encoding::UInt8:
+            quantize(encoded.data(), 255.f);
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    brickInfo._offset           = _numberOfEncodedBytes;
+    brickInfo._numberOfBytes    = encoded.size();
+
+    if (_backingFile.is_open()) {
+        _backingFile.seekp(static_cast<std::streamoff>(brickInfo._offset));
+        _backingFile.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+
+        if (!_backingFile)
+            throw std::runtime_error("Unable to write brick to backing file " + _backingFilePath);
+    }
+    else {
+        _encodedBricks.insert(_encodedBricks.end(), encoded.begin(), encoded.end());
+    }
+
+    _numberOfEncodedBytes += encoded.size();
+}
+
+VolumeBrickStore::SharedBrick VolumeBrickStore::loadBrick(std::uint32_t level, std::uint32_t brickIndex) const
+{
+    const auto& brickInfo = _levels.at(level)._bricks.at(brickIndex);
+
+    std::vector<std::uint8_t> encoded(brickInfo._numberOfBytes);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_backingFile.is_open()) {
+            _backingFile.seekg(static_cast<std::streamoff>(brickInfo._offset));
+            _backingFile.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+
+            if (!_backingFile)
+                throw std::runtime_error("Unable to read brick from backing file " + _backingFilePath);
+        }
+        else {
+            std::copy_n(_encodedBricks.begin() + brickInfo._offset, encoded.size(), encoded.begin());
+        }
+    }
+
+    auto brick = std::make_shared<Brick>();
+
+    brick->_level               = level;
+    brick->_index               = brickIndex;
+    brick->_region              = brickInfo._region;
+    brick->_numberOfDimensions  = _numberOfDimensions;
+
+    brick->_scalars.resize(brickInfo._region.getNumberOfVoxels() * _numberOfDimensions);
+
+    const auto dequantize = [this, &brickInfo, &brick](const auto* source, float maximumValue) -> void {
+        for (std::size_t scalarIndex = 0; scalarIndex < brick->_scalars.size(); scalarIndex++) {
+            const auto dimension    = scalarIndex % _numberOfDimensions;
+            const auto minimum      = brickInfo._minima[dimension];
+            const auto range        = brickInfo._maxima[dimension] - minimum;
+
+            brick->_scalars[scalarIndex] = minimum + range * (static_cast<float>(source[scalarIndex]) / maximumValue);
+        }
+    };
+
+    switch (_encoding)
+    {
+        case Encoding::Float32:
+            std::memcpy(brick->_scalars.data(), encoded.data(), encoded.size());
+            break;
+
+        case Encoding::UInt16:
+            dequantize(reinterpret_cast<const std::uint16_t*>(encoded.data()), 65535.f);
+            break;
+
+        case Encoding::UInt8:
+            dequantize(encoded.data(), 255.f);
+            break;
+    }
+
+    return brick;
+}
+
+void VolumeBrickStore::buildLevel(std::uint32_t level)
+{
+    auto& currentLevel = _levels[level];
+
+    std::vector<float> scalars, sums;
+    std::vector<std::uint32_t> counts;
+
+    for (std::int32_t brickZ = 0; brickZ < currentLevel._brickGridSize.depth(); brickZ++) {
+        for (std::int32_t brickY = 0; brickY < currentLevel._brickGridSize.height(); brickY++) {
+            for (std::int32_t brickX = 0; brickX < currentLevel._brickGridSize.width(); brickX++) {
+                const auto brickIndex   = (static_cast<std::size_t>(brickZ) * currentLevel._brickGridSize.height() + brickY) * currentLevel._brickGridSize.width() + brickX;
+                auto& brickInfo         = currentLevel._bricks[brickIndex];
+
+                brickInfo._region = getBrickRegion(currentLevel, brickX, brickY, brickZ);
+
+                const auto& region      = brickInfo._region;
+                const auto numberOfVoxels = region.getNumberOfVoxels();
+
+                sums.assign(numberOfVoxels * _numberOfDimensions, 0.f);
+                counts.assign(numberOfVoxels, 0);
+
+                // Region of the previous level covered by this brick (2x2x2 source voxels per target voxel)
+                const Region sourceRegion{ 2 * region._x, 2 * region._y, 2 * region._z, 2 * region._width, 2 * region._height, 2 * region._depth };
+
+                // Accumulate the source voxels from the (at most eight) child bricks, bypassing the cache so that building does not evict bricks in use
+                for (const auto& sourceBrickIndex : getBrickIndices(level - 1, sourceRegion)) {
+                    const auto sourceBrick  = loadBrick(level - 1, sourceBrickIndex);
+                    const auto overlap      = sourceBrick->_region.intersected(sourceRegion);
+
+                    for (std::int32_t z = overlap._z; z < overlap._z + overlap._depth; z++) {
+                        for (std::int32_t y = overlap._y; y < overlap._y + overlap._height; y++) {
+                            for (std::int32_t x = overlap._x; x < overlap._x + overlap._width; x++) {
+                                const auto targetVoxelIndex = (static_cast<std::size_t>(z / 2 - region._z) * region._height + (y / 2 - region._y)) * region._width + (x / 2 - region._x);
+
+                                for (std::uint32_t dimension = 0; dimension < _numberOfDimensions; dimension++)
+                                    sums[targetVoxelIndex * _numberOfDimensions + dimension] += sourceBrick->getScalar(x - sourceBrick->_region._x, y - sourceBrick->_region._y, z - sourceBrick->_region._z, dimension);
+
+                                counts[targetVoxelIndex]++;
+                            }
+                        }
+                    }
+                }
+
+                scalars.resize(sums.size());
+
+                for (std::uint64_t voxelIndex = 0; voxelIndex < numberOfVoxels; voxelIndex++)
+                    for (std::uint32_t dimension = 0; dimension < _numberOfDimensions; dimension++)
+                        scalars[voxelIndex * _numberOfDimensions + dimension] = counts[voxelIndex] > 0 ? sums[voxelIndex * _numberOfDimensions + dimension] / static_cast<float>(counts[voxelIndex]) : 0.f;
+
+                storeBrick(brickInfo, scalars);
+            }
+        }
+    }
+}
+
+void VolumeBrickStore::evict() const
+{
+    // Always keep the most recently used brick, even when it exceeds the budget on its own
+    while (_cacheSize > _cacheBudget && _cache.size() > 1) {
+        const auto leastRecentlyUsed = std::min_element(_cache.begin(), _cache.end(), [](const auto& lhs, const auto& rhs) -> bool {
+            return lhs.second._lastUsed < rhs.second._lastUsed;
+        });
+
+        _cacheSize -= leastRecentlyUsed->second._brick->_scalars.size() * sizeof(float);
+
+        _cache.erase(leastRecentlyUsed);
+    }
+}
+
+std::uint32_t VolumeBrickStore::getNumberOfBytesPerScalar() const
+{
+    switch (_encoding)
+    {
+        case Encoding::Float32:
+            return sizeof(float);
+
+        case Encoding::UInt16:
+            return sizeof(std::uint16_t);
+
+        case Encoding::UInt8:
+            return sizeof(std::uint8_t);
+    }
+
+    return sizeof(float);
+}
@@ -0,0 +1,376 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "volumedata_export.h"
+#include "Size3D.h"
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Volume brick store class
+ *
+ * Stores a multi-dimensional volume as fixed-size bricks (e.g. 32x32x32 voxels) so that renderers only need to fetch
+ * the bricks which intersect the region (and level of detail) they actually display, instead of a dense copy of the
+ * entire volume for all dimensions.
+ *
+ * The store is populated one slab of brick rows at a time, so building it never requires the dense volume in memory.
+ * Encoded bricks are kept in memory or, when a backing file is set, written to disk (out-of-core). Bricks can
+ * optionally be quantized to 16 or 8 bits per scalar (normalized to the per-brick range of each dimension).
+ *
+ * Decoded bricks are served from a least-recently-used brick cache with a memory budget.
+ *
+ * Each level of detail halves the resolution of the previous level with a 2x2x2 box filter. Every brick records
+ * the minimum and maximum value for each dimension, which allows renderers to skip empty bricks without decoding them.
+ *
+ * Within a brick, scalars are stored voxel-major with the dimensions interleaved: [(z * height + y) * width + x] * numberOfDimensions + dimension
+ *
+ * @author Thomas Kroes
+ */
+class VOLUMEDATA_EXPORT VolumeBrickStore
+{
+public:
+
+    /** Storage encoding of the brick scalars */
+    enum class Encoding {
+        Float32,    /** Full precision */
+        UInt16,     /** 16-bit quantized (normalized to the brick range per dimension) */
+        UInt8       /** 8-bit quantized (normalized to the brick range per dimension) */
+    };
+
+    /** Axis-aligned voxel region */
+    struct VOLUMEDATA_EXPORT Region
+    {
+        std::int32_t    _x = 0;         /** Voxel x-coordinate of the region origin */
+        std::int32_t    _y = 0;         /** Voxel y-coordinate of the region origin */
+        std::int32_t    _z = 0;         /** Voxel z-coordinate of the region origin */
+        std::int32_t    _width = 0;     /** Width of the region in voxels */
+        std::int32_t    _height = 0;    /** Height of the region in voxels */
+        std::int32_t    _depth = 0;     /** Depth of the region in voxels */
+
+        /**
+         * Get whether the region does not contain any voxels
+         * @return Boolean determining whether the region is empty
+         */
+        bool isEmpty() const;
+
+        /**
+         * Get the number of voxels in the region
+         * @return Number of voxels
+         */
+        std::uint64_t getNumberOfVoxels() const;
+
+        /**
+         * Get whether the region intersects with \p other
+         * @param other Other region
+         * @return Boolean determining whether the regions intersect
+         */
+        bool intersects(const Region& other) const;
+
+        /**
+         * Get the intersection with \p other
+         * @param other Other region
+         * @return Intersection (empty if the regions do not intersect)
+         */
+        Region intersected(const Region& other) const;
+    };
+
+    /** Per-brick meta data, available without decoding the brick */
+    struct BrickInfo
+    {
+        Region              _region;            /** Region of the brick in level voxel coordinates */
+        std::vector<float>  _minima;            /** Minimum value per dimension */
+        std::vector<float>  _maxima;            /** Maximum value per dimension */
+        std::uint64_t       _offset = 0;        /** Offset of the encoded brick in the backing storage */
+        std::uint64_t       _numberOfBytes = 0; /** Number of bytes of the encoded brick */
+    };
+
+    /** Decoded brick */
+    struct Brick
+    {
+        std::uint32_t       _level = 0;                 /** Level of detail */
+        std::uint32_t       _index = 0;                 /** Brick index within the level */
+        Region              _region;                    /** Region of the brick in level voxel coordinates */
+        std::uint32_t       _numberOfDimensions = 0;    /** Number of dimensions per voxel */
+        std::vector<float>  _scalars;                   /** Scalars (voxel-major, dimensions interleaved) */
+
+        /**
+         * Get scalar at brick-local voxel coordinate (\p x, \p y, \p z) for \p dimension
+         * @param x Brick-local x-coordinate
+         * @param y Brick-local y-coordinate
+         * @param z Brick-local z-coordinate
+         * @param dimension Dimension index
+         * @return Scalar value
+         */
+        float getScalar(std::int32_t x, std::int32_t y, std::int32_t z, std::uint32_t dimension) const {
+            return _scalars[(((static_cast<std::size_t>(z) * _region._height) + y) * _region._width + x) * _numberOfDimensions + dimension];
+        }
+    };
+
+    using SharedBrick = std::shared_ptr<const Brick>;
+    using Bricks = std::vector<SharedBrick>;
+
+    /**
+     * Populates the voxels with z-coordinates in [zBegin, zEnd) of the full resolution volume
+     * The slab is zero-initialized and laid out as [((z - zBegin) * height + y) * width + x] * numberOfDimensions + dimension
+     */
+    using SlabPopulator = std::function<void(std::int32_t zBegin, std::int32_t zEnd, float* slab)>;
+
+    /** Default brick size (in voxels along each axis) */
+    static constexpr std::uint32_t defaultBrickSize = 32;
+
+    /** Default memory budget of the decoded brick cache */
+    static constexpr std::uint64_t defaultCacheBudget = 256ull * 1024ull * 1024ull;
+
+public:
+
+    /**
+     * Construct with \p brickSize and \p encoding
+     * @param brickSize Brick size in voxels along each axis
+     * @param encoding Storage encoding of the brick scalars
+     */
+    explicit VolumeBrickStore(std::uint32_t brickSize = defaultBrickSize, Encoding encoding = Encoding::Float32);
+
+    /** Destructor, removes the backing file (if any) */
+    ~VolumeBrickStore();
+
+    VolumeBrickStore(const VolumeBrickStore&) = delete;
+    VolumeBrickStore& operator=(const VolumeBrickStore&) = delete;
+
+    /**
+     * Set the backing file path to \p backingFilePath (must be set before build(), empty keeps the encoded bricks in memory)
+     * @param backingFilePath Location of the file in which encoded bricks are stored
+     */
+    void setBackingFilePath(const std::string& backingFilePath);
+
+    /**
+     * Get the backing file path
+     * @return Location of the backing file, empty when bricks are stored in memory
+     */
+    std::string getBackingFilePath() const;
+
+    /**
+     * Build the store for a volume of \p volumeSize with \p numberOfDimensions, voxels are obtained slab-wise from \p slabPopulator
+     * @param volumeSize Size of the full resolution volume
+     * @param numberOfDimensions Number of dimensions per voxel
+     * @param slabPopulator Populates slabs of the full resolution volume
+     * @param numberOfLevels Number of levels of detail (zero determines the number of levels automatically)
+     */
+    void build(const Size3D& volumeSize, std::uint32_t numberOfDimensions, const SlabPopulator& slabPopulator, std::uint32_t numberOfLevels = 0);
+
+    /** Remove all bricks */
+    void clear();
+
+    /**
+     * Get whether the store is built
+     * @return Boolean determining whether the store is built
+     */
+    bool isBuilt() const;
+
+public: // Layout
+
+    /**
+     * Get the brick size
+     * @return Brick size in voxels along each axis
+     */
+    std::uint32_t getBrickSize() const;
+
+    /**
+     * Get the storage encoding
+     * @return Storage encoding of the brick scalars
+     */
+    Encoding getEncoding() const;
+
+    /**
+     * Get the number of dimensions per voxel
+     * @return Number of dimensions
+     */
+    std::uint32_t getNumberOfDimensions() const;
+
+    /**
+     * Get the number of levels of detail
+     * @return Number of levels
+     */
+    std::uint32_t getNumberOfLevels() const;
+
+    /**
+     * Get the volume size at \p level
+     * @param level Level of detail
+     * @return Volume size at the level
+     */
+    Size3D getLevelSize(std::uint32_t level) const;
+
+    /**
+     * Get the number of bricks along each axis at \p level
+     * @param level Level of detail
+     * @return Brick grid size
+     */
+    Size3D getBrickGridSize(std::uint32_t level) const;
+
+    /**
+     * Get the number of bricks at \p level
+     * @param level Level of detail
+     * @return Number of bricks
+     */
+    std::uint32_t getNumberOfBricks(std::uint32_t level) const;
+
+    /**
+     * Get the meta data of brick \p brickIndex at \p level
+     * @param level Level of detail
+     * @param brickIndex Brick index
+     * @return Brick meta data
+     */
+    const BrickInfo& getBrickInfo(std::uint32_t level, std::uint32_t brickIndex) const;
+
+    /**
+     * Get the value range of \p dimension over the entire volume
+     * @param dimension Dimension index
+     * @return Minimum and maximum value
+     */
+    std::pair<float, float> getRange(std::uint32_t dimension) const;
+
+    /**
+     * Get the number of bytes of the encoded bricks (in memory or on disk)
+     * @return Number of bytes
+     */
+    std::uint64_t getNumberOfEncodedBytes() const;
+
+public: // Fetching
+
+    /**
+     * Get indices of the bricks at \p level which intersect \p region
+     * @param level Level of detail
+     * @param region Region in level voxel coordinates
+     * @return Brick indices in z/y/x order
+     */
+    std::vector<std::uint32_t> getBrickIndices(std::uint32_t level, const Region& region) const;
+
+    /**
+     * Get decoded brick \p brickIndex at \p level (served from the brick cache when available)
+     * @param level Level of detail
+     * @param brickIndex Brick index
+     * @return Shared pointer to the decoded brick (remains valid when the brick is evicted)
+     */
+    SharedBrick getBrick(std::uint32_t level, std::uint32_t brickIndex) const;
+
+    /**
+     * Get decoded bricks at \p level which intersect \p region
+     * @param level Level of detail
+     * @param region Region in level voxel coordinates
+     * @return Decoded bricks in z/y/x order
+     */
+    Bricks getBricks(std::uint32_t level, const Region& region) const;
+
+    /**
+     * Copy \p region at \p level for \p dimensions into \p scalars (voxel-major, the requested dimensions interleaved)
+     * @param level Level of detail
+     * @param region Region in level voxel coordinates (clipped to the level)
+     * @param dimensions Dimensions to copy
+     * @param scalars Scalars (resized to the clipped region)
+     * @return Clipped region
+     */
+    Region getRegion(std::uint32_t level, const Region& region, const std::vector<std::uint32_t>& dimensions, std::vector<float>& scalars) const;
+
+public: // Cache
+
+    /**
+     * Get the memory budget of the decoded brick cache
+     * @return Memory budget in bytes
+     */
+    std::uint64_t getCacheBudget() const;
+
+    /**
+     * Set the memory budget of the decoded brick cache to \p cacheBudget (evicts bricks when exceeded)
+     * @param cacheBudget Memory budget in bytes
+     */
+    void setCacheBudget(std::uint64_t cacheBudget);
+
+    /**
+     * Get the number of bytes occupied by the decoded brick cache
+     * @return Number of bytes
+     */
+    std::uint64_t getCacheSize() const;
+
+private:
+
+    /** Level of detail layout and brick meta data */
+    struct Level
+    {
+        Size3D                  _size;          /** Volume size at this level */
+        Size3D                  _brickGridSize; /** Number of bricks along each axis */
+        std::vector<BrickInfo>  _bricks;        /** Brick meta data in z/y/x order */
+    };
+
+    /** Cache entry */
+    struct CacheEntry
+    {
+        SharedBrick     _brick;     /** Decoded brick */
+        std::uint64_t   _lastUsed;  /** Usage stamp for least-recently-used eviction */
+    };
+
+    /**
+     * Get the brick region of brick (\p brickX, \p brickY, \p brickZ) at \p level
+     * @param level Level of detail
+     * @param brickX Brick x-coordinate
+     * @param brickY Brick y-coordinate
+     * @param brickZ Brick z-coordinate
+     * @return Brick region in level voxel coordinates
+     */
+    Region getBrickRegion(const Level& level, std::int32_t brickX, std::int32_t brickY, std::int32_t brickZ) const;
+
+    /**
+     * Compute the brick meta data ranges, encode \p scalars and write them to the backing storage
+     * @param brickInfo Brick meta data (ranges and storage location are set)
+     * @param scalars Brick scalars (voxel-major, dimensions interleaved)
+     */
+    void storeBrick(BrickInfo& brickInfo, const std::vector<float>& scalars);
+
+    /**
+     * Read and decode brick \p brickIndex at \p level from the backing storage (bypasses the cache)
+     * @param level Level of detail
+     * @param brickIndex Brick index
+     * @return Decoded brick
+     */
+    SharedBrick loadBrick(std::uint32_t level, std::uint32_t brickIndex) const;
+
+    /**
+     * Build level of detail \p level from the previous level
+     * @param level Level of detail (must be larger than zero)
+     */
+    void buildLevel(std::uint32_t level);
+
+    /** Evict least recently used bricks until the cache fits the budget (assumes the cache mutex is locked) */
+    void evict() const;
+
+    /**
+     * Get the number of bytes per encoded scalar
+     * @return Number of bytes
+     */
+    std::uint32_t getNumberOfBytesPerScalar() const;
+
+private:
+    std::uint32_t                               _brickSize;             /** Brick size in voxels along each axis */
+    Encoding                                    _encoding;              /** Storage encoding of the brick scalars */
+    std::uint32_t                               _numberOfDimensions;    /** Number of dimensions per voxel */
+    std::vector<Level>                          _levels;                /** Levels of detail */
+    std::vector<std::pair<float, float>>        _ranges;                /** Value range per dimension */
+    std::string                                 _backingFilePath;       /** Location of the backing file, empty when stored in memory */
+    mutable std::fstream                        _backingFile;           /** Backing file stream */
+    std::vector<std::uint8_t>                   _encodedBricks;         /** Encoded bricks (when stored in memory) */
+    std::uint64_t                               _numberOfEncodedBytes;  /** Number of bytes of the encoded bricks */
+    std::uint64_t                               _cacheBudget;           /** Memory budget of the decoded brick cache */
+    mutable std::map<std::uint64_t, CacheEntry> _cache;                 /** Decoded bricks by level and brick index */
+    mutable std::uint64_t                       _cacheSize;             /** Number of bytes occupied by the decoded brick cache */
+    mutable std::uint64_t                       _usageCounter;          /** Incremented on each brick access */
+    mutable std::mutex                          _mutex;                 /** Guards the cache and the backing storage */
+};
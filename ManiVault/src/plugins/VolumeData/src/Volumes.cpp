@@ -17,22 +17,25 @@
 #include <PointData/PointData.h>
 
 #include <cmath>
+#include <cstring>
 #include <exception>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <utility>
 
 #include <QDebug>
 
 
 using namespace mv::util;
-static int GL_MAX_3D_TEXTURE_SIZE = 2048; // 2048 is the minimum value for OpenGL 3D textures, defined here manually for now to avoid including OpenGL headers
 
 Volumes::Volumes(QString dataName, bool mayUnderive /*= false*/, const QString& guid /*= ""*/) :
     DatasetImpl(dataName, mayUnderive, guid),
     _indices(),
     _volumeData(nullptr),
-    _infoAction()
+    _infoAction(),
+    _parentDataset(),
+    _globalIndexMap()
 {
     _volumeData = getRawData<VolumeData>();
 
@@ -51,6 +54,17 @@ void Volumes::init()
     if (!getDataHierarchyItem().getParent()->getDataset<DatasetImpl>().isValid() ||
         getDataHierarchyItem().getParent()->getDataType() != PointType)
         qCritical() << "Volumes: warning: volume data set must be derived from points.";
+
+    _parentDataset = getParent();
+
+    if (_parentDataset.isValid()) {
+        const auto invalidateGlobalIndices = [this]() -> void {
+            _globalIndexMap.reset();
+        };
+
+        connect(&_parentDataset, &Dataset<DatasetImpl>::dataChanged, this, invalidateGlobalIndices);
+        connect(&_parentDataset, &Dataset<DatasetImpl>::dataDimensionsChanged, this, invalidateGlobalIndices);
+    }
 }
 
 mv::Dataset<Volumes> Volumes::addVolumeDataset(QString datasetGuiName, const mv::Dataset<Points>& parentDataSet)
@@ -196,18 +210,27 @@ void Volumes::getVolumeData(const std::vector<std::uint32_t>& dimensionIndices,
         if (static_cast<std::uint32_t>(scalarData.capacity()) < numberOfElementsRequired)
             throw std::runtime_error("Scalar data vector number of elements is smaller than (nDimensions * nVoxels)");
 
-        QVector<float> tempScalarData(numberOfElementsRequired);
-        QPair<float, float> tempScalarDataRange(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest());
+        auto parent = getParent();
+
+        if (parent->getDataType() != PointType)
+            throw std::runtime_error("Volume data set must be derived from points");
 
-        std::int32_t componentIndex = 0;
+        auto points = Dataset<Points>(parent);
 
-        for (const auto& dimensionIndex : dimensionIndices) {
-            getScalarDataForVolumeDimension(dimensionIndex, tempScalarData, tempScalarDataRange);
-            for (std::int32_t voxelIndex = 0; voxelIndex < numberOfVoxels; voxelIndex++)
-                scalarData[static_cast<size_t>(voxelIndex * numberOfComponentsPerVoxel) + componentIndex] = tempScalarData[voxelIndex];
+        const auto& globalIndices = getGlobalIndices();
 
-            componentIndex++;
-        }
+        // Scatter all requested dimensions in a single pass over the points, without a dense temporary per dimension
+        std::as_const(*points).visitData([&dimensionIndices, &globalIndices, &scalarData, numberOfVoxels, numberOfComponentsPerVoxel](auto pointData) {
+            for (std::uint32_t pointIndex = 0; pointIndex < pointData.size(); pointIndex++) {
+                const auto voxelIndex = static_cast<std::int32_t>(globalIndices[pointIndex]);
+
+                if (voxelIndex >= numberOfVoxels)
+                    continue;
+
+                for (std::size_t componentIndex = 0; componentIndex < dimensionIndices.size(); componentIndex++)
+                    scalarData[static_cast<size_t>(voxelIndex * numberOfComponentsPerVoxel) + componentIndex] = pointData[pointIndex][dimensionIndices[componentIndex]];
+            }
+        });
 
         scalarDataRange = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
 
@@ -227,129 +250,124 @@ void Volumes::getVolumeData(const std::vector<std::uint32_t>& dimensionIndices,
 
 mv::Vector3f Volumes::getVolumeAtlasData(const std::vector<std::uint32_t>& dimensionIndices, std::vector<float>& scalarData, QPair<float, float>& scalarDataRange, int textureBlockDimensions /*default value = 4 (RGBA)*/)
 {
-    qDebug() << "amount of dimensions: " << dimensionIndices.size();
-    try
-    {
-        const std::int32_t numberOfVoxels = getNumberOfVoxels();
-        const std::int32_t numberOfElementsRequired = std::ceil(float(dimensionIndices.size()) / float(textureBlockDimensions)) * textureBlockDimensions * getNumberOfVoxels();
+    std::vector<std::uint8_t> atlasData;
+    VolumeAtlasBuilder::ChannelRanges channelRanges;
 
-        int brickAmount = std::ceil(float(dimensionIndices.size()) / float(textureBlockDimensions));
+    const auto atlasSize = getVolumeAtlasData(dimensionIndices, atlasData, VolumeAtlasBuilder::Format::Float32, channelRanges, textureBlockDimensions);
 
-        // These are currently not intresting, but later on we might add borders to the blocks to avoid interpolation artifacts
-        int width = getVolumeSize().width();
-        int height = getVolumeSize().height();
-        int depth = getVolumeSize().depth();
+    scalarData.resize(atlasData.size() / sizeof(float));
 
-        // Here we figure out the optimal way we can arrange the atlas bricks such that we minimize the amount of wasted space in the texture
-        mv::Vector3f maxDimsInBricks = mv::Vector3f(GL_MAX_3D_TEXTURE_SIZE / width, GL_MAX_3D_TEXTURE_SIZE / height, GL_MAX_3D_TEXTURE_SIZE / depth);
-        mv::Vector3f brickLayout = findOptimalDimensions(brickAmount, maxDimsInBricks);
+    std::memcpy(scalarData.data(), atlasData.data(), atlasData.size());
 
+    scalarDataRange = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
 
-        QVector<float> tempScalarData(numberOfElementsRequired);
-        qDebug() << "Size of temp vector: " << tempScalarData.size() << " " << numberOfElementsRequired;
-        QPair<float, float> tempScalarDataRange(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest());
+    for (const auto& channelRange : channelRanges) {
+        scalarDataRange.first   = std::min(channelRange.first, scalarDataRange.first);
+        scalarDataRange.second  = std::max(channelRange.second, scalarDataRange.second);
+    }
 
-        int trueWidth = width * brickLayout.x;
-        int trueHeight = height * brickLayout.y;
-        int trueDepth = depth * brickLayout.z;
-        
-        int trueVolume = trueWidth * trueHeight * trueDepth * textureBlockDimensions;
-        if (trueVolume >= scalarData.size()) {
-            scalarData.resize(trueVolume);
-            qDebug() << "Resized scalar data to: " << trueVolume;
-        }
+    return atlasSize;
+}
 
-        // Loop over the dimensions and fill the scalar data
-        std::int32_t componentIndex = 0;
-        for (const auto& dimensionIndex : dimensionIndices) {
-            getScalarDataForVolumeDimension(dimensionIndex, tempScalarData, tempScalarDataRange);
-            int brickIndex = std::floor(float(componentIndex) / float(textureBlockDimensions));
-
-            int brickX = brickIndex % int(brickLayout.x);
-            int brickY = int(std::floor(float(brickIndex) / float(brickLayout.x))) % int(brickLayout.y);
-            int brickZ = std::floor(float(brickIndex) / float(brickLayout.x * brickLayout.y));
-            for (std::int32_t voxelIndex = 0; voxelIndex < numberOfVoxels; voxelIndex++) {
-                mv::Vector3f voxelCoordinate = getVoxelCoordinateFromVoxelIndex(voxelIndex);
-                // The voxel coordinate detimenes the position of the voxel in the volume, not accounting for (for example) the rgba format yet inside the brick itself
-                std::uint32_t voxelBaseIndex = (std::uint32_t(voxelCoordinate.x + (brickX * width))
-                        + std::uint32_t(voxelCoordinate.y + (brickY * height)) * trueWidth
-                        + std::uint32_t(voxelCoordinate.z + (brickZ * depth)) * trueWidth * trueHeight)
-                    * textureBlockDimensions;
-
-                // Here, we add the offset of the channel inside the brick
-                std::uint32_t channelOffset = componentIndex % textureBlockDimensions;
-                std::uint32_t valueIndex = voxelBaseIndex + channelOffset;
-
-                float value = tempScalarData[voxelIndex];
-                if(valueIndex > scalarData.size())
-                    qCritical() << "Index out of bounds: " << valueIndex << " " << scalarData.size();
-                scalarData[valueIndex] = value;
-            }
+mv::Vector3f Volumes::getVolumeAtlasData(const std::vector<std::uint32_t>& dimensionIndices, std::vector<std::uint8_t>& atlasData, VolumeAtlasBuilder::Format format, VolumeAtlasBuilder::ChannelRanges& channelRanges, int textureBlockDimensions /*= 4*/)
+{
+    try
+    {
+        auto parent = getParent();
 
-            componentIndex++;
-        }
+        if (parent->getDataType() != PointType)
+            throw std::runtime_error("Volume data set must be derived from points");
 
-        scalarDataRange = { std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest() };
+        auto points = Dataset<Points>(parent);
 
-        for (auto& scalar : scalarData) {
-            scalarDataRange.first = std::min(scalar, scalarDataRange.first);
-            scalarDataRange.second = std::max(scalar, scalarDataRange.second);
-        }
+        const auto layout               = VolumeAtlasBuilder::computeLayout(getVolumeSize(), static_cast<std::uint32_t>(dimensionIndices.size()), static_cast<std::uint32_t>(std::max(textureBlockDimensions, 1)));
+        const auto voxelPointIndices    = getVoxelPointIndices();
+
+        std::as_const(*points).visitData([&](auto pointData) {
+            const auto getter = [&pointData, &voxelPointIndices, &dimensionIndices](std::uint64_t voxelIndex, std::uint32_t channel) -> float {
+                const auto pointIndex = voxelPointIndices[voxelIndex];
 
-        return mv::Vector3f(trueWidth, trueHeight, trueDepth);
+                return pointIndex < 0 ? 0.f : static_cast<float>(pointData[pointIndex][dimensionIndices[channel]]);
+            };
+
+            channelRanges = VolumeAtlasBuilder::build(layout, getter, format, atlasData);
+        });
+
+        return layout._atlasSize.toVector3f();
     }
     catch (std::exception& e)
     {
-        exceptionMessageBox("Unable to get scalar data for the given dimension indices", e);
+        exceptionMessageBox("Unable to get volume atlas data for the given dimension indices", e);
     }
     catch (...) {
-        exceptionMessageBox("Unable to get scalar data for the given dimension indices");
+        exceptionMessageBox("Unable to get volume atlas data for the given dimension indices");
     }
+
+    return {};
 }
 
-// Finds the optimal dimensions for the volume cube when given a certain amount of cubes
-mv::Vector3f Volumes::findOptimalDimensions(int N, mv::Vector3f maxDims) {
-    int maxX = 1;
-    int maxY = 1;
-    int maxZ = 1;
+std::shared_ptr<VolumeBrickStore> Volumes::createBrickStore(const std::vector<std::uint32_t>& dimensionIndices, std::uint32_t brickSize /*= VolumeBrickStore::defaultBrickSize*/, VolumeBrickStore::Encoding encoding /*= VolumeBrickStore::Encoding::Float32*/, const QString& backingFilePath /*= ""*/)
+{
+    try
+    {
+        auto parent = getParent();
+
+        if (parent->getDataType() != PointType)
+            throw std::runtime_error("Volume data set must be derived from points");
 
-    mv::Vector3f bestDims(1, 1, 1);
-    int bestVolume = std::numeric_limits<int>::max();
-    if (N <= maxDims.x) {
-        return mv::Vector3f(N, 1, 1);
-    }
-    else if (N <= maxDims.x * maxDims.y) {
-        maxX = std::min(int(std::ceil(std::sqrt(N))), int(std::floor(maxDims.x)));
-        maxY = std::min(int(std::ceil(std::sqrt(N))), int(std::floor(maxDims.y)));
-    }
-    else if (N <= maxDims.x * maxDims.y * maxDims.z) {
-        maxX = std::min(int(std::ceil(std::cbrt(N))), int(std::floor(maxDims.x)));
-        maxY = std::min(int(std::ceil(std::cbrt(N))), int(std::floor(maxDims.y)));
-        maxZ = std::min(int(std::ceil(std::cbrt(N))), int(std::floor(maxDims.z)));
-    }
-    else {
-        qCritical() << "Volume too large to fit in texture";
-    }
+        auto points = Dataset<Points>(parent);
 
+        const auto volumeSize           = getVolumeSize();
+        const auto numberOfDimensions   = static_cast<std::uint32_t>(dimensionIndices.size());
+        const auto& globalIndices       = getGlobalIndices();
+        const auto sliceSize            = static_cast<std::uint64_t>(volumeSize.width()) * volumeSize.height();
+        const auto slabSize             = sliceSize * std::max(brickSize, 1u);
+        const auto numberOfSlabs        = static_cast<std::size_t>((static_cast<std::uint64_t>(getNumberOfVoxels()) + slabSize - 1) / slabSize);
 
-    for (int z = 1; z <= maxZ; ++z) {
-        float remaining = std::ceil(N / float(z));
-        for (int y = 1; y <= maxY; ++y) {
-            int x = std::ceil(remaining / float(y));
-            if (x <= maxX) {
-                int volume = x * y * z;
-                if (volume == N) {
-                    return mv::Vector3f(x, y, z); // Exact match found
-                }
-                if (volume >= N && volume < bestVolume) {
-                    bestVolume = volume;
-                    bestDims = mv::Vector3f(x, y, z); // best match so far
+        // Bucket the local point indices per slab (counting sort) so that each slab only visits its own points
+        std::vector<std::uint32_t> slabOffsets(numberOfSlabs + 1, 0), slabPointIndices(globalIndices.size());
+
+        for (const auto& globalIndex : globalIndices)
+            if (globalIndex < getNumberOfVoxels())
+                slabOffsets[globalIndex / slabSize + 1]++;
+
+        std::partial_sum(slabOffsets.begin(), slabOffsets.end(), slabOffsets.begin());
+
+        auto slabCursors = slabOffsets;
+
+        for (std::uint32_t pointIndex = 0; pointIndex < globalIndices.size(); pointIndex++)
+            if (globalIndices[pointIndex] < getNumberOfVoxels())
+                slabPointIndices[slabCursors[globalIndices[pointIndex] / slabSize]++] = pointIndex;
+
+        auto brickStore = std::make_shared<VolumeBrickStore>(brickSize, encoding);
+
+        brickStore->setBackingFilePath(backingFilePath.toStdString());
+        brickStore->build(volumeSize, numberOfDimensions, [&](std::int32_t zBegin, std::int32_t zEnd, float* slab) -> void {
+            const auto slabIndex    = static_cast<std::size_t>(zBegin) * sliceSize / slabSize;
+            const auto voxelOffset  = static_cast<std::uint64_t>(zBegin) * sliceSize;
+
+            std::as_const(*points).visitData([&](auto pointData) {
+                for (auto offset = slabOffsets[slabIndex]; offset < slabOffsets[slabIndex + 1]; offset++) {
+                    const auto pointIndex   = slabPointIndices[offset];
+                    const auto slabVoxel    = globalIndices[pointIndex] - voxelOffset;
+
+                    for (std::uint32_t dimension = 0; dimension < numberOfDimensions; dimension++)
+                        slab[slabVoxel * numberOfDimensions + dimension] = pointData[pointIndex][dimensionIndices[dimension]];
                 }
-            }
-        }
+            });
+        });
+
+        return brickStore;
+    }
+    catch (std::exception& e)
+    {
+        exceptionMessageBox("Unable to create volume brick store", e);
+    }
+    catch (...) {
+        exceptionMessageBox("Unable to create volume brick store");
     }
 
-    return bestDims; // Return the closest combination found
+    return {};
 }
 
 void Volumes::getScalarDataForVolumeDimension(const std::uint32_t& dimensionIndex, QVector<float>& scalarData, QPair<float, float>& scalarDataRange)
@@ -359,11 +377,9 @@ void Volumes::getScalarDataForVolumeDimension(const std::uint32_t& dimensionInde
     if (parent->getDataType() == PointType) {
         auto points = Dataset<Points>(parent);
 
-        std::vector<std::uint32_t> globalIndices;
-
-        points->getGlobalIndices(globalIndices); //TODO this seems very inneficient to call this every time
+        const auto& globalIndices = getGlobalIndices();
 
-        points->visitData([this, dimensionIndex, &globalIndices, &scalarData](auto pointData) {
+        std::as_const(*points).visitData([this, dimensionIndex, &globalIndices, &scalarData](auto pointData) {
             for (std::uint32_t pointIndex = 0; pointIndex < pointData.size(); pointIndex++) {
                 scalarData[globalIndices[pointIndex]] = pointData[pointIndex][dimensionIndex];
             }
@@ -374,6 +390,33 @@ void Volumes::getScalarDataForVolumeDimension(const std::uint32_t& dimensionInde
     }
 }
 
+const std::vector<std::uint32_t>& Volumes::getGlobalIndices()
+{
+    if (!_globalIndexMap) {
+        auto parent = getParent();
+
+        if (parent->getDataType() == PointType)
+            _globalIndexMap = Dataset<Points>(parent)->getGlobalIndexMap();
+        else
+            _globalIndexMap = std::make_shared<const GlobalIndexMap>(std::vector<std::uint32_t>(), 0, true);
+    }
+
+    return _globalIndexMap->getLocalToGlobal();
+}
+
+std::vector<std::int32_t> Volumes::getVoxelPointIndices()
+{
+    const auto& globalIndices = getGlobalIndices();
+
+    std::vector<std::int32_t> voxelPointIndices(getNumberOfVoxels(), -1);
+
+    for (std::uint32_t pointIndex = 0; pointIndex < globalIndices.size(); pointIndex++)
+        if (globalIndices[pointIndex] < voxelPointIndices.size())
+            voxelPointIndices[globalIndices[pointIndex]] = static_cast<std::int32_t>(pointIndex);
+
+    return voxelPointIndices;
+}
+
 mv::Vector3f Volumes::getVoxelCoordinateFromVoxelIndex(const std::int32_t& voxelIndex) const
 {
     const auto size = getVolumeSize();
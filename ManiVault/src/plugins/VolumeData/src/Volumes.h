@@ -6,6 +6,8 @@
 
 #include "volumedata_export.h"
 #include "Volume.h"
+#include "VolumeAtlasBuilder.h"
+#include "VolumeBrickStore.h"
 #include "VolumeData.h"
 
 #include <Set.h>
@@ -14,6 +16,7 @@
 #include <QRect>
 #include <QString>
 
+#include <memory>
 #include <tuple>
 #include <vector>
 #include "graphics/Vector3f.h"
@@ -21,6 +24,7 @@
 using namespace mv::plugin;
 
 class InfoAction;
+class GlobalIndexMap;
 
 /**
  * Volumes dataset class
@@ -121,6 +125,9 @@ public: // Selection
      */
     void setSelectionIndices(const std::vector<std::uint32_t>& indices) override;
 
+    /** Do not hide the move overload of the base class (which forwards to the copying overload above) */
+    using DatasetImpl::setSelectionIndices;
+
     /** Determines whether items can be selected */
     bool canSelect() const override;
 
@@ -164,9 +171,35 @@ public:
      */
     mv::Vector3f getVolumeAtlasData(const std::vector<std::uint32_t>& dimensionIndices, std::vector<float>& scalarData, QPair<float, float>& scalarDataRange, int textureBlockDimensions = 4);
 
+    /**
+     * Get volume atlas data for \p dimensionIndices in \p format (see VolumeAtlasBuilder for the layout)
+     * @param dimensionIndices Dimension indices to pack into the atlas
+     * @param atlasData Atlas bytes (float, half float or 8-bit normalized elements depending on \p format, resized to the atlas)
+     * @param format Texel format (half float and 8-bit normalized atlases reduce the memory footprint two- and four-fold)
+     * @param channelRanges Value range of each dimension (needed to decode 8-bit normalized atlases)
+     * @param textureBlockDimensions Texture block dimensions per voxel (default value = 4 (RGBA))
+     * @return Dimensions of the volume atlas
+     */
+    mv::Vector3f getVolumeAtlasData(const std::vector<std::uint32_t>& dimensionIndices, std::vector<std::uint8_t>& atlasData, VolumeAtlasBuilder::Format format, VolumeAtlasBuilder::ChannelRanges& channelRanges, int textureBlockDimensions = 4);
+
+    /**
+     * Create a bricked store for \p dimensionIndices, so that (parts of) large volumes can be streamed brick by brick instead of expanded into one dense buffer
+     * The store is populated one slab of bricks at a time, the dense volume is never allocated
+     * @param dimensionIndices Dimension indices to store (in this order)
+     * @param brickSize Brick size in voxels along each axis
+     * @param encoding Storage encoding of the brick scalars (quantized encodings reduce the memory footprint two- to four-fold)
+     * @param backingFilePath Location of the file in which encoded bricks are stored (empty keeps the encoded bricks in memory)
+     * @return Shared pointer to the brick store, nullptr when the store could not be created
+     */
+    std::shared_ptr<VolumeBrickStore> createBrickStore(const std::vector<std::uint32_t>& dimensionIndices, std::uint32_t brickSize = VolumeBrickStore::defaultBrickSize, VolumeBrickStore::Encoding encoding = VolumeBrickStore::Encoding::Float32, const QString& backingFilePath = "");
+
 protected:
 
-    mv::Vector3f findOptimalDimensions(int N, mv::Vector3f maxDims);
+    /**
+     * Get the parent point index for each voxel
+     * @return Point index for each voxel, -1 for voxels without a point
+     */
+    std::vector<std::int32_t> getVoxelPointIndices();
 
     /**
     * Get scalar data for a single volume dimension
@@ -176,6 +209,12 @@ protected:
     */
     void getScalarDataForVolumeDimension(const std::uint32_t& dimensionIndex, QVector<float>& scalarData, QPair<float, float>& scalarDataRange);
 
+    /**
+     * Get the global (voxel) indices of the parent points, cached until the parent data changes
+     * @return Global voxel index for each local point
+     */
+    const std::vector<std::uint32_t>& getGlobalIndices();
+
     /**
      * Get voxel coordinate from voxel index, doesn't take into account valueDimensions
      * @param voxelIndex Voxel index
@@ -205,8 +244,10 @@ public: // Serialization
 
 
 private:
-    std::vector<std::uint32_t>      _indices;               /** Selection indices */
-    VolumeData*                     _volumeData;            /** Pointer to raw volume data */
-    QSharedPointer<InfoAction>      _infoAction;            /** Shared pointer to info action */
+    std::vector<std::uint32_t>              _indices;           /** Selection indices */
+    VolumeData*                             _volumeData;        /** Pointer to raw volume data */
+    QSharedPointer<InfoAction>              _infoAction;        /** Shared pointer to info action */
+    mv::Dataset<mv::DatasetImpl>            _parentDataset;     /** Parent dataset, its data changes invalidate the cached global indices */
+    std::shared_ptr<const GlobalIndexMap>   _globalIndexMap;    /** Shared global index map of the parent points (reset when the parent data changes) */
 };
 
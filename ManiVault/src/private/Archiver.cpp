@@ -5,6 +5,7 @@
 #include "Archiver.h"
 
 #include <util/Exception.h>
+#include <util/Trace.h>
 
 #include <stdexcept>
 
@@ -20,6 +21,8 @@ namespace util {
 
 void Archiver::compressDirectory(const QString& sourceDirectory, const QString& compressedFilePath, bool recursive /*= true*/, std::int32_t compressionLevel /*= 0*/, const QString& password /*= ""*/, QDir::Filters filters /*= QDir::Filter::Files*/)
 {
+    MV_TRACE_SCOPE_DETAIL("project", "Compress directory", compressedFilePath);
+
     // Clean up and throw exception if error(s) occurred
     const auto except = [&compressedFilePath](const QString& errorMessage) {
 
@@ -59,6 +62,8 @@ void Archiver::compressDirectory(const QString& sourceDirectory, const QString&
 
 void Archiver::decompress(const QString& compressedFile, const QString& destinationDirectory, const QString& password /*= ""*/)
 {
+    MV_TRACE_SCOPE_DETAIL("project", "Decompress", compressedFile);
+
     // Files that were extracted during decompression
     QStringList extracted;
 
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "BatchRunner.h"
+
+#include <AnalysisPlugin.h>
+#include <CoreInterface.h>
+#include <Set.h>
+#include <TransformationPlugin.h>
+
+#include <actions/TriggerAction.h>
+#include <util/Trace.h>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QThread>
+
+#include <algorithm>
+
+using namespace mv::plugin;
+using namespace mv::gui;
+
+namespace mv {
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    float getElapsedSeconds(const Clock::time_point& start)
+    {
+        return std::chrono::duration<float>(Clock::now() - start).count();
+    }
+
+    bool isBusy(const Task& task)
+    {
+        switch (task.getStatus()) {
+            case Task::Status::Running:
+            case Task::Status::RunningIndeterminate:
+            case Task::Status::AboutToBeAborted:
+            case Task::Status::Aborting:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+}
+
+BatchRunner::BatchRunner(const QString& batchFilePath, const QString& projectFilePath /*= ""*/, const QString& outputFilePath /*= ""*/) :
+    _batchFilePath(batchFilePath),
+    _projectFilePath(projectFilePath),
+    _outputFilePath(outputFilePath),
+    _steps()
+{
+}
+
+std::int32_t BatchRunner::run()
+{
+    const auto start = Clock::now();
+
+    try {
+        MV_TRACE_SCOPE_DETAIL("batch", "Run batch", _batchFilePath);
+
+        loadBatch();
+        openProject();
+
+        for (std::int32_t stepIndex = 0; stepIndex < _steps.count(); stepIndex++)
+            runStep(_steps[stepIndex].toMap(), stepIndex);
+
+        saveProject();
+
+        qInfo().noquote() << QString("Batch finished in %1 s").arg(getElapsedSeconds(start), 0, 'f', 1);
+
+        return static_cast<std::int32_t>(ExitCode::Success);
+    }
+    catch (Error& e)
+    {
+        qCritical().noquote() << QString("Batch failed after %1 s: %2").arg(getElapsedSeconds(start), 0, 'f', 1).arg(e.what());
+
+        return static_cast<std::int32_t>(e.getExitCode());
+    }
+    catch (std::exception& e)
+    {
+        qCritical().noquote() << QString("Batch failed after %1 s: %2").arg(getElapsedSeconds(start), 0, 'f', 1).arg(e.what());
+
+        return static_cast<std::int32_t>(ExitCode::StepFailed);
+    }
+    catch (...)
+    {
+        qCritical().noquote() << QString("Batch failed after %1 s: unhandled exception").arg(getElapsedSeconds(start), 0, 'f', 1);
+
+        return static_cast<std::int32_t>(ExitCode::StepFailed);
+    }
+}
+
+void BatchRunner::loadBatch()
+{
+    QFile batchFile(_batchFilePath);
+
+    if (!batchFile.open(QIODevice::ReadOnly))
+        throw Error(ExitCode::InvalidBatch, QString("Unable to open batch file %1: %2").arg(_batchFilePath, batchFile.errorString()));
+
+    QJsonParseError jsonParseError;
+
+    const auto jsonDocument = QJsonDocument::fromJson(batchFile.readAll(), &jsonParseError);
+
+    if (jsonParseError.error != QJsonParseError::NoError || !jsonDocument.isObject())
+        throw Error(ExitCode::InvalidBatch, QString("Batch file %1 is not a valid JSON object: %2").arg(_batchFilePath, jsonParseError.errorString()));
+
+    const auto batch = jsonDocument.toVariant().toMap();
+
+    if (_projectFilePath.isEmpty())
+        _projectFilePath = batch.value("Project").toString();
+
+    if (_outputFilePath.isEmpty())
+        _outputFilePath = batch.value("Output", _projectFilePath).toString();
+
+    _steps = batch.value("Steps").toList();
+
+    if (_projectFilePath.isEmpty())
+        throw Error(ExitCode::InvalidBatch, "No project specified (in the batch file or with --project)");
+
+    for (const auto& step : _steps)
+        if (step.toMap().value("Kind").toString().isEmpty())
+            throw Error(ExitCode::InvalidBatch, "Each batch step must specify a plugin kind");
+
+    qInfo().noquote() << QString("Loaded batch %1 with %2 step(s)").arg(_batchFilePath, QString::number(_steps.count()));
+}
+
+void BatchRunner::openProject()
+{
+    const auto start = Clock::now();
+
+    if (!QFileInfo(_projectFilePath).isFile())
+        throw Error(ExitCode::ProjectNotOpened, QString("Project %1 does not exist").arg(_projectFilePath));
+
+    auto opened = false;
+
+    const auto connection = QObject::connect(&projects(), &AbstractProjectManager::projectOpened, [&opened](const Project&) -> void {
+        opened = true;
+    });
+
+    // The workspace is not loaded because view plugins need a display
+    projects().openProject(_projectFilePath, false, false);
+
+    QObject::disconnect(connection);
+
+    if (!opened)
+        throw Error(ExitCode::ProjectNotOpened, QString("Unable to open project %1").arg(_projectFilePath));
+
+    waitForDatasetTasks({}, std::chrono::seconds(0));
+
+    qInfo().noquote() << QString("Opened project %1 in %2 s").arg(_projectFilePath).arg(getElapsedSeconds(start), 0, 'f', 1);
+}
+
+void BatchRunner::runStep(const QVariantMap& step, std::int32_t stepIndex)
+{
+    const auto start    = Clock::now();
+    const auto kind     = step.value("Kind").toString();
+    const auto name     = QString("Step %1/%2 (%3)").arg(QString::number(stepIndex + 1), QString::number(_steps.count()), kind);
+
+    MV_TRACE_SCOPE_DETAIL("batch", "Run batch step", kind);
+
+    qInfo().noquote() << name << "started";
+
+    const auto pluginFactory = plugins().loadDeferredPluginFactory(kind);
+
+    if (pluginFactory == nullptr)
+        throw Error(ExitCode::StepFailed, QString("%1: unknown plugin kind").arg(name));
+
+    if (pluginFactory->getType() != Type::ANALYSIS && pluginFactory->getType() != Type::TRANSFORMATION)
+        throw Error(ExitCode::StepFailed, QString("%1: only analysis and transformation plugins can be run").arg(name));
+
+    const auto inputDatasets = getDatasets(step.value("Inputs").toStringList());
+
+    auto plugin = plugins().requestPlugin(kind, inputDatasets);
+
+    if (plugin == nullptr)
+        throw Error(ExitCode::StepFailed, QString("%1: unable to create the plugin").arg(name));
+
+    const auto settings = step.value("Settings").toMap();
+
+    for (auto it = settings.constBegin(); it != settings.constEnd(); ++it) {
+        auto action = plugin->findChildByPath(it.key());
+
+        if (action == nullptr)
+            throw Error(ExitCode::StepFailed, QString("%1: setting %2 not found").arg(name, it.key()));
+
+        action->fromVariantMap(it.value().toMap());
+    }
+
+    for (const auto& triggerPath : step.value("Triggers").toStringList()) {
+        auto triggerAction = plugin->findChildByPath<TriggerAction>(triggerPath);
+
+        if (triggerAction == nullptr)
+            throw Error(ExitCode::StepFailed, QString("%1: trigger %2 not found").arg(name, triggerPath));
+
+        triggerAction->trigger();
+    }
+
+    Datasets outputDatasets;
+
+    if (auto analysisPlugin = dynamic_cast<AnalysisPlugin*>(plugin))
+        outputDatasets = analysisPlugin->getOutputDatasets();
+
+    if (auto transformationPlugin = dynamic_cast<TransformationPlugin*>(plugin))
+        transformationPlugin->transform();
+
+    waitForDatasetTasks(outputDatasets, std::chrono::seconds(step.value("Timeout", 0).toLongLong()));
+
+    qInfo().noquote() << QString("%1 finished in %2 s").arg(name).arg(getElapsedSeconds(start), 0, 'f', 1);
+}
+
+void BatchRunner::saveProject()
+{
+    const auto start = Clock::now();
+
+    auto saved = false;
+
+    const auto connection = QObject::connect(&projects(), &AbstractProjectManager::projectSaved, [&saved](const Project&) -> void {
+        saved = true;
+    });
+
+    projects().saveProject(_outputFilePath);
+
+    QObject::disconnect(connection);
+
+    if (!saved || !QFileInfo(_outputFilePath).isFile())
+        throw Error(ExitCode::ProjectNotSaved, QString("Unable to save project to %1").arg(_outputFilePath));
+
+    qInfo().noquote() << QString("Saved project to %1 in %2 s").arg(_outputFilePath).arg(getElapsedSeconds(start), 0, 'f', 1);
+}
+
+Datasets BatchRunner::getDatasets(const QStringList& datasetIdsOrNames) const
+{
+    const auto allDatasets = mv::data().getAllDatasets();
+
+    Datasets datasets;
+
+    for (const auto& datasetIdOrName : datasetIdsOrNames) {
+        Datasets candidates;
+
+        for (const auto& dataset : allDatasets)
+            if (dataset->getId() == datasetIdOrName || dataset->getGuiName() == datasetIdOrName)
+                candidates << dataset;
+
+        if (candidates.isEmpty())
+            throw Error(ExitCode::StepFailed, QString("Input dataset %1 not found").arg(datasetIdOrName));
+
+        if (candidates.count() > 1)
+            throw Error(ExitCode::StepFailed, QString("Input dataset name %1 is ambiguous, use the dataset ID instead").arg(datasetIdOrName));
+
+        datasets << candidates.first();
+    }
+
+    return datasets;
+}
+
+void BatchRunner::waitForDatasetTasks(const Datasets& outputDatasets, std::chrono::seconds timeout) const
+{
+    const auto start = Clock::now();
+
+    auto idleSince = Clock::now();
+
+    while (true) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+
+        const auto now = Clock::now();
+
+        for (const auto& outputDataset : outputDatasets)
+            if (outputDataset.isValid() && outputDataset->getTask().isAborted())
+                throw Error(ExitCode::StepAborted, QString("Task of %1 was aborted").arg(outputDataset->getGuiName()));
+
+        const auto allDatasets = mv::data().getAllDatasets();
+
+        const auto busy = std::any_of(allDatasets.begin(), allDatasets.end(), [](const Dataset<DatasetImpl>& dataset) -> bool {
+            return dataset.isValid() && isBusy(dataset->getTask());
+        });
+
+        if (busy)
+            idleSince = now;
+        else if (now - idleSince >= settleDuration)
+            return;
+
+        if (timeout.count() > 0 && now - start > timeout)
+            throw Error(ExitCode::StepTimedOut, QString("Timed out after %1 s").arg(QString::number(timeout.count())));
+
+        QThread::msleep(10);
+    }
+}
+
+}
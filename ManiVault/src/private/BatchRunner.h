@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <Dataset.h>
+
+#include <QString>
+#include <QVariantMap>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mv {
+
+/**
+ * Batch runner class
+ *
+ * Runs analyses and transformations without a display (headless mode, see the --batch command line option): opens
+ * a project, runs the steps of a batch file in order, waits for the tasks of the datasets to finish and saves the
+ * resulting project. Progress and timing are logged, the outcome is reported through the process exit code (see
+ * BatchRunner::ExitCode) so that runs can be scheduled on compute nodes.
+ *
+ * The batch file is a JSON document:
+ *
+ * {
+ *     "Project": "input.mv",                           (overridden by --project)
+ *     "Output": "output.mv",                           (overridden by --output, defaults to the input project)
+ *     "Steps": [
+ *         {
+ *             "Kind": "tSNE Analysis",                 (kind of analysis or transformation plugin)
+ *             "Inputs": [ "Dataset ID or name" ],
+ *             "Settings": { "Action path": { ... } },  (serialized actions of the plugin, as in a saved project)
+ *             "Triggers": [ "Action path" ],           (e.g. the action which starts the computation)
+ *             "Timeout": 3600                          (seconds, optional)
+ *         }
+ *     ]
+ * }
+ *
+ * The workspace of the project is not loaded (view plugins need a display), so the saved project has an empty
+ * workspace.
+ *
+ * @author Thomas Kroes
+ */
+class BatchRunner final
+{
+public:
+
+    /** Process exit codes */
+    enum class ExitCode : std::int32_t {
+        Success = 0,            /** All steps finished and the project was saved */
+        InvalidBatch = 2,       /** The batch file is missing or invalid */
+        ProjectNotOpened,       /** The project could not be opened */
+        StepFailed,             /** A step could not be set up (unknown plugin, input, setting or trigger) or threw an unexpected exception */
+        StepAborted,            /** A task of a step was aborted */
+        StepTimedOut,           /** A step did not finish within its timeout */
+        ProjectNotSaved         /** The resulting project could not be saved */
+    };
+
+    /** Batch error (carries the exit code) */
+    class Error : public std::runtime_error
+    {
+    public:
+
+        /**
+         * Construct with \p exitCode and \p message
+         * @param exitCode Process exit code
+         * @param message Error message
+         */
+        Error(ExitCode exitCode, const QString& message) :
+            std::runtime_error(message.toStdString()),
+            _exitCode(exitCode)
+        {
+        }
+
+        /**
+         * Get the exit code
+         * @return Process exit code
+         */
+        ExitCode getExitCode() const {
+            return _exitCode;
+        }
+
+    private:
+        ExitCode    _exitCode;  /** Process exit code */
+    };
+
+    /** Time without running dataset tasks after which a step is considered finished (tasks may start asynchronously) */
+    static constexpr std::chrono::milliseconds settleDuration{ 1000 };
+
+public:
+
+    /**
+     * Construct with \p batchFilePath and optional overrides
+     * @param batchFilePath Path of the batch file
+     * @param projectFilePath Path of the project to open (overrides the batch file when non-empty)
+     * @param outputFilePath Path to save the resulting project to (overrides the batch file when non-empty)
+     */
+    BatchRunner(const QString& batchFilePath, const QString& projectFilePath = "", const QString& outputFilePath = "");
+
+    /**
+     * Run the batch (the core must be initialized)
+     * @return Process exit code
+     */
+    std::int32_t run();
+
+private:
+
+    /** Load the batch file (throws an Error when invalid) */
+    void loadBatch();
+
+    /** Open the project (throws an Error when it cannot be opened) */
+    void openProject();
+
+    /**
+     * Run \p step (throws an Error when it fails)
+     * @param step Variant map representation of the step
+     * @param stepIndex Index of the step
+     */
+    void runStep(const QVariantMap& step, std::int32_t stepIndex);
+
+    /** Save the project (throws an Error when it cannot be saved) */
+    void saveProject();
+
+    /**
+     * Get the datasets with \p datasetIdsOrNames (throws an Error when a dataset is not found or ambiguous)
+     * @param datasetIdsOrNames Dataset globally unique identifiers or GUI names
+     * @return Datasets
+     */
+    Datasets getDatasets(const QStringList& datasetIdsOrNames) const;
+
+    /**
+     * Process events until no dataset task is running anymore (throws an Error when a task of \p outputDatasets is aborted or on time out)
+     * @param outputDatasets Output datasets of the step
+     * @param timeout Maximum duration (zero means no limit)
+     */
+    void waitForDatasetTasks(const Datasets& outputDatasets, std::chrono::seconds timeout) const;
+
+private:
+    QString         _batchFilePath;     /** Path of the batch file */
+    QString         _projectFilePath;   /** Path of the project to open */
+    QString         _outputFilePath;    /** Path to save the resulting project to */
+    QVariantList    _steps;             /** Steps of the batch */
+};
+
+}
@@ -14,9 +14,12 @@
 #include "ProjectManager.h"
 #include "SettingsManager.h"
 #include "HelpManager.h"
+#include "MemoryManager.h"
 
 #include "Application.h"
 
+#include <util/Timer.h>
+
 //#define CORE_VERBOSE
 
 using namespace mv;
@@ -61,6 +64,7 @@ void Core::createManagers()
     _managers[static_cast<int>(ManagerType::Projects)]      = std::make_unique<ProjectManager>(this);
     _managers[static_cast<int>(ManagerType::Settings)]      = std::make_unique<SettingsManager>(this);
     _managers[static_cast<int>(ManagerType::Help)]          = std::make_unique<HelpManager>(this);
+    _managers[static_cast<int>(ManagerType::Memory)]        = std::make_unique<MemoryManager>(this);
 
     setManagersCreated();
 }
@@ -98,7 +102,11 @@ void Core::initialize()
         for (auto& manager : _managers) {
             loadCoreManagersTask.setSubtaskStarted(manager->getSerializationName(), "Initializing " + manager->getSerializationName().toLower() + " manager");
             {
+                Timer timer;
+
                 manager->initialize();
+
+                Application::current()->getStartupTask().addTiming("Initialize " + manager->getSerializationName().toLower() + " manager", timer.getElapsedTimeMilliseconds());
             }
             loadCoreManagersTask.setSubtaskFinished(manager->getSerializationName(), "Initializing " + manager->getSerializationName().toLower() + " manager");
         }
@@ -189,4 +197,9 @@ mv::AbstractHelpManager& Core::getHelpManager()
     return *dynamic_cast<AbstractHelpManager*>(getManager(ManagerType::Help));
 }
 
+AbstractMemoryManager& Core::getMemoryManager()
+{
+    return *dynamic_cast<AbstractMemoryManager*>(getManager(ManagerType::Memory));
+}
+
 }
@@ -18,6 +18,7 @@ class AbstractWorkspaceManager;
 class AbstractProjectManager;
 class AbstractSettingsManager;
 class AbstractHelpManager;
+class AbstractMemoryManager;
 
 class Core final : public CoreInterface
 {
@@ -77,6 +78,7 @@ public: // Managers
     AbstractProjectManager& getProjectManager() override;
     AbstractSettingsManager& getSettingsManager() override;
     AbstractHelpManager& getHelpManager() override;
+    AbstractMemoryManager& getMemoryManager() override;
 
 private:
     std::vector<std::unique_ptr<AbstractManager>>   _managers;              /** All managers in the core */
@@ -6,6 +6,7 @@
 #include "DataManager.h"
 
 #include <util/Exception.h>
+#include <util/Trace.h>
 
 #include <algorithm>
 #include <stdexcept>
@@ -265,6 +266,8 @@ void DataHierarchyManager::fromVariantMap(const QVariantMap& variantMap)
         const auto isFull           = dataset["Full"].toBool();
         const auto sourceDatasetID  = dataset["SourceDatasetID"].toString();
 
+        MV_TRACE_SCOPE_DETAIL("project", "Create dataset", datasetName);
+
         auto subtaskName = QString("Loading dataset hierarchy item: %1").arg(datasetName);
         projectDataSerializationTask.setSubtaskStarted(datasetId, subtaskName);
 
@@ -322,7 +325,11 @@ void DataHierarchyManager::fromVariantMap(const QVariantMap& variantMap)
             auto subtaskName = QString("Loading dataset: %1").arg(datasetName);
             projectDataSerializationTask.setSubtaskStarted(datasetId, subtaskName);
 
-            mv::data().getDataset(datasetId)->fromVariantMap(dataVariantMap);
+            {
+                MV_TRACE_SCOPE_DETAIL("project", "Load dataset", datasetName);
+
+                mv::data().getDataset(datasetId)->fromVariantMap(dataVariantMap);
+            }
 
             projectDataSerializationTask.setSubtaskFinished(datasetId, subtaskName);
 
@@ -362,6 +369,8 @@ QVariantMap DataHierarchyManager::toVariantMap() const
 
             projectDataSerializationTask.setSubtaskStarted(dataHierarchyItem->getDataset()->getId(), QString("Saving %1").arg(datasetName));
 
+            MV_TRACE_SCOPE_DETAIL("project", "Save dataset hierarchy", datasetName);
+
             auto dataHierarchyItemMap = dataHierarchyItem->toVariantMap();
 
             QCoreApplication::processEvents();
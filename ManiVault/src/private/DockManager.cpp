@@ -189,7 +189,8 @@ void DockManager::fromVariantMap(const QVariantMap& variantMap)
             const auto pluginMap        = viewPluginMap["Plugin"].toMap();
             const auto guiName          = viewPluginMap["GuiName"].toMap()["Value"].toString();
 
-            if (plugins().isPluginLoaded(pluginKind)) {
+            // Loads the plugin shared library if it was deferred, so that a library which fails to load ends up as not loaded
+            if (plugins().loadDeferredPluginFactory(pluginKind)) {
                 addViewPluginDockWidget(RightDockWidgetArea, new ViewPluginDockWidget(viewPluginDockWidgetVariant.toMap()));
             } else {
                 auto notLoadedDockWidget    = new CDockWidget(QString("%1 (not loaded)").arg(guiName));
@@ -5,6 +5,7 @@
 #include "EventManager.h"
 
 #include <util/Exception.h>
+#include <util/Trace.h>
 
 #include <event/Event.h>
 
@@ -60,6 +61,8 @@ void EventManager::initialize()
             if (!dataset->needsSelectionUpdate())
                 continue;
 
+            MV_TRACE_SCOPE_DETAIL("events", "Propagate selection", dataset->getGuiName());
+
             // For all datasets, check if they relate to the current dataset and notify them as well
             for (auto candidateDataset : mv::data().getAllDatasets()) {
                 // Ignore the current dataset
@@ -86,6 +89,8 @@ void EventManager::initialize()
             if (!dataset->needsSelectionUpdate())
                 continue;
             
+            MV_TRACE_SCOPE_DETAIL("events", "Dispatch selection changed", dataset->getGuiName());
+
             DatasetDataSelectionChangedEvent dataSelectionChangedEvent(dataset);
             
             // For every listener, find it in the original list and call its DataSelectionChangedEvent
@@ -125,6 +130,8 @@ void EventManager::unregisterEventListener(EventListener* eventListener)
 void EventManager::notifyDatasetAdded(const Dataset<DatasetImpl>& dataset)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset added", dataset->getGuiName());
+
         DatasetAddedEvent dataEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -145,6 +152,8 @@ void EventManager::notifyDatasetAdded(const Dataset<DatasetImpl>& dataset)
 void EventManager::notifyDatasetAboutToBeRemoved(const Dataset<DatasetImpl>& dataset)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset about to be removed", dataset->getGuiName());
+
         DatasetAboutToBeRemovedEvent dataAboutToBeRemovedEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -165,6 +174,8 @@ void EventManager::notifyDatasetAboutToBeRemoved(const Dataset<DatasetImpl>& dat
 void EventManager::notifyDatasetRemoved(const QString& datasetId, const DataType& dataType)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset removed", datasetId);
+
         DatasetRemovedEvent dataRemovedEvent(nullptr, datasetId, dataType);
 
         const auto eventListeners = _eventListeners;
@@ -185,6 +196,8 @@ void EventManager::notifyDatasetRemoved(const QString& datasetId, const DataType
 void EventManager::notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset data changed", dataset->getGuiName());
+
         DatasetDataChangedEvent dataEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -205,6 +218,8 @@ void EventManager::notifyDatasetDataChanged(const Dataset<DatasetImpl>& dataset)
 void EventManager::notifyDatasetDataDimensionsChanged(const Dataset<DatasetImpl>& dataset)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset data dimensions changed", dataset->getGuiName());
+
         DatasetDataDimensionsChangedEvent dataEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -225,6 +240,8 @@ void EventManager::notifyDatasetDataDimensionsChanged(const Dataset<DatasetImpl>
 void EventManager::notifyDatasetDataSelectionChanged(const Dataset<DatasetImpl>& dataset, Datasets* ignoreDatasets /*= nullptr*/)
 {
     try {
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset data selection changed", dataset->getGuiName());
+
 #ifdef EVENT_MANAGER_VERBOSE
         QStringList datasetNotifiedString;
 
@@ -263,6 +280,8 @@ void EventManager::notifyDatasetLocked(const Dataset<DatasetImpl>& dataset)
         if (!dataset.isValid())
             throw std::runtime_error("Dataset is invalid");
 
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset locked", dataset->getGuiName());
+
         DatasetLockedEvent dataLockedEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -287,6 +306,8 @@ void EventManager::notifyDatasetUnlocked(const Dataset<DatasetImpl>& dataset)
         if (!dataset.isValid())
             throw std::runtime_error("Dataset is invalid");
 
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset unlocked", dataset->getGuiName());
+
         DatasetUnlockedEvent dataUnlockedEvent(dataset);
 
         const auto eventListeners = _eventListeners;
@@ -304,4 +325,30 @@ void EventManager::notifyDatasetUnlocked(const Dataset<DatasetImpl>& dataset)
     }
 }
 
+void EventManager::notifyDatasetLinkedDataChanged(const Dataset<DatasetImpl>& dataset)
+{
+    try {
+
+        if (!dataset.isValid())
+            throw std::runtime_error("Dataset is invalid");
+
+        MV_TRACE_SCOPE_DETAIL("events", "Dataset linked data changed", dataset->getGuiName());
+
+        DatasetLinkedDataChangedEvent linkedDataChangedEvent(dataset);
+
+        const auto eventListeners = _eventListeners;
+
+        for (auto listener : eventListeners)
+            if (std::find(_eventListeners.begin(), _eventListeners.end(), listener) != _eventListeners.end())
+                callListenerDataEvent(listener, &linkedDataChangedEvent);
+    }
+    catch (std::exception& e)
+    {
+        exceptionMessageBox("Unable to notify that dataset linked data has changed", e);
+    }
+    catch (...) {
+        exceptionMessageBox("Unable to notify that dataset linked data has changed");
+    }
+}
+
 }
@@ -88,6 +88,12 @@ public:
      */
     void notifyDatasetUnlocked(const Dataset<DatasetImpl>& dataset) override;
 
+    /**
+     * Notify all listeners that linked data of a dataset changed (linked data added, removed or its mapping changed)
+     * @param dataset Smart pointer to the source dataset of the linked data
+     */
+    void notifyDatasetLinkedDataChanged(const Dataset<DatasetImpl>& dataset) override;
+
     /**
      * Register an event listener
      * @param eventListener Pointer to event listener to register
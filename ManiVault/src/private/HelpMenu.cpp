@@ -56,7 +56,8 @@ void HelpMenu::populate()
     
     QVector<QPointer<TriggerAction>> actions;
 
-    for (auto& pluginFactory : plugins().getPluginFactoriesByTypes({ Type::ANALYSIS, Type::DATA, Type::LOADER, Type::WRITER, Type::TRANSFORMATION, Type::VIEW }))
+    // Plugins with instances are loaded, so there is no need to load the deferred plugins
+    for (auto& pluginFactory : plugins().getLoadedPluginFactories())
         if (pluginFactory->hasHelp() && pluginFactory->getNumberOfInstances() >= 1)
             actions << &pluginFactory->getPluginMetadata().getTriggerHelpAction();
 
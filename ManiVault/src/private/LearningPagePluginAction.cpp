@@ -5,6 +5,7 @@
 #include "LearningPagePluginAction.h"
 
 #include <Application.h>
+#include <CoreInterface.h>
 #include <PluginFactory.h>
 
 #include <QDebug>
@@ -13,24 +14,19 @@
 using namespace mv;
 using namespace mv::plugin;
 
-LearningPagePluginActionsWidget::LearningPagePluginActionsWidget(const mv::plugin::PluginFactory* pluginFactory, QWidget* parent /*= nullptr*/) :
+LearningPagePluginActionsWidget::LearningPagePluginActionsWidget(const AbstractPluginManager::PluginFactoryInfo& pluginFactoryInfo, QWidget* parent /*= nullptr*/) :
     QWidget(parent),
-    _pluginFactory(pluginFactory),
+    _pluginFactoryInfo(pluginFactoryInfo),
     _actionsOverlayWidget(this)
 {
-    Q_ASSERT(_pluginFactory);
-
-    if (!_pluginFactory)
-        return;
-
     setObjectName("LearningPagePluginActionsWidget");
     setMouseTracking(true);
 
     auto categoryIconLabel  = new QLabel();
-    auto nameLabel          = new QLabel(_pluginFactory->getKind());
-    auto versionLabel       = new QLabel(QString("v%1").arg(QString::fromStdString(_pluginFactory->getVersion().getVersionString())));
+    auto nameLabel          = new QLabel(_pluginFactoryInfo._kind);
+    auto versionLabel       = new QLabel(QString("v%1").arg(_pluginFactoryInfo._version));
 
-    categoryIconLabel->setPixmap(_pluginFactory->getCategoryIcon().pixmap(QSize(12, 12)));
+    categoryIconLabel->setPixmap(getPluginTypeIcon(_pluginFactoryInfo._type).pixmap(QSize(12, 12)));
 
     categoryIconLabel->setToolTip("Plugin category");
     nameLabel->setToolTip("Name of the plugin");
@@ -62,9 +58,9 @@ LearningPagePluginActionsWidget::LearningPagePluginActionsWidget(const mv::plugi
     updateStyle();
 }
 
-const PluginFactory* LearningPagePluginActionsWidget::getPluginFactory() const
+const AbstractPluginManager::PluginFactoryInfo& LearningPagePluginActionsWidget::getPluginFactoryInfo() const
 {
-    return _pluginFactory;
+    return _pluginFactoryInfo;
 }
 
 void LearningPagePluginActionsWidget::enterEvent(QEnterEvent* enterEvent)
@@ -103,7 +99,7 @@ bool LearningPagePluginActionsWidget::event(QEvent* event)
 
 bool LearningPagePluginActionsWidget::hasOverlay() const
 {
-    return _pluginFactory->getReadmeMarkdownUrl().isValid() || _pluginFactory->getRepositoryUrl().isValid();
+    return _pluginFactoryInfo._readmeMarkdownUrl.isValid() || _pluginFactoryInfo._repositoryUrl.isValid();
 }
 
 void LearningPagePluginActionsWidget::updateStyle()
@@ -125,12 +121,15 @@ LearningPagePluginActionsWidget::ActionsOverlayWidget::ActionsOverlayWidget(Lear
     _mainLayout.setContentsMargins(4, 2, 4, 2);
     _mainLayout.addStretch(1);
 
-    const auto hasReadmeMarkdownUrl = _learningPagePluginActionWidget->getPluginFactory()->getReadmeMarkdownUrl().isValid();
-    const auto hasRespositoryUrl    = _learningPagePluginActionWidget->getPluginFactory()->getRepositoryUrl().isValid();
+    const auto& pluginFactoryInfo = _learningPagePluginActionWidget->getPluginFactoryInfo();
+
+    const auto hasReadmeMarkdownUrl = pluginFactoryInfo._readmeMarkdownUrl.isValid();
+    const auto hasRespositoryUrl    = pluginFactoryInfo._repositoryUrl.isValid();
 
     if (hasReadmeMarkdownUrl) {
         auto triggerReadmeActionWidget = new ActionWidget("book", [this]() -> void {
-            const_cast<PluginFactory*>(_learningPagePluginActionWidget->getPluginFactory())->getPluginMetadata().getTriggerReadmeAction().trigger();
+            if (auto pluginFactory = mv::plugins().loadDeferredPluginFactory(_learningPagePluginActionWidget->getPluginFactoryInfo()._kind))
+                pluginFactory->getPluginMetadata().getTriggerReadmeAction().trigger();
         });
 
         triggerReadmeActionWidget->setToolTip("View the plugin readme content");
@@ -140,7 +139,8 @@ LearningPagePluginActionsWidget::ActionsOverlayWidget::ActionsOverlayWidget(Lear
 
     if (hasRespositoryUrl) {
         auto visitRepositoryActionWidget = new ActionWidget("globe", [this]() -> void {
-            const_cast<PluginFactory*>(_learningPagePluginActionWidget->getPluginFactory())->getPluginMetadata().getVisitRepositoryAction().trigger();
+            if (auto pluginFactory = mv::plugins().loadDeferredPluginFactory(_learningPagePluginActionWidget->getPluginFactoryInfo()._kind))
+                pluginFactory->getPluginMetadata().getVisitRepositoryAction().trigger();
         });
 
         visitRepositoryActionWidget->setToolTip("Visit the plugin repository");
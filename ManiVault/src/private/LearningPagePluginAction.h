@@ -6,16 +6,14 @@
 
 #include "util/WidgetOverlayer.h"
 
+#include <AbstractPluginManager.h>
+
 #include <QLabel>
 #include <QHBoxLayout>
 #include <QWidget>
 
 #include <functional>
 
-namespace mv::plugin {
-    class PluginFactory;
-}
-
 /**
  * Learning page plugin action widget class
  *
@@ -81,11 +79,11 @@ private:
 protected:
 
     /**
-     * Construct with pointer to \p pluginFactory and pointer to \p parent widget
-     * @param pluginFactory Pointer plugin factory
+     * Construct with \p pluginFactoryInfo and pointer to \p parent widget
+     * @param pluginFactoryInfo Plugin factory properties (the plugin need not be loaded)
      * @param parent Pointer parent widget
      */
-    LearningPagePluginActionsWidget(const mv::plugin::PluginFactory* pluginFactory, QWidget* parent = nullptr);
+    LearningPagePluginActionsWidget(const mv::AbstractPluginManager::PluginFactoryInfo& pluginFactoryInfo, QWidget* parent = nullptr);
 
     /**
      * Triggered on mouse hover
@@ -108,19 +106,19 @@ protected:
 private:
 
     /**
-     * Get the plugin factory which is associated with the plugin action
-     * @param Pointer to plugin factory
+     * Get the properties of the plugin factory which is associated with the plugin action
+     * @return Plugin factory properties
      */
-    const mv::plugin::PluginFactory* getPluginFactory() const;
+    const mv::AbstractPluginManager::PluginFactoryInfo& getPluginFactoryInfo() const;
 
     bool hasOverlay() const;
 
     void updateStyle();
 
 private:
-    const mv::plugin::PluginFactory*    _pluginFactory;             /** Pointer to plugin factory */
-    QHBoxLayout                         _mainLayout;                /** Main vertical layout */
-    ActionsOverlayWidget                _actionsOverlayWidget;      /** Overlay widget which shows the associated plugin actions */
+    mv::AbstractPluginManager::PluginFactoryInfo    _pluginFactoryInfo;         /** Plugin factory properties */
+    QHBoxLayout                                     _mainLayout;                /** Main vertical layout */
+    ActionsOverlayWidget                            _actionsOverlayWidget;      /** Overlay widget which shows the associated plugin actions */
 
     friend class LearningPagePluginResourcesWidget;
 };
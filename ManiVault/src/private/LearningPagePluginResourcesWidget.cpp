@@ -33,8 +33,9 @@ LearningPagePluginResourcesWidget::LearningPagePluginResourcesWidget(LearningPag
 
     QSet<QString> pluginTypesSet;
 
-    for (auto pluginFactory : mv::plugins().getPluginFactoriesByTypes())
-        pluginTypesSet.insert(getPluginTypeName(pluginFactory->getType()));
+    // Plugins are listed from their factory properties, so that deferred plugin shared libraries are not loaded
+    for (const auto& pluginFactoryInfo : mv::plugins().getPluginFactoryInfos())
+        pluginTypesSet.insert(getPluginTypeName(pluginFactoryInfo._type));
 
     QStringList pluginTypes(pluginTypesSet.begin(), pluginTypesSet.end());
 
@@ -57,7 +58,7 @@ void LearningPagePluginResourcesWidget::updateFlowLayout()
         delete layoutItem;
     }
 
-    for (auto pluginFactory : mv::plugins().getPluginFactoriesByTypes())
-        if (_pluginTypesFilterAction.getSelectedOptions().contains(getPluginTypeName(pluginFactory->getType())))
-            _pluginsLayout.addWidget(new LearningPagePluginActionsWidget(pluginFactory));
+    for (const auto& pluginFactoryInfo : mv::plugins().getPluginFactoryInfos())
+        if (_pluginTypesFilterAction.getSelectedOptions().contains(getPluginTypeName(pluginFactoryInfo._type)))
+            _pluginsLayout.addWidget(new LearningPagePluginActionsWidget(pluginFactoryInfo));
 }
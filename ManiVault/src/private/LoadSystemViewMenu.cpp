@@ -35,6 +35,9 @@ LoadSystemViewMenu::LoadSystemViewMenu(QWidget *parent /*= nullptr*/, ads::CDock
     _loadViewsDockedMenus.insert(gui::DockAreaFlag::Center, QSharedPointer<QMenu>(new QMenu(gui::dockAreaMap.key(gui::DockAreaFlag::Center), this)));
 
     populate();
+
+    // Re-populate when shown, deferred view plugins might have been loaded in the meantime
+    connect(this, &QMenu::aboutToShow, this, &LoadSystemViewMenu::populate);
 }
 
 void LoadSystemViewMenu::populate()
@@ -66,13 +69,15 @@ void LoadSystemViewMenu::populate()
 
 bool LoadSystemViewMenu::mayProducePlugins() const
 {
-    for (auto& pluginTriggerAction : plugins().getPluginTriggerActions(Type::VIEW)) {
-        auto viewPluginFactory = dynamic_cast<const ViewPluginFactory*>(pluginTriggerAction->getPluginFactory());
-
-        if (!viewPluginFactory->producesSystemViewPlugins())
+    for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ Type::VIEW })) {
+        if (!pluginFactoryInfo._producesSystemViewPlugins)
             continue;
 
-        if (pluginTriggerAction->isEnabled())
+        // Deferred view plugins have no instances yet
+        if (!pluginFactoryInfo._isLoaded)
+            return true;
+
+        if (plugins().getPluginFactory(pluginFactoryInfo._kind)->getPluginTriggerAction().isEnabled())
             return true;
     }
 
@@ -83,23 +88,27 @@ QVector<QPointer<TriggerAction>> LoadSystemViewMenu::getLoadSystemViewsActions(m
 {
     QVector<QPointer<TriggerAction>> actions;
 
-    auto pluginTriggerActions = plugins().getPluginTriggerActions(Type::VIEW);
+    // View plugins are listed from their factory properties, deferred view plugins are only loaded when one is created
+    for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ Type::VIEW })) {
+        if (!pluginFactoryInfo._producesSystemViewPlugins)
+            continue;
+
+        const auto pluginKind = pluginFactoryInfo._kind;
 
-    for (auto& pluginTriggerAction : pluginTriggerActions) {
-        auto viewPluginFactory = dynamic_cast<const ViewPluginFactory*>(pluginTriggerAction->getPluginFactory());
+        auto action = new TriggerAction(this, pluginKind);
 
-        if (!viewPluginFactory->producesSystemViewPlugins())
-            continue;
+        action->setIcon(pluginFactoryInfo._icon);
 
-        auto action = new TriggerAction(this, viewPluginFactory->getKind());
+        if (pluginFactoryInfo._isLoaded) {
+            auto pluginTriggerAction = &plugins().getPluginFactory(pluginKind)->getPluginTriggerAction();
 
-        action->setIcon(pluginTriggerAction->icon());
-        action->setEnabled(pluginTriggerAction->isEnabled());
+            action->setEnabled(pluginTriggerAction->isEnabled());
 
-        connect(pluginTriggerAction, &PluginTriggerAction::enabledChanged, action, [action, pluginTriggerAction](bool enabled) -> void {
-            if (enabled != action->isEnabled())
-                action->setEnabled(enabled);
-        });
+            connect(pluginTriggerAction, &PluginTriggerAction::enabledChanged, action, [action](bool enabled) -> void {
+                if (enabled != action->isEnabled())
+                    action->setEnabled(enabled);
+            });
+        }
 
         ViewPlugin* dockToViewPlugin = nullptr;
 
@@ -112,8 +121,10 @@ QVector<QPointer<TriggerAction>> LoadSystemViewMenu::getLoadSystemViewsActions(m
                 dockToViewPlugin = firstViewPluginDockWidget->getViewPlugin();
         }
 
-        connect(action, &QAction::triggered, this, [pluginTriggerAction, dockToViewPlugin, viewPluginFactory, dockArea]() -> void {
-            Application::core()->getPluginManager().requestViewPlugin(pluginTriggerAction->getPluginFactory()->getKind(), dockToViewPlugin, dockArea == DockAreaFlag::None ? viewPluginFactory->getPreferredDockArea() : dockArea);
+        const auto preferredDockArea = pluginFactoryInfo._preferredDockArea;
+
+        connect(action, &QAction::triggered, this, [pluginKind, dockToViewPlugin, preferredDockArea, dockArea]() -> void {
+            Application::core()->getPluginManager().requestViewPlugin(pluginKind, dockToViewPlugin, dockArea == DockAreaFlag::None ? preferredDockArea : dockArea);
         });
 
         actions << action;
@@ -49,7 +49,8 @@ LoggingStatusBarAction::LoggingStatusBarAction(QObject* parent, const QString& t
         if (loggingPlugin)
             return loggingPlugin->getNumberOfInstances() == 0;
 
-        return false;
+        // A deferred plugin has no instances yet
+        return mv::plugins().isPluginDeferred("Logging");
     };
 
     _recordsAction.setWidgetConfigurationFunction([this, checkLoggingPluginAvailable](WidgetAction* action, QWidget* widget) -> void {
@@ -129,7 +129,8 @@ void MainWindow::showEvent(QShowEvent* showEvent)
             return statusBar()->findChildren<QWidget*>(Qt::FindDirectChildrenOnly).count();
         };
 
-        for (auto pluginFactory : mv::plugins().getPluginFactoriesByTypes()) {
+        // Plugins with a status bar action are always loaded at startup, so there is no need to load the deferred plugins
+        for (auto pluginFactory : mv::plugins().getLoadedPluginFactories()) {
             if (auto statusBarAction = pluginFactory->getStatusBarAction()) {
                 const auto index = statusBarAction->getIndex();
 
@@ -0,0 +1,312 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "MemoryManager.h"
+
+#include <CoreInterface.h>
+#include <Set.h>
+
+#include <util/Miscellaneous.h>
+
+#include <QDir>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _DEBUG
+    //#define MEMORY_MANAGER_VERBOSE
+#endif
+
+using namespace mv::gui;
+using namespace mv::util;
+
+namespace mv
+{
+
+namespace
+{
+    /**
+     * Get the spill file path for \p spillName in \p spillDirectory
+     * @param spillDirectory Spill directory
+     * @param spillName Spill name
+     * @return Spill file path
+     */
+    QString getSpillFilePath(const QString& spillDirectory, const QString& spillName)
+    {
+        static const QRegularExpression invalidCharacters("[^A-Za-z0-9_-]");
+
+        const auto fileName = QString("%1_%2.spill").arg(QString(spillName).replace(invalidCharacters, "_"), QString::number(qHash(spillName), 16));
+
+        return QDir(spillDirectory).filePath(fileName);
+    }
+}
+
+MemoryManager::MemoryManager(QObject* parent) :
+    AbstractMemoryManager(parent),
+    _updateTimer(),
+    _summaryAction(this, "Memory usage"),
+    _spilledBytes(),
+    _numberOfSpilledBytes(0),
+    _accountingGeneration(0),
+    _budgetExceededReported(false)
+{
+    _summaryAction.setEnabled(false);
+    _summaryAction.setToolTip("Host memory occupied by raw data, selections and caches");
+
+    _updateTimer.setInterval(updateInterval);
+
+    connect(&_updateTimer, &QTimer::timeout, this, &MemoryManager::update);
+}
+
+MemoryManager::~MemoryManager()
+{
+    reset();
+}
+
+void MemoryManager::initialize()
+{
+#ifdef MEMORY_MANAGER_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    AbstractMemoryManager::initialize();
+
+    if (isInitialized())
+        return;
+
+    beginInitialization();
+    {
+        auto& memorySettingsAction = mv::settings().getMemorySettingsAction();
+
+        connect(&memorySettingsAction.getEnforceBudgetAction(), &ToggleAction::toggled, this, &MemoryManager::update);
+        connect(&memorySettingsAction.getBudgetAction(), &IntegralAction::valueChanged, this, &MemoryManager::update);
+        connect(&memorySettingsAction.getSpillToDiskAction(), &ToggleAction::toggled, this, &MemoryManager::update);
+
+        _updateTimer.start();
+    }
+    endInitialization();
+}
+
+void MemoryManager::reset()
+{
+#ifdef MEMORY_MANAGER_VERBOSE
+    qDebug() << __FUNCTION__;
+#endif
+
+    beginReset();
+    {
+        if (isCoreDestroyed())
+            _updateTimer.stop();
+    }
+    endReset();
+}
+
+std::uint64_t MemoryManager::getNumberOfSpilledBytes() const
+{
+    return _numberOfSpilledBytes;
+}
+
+bool MemoryManager::isSpilled(const QString& spillName) const
+{
+    return _spilledBytes.contains(spillName);
+}
+
+std::uint64_t MemoryManager::getBudget() const
+{
+    return mv::settings().getMemorySettingsAction().getBudget();
+}
+
+QString MemoryManager::getSpillDirectory() const
+{
+    return mv::settings().getMemorySettingsAction().getSpillDirectoryAction().getString();
+}
+
+void MemoryManager::update()
+{
+    if (!isInitialized() || isCoreDestroyed())
+        return;
+
+    const auto previousSpilledBytes = _spilledBytes;
+
+    updateAccounting();
+    enforceBudget();
+
+    if (MemoryAccounting::getGeneration() == _accountingGeneration && _spilledBytes == previousSpilledBytes)
+        return;
+
+    _accountingGeneration = MemoryAccounting::getGeneration();
+
+    updateSummary();
+
+    emit accountingChanged();
+}
+
+void MemoryManager::updateAccounting()
+{
+    Spillable::advanceAccessClock();
+
+    QMap<QString, std::uint64_t> spilledBytes;
+
+    Spillable::visitSpillables([&spilledBytes](const std::vector<Spillable*>& spillables) -> void {
+        for (auto spillable : spillables)
+            if (spillable->isSpilled())
+                spilledBytes[spillable->getSpillName()] = 0;
+    });
+
+    MemoryAccounting::Allocations rawDataAllocations;
+
+    for (const auto& rawDataName : mv::data().getRawDataNames()) {
+        const auto rawDataSize = mv::data().getRawDataSize(rawDataName);
+
+        if (spilledBytes.contains(rawDataName))
+            spilledBytes[rawDataName] = rawDataSize;
+        else if (rawDataSize > 0)
+            rawDataAllocations[rawDataName] = rawDataSize;
+    }
+
+    MemoryAccounting::setAllocations(MemoryAccounting::Category::RawData, rawDataAllocations);
+
+    MemoryAccounting::Allocations selectionAllocations;
+
+    for (auto& selection : mv::data().getAllSelections()) {
+        if (!selection.isValid())
+            continue;
+
+        const auto numberOfBytes = static_cast<std::uint64_t>(selection->getSelectionIndices().capacity() * sizeof(std::uint32_t));
+
+        if (numberOfBytes > 0)
+            selectionAllocations[selection->getRawDataName()] = numberOfBytes;
+    }
+
+    MemoryAccounting::setAllocations(MemoryAccounting::Category::Selection, selectionAllocations);
+
+    _spilledBytes           = spilledBytes;
+    _numberOfSpilledBytes   = 0;
+
+    for (const auto numberOfBytes : _spilledBytes)
+        _numberOfSpilledBytes += numberOfBytes;
+}
+
+void MemoryManager::enforceBudget()
+{
+    const auto budget               = getBudget();
+    const auto numberOfHostBytes    = getNumberOfHostBytes();
+
+    if (budget == 0 || numberOfHostBytes <= budget) {
+        _budgetExceededReported = false;
+        return;
+    }
+
+    if (!mv::settings().getMemorySettingsAction().getSpillToDiskAction().isChecked()) {
+        if (!_budgetExceededReported)
+            qWarning() << QString("Memory budget of %1 exceeded (%2 in use), spilling to disk is disabled").arg(getNoBytesHumanReadable(budget), getNoBytesHumanReadable(numberOfHostBytes));
+
+        _budgetExceededReported = true;
+
+        return;
+    }
+
+    const auto spillDirectory = getSpillDirectory();
+
+    if (!QDir().mkpath(spillDirectory)) {
+        qWarning() << "Unable to create spill directory" << spillDirectory;
+        return;
+    }
+
+    const auto accessClock = Spillable::getAccessClock();
+
+    auto numberOfBytesToFree = numberOfHostBytes - budget;
+
+    QList<QPair<QString, std::uint64_t>> spilledSpillables;
+
+    Spillable::visitSpillables([&](const std::vector<Spillable*>& spillables) -> void {
+        std::vector<Spillable*> candidates;
+
+        // Spillables which were accessed since the previous update are considered in use
+        for (auto spillable : spillables)
+            if (!spillable->isSpilled() && !spillable->isPinned() && spillable->getLastAccessTick() + 1 < accessClock && spillable->getNumberOfResidentBytes() > 0)
+                candidates.push_back(spillable);
+
+        std::sort(candidates.begin(), candidates.end(), [](const Spillable* lhs, const Spillable* rhs) -> bool {
+            return lhs->getLastAccessTick() < rhs->getLastAccessTick();
+        });
+
+        for (auto candidate : candidates) {
+            if (numberOfBytesToFree == 0)
+                break;
+
+            const auto spillName                = candidate->getSpillName();
+            const auto numberOfResidentBytes    = candidate->getNumberOfResidentBytes();
+
+            try {
+                if (!candidate->spill(getSpillFilePath(spillDirectory, spillName)))
+                    continue;
+
+                numberOfBytesToFree -= std::min(numberOfBytesToFree, numberOfResidentBytes);
+
+                spilledSpillables << QPair<QString, std::uint64_t>(spillName, numberOfResidentBytes);
+            }
+            catch (std::exception& e)
+            {
+                qWarning() << "Unable to spill" << spillName << "to disk:" << e.what();
+            }
+        }
+    });
+
+    if (spilledSpillables.isEmpty())
+        return;
+
+    for (const auto& [spillName, numberOfBytes] : spilledSpillables) {
+#ifdef MEMORY_MANAGER_VERBOSE
+        qDebug() << "Spilled" << spillName << getNoBytesHumanReadable(numberOfBytes) << "to disk";
+#endif
+
+        emit spilled(spillName, numberOfBytes);
+    }
+
+    updateAccounting();
+}
+
+void MemoryManager::updateSummary()
+{
+    using Category = MemoryAccounting::Category;
+
+    QStringList hostCategories, toolTipLines;
+
+    for (int categoryIndex = 0; categoryIndex < static_cast<int>(Category::Count); categoryIndex++) {
+        const auto category         = static_cast<Category>(categoryIndex);
+        const auto numberOfBytes    = getNumberOfBytes(category);
+        const auto categoryName     = MemoryAccounting::getCategoryName(category);
+
+        toolTipLines << QString("%1: %2").arg(categoryName, getNoBytesHumanReadable(numberOfBytes));
+
+        if (MemoryAccounting::isHostCategory(category) && numberOfBytes > 0)
+            hostCategories << QString("%1 %2").arg(categoryName.toLower(), getNoBytesHumanReadable(numberOfBytes));
+    }
+
+    const auto budget = getBudget();
+
+    auto summary = QString("Memory usage: %1").arg(getNoBytesHumanReadable(getNumberOfHostBytes()));
+
+    if (budget > 0)
+        summary += QString(" of %1").arg(getNoBytesHumanReadable(budget));
+
+    if (!hostCategories.isEmpty())
+        summary += QString(" (%1)").arg(hostCategories.join(", "));
+
+    if (const auto numberOfGpuBytes = getNumberOfBytes(Category::GpuBuffer); numberOfGpuBytes > 0)
+        summary += QString(", %1 on GPU").arg(getNoBytesHumanReadable(numberOfGpuBytes));
+
+    if (_numberOfSpilledBytes > 0)
+        summary += QString(", %1 spilled to disk").arg(getNoBytesHumanReadable(_numberOfSpilledBytes));
+
+    toolTipLines << QString("Spilled to disk: %1").arg(getNoBytesHumanReadable(_numberOfSpilledBytes));
+    toolTipLines << QString("Budget: %1").arg(budget > 0 ? getNoBytesHumanReadable(budget) : "Not enforced");
+
+    _summaryAction.setString(summary);
+    _summaryAction.setToolTip(toolTipLines.join("\n"));
+}
+
+}
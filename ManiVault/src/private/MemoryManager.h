@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <AbstractMemoryManager.h>
+
+#include <QMap>
+#include <QTimer>
+
+namespace mv
+{
+
+/**
+ * Memory manager class
+ *
+ * Periodically polls the raw data and selection memory, and spills the least recently used raw data to the
+ * spill directory when the host memory exceeds the memory budget (see gui::MemorySettingsAction). Raw data which
+ * was accessed since the previous update is never spilled, nor is pinned raw data (see util::Spillable::Pin).
+ *
+ * @author Thomas Kroes
+ */
+class MemoryManager final : public AbstractMemoryManager
+{
+    Q_OBJECT
+
+public:
+
+    /** Interval at which the memory accounting is updated and the memory budget is enforced */
+    static constexpr std::int32_t updateInterval = 1000;
+
+    /**
+     * Construct manager with pointer to \p parent object
+     * @param parent Pointer to parent object
+     */
+    MemoryManager(QObject* parent);
+
+    /** Reset when destructed */
+    ~MemoryManager() override;
+
+    /** Perform manager startup initialization */
+    void initialize() override;
+
+    /** Resets the contents of the memory manager */
+    void reset() override;
+
+    /**
+     * Get the number of bytes that are spilled to disk
+     * @return Number of bytes
+     */
+    std::uint64_t getNumberOfSpilledBytes() const override;
+
+    /**
+     * Get whether the spillable with \p spillName (e.g. raw data name) is spilled to disk
+     * @param spillName Spill name
+     * @return Boolean determining whether the spillable is spilled to disk
+     */
+    bool isSpilled(const QString& spillName) const override;
+
+    /**
+     * Get the memory budget
+     * @return Memory budget in bytes (zero when the budget is not enforced)
+     */
+    std::uint64_t getBudget() const override;
+
+    /**
+     * Get the directory in which spillables are spilled
+     * @return Spill directory
+     */
+    QString getSpillDirectory() const override;
+
+    /** Update the memory accounting and enforce the memory budget (also done periodically) */
+    void update() override;
+
+public: // Action getters
+
+    gui::StringAction& getSummaryAction() override { return _summaryAction; }
+
+private:
+
+    /** Poll the raw data and selection memory and the spilled spillables */
+    void updateAccounting();
+
+    /** Spill the least recently used spillables until the host memory is within the budget */
+    void enforceBudget();
+
+    /** Update the summary action text */
+    void updateSummary();
+
+private:
+    QTimer                          _updateTimer;               /** Timer for periodic updates */
+    gui::StringAction               _summaryAction;             /** Summary of the memory usage */
+    QMap<QString, std::uint64_t>    _spilledBytes;              /** Number of spilled bytes per spill name */
+    std::uint64_t                   _numberOfSpilledBytes;      /** Total number of spilled bytes */
+    std::uint64_t                   _accountingGeneration;      /** Accounting generation at the previous update */
+    bool                            _budgetExceededReported;    /** Whether exceeding the budget without spilling was reported */
+};
+
+}
@@ -6,6 +6,9 @@
 
 #include "Core.h"
 
+#include <Application.h>
+#include <ApplicationStartupTask.h>
+
 #include <AnalysisPlugin.h>
 #include <LoaderPlugin.h>
 #include <PluginFactory.h>
@@ -16,14 +19,18 @@
 #include <WriterPlugin.h>
 
 #include <util/Serialization.h>
+#include <util/Timer.h>
 
 #include <actions/PluginTriggerAction.h>
 
+#include <QBuffer>
 #include <QDebug>
 #include <QJsonArray>
 #include <QJsonValue>
+#include <QPixmap>
 #include <QPluginLoader>
 #include <QSet>
+#include <QStandardPaths>
 
 #include <cassert>
 #include <utility>
@@ -37,6 +44,9 @@
 
 namespace mv {
 
+/** Size of the plugin icons in the plugin metadata cache */
+constexpr QSize cachedIconSize(32, 32);
+
 using namespace util;
 using namespace plugin;
 using namespace gui;
@@ -44,7 +54,8 @@ using namespace gui;
 PluginManager::PluginManager(QObject* parent) :
     AbstractPluginManager(parent),
     _listModel(nullptr),
-    _treeModel(nullptr)
+    _treeModel(nullptr),
+    _metadataCache(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("PluginMetadataCache.json"))
 {
     setObjectName("Plugins");
 }
@@ -115,8 +126,157 @@ void PluginManager::loadPluginFactories()
 #endif
     pluginDir.cd("Plugins");
     
+    _pluginDir = pluginDir;
+
     _pluginFactories.clear();
+    _menuNames.clear();
+    _deferredPluginFactories.clear();
+
+    _loadDurations = LoadDurations();
+
+    auto& startupTask = Application::current()->getStartupTask();
+
+    Timer timer;
+
+    _metadataCache.load();
+
+    // List of filenames of dependency resolved plugins
+    const QStringList resolvedPlugins = resolveDependencies(pluginDir);
+
+    startupTask.addTiming(QString("Plugins: read metadata and resolve dependencies (%1 cached, %2 probed)").arg(QString::number(_metadataCache.getNumberOfHits()), QString::number(_metadataCache.getNumberOfMisses())), timer.getElapsedTimeMilliseconds());
+
+    // For each of the plugin files which are resolved, load them (or defer loading them until first use)
+    for (const auto& fileName: resolvedPlugins)
+    {
+        const auto pluginFilePath = pluginDir.absoluteFilePath(fileName);
+
+        // Get metadata about plugin from the accompanying .json file compiled in the shared library (served from the metadata cache when possible)
+        const auto metaData = _metadataCache.getMetaData(pluginFilePath);
+
+        // Factory traits are only known when the (unchanged) library was loaded before, plugins with a status bar action are needed by the main window
+        const auto factoryTraits = _metadataCache.getFactoryTraits(pluginFilePath);
+
+        if (factoryTraits.isValid() && !factoryTraits._hasStatusBarAction) {
+            _deferredPluginFactories[metaData.value("name").toString()] = { fileName, metaData, factoryTraits };
+            continue;
+        }
+
+        loadPluginFactory(fileName, metaData);
+    }
+
+    _metadataCache.save();
+
+    startupTask.addTiming("Plugins: load dependency libraries", _loadDurations._dependencies);
+    startupTask.addTiming(QString("Plugins: load %1 plugin libraries (%2 deferred until first use)").arg(QString::number(_pluginFactories.count()), QString::number(_deferredPluginFactories.count())), _loadDurations._libraries);
+    startupTask.addTiming("Plugins: initialize plugin factories", _loadDurations._initialize);
+
+    emit pluginFactoriesLoaded();
+}
+
+PluginFactory* PluginManager::loadPluginFactory(const QString& fileName, const QJsonObject& metaData)
+{
+    const auto pluginKind   = metaData.value("name").toString();
+    const auto version      = metaData.value("version").toString();
+
+#ifdef PLUGIN_MANAGER_VERBOSE
+    qDebug() << "Loading plugin factory" << pluginKind << "from" << fileName;
+#endif
+
+    const auto pluginFilePath = _pluginDir.absoluteFilePath(fileName);
+
+    Timer timer;
+
+    // Load plugin dependencies, if there are any
+    loadPluginDependencies(fileName);
+
+    _loadDurations._dependencies += timer.getElapsedTimeMilliseconds();
+
+    // Dynamic loader of plugin shared library
+    QPluginLoader pluginLoader(pluginFilePath);
+
+    timer.reset();
+
+    // Create an instance of the plugin, i.e. the factory
+    auto pluginFactory = dynamic_cast<PluginFactory*>(pluginLoader.instance());
+
+    _loadDurations._libraries += timer.getElapsedTimeMilliseconds();
+
+    // If pluginFactory is a nullptr then loading of the plugin failed for some reason. Print the reason to output.
+    if (!pluginFactory)
+    {
+        qWarning() << "Failed to load plugin: " << fileName << pluginLoader.errorString();
+
+        // Forget the factory traits, so that the plugin is loaded (and the failure is reported) at startup next time
+        _metadataCache.setFactoryTraits(pluginFilePath, {});
+
+        return nullptr;
+    }
 
+    timer.reset();
+
+    // Loading of the plugin succeeded so cast it to its original class
+    _pluginFactories[pluginKind] = pluginFactory;
+	_pluginFactories[pluginKind]->setKind(pluginKind);
+    _pluginFactories[pluginKind]->getPluginMetadata().getVersion().setContext(QString("%1 plugin").arg(pluginKind).toStdString());
+    _pluginFactories[pluginKind]->getPluginMetadata().getVersion().initialize(version);
+    _pluginFactories[pluginKind]->initialize();
+
+    _menuNames[pluginKind] = metaData.value("menuName").toString();
+
+    _loadDurations._initialize += timer.getElapsedTimeMilliseconds();
+
+    if (qobject_cast<AnalysisPluginFactory*>(pluginFactory))
+    {
+    }
+    else if (qobject_cast<RawDataFactory*>(pluginFactory))
+    {
+    }
+    else if (qobject_cast<LoaderPluginFactory*>(pluginFactory))
+    {
+    }
+    else if (qobject_cast<WriterPluginFactory*>(pluginFactory))
+    {
+    }
+    else if (qobject_cast<ViewPluginFactory*>(pluginFactory))
+    {
+    }
+    else if (qobject_cast<TransformationPluginFactory*>(pluginFactory))
+    {
+    }
+    else
+    {
+        qDebug() << "Plugin " << fileName << " does not implement any of the possible interfaces!";
+    }
+
+    // Record the factory traits, so that the plugin can be registered (and listed) without loading its library on the next startup
+    PluginMetadataCache::FactoryTraits factoryTraits;
+
+    factoryTraits._type                                 = static_cast<std::int32_t>(pluginFactory->getType());
+    factoryTraits._hasStatusBarAction                   = pluginFactory->getStatusBarAction() != nullptr;
+    factoryTraits._guiName                              = pluginFactory->getGuiName();
+    factoryTraits._repositoryUrl                        = pluginFactory->getRepositoryUrl().toString();
+    factoryTraits._readmeMarkdownUrl                    = pluginFactory->getReadmeMarkdownUrl().toString();
+    factoryTraits._allowPluginCreationFromStandardGui   = pluginFactory->getAllowPluginCreationFromStandardGui();
+
+    if (const auto viewPluginFactory = qobject_cast<ViewPluginFactory*>(pluginFactory)) {
+        factoryTraits._producesSystemViewPlugins    = viewPluginFactory->producesSystemViewPlugins();
+        factoryTraits._preferredDockArea            = static_cast<std::int32_t>(viewPluginFactory->getPreferredDockArea());
+    }
+
+    QBuffer iconBuffer(&factoryTraits._icon);
+
+    if (iconBuffer.open(QIODevice::WriteOnly))
+        pluginFactory->getIcon().pixmap(cachedIconSize).save(&iconBuffer, "PNG");
+
+    _metadataCache.setFactoryTraits(pluginFilePath, factoryTraits);
+
+    emit pluginFactoryLoaded(pluginFactory);
+
+    return pluginFactory;
+}
+
+void PluginManager::loadPluginDependencies(const QString& fileName) const
+{
     auto getPluginDependencyDir = [](const QDir& dir, const QString& name) -> std::pair<QDir, bool> {
         QDir dependenciesDir = dir;
         dependenciesDir.cdUp();
@@ -141,121 +301,98 @@ void PluginManager::loadPluginFactories()
         return baseName;
         };
 
-    auto loadPluginDependencies = [&getLibraryName, &getPluginDependencyDir](const QDir& pluginDir, const QString& fileName) -> void {
-
-        const auto pluginName = getLibraryName(fileName);
-        const auto [pluginDependenciesDir, pluginDependenciesExists] = getPluginDependencyDir(pluginDir, pluginName);
+    const auto pluginName = getLibraryName(fileName);
+    const auto [pluginDependenciesDir, pluginDependenciesExists] = getPluginDependencyDir(_pluginDir, pluginName);
 
-        if (!pluginDependenciesExists)
-            return;
+    if (!pluginDependenciesExists)
+        return;
 
-        QSet<QString> dynamicLibsToLoad;
-        for (const QFileInfo& fileInfo : pluginDependenciesDir.entryInfoList({}, QDir::Files))
-        {
-            const auto filePath = fileInfo.absoluteFilePath();
-            if (!QLibrary::isLibrary(filePath))
-                continue;
+    QSet<QString> dynamicLibsToLoad;
+    for (const QFileInfo& fileInfo : pluginDependenciesDir.entryInfoList({}, QDir::Files))
+    {
+        const auto filePath = fileInfo.absoluteFilePath();
+        if (!QLibrary::isLibrary(filePath))
+            continue;
 
-            dynamicLibsToLoad.insert(filePath);
-        }
+        dynamicLibsToLoad.insert(filePath);
+    }
 
-        // Some dependencies might depend on other dynamic libraries
-        // We could build a dependency tree, but this works just as well
-        const size_t maxTries = dynamicLibsToLoad.size();
-        size_t currentTry = 0;
-        while (!dynamicLibsToLoad.isEmpty()) {
-            for (const QString& dynamicLibPath : dynamicLibsToLoad) {
-                QLibrary lib(dynamicLibPath);
-                if (lib.load()) {
-                    qDebug() << "Loaded dependency: " << dynamicLibPath;
-                    dynamicLibsToLoad.remove(dynamicLibPath);
-                }
+    // Some dependencies might depend on other dynamic libraries
+    // We could build a dependency tree, but this works just as well
+    const size_t maxTries = dynamicLibsToLoad.size();
+    size_t currentTry = 0;
+    while (!dynamicLibsToLoad.isEmpty()) {
+        for (const QString& dynamicLibPath : dynamicLibsToLoad) {
+            QLibrary lib(dynamicLibPath);
+            if (lib.load()) {
+                qDebug() << "Loaded dependency: " << dynamicLibPath;
+                dynamicLibsToLoad.remove(dynamicLibPath);
             }
+        }
 
-            if (dynamicLibsToLoad.isEmpty())
-                break;
+        if (dynamicLibsToLoad.isEmpty())
+            break;
 
-            if (++currentTry >= maxTries)
-            {
-                qWarning() << "Could not load all dependencies for " << pluginName << ". Missing: " << dynamicLibsToLoad;
-                break;
-            }
+        if (++currentTry >= maxTries)
+        {
+            qWarning() << "Could not load all dependencies for " << pluginName << ". Missing: " << dynamicLibsToLoad;
+            break;
         }
-        };
+    }
+}
 
-    // List of filenames of dependency resolved plugins
-    const QStringList resolvedPlugins = resolveDependencies(pluginDir);
+PluginFactory* PluginManager::loadDeferredPluginFactory(const QString& pluginKind)
+{
+    if (!_deferredPluginFactories.contains(pluginKind))
+        return _pluginFactories.value(pluginKind, nullptr);
 
-    // For each of the plugin files which are resolved, load them and add them in their proper menu category
-    for (const auto& fileName: resolvedPlugins)
-    {
-        // Load plugin dependencies, if there are any
-        loadPluginDependencies(pluginDir, fileName);
+    // Take the plugin out of the deferred plugins first, so that it is not loaded twice when its factory requests plugin factories while initializing
+    const auto deferredPluginFactory = _deferredPluginFactories.take(pluginKind);
 
-        // Dynamic loader of plugin shared library
-        QPluginLoader pluginLoader(pluginDir.absoluteFilePath(fileName));
-        
-        // Get metadata about plugin from the accompanying .json file compiled in the shared library
-        QString pluginKind      = pluginLoader.metaData().value("MetaData").toObject().value("name").toString();
-        QString menuName        = pluginLoader.metaData().value("MetaData").toObject().value("menuName").toString();
-        QString version         = pluginLoader.metaData().value("MetaData").toObject().value("version").toString();
+#ifdef PLUGIN_MANAGER_VERBOSE
+    qDebug() << "Loading deferred plugin" << pluginKind;
+#endif
 
-        // Create an instance of the plugin, i.e. the factory
-        auto pluginFactory = dynamic_cast<PluginFactory*>(pluginLoader.instance());
+    // Respect the dependency order in which the plugins would have been loaded at startup
+    for (const auto& dependency : deferredPluginFactory._metaData.value("dependencies").toArray())
+        loadDeferredPluginFactory(dependency.toString());
 
-        // If pluginFactory is a nullptr then loading of the plugin failed for some reason. Print the reason to output.
-        if (!pluginFactory)
-        {
-            qWarning() << "Failed to load plugin: " << fileName << pluginLoader.errorString();
-            continue;
-        }
+    auto pluginFactory = loadPluginFactory(deferredPluginFactory._fileName, deferredPluginFactory._metaData);
 
-        // Loading of the plugin succeeded so cast it to its original class
-        _pluginFactories[pluginKind] = pluginFactory;
-    	_pluginFactories[pluginKind]->setKind(pluginKind);
-        _pluginFactories[pluginKind]->getPluginMetadata().getVersion().setContext(QString("%1 plugin").arg(pluginKind).toStdString());
-        _pluginFactories[pluginKind]->getPluginMetadata().getVersion().initialize(version);
-        _pluginFactories[pluginKind]->initialize();
+    // Persist updated factory traits (e.g. when the library failed to load)
+    _metadataCache.save();
 
-        if (qobject_cast<AnalysisPluginFactory*>(pluginFactory))
-        {
-        }
-        else if (qobject_cast<RawDataFactory*>(pluginFactory))
-        {
-        }
-        else if (qobject_cast<LoaderPluginFactory*>(pluginFactory))
-        {
-        }
-        else if (qobject_cast<WriterPluginFactory*>(pluginFactory))
-        {
-        }
-        else if (qobject_cast<ViewPluginFactory*>(pluginFactory))
-        {
-        }
-        else if (qobject_cast<TransformationPluginFactory*>(pluginFactory))
-        {
-        }
-        else
-        {
-            qDebug() << "Plugin " << fileName << " does not implement any of the possible interfaces!";
-            return;
-        }
-    }
+    return pluginFactory;
+}
 
-    emit pluginFactoriesLoaded();
+void PluginManager::loadDeferredPluginFactories(const plugin::Types& pluginTypes /*= plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }*/)
+{
+    QStringList pluginKinds;
+
+    for (auto it = _deferredPluginFactories.constBegin(); it != _deferredPluginFactories.constEnd(); ++it)
+        if (pluginTypes.contains(static_cast<plugin::Type>(it.value()._factoryTraits._type)))
+            pluginKinds << it.key();
+
+    // Load in kind order, so that the loading order does not depend on the hash table order
+    pluginKinds.sort();
+
+    for (const auto& pluginKind : pluginKinds)
+        loadDeferredPluginFactory(pluginKind);
 }
 
 bool PluginManager::isPluginLoaded(const QString& kind) const
 {
-    return _pluginFactories.keys().contains(kind);
+    return _pluginFactories.contains(kind);
 }
 
-mv::plugin::PluginFactory* PluginManager::getPluginFactory(const QString& pluginKind) const
+bool PluginManager::isPluginDeferred(const QString& kind) const
 {
-    if (!isPluginLoaded(pluginKind))
-        return nullptr;
+    return _deferredPluginFactories.contains(kind);
+}
 
-    return _pluginFactories[pluginKind];
+mv::plugin::PluginFactory* PluginManager::getPluginFactory(const QString& pluginKind) const
+{
+    return _pluginFactories.value(pluginKind, nullptr);
 }
 
 QStringList PluginManager::resolveDependencies(QDir pluginDir) const
@@ -276,14 +413,26 @@ QStringList PluginManager::resolveDependencies(QDir pluginDir) const
      * immediately add it to the list of resolved plugins. Dependencies are given by a list of plugin kinds
      * under the 'dependencies' key in the accompanying .json metadata file.
      */
-    for (QString fileName: pluginDir.entryList(QDir::Files))
-    {
-        QPluginLoader pluginLoader(pluginDir.absoluteFilePath(fileName));
+    const auto fileNames = pluginDir.entryList(QDir::Files);
+
+    QStringList pluginFilePaths;
 
-        QJsonObject metaData = pluginLoader.metaData().value("MetaData").toObject();
+    for (const auto& fileName : fileNames)
+        pluginFilePaths << pluginDir.absoluteFilePath(fileName);
+
+    // Forget about plugins which are no longer installed
+    _metadataCache.prune(pluginFilePaths);
+
+    for (QString fileName: fileNames)
+    {
+        QJsonObject metaData = _metadataCache.getMetaData(pluginDir.absoluteFilePath(fileName));
         QString kind = metaData.value("name").toString();
         QJsonArray dependencyData = metaData.value("dependencies").toArray();
 
+        // Files without plugin metadata are not plugins, do not attempt to load them
+        if (kind.isEmpty())
+            continue;
+
         // Map plugin kind to plugin file name
         kindToPluginNameMap[kind] = fileName;
 
@@ -363,10 +512,12 @@ plugin::Plugin* PluginManager::requestPlugin(const QString& kind, Datasets input
 {
     try
     {
-        if (!_pluginFactories.keys().contains(kind))
+        // Loads the plugin shared library when it was deferred
+        auto pluginFactory = loadDeferredPluginFactory(kind);
+
+        if (!pluginFactory)
             throw std::runtime_error("Unrecognized plugin kind");
 
-        auto pluginFactory  = _pluginFactories[kind];
         auto pluginInstance = pluginFactory->produce();
 
         if (pluginInstance == nullptr)
@@ -622,6 +773,90 @@ std::vector<PluginFactory*> PluginManager::getPluginFactoriesByTypes(const plugi
     return pluginFactories;
 }
 
+std::vector<PluginFactory*> PluginManager::getLoadedPluginFactories() const
+{
+    std::vector<PluginFactory*> pluginFactories(_pluginFactories.begin(), _pluginFactories.end());
+
+    std::sort(pluginFactories.begin(), pluginFactories.end(), [](auto pluginFactoryLhs, auto pluginFactoryRhs) -> bool {
+        if (pluginFactoryLhs->getType() != pluginFactoryRhs->getType())
+            return pluginFactoryLhs->getType() < pluginFactoryRhs->getType();
+
+        return pluginFactoryLhs->getKind() < pluginFactoryRhs->getKind();
+    });
+
+    return pluginFactories;
+}
+
+PluginManager::PluginFactoryInfos PluginManager::getPluginFactoryInfos(const plugin::Types& pluginTypes /*= plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }*/) const
+{
+    PluginFactoryInfos pluginFactoryInfos;
+
+    for (auto pluginFactory : _pluginFactories)
+        if (pluginTypes.contains(pluginFactory->getType()))
+            pluginFactoryInfos.push_back(getPluginFactoryInfo(pluginFactory));
+
+    for (auto it = _deferredPluginFactories.constBegin(); it != _deferredPluginFactories.constEnd(); ++it)
+        if (pluginTypes.contains(static_cast<plugin::Type>(it.value()._factoryTraits._type)))
+            pluginFactoryInfos.push_back(getPluginFactoryInfo(it.key(), it.value()));
+
+    std::sort(pluginFactoryInfos.begin(), pluginFactoryInfos.end(), [](const auto& pluginFactoryInfoLhs, const auto& pluginFactoryInfoRhs) -> bool {
+        if (pluginFactoryInfoLhs._type != pluginFactoryInfoRhs._type)
+            return pluginFactoryInfoLhs._type < pluginFactoryInfoRhs._type;
+
+        return pluginFactoryInfoLhs._kind < pluginFactoryInfoRhs._kind;
+    });
+
+    return pluginFactoryInfos;
+}
+
+PluginManager::PluginFactoryInfo PluginManager::getPluginFactoryInfo(const plugin::PluginFactory* pluginFactory) const
+{
+    const auto viewPluginFactory = dynamic_cast<const ViewPluginFactory*>(pluginFactory);
+
+    PluginFactoryInfo pluginFactoryInfo;
+
+    pluginFactoryInfo._kind                                 = pluginFactory->getKind();
+    pluginFactoryInfo._type                                 = pluginFactory->getType();
+    pluginFactoryInfo._version                              = QString::fromStdString(pluginFactory->getVersion().getVersionString());
+    pluginFactoryInfo._guiName                              = pluginFactory->getGuiName();
+    pluginFactoryInfo._menuName                             = _menuNames.value(pluginFactory->getKind());
+    pluginFactoryInfo._icon                                 = pluginFactory->getIcon();
+    pluginFactoryInfo._repositoryUrl                        = pluginFactory->getRepositoryUrl();
+    pluginFactoryInfo._readmeMarkdownUrl                    = pluginFactory->getReadmeMarkdownUrl();
+    pluginFactoryInfo._allowPluginCreationFromStandardGui   = pluginFactory->getAllowPluginCreationFromStandardGui();
+    pluginFactoryInfo._producesSystemViewPlugins            = viewPluginFactory ? viewPluginFactory->producesSystemViewPlugins() : false;
+    pluginFactoryInfo._preferredDockArea                    = viewPluginFactory ? viewPluginFactory->getPreferredDockArea() : DockAreaFlag::None;
+    pluginFactoryInfo._isLoaded                             = true;
+
+    return pluginFactoryInfo;
+}
+
+PluginManager::PluginFactoryInfo PluginManager::getPluginFactoryInfo(const QString& pluginKind, const DeferredPluginFactory& deferredPluginFactory)
+{
+    const auto& factoryTraits = deferredPluginFactory._factoryTraits;
+
+    QPixmap iconPixmap;
+
+    iconPixmap.loadFromData(factoryTraits._icon, "PNG");
+
+    PluginFactoryInfo pluginFactoryInfo;
+
+    pluginFactoryInfo._kind                                 = pluginKind;
+    pluginFactoryInfo._type                                 = static_cast<plugin::Type>(factoryTraits._type);
+    pluginFactoryInfo._version                              = deferredPluginFactory._metaData.value("version").toString();
+    pluginFactoryInfo._guiName                              = factoryTraits._guiName;
+    pluginFactoryInfo._menuName                             = deferredPluginFactory._metaData.value("menuName").toString();
+    pluginFactoryInfo._icon                                 = iconPixmap.isNull() ? QIcon() : QIcon(iconPixmap);
+    pluginFactoryInfo._repositoryUrl                        = QUrl(factoryTraits._repositoryUrl);
+    pluginFactoryInfo._readmeMarkdownUrl                    = QUrl(factoryTraits._readmeMarkdownUrl);
+    pluginFactoryInfo._allowPluginCreationFromStandardGui   = factoryTraits._allowPluginCreationFromStandardGui;
+    pluginFactoryInfo._producesSystemViewPlugins            = factoryTraits._producesSystemViewPlugins;
+    pluginFactoryInfo._preferredDockArea                    = static_cast<DockAreaFlag>(factoryTraits._preferredDockArea);
+    pluginFactoryInfo._isLoaded                             = false;
+
+    return pluginFactoryInfo;
+}
+
 std::vector<plugin::Plugin*> PluginManager::getPluginsByFactory(const plugin::PluginFactory* pluginFactory) const
 {
     std::vector<plugin::Plugin*> pluginsByFactory;
@@ -673,11 +908,17 @@ QStringList PluginManager::getPluginKindsByPluginTypes(const plugin::Types& plug
 {
     QStringList pluginKinds;
 
-    for (const auto& pluginType : pluginTypes)
+    for (const auto& pluginType : pluginTypes) {
         for (auto pluginFactory : _pluginFactories)
             if (pluginFactory->getType() == pluginType)
                 pluginKinds << pluginFactory->getKind();
 
+        // The plugin type of deferred plugins is known without loading them
+        for (auto it = _deferredPluginFactories.constBegin(); it != _deferredPluginFactories.constEnd(); ++it)
+            if (static_cast<plugin::Type>(it.value()._factoryTraits._type) == pluginType)
+                pluginKinds << it.key();
+    }
+
     return pluginKinds;
 }
 
@@ -758,18 +999,24 @@ PluginTriggerActions PluginManager::getPluginTriggerActions(const QString& plugi
 
 QString PluginManager::getPluginGuiName(const QString& pluginKind) const
 {
-    if (!_pluginFactories.contains(pluginKind))
-        return "";
+    if (const auto pluginFactory = getPluginFactory(pluginKind))
+        return pluginFactory->getGuiName();
+
+    if (isPluginDeferred(pluginKind))
+        return _deferredPluginFactories[pluginKind]._factoryTraits._guiName;
 
-    return _pluginFactories[pluginKind]->getGuiName();
+    return "";
 }
 
 QIcon PluginManager::getPluginIcon(const QString& pluginKind) const
 {
-    if (!_pluginFactories.contains(pluginKind))
-        return {};
+    if (const auto pluginFactory = getPluginFactory(pluginKind))
+        return pluginFactory->getIcon();
 
-    return _pluginFactories[pluginKind]->getIcon();
+    if (isPluginDeferred(pluginKind))
+        return getPluginFactoryInfo(pluginKind, _deferredPluginFactories[pluginKind])._icon;
+
+    return {};
 }
 
 void PluginManager::fromVariantMap(const QVariantMap& variantMap)
@@ -781,7 +1028,7 @@ void PluginManager::fromVariantMap(const QVariantMap& variantMap)
     QStringList missingPluginKinds;
 
     for (const auto& usedPlugin : variantMap["UsedPlugins"].toList())
-        if (!_pluginFactories.contains(usedPlugin.toString()))
+        if (!isPluginLoaded(usedPlugin.toString()) && !isPluginDeferred(usedPlugin.toString()))
             missingPluginKinds << usedPlugin.toString();
 
     if (variantMap.contains("LoadedAnalyses"))
@@ -804,7 +1051,7 @@ void PluginManager::fromVariantMap(const QVariantMap& variantMap)
 
             auto analysisPluginKind = analysisPluginMap["Kind"].toString();
 
-            if (_pluginFactories.contains(analysisPluginKind))
+            if (isPluginLoaded(analysisPluginKind) || isPluginDeferred(analysisPluginKind))
             {
                 auto inputDatasetsGUIDs = analysisPluginMap["InputDatasetsIDs"].toStringList();
                 auto outputDatasetsGUIDs = analysisPluginMap["OutputDatasetsIDs"].toStringList();
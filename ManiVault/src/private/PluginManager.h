@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "PluginMetadataCache.h"
+
 #include <models/PluginsTreeModel.h>
 
 #include <AbstractPluginManager.h>
@@ -13,6 +15,19 @@ namespace mv {
 
 using namespace plugin;
 
+/**
+ * Plugin manager class
+ *
+ * Loads the plugin factories from the plugin directory and manages the plugin instances. Plugin shared libraries of
+ * which the factory traits are known from a previous startup (see PluginMetadataCache) are not loaded at startup,
+ * they are registered from the plugin metadata cache instead. Deferred plugins are listed from their cached traits
+ * (see getPluginFactoryInfos()) and their shared library is only loaded when a plugin of their kind is requested or
+ * when a caller explicitly needs the factory (see loadDeferredPluginFactory() and loadDeferredPluginFactories()).
+ * Const getters never load plugin shared libraries. Plugins which provide a status bar action are always loaded at
+ * startup.
+ *
+ * @author Thomas Kroes
+ */
 class PluginManager final : public AbstractPluginManager
 {
 public:
@@ -32,20 +47,40 @@ public:
     /** Resets the contents of the plugin manager */
     void reset() override;
 
-    /** Loads all plugin factories from the plugin directory */
+    /** Loads all plugin factories from the plugin directory (or registers them for loading on first use) */
     void loadPluginFactories() override;
 
     /**
-     * Determine whether a plugin of \p kind is loaded
+     * Determine whether the shared library of the plugin of \p kind is loaded
      * @param kind Plugin kind
      * @return Boolean determining whether a plugin of \p kind is loaded
      */
     bool isPluginLoaded(const QString& kind) const override;
 
+    /**
+     * Determine whether the plugin of \p kind is registered, but its shared library is only loaded on first use (it might still fail to load)
+     * @param kind Plugin kind
+     * @return Boolean determining whether the plugin of \p kind is deferred
+     */
+    bool isPluginDeferred(const QString& kind) const override;
+
+    /**
+     * Load the deferred shared library of the plugin of \p pluginKind (no-op if the plugin is not deferred)
+     * @param pluginKind Kind of plugin
+     * @return Plugin factory of \p pluginKind, nullptr if not found or if loading failed
+     */
+    plugin::PluginFactory* loadDeferredPluginFactory(const QString& pluginKind) override;
+
+    /**
+     * Load the deferred shared libraries of the plugins of \p pluginTypes
+     * @param pluginTypes Plugin types
+     */
+    void loadDeferredPluginFactories(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) override;
+
 public: // Plugin creation/destruction
 
     /**
-     * Create a plugin of \p kind with input \p datasets
+     * Create a plugin of \p kind with input \p datasets (loads the plugin shared library if it was deferred)
      * @param kind Kind of plugin (name of the plugin)
      * @param datasets Zero or more datasets upon which the plugin is based (e.g. analysis plugin)
      * @return Pointer to created plugin, nullptr if creation failed
@@ -95,26 +130,39 @@ public: // Destroy
 public: // Plugin factory
 
     /**
-     * Get plugin factory from \p pluginKind
+     * Get plugin factory from \p pluginKind (deferred plugins are not loaded, see loadDeferredPluginFactory())
      * @param pluginKind Kind of plugin
-     * @return Plugin factory of \p pluginKind, nullptr if not found
+     * @return Plugin factory of \p pluginKind, nullptr if not found or not loaded
      */
     plugin::PluginFactory* getPluginFactory(const QString& pluginKind) const override;
 
     /**
-     * Get plugin factories for \p pluginType
+     * Get the loaded plugin factories for \p pluginType (deferred plugins are not loaded, see loadDeferredPluginFactories())
      * @param pluginType Plugin type
      * @return Vector of pointers to plugin factories
      */
     std::vector<plugin::PluginFactory*> getPluginFactoriesByType(const plugin::Type& pluginType) const override;
 
     /**
-     * Get plugin factories for \p pluginTypes (by default it gets all plugins factories for all types)
+     * Get the loaded plugin factories for \p pluginTypes (by default it gets all plugins factories for all types, deferred plugins are not loaded)
      * @param pluginTypes Plugin types
      * @return Vector of pointers to plugin factories of \p pluginTypes
      */
     std::vector<plugin::PluginFactory*> getPluginFactoriesByTypes(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const override;
 
+    /**
+     * Get the plugin factories of which the shared library is loaded
+     * @return Vector of pointers to loaded plugin factories, ordered by type and kind
+     */
+    std::vector<plugin::PluginFactory*> getLoadedPluginFactories() const override;
+
+    /**
+     * Get the properties of the loaded and deferred plugin factories for \p pluginTypes (without loading deferred plugins)
+     * @param pluginTypes Plugin types
+     * @return Plugin factory properties, ordered by type and kind
+     */
+    PluginFactoryInfos getPluginFactoryInfos(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const override;
+
     /**
      * Get plugin instances for \p pluginFactory
      * @param pluginFactory Pointer to plugin factory
@@ -139,13 +187,13 @@ public: // Plugin getters
     std::vector<plugin::Plugin*> getPluginsByTypes(const plugin::Types& pluginTypes = plugin::Types{ plugin::Type::ANALYSIS, plugin::Type::DATA, plugin::Type::LOADER, plugin::Type::WRITER, plugin::Type::TRANSFORMATION, plugin::Type::VIEW }) const override;
 
     /**
-     * Get plugin kinds by plugin type(s)
+     * Get plugin kinds by plugin type(s), including the kinds of deferred plugins
      * @param pluginTypes Plugin type(s)
      * @return Plugin kinds
      */
     QStringList getPluginKindsByPluginTypes(const plugin::Types& pluginTypes) const;
 
-public: // Plugin trigger actions
+public: // Plugin trigger actions (of loaded plugins only, see loadDeferredPluginFactories())
 
     /**
      * Get plugin trigger actions by \p pluginType
@@ -189,14 +237,14 @@ public: // Plugin trigger actions
 public: // Plugin query
 
     /**
-     * Get plugin GUI name from plugin kind
+     * Get plugin GUI name from plugin kind (deferred plugins are not loaded)
      * @param pluginKind Kind of plugin
      * @param GUI name of the plugin, empty if the plugin kind was not found
      */
     QString getPluginGuiName(const QString& pluginKind) const;
 
     /**
-     * Get plugin icon from plugin kind
+     * Get plugin icon from plugin kind (deferred plugins are not loaded)
      * @param pluginKind Kind of plugin
      * @return Plugin icon name of the plugin, null icon the plugin kind was not found
      */
@@ -239,11 +287,63 @@ protected:
      */
     QStringList resolveDependencies(QDir pluginDir) const override;
 
+private: // Deferred loading
+
+    /** Plugin of which the shared library is loaded on first use */
+    struct DeferredPluginFactory
+    {
+        QString                             _fileName;          /** File name of the plugin shared library */
+        QJsonObject                         _metaData;          /** Plugin metadata */
+        PluginMetadataCache::FactoryTraits  _factoryTraits;     /** Factory traits from the plugin metadata cache */
+    };
+
+    /** Time spent on loading plugin shared libraries (in milliseconds) */
+    struct LoadDurations
+    {
+        float   _dependencies   = 0.f;  /** Loading the plugin dependency libraries */
+        float   _libraries      = 0.f;  /** Loading the plugin shared libraries */
+        float   _initialize     = 0.f;  /** Initializing the plugin factories */
+    };
+
+    /**
+     * Load the plugin shared library with \p fileName (and its dependencies) and register its factory under the kind in \p metaData
+     * @param fileName File name of the plugin shared library (in the plugin directory)
+     * @param metaData Plugin metadata
+     * @return Pointer to the plugin factory, nullptr when loading failed
+     */
+    PluginFactory* loadPluginFactory(const QString& fileName, const QJsonObject& metaData);
+
+    /**
+     * Get the properties of \p pluginFactory
+     * @param pluginFactory Pointer to loaded plugin factory
+     * @return Plugin factory properties
+     */
+    PluginFactoryInfo getPluginFactoryInfo(const plugin::PluginFactory* pluginFactory) const;
+
+    /**
+     * Get the properties of \p deferredPluginFactory with \p pluginKind
+     * @param pluginKind Kind of plugin
+     * @param deferredPluginFactory Deferred plugin factory
+     * @return Plugin factory properties
+     */
+    static PluginFactoryInfo getPluginFactoryInfo(const QString& pluginKind, const DeferredPluginFactory& deferredPluginFactory);
+
+    /**
+     * Load the dependency libraries of the plugin shared library with \p fileName (from the plugin dependencies directory)
+     * @param fileName File name of the plugin shared library (in the plugin directory)
+     */
+    void loadPluginDependencies(const QString& fileName) const;
+
 private:
-    QHash<QString, PluginFactory*>                  _pluginFactories;   /** All loaded plugin factories */
-    std::vector<std::unique_ptr<plugin::Plugin>>    _plugins;           /** Vector of plugin instances */
-    PluginsListModel*                               _listModel;         /** List model of all loaded plugins */
-    PluginsTreeModel*                               _treeModel;         /** Tree model of all loaded plugins */
+    QDir                                            _pluginDir;                 /** Directory from which the plugins are loaded */
+    QHash<QString, PluginFactory*>                  _pluginFactories;           /** All loaded plugin factories */
+    QHash<QString, QString>                         _menuNames;                 /** Menu names from the plugin metadata (by kind) */
+    QHash<QString, DeferredPluginFactory>           _deferredPluginFactories;   /** Plugins of which the shared library is loaded on first use (by kind) */
+    std::vector<std::unique_ptr<plugin::Plugin>>    _plugins;                   /** Vector of plugin instances */
+    PluginsListModel*                               _listModel;                 /** List model of all loaded plugins */
+    PluginsTreeModel*                               _treeModel;                 /** Tree model of all loaded plugins */
+    mutable PluginMetadataCache                     _metadataCache;             /** Persisted plugin metadata so that libraries need not be probed on every startup */
+    LoadDurations                                   _loadDurations;             /** Time spent on loading plugin shared libraries */
 };
 
 }
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "PluginMetadataCache.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QPluginLoader>
+#include <QSet>
+#include <QSaveFile>
+
+#ifdef _DEBUG
+    //#define PLUGIN_METADATA_CACHE_VERBOSE
+#endif
+
+namespace mv {
+
+/** Bump when the layout of the cache file changes, older caches are discarded */
+constexpr auto pluginMetadataCacheFormatVersion = 3;
+
+PluginMetadataCache::PluginMetadataCache(const QString& cacheFilePath /*= ""*/) :
+    _cacheFilePath(cacheFilePath),
+    _entries(),
+    _dirty(false),
+    _numberOfHits(0),
+    _numberOfMisses(0)
+{
+}
+
+QString PluginMetadataCache::getCacheFilePath() const
+{
+    return _cacheFilePath;
+}
+
+void PluginMetadataCache::setCacheFilePath(const QString& cacheFilePath)
+{
+    _cacheFilePath = cacheFilePath;
+}
+
+void PluginMetadataCache::load()
+{
+    _entries.clear();
+
+    _dirty          = false;
+    _numberOfHits   = 0;
+    _numberOfMisses = 0;
+
+    if (_cacheFilePath.isEmpty())
+        return;
+
+    QFile cacheFile(_cacheFilePath);
+
+    if (!cacheFile.exists())
+        return;
+
+    if (!cacheFile.open(QIODevice::ReadOnly)) {
+        qWarning() << "Unable to open plugin metadata cache" << _cacheFilePath;
+        return;
+    }
+
+    QJsonParseError parseError;
+
+    const auto cacheDocument = QJsonDocument::fromJson(cacheFile.readAll(), &parseError);
+
+    if (parseError.error != QJsonParseError::NoError || !cacheDocument.isObject()) {
+        qWarning() << "Discarding malformed plugin metadata cache" << _cacheFilePath << parseError.errorString();
+        _dirty = true;
+        return;
+    }
+
+    const auto cacheObject = cacheDocument.object();
+
+    if (cacheObject.value("Version").toInt() != pluginMetadataCacheFormatVersion) {
+        _dirty = true;
+        return;
+    }
+
+    for (const auto& entryValue : cacheObject.value("Entries").toArray()) {
+        const auto entryObject = entryValue.toObject();
+
+        Entry entry;
+
+        entry._lastModified = entryObject.value("LastModified").toInteger();
+        entry._size         = entryObject.value("Size").toInteger();
+        entry._metaData     = entryObject.value("MetaData").toObject();
+
+        const auto factoryTraitsObject = entryObject.value("FactoryTraits").toObject();
+
+        auto& factoryTraits = entry._factoryTraits;
+
+        factoryTraits._type                                 = factoryTraitsObject.value("Type").toInt(-1);
+        factoryTraits._hasStatusBarAction                   = factoryTraitsObject.value("StatusBarAction").toBool();
+        factoryTraits._guiName                              = factoryTraitsObject.value("GuiName").toString();
+        factoryTraits._icon                                 = QByteArray::fromBase64(factoryTraitsObject.value("Icon").toString().toLatin1());
+        factoryTraits._repositoryUrl                        = factoryTraitsObject.value("RepositoryUrl").toString();
+        factoryTraits._readmeMarkdownUrl                    = factoryTraitsObject.value("ReadmeMarkdownUrl").toString();
+        factoryTraits._allowPluginCreationFromStandardGui   = factoryTraitsObject.value("AllowPluginCreationFromStandardGui").toBool(true);
+        factoryTraits._producesSystemViewPlugins            = factoryTraitsObject.value("ProducesSystemViewPlugins").toBool();
+        factoryTraits._preferredDockArea                    = factoryTraitsObject.value("PreferredDockArea").toInt();
+
+        _entries[entryObject.value("FilePath").toString()] = entry;
+    }
+
+#ifdef PLUGIN_METADATA_CACHE_VERBOSE
+    qDebug() << "Loaded" << _entries.count() << "plugin metadata cache entries from" << _cacheFilePath;
+#endif
+}
+
+void PluginMetadataCache::save()
+{
+    if (_cacheFilePath.isEmpty() || !_dirty)
+        return;
+
+    QDir().mkpath(QFileInfo(_cacheFilePath).absolutePath());
+
+    QJsonArray entriesArray;
+
+    for (auto it = _entries.constBegin(); it != _entries.constEnd(); ++it) {
+        const auto& factoryTraits = it.value()._factoryTraits;
+
+        entriesArray.append(QJsonObject({
+            { "FilePath", it.key() },
+            { "LastModified", static_cast<qint64>(it.value()._lastModified) },
+            { "Size", static_cast<qint64>(it.value()._size) },
+            { "MetaData", it.value()._metaData },
+            { "FactoryTraits", QJsonObject({
+                { "Type", factoryTraits._type },
+                { "StatusBarAction", factoryTraits._hasStatusBarAction },
+                { "GuiName", factoryTraits._guiName },
+                { "Icon", QString::fromLatin1(factoryTraits._icon.toBase64()) },
+                { "RepositoryUrl", factoryTraits._repositoryUrl },
+                { "ReadmeMarkdownUrl", factoryTraits._readmeMarkdownUrl },
+                { "AllowPluginCreationFromStandardGui", factoryTraits._allowPluginCreationFromStandardGui },
+                { "ProducesSystemViewPlugins", factoryTraits._producesSystemViewPlugins },
+                { "PreferredDockArea", factoryTraits._preferredDockArea }
+            }) }
+        }));
+    }
+
+    const QJsonObject cacheObject({
+        { "Version", pluginMetadataCacheFormatVersion },
+        { "Entries", entriesArray }
+    });
+
+    QSaveFile cacheFile(_cacheFilePath);
+
+    if (!cacheFile.open(QIODevice::WriteOnly)) {
+        qWarning() << "Unable to write plugin metadata cache" << _cacheFilePath;
+        return;
+    }
+
+    cacheFile.write(QJsonDocument(cacheObject).toJson(QJsonDocument::Compact));
+
+    if (cacheFile.commit())
+        _dirty = false;
+}
+
+QJsonObject PluginMetadataCache::getMetaData(const QString& pluginFilePath)
+{
+    const auto it = _entries.constFind(pluginFilePath);
+
+    if (it != _entries.constEnd() && isEntryValid(it.value(), pluginFilePath)) {
+        ++_numberOfHits;
+        return it.value()._metaData;
+    }
+
+    const QFileInfo pluginFileInfo(pluginFilePath);
+
+    const auto lastModified = pluginFileInfo.lastModified().toMSecsSinceEpoch();
+    const auto size         = pluginFileInfo.size();
+
+    ++_numberOfMisses;
+
+#ifdef PLUGIN_METADATA_CACHE_VERBOSE
+    qDebug() << "Reading plugin metadata from" << pluginFilePath;
+#endif
+
+    Entry entry;
+
+    entry._lastModified = lastModified;
+    entry._size         = size;
+    entry._metaData     = QPluginLoader(pluginFilePath).metaData().value("MetaData").toObject();
+
+    _entries[pluginFilePath] = entry;
+
+    _dirty = true;
+
+    return entry._metaData;
+}
+
+PluginMetadataCache::FactoryTraits PluginMetadataCache::getFactoryTraits(const QString& pluginFilePath) const
+{
+    const auto it = _entries.constFind(pluginFilePath);
+
+    if (it == _entries.constEnd() || !isEntryValid(it.value(), pluginFilePath))
+        return {};
+
+    return it.value()._factoryTraits;
+}
+
+void PluginMetadataCache::setFactoryTraits(const QString& pluginFilePath, const FactoryTraits& factoryTraits)
+{
+    const auto it = _entries.find(pluginFilePath);
+
+    if (it == _entries.end() || !isEntryValid(it.value(), pluginFilePath))
+        return;
+
+    if (it.value()._factoryTraits == factoryTraits)
+        return;
+
+    it.value()._factoryTraits = factoryTraits;
+
+    _dirty = true;
+}
+
+void PluginMetadataCache::prune(const QStringList& pluginFilePaths)
+{
+    const QSet<QString> existingPluginFilePaths(pluginFilePaths.begin(), pluginFilePaths.end());
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (!existingPluginFilePaths.contains(it.key())) {
+            it = _entries.erase(it);
+            _dirty = true;
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void PluginMetadataCache::clear()
+{
+    if (_entries.isEmpty())
+        return;
+
+    _entries.clear();
+
+    _dirty = true;
+}
+
+std::uint32_t PluginMetadataCache::getNumberOfHits() const
+{
+    return _numberOfHits;
+}
+
+std::uint32_t PluginMetadataCache::getNumberOfMisses() const
+{
+    return _numberOfMisses;
+}
+
+bool PluginMetadataCache::isEntryValid(const Entry& entry, const QString& pluginFilePath)
+{
+    const QFileInfo pluginFileInfo(pluginFilePath);
+
+    return pluginFileInfo.exists() && entry._lastModified == pluginFileInfo.lastModified().toMSecsSinceEpoch() && entry._size == pluginFileInfo.size();
+}
+
+}
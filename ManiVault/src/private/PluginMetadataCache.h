@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+
+namespace mv {
+
+/**
+ * Plugin metadata cache class
+ *
+ * Persistent index of plugin shared library metadata (the content of the plugin .json file compiled into the library).
+ * Entries are keyed by the absolute plugin file path and are only considered valid when the last modified time
+ * and file size on disk still match, so that metadata can be obtained without constructing a QPluginLoader.
+ *
+ * Once a plugin shared library has been loaded, the traits of its factory (e.g. the plugin type, GUI name and icon) are
+ * recorded with its entry as well, so that the plugin manager can register and list the plugin on the next startup
+ * without loading the library (see PluginManager::loadPluginFactories()). A changed plugin file invalidates its entry,
+ * traits included.
+ *
+ * @author Thomas Kroes
+ */
+class PluginMetadataCache final
+{
+public:
+
+    /**
+     * Properties of a plugin factory which are only known once its shared library has been loaded, cached so that the
+     * plugin can be listed (e.g. in menus) without loading its shared library
+     */
+    struct FactoryTraits
+    {
+        std::int32_t    _type = -1;                                     /** Plugin type of the factory (plugin::Type), -1 when unknown */
+        bool            _hasStatusBarAction = false;                    /** Whether the factory provides a status bar action */
+        QString         _guiName;                                       /** GUI name of the plugin */
+        QByteArray      _icon;                                          /** Plugin icon (PNG encoded) */
+        QString         _repositoryUrl;                                 /** Plugin repository URL, empty if none */
+        QString         _readmeMarkdownUrl;                             /** Plugin readme markdown URL, empty if none */
+        bool            _allowPluginCreationFromStandardGui = true;     /** Whether plugin instances may be created from the standard GUI */
+        bool            _producesSystemViewPlugins = false;             /** Whether the factory produces system view plugins (view plugins only) */
+        std::int32_t    _preferredDockArea = 0;                         /** Preferred dock area (gui::DockAreaFlag, view plugins only) */
+
+        /**
+         * Get whether the traits are known
+         * @return Boolean determining whether the traits are known
+         */
+        bool isValid() const {
+            return _type >= 0;
+        }
+
+        /**
+         * Equality operator
+         * @param other Factory traits to compare with
+         * @return Boolean determining whether the factory traits are equal
+         */
+        bool operator==(const FactoryTraits& other) const = default;
+    };
+
+    /** Cached metadata of a single plugin shared library */
+    struct Entry
+    {
+        std::int64_t    _lastModified = 0;      /** Last modified time of the plugin file (msecs since epoch) */
+        std::int64_t    _size = 0;              /** Size of the plugin file in bytes */
+        QJsonObject     _metaData;              /** Plugin metadata (the MetaData object of the plugin loader), empty when the file is not a plugin */
+        FactoryTraits   _factoryTraits;         /** Factory traits, invalid when the library was not loaded yet */
+    };
+
+public:
+
+    /**
+     * Construct with \p cacheFilePath
+     * @param cacheFilePath Location of the persisted cache file
+     */
+    explicit PluginMetadataCache(const QString& cacheFilePath = "");
+
+    /**
+     * Get cache file path
+     * @return Location of the persisted cache file
+     */
+    QString getCacheFilePath() const;
+
+    /**
+     * Set cache file path to \p cacheFilePath
+     * @param cacheFilePath Location of the persisted cache file
+     */
+    void setCacheFilePath(const QString& cacheFilePath);
+
+    /** Load the cache from disk (stale or malformed caches are discarded) */
+    void load();
+
+    /** Save the cache to disk (only when modified since the last load/save) */
+    void save();
+
+    /**
+     * Get plugin metadata for \p pluginFilePath, read from the shared library only when there is no valid cache entry
+     * @param pluginFilePath Absolute path of the plugin shared library
+     * @return Plugin metadata, empty if the file is not a plugin
+     */
+    QJsonObject getMetaData(const QString& pluginFilePath);
+
+    /**
+     * Get the factory traits of the plugin at \p pluginFilePath (only when its entry is still valid)
+     * @param pluginFilePath Absolute path of the plugin shared library
+     * @return Factory traits, invalid when unknown or when the plugin file changed since they were recorded
+     */
+    FactoryTraits getFactoryTraits(const QString& pluginFilePath) const;
+
+    /**
+     * Record the \p factoryTraits of the plugin at \p pluginFilePath (requires a valid entry, see getMetaData())
+     * @param pluginFilePath Absolute path of the plugin shared library
+     * @param factoryTraits Factory traits
+     */
+    void setFactoryTraits(const QString& pluginFilePath, const FactoryTraits& factoryTraits);
+
+    /**
+     * Remove entries that are not in \p pluginFilePaths (e.g. plugins that were uninstalled)
+     * @param pluginFilePaths Absolute paths of the plugin shared libraries that currently exist
+     */
+    void prune(const QStringList& pluginFilePaths);
+
+    /** Remove all entries */
+    void clear();
+
+    /**
+     * Get number of metadata requests served from the cache since the last load
+     * @return Number of cache hits
+     */
+    std::uint32_t getNumberOfHits() const;
+
+    /**
+     * Get number of metadata requests that required reading the shared library since the last load
+     * @return Number of cache misses
+     */
+    std::uint32_t getNumberOfMisses() const;
+
+private:
+
+    /**
+     * Get whether \p entry is still valid for the plugin file at \p pluginFilePath (its last modified time and size match)
+     * @param entry Cache entry
+     * @param pluginFilePath Absolute path of the plugin shared library
+     * @return Boolean determining whether the entry is valid
+     */
+    static bool isEntryValid(const Entry& entry, const QString& pluginFilePath);
+
+private:
+    QString                 _cacheFilePath;     /** Location of the persisted cache file */
+    QHash<QString, Entry>   _entries;           /** Cache entries by absolute plugin file path */
+    bool                    _dirty;             /** Whether the cache was modified since the last load/save */
+    std::uint32_t           _numberOfHits;      /** Number of cache hits since the last load */
+    std::uint32_t           _numberOfMisses;    /** Number of cache misses since the last load */
+};
+
+}
@@ -16,6 +16,7 @@
 
 #include <util/Exception.h>
 #include <util/Serialization.h>
+#include <util/Trace.h>
 
 #include <widgets/FileDialog.h>
 
@@ -175,8 +176,21 @@ ProjectManager::ProjectManager(QObject* parent) :
     connect(&_importDataMenu, &QMenu::aboutToShow, this, [this]() -> void {
         _importDataMenu.clear();
 
-        for (auto& pluginTriggerAction : plugins().getPluginTriggerActions(plugin::Type::LOADER))
-            _importDataMenu.addAction(pluginTriggerAction);
+        // Listed from the plugin factory properties, the (deferred) loader plugin is loaded when triggered
+        for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ plugin::Type::LOADER })) {
+            const auto pluginKind = pluginFactoryInfo._kind;
+
+            auto importDataAction = new TriggerAction(&_importDataMenu, pluginKind);
+
+            importDataAction->setIcon(pluginFactoryInfo._icon);
+            importDataAction->setToolTip(QString("Load %1").arg(pluginKind));
+
+            connect(importDataAction, &TriggerAction::triggered, this, [pluginKind]() -> void {
+                plugins().requestPlugin(pluginKind);
+            });
+
+            _importDataMenu.addAction(importDataAction);
+        }
 
         _importDataMenu.setEnabled(!_importDataMenu.actions().isEmpty());
     });
@@ -302,13 +316,17 @@ void ProjectManager::newProject(const Qt::AlignmentFlag& alignment, bool logging
 
     plugin::ViewPlugin* dataHierarchyPlugin = nullptr;
 
-    if (plugins().isPluginLoaded("Data hierarchy"))
+    const auto isPluginAvailable = [](const QString& pluginKind) -> bool {
+        return plugins().isPluginLoaded(pluginKind) || plugins().isPluginDeferred(pluginKind);
+    };
+
+    if (isPluginAvailable("Data hierarchy"))
         dataHierarchyPlugin = plugins().requestViewPlugin("Data hierarchy", nullptr, dockAreaFlag);
 
-    if (plugins().isPluginLoaded("Data properties"))
+    if (isPluginAvailable("Data properties"))
         plugins().requestViewPlugin("Data properties", dataHierarchyPlugin, DockAreaFlag::Bottom);
 
-    if (logging && plugins().isPluginLoaded("Logging"))
+    if (logging && isPluginAvailable("Logging"))
         plugins().requestViewPlugin("Logging", nullptr, DockAreaFlag::Bottom);
 }
 
@@ -437,6 +455,8 @@ void ProjectManager::openProject(QString filePath /*= ""*/, bool importDataOnly
 
         qDebug().noquote() << "Open ManiVault project from" << filePath;
 
+        MV_TRACE_SCOPE_DETAIL("project", "Open project", filePath);
+
         workspaces().reset();
 
         if (!importDataOnly)
@@ -482,9 +502,15 @@ void ProjectManager::openProject(QString filePath /*= ""*/, bool importDataOnly
 
             compressionTask.setFinished();
 
-            projects().fromJsonFile(QFileInfo(temporaryDirectoryPath, "project.json").absoluteFilePath());
-            
+            {
+                MV_TRACE_SCOPE("project", "Load project JSON");
+
+                projects().fromJsonFile(QFileInfo(temporaryDirectoryPath, "project.json").absoluteFilePath());
+            }
+
             if (loadWorkspace) {
+                MV_TRACE_SCOPE("project", "Load workspace");
+
                 if (workspaceFileInfo.exists())
                     workspaces().loadWorkspace(workspaceFileInfo.absoluteFilePath(), false);
 
@@ -705,6 +731,8 @@ void ProjectManager::saveProject(QString filePath /*= ""*/, const QString& passw
             else
                 qDebug().noquote() << "Saving ManiVault project to" << filePath << "without compression";
 
+            MV_TRACE_SCOPE_DETAIL("project", "Save project", filePath);
+
             auto& projectSerializationTask  = projects().getProjectSerializationTask();
             auto& compressionTask           = projectSerializationTask.getCompressionTask();
 
@@ -725,13 +753,21 @@ void ProjectManager::saveProject(QString filePath /*= ""*/, const QString& passw
 
             Application::setSerializationAborted(false);
 
-            projects().toJsonFile(projectJsonFileInfo.absoluteFilePath());
+            {
+                MV_TRACE_SCOPE("project", "Save project JSON");
+
+                projects().toJsonFile(projectJsonFileInfo.absoluteFilePath());
+            }
 
             _project->getProjectMetaAction().toJsonFile(projectMetaJsonFileInfo.absoluteFilePath());
             
             QFileInfo workspaceFileInfo(temporaryDirectoryPath, "workspace.json");
 
-            workspaces().saveWorkspace(workspaceFileInfo.absoluteFilePath(), false);
+            {
+                MV_TRACE_SCOPE("project", "Save workspace");
+
+                workspaces().saveWorkspace(workspaceFileInfo.absoluteFilePath(), false);
+            }
 
             compressionTask.setSubtasks(archiver.getTaskNamesForDirectoryCompression(temporaryDirectoryPath));
             compressionTask.setRunning();
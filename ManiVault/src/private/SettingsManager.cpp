@@ -31,7 +31,8 @@ SettingsManager::SettingsManager(QObject* parent) :
     _miscellaneousSettingsAction(this),
     _tasksSettingsAction(this),
     _applicationSettingsAction(this),
-    _temporaryDirectoriesSettingsAction(this)
+    _temporaryDirectoriesSettingsAction(this),
+    _memorySettingsAction(this)
 {
     _editSettingsAction.setShortcutContext(Qt::WidgetWithChildrenShortcut);
 
@@ -98,7 +99,7 @@ PluginGlobalSettingsGroupAction* SettingsManager::getPluginGlobalSettingsGroupAc
         if (kind.isEmpty())
             throw std::runtime_error("Plugin kind is empty");
 
-        auto pluginFactory = mv::plugins().getPluginFactory(kind);
+        auto pluginFactory = mv::plugins().loadDeferredPluginFactory(kind);
 
         if (!pluginFactory)
             throw std::runtime_error("No plugin factory loaded with kind");
@@ -44,6 +44,7 @@ public: // Global settings actions
     gui::TasksSettingsAction& getTasksSettingsAction() override { return _tasksSettingsAction; };
     gui::ApplicationSettingsAction& getApplicationSettings() override { return _applicationSettingsAction; };
     gui::TemporaryDirectoriesSettingsAction& getTemporaryDirectoriesSettingsAction() override { return _temporaryDirectoriesSettingsAction; };
+    gui::MemorySettingsAction& getMemorySettingsAction() override { return _memorySettingsAction; };
 
     /**
      * Get plugin global settings for plugin \p kind
@@ -66,6 +67,7 @@ private:
     gui::TasksSettingsAction                    _tasksSettingsAction;                   /** Tasks global settings */
     gui::ApplicationSettingsAction              _applicationSettingsAction;             /** Application global settings */
     gui::TemporaryDirectoriesSettingsAction     _temporaryDirectoriesSettingsAction;    /** Temporary files global settings */
+    gui::MemorySettingsAction                   _memorySettingsAction;                  /** Memory budget global settings */
 };
 
 }
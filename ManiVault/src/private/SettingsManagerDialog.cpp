@@ -41,6 +41,10 @@ SettingsManagerDialog::SettingsManagerDialog(QWidget* parent /*= nullptr*/) :
 #endif
 
     _groupsAction.addGroupAction(&mv::settings().getTemporaryDirectoriesSettingsAction());
+    _groupsAction.addGroupAction(&mv::settings().getMemorySettingsAction());
+
+    // Global plugin settings are provided by the plugin factories, so load the deferred ones
+    mv::plugins().loadDeferredPluginFactories();
 
     for (auto pluginFactory : mv::plugins().getPluginFactoriesByTypes()) {
         auto pluginGlobalSettingsGroupAction = pluginFactory->getGlobalSettingsGroupAction();
@@ -175,16 +175,17 @@ void StartPageGetStartedWidget::updateCreateProjectFromDatasetActions()
 {
     _createProjectFromDatasetWidget.getModel().reset();
 
-    for (auto viewPluginFactory : plugins().getPluginFactoriesByType(plugin::Type::LOADER)) {
-        const auto subtitle = QString("Import data into new project with %1").arg(viewPluginFactory->getKind());
+    for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ plugin::Type::LOADER })) {
+        const auto pluginKind   = pluginFactoryInfo._kind;
+        const auto subtitle     = QString("Import data into new project with %1").arg(pluginKind);
 
-        PageAction fromDataPageAction(viewPluginFactory->getIcon(), viewPluginFactory->getKind(), subtitle, subtitle, "", [viewPluginFactory]() -> void {
+        PageAction fromDataPageAction(pluginFactoryInfo._icon, pluginKind, subtitle, subtitle, "", [pluginKind]() -> void {
             projects().newProject(Qt::AlignRight);
-            plugins().requestPlugin(viewPluginFactory->getKind());
+            plugins().requestPlugin(pluginKind);
         });
 
         fromDataPageAction.setSubtitle(subtitle);
-        fromDataPageAction.setComments(QString("Create a new project and import data into it with the %1").arg(viewPluginFactory->getKind()));
+        fromDataPageAction.setComments(QString("Create a new project and import data into it with the %1").arg(pluginKind));
 
         _createProjectFromDatasetWidget.getModel().add(fromDataPageAction);
     }
@@ -104,30 +104,50 @@ void ViewMenu::populate()
 
 bool ViewMenu::mayProducePlugins() const
 {
-    for (auto& pluginTriggerAction : plugins().getPluginTriggerActions(Type::VIEW)) {
-        auto viewPluginFactory = dynamic_cast<const ViewPluginFactory*>(pluginTriggerAction->getPluginFactory());
-
-        if (viewPluginFactory->producesSystemViewPlugins())
+    for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ Type::VIEW })) {
+        if (pluginFactoryInfo._producesSystemViewPlugins)
             continue;
 
-        if (pluginTriggerAction->isEnabled())
+        // Deferred view plugins have no instances yet
+        if (!pluginFactoryInfo._isLoaded)
+            return true;
+
+        if (plugins().getPluginFactory(pluginFactoryInfo._kind)->getPluginTriggerAction().isEnabled())
             return true;
     }
 
     return false;
 }
 
-QVector<QPointer<PluginTriggerAction>> ViewMenu::getLoadViewsActions(gui::DockAreaFlag dockArea) const
+QVector<QPointer<TriggerAction>> ViewMenu::getLoadViewsActions(gui::DockAreaFlag dockArea)
 {
-    PluginTriggerActions pluginTriggerActions;
+    QVector<QPointer<TriggerAction>> actions;
 
-    for (auto& pluginTriggerAction : plugins().getPluginTriggerActions(plugin::Type::VIEW)) {
-        auto viewPluginFactory = dynamic_cast<const ViewPluginFactory*>(pluginTriggerAction->getPluginFactory());
+    // The actions are deleted when the menu they are added to is cleared
+    auto actionsMenu = _dockAreaWidget ? _loadViewsDockedMenus[dockArea].get() : this;
 
-        if (viewPluginFactory->producesSystemViewPlugins() || !viewPluginFactory->getAllowPluginCreationFromStandardGui())
+    // View plugins are listed from their factory properties, deferred view plugins are only loaded when one is created
+    for (const auto& pluginFactoryInfo : plugins().getPluginFactoryInfos({ Type::VIEW })) {
+        if (pluginFactoryInfo._producesSystemViewPlugins || !pluginFactoryInfo._allowPluginCreationFromStandardGui)
             continue;
-            
-        pluginTriggerActions << new PluginTriggerAction(*pluginTriggerAction, QString("Create %1").arg(viewPluginFactory->getKind()));
+
+        const auto pluginKind = pluginFactoryInfo._kind;
+
+        auto action = new TriggerAction(actionsMenu, pluginKind);
+
+        action->setToolTip(QString("Create %1").arg(pluginKind));
+        action->setIcon(pluginFactoryInfo._icon);
+
+        if (pluginFactoryInfo._isLoaded) {
+            auto pluginTriggerAction = &plugins().getPluginFactory(pluginKind)->getPluginTriggerAction();
+
+            action->setEnabled(pluginTriggerAction->isEnabled());
+
+            connect(pluginTriggerAction, &PluginTriggerAction::enabledChanged, action, [action](bool enabled) -> void {
+                if (enabled != action->isEnabled())
+                    action->setEnabled(enabled);
+            });
+        }
 
         ViewPlugin* dockToViewPlugin = nullptr;
 
@@ -138,12 +158,14 @@ QVector<QPointer<PluginTriggerAction>> ViewMenu::getLoadViewsActions(gui::DockAr
                 dockToViewPlugin = firstViewPluginDockWidget->getViewPlugin();
         }
 
-        pluginTriggerActions.last()->setRequestPluginCallback([dockToViewPlugin, dockArea](PluginTriggerAction& pluginTriggerAction) -> void {
-            plugins().requestViewPlugin(pluginTriggerAction.getPluginFactory()->getKind(), dockToViewPlugin, dockArea);
+        connect(action, &QAction::triggered, action, [pluginKind, dockToViewPlugin, dockArea]() -> void {
+            plugins().requestViewPlugin(pluginKind, dockToViewPlugin, dockArea);
         });
+
+        actions << action;
     }
 
-    sortActions(pluginTriggerActions);
+    sortActions(actions);
 
-    return pluginTriggerActions;
+    return actions;
 }
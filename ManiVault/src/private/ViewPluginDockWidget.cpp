@@ -152,7 +152,7 @@ void ViewPluginDockWidget::loadViewPlugin()
     qDebug() << __FUNCTION__;
 #endif
 
-	if (!plugins().isPluginLoaded(_viewPluginKind))
+	if (!plugins().isPluginLoaded(_viewPluginKind) && !plugins().isPluginDeferred(_viewPluginKind))
 		return;
 
 	if (auto viewPlugin = dynamic_cast<ViewPlugin*>(plugins().requestPlugin(_viewPluginKind)))
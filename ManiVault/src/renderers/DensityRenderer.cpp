@@ -4,6 +4,8 @@
 
 #include "DensityRenderer.h"
 
+#include "util/Trace.h"
+
 namespace mv
 {
     namespace gui
@@ -100,6 +102,8 @@ namespace mv
 
         void DensityRenderer::render()
         {
+            MV_TRACE_SCOPE("render", "DensityRenderer::render");
+
             glViewport(0, 0, _windowSize.width(), _windowSize.height());
 
             int w = _windowSize.width();
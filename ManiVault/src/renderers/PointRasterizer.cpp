@@ -0,0 +1,479 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "PointRasterizer.h"
+
+#include "util/Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
+namespace mv
+{
+    namespace gui
+    {
+        namespace
+        {
+            /** Point sets smaller than this are shaded and binned on one thread */
+            constexpr std::size_t minimumNumberOfPointsPerPartition = 65536;
+
+            /**
+             * Invoke \p function for each index in [0, \p count) in parallel
+             * @param count Number of indices
+             * @param function Function to invoke
+             */
+            template<typename Function>
+            void forEachIndex(std::size_t count, const Function& function)
+            {
+                std::vector<std::size_t> indices(count);
+
+                std::iota(indices.begin(), indices.end(), 0);
+
+#ifndef __APPLE__
+                std::for_each(std::execution::par, indices.begin(), indices.end(), function);
+#else
+                std::for_each(indices.begin(), indices.end(), function);
+#endif
+            }
+
+            /** GLSL smoothstep() */
+            float smoothStep(float edge0, float edge1, float x)
+            {
+                const auto t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+
+                return t * t * (3.0f - 2.0f * t);
+            }
+
+            /** Normalize \p value to [0, 1] in the range [\p minimum, \p maximum] (as in the point plot fragment shader) */
+            float normalizeValue(float minimum, float maximum, float value)
+            {
+                return std::clamp((value - minimum) / (maximum - minimum), 0.0f, 1.0f);
+            }
+        }
+
+        void PointRasterizer::setFromPointRenderer(const PointRenderer& pointRenderer)
+        {
+            const auto& gpuPoints       = pointRenderer.getGpuPoints();
+            const auto& pointSettings   = pointRenderer.getPointSettings();
+
+            _positions          = gpuPoints.getPositions();
+            _colors             = gpuPoints.getColors();
+            _highlights         = gpuPoints.getHighlights();
+            _focusHighlights    = gpuPoints.getFocusHighlights();
+            _colorScalars       = gpuPoints.getScalars();
+            _sizeScalars        = gpuPoints.getSizeScalars();
+            _opacityScalars     = gpuPoints.getOpacityScalars();
+            _colorScalarsRange  = gpuPoints.getColorMapRange();
+
+            _scalingMode    = pointSettings._scalingMode;
+            _pointSize      = pointSettings._pointSize;
+            _alpha          = pointSettings._alpha;
+            _pointEffect    = pointRenderer.getScalarEffect();
+
+            _selectionDisplayMode           = pointRenderer.getSelectionDisplayMode();
+            _selectionOutlineColor          = pointRenderer.getSelectionOutlineColor();
+            _selectionOutlineOverrideColor  = pointRenderer.getSelectionOutlineOverrideColor();
+            _selectionOutlineScale          = pointRenderer.getSelectionOutlineScale();
+            _selectionOutlineOpacity        = pointRenderer.getSelectionOutlineOpacity();
+            _selectionHaloEnabled           = pointRenderer.getSelectionHaloEnabled();
+
+            _boundsView = pointRenderer.getViewBounds();
+            _boundsData = pointRenderer.getDataBounds();
+        }
+
+        void PointRasterizer::setData(const std::vector<Vector2f>& positions)
+        {
+            _positions = positions;
+        }
+
+        void PointRasterizer::setHighlights(const std::vector<char>& highlights)
+        {
+            _highlights = highlights;
+        }
+
+        void PointRasterizer::setFocusHighlights(const std::vector<char>& focusHighlights)
+        {
+            _focusHighlights = focusHighlights;
+        }
+
+        void PointRasterizer::setColorChannelScalars(const std::vector<float>& scalars, bool adjustColorMapRange /*= true*/)
+        {
+            if (adjustColorMapRange)
+            {
+                _colorScalarsRange.x = std::numeric_limits<float>::max();
+                _colorScalarsRange.y = -std::numeric_limits<float>::max();
+
+                // Determine scalar range
+                for (const float& scalar : scalars)
+                {
+                    if (scalar < _colorScalarsRange.x)
+                        _colorScalarsRange.x = scalar;
+
+                    if (scalar > _colorScalarsRange.y)
+                        _colorScalarsRange.y = scalar;
+                }
+
+                _colorScalarsRange.z = _colorScalarsRange.y - _colorScalarsRange.x;
+
+                if (_colorScalarsRange.z < 1e-07)
+                    _colorScalarsRange.z = static_cast<float>(1e-07);
+            }
+
+            _colorScalars = scalars;
+        }
+
+        void PointRasterizer::setSizeChannelScalars(const std::vector<float>& scalars)
+        {
+            _sizeScalars = scalars;
+        }
+
+        void PointRasterizer::setOpacityChannelScalars(const std::vector<float>& scalars)
+        {
+            _opacityScalars = scalars;
+        }
+
+        void PointRasterizer::setColors(const std::vector<Vector3f>& colors)
+        {
+            _colors = colors;
+        }
+
+        PointEffect PointRasterizer::getScalarEffect() const
+        {
+            return _pointEffect;
+        }
+
+        void PointRasterizer::setScalarEffect(const PointEffect effect)
+        {
+            _pointEffect = effect;
+        }
+
+        void PointRasterizer::setColormap(const QImage& image)
+        {
+            _colormap = image.convertToFormat(QImage::Format_ARGB32);
+        }
+
+        void PointRasterizer::setBounds(const Bounds& bounds)
+        {
+            setViewBounds(bounds);
+            setDataBounds(bounds);
+        }
+
+        void PointRasterizer::setViewBounds(const Bounds& boundsView)
+        {
+            _boundsView = boundsView;
+        }
+
+        void PointRasterizer::setDataBounds(const Bounds& boundsData)
+        {
+            _boundsData = boundsData;
+        }
+
+        void PointRasterizer::setPointSize(const float size)
+        {
+            _pointSize = size;
+        }
+
+        void PointRasterizer::setAlpha(const float alpha)
+        {
+            _alpha = std::clamp(alpha, 0.0f, 1.0f);
+        }
+
+        void PointRasterizer::setPointScaling(PointScaling scalingMode)
+        {
+            _scalingMode = scalingMode;
+        }
+
+        Vector3f PointRasterizer::getColorMapRange() const
+        {
+            return _colorScalarsRange;
+        }
+
+        void PointRasterizer::setColorMapRange(const float& min, const float& max)
+        {
+            _colorScalarsRange = Vector3f(min, max, max - min);
+        }
+
+        void PointRasterizer::setSelectionDisplayMode(PointSelectionDisplayMode selectionDisplayMode)
+        {
+            _selectionDisplayMode = selectionDisplayMode;
+        }
+
+        void PointRasterizer::setSelectionOutlineColor(Vector3f color)
+        {
+            _selectionOutlineColor = color;
+        }
+
+        void PointRasterizer::setSelectionOutlineOverrideColor(bool selectionOutlineOverrideColor)
+        {
+            _selectionOutlineOverrideColor = selectionOutlineOverrideColor;
+        }
+
+        void PointRasterizer::setSelectionOutlineScale(float selectionOutlineScale)
+        {
+            _selectionOutlineScale = selectionOutlineScale;
+        }
+
+        void PointRasterizer::setSelectionOutlineOpacity(float selectionOutlineOpacity)
+        {
+            _selectionOutlineOpacity = selectionOutlineOpacity;
+        }
+
+        void PointRasterizer::setSelectionHaloEnabled(bool selectionHaloEnabled)
+        {
+            _selectionHaloEnabled = selectionHaloEnabled;
+        }
+
+        QImage PointRasterizer::rasterize(const QSize& imageSize, const QColor& backgroundColor /*= Qt::transparent*/) const
+        {
+            MV_TRACE_SCOPE("render", "PointRasterizer::rasterize");
+
+            if (imageSize.isEmpty())
+                return {};
+
+            QImage image(imageSize, QImage::Format_ARGB32_Premultiplied);
+
+            const auto width    = imageSize.width();
+            const auto height   = imageSize.height();
+
+            // Largest centered square viewport, as in the point renderer (which has its viewport origin at the bottom)
+            const auto viewportSize = std::min(width, height);
+            const auto viewportLeft = width / 2 - viewportSize / 2;
+            const auto viewportTop  = height - (height / 2 - viewportSize / 2) - viewportSize;
+            const auto viewport     = QRectF(viewportLeft, viewportTop, viewportSize, viewportSize);
+
+            const auto numberOfTilesX   = (width + tileSize - 1) / tileSize;
+            const auto numberOfTilesY   = (height + tileSize - 1) / tileSize;
+            const auto numberOfTiles    = static_cast<std::size_t>(numberOfTilesX) * static_cast<std::size_t>(numberOfTilesY);
+
+            const auto numberOfPoints       = _positions.size();
+            const auto numberOfThreads      = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            const auto numberOfPartitions   = std::clamp<std::size_t>(numberOfPoints / minimumNumberOfPointsPerPartition, 1, numberOfThreads);
+            const auto partitionSize        = (numberOfPoints + numberOfPartitions - 1) / numberOfPartitions;
+
+            std::vector<Splat> splats(numberOfPoints);
+
+            // Splat indices per partition and tile, the partitions are contiguous so concatenating them preserves the point order
+            std::vector<std::vector<std::vector<std::uint32_t>>> partitionTileSplats(numberOfPartitions, std::vector<std::vector<std::uint32_t>>(numberOfTiles));
+
+            const auto outlineStart = 1.0f / _selectionOutlineScale;
+
+            forEachIndex(numberOfPartitions, [&](std::size_t partitionIndex) -> void {
+                auto& tileSplats = partitionTileSplats[partitionIndex];
+
+                const auto first    = std::min(partitionIndex * partitionSize, numberOfPoints);
+                const auto last     = std::min(first + partitionSize, numberOfPoints);
+
+                for (auto pointIndex = first; pointIndex < last; ++pointIndex) {
+                    auto& splat = splats[pointIndex];
+
+                    splat = createSplat(static_cast<std::uint32_t>(pointIndex), viewport);
+
+                    // Non-highlighted points are clipped at the outline start in outline mode
+                    const auto isHighlighted    = splat._highlighted || splat._focusHighlighted;
+                    const auto clipRadius       = splat._radius * ((_selectionDisplayMode == PointSelectionDisplayMode::Outline && !isHighlighted) ? outlineStart : 1.0f);
+
+                    if (!std::isfinite(splat._x) || !std::isfinite(splat._y) || !(clipRadius > 0.0f))
+                        continue;
+
+                    const auto left     = std::max(static_cast<std::int32_t>(std::floor((splat._x - clipRadius) / tileSize)), 0);
+                    const auto right    = std::min(static_cast<std::int32_t>(std::floor((splat._x + clipRadius) / tileSize)), numberOfTilesX - 1);
+                    const auto top      = std::max(static_cast<std::int32_t>(std::floor((splat._y - clipRadius) / tileSize)), 0);
+                    const auto bottom   = std::min(static_cast<std::int32_t>(std::floor((splat._y + clipRadius) / tileSize)), numberOfTilesY - 1);
+
+                    for (auto tileY = top; tileY <= bottom; ++tileY)
+                        for (auto tileX = left; tileX <= right; ++tileX)
+                            tileSplats[static_cast<std::size_t>(tileY) * numberOfTilesX + tileX].push_back(static_cast<std::uint32_t>(pointIndex));
+                }
+            });
+
+            // Premultiplied background color
+            const auto backgroundAlpha  = static_cast<float>(backgroundColor.alphaF());
+            const float background[4]   = {
+                static_cast<float>(backgroundColor.redF()) * backgroundAlpha,
+                static_cast<float>(backgroundColor.greenF()) * backgroundAlpha,
+                static_cast<float>(backgroundColor.blueF()) * backgroundAlpha,
+                backgroundAlpha
+            };
+
+            // Detach once, so that the tiles can write their (disjoint) pixels concurrently
+            auto imageBits          = image.bits();
+            const auto bytesPerLine = image.bytesPerLine();
+
+            forEachIndex(numberOfTiles, [&](std::size_t tileIndex) -> void {
+                const auto tileX        = static_cast<std::int32_t>(tileIndex % numberOfTilesX) * tileSize;
+                const auto tileY        = static_cast<std::int32_t>(tileIndex / numberOfTilesX) * tileSize;
+                const auto tileWidth    = std::min(tileSize, width - tileX);
+                const auto tileHeight   = std::min(tileSize, height - tileY);
+
+                std::vector<float> tilePixels(static_cast<std::size_t>(tileWidth) * tileHeight * 4);
+
+                for (std::size_t pixelIndex = 0; pixelIndex < tilePixels.size(); pixelIndex += 4)
+                    std::copy(background, background + 4, tilePixels.begin() + pixelIndex);
+
+                for (const auto& tileSplats : partitionTileSplats)
+                    for (const auto splatIndex : tileSplats[tileIndex])
+                        drawSplat(splats[splatIndex], tileX, tileY, tileWidth, tileHeight, tilePixels.data());
+
+                const auto toByte = [](float value) -> int {
+                    return static_cast<int>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+                };
+
+                for (std::int32_t y = 0; y < tileHeight; ++y) {
+                    auto scanLine       = reinterpret_cast<QRgb*>(imageBits + static_cast<std::ptrdiff_t>(tileY + y) * bytesPerLine) + tileX;
+                    const auto* pixel   = tilePixels.data() + static_cast<std::size_t>(y) * tileWidth * 4;
+
+                    for (std::int32_t x = 0; x < tileWidth; ++x, pixel += 4)
+                        scanLine[x] = qRgba(toByte(pixel[0]), toByte(pixel[1]), toByte(pixel[2]), toByte(pixel[3]));
+                }
+            });
+
+            return image;
+        }
+
+        PointRasterizer::Splat PointRasterizer::createSplat(std::uint32_t index, const QRectF& viewport) const
+        {
+            Splat splat{};
+
+            const auto& position = _positions[index];
+
+            // Bounds space to clip space to image space
+            const auto clipX = 2.0f * (position.x - _boundsView.getLeft()) / _boundsView.getWidth() - 1.0f;
+            const auto clipY = 2.0f * (position.y - _boundsView.getBottom()) / _boundsView.getHeight() - 1.0f;
+
+            splat._x = static_cast<float>(viewport.left() + (clipX + 1.0f) * 0.5f * viewport.width());
+            splat._y = static_cast<float>(viewport.top() + (1.0f - clipY) * 0.5f * viewport.height());
+
+            // The point size is in pixels, in outline mode the quad is enlarged to make room for the outline
+            const auto pointSize = index < _sizeScalars.size() ? _sizeScalars[index] : _pointSize;
+
+            splat._radius = 0.5f * pointSize * (_selectionDisplayMode == PointSelectionDisplayMode::Outline ? _selectionOutlineScale : 1.0f);
+
+            splat._highlighted      = index < _highlights.size() && _highlights[index] == 1;
+            splat._focusHighlighted = index < _focusHighlights.size() && _focusHighlights[index] == 1;
+            splat._opacity          = index < _opacityScalars.size() ? _opacityScalars[index] : _alpha;
+
+            const auto color = index < _colors.size() ? _colors[index] : Vector3f(0.5f);
+
+            splat._color[0] = color.x;
+            splat._color[1] = color.y;
+            splat._color[2] = color.z;
+
+            if (!_colormap.isNull()) {
+                if (_pointEffect == PointEffect::Color) {
+                    const auto scalar = index < _colorScalars.size() ? (_colorScalars[index] - _colorScalarsRange.x) / _colorScalarsRange.z : 0.0f;
+
+                    sampleColormap(scalar, 1.0f - scalar, splat._color);
+                }
+
+                if (_pointEffect == PointEffect::Color2D) {
+                    const auto channel1 = normalizeValue(_boundsData.getLeft(), _boundsData.getRight(), position.x);
+                    const auto channel2 = normalizeValue(_boundsData.getBottom(), _boundsData.getTop(), position.y);
+
+                    sampleColormap(channel1, channel2, splat._color);
+                }
+            }
+
+            return splat;
+        }
+
+        void PointRasterizer::sampleColormap(float u, float v, float* color) const
+        {
+            const auto x = std::clamp(static_cast<std::int32_t>(std::floor(u * _colormap.width())), 0, _colormap.width() - 1);
+            const auto y = std::clamp(static_cast<std::int32_t>(std::floor(v * _colormap.height())), 0, _colormap.height() - 1);
+
+            const auto texel = reinterpret_cast<const QRgb*>(_colormap.constScanLine(y))[x];
+
+            color[0] = static_cast<float>(qRed(texel)) / 255.0f;
+            color[1] = static_cast<float>(qGreen(texel)) / 255.0f;
+            color[2] = static_cast<float>(qBlue(texel)) / 255.0f;
+        }
+
+        void PointRasterizer::drawSplat(const Splat& splat, std::int32_t tileX, std::int32_t tileY, std::int32_t tileWidth, std::int32_t tileHeight, float* tilePixels) const
+        {
+            const auto isSelectionHighlighted   = splat._highlighted;
+            const auto isFocusHighlighted       = splat._focusHighlighted;
+            const auto isHighlighted            = isSelectionHighlighted || isFocusHighlighted;
+            const auto isOutlineMode            = _selectionDisplayMode == PointSelectionDisplayMode::Outline;
+            const auto selectionOutlineStart    = 1.0f / _selectionOutlineScale;
+            const auto discardLength            = (isOutlineMode && !isHighlighted) ? selectionOutlineStart : 1.0f;
+            const auto clipRadius               = splat._radius * discardLength;
+            const float selectionOutlineColor[3] = { _selectionOutlineColor.x, _selectionOutlineColor.y, _selectionOutlineColor.z };
+
+            // Screen space derivative of the quad coordinate length, used for anti-aliasing the edge
+            const auto lengthDerivative = 1.0f / splat._radius;
+
+            const auto left     = std::max(static_cast<std::int32_t>(std::floor(splat._x - clipRadius)), tileX);
+            const auto right    = std::min(static_cast<std::int32_t>(std::ceil(splat._x + clipRadius)), tileX + tileWidth);
+            const auto top      = std::max(static_cast<std::int32_t>(std::floor(splat._y - clipRadius)), tileY);
+            const auto bottom   = std::min(static_cast<std::int32_t>(std::ceil(splat._y + clipRadius)), tileY + tileHeight);
+
+            for (auto y = top; y < bottom; ++y) {
+                const auto deltaY = static_cast<float>(y) + 0.5f - splat._y;
+
+                for (auto x = left; x < right; ++x) {
+                    const auto deltaX   = static_cast<float>(x) + 0.5f - splat._x;
+                    const auto length   = std::sqrt(deltaX * deltaX + deltaY * deltaY) / splat._radius;
+
+                    if (length > discardLength)
+                        continue;
+
+                    const auto a = smoothStep(1.0f, 1.0f - lengthDerivative, length);
+
+                    const float* color  = splat._color;
+                    auto opacity        = 1.0f;
+
+                    if (isOutlineMode) {
+                        if (isHighlighted && length > selectionOutlineStart) {
+                            if (_selectionOutlineOverrideColor)
+                                color = selectionOutlineColor;
+
+                            opacity = _selectionOutlineOpacity;
+
+                            if (isFocusHighlighted)
+                                opacity = isSelectionHighlighted ? 1.0f : 0.5f * _selectionOutlineOpacity;
+
+                            if (_selectionHaloEnabled)
+                                opacity *= 1.0f - smoothStep(selectionOutlineStart, 1.0f, length);
+                        } else {
+                            opacity *= a * splat._opacity;
+                        }
+                    }
+                    else {
+                        if (isHighlighted) {
+                            color   = selectionOutlineColor;
+                            opacity = a;
+                        }
+                        else {
+                            opacity = a * splat._opacity;
+                        }
+                    }
+
+                    // Source over destination with premultiplied destination pixels
+                    const auto sourceAlpha  = std::clamp(opacity, 0.0f, 1.0f);
+                    auto pixel              = tilePixels + (static_cast<std::size_t>(y - tileY) * tileWidth + (x - tileX)) * 4;
+
+                    for (int channel = 0; channel < 3; ++channel)
+                        pixel[channel] = color[channel] * sourceAlpha + pixel[channel] * (1.0f - sourceAlpha);
+
+                    pixel[3] = sourceAlpha + pixel[3] * (1.0f - sourceAlpha);
+                }
+            }
+        }
+
+    } // namespace gui
+
+} // namespace mv
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "PointRenderer.h"
+
+#include "graphics/Bounds.h"
+#include "graphics/Vector2f.h"
+#include "graphics/Vector3f.h"
+
+#include <QColor>
+#include <QImage>
+#include <QRectF>
+#include <QSize>
+
+#include <cstdint>
+#include <vector>
+
+namespace mv
+{
+    namespace gui
+    {
+        /**
+         * Point rasterizer class
+         *
+         * Software (CPU) counterpart of the point renderer: it takes the same inputs (positions, highlights, color,
+         * size and opacity scalars, colors, colormap image and bounds) and shades the points like the point plot
+         * shaders do, but writes the result to a QImage. It needs no OpenGL context or widget, so it can be used
+         * to produce scatterplot images in headless batch runs (e.g. for reports and project thumbnails).
+         *
+         * The image is divided into tiles, the points are binned per tile and the tiles are splatted in parallel.
+         * Within a tile the points are alpha blended in the order in which they are given, as in the point renderer
+         * with randomized depth disabled.
+         *
+         * @author Thomas Kroes
+         */
+        class CORE_EXPORT PointRasterizer
+        {
+        public:
+
+            /** Width and height of a tile in pixels */
+            static constexpr std::int32_t tileSize = 64;
+
+        public:
+
+            /**
+             * Copy all inputs of \p pointRenderer except its colormap (which only exists on the GPU, see setColormap())
+             * @param pointRenderer Point renderer to copy the inputs from
+             */
+            void setFromPointRenderer(const PointRenderer& pointRenderer);
+
+            void setData(const std::vector<Vector2f>& positions);
+            void setHighlights(const std::vector<char>& highlights);
+            void setFocusHighlights(const std::vector<char>& focusHighlights);
+            void setColorChannelScalars(const std::vector<float>& scalars, bool adjustColorMapRange = true);
+            void setSizeChannelScalars(const std::vector<float>& scalars);
+            void setOpacityChannelScalars(const std::vector<float>& scalars);
+            void setColors(const std::vector<Vector3f>& colors);
+
+            PointEffect getScalarEffect() const;
+            void setScalarEffect(const PointEffect effect);
+
+            void setColormap(const QImage& image);
+
+            // Sets both the view bounds and the data bounds
+            void setBounds(const Bounds& bounds);
+
+            // Sets the bounds which are mapped to the (square) viewport
+            void setViewBounds(const Bounds& boundsView);
+
+            // Sets the bounds used for scaling the 2D colormap
+            void setDataBounds(const Bounds& boundsData);
+
+            void setPointSize(const float size);
+            void setAlpha(const float alpha);
+            void setPointScaling(PointScaling scalingMode);
+
+            Vector3f getColorMapRange() const;
+            void setColorMapRange(const float& min, const float& max);
+
+        public: // Selection visualization
+
+            void setSelectionDisplayMode(PointSelectionDisplayMode selectionDisplayMode);
+            void setSelectionOutlineColor(Vector3f color);
+            void setSelectionOutlineOverrideColor(bool selectionOutlineOverrideColor);
+            void setSelectionOutlineScale(float selectionOutlineScale);
+            void setSelectionOutlineOpacity(float selectionOutlineOpacity);
+            void setSelectionHaloEnabled(bool selectionHaloEnabled);
+
+        public: // Rasterization
+
+            /**
+             * Rasterize the points into an image of \p imageSize (in parallel), like the point renderer the points
+             * are drawn in the largest centered square viewport
+             * @param imageSize Size of the image in pixels
+             * @param backgroundColor Color the image is cleared with
+             * @return Image in premultiplied ARGB32 format
+             */
+            QImage rasterize(const QSize& imageSize, const QColor& backgroundColor = Qt::transparent) const;
+
+        private:
+
+            /** Point which is ready to be splatted (in image space) */
+            struct Splat
+            {
+                float       _x;                 /** Center x-coordinate in pixels */
+                float       _y;                 /** Center y-coordinate in pixels */
+                float       _radius;            /** Radius of the point quad in pixels */
+                float       _color[3];          /** Point color */
+                float       _opacity;           /** Point opacity */
+                bool        _highlighted;       /** Whether the point is selection highlighted */
+                bool        _focusHighlighted;  /** Whether the point is focus highlighted */
+            };
+
+            /**
+             * Shade point \p index and transform it to image space
+             * @param index Point index
+             * @param viewport Square viewport in image space
+             * @return Splat
+             */
+            Splat createSplat(std::uint32_t index, const QRectF& viewport) const;
+
+            /**
+             * Look up the color in the colormap at normalized texture coordinates (\p u, \p v) (nearest, clamped to the edge)
+             * @param u Horizontal texture coordinate
+             * @param v Vertical texture coordinate
+             * @param color Resulting color
+             */
+            void sampleColormap(float u, float v, float* color) const;
+
+            /**
+             * Splat \p splat into the tile with origin (\p tileX, \p tileY)
+             * @param splat Splat to draw
+             * @param tileX Tile origin x-coordinate in pixels
+             * @param tileY Tile origin y-coordinate in pixels
+             * @param tileWidth Width of the tile in pixels
+             * @param tileHeight Height of the tile in pixels
+             * @param tilePixels Premultiplied RGBA tile pixels
+             */
+            void drawSplat(const Splat& splat, std::int32_t tileX, std::int32_t tileY, std::int32_t tileWidth, std::int32_t tileHeight, float* tilePixels) const;
+
+        private:
+
+            /* Point attributes */
+            std::vector<Vector2f>   _positions;         /** Point positions */
+            std::vector<Vector3f>   _colors;            /** Point colors */
+            std::vector<char>       _highlights;        /** Point selection highlights */
+            std::vector<char>       _focusHighlights;   /** Point focus highlights */
+
+            /** Scalar channels */
+            std::vector<float>      _colorScalars;      /** Point color scalar channel */
+            std::vector<float>      _sizeScalars;       /** Point size scalar channel */
+            std::vector<float>      _opacityScalars;    /** Point opacity scalar channel */
+            Vector3f                _colorScalarsRange = Vector3f(0, 1, 1); /** Scalar range of the point color scalars */
+
+            /* Point properties */
+            PointScaling                _scalingMode                    = PointScaling::Relative;
+            float                       _pointSize                      = 15.0f;
+            float                       _alpha                          = 0.5f;
+            PointEffect                 _pointEffect                    = PointEffect::Size;
+            QImage                      _colormap;                                              /** Colormap image (in ARGB32 format) */
+
+            /** Selection visualization */
+            PointSelectionDisplayMode   _selectionDisplayMode           = PointSelectionDisplayMode::Outline;
+            Vector3f                    _selectionOutlineColor          = Vector3f(0, 0, 1);
+            bool                        _selectionOutlineOverrideColor  = true;
+            float                       _selectionOutlineScale          = 1.75f;
+            float                       _selectionOutlineOpacity        = 0.5f;
+            bool                        _selectionHaloEnabled           = false;
+
+            Bounds                      _boundsView                     = Bounds(-1, 1, -1, 1); /** Mapped to the (square) viewport */
+            Bounds                      _boundsData                     = Bounds(-1, 1, -1, 1); /** Used for scaling the 2d colormap */
+        };
+
+    } // namespace gui
+
+} // namespace mv
@@ -4,6 +4,8 @@
 
 #include "PointRenderer.h"
 
+#include "util/Trace.h"
+
 #include <limits>
 
 namespace mv
@@ -496,6 +498,8 @@ namespace mv
 
         void PointRenderer::render()
         {
+            MV_TRACE_SCOPE("render", "PointRenderer::render");
+
             int w = _windowSize.width();
             int h = _windowSize.height();
             int size = w < h ? w : h;
@@ -7,8 +7,10 @@
 #include "graphics/Bounds.h"
 #include "graphics/Matrix3f.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 namespace mv
 {
@@ -76,7 +78,10 @@ DensityComputation::DensityComputation() :
     _ctx(nullptr),
     _points(nullptr),
     _weights(nullptr),
-    _vao(0)
+    _vao(0),
+    _labelsVao(0),
+    _labels(nullptr),
+    _numberOfLabels(0)
 {
 
 }
@@ -157,6 +162,43 @@ void DensityComputation::init(QOpenGLContext* ctx)
     _densityBuffer.addColorTexture(0, &_densityTexture);
     _densityBuffer.validate();
 
+    // Build a second VAO for the label densities, its instance attributes are sorted by label
+    glGenVertexArrays(1, &_labelsVao);
+    glBindVertexArray(_labelsVao);
+
+    quadBuffer.bind();
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, 0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 4, (void*)(sizeof(float) * 2));
+    glEnableVertexAttribArray(1);
+
+    _labelPointBuffer.create();
+    _labelPointBuffer.bind();
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0);
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(2);
+
+    _labelWeightsBuffer.create();
+    _labelWeightsBuffer.bind();
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 0, 0);
+    glVertexAttribDivisor(3, 1);
+    glEnableVertexAttribArray(3);
+
+    _labelBuffer.create();
+    _labelBuffer.bind();
+    glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, 0, 0);
+    glVertexAttribDivisor(4, 1);
+    glEnableVertexAttribArray(4);
+
+    // Load the label density computation shader
+    loaded = _shaderLabelDensityCompute.loadShaderFromFile(":shaders/DensityComputeLabels.vert", ":shaders/DensityComputeLabels.frag");
+    if (!loaded) {
+        qDebug() << "Failed to load DensityComputeLabels shader";
+    }
+
+    // The label density textures are attached per pass
+    _labelDensityBuffer.create();
+
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
@@ -182,6 +224,20 @@ void DensityComputation::cleanup()
     _pointBuffer.destroy();
     _weightsBuffer.destroy();
     // FIXME: Other VBOs are not deleted
+
+    // Destroy the label density resources
+    _shaderLabelDensityCompute.destroy();
+
+    for (auto& labelDensityTexture : _labelDensityTextures)
+        labelDensityTexture.destroy();
+
+    _labelDensityTextures.clear();
+    _labelDensityBuffer.destroy();
+
+    glDeleteVertexArrays(1, &_labelsVao);
+    _labelPointBuffer.destroy();
+    _labelWeightsBuffer.destroy();
+    _labelBuffer.destroy();
 }
 
 void DensityComputation::setData(const std::vector<Vector2f>* points)
@@ -214,11 +270,7 @@ void DensityComputation::compute()
     if (!_initialized) return;
     if (!hasData()) return;
 
-    // Bind the OpenGL context to an off-screen surface to draw on
-    _offscreenSurface.setFormat(_ctx->format());
-    _offscreenSurface.setScreen(_ctx->screen());
-    _offscreenSurface.create();
-    _ctx->makeCurrent(&_offscreenSurface);
+    makeCurrent();
 
     _numPoints = static_cast<std::uint32_t>(_points->size());
     
@@ -279,6 +331,219 @@ void DensityComputation::compute()
     //qDebug() << "Done computing density";
 }
 
+void DensityComputation::setLabels(const std::vector<std::uint32_t>* labels, std::uint32_t numberOfLabels)
+{
+    _labels         = labels;
+    _numberOfLabels = numberOfLabels;
+}
+
+void DensityComputation::computeLabelDensities()
+{
+    if (!_initialized) return;
+    if (!hasData()) return;
+    if (_labels == nullptr || _labels->size() != _points->size() || _numberOfLabels == 0) return;
+
+    makeCurrent();
+
+    const auto numberOfPoints   = _points->size();
+    const bool hasWeight        = (_weights != nullptr) && (_weights->size() == numberOfPoints);
+
+    // Sort the points by label (counting sort), so that each pass only splats the points of its own labels
+    std::vector<std::uint32_t> labelOffsets(_numberOfLabels + 1, 0);
+
+    for (const auto label : *_labels)
+        if (label < _numberOfLabels)
+            labelOffsets[label + 1]++;
+
+    std::partial_sum(labelOffsets.begin(), labelOffsets.end(), labelOffsets.begin());
+
+    const auto numberOfLabeledPoints = labelOffsets.back();
+
+    std::vector<Vector2f>       sortedPoints(numberOfLabeledPoints);
+    std::vector<float>          sortedWeights(hasWeight ? numberOfLabeledPoints : 0);
+    std::vector<std::uint32_t>  sortedLabels(numberOfLabeledPoints);
+
+    auto insertOffsets = labelOffsets;
+
+    for (std::size_t pointIndex = 0; pointIndex < numberOfPoints; pointIndex++) {
+        const auto label = (*_labels)[pointIndex];
+
+        if (label >= _numberOfLabels)
+            continue;
+
+        const auto sortedIndex = insertOffsets[label]++;
+
+        sortedPoints[sortedIndex] = (*_points)[pointIndex];
+        sortedLabels[sortedIndex] = label;
+
+        if (hasWeight)
+            sortedWeights[sortedIndex] = (*_weights)[pointIndex];
+    }
+
+    allocateLabelDensityTextures();
+
+    glBindVertexArray(_labelsVao);
+
+    // Upload the sorted points and labels to the GPU
+    _labelPointBuffer.bind();
+    _labelPointBuffer.setData(sortedPoints);
+
+    _labelBuffer.bind();
+    _labelBuffer.setData(sortedLabels);
+
+    // Upload the sorted weights to the GPU, if there are any
+    _labelWeightsBuffer.bind();
+    glDisableVertexAttribArray(3);
+
+    if (hasWeight)
+    {
+        _labelWeightsBuffer.setData(sortedWeights);
+        glEnableVertexAttribArray(3);
+    }
+
+    // Bind the off-screen framebuffer
+    _labelDensityBuffer.bind();
+    glViewport(0, 0, RESOLUTION, RESOLUTION);
+
+    // Enable additive blending
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    // Bind shader and set shader uniforms
+    _shaderLabelDensityCompute.bind();
+    _shaderLabelDensityCompute.uniform1f("sigma", _sigma);
+
+    _gaussTexture.bind(0);
+    _shaderLabelDensityCompute.uniform1i("gaussSampler", 0);
+
+    Matrix3f ortho = createProjectionMatrix(_bounds);
+    _shaderLabelDensityCompute.uniformMatrix3f("projMatrix", ortho);
+
+    _shaderLabelDensityCompute.uniform1i("hasWeight", hasWeight);
+
+    const auto numberOfTextures         = static_cast<std::uint32_t>(_labelDensityTextures.size());
+    const auto numberOfTexturesPerPass  = numberOfLabelsPerPass / numberOfLabelsPerTexture;
+
+    for (std::uint32_t firstLabel = 0; firstLabel < _numberOfLabels; firstLabel += numberOfLabelsPerPass) {
+        const auto firstTexture = firstLabel / numberOfLabelsPerTexture;
+
+        // Attach the textures of the labels of this pass
+        std::vector<GLenum> drawBuffers;
+
+        for (std::uint32_t attachmentIndex = 0; attachmentIndex < numberOfTexturesPerPass; attachmentIndex++) {
+            const auto attachment = GL_COLOR_ATTACHMENT0 + attachmentIndex;
+
+            if (firstTexture + attachmentIndex < numberOfTextures) {
+                _labelDensityBuffer.setTexture(attachment, _labelDensityTextures[firstTexture + attachmentIndex]);
+                drawBuffers.push_back(attachment);
+            }
+            else {
+                glFramebufferTexture(GL_FRAMEBUFFER, attachment, 0, 0);
+                drawBuffers.push_back(GL_NONE);
+            }
+        }
+
+        glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+
+        // Each channel holds a label density, so the alpha channel is cleared too
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        const auto firstPoint   = labelOffsets[firstLabel];
+        const auto lastPoint    = labelOffsets[std::min(firstLabel + numberOfLabelsPerPass, _numberOfLabels)];
+
+        if (lastPoint == firstPoint)
+            continue;
+
+        // Point the instance attributes to the points of the labels of this pass
+        _labelPointBuffer.bind();
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<void*>(firstPoint * sizeof(Vector2f)));
+
+        if (hasWeight)
+        {
+            _labelWeightsBuffer.bind();
+            glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 0, reinterpret_cast<void*>(firstPoint * sizeof(float)));
+        }
+
+        _labelBuffer.bind();
+        glVertexAttribIPointer(4, 1, GL_UNSIGNED_INT, 0, reinterpret_cast<void*>(firstPoint * sizeof(std::uint32_t)));
+
+        _shaderLabelDensityCompute.uniform1i("firstLabel", static_cast<int>(firstLabel));
+
+        // Draw the splats
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, lastPoint - firstPoint);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    readLabelDensities();
+}
+
+void DensityComputation::makeCurrent()
+{
+    _offscreenSurface.setFormat(_ctx->format());
+    _offscreenSurface.setScreen(_ctx->screen());
+    _offscreenSurface.create();
+    _ctx->makeCurrent(&_offscreenSurface);
+}
+
+void DensityComputation::allocateLabelDensityTextures()
+{
+    const auto numberOfTextures = (_numberOfLabels + numberOfLabelsPerTexture - 1) / numberOfLabelsPerTexture;
+
+    if (_labelDensityTextures.size() == numberOfTextures)
+        return;
+
+    for (auto& labelDensityTexture : _labelDensityTextures)
+        labelDensityTexture.destroy();
+
+    _labelDensityTextures.clear();
+    _labelDensityTextures.resize(numberOfTextures);
+
+    for (auto& labelDensityTexture : _labelDensityTextures) {
+        labelDensityTexture.create();
+        labelDensityTexture.bind();
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, RESOLUTION, RESOLUTION, 0, GL_RGBA, GL_FLOAT, nullptr);
+    }
+}
+
+void DensityComputation::readLabelDensities()
+{
+    const auto numberOfPixels = static_cast<std::size_t>(RESOLUTION) * RESOLUTION;
+
+    _labelDensityMaps.assign(_numberOfLabels, std::vector<float>(numberOfPixels, 0.0f));
+    _maxLabelDensities.assign(_numberOfLabels, 0.0f);
+
+    std::vector<float> pixels(numberOfPixels * numberOfLabelsPerTexture);
+
+    for (std::uint32_t textureIndex = 0; textureIndex < _labelDensityTextures.size(); textureIndex++) {
+        _labelDensityTextures[textureIndex].bind();
+
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_FLOAT, pixels.data());
+
+        // De-interleave the channels into the density maps of the labels
+        for (std::uint32_t channel = 0; channel < numberOfLabelsPerTexture; channel++) {
+            const auto labelIndex = textureIndex * numberOfLabelsPerTexture + channel;
+
+            if (labelIndex >= _numberOfLabels)
+                break;
+
+            auto& labelDensityMap = _labelDensityMaps[labelIndex];
+
+            for (std::size_t pixelIndex = 0; pixelIndex < numberOfPixels; pixelIndex++)
+                labelDensityMap[pixelIndex] = pixels[pixelIndex * numberOfLabelsPerTexture + channel];
+
+            _maxLabelDensities[labelIndex] = *std::max_element(labelDensityMap.begin(), labelDensityMap.end());
+        }
+    }
+}
+
 bool DensityComputation::hasData() const
 {
     return _points != nullptr && _points->size() > 0;
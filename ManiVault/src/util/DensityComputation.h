@@ -14,6 +14,9 @@
 
 #include <QOffscreenSurface>
 
+#include <cstdint>
+#include <vector>
+
 namespace mv
 {
 
@@ -23,8 +26,24 @@ public:
     void generate();
 };
 
+/**
+ * Density computation class
+ *
+ * Computes the kernel density estimate of two-dimensional points by splatting a Gaussian per point into an
+ * off-screen texture.
+ *
+ * Besides the density of all points, the densities of labeled points (e.g. per cluster) can be computed in
+ * batches: the points are sorted by label once and each pass splats the points of up to
+ * DensityComputation::numberOfLabelsPerPass labels, into one color channel per label of multiple render targets.
+ * The cost therefore scales with the number of points rather than with the number of points times labels.
+ */
 class CORE_EXPORT DensityComputation : protected QOpenGLFunctions_3_3_Core
 {
+public:
+
+    static constexpr std::uint32_t numberOfLabelsPerTexture = 4;                                    /** One label per color channel */
+    static constexpr std::uint32_t numberOfLabelsPerPass    = 8 * numberOfLabelsPerTexture;         /** Labels of eight render targets per pass */
+
 public:
     DensityComputation();
     ~DensityComputation() override;
@@ -43,10 +62,71 @@ public:
 
     void compute();
 
+    /**
+     * Get the width and height of the density textures
+     * @return Resolution in pixels
+     */
+    unsigned int getResolution() const { return RESOLUTION; }
+
+public: // Label densities
+
+    /**
+     * Set the label of each point for the computation of the per-label densities (see computeLabelDensities())
+     * Note: does not take the ownership of the vector specified by the argument
+     * @param labels Pointer to the label (e.g. cluster index) per point, points with a label of \p numberOfLabels or higher are not splatted
+     * @param numberOfLabels Number of labels
+     */
+    void setLabels(const std::vector<std::uint32_t>* labels, std::uint32_t numberOfLabels);
+
+    /** Compute the densities of all labels (in batches of DensityComputation::numberOfLabelsPerPass labels) */
+    void computeLabelDensities();
+
+    /**
+     * Get the number of labels whose densities are computed
+     * @return Number of labels
+     */
+    std::uint32_t getNumberOfLabels() const { return _numberOfLabels; }
+
+    /**
+     * Get the texture which contains the density of \p labelIndex in channel DensityComputation::getLabelDensityChannel()
+     * @param labelIndex Index of the label
+     * @return Density texture (RGBA, one label per channel)
+     */
+    Texture2D& getLabelDensityTexture(std::uint32_t labelIndex) { return _labelDensityTextures[labelIndex / numberOfLabelsPerTexture]; }
+
+    /**
+     * Get the color channel of the density texture of \p labelIndex
+     * @param labelIndex Index of the label
+     * @return Color channel (0: red, 1: green, 2: blue, 3: alpha)
+     */
+    static std::uint32_t getLabelDensityChannel(std::uint32_t labelIndex) { return labelIndex % numberOfLabelsPerTexture; }
+
+    /**
+     * Get the density map of \p labelIndex
+     * @param labelIndex Index of the label
+     * @return Row-major density map with getResolution() x getResolution() values
+     */
+    const std::vector<float>& getLabelDensityMap(std::uint32_t labelIndex) const { return _labelDensityMaps[labelIndex]; }
+
+    /**
+     * Get the maximum density of each label
+     * @return Maximum density per label
+     */
+    const std::vector<float>& getMaxLabelDensities() const { return _maxLabelDensities; }
+
 private:
     bool hasData() const;
     float calculateMaxKDE();
 
+    /** Bind the OpenGL context to an off-screen surface to draw on */
+    void makeCurrent();
+
+    /** (Re)allocate the label density textures for the number of labels */
+    void allocateLabelDensityTextures();
+
+    /** Read back the label density textures and compute the maximum density per label */
+    void readLabelDensities();
+
 private:
     const unsigned int RESOLUTION       = 128;
     const float DEFAULT_SIGMA           = 0.15f;
@@ -71,6 +151,18 @@ private:
     QOffscreenSurface _offscreenSurface;
 
     bool _initialized;
+
+    ShaderProgram                       _shaderLabelDensityCompute;     /** Splats the points of a batch of labels */
+    Framebuffer                         _labelDensityBuffer;            /** Off-screen framebuffer of the label densities */
+    std::vector<Texture2D>              _labelDensityTextures;          /** Label densities, one label per color channel */
+    GLuint                              _labelsVao;                     /** Quad and instance attributes sorted by label */
+    BufferObject                        _labelPointBuffer;              /** Positions of the points sorted by label */
+    BufferObject                        _labelWeightsBuffer;            /** Weights of the points sorted by label */
+    BufferObject                        _labelBuffer;                   /** Labels of the points sorted by label */
+    const std::vector<std::uint32_t>*   _labels;                        /** Label per point (not owned) */
+    std::uint32_t                       _numberOfLabels;                /** Number of labels */
+    std::vector<std::vector<float>>     _labelDensityMaps;              /** Read back density map per label */
+    std::vector<float>                  _maxLabelDensities;             /** Maximum density per label */
 };
 
 } // namespace mv
@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "DerivedDataCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
+namespace mv::util {
+
+namespace
+{
+    /** Identifies cached artefact files */
+    constexpr quint32 artefactMagic = 0x4D564443;
+
+    /** Version of the artefact file format (magic, version, data size, data checksum and data) */
+    constexpr quint32 artefactVersion = 2;
+
+    /** Extension of cached artefact files */
+    const QString artefactExtension = "mvdc";
+
+    /** Global cache state */
+    struct DerivedDataCacheState
+    {
+        std::mutex      _mutex;                                                 /** Guards the cache directory */
+        bool            _enabled        = true;                                 /** Whether the cache is enabled */
+        QString         _directory;                                             /** Cache directory (default location when empty) */
+        std::uint64_t   _maximumSize    = DerivedDataCache::defaultMaximumSize; /** Maximum size of the cache in bytes */
+    };
+
+    /**
+     * Get the global cache state (intentionally leaked, artefacts may be stored during static destruction)
+     * @return Cache state
+     */
+    DerivedDataCacheState& getDerivedDataCacheState()
+    {
+        static auto* derivedDataCacheState = new DerivedDataCacheState();
+
+        return *derivedDataCacheState;
+    }
+
+    /**
+     * Get the cache directory (the state mutex must be locked)
+     * @param state Cache state
+     * @return Cache directory
+     */
+    QString getCacheDirectory(const DerivedDataCacheState& state)
+    {
+        if (!state._directory.isEmpty())
+            return state._directory;
+
+        return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath("DerivedData");
+    }
+
+    /**
+     * Get the path of the artefact file with \p key (the state mutex must be locked)
+     * @param state Cache state
+     * @param key Cache key
+     * @return Artefact file path
+     */
+    QString getArtefactFilePath(const DerivedDataCacheState& state, const QString& key)
+    {
+        return QDir(getCacheDirectory(state)).filePath(QString("%1.%2").arg(key, artefactExtension));
+    }
+
+    /**
+     * Get the artefact files, the least recently used first (the state mutex must be locked)
+     * @param state Cache state
+     * @return Artefact files
+     */
+    QFileInfoList getArtefactFiles(const DerivedDataCacheState& state)
+    {
+        return QDir(getCacheDirectory(state)).entryInfoList({ QString("*.%1").arg(artefactExtension) }, QDir::Files, QDir::Time | QDir::Reversed);
+    }
+
+    /**
+     * Hash a block of \p numberOfBytes bytes at \p data
+     * @param data Pointer to the block
+     * @param numberOfBytes Number of bytes in the block
+     * @return 64-bit block hash
+     */
+    std::uint64_t hashBlock(const unsigned char* data, std::size_t numberOfBytes)
+    {
+        constexpr std::uint64_t multiplier1 = 0x9E3779B185EBCA87ull;
+        constexpr std::uint64_t multiplier2 = 0xC2B2AE3D27D4EB4Full;
+
+        std::uint64_t hash = multiplier1 ^ numberOfBytes;
+
+        const auto mix = [&hash](std::uint64_t word) -> void {
+            word *= multiplier2;
+            word = (word << 31) | (word >> 33);
+            word *= multiplier1;
+
+            hash ^= word;
+            hash = ((hash << 27) | (hash >> 37)) * multiplier1 + 0x52DCE729;
+        };
+
+        const auto numberOfWords = numberOfBytes / sizeof(std::uint64_t);
+
+        for (std::size_t wordIndex = 0; wordIndex < numberOfWords; ++wordIndex) {
+            std::uint64_t word;
+
+            std::memcpy(&word, data + wordIndex * sizeof(std::uint64_t), sizeof(std::uint64_t));
+
+            mix(word);
+        }
+
+        const auto numberOfRemainingBytes = numberOfBytes % sizeof(std::uint64_t);
+
+        if (numberOfRemainingBytes > 0) {
+            std::uint64_t word = 0;
+
+            std::memcpy(&word, data + numberOfWords * sizeof(std::uint64_t), numberOfRemainingBytes);
+
+            mix(word);
+        }
+
+        // Final avalanche
+        hash ^= hash >> 33;
+        hash *= multiplier2;
+        hash ^= hash >> 29;
+
+        return hash;
+    }
+
+    /**
+     * Load the artefact with \p key, and optionally require it to be \p expectedSize bytes
+     * @param key Cache key
+     * @param data Artefact data (output)
+     * @param expectedSize Expected size of the artefact data in bytes (any size when empty)
+     * @return Boolean determining whether the artefact was found (and is intact and of the expected size)
+     */
+    bool loadArtefact(const QString& key, QByteArray& data, std::optional<std::uint64_t> expectedSize)
+    {
+        auto& state = getDerivedDataCacheState();
+
+        std::lock_guard<std::mutex> lock(state._mutex);
+
+        if (!state._enabled)
+            return false;
+
+        QFile artefactFile(getArtefactFilePath(state, key));
+
+        if (!artefactFile.exists() || !artefactFile.open(QIODevice::ReadOnly))
+            return false;
+
+        QDataStream artefactDataStream(&artefactFile);
+
+        quint32 magic = 0, version = 0;
+
+        artefactDataStream >> magic >> version;
+
+        if (magic != artefactMagic || version != artefactVersion)
+            return false;
+
+        quint64 size = 0, checksum = 0;
+
+        artefactDataStream >> size >> checksum >> data;
+
+        // Truncated or otherwise corrupted artefacts are detected by their size and checksum
+        const auto isIntact = artefactDataStream.status() == QDataStream::Ok
+            && static_cast<quint64>(data.size()) == size
+            && hashBlock(reinterpret_cast<const unsigned char*>(data.constData()), static_cast<std::size_t>(data.size())) == checksum;
+
+        if (!isIntact || (expectedSize.has_value() && size != *expectedSize)) {
+            if (isIntact)
+                qWarning() << "Derived data artefact" << key << "has" << size << "bytes instead of the expected" << *expectedSize << ", it is removed from the cache";
+            else
+                qWarning() << "Derived data artefact" << key << "is corrupt, it is removed from the cache";
+
+            data.clear();
+
+            artefactFile.close();
+            artefactFile.remove();
+
+            return false;
+        }
+
+        // Mark the artefact as recently used
+        artefactFile.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+        return true;
+    }
+}
+
+QByteArray DerivedDataCache::computeContentHash(const void* data, std::size_t numberOfBytes)
+{
+    const auto bytes            = static_cast<const unsigned char*>(data);
+    const auto numberOfBlocks   = (numberOfBytes + contentHashBlockSize - 1) / contentHashBlockSize;
+
+    std::vector<std::uint64_t> blockHashes(numberOfBlocks);
+    std::vector<std::size_t> blockIndices(numberOfBlocks);
+
+    std::iota(blockIndices.begin(), blockIndices.end(), 0);
+
+    const auto computeBlockHash = [bytes, numberOfBytes, &blockHashes](std::size_t blockIndex) -> void {
+        const auto offset = blockIndex * contentHashBlockSize;
+
+        blockHashes[blockIndex] = hashBlock(bytes + offset, std::min(contentHashBlockSize, numberOfBytes - offset));
+    };
+
+#ifndef __APPLE__
+    std::for_each(std::execution::par, blockIndices.begin(), blockIndices.end(), computeBlockHash);
+#else
+    std::for_each(blockIndices.begin(), blockIndices.end(), computeBlockHash);
+#endif
+
+    // Combine the block hashes (and the size) with a cryptographic hash, so that the content hash is robust (equal block hashes are assumed to mean equal blocks)
+    QCryptographicHash contentHash(QCryptographicHash::Sha256);
+
+    const auto size = static_cast<std::uint64_t>(numberOfBytes);
+
+    contentHash.addData(QByteArrayView(reinterpret_cast<const char*>(&size), sizeof(size)));
+    contentHash.addData(QByteArrayView(reinterpret_cast<const char*>(blockHashes.data()), static_cast<qsizetype>(blockHashes.size() * sizeof(std::uint64_t))));
+
+    return contentHash.result();
+}
+
+QString DerivedDataCache::createKey(const QString& producer, const QVariantMap& parameters, const QByteArray& inputHash)
+{
+    QByteArray serializedParameters;
+
+    // Variant maps are ordered by key, so equal parameters serialize to equal bytes
+    QDataStream parametersDataStream(&serializedParameters, QIODevice::WriteOnly);
+
+    parametersDataStream << parameters;
+
+    QCryptographicHash key(QCryptographicHash::Sha256);
+
+    key.addData(producer.toUtf8());
+    key.addData(serializedParameters);
+    key.addData(inputHash);
+
+    return QString::fromLatin1(key.result().toHex());
+}
+
+bool DerivedDataCache::load(const QString& key, QByteArray& data)
+{
+    return loadArtefact(key, data, std::nullopt);
+}
+
+bool DerivedDataCache::load(const QString& key, QByteArray& data, std::uint64_t expectedSize)
+{
+    return loadArtefact(key, data, expectedSize);
+}
+
+bool DerivedDataCache::store(const QString& key, const QByteArray& data)
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    if (!state._enabled || static_cast<std::uint64_t>(data.size()) > state._maximumSize)
+        return false;
+
+    if (!QDir().mkpath(getCacheDirectory(state)))
+        return false;
+
+    // Written to a temporary file first, so a cached artefact is never partially written
+    QSaveFile artefactFile(getArtefactFilePath(state, key));
+
+    if (!artefactFile.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream artefactDataStream(&artefactFile);
+
+    const auto size     = static_cast<quint64>(data.size());
+    const auto checksum = static_cast<quint64>(hashBlock(reinterpret_cast<const unsigned char*>(data.constData()), static_cast<std::size_t>(data.size())));
+
+    artefactDataStream << artefactMagic << artefactVersion << size << checksum << data;
+
+    if (artefactDataStream.status() != QDataStream::Ok || !artefactFile.commit()) {
+        qWarning() << "Unable to store derived data artefact" << key;
+        return false;
+    }
+
+    // Remove the least recently used artefacts until the cache fits
+    const auto artefactFiles = getArtefactFiles(state);
+
+    auto size = std::accumulate(artefactFiles.begin(), artefactFiles.end(), std::uint64_t{ 0 }, [](std::uint64_t sum, const QFileInfo& artefactFileInfo) -> std::uint64_t {
+        return sum + static_cast<std::uint64_t>(artefactFileInfo.size());
+    });
+
+    for (const auto& artefactFileInfo : artefactFiles) {
+        if (size <= state._maximumSize)
+            break;
+
+        if (artefactFileInfo.completeBaseName() == key)
+            continue;
+
+        if (QFile::remove(artefactFileInfo.absoluteFilePath()))
+            size -= static_cast<std::uint64_t>(artefactFileInfo.size());
+    }
+
+    return true;
+}
+
+void DerivedDataCache::remove(const QString& key)
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    QFile::remove(getArtefactFilePath(state, key));
+}
+
+void DerivedDataCache::clear()
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    for (const auto& artefactFileInfo : getArtefactFiles(state))
+        QFile::remove(artefactFileInfo.absoluteFilePath());
+}
+
+bool DerivedDataCache::isEnabled()
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return state._enabled;
+}
+
+void DerivedDataCache::setEnabled(bool enabled)
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    state._enabled = enabled;
+}
+
+QString DerivedDataCache::getDirectory()
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return getCacheDirectory(state);
+}
+
+void DerivedDataCache::setDirectory(const QString& directory)
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    state._directory = directory;
+}
+
+std::uint64_t DerivedDataCache::getMaximumSize()
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return state._maximumSize;
+}
+
+void DerivedDataCache::setMaximumSize(std::uint64_t maximumSize)
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    state._maximumSize = maximumSize;
+}
+
+std::uint64_t DerivedDataCache::getSize()
+{
+    auto& state = getDerivedDataCacheState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    std::uint64_t size = 0;
+
+    for (const auto& artefactFileInfo : getArtefactFiles(state))
+        size += static_cast<std::uint64_t>(artefactFileInfo.size());
+
+    return size;
+}
+
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVariantMap>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mv::util {
+
+/**
+ * Derived data cache class
+ *
+ * Thread-safe, content-addressed cache of derived data (e.g. dimension statistics) in a local cache directory, so
+ * that expensive computations do not have to be repeated when a project is reopened or when a computation is rerun
+ * with identical parameters.
+ *
+ * An artefact is stored under a key which is created from the name of its producer, the parameters of the
+ * computation and the content hash of its input (see DerivedDataCache::createKey()), so a cached artefact can never
+ * be out of date: when the input changes, its content hash (and thus the key) changes too. Consumers look up the key
+ * before computing and store the result afterwards. When the cache exceeds its maximum size, the least recently used
+ * artefacts are removed.
+ *
+ * Content hashes are addresses, not proofs of equality: blocks are hashed with a fast 64-bit non-cryptographic hash
+ * and only the block hashes (and the size) are combined with SHA-256. Two inputs which differ in a block whose 64-bit
+ * hashes collide (a chance of about 2^-64 per differing block) therefore share a key, this is accepted in exchange
+ * for hashing at memory bandwidth. Artefacts themselves are stored with their size and a checksum, so that truncated
+ * or corrupted artefacts are rejected (and removed) on load, and consumers can additionally require the size they
+ * expect (e.g. derived from the dimensions of the input).
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT DerivedDataCache
+{
+public:
+
+    /** Number of bytes which are hashed per block (the blocks are hashed in parallel) */
+    static constexpr std::size_t contentHashBlockSize = 1 << 20;
+
+    /** Default maximum size of the cache */
+    static constexpr std::uint64_t defaultMaximumSize = 2ull << 30;
+
+public:
+
+    /**
+     * Compute the content hash of \p numberOfBytes bytes at \p data (in parallel, see the class description for the collision assumption)
+     * @param data Pointer to the data
+     * @param numberOfBytes Number of bytes
+     * @return Content hash
+     */
+    static QByteArray computeContentHash(const void* data, std::size_t numberOfBytes);
+
+    /**
+     * Create the cache key for an artefact of \p producer computed with \p parameters from input with \p inputHash
+     * @param producer Name of the producer (e.g. the class which computes the artefact)
+     * @param parameters Parameters of the computation
+     * @param inputHash Content hash of the input
+     * @return Cache key
+     */
+    static QString createKey(const QString& producer, const QVariantMap& parameters, const QByteArray& inputHash);
+
+    /**
+     * Load the artefact with \p key
+     * @param key Cache key
+     * @param data Artefact data (output)
+     * @return Boolean determining whether the artefact was found (and is intact)
+     */
+    static bool load(const QString& key, QByteArray& data);
+
+    /**
+     * Load the artefact with \p key and require it to be \p expectedSize bytes (artefacts of another size are removed)
+     * @param key Cache key
+     * @param data Artefact data (output)
+     * @param expectedSize Expected size of the artefact data in bytes
+     * @return Boolean determining whether the artefact was found (and is intact and of the expected size)
+     */
+    static bool load(const QString& key, QByteArray& data, std::uint64_t expectedSize);
+
+    /**
+     * Store \p data under \p key
+     * @param key Cache key
+     * @param data Artefact data
+     * @return Boolean determining whether the artefact was stored
+     */
+    static bool store(const QString& key, const QByteArray& data);
+
+    /**
+     * Remove the artefact with \p key
+     * @param key Cache key
+     */
+    static void remove(const QString& key);
+
+    /** Remove all artefacts */
+    static void clear();
+
+    /**
+     * Get whether the cache is enabled
+     * @return Boolean determining whether the cache is enabled
+     */
+    static bool isEnabled();
+
+    /**
+     * Set whether the cache is enabled (when disabled, artefacts are neither loaded nor stored)
+     * @param enabled Boolean determining whether the cache is enabled
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Get the cache directory
+     * @return Cache directory
+     */
+    static QString getDirectory();
+
+    /**
+     * Set the cache directory to \p directory
+     * @param directory Cache directory
+     */
+    static void setDirectory(const QString& directory);
+
+    /**
+     * Get the maximum size of the cache
+     * @return Maximum size in bytes
+     */
+    static std::uint64_t getMaximumSize();
+
+    /**
+     * Set the maximum size of the cache to \p maximumSize (the least recently used artefacts are removed when exceeded)
+     * @param maximumSize Maximum size in bytes
+     */
+    static void setMaximumSize(std::uint64_t maximumSize);
+
+    /**
+     * Get the size of the cache
+     * @return Size of all cached artefacts in bytes
+     */
+    static std::uint64_t getSize();
+};
+
+}
@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "DualHistogram.h"
+
+namespace mv::util {
+
+DualHistogram::DualHistogram(std::uint32_t numberOfBins /*= 0*/, float minimum /*= 0.0f*/, float maximum /*= 1.0f*/) :
+    _all(numberOfBins, minimum, maximum),
+    _selected(numberOfBins, minimum, maximum)
+{
+}
+
+const Histogram& DualHistogram::getAll() const
+{
+    return _all;
+}
+
+const Histogram& DualHistogram::getSelected() const
+{
+    return _selected;
+}
+
+}
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "Histogram.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace mv::util {
+
+/**
+ * Dual histogram class
+ *
+ * Histogram of all values together with the histogram of the selected values (with the same bins), e.g. to show
+ * the distribution of the selection against the distribution of all points.
+ *
+ * When the selection changes, the histogram of the selected values is updated with the selection delta (only the
+ * values which were added to or removed from the selection are binned) unless the delta is larger than the new
+ * selection, in which case it is recomputed.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT DualHistogram
+{
+public:
+
+    using Indices = std::vector<std::uint32_t>;
+
+public:
+
+    /**
+     * Construct with \p numberOfBins over [\p minimum, \p maximum]
+     * @param numberOfBins Number of bins
+     * @param minimum Lower bound of the range
+     * @param maximum Upper bound of the range
+     */
+    DualHistogram(std::uint32_t numberOfBins = 0, float minimum = 0.0f, float maximum = 1.0f);
+
+    /**
+     * Get the histogram of all values
+     * @return Histogram of all values
+     */
+    const Histogram& getAll() const;
+
+    /**
+     * Get the histogram of the selected values
+     * @return Histogram of the selected values
+     */
+    const Histogram& getSelected() const;
+
+    /**
+     * Compute the histogram of all \p numberOfValues values and of the selected values (in parallel)
+     * @param numberOfValues Number of values
+     * @param selectionIndices Indices of the selected values
+     * @param valueFunction Returns the value at an index in [0, \p numberOfValues), invoked concurrently
+     */
+    template <typename ValueFunction>
+    void compute(const std::size_t numberOfValues, const Indices& selectionIndices, const ValueFunction& valueFunction)
+    {
+        _all.clear();
+        _all.addValues(numberOfValues, valueFunction);
+
+        setSelection(selectionIndices, valueFunction);
+    }
+
+    /**
+     * Recompute the histogram of the selected values (in parallel)
+     * @param selectionIndices Indices of the selected values
+     * @param valueFunction Returns the value at an index, invoked concurrently
+     */
+    template <typename ValueFunction>
+    void setSelection(const Indices& selectionIndices, const ValueFunction& valueFunction)
+    {
+        _selected.clear();
+        _selected.addValues(selectionIndices.size(), [&selectionIndices, &valueFunction](const std::size_t index) -> float {
+            return static_cast<float>(valueFunction(selectionIndices[index]));
+        });
+    }
+
+    /**
+     * Update the histogram of the selected values from \p previousSelectionIndices to \p selectionIndices
+     * @param previousSelectionIndices Sorted indices of the previously selected values (from which the histogram of the selected values was computed)
+     * @param selectionIndices Sorted indices of the selected values
+     * @param valueFunction Returns the value at an index
+     */
+    template <typename ValueFunction>
+    void updateSelection(const Indices& previousSelectionIndices, const Indices& selectionIndices, const ValueFunction& valueFunction)
+    {
+        Indices addedIndices, removedIndices;
+
+        std::set_difference(selectionIndices.begin(), selectionIndices.end(), previousSelectionIndices.begin(), previousSelectionIndices.end(), std::back_inserter(addedIndices));
+        std::set_difference(previousSelectionIndices.begin(), previousSelectionIndices.end(), selectionIndices.begin(), selectionIndices.end(), std::back_inserter(removedIndices));
+
+        // Recomputing (in parallel) is cheaper than applying a large delta
+        if (addedIndices.size() + removedIndices.size() > selectionIndices.size()) {
+            setSelection(selectionIndices, valueFunction);
+            return;
+        }
+
+        for (const auto addedIndex : addedIndices)
+            _selected.add(static_cast<float>(valueFunction(addedIndex)));
+
+        for (const auto removedIndex : removedIndices)
+            _selected.remove(static_cast<float>(valueFunction(removedIndex)));
+    }
+
+private:
+    Histogram   _all;           /** Histogram of all values */
+    Histogram   _selected;      /** Histogram of the selected values */
+};
+
+}
@@ -4,6 +4,22 @@
 
 #include "Exception.h"
 
+#include <atomic>
+
 namespace mv::util {
 
+namespace {
+    std::atomic<bool> exceptionMessageBoxesEnabled = true;
+}
+
+void setExceptionMessageBoxesEnabled(bool enabled)
+{
+    exceptionMessageBoxesEnabled.store(enabled);
+}
+
+bool areExceptionMessageBoxesEnabled()
+{
+    return exceptionMessageBoxesEnabled.load();
+}
+
 }
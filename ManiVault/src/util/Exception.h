@@ -13,6 +13,18 @@
 
 namespace mv::util {
 
+/**
+ * Set whether exceptions are reported in a (modal) message box, in headless mode nobody is there to dismiss it
+ * @param enabled Boolean determining whether message boxes are shown (exceptions are always logged)
+ */
+CORE_EXPORT void setExceptionMessageBoxesEnabled(bool enabled);
+
+/**
+ * Get whether exceptions are reported in a message box
+ * @return Boolean determining whether message boxes are shown
+ */
+CORE_EXPORT bool areExceptionMessageBoxesEnabled();
+
 /**
  * Create an exception message box using a title and reason
  * @param title Message box title
@@ -21,7 +33,8 @@ namespace mv::util {
  */
 CORE_EXPORT inline void exceptionMessageBox(const QString& title, const QString& reason, QWidget* parent = nullptr)
 {
-    QMessageBox::critical(parent, title, reason);
+    if (areExceptionMessageBoxesEnabled())
+        QMessageBox::critical(parent, title, reason);
 
     qDebug() << title << reason;
 }
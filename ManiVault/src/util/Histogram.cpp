@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "Histogram.h"
+
+#include <numeric>
+#include <thread>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
+
+namespace mv::util {
+
+Histogram::Histogram(std::uint32_t numberOfBins /*= 0*/, float minimum /*= 0.0f*/, float maximum /*= 1.0f*/) :
+    _numberOfBins(numberOfBins),
+    _minimum(minimum),
+    _maximum(maximum),
+    _scale(maximum > minimum ? static_cast<float>(numberOfBins) / (maximum - minimum) : 0.0f),
+    _bins(numberOfBins, 0)
+{
+}
+
+std::uint32_t Histogram::getNumberOfBins() const
+{
+    return _numberOfBins;
+}
+
+float Histogram::getMinimum() const
+{
+    return _minimum;
+}
+
+float Histogram::getMaximum() const
+{
+    return _maximum;
+}
+
+const Histogram::Bins& Histogram::getBins() const
+{
+    return _bins;
+}
+
+void Histogram::clear()
+{
+    _bins.fill(0);
+}
+
+void Histogram::add(float value)
+{
+    if (_numberOfBins == 0)
+        return;
+
+    const auto binIndex = getBinIndex(value);
+
+    if (binIndex < _numberOfBins)
+        ++_bins[binIndex];
+}
+
+void Histogram::remove(float value)
+{
+    if (_numberOfBins == 0)
+        return;
+
+    const auto binIndex = getBinIndex(value);
+
+    if (binIndex < _numberOfBins && _bins[binIndex] > 0)
+        --_bins[binIndex];
+}
+
+std::size_t Histogram::getNumberOfPartitions(std::size_t numberOfValues)
+{
+    const auto numberOfThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    return std::clamp<std::size_t>(numberOfValues / minimumNumberOfValuesPerPartition, 1, numberOfThreads);
+}
+
+void Histogram::forEachPartition(std::size_t numberOfPartitions, const std::function<void(std::size_t)>& function)
+{
+    std::vector<std::size_t> partitionIndices(numberOfPartitions);
+
+    std::iota(partitionIndices.begin(), partitionIndices.end(), 0);
+
+#ifndef __APPLE__
+    std::for_each(std::execution::par, partitionIndices.begin(), partitionIndices.end(), function);
+#else
+    std::for_each(partitionIndices.begin(), partitionIndices.end(), function);
+#endif
+}
+
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QVector>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mv::util {
+
+/**
+ * Histogram class
+ *
+ * One-dimensional histogram with a fixed number of equally wide bins over [minimum, maximum]. Values outside the
+ * range (and NaN) are not counted, the maximum itself is counted in the last bin.
+ *
+ * Values are binned in parallel: each partition of the values is binned into its own counts, which are summed
+ * afterwards. Within a partition the bin indices of a block of values are computed in a separate, branch-free
+ * loop (which the compiler vectorizes) before the counts are incremented.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT Histogram
+{
+public:
+
+    using Bins = QVector<std::uint32_t>;
+
+    static constexpr std::size_t numberOfValuesPerBlock             = 256;      /** Number of values whose bin indices are computed together */
+    static constexpr std::size_t minimumNumberOfValuesPerPartition  = 65536;    /** Minimum number of values per worker */
+
+public:
+
+    /**
+     * Construct with \p numberOfBins over [\p minimum, \p maximum]
+     * @param numberOfBins Number of bins
+     * @param minimum Lower bound of the range
+     * @param maximum Upper bound of the range
+     */
+    Histogram(std::uint32_t numberOfBins = 0, float minimum = 0.0f, float maximum = 1.0f);
+
+    /**
+     * Get the number of bins
+     * @return Number of bins
+     */
+    std::uint32_t getNumberOfBins() const;
+
+    /**
+     * Get the lower bound of the range
+     * @return Lower bound
+     */
+    float getMinimum() const;
+
+    /**
+     * Get the upper bound of the range
+     * @return Upper bound
+     */
+    float getMaximum() const;
+
+    /**
+     * Get the bin counts
+     * @return Bin counts
+     */
+    const Bins& getBins() const;
+
+    /** Reset all bin counts to zero */
+    void clear();
+
+    /**
+     * Get the index of the bin of \p value
+     * @param value Value
+     * @return Bin index, the number of bins when \p value is outside the range (or NaN)
+     */
+    std::uint32_t getBinIndex(float value) const {
+        const auto isInRange    = value >= _minimum && value <= _maximum;
+        const auto binIndex     = std::min(static_cast<std::uint32_t>(isInRange ? (value - _minimum) * _scale : 0.0f), _numberOfBins - 1);
+
+        return isInRange ? binIndex : _numberOfBins;
+    }
+
+    /**
+     * Count \p value
+     * @param value Value
+     */
+    void add(float value);
+
+    /**
+     * Uncount \p value (which must have been counted before)
+     * @param value Value
+     */
+    void remove(float value);
+
+    /**
+     * Count \p numberOfValues values (in parallel)
+     * @param numberOfValues Number of values
+     * @param valueFunction Returns the value at an index in [0, \p numberOfValues), invoked concurrently
+     */
+    template <typename ValueFunction>
+    void addValues(const std::size_t numberOfValues, const ValueFunction valueFunction)
+    {
+        if (_numberOfBins == 0)
+            return;
+
+        const auto numberOfPartitions = getNumberOfPartitions(numberOfValues);
+
+        // Counts per partition, with an extra bin for values outside the range
+        std::vector<std::vector<std::uint32_t>> partitionCounts(numberOfPartitions, std::vector<std::uint32_t>(_numberOfBins + 1, 0));
+
+        forEachPartition(numberOfPartitions, [&](const std::size_t partitionIndex) -> void {
+            const auto firstIndex   = numberOfValues * partitionIndex / numberOfPartitions;
+            const auto lastIndex    = numberOfValues * (partitionIndex + 1) / numberOfPartitions;
+
+            auto& counts = partitionCounts[partitionIndex];
+
+            std::array<float, numberOfValuesPerBlock>           values;
+            std::array<std::uint32_t, numberOfValuesPerBlock>   binIndices;
+
+            for (auto firstBlockIndex = firstIndex; firstBlockIndex < lastIndex; firstBlockIndex += numberOfValuesPerBlock) {
+                const auto numberOfBlockValues = std::min(numberOfValuesPerBlock, lastIndex - firstBlockIndex);
+
+                for (std::size_t blockIndex = 0; blockIndex < numberOfBlockValues; ++blockIndex)
+                    values[blockIndex] = static_cast<float>(valueFunction(firstBlockIndex + blockIndex));
+
+                for (std::size_t blockIndex = 0; blockIndex < numberOfBlockValues; ++blockIndex)
+                    binIndices[blockIndex] = getBinIndex(values[blockIndex]);
+
+                for (std::size_t blockIndex = 0; blockIndex < numberOfBlockValues; ++blockIndex)
+                    ++counts[binIndices[blockIndex]];
+            }
+        });
+
+        for (const auto& counts : partitionCounts)
+            for (std::uint32_t binIndex = 0; binIndex < _numberOfBins; ++binIndex)
+                _bins[binIndex] += counts[binIndex];
+    }
+
+private:
+
+    /**
+     * Get the number of partitions (workers) for \p numberOfValues
+     * @param numberOfValues Number of values
+     * @return Number of partitions (at least one)
+     */
+    static std::size_t getNumberOfPartitions(std::size_t numberOfValues);
+
+    /**
+     * Invoke \p function for each partition in parallel
+     * @param numberOfPartitions Number of partitions
+     * @param function Function which is invoked with the partition index
+     */
+    static void forEachPartition(std::size_t numberOfPartitions, const std::function<void(std::size_t)>& function);
+
+private:
+    std::uint32_t   _numberOfBins;  /** Number of bins */
+    float           _minimum;       /** Lower bound of the range */
+    float           _maximum;       /** Upper bound of the range */
+    float           _scale;         /** Number of bins per unit */
+    Bins            _bins;          /** Bin counts */
+};
+
+}
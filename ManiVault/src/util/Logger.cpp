@@ -6,6 +6,7 @@
 #include "Logger.h"
 
 #include "Application.h"
+#include "MpscRingBuffer.h"
 
 // Qt header files:
 #include <QByteArray>
@@ -18,11 +19,13 @@
 #include <QtGlobal> // For qInstallMessageHandler
 
 // Standard C++ header files:
+#include <algorithm>
 #include <atomic>
-#include <cassert>
+#include <chrono>
 #include <cstdint> // For uint8_t.
 #include <deque>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <typeinfo>
 
@@ -189,13 +192,19 @@ namespace
     };
 
 
+    /** Interval at which the background writer wakes up to write pending messages */
+    constexpr auto writerInterval = std::chrono::milliseconds(50);
+
+    /** Maximum time to wait for the background writer when flushing */
+    constexpr auto flushTimeout = std::chrono::seconds(5);
+
     void MessageHandler(
         const QtMsgType type,
         const QMessageLogContext& context,
         const QString& message)
     {
-        // Avoid recursion.
-        static std::atomic_bool isExecutingMessageHandler{ false };
+        // Avoid recursion (per thread, so that messages from other threads are never skipped).
+        thread_local std::atomic_bool isExecutingMessageHandler{ false };
 
         if (!isExecutingMessageHandler)
         {
@@ -203,66 +212,75 @@ namespace
 
             const SetAtomicBoolFalseAtScopeExit setAtomicBoolFalseAtScopeExit{ isExecutingMessageHandler };
 
-            static LogFile logFile;
             const auto previousMessageHandler = GetPreviousMessageHandler();
 
-            auto utf8Message = message.toUtf8();
-            ReplaceUnprintableAsciiCharsBySpaces(utf8Message);
-            const char* const utf8MessageData = utf8Message.constData();
-
             if (previousMessageHandler != nullptr)
             {
                 previousMessageHandler(type, context, message);
             }
 
-            // Get reference to application-wide logger
-            auto& logger = Application::getLogger();
-
-            // Lock the mutex from here, to grant exclusive access to 
-            // MessageRecords and log file.
-            const std::lock_guard<std::mutex> guard(logger.getMutex());
-
-            auto& messageRecords = Application::getLogger().getMessageRecords();
-
-            const auto messageNumber = messageRecords.size() + 1;
-
-            for (const auto& messageSegment : message.split("\n")) {
-                messageRecords.push_back(
-                    {
-                        messageNumber,
-                        type,
-                        context.version,
-                        context.line,
-                        context.file,
-                        context.function,
-                        context.category,
-                        messageSegment
-                    });
-
-                if (logFile)
-                {
-                    logFile.GetOutputStream()
-                        << messageNumber
-                        << separator << MakeNullPrintable(context.category, "<category>")
-                        << separator << mv::util::Logger::getMessageTypeName(type).toStdString()
-                        << separator << context.version
-                        << separator << MakeNullPrintable(context.file, "<file>")
-                        << separator << context.line
-                        << separator << MakeNullPrintable(context.function, "<function>")
-                        << separator << '"' << utf8MessageData << '"'
-                        << std::endl;
-                }
-            }
+            // Hand the message to the background writer of the application-wide logger
+            Application::getLogger().enqueueMessage(type, context, message);
         }
     }
 
+    /**
+     * Append \p messageRecord to \p fileBuffer as log file row
+     * @param fileBuffer Buffer with log file rows which are written in one batch
+     * @param messageRecord Message record to append
+     */
+    void WriteMessageRecord(std::string& fileBuffer, const mv::util::MessageRecord& messageRecord)
+    {
+        auto utf8Message = messageRecord.message.toUtf8();
+        ReplaceUnprintableAsciiCharsBySpaces(utf8Message);
+
+        fileBuffer += std::to_string(messageRecord.number);
+        fileBuffer += separator;
+        fileBuffer += MakeNullPrintable(messageRecord.category, "<category>");
+        fileBuffer += separator;
+        fileBuffer += mv::util::Logger::getMessageTypeName(messageRecord.type).toStdString();
+        fileBuffer += separator;
+        fileBuffer += std::to_string(messageRecord.version);
+        fileBuffer += separator;
+        fileBuffer += MakeNullPrintable(messageRecord.file, "<file>");
+        fileBuffer += separator;
+        fileBuffer += std::to_string(messageRecord.line);
+        fileBuffer += separator;
+        fileBuffer += MakeNullPrintable(messageRecord.function, "<function>");
+        fileBuffer += separator;
+        fileBuffer += '"';
+        fileBuffer += utf8Message.constData();
+        fileBuffer += '"';
+        fileBuffer += '\n';
+    }
+
 }   // namespace
 
 namespace mv::util {
 
+Logger::Logger() :
+    _queue(std::make_unique<MpscRingBuffer<MessageRecord>>(queueCapacity)),
+    _numberOfMessages(0),
+    _numberOfHandledMessages(0),
+    _numberOfDroppedMessages(0),
+    _stopping(false),
+    _flushRequested(false),
+    _writerMutex(),
+    _wakeWriterCondition(),
+    _messagesHandledCondition(),
+    _writerThread(),
+    _messageRecords(),
+    _firstRecordIndex(0),
+    _maximumNumberOfRecords(defaultMaximumNumberOfRecords),
+    _recordsMutex()
+{
+}
+
 Logger::~Logger()
 {
     qInstallMessageHandler(0);
+
+    stop();
 }
 
 QMap<QtMsgType, QString> Logger::messageTypeNames = {
@@ -275,12 +293,16 @@ QMap<QtMsgType, QString> Logger::messageTypeNames = {
 
 QString Logger::getMessageTypeName(const QtMsgType msgType)
 {
-    return Logger::messageTypeNames[msgType];
+    return Logger::messageTypeNames.value(msgType);
 }
 
 void Logger::initialize()
 {
     QDir{}.mkpath(GetLogDirectoryPathName());
+
+    if (!_writerThread.joinable())
+        _writerThread = std::thread(&Logger::write, this);
+
     (void)GetPreviousMessageHandler(qInstallMessageHandler(&MessageHandler));
 }
 
@@ -297,40 +319,228 @@ QString Logger::ExceptionToText(const std::exception& stdException)
         .arg(typeid(stdException).name());
 }
 
-MessageRecords& Logger::getMessageRecords()
+void Logger::enqueueMessage(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    // The writer numbers the message when it is dequeued, so that the numbers follow the order in the log file
+    MessageRecord messageRecord{
+        0,
+        type,
+        context.version,
+        context.line,
+        context.file,
+        context.function,
+        context.category,
+        message
+    };
+
+    auto pushed = _queue->tryPush(messageRecord);
+
+    // Give the writer a chance to catch up before dropping the message
+    if (!pushed) {
+        _wakeWriterCondition.notify_one();
+
+        std::this_thread::yield();
+
+        pushed = _queue->tryPush(messageRecord);
+    }
+
+    _numberOfMessages++;
+
+    if (pushed) {
+        if (_queue->getApproximateSize() >= queueCapacity / 2)
+            _wakeWriterCondition.notify_one();
+    }
+    else {
+        _numberOfDroppedMessages++;
+
+        // Update under the writer mutex, so that a concurrent flush() cannot miss the notification
+        {
+            const std::lock_guard<std::mutex> guard(_writerMutex);
+
+            _numberOfHandledMessages++;
+        }
+
+        _messagesHandledCondition.notify_all();
+    }
+
+    if (type == QtFatalMsg)
+        flush();
+}
+
+void Logger::flush()
 {
-    return _messageRecords;
+    if (!_writerThread.joinable() || std::this_thread::get_id() == _writerThread.get_id())
+        return;
+
+    const auto numberOfMessages = _numberOfMessages.load();
+
+    std::unique_lock<std::mutex> lock(_writerMutex);
+
+    _flushRequested = true;
+
+    _wakeWriterCondition.notify_one();
+
+    _messagesHandledCondition.wait_for(lock, flushTimeout, [this, numberOfMessages]() -> bool {
+        return _numberOfHandledMessages.load() >= numberOfMessages;
+    });
 }
 
-void Logger::updateMessageRecords(MessageRecordPointers& messageRecordPointers)
+void Logger::getMessageRecords(std::uint64_t& recordIndex, MessageRecords& messageRecords, std::size_t maximumNumberOfRecords) const
 {
-    // Lock the mutex from here.
-    const std::lock_guard<std::mutex> guard(getMutex());
+    const std::lock_guard<std::mutex> guard(_recordsMutex);
+
+    recordIndex = std::max(recordIndex, _firstRecordIndex);
 
-    const auto previousNumberOfMessages = messageRecordPointers.size();
-    const auto numberOfMessages = _messageRecords.size();
+    const auto endRecordIndex   = _firstRecordIndex + _messageRecords.size();
+    const auto numberOfRecords  = std::min(endRecordIndex - std::min(recordIndex, endRecordIndex), static_cast<std::uint64_t>(maximumNumberOfRecords));
+    const auto first            = _messageRecords.begin() + static_cast<std::ptrdiff_t>(recordIndex - _firstRecordIndex);
+
+    messageRecords.insert(messageRecords.end(), first, first + static_cast<std::ptrdiff_t>(numberOfRecords));
+
+    recordIndex += numberOfRecords;
+}
+
+std::uint64_t Logger::getEndRecordIndex() const
+{
+    const std::lock_guard<std::mutex> guard(_recordsMutex);
+
+    return _firstRecordIndex + _messageRecords.size();
+}
+
+std::size_t Logger::getMaximumNumberOfRecords() const
+{
+    return _maximumNumberOfRecords;
+}
+
+void Logger::setMaximumNumberOfRecords(std::size_t maximumNumberOfRecords)
+{
+    _maximumNumberOfRecords = std::max<std::size_t>(maximumNumberOfRecords, 1);
 
-    if (previousNumberOfMessages <= numberOfMessages)
+    const std::lock_guard<std::mutex> guard(_recordsMutex);
+
+    while (_messageRecords.size() > _maximumNumberOfRecords) {
+        _messageRecords.pop_front();
+        _firstRecordIndex++;
+    }
+}
+
+std::uint64_t Logger::getNumberOfDroppedMessages() const
+{
+    return _numberOfDroppedMessages;
+}
+
+void Logger::write()
+{
+    LogFile logFile;
+
+    std::string         fileBuffer;
+    MessageRecords      batch;
+    std::uint64_t       numberOfReportedDroppedMessages = 0;
+    std::size_t         messageNumber                   = 0;
+
+    while (true)
     {
-        for (auto i = 0; i < previousNumberOfMessages; ++i)
         {
-            assert(messageRecordPointers[i] == &(_messageRecords[i]));
+            std::unique_lock<std::mutex> lock(_writerMutex);
+
+            _wakeWriterCondition.wait_for(lock, writerInterval, [this]() -> bool {
+                return _stopping || _flushRequested || _queue->getApproximateSize() >= queueCapacity / 2;
+            });
+
+            _flushRequested = false;
         }
-    }
-    else
-    {
-        assert(!"The number of messages should not be less than the previous time!");
-    }
 
-    messageRecordPointers.resize(numberOfMessages);
+        const auto stopping = _stopping.load();
+
+        std::uint64_t numberOfHandledMessages = 0;
+
+        const auto addMessageRecord = [&fileBuffer, &batch](const MessageRecord& messageRecord) -> void {
+            for (const auto& messageSegment : messageRecord.message.split("\n")) {
+                auto& segmentRecord = batch.emplace_back(messageRecord);
+
+                segmentRecord.message = messageSegment;
+
+                WriteMessageRecord(fileBuffer, segmentRecord);
+            }
+        };
+
+        MessageRecord messageRecord;
+
+        while (_queue->tryPop(messageRecord)) {
+            messageRecord.number = ++messageNumber;
+
+            addMessageRecord(messageRecord);
+
+            numberOfHandledMessages++;
+        }
 
-    for (auto i = previousNumberOfMessages; i < numberOfMessages; ++i)
-        messageRecordPointers[i] = &(_messageRecords[i]);
+        const auto numberOfDroppedMessages = _numberOfDroppedMessages.load();
+
+        if (numberOfDroppedMessages > numberOfReportedDroppedMessages) {
+            addMessageRecord({
+                ++messageNumber,
+                QtWarningMsg,
+                0,
+                0,
+                nullptr,
+                nullptr,
+                nullptr,
+                QString("%1 log message(s) were dropped because messages were logged faster than they could be written").arg(numberOfDroppedMessages - numberOfReportedDroppedMessages)
+            });
+
+            numberOfReportedDroppedMessages = numberOfDroppedMessages;
+        }
+
+        if (!fileBuffer.empty()) {
+            if (logFile) {
+                logFile.GetOutputStream().write(fileBuffer.data(), static_cast<std::streamsize>(fileBuffer.size()));
+                logFile.GetOutputStream().flush();
+            }
+
+            fileBuffer.clear();
+        }
+
+        if (!batch.empty()) {
+            const std::lock_guard<std::mutex> guard(_recordsMutex);
+
+            std::move(batch.begin(), batch.end(), std::back_inserter(_messageRecords));
+
+            while (_messageRecords.size() > _maximumNumberOfRecords) {
+                _messageRecords.pop_front();
+                _firstRecordIndex++;
+            }
+
+            batch.clear();
+        }
+
+        if (numberOfHandledMessages > 0) {
+            {
+                const std::lock_guard<std::mutex> guard(_writerMutex);
+
+                _numberOfHandledMessages += numberOfHandledMessages;
+            }
+
+            _messagesHandledCondition.notify_all();
+        }
+
+        if (stopping && numberOfHandledMessages == 0)
+            break;
+    }
 }
 
-std::mutex& Logger::getMutex()
+void Logger::stop()
 {
-    return _mutex;
+    if (!_writerThread.joinable())
+        return;
+
+    {
+        const std::lock_guard<std::mutex> guard(_writerMutex);
+
+        _stopping = true;
+    }
+
+    _wakeWriterCondition.notify_one();
+    _writerThread.join();
 }
 
 QString MessageRecord::toString() const
@@ -9,10 +9,15 @@
 #include <QMap>
 #include <QString>
 
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <exception>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 namespace mv {
     class Application;
@@ -35,14 +40,23 @@ struct CORE_EXPORT MessageRecord
     QString toString() const;
 };
 
-using MessageRecordPointers = std::deque<const MessageRecord*>;
 using MessageRecords = std::deque<MessageRecord>;
 
+template<typename ValueType>
+class MpscRingBuffer;
+
 /**
  * Global application logger
  *
  * Class for recording log messages
  *
+ * The Qt message handler does not block: it enqueues the message in a lock-free ring buffer and returns. A
+ * background writer drains the buffer in batches, writes the batch to the log file (one flush per batch) and
+ * appends the records to a bounded in-memory record store (the oldest records are discarded beyond the
+ * retention limit). When the ring buffer is full, messages are dropped and counted; the writer logs how many
+ * messages were dropped. The writer numbers the messages as it dequeues them, so the message numbers follow the
+ * order in the log file. Fatal messages are flushed synchronously because the application aborts afterwards.
+ *
  * @author Niels Dekker (original design) and Thomas Kroes (re-design and refactor)
  */
 class CORE_EXPORT Logger
@@ -50,21 +64,89 @@ class CORE_EXPORT Logger
 public:
     static QMap<QtMsgType, QString> messageTypeNames;
 
+    /** Number of messages the ring buffer can hold (messages are dropped when producers outpace the writer) */
+    static constexpr std::size_t queueCapacity = 1 << 14;
+
+    /** Default maximum number of records in the in-memory record store */
+    static constexpr std::size_t defaultMaximumNumberOfRecords = 100000;
+
 public:
+    Logger();
     ~Logger();
 
     static QString getMessageTypeName(QtMsgType);
     static QString GetFilePathName();
     static QString ExceptionToText(const std::exception& stdException);
 
+    /** Install the message handler and start the background writer */
     void initialize();
-    MessageRecords& getMessageRecords();
-    void updateMessageRecords(MessageRecordPointers& messageRecordPointers);
-    std::mutex& getMutex();
+
+    /**
+     * Enqueue a message (called by the message handler, does not block)
+     * @param type Message type
+     * @param context Message context
+     * @param message Message
+     */
+    void enqueueMessage(QtMsgType type, const QMessageLogContext& context, const QString& message);
+
+    /** Wait until the background writer processed all messages enqueued so far */
+    void flush();
+
+    /**
+     * Copy the records with sequence index \p recordIndex onwards into \p messageRecords (records which have already been discarded are skipped)
+     * @param recordIndex Sequence index of the first record to copy, set to the sequence index after the last copied record
+     * @param messageRecords Message records to append to
+     * @param maximumNumberOfRecords Maximum number of records to copy
+     */
+    void getMessageRecords(std::uint64_t& recordIndex, MessageRecords& messageRecords, std::size_t maximumNumberOfRecords) const;
+
+    /**
+     * Get the sequence index after the last record in the record store
+     * @return Sequence index
+     */
+    std::uint64_t getEndRecordIndex() const;
+
+    /**
+     * Get the maximum number of records in the record store
+     * @return Maximum number of records
+     */
+    std::size_t getMaximumNumberOfRecords() const;
+
+    /**
+     * Set the maximum number of records in the record store to \p maximumNumberOfRecords (older records are discarded)
+     * @param maximumNumberOfRecords Maximum number of records
+     */
+    void setMaximumNumberOfRecords(std::size_t maximumNumberOfRecords);
+
+    /**
+     * Get the number of messages which were dropped because the ring buffer was full
+     * @return Number of dropped messages
+     */
+    std::uint64_t getNumberOfDroppedMessages() const;
+
+private:
+
+    /** Background writer loop */
+    void write();
+
+    /** Stop the background writer (remaining messages are written first) */
+    void stop();
 
 private:
-    MessageRecords  _messageRecords;    /** Messages recorded since the instantiation of the logger */
-    std::mutex      _mutex;             /** Prevent race conditions */
+    std::unique_ptr<MpscRingBuffer<MessageRecord>>  _queue;                         /** Messages which are not yet processed by the writer */
+    std::atomic<std::uint64_t>                      _numberOfMessages;              /** Number of logged messages (enqueued or dropped, the writer numbers the messages) */
+    std::atomic<std::uint64_t>                      _numberOfHandledMessages;       /** Number of messages which were written or dropped */
+    std::atomic<std::uint64_t>                      _numberOfDroppedMessages;       /** Number of messages dropped because the ring buffer was full */
+    std::atomic<bool>                               _stopping;                      /** Whether the writer should stop */
+    std::atomic<bool>                               _flushRequested;                /** Whether a flush is pending */
+    std::mutex                                      _writerMutex;                   /** Mutex for the writer conditions */
+    std::condition_variable                         _wakeWriterCondition;           /** Wakes the writer early */
+    std::condition_variable                         _messagesHandledCondition;      /** Signals that the writer handled a batch */
+    std::thread                                     _writerThread;                  /** Background writer thread */
+    MessageRecords                                  _messageRecords;                /** Retained message records */
+    std::uint64_t                                   _firstRecordIndex;              /** Sequence index of the first retained record */
+    std::atomic<std::size_t>                        _maximumNumberOfRecords;        /** Maximum number of retained records */
+    mutable std::mutex                              _recordsMutex;                  /** Guards the record store */
 
     friend class mv::Application;
 };
@@ -6,12 +6,27 @@
 
 #include "graphics/Matrix3f.h"
 
-#include <algorithm>
-
 #include <QImage>
 #include <QDebug>
+#include <QOpenGLContext>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
 #include <math.h>
 #include <float.h>
+
+#ifndef __APPLE__
+#if defined(emit) // tbb defines emit which clashes with Qt's emit
+    #undef emit
+    #include <execution>
+    #define emit
+#else
+    #include <execution>
+#endif
+#endif
 //#define MEANSHIFT_IMAGE_DEBUG
 
 namespace mv
@@ -27,8 +42,84 @@ Matrix3f createProjectionMatrix(QRectF bounds)
     m[7] = -((bounds.top() + bounds.bottom()) / (bounds.top() - bounds.bottom()));
     return m;
 }
+
+namespace
+{
+    constexpr float minimumDensity      = 1.0f / 100000;    /** Pixels with less density have no gradient (as in GradientCompute.frag) */
+    constexpr float minimumGradient     = 0.001f;           /** Mean shift converges when the normalized gradient is smaller (as in MeanshiftCompute.frag) */
+    constexpr float stepSize            = 0.25f;            /** Mean shift step in pixels (as in MeanshiftCompute.frag) */
+    constexpr int   maximumNumberOfSteps = 10000;           /** Maximum number of mean shift steps (as in MeanshiftCompute.frag) */
+
+    /** Peak density of a single point (as in the splat of GaussianTexture::generate()) */
+    const float splatPeakDensity = static_cast<float>(1000.0 / (2.0 * 3.1415926535 * (32.0 / 6.0) * (32.0 / 6.0)));
+
+    /**
+     * Invoke \p function for each index in [0, \p count) in parallel
+     * @param count Number of indices
+     * @param function Function which is invoked with the index
+     */
+    template <typename Function>
+    void parallelFor(std::size_t count, Function function)
+    {
+        std::vector<std::size_t> indices(count);
+
+        std::iota(indices.begin(), indices.end(), 0);
+
+#ifndef __APPLE__
+        std::for_each(std::execution::par, indices.begin(), indices.end(), function);
+#else
+        std::for_each(indices.begin(), indices.end(), function);
+#endif
+    }
+
+    /**
+     * Sample a two-channel map bilinearly at texture coordinate \p position, clamped to the edges (as OpenGL samples a texture)
+     * @param map Row-major map with \p resolution x \p resolution pixels
+     * @param resolution Width and height of the map
+     * @param position Texture coordinate
+     * @return Interpolated value
+     */
+    Vector2f sampleBilinear(const std::vector<Vector2f>& map, int resolution, const Vector2f& position)
+    {
+        const auto x = std::clamp(position.x * resolution - 0.5f, 0.0f, static_cast<float>(resolution - 1));
+        const auto y = std::clamp(position.y * resolution - 0.5f, 0.0f, static_cast<float>(resolution - 1));
+
+        const auto x0 = static_cast<int>(x);
+        const auto y0 = static_cast<int>(y);
+        const auto x1 = std::min(x0 + 1, resolution - 1);
+        const auto y1 = std::min(y0 + 1, resolution - 1);
+        const auto fx = x - x0;
+        const auto fy = y - y0;
+
+        const auto& v00 = map[y0 * resolution + x0];
+        const auto& v10 = map[y0 * resolution + x1];
+        const auto& v01 = map[y1 * resolution + x0];
+        const auto& v11 = map[y1 * resolution + x1];
+
+        return Vector2f(
+            (v00.x * (1 - fx) + v10.x * fx) * (1 - fy) + (v01.x * (1 - fx) + v11.x * fx) * fy,
+            (v00.y * (1 - fx) + v10.y * fx) * (1 - fy) + (v01.y * (1 - fx) + v11.y * fx) * fy
+        );
+    }
+
+    /**
+     * Get the hash grid key of \p cell
+     * @param cellX Horizontal cell index
+     * @param cellY Vertical cell index
+     * @return Key
+     */
+    std::int64_t getCellKey(std::int64_t cellX, std::int64_t cellY)
+    {
+        return (cellX << 32) ^ (cellY & 0xffffffff);
+    }
+}
+
 void MeanShift::init()
 {
+    // Without OpenGL context the maps are computed on the CPU
+    if (QOpenGLContext::currentContext() == nullptr)
+        return;
+
     initializeOpenGLFunctions();
 
     glClearColor(1, 1, 1, 1);
@@ -51,31 +142,41 @@ void MeanShift::init()
     }
 
     _meanshiftFramebuffer.create();
+    _gradientTexture.create();
+    _meanshiftTexture.create();
+
+    allocateTextures();
+
+    _initialized = true;
+}
+
+void MeanShift::allocateTextures()
+{
     _meanshiftFramebuffer.bind();
 
-    _gradientTexture.create();
     _gradientTexture.bind();
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, RESOLUTION, RESOLUTION, 0, GL_RGB, GL_FLOAT, NULL);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, _resolution, _resolution, 0, GL_RGB, GL_FLOAT, NULL);
 
     _meanshiftFramebuffer.addColorTexture(1, &_gradientTexture);
     _meanshiftFramebuffer.validate();
 
-    _meanshiftTexture.create();
     _meanshiftTexture.bind();
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, RESOLUTION, RESOLUTION, 0, GL_RGB, GL_FLOAT, NULL);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F, _resolution, _resolution, 0, GL_RGB, GL_FLOAT, NULL);
 
     _meanshiftFramebuffer.addColorTexture(2, &_meanshiftTexture);
     _meanshiftFramebuffer.validate();
+
+    _textureResolution = _resolution;
 }
 
 void MeanShift::cleanup()
@@ -118,6 +219,26 @@ void MeanShift::setSigma(float sigma)
     _sigma = sigma;
 }
 
+void MeanShift::setBackend(const Backend& backend)
+{
+    _backend = backend;
+}
+
+MeanShift::Backend MeanShift::getBackend() const
+{
+    return _backend;
+}
+
+void MeanShift::setResolution(std::uint32_t resolution)
+{
+    _resolution = std::max<std::uint32_t>(resolution, 2);
+}
+
+std::uint32_t MeanShift::getResolution() const
+{
+    return _resolution;
+}
+
 void MeanShift::drawFullscreenQuad()
 {
     glBindVertexArray(_quad);
@@ -130,7 +251,7 @@ void MeanShift::computeGradient()
     _meanshiftFramebuffer.bind();
     glDrawBuffer(GL_COLOR_ATTACHMENT1);
 
-    glViewport(0, 0, RESOLUTION, RESOLUTION);
+    glViewport(0, 0, _resolution, _resolution);
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -140,7 +261,7 @@ void MeanShift::computeGradient()
     densityComputation.getDensityTexture().bind(0);
     _shaderGradientCompute.uniform1i("densityTexture", 0);
 
-    _shaderGradientCompute.uniform4f("renderParams", 1.0f / densityComputation.getMaxDensity(), 1.0f / 100000, 1.0f / RESOLUTION, 1.0f);
+    _shaderGradientCompute.uniform4f("renderParams", 1.0f / densityComputation.getMaxDensity(), 1.0f / 100000, 1.0f / _resolution, 1.0f);
 
     drawFullscreenQuad();
 
@@ -148,18 +269,18 @@ void MeanShift::computeGradient()
 
 #ifdef MEANSHIFT_IMAGE_DEBUG
     std::vector<float> gradientValues;
-    gradientValues.resize(RESOLUTION * RESOLUTION * 3);
+    gradientValues.resize(_resolution * _resolution * 3);
 
     glReadBuffer(GL_COLOR_ATTACHMENT1);
-    glReadPixels(0, 0, RESOLUTION, RESOLUTION, GL_RGB, GL_FLOAT, gradientValues.data());
+    glReadPixels(0, 0, _resolution, _resolution, GL_RGB, GL_FLOAT, gradientValues.data());
 
-    QImage gradients(RESOLUTION, RESOLUTION, QImage::Format::Format_RGB32);
+    QImage gradients(_resolution, _resolution, QImage::Format::Format_RGB32);
     float maxL = 0.0f;
-    for (int j = 0; j < RESOLUTION; ++j)
+    for (int j = 0; j < _resolution; ++j)
     {
-        for (int i = 0; i < RESOLUTION; ++i)
+        for (int i = 0; i < _resolution; ++i)
         {
-            int idx = j * RESOLUTION + i;
+            int idx = j * _resolution + i;
 
             Vector2f p(gradientValues[idx * 3], gradientValues[idx * 3 + 1]);
             float l = p.length();
@@ -170,11 +291,11 @@ void MeanShift::computeGradient()
 
     qDebug() << "Max gradient magnitude = " << maxL << "\n";
 
-    for (int j = 0; j < RESOLUTION; ++j)
+    for (int j = 0; j < _resolution; ++j)
     {
-        for (int i = 0; i < RESOLUTION; ++i)
+        for (int i = 0; i < _resolution; ++i)
         {
-            int idx = j * RESOLUTION + i;
+            int idx = j * _resolution + i;
 
             Vector2f p(gradientValues[idx * 3], gradientValues[idx * 3 + 1]);
             float l = p.length();
@@ -192,7 +313,7 @@ void MeanShift::computeGradient()
             QColor col;
             col.setHsvF(a, l / maxL, 1.0);
             
-            gradients.setPixelColor(i, RESOLUTION - j - 1, col);
+            gradients.setPixelColor(i, _resolution - j - 1, col);
 
         }
     }
@@ -206,7 +327,7 @@ void MeanShift::computeMeanShift()
     _meanshiftFramebuffer.bind();
     glDrawBuffer(GL_COLOR_ATTACHMENT2);
 
-    glViewport(0, 0, RESOLUTION, RESOLUTION);
+    glViewport(0, 0, _resolution, _resolution);
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -216,25 +337,25 @@ void MeanShift::computeMeanShift()
     _gradientTexture.bind(0);
     _shaderMeanshiftCompute.uniform1i("gradientTexture", 0);
 
-    _shaderMeanshiftCompute.uniform4f("renderParams", 0.25f, densityComputation.getMaxDensity(), 1.0f / RESOLUTION, 1.0f / RESOLUTION);
+    _shaderMeanshiftCompute.uniform4f("renderParams", 0.25f, densityComputation.getMaxDensity(), 1.0f / _resolution, 1.0f / _resolution);
 
     drawFullscreenQuad();
 //    qDebug() << "Drawing meanshift";
     _shaderMeanshiftCompute.release();
 
-    _meanshiftPixels.resize(RESOLUTION * RESOLUTION);
+    _meanshiftPixels.resize(_resolution * _resolution);
 
     glReadBuffer(GL_COLOR_ATTACHMENT2);
-    glReadPixels(0, 0, RESOLUTION, RESOLUTION, GL_RG, GL_FLOAT, _meanshiftPixels.data());
+    glReadPixels(0, 0, _resolution, _resolution, GL_RG, GL_FLOAT, _meanshiftPixels.data());
 
 #ifdef MEANSHIFT_IMAGE_DEBUG
-    QImage centers(RESOLUTION, RESOLUTION, QImage::Format::Format_RGB32);
-    for (int j = 0; j < RESOLUTION; ++j)
+    QImage centers(_resolution, _resolution, QImage::Format::Format_RGB32);
+    for (int j = 0; j < _resolution; ++j)
     {
-        for (int i = 0; i < RESOLUTION; ++i)
+        for (int i = 0; i < _resolution; ++i)
     	{
-            int idx = j * RESOLUTION + i;
-            centers.setPixel(i, RESOLUTION - j - 1, qRgb(_meanshiftPixels[idx].x * 255, _meanshiftPixels[idx].y * 255, 0));
+            int idx = j * _resolution + i;
+            centers.setPixel(i, _resolution - j - 1, qRgb(_meanshiftPixels[idx].x * 255, _meanshiftPixels[idx].y * 255, 0));
     	}
     }
     centers.save("meanshift_centers.png");
@@ -244,8 +365,8 @@ void MeanShift::computeMeanShift()
         Vector2f p = (ortho * (*_points)[i]);
 
         const Vector2f point = p * 0.5 + 0.5;
-        int x = (int)(point.x * (RESOLUTION - 1) + 0.5);
-        int y = (int)(point.y * (RESOLUTION - 1) + 0.5);
+        int x = (int)(point.x * (_resolution - 1) + 0.5);
+        int y = (int)(point.y * (_resolution - 1) + 0.5);
 
         centers.setPixel(x, y, qRgb(255, 0, 0));
     }
@@ -255,145 +376,286 @@ void MeanShift::computeMeanShift()
 #endif
 }
 
-void MeanShift::cluster(const std::vector<Vector2f>& points, std::vector<std::vector<unsigned int>>& clusters)
+void MeanShift::computeMeanShiftOnCpu()
 {
-    if (points.size() == 0) return;
+    const auto resolution       = static_cast<int>(_resolution);
+    const auto numberOfPixels   = static_cast<std::size_t>(resolution) * resolution;
+    const auto ortho            = createProjectionMatrix(_bounds);
+
+    // Splat the points bilinearly into the density map
+    std::vector<float> density(numberOfPixels, 0.0f);
+
+    for (const auto& point : *_points) {
+        const Vector2f textureCoordinate = (ortho * point) * 0.5 + 0.5;
+
+        const auto x    = std::clamp(textureCoordinate.x * resolution - 0.5f, 0.0f, static_cast<float>(resolution - 1));
+        const auto y    = std::clamp(textureCoordinate.y * resolution - 0.5f, 0.0f, static_cast<float>(resolution - 1));
+        const auto x0   = static_cast<int>(x);
+        const auto y0   = static_cast<int>(y);
+        const auto x1   = std::min(x0 + 1, resolution - 1);
+        const auto y1   = std::min(y0 + 1, resolution - 1);
+        const auto fx   = x - x0;
+        const auto fy   = y - y0;
+
+        density[y0 * resolution + x0] += (1 - fx) * (1 - fy);
+        density[y0 * resolution + x1] += fx * (1 - fy);
+        density[y1 * resolution + x0] += (1 - fx) * fy;
+        density[y1 * resolution + x1] += fx * fy;
+    }
 
-    densityComputation.setSigma(_sigma);
-    densityComputation.compute();
-    computeGradient();
-    computeMeanShift();
+    // Blur with the same Gaussian as the splats of the OpenGL backend (the splat is sigma * resolution pixels wide and its kernel has a standard deviation of a sixth of that)
+    const auto standardDeviation    = std::max(_sigma * resolution / 6.0f, 0.5f);
+    const auto radius               = static_cast<int>(std::ceil(3.0f * standardDeviation));
 
-    // Resize clusterID arrays to equal number of pixels
-    _clusterIds.resize(RESOLUTION * RESOLUTION);
-    _clusterIdsOriginal.resize(RESOLUTION * RESOLUTION);
-    // Stores centers of all clusters that are found in meanshift segmentation
-    std::vector<Vector2f> clusterCenters;
+    std::vector<float> kernel(2 * radius + 1);
 
-    // we take a distance of 2 pixels as maximum to assume points ended in the same peak
-    float epsilon = 2.0f/RESOLUTION;// 0.05f;
-    // For every pixel in Mean Shift Map
-    for (int i = 0; i < _meanshiftPixels.size(); i++) {
-        // Set center to red and green component of pixel
-        Vector2f center = _meanshiftPixels[i];
+    for (int offset = -radius; offset <= radius; offset++)
+        kernel[offset + radius] = std::exp(-static_cast<float>(offset * offset) / (2.0f * standardDeviation * standardDeviation));
 
-        // If center equals 0, set clusterID for this pixel to -1
-        if (center.sqrMagnitude() < 0.0001)
-        {
-            _clusterIdsOriginal[i] = -1;
-            continue;
+    const auto kernelSum = std::accumulate(kernel.begin(), kernel.end(), 0.0f);
+
+    // Normalize such that a single point has the peak density of a splat
+    for (auto& weight : kernel)
+        weight *= std::sqrt(splatPeakDensity * (2.0f * 3.1415926535f * standardDeviation * standardDeviation)) / kernelSum;
+
+    std::vector<float> blurred(numberOfPixels, 0.0f);
+
+    parallelFor(resolution, [&](std::size_t row) -> void {
+        for (int x = 0; x < resolution; x++) {
+            float sum = 0.0f;
+
+            for (int offset = std::max(-radius, -x); offset <= std::min(radius, resolution - 1 - x); offset++)
+                sum += kernel[offset + radius] * density[row * resolution + x + offset];
+
+            blurred[row * resolution + x] = sum;
         }
+    });
 
-        // If the center already exist in clusterCenters set clusterID to that cluster
-        bool clusterFound = false;
-        int clusterId = -1;
-        for (int c = 0; c < clusterCenters.size(); c++)
-        {
-            if (equal(center, clusterCenters[c], epsilon))
-            {
-                clusterFound = true;
-                clusterId = c;
+    parallelFor(resolution, [&](std::size_t column) -> void {
+        const auto x = static_cast<int>(column);
+
+        for (int y = 0; y < resolution; y++) {
+            float sum = 0.0f;
+
+            for (int offset = std::max(-radius, -y); offset <= std::min(radius, resolution - 1 - y); offset++)
+                sum += kernel[offset + radius] * blurred[(y + offset) * resolution + x];
+
+            density[y * resolution + x] = sum;
+        }
+    });
+
+    const auto maxDensity = *std::max_element(density.begin(), density.end());
+
+    if (maxDensity <= 0.0f) {
+        _meanshiftPixels.assign(numberOfPixels, Vector2f(0.0f, 0.0f));
+        return;
+    }
+
+    // Central differences of the normalized density (as in GradientCompute.frag)
+    std::vector<Vector2f> gradient(numberOfPixels);
+
+    parallelFor(numberOfPixels, [&](std::size_t pixelIndex) -> void {
+        const auto x = static_cast<int>(pixelIndex % resolution);
+        const auto y = static_cast<int>(pixelIndex / resolution);
+
+        if (density[pixelIndex] < minimumDensity) {
+            gradient[pixelIndex] = Vector2f(0.0f, 0.0f);
+            return;
+        }
+
+        const auto densityAt = [&](int x, int y) -> float {
+            return density[std::clamp(y, 0, resolution - 1) * resolution + std::clamp(x, 0, resolution - 1)] / maxDensity;
+        };
+
+        gradient[pixelIndex] = Vector2f(densityAt(x + 1, y) - densityAt(x - 1, y), densityAt(x, y + 1) - densityAt(x, y - 1));
+    });
+
+    // Follow the gradient from each pixel (as in MeanshiftCompute.frag)
+    _meanshiftPixels.resize(numberOfPixels);
+
+    const auto step = stepSize / resolution;
+
+    parallelFor(numberOfPixels, [&](std::size_t pixelIndex) -> void {
+        if (gradient[pixelIndex].x == 0.0f && gradient[pixelIndex].y == 0.0f) {
+            _meanshiftPixels[pixelIndex] = Vector2f(0.0f, 0.0f);
+            return;
+        }
+
+        Vector2f position((pixelIndex % resolution + 0.5f) / resolution, (pixelIndex / resolution + 0.5f) / resolution);
+
+        for (int stepIndex = 0; stepIndex < maximumNumberOfSteps; stepIndex++) {
+            const auto sample = sampleBilinear(gradient, resolution, position);
+            const auto length = sample.length();
+
+            if (length < minimumGradient)
                 break;
-            }
+
+            position = position + sample * (step / length);
         }
-        
-        // If clusterID was not found already, push the new center into clusterCenters
-        if (!clusterFound)
-        {
-            clusterCenters.push_back(center);
-            // Set the current pixel in clusterIdsOriginal to the latest cluster index
-            _clusterIdsOriginal[i] = static_cast<int>(clusterCenters.size() - 1);
+
+        _meanshiftPixels[pixelIndex] = position;
+    });
+}
+
+std::vector<int> MeanShift::findModes(std::vector<Vector2f>& modes) const
+{
+    // We take a distance of 2 pixels as maximum to assume points ended in the same peak
+    const auto epsilon = 2.0f / _resolution;
+
+    // Modes by hash grid cell, the cells are epsilon wide so only the neighboring cells have to be searched
+    std::unordered_map<std::int64_t, std::vector<int>> grid;
+
+    std::vector<int> modeIds(_meanshiftPixels.size(), -1);
+
+    modes.clear();
+
+    for (std::size_t pixelIndex = 0; pixelIndex < _meanshiftPixels.size(); pixelIndex++) {
+        const auto& center = _meanshiftPixels[pixelIndex];
+
+        // Pixels without density did not shift
+        if (center.sqrMagnitude() < 0.0001)
+            continue;
+
+        const auto cellX = static_cast<std::int64_t>(std::floor(center.x / epsilon));
+        const auto cellY = static_cast<std::int64_t>(std::floor(center.y / epsilon));
+
+        // Find the first mode (in order of discovery) within merge distance
+        auto modeId = -1;
+
+        for (std::int64_t offsetY = -1; offsetY <= 1; offsetY++) {
+            for (std::int64_t offsetX = -1; offsetX <= 1; offsetX++) {
+                const auto it = grid.find(getCellKey(cellX + offsetX, cellY + offsetY));
+
+                if (it == grid.end())
+                    continue;
+
+                for (const auto candidateId : it->second)
+                    if ((modeId < 0 || candidateId < modeId) && equal(center, modes[candidateId], epsilon))
+                        modeId = candidateId;
+            }
         }
-        else
-        {
-            // Set the current pixel in clusterIdsOriginal to the previously found clusterID
-            _clusterIdsOriginal[i] = clusterId;
+
+        if (modeId < 0) {
+            modeId = static_cast<int>(modes.size());
+
+            modes.push_back(center);
+            grid[getCellKey(cellX, cellY)].push_back(modeId);
         }
+
+        modeIds[pixelIndex] = modeId;
     }
 
+    return modeIds;
+}
+
+std::vector<int> MeanShift::getPointPixelIndices() const
+{
+    const auto ortho        = createProjectionMatrix(_bounds);
+    const auto resolution   = static_cast<int>(_resolution);
+
+    std::vector<int> pixelIndices(_points->size());
+
+    parallelFor(_points->size(), [&](std::size_t pointIndex) -> void {
+        // Calculate the coordinate of the pixel center on the texture
+        const Vector2f point = (ortho * (*_points)[pointIndex]) * 0.5 + 0.5;
+
+        const auto x = std::clamp(static_cast<int>(point.x * (resolution - 1) + 0.5), 0, resolution - 1);
+        const auto y = std::clamp(static_cast<int>(point.y * (resolution - 1) + 0.5), 0, resolution - 1);
+
+        pixelIndices[pointIndex] = x + y * resolution;
+    });
+
+    return pixelIndices;
+}
+
+void MeanShift::cluster(const std::vector<Vector2f>& points, std::vector<std::vector<unsigned int>>& clusters)
+{
+    if (points.size() == 0) return;
+
+    if (_backend == Backend::OpenGL && _initialized) {
+        if (_textureResolution != _resolution)
+            allocateTextures();
+
+        densityComputation.setSigma(_sigma);
+        densityComputation.compute();
+        computeGradient();
+        computeMeanShift();
+    }
+    else {
+        computeMeanShiftOnCpu();
+    }
+
+    const auto numberOfPixels = static_cast<std::size_t>(_resolution) * _resolution;
+
+    // Stores centers of all clusters that are found in meanshift segmentation
+    std::vector<Vector2f> clusterCenters;
+
+    _clusterIdsOriginal = findModes(clusterCenters);
+    _clusterIds.resize(numberOfPixels);
+
 #ifdef MEANSHIFT_IMAGE_DEBUG
     for (int i = 0; i < clusterCenters.size(); i++) {
         qDebug() << "Cluster center: " << clusterCenters[i].x << " " << clusterCenters[i].y;
     }
 #endif //MEANSHIFT_IMAGE_DEBUG
 
+    const auto pointPixelIndices = getPointPixelIndices();
+
     // Create a vector with the same size as the number of clusters, and set all IDs to -1
     std::vector<int> activeIds(clusterCenters.size(), -1);
 
-    Matrix3f ortho = createProjectionMatrix(_bounds);
-
     int runningIdx = 0;
     _clusterPositions.clear();
-    // For every point
-    for (int i = 0; i < _points->size(); i++) {
-        // Calculate the coordinate of the pixel center on the texture
-        Vector2f p = (ortho * (*_points)[i]);
 
-        const Vector2f point = p * 0.5 + 0.5;
-        int x = (int)(point.x * (RESOLUTION - 1) + 0.5);
-        int y = (int)(point.y * (RESOLUTION - 1) + 0.5);
-
-        // Calculate index into clusterID array this pixel belongs to
-        int pixelIndex = (x + y * RESOLUTION);
-        // Get the clusterID
-        int cId = _clusterIdsOriginal[pixelIndex];
-        // If the clusterID is 0 or more and cluster is not active
+    // Number the clusters which contain points in order of their first point
+    for (const auto pixelIndex : pointPixelIndices) {
+        const auto cId = _clusterIdsOriginal[pixelIndex];
+
         if (cId >= 0 && activeIds[cId] < 0) {
-            // Get the cluster center
-            Vector2f center = clusterCenters[cId];
             // Store the cluster center as the position of the cluster
-            _clusterPositions.push_back(center);
+            _clusterPositions.push_back(clusterCenters[cId]);
 
             activeIds[cId] = runningIdx++;
         }
     }
 
-#pragma omp parallel for
     // For every assigned clusterID, set it to the corresponding active ID and store it in clusterIds
-    for (int i = 0; i < _clusterIdsOriginal.size(); i++) {
-        if (_clusterIdsOriginal[i] >= 0){ _clusterIdsOriginal[i] = activeIds[_clusterIdsOriginal[i]]; }
+    parallelFor(numberOfPixels, [&](std::size_t i) -> void {
+        if (_clusterIdsOriginal[i] >= 0)
+            _clusterIdsOriginal[i] = activeIds[_clusterIdsOriginal[i]];
+
         _clusterIds[i] = _clusterIdsOriginal[i];
-    }
+    });
 
     // Check if clusters contain their own cluster center.
     // If not it is likely that the center is just a variation of an existing cluster and those should be merged
-#pragma omp parallel for
-    for (int i = 0; i < _clusterIds.size(); i++) {
+    parallelFor(numberOfPixels, [&](std::size_t i) -> void {
+        const auto& currentCenter = _meanshiftPixels[i];
 
-        Vector2f currentCenter = _meanshiftPixels[i];
-        int x = static_cast<int>(currentCenter.x * (RESOLUTION - 1) + 0.5);
-        int y = static_cast<int>(currentCenter.y * (RESOLUTION - 1) + 0.5);
-        int centerIdx = (x + y * RESOLUTION);
+        const auto x = static_cast<int>(currentCenter.x * (_resolution - 1) + 0.5);
+        const auto y = static_cast<int>(currentCenter.y * (_resolution - 1) + 0.5);
 
-        if (centerIdx < 0 || centerIdx >= _clusterIds.size())
-            continue;
+        if (x < 0 || y < 0 || x >= static_cast<int>(_resolution) || y >= static_cast<int>(_resolution))
+            return;
+
+        const auto centerIdx = x + y * static_cast<int>(_resolution);
+
+        // Read the original (active) IDs so the result does not depend on the order in which pixels are processed
+        if (_clusterIdsOriginal[i] != _clusterIdsOriginal[centerIdx] && _clusterIdsOriginal[i] >= 0 && _clusterIdsOriginal[centerIdx] >= 0)
+            _clusterIds[i] = _clusterIdsOriginal[centerIdx];
+    });
 
-        if (_clusterIds[i] != _clusterIds[centerIdx] && _clusterIds[i] >= 0 && _clusterIds[centerIdx] >= 0)
-        {
-            //qDebug() << "Assigned from cluster " << _clusterIds[i] << " to " << _clusterIds[centerIdx] << "index: " << i << ", pos(" << currentCenter.x << ", " << currentCenter.y << ")";
-            _clusterIds[i] = _clusterIds[centerIdx];
-        }
-    }
-    
     // Divide points into their corresponding clusters
-    //qDebug() << "Matrix: " << ortho[0] << "," << ortho[1] << "," << ortho[2] << "," << ortho[3] << "," << ortho[4] << "," << ortho[5] << "," << ortho[6] << "," << ortho[7] << "," << ortho[8];
+    clusters.clear();
     clusters.resize(runningIdx);
-    for (int i = 0; i < _points->size(); i++) {
-        Vector2f p = (ortho * (*_points)[i]);
-
-        const Vector2f point = p * 0.5 + 0.5;
-        int x = (int)(point.x * (RESOLUTION - 1) + 0.5);
-        int y = (int)(point.y * (RESOLUTION - 1) + 0.5);
 
-        int pixelIndex = (x + y * RESOLUTION);
-        //_clusterIds[pixelIndex] = qRgb(255, 0, 0);
+    for (std::size_t i = 0; i < pointPixelIndices.size(); i++) {
+        const auto cId = _clusterIds[pointPixelIndices[i]];
 
-        int cId = _clusterIds[pixelIndex];
-        if (cId >= 0) { clusters[cId].push_back(i); }
+        if (cId >= 0)
+            clusters[cId].push_back(static_cast<unsigned int>(i));
     }
 
-    //qDebug() << "Final clusters size (including empty clusters): " << clusters.size();
-
     clusters.erase(std::remove_if(clusters.begin(), clusters.end(),
         [](const auto& pointIDs) { return pointIDs.empty(); }),
         clusters.end());
@@ -401,14 +663,14 @@ void MeanShift::cluster(const std::vector<Vector2f>& points, std::vector<std::ve
     qDebug() << "Final clusters size: " << clusters.size();
 
 #ifdef MEANSHIFT_IMAGE_DEBUG
-    QImage clustersImg(RESOLUTION, RESOLUTION, QImage::Format::Format_RGB32);
+    QImage clustersImg(_resolution, _resolution, QImage::Format::Format_RGB32);
     float scale = 255.0 / clusterCenters.size();
-    for (int j = 0; j < RESOLUTION; ++j)
+    for (int j = 0; j < _resolution; ++j)
     {
-        for (int i = 0; i < RESOLUTION; ++i)
+        for (int i = 0; i < _resolution; ++i)
         {
-            int idx = j * RESOLUTION + i;
-            clustersImg.setPixel(i, RESOLUTION - j - 1, qRgb(_clusterIds[idx] * scale, _clusterIds[idx] * scale, _clusterIds[idx] * scale));
+            int idx = j * _resolution + i;
+            clustersImg.setPixel(i, _resolution - j - 1, qRgb(_clusterIds[idx] * scale, _clusterIds[idx] * scale, _clusterIds[idx] * scale));
         }
     }
     clustersImg.save("meanshift_clusters.png");
@@ -416,9 +678,9 @@ void MeanShift::cluster(const std::vector<Vector2f>& points, std::vector<std::ve
 #endif
 }
 
-bool MeanShift::equal(const Vector2f& p1, const Vector2f& p2, float epsilon)
+bool MeanShift::equal(const Vector2f& p1, const Vector2f& p2, float epsilon) const
 {
-    return fabs(p1.x - p2.x) < epsilon && fabs(p1.y - p2.y < epsilon);
+    return std::abs(p1.x - p2.x) < epsilon && std::abs(p1.y - p2.y) < epsilon;
 }
 
 Texture2D& MeanShift::getGradientTexture()
@@ -14,35 +14,102 @@
 #include "graphics/Texture.h"
 #include "graphics/Vector2f.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace mv
 {
 
+/**
+ * Mean shift class
+ *
+ * Clusters two-dimensional points by the modes of their kernel density estimate: the density gradient is followed
+ * from each pixel of a square grid until it vanishes, pixels which end up in the same mode form a cluster and points
+ * are assigned to the cluster of their pixel.
+ *
+ * The density, gradient and mean shift maps are either computed with OpenGL (requires a current OpenGL context
+ * when MeanShift::init() is called) or on the CPU (for machines without a GPU, and the fallback when OpenGL was
+ * not initialized). Modes are merged in a hash grid with cells the size of the merge distance.
+ */
 class CORE_EXPORT MeanShift : protected QOpenGLFunctions_3_3_Core
 {
+public:
+
+    /** Backends which compute the density, gradient and mean shift maps */
+    enum class Backend {
+        OpenGL,     /** Shaders, requires an OpenGL context */
+        CPU         /** Parallel CPU implementation of the same computation */
+    };
+
+    static constexpr std::uint32_t defaultResolution = 256;     /** Default width and height of the mean shift map */
+
 public:
     MeanShift() : _sigma(0.15f), _needsDensityMapUpdate(true), _quad(0) { }
+
+    /** Initialize the OpenGL backend (does nothing when no OpenGL context is current) */
     void init();
     void cleanup();
 
     void setData(const std::vector<Vector2f>* points);
     void setSigma(float sigma);
 
+    /**
+     * Set the backend to \p backend
+     * @param backend Backend which computes the maps (the CPU backend is used as long as OpenGL is not initialized)
+     */
+    void setBackend(const Backend& backend);
+
+    /**
+     * Get the backend
+     * @return Backend which computes the maps
+     */
+    Backend getBackend() const;
+
+    /**
+     * Set the width and height of the mean shift map to \p resolution (the merge distance of modes is two pixels)
+     * @param resolution Resolution in pixels
+     */
+    void setResolution(std::uint32_t resolution);
+
+    /**
+     * Get the width and height of the mean shift map
+     * @return Resolution in pixels
+     */
+    std::uint32_t getResolution() const;
+
     void drawFullscreenQuad();
 
     void cluster(const std::vector<Vector2f>& points, std::vector<std::vector<unsigned int>>& clusters);
-    bool equal(const Vector2f& p1, const Vector2f& p2, float epsilon);
+    bool equal(const Vector2f& p1, const Vector2f& p2, float epsilon) const;
 
     Texture2D& getGradientTexture();
     Texture2D& getMeanShiftTexture();
 
 private:
-    const unsigned int RESOLUTION = 256;
-
     DensityComputation densityComputation;
 
+    /** Allocate the gradient and mean shift textures at the current resolution */
+    void allocateTextures();
+
     void computeGradient();
     void computeMeanShift();
 
+    /** Compute the density, gradient and mean shift maps on the CPU */
+    void computeMeanShiftOnCpu();
+
+    /**
+     * Find the modes of the mean shift map: pixels whose positions converged within two pixels of each other share a mode
+     * @param modes Positions of the modes
+     * @return Mode index per pixel (-1 for pixels without density)
+     */
+    std::vector<int> findModes(std::vector<Vector2f>& modes) const;
+
+    /**
+     * Get the index of the pixel of each point
+     * @return Pixel index per point
+     */
+    std::vector<int> getPointPixelIndices() const;
+
     ShaderProgram _shaderGradientCompute;
     ShaderProgram _shaderMeanshiftCompute;
 
@@ -57,6 +124,11 @@ private:
     bool _needsDensityMapUpdate;
     float _sigma;
 
+    Backend         _backend = Backend::OpenGL;             /** Backend which computes the maps */
+    std::uint32_t   _resolution = defaultResolution;        /** Width and height of the mean shift map */
+    std::uint32_t   _textureResolution = 0;                 /** Resolution of the allocated textures */
+    bool            _initialized = false;                   /** Whether the OpenGL backend is initialized */
+
     std::vector<Vector2f> _meanshiftPixels;
     std::vector<Vector2f> _clusterPositions;
     std::vector<int> _clusterIds;
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "MemoryAccounting.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace mv::util {
+
+namespace
+{
+    /** Number of memory categories */
+    constexpr auto numberOfCategories = static_cast<std::size_t>(MemoryAccounting::Category::Count);
+
+    /** Global accounting state */
+    struct MemoryAccountingState
+    {
+        std::mutex                                                      _mutex;             /** Guards the allocations */
+        std::array<MemoryAccounting::Allocations, numberOfCategories>   _allocations;       /** Allocations per category */
+        std::array<std::uint64_t, numberOfCategories>                   _numberOfBytes{};   /** Number of bytes per category */
+        std::atomic<std::uint64_t>                                      _generation = 0;    /** Incremented when an allocation changes */
+    };
+
+    /**
+     * Get the global accounting state (intentionally leaked, allocations may be withdrawn during static destruction)
+     * @return Accounting state
+     */
+    MemoryAccountingState& getMemoryAccountingState()
+    {
+        static auto* memoryAccountingState = new MemoryAccountingState();
+
+        return *memoryAccountingState;
+    }
+}
+
+QString MemoryAccounting::getCategoryName(const Category& category)
+{
+    switch (category)
+    {
+        case Category::RawData:
+            return "Raw data";
+
+        case Category::Selection:
+            return "Selections";
+
+        case Category::GpuBuffer:
+            return "GPU buffers";
+
+        case Category::Cache:
+            return "Caches";
+
+        default:
+            break;
+    }
+
+    return {};
+}
+
+bool MemoryAccounting::isHostCategory(const Category& category)
+{
+    return category != Category::GpuBuffer;
+}
+
+void MemoryAccounting::setAllocation(const Category& category, const QString& owner, std::uint64_t numberOfBytes)
+{
+    if (numberOfBytes == 0) {
+        removeAllocation(category, owner);
+        return;
+    }
+
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    auto& allocations       = state._allocations[static_cast<int>(category)];
+    auto& categoryBytes     = state._numberOfBytes[static_cast<int>(category)];
+    const auto previous     = allocations.value(owner, 0);
+
+    if (previous == numberOfBytes)
+        return;
+
+    allocations[owner] = numberOfBytes;
+
+    categoryBytes = categoryBytes - previous + numberOfBytes;
+
+    state._generation++;
+}
+
+void MemoryAccounting::removeAllocation(const Category& category, const QString& owner)
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    auto& allocations = state._allocations[static_cast<int>(category)];
+
+    if (!allocations.contains(owner))
+        return;
+
+    state._numberOfBytes[static_cast<int>(category)] -= allocations.take(owner);
+    state._generation++;
+}
+
+void MemoryAccounting::setAllocations(const Category& category, const Allocations& allocations)
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    if (state._allocations[static_cast<int>(category)] == allocations)
+        return;
+
+    std::uint64_t numberOfBytes = 0;
+
+    for (const auto allocation : allocations)
+        numberOfBytes += allocation;
+
+    state._allocations[static_cast<int>(category)]      = allocations;
+    state._numberOfBytes[static_cast<int>(category)]    = numberOfBytes;
+    state._generation++;
+}
+
+std::uint64_t MemoryAccounting::getAllocation(const Category& category, const QString& owner)
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return state._allocations[static_cast<int>(category)].value(owner, 0);
+}
+
+MemoryAccounting::Allocations MemoryAccounting::getAllocations(const Category& category)
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return state._allocations[static_cast<int>(category)];
+}
+
+std::uint64_t MemoryAccounting::getNumberOfBytes(const Category& category)
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    return state._numberOfBytes[static_cast<int>(category)];
+}
+
+std::uint64_t MemoryAccounting::getNumberOfHostBytes()
+{
+    auto& state = getMemoryAccountingState();
+
+    std::lock_guard<std::mutex> lock(state._mutex);
+
+    std::uint64_t numberOfHostBytes = 0;
+
+    for (std::size_t categoryIndex = 0; categoryIndex < numberOfCategories; categoryIndex++)
+        if (isHostCategory(static_cast<Category>(categoryIndex)))
+            numberOfHostBytes += state._numberOfBytes[categoryIndex];
+
+    return numberOfHostBytes;
+}
+
+std::uint64_t MemoryAccounting::getGeneration()
+{
+    return getMemoryAccountingState()._generation.load(std::memory_order_relaxed);
+}
+
+}
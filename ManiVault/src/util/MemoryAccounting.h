@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QMap>
+#include <QString>
+
+#include <cstdint>
+
+namespace mv::util {
+
+/**
+ * Memory accounting class
+ *
+ * Thread-safe registry of the number of bytes that owners (e.g. raw data, renderers or caches) occupy per memory
+ * category. Owners report their allocations with MemoryAccounting::setAllocation() and withdraw them with
+ * MemoryAccounting::removeAllocation(), the memory manager (see AbstractMemoryManager) presents the totals and
+ * enforces the memory budget.
+ *
+ * The registry does not depend on the core, so allocations may be reported from anywhere, also during shutdown.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT MemoryAccounting
+{
+public:
+
+    /** Memory categories */
+    enum class Category {
+        RawData,        /** Raw data (e.g. point data) */
+        Selection,      /** Selection indices */
+        GpuBuffer,      /** Graphics buffers (device memory) */
+        Cache,          /** Derived data caches */
+
+        Count
+    };
+
+    /** Maps owner to number of bytes */
+    using Allocations = QMap<QString, std::uint64_t>;
+
+    /**
+     * Get the name of \p category
+     * @param category Memory category
+     * @return Category name
+     */
+    static QString getCategoryName(const Category& category);
+
+    /**
+     * Get whether \p category occupies host memory (and thus counts towards the memory budget)
+     * @param category Memory category
+     * @return Boolean determining whether \p category occupies host memory
+     */
+    static bool isHostCategory(const Category& category);
+
+    /**
+     * Set the number of bytes that \p owner occupies in \p category to \p numberOfBytes (removes the allocation when zero)
+     * @param category Memory category
+     * @param owner Unique owner identifier within the category
+     * @param numberOfBytes Number of bytes
+     */
+    static void setAllocation(const Category& category, const QString& owner, std::uint64_t numberOfBytes);
+
+    /**
+     * Remove the allocation of \p owner in \p category
+     * @param category Memory category
+     * @param owner Unique owner identifier within the category
+     */
+    static void removeAllocation(const Category& category, const QString& owner);
+
+    /**
+     * Replace all allocations in \p category with \p allocations (for categories which are polled as a whole)
+     * @param category Memory category
+     * @param allocations Allocations
+     */
+    static void setAllocations(const Category& category, const Allocations& allocations);
+
+    /**
+     * Get the number of bytes that \p owner occupies in \p category
+     * @param category Memory category
+     * @param owner Unique owner identifier within the category
+     * @return Number of bytes (zero when not registered)
+     */
+    static std::uint64_t getAllocation(const Category& category, const QString& owner);
+
+    /**
+     * Get the allocations in \p category
+     * @param category Memory category
+     * @return Allocations
+     */
+    static Allocations getAllocations(const Category& category);
+
+    /**
+     * Get the number of bytes in \p category
+     * @param category Memory category
+     * @return Number of bytes
+     */
+    static std::uint64_t getNumberOfBytes(const Category& category);
+
+    /**
+     * Get the number of bytes in all host memory categories (see MemoryAccounting::isHostCategory())
+     * @return Number of bytes
+     */
+    static std::uint64_t getNumberOfHostBytes();
+
+    /**
+     * Get the accounting generation, which is incremented each time an allocation changes
+     * @return Accounting generation
+     */
+    static std::uint64_t getGeneration();
+};
+
+}
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mv::util {
+
+/**
+ * Multiple producer single consumer ring buffer class
+ *
+ * Bounded lock-free queue (after Dmitry Vyukov's bounded queue): producers claim a slot by advancing the
+ * enqueue position with a compare-and-swap and publish it through the slot sequence number, the (single)
+ * consumer takes slots in order. Neither side blocks: MpscRingBuffer::tryPush() fails when the buffer is
+ * full and MpscRingBuffer::tryPop() fails when the next slot has not been published yet.
+ *
+ * @author Thomas Kroes
+ */
+template<typename ValueType>
+class MpscRingBuffer
+{
+public:
+
+    /**
+     * Construct with \p capacity
+     * @param capacity Number of slots (must be a power of two)
+     */
+    explicit MpscRingBuffer(std::size_t capacity) :
+        _capacity(capacity),
+        _mask(capacity - 1),
+        _slots(std::make_unique<Slot[]>(capacity)),
+        _enqueuePosition(0),
+        _dequeuePosition(0)
+    {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+            throw std::invalid_argument("Ring buffer capacity must be a power of two");
+
+        for (std::size_t slotIndex = 0; slotIndex < capacity; slotIndex++)
+            _slots[slotIndex]._sequence.store(slotIndex, std::memory_order_relaxed);
+    }
+
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+    /**
+     * Try to push \p value (may be called from any thread)
+     * @param value Value to push (only moved from when the push succeeds)
+     * @return Boolean determining whether the value was pushed (false when the buffer is full)
+     */
+    bool tryPush(ValueType& value)
+    {
+        auto position = _enqueuePosition.load(std::memory_order_relaxed);
+
+        while (true) {
+            auto& slot = _slots[position & _mask];
+
+            const auto sequence     = slot._sequence.load(std::memory_order_acquire);
+            const auto difference   = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+            if (difference == 0) {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot._value = std::move(value);
+                    slot._sequence.store(position + 1, std::memory_order_release);
+
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false;
+            }
+            else {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Try to pop the oldest value into \p value (may only be called from the consumer thread)
+     * @param value Popped value
+     * @return Boolean determining whether a value was popped (false when the buffer is empty)
+     */
+    bool tryPop(ValueType& value)
+    {
+        const auto position = _dequeuePosition.load(std::memory_order_relaxed);
+
+        auto& slot = _slots[position & _mask];
+
+        if (slot._sequence.load(std::memory_order_acquire) != position + 1)
+            return false;
+
+        value = std::move(slot._value);
+
+        slot._value = ValueType();
+        slot._sequence.store(position + _capacity, std::memory_order_release);
+
+        _dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    /**
+     * Get the approximate number of values in the buffer
+     * @return Number of values
+     */
+    std::size_t getApproximateSize() const
+    {
+        const auto enqueuePosition = _enqueuePosition.load(std::memory_order_relaxed);
+        const auto dequeuePosition = _dequeuePosition.load(std::memory_order_relaxed);
+
+        return enqueuePosition > dequeuePosition ? enqueuePosition - dequeuePosition : 0;
+    }
+
+    /**
+     * Get the capacity
+     * @return Number of slots
+     */
+    std::size_t getCapacity() const
+    {
+        return _capacity;
+    }
+
+private:
+
+    /** Buffer slot, the sequence number determines whether the slot is free or holds a published value */
+    struct Slot
+    {
+        std::atomic<std::size_t>    _sequence;      /** Slot sequence number */
+        ValueType                   _value;         /** Slot value */
+    };
+
+    const std::size_t                       _capacity;          /** Number of slots */
+    const std::size_t                       _mask;              /** Mask for mapping positions to slots */
+    std::unique_ptr<Slot[]>                 _slots;             /** Slots */
+    alignas(64) std::atomic<std::size_t>    _enqueuePosition;   /** Next position to claim by producers */
+    alignas(64) std::atomic<std::size_t>    _dequeuePosition;   /** Next position to take by the consumer */
+};
+
+}
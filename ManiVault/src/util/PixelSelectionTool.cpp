@@ -12,6 +12,8 @@
 #include <QPainterPath>
 #include <QtMath>
 
+#include <cmath>
+
 namespace mv::util {
 
 PixelSelectionTool::PixelSelectionTool(QWidget* targetWidget, const bool& enabled /*= true*/) :
@@ -540,6 +542,123 @@ bool PixelSelectionTool::eventFilter(QObject* target, QEvent* event)
     return QObject::eventFilter(target, event);
 }
 
+SpatialIndex2D::Indices PixelSelectionTool::getSelectedPointIndices(const SpatialIndex2D& spatialIndex, const QTransform& widgetToIndex) const
+{
+    SpatialIndex2D::Mask mask(spatialIndex.getNumberOfPoints(), false);
+
+    const auto toIndexPolygon = [&widgetToIndex](const QPolygonF& widgetPolygon) -> std::vector<Vector2f> {
+        std::vector<Vector2f> polygon;
+
+        polygon.reserve(widgetPolygon.size());
+
+        for (const auto& point : widgetToIndex.map(widgetPolygon))
+            polygon.emplace_back(static_cast<float>(point.x()), static_cast<float>(point.y()));
+
+        return polygon;
+    };
+
+    // Circles are queried directly when the transform preserves them, otherwise as (mapped) polygons
+    const auto isConformal = !widgetToIndex.isRotating() && qFuzzyCompare(std::abs(widgetToIndex.m11()), std::abs(widgetToIndex.m22()));
+
+    const auto selectCircle = [&](const QPointF& center, qreal radius) -> void {
+        if (isConformal) {
+            const auto indexCenter = widgetToIndex.map(center);
+
+            spatialIndex.selectCircle(Vector2f(static_cast<float>(indexCenter.x()), static_cast<float>(indexCenter.y())), static_cast<float>(radius * std::abs(widgetToIndex.m11())), mask);
+        }
+        else {
+            constexpr auto numberOfSegments = 64;
+
+            QPolygonF circle;
+
+            for (int segmentIndex = 0; segmentIndex < numberOfSegments; ++segmentIndex) {
+                const auto angle = 2.0 * M_PI * segmentIndex / numberOfSegments;
+
+                circle << center + radius * QPointF(std::cos(angle), std::sin(angle));
+            }
+
+            spatialIndex.selectPolygon(toIndexPolygon(circle), mask);
+        }
+    };
+
+    switch (_type)
+    {
+        case PixelSelectionType::Rectangle:
+        {
+            if (_mousePositions.size() != 2)
+                break;
+
+            const auto rectangle = QRectF(QPointF(_mousePositions.first()), QPointF(_mousePositions.last())).normalized();
+
+            if (widgetToIndex.isRotating()) {
+                spatialIndex.selectPolygon(toIndexPolygon(QPolygonF(rectangle)), mask);
+            }
+            else {
+                const auto indexRectangle = widgetToIndex.mapRect(rectangle);
+
+                spatialIndex.selectRectangle(Bounds(indexRectangle.left(), indexRectangle.right(), indexRectangle.top(), indexRectangle.bottom()), mask);
+            }
+
+            break;
+        }
+
+        case PixelSelectionType::Brush:
+        {
+            // The stroke is painted as a polyline with round caps and joins, so it is the union of the circles at the
+            // mouse positions and the rectangles which connect consecutive circles
+            for (const auto& mousePosition : _mousePositions)
+                selectCircle(mousePosition, _brushRadius);
+
+            for (qsizetype positionIndex = 1; positionIndex < _mousePositions.size(); ++positionIndex) {
+                const auto start    = QPointF(_mousePositions[positionIndex - 1]);
+                const auto end      = QPointF(_mousePositions[positionIndex]);
+                const auto length   = std::hypot(end.x() - start.x(), end.y() - start.y());
+
+                if (length <= 0.0)
+                    continue;
+
+                const auto normal = QPointF(start.y() - end.y(), end.x() - start.x()) * (_brushRadius / length);
+
+                spatialIndex.selectPolygon(toIndexPolygon(QPolygonF({ start + normal, end + normal, end - normal, start - normal })), mask);
+            }
+
+            break;
+        }
+
+        case PixelSelectionType::Lasso:
+        case PixelSelectionType::Polygon:
+        {
+            if (_mousePositions.size() < 3)
+                break;
+
+            spatialIndex.selectPolygon(toIndexPolygon(QPolygonF(QPolygon(_mousePositions))), mask);
+
+            break;
+        }
+
+        case PixelSelectionType::Sample:
+        {
+            // The sample is painted as a point with a pen width of the brush radius
+            if (!_mousePositions.isEmpty())
+                selectCircle(_mousePositions.last(), 0.5 * _brushRadius);
+
+            break;
+        }
+
+        case PixelSelectionType::ROI:
+        default:
+            break;
+    }
+
+    SpatialIndex2D::Indices indices;
+
+    for (std::uint32_t pointIndex = 0; pointIndex < mask.size(); ++pointIndex)
+        if (mask[pointIndex])
+            indices.push_back(pointIndex);
+
+    return indices;
+}
+
 void PixelSelectionTool::paint()
 {
     if (!_enabled) // _type != PixelSelectionType::ROI && 
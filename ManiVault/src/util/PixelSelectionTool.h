@@ -7,7 +7,9 @@
 #include "ManiVaultGlobals.h"
 
 #include "PixelSelection.h"
+#include "SpatialIndex2D.h"
 
+#include <QTransform>
 #include <QWidget>
 #include <QMap>
 #include <QPen>
@@ -130,6 +132,34 @@ public: // Getters/setters
         return _areaPixmap;
     }
 
+    /**
+     * Get the recorded mouse positions (in target widget coordinates) which define the current selection shape
+     * The first and last position span the rectangle in rectangle mode, the positions are the vertices in lasso/polygon mode
+     * and the current brush center is available through getMousePosition() in brush mode
+     * @return Mouse positions
+     */
+    QVector<QPoint> getMousePositions() const {
+        return _mousePositions;
+    }
+
+    /**
+     * Get the current mouse position (in target widget coordinates)
+     * @return Mouse position
+     */
+    QPoint getMousePosition() const {
+        return _mousePosition;
+    }
+
+    /**
+     * Get the points of \p spatialIndex inside the current selection shape (an alternative to rasterizing the area pixmap)
+     * The shape is mapped to the coordinate frame of the index with \p widgetToIndex, the brush stroke is selected as a
+     * whole (as it is painted in the area pixmap) and region of interest selection is not supported
+     * @param spatialIndex Spatial index of the points (e.g. of a 2D embedding)
+     * @param widgetToIndex Transform from target widget coordinates to the coordinate frame of the spatial index
+     * @return Point indices in ascending order
+     */
+    SpatialIndex2D::Indices getSelectedPointIndices(const SpatialIndex2D& spatialIndex, const QTransform& widgetToIndex) const;
+
     /** Updates the pixel selection tool (wraps internal paint method) */
     void update();
 
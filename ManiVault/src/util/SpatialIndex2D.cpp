@@ -0,0 +1,595 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "SpatialIndex2D.h"
+
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mv::util {
+
+namespace
+{
+    /** Upper bound for the number of grid columns/rows */
+    constexpr std::uint32_t maximumGridResolution = 4096;
+
+    /** Cell classification with respect to a query shape */
+    enum class CellCoverage
+    {
+        Outside,        /** Cell does not overlap the shape */
+        Inside,         /** Cell lies completely inside the shape */
+        Intersecting    /** Cell straddles the boundary of the shape, points need to be tested individually */
+    };
+
+    /** Inclusive range of grid cells */
+    struct CellRange
+    {
+        std::int32_t    _columnBegin;
+        std::int32_t    _columnEnd;
+        std::int32_t    _rowBegin;
+        std::int32_t    _rowEnd;
+    };
+
+    bool isFinite(const Vector2f& position)
+    {
+        return std::isfinite(position.x) && std::isfinite(position.y);
+    }
+
+    std::int32_t getColumn(const SpatialIndex2D::Grid& grid, float x)
+    {
+        return std::clamp(static_cast<std::int32_t>(std::floor((x - grid._bounds.getLeft()) / grid._cellWidth)), 0, static_cast<std::int32_t>(grid._numberOfColumns) - 1);
+    }
+
+    std::int32_t getRow(const SpatialIndex2D::Grid& grid, float y)
+    {
+        return std::clamp(static_cast<std::int32_t>(std::floor((y - grid._bounds.getBottom()) / grid._cellHeight)), 0, static_cast<std::int32_t>(grid._numberOfRows) - 1);
+    }
+
+    /** Get the cells overlapped by \p queryBounds, returns false when the query does not overlap the grid */
+    bool getCellRange(const SpatialIndex2D::Grid& grid, const Bounds& queryBounds, CellRange& cellRange)
+    {
+        if (queryBounds.getRight() < grid._bounds.getLeft() || queryBounds.getLeft() > grid._bounds.getRight())
+            return false;
+
+        if (queryBounds.getTop() < grid._bounds.getBottom() || queryBounds.getBottom() > grid._bounds.getTop())
+            return false;
+
+        cellRange._columnBegin  = getColumn(grid, queryBounds.getLeft());
+        cellRange._columnEnd    = getColumn(grid, queryBounds.getRight());
+        cellRange._rowBegin     = getRow(grid, queryBounds.getBottom());
+        cellRange._rowEnd       = getRow(grid, queryBounds.getTop());
+
+        return true;
+    }
+
+    Bounds getCellBounds(const SpatialIndex2D::Grid& grid, std::int32_t column, std::int32_t row)
+    {
+        const auto left     = grid._bounds.getLeft() + static_cast<float>(column) * grid._cellWidth;
+        const auto bottom   = grid._bounds.getBottom() + static_cast<float>(row) * grid._cellHeight;
+
+        return { left, left + grid._cellWidth, bottom, bottom + grid._cellHeight };
+    }
+
+    /**
+     * Visit the points of \p grid in \p cellRange which are inside a shape
+     * @param grid Grid acceleration structure
+     * @param cellRange Cells overlapped by the bounds of the shape
+     * @param classifyCell Returns the coverage of a cell (by column and row) by the shape
+     * @param isInside Returns whether a point is inside the shape
+     * @param visitor Invoked with the original index of each point inside the shape
+     */
+    template<typename ClassifyCell, typename IsInside, typename Visitor>
+    void visitGrid(const SpatialIndex2D::Grid& grid, const CellRange& cellRange, ClassifyCell classifyCell, IsInside isInside, Visitor visitor)
+    {
+        for (auto row = cellRange._rowBegin; row <= cellRange._rowEnd; ++row) {
+            for (auto column = cellRange._columnBegin; column <= cellRange._columnEnd; ++column) {
+                const auto cellIndex    = static_cast<std::size_t>(row) * grid._numberOfColumns + column;
+                const auto begin        = grid._cellOffsets[cellIndex];
+                const auto end          = grid._cellOffsets[cellIndex + 1];
+
+                if (begin == end)
+                    continue;
+
+                switch (classifyCell(column, row)) {
+                    case CellCoverage::Outside:
+                        break;
+
+                    case CellCoverage::Inside:
+                    {
+                        for (auto pointOffset = begin; pointOffset < end; ++pointOffset)
+                            visitor(grid._indices[pointOffset]);
+
+                        break;
+                    }
+
+                    case CellCoverage::Intersecting:
+                    {
+                        for (auto pointOffset = begin; pointOffset < end; ++pointOffset)
+                            if (isInside(grid._positions[pointOffset]))
+                                visitor(grid._indices[pointOffset]);
+
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    bool isInsideRectangle(const Bounds& rectangle, const Vector2f& position)
+    {
+        return position.x >= rectangle.getLeft() && position.x <= rectangle.getRight() && position.y >= rectangle.getBottom() && position.y <= rectangle.getTop();
+    }
+
+    Bounds getPolygonBounds(const std::vector<Vector2f>& polygon)
+    {
+        auto left   = std::numeric_limits<float>::max();
+        auto right  = std::numeric_limits<float>::lowest();
+        auto bottom = std::numeric_limits<float>::max();
+        auto top    = std::numeric_limits<float>::lowest();
+
+        for (const auto& vertex : polygon) {
+            left    = std::min(left, vertex.x);
+            right   = std::max(right, vertex.x);
+            bottom  = std::min(bottom, vertex.y);
+            top     = std::max(top, vertex.y);
+        }
+
+        return { left, right, bottom, top };
+    }
+
+    /** Visits the points inside a rectangle */
+    template<typename Visitor>
+    void visitRectangle(const std::vector<Vector2f>& positions, const SpatialIndex2D::Grid* grid, const Bounds& rectangle, Visitor visitor)
+    {
+        if (grid == nullptr) {
+            for (std::uint32_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex)
+                if (isInsideRectangle(rectangle, positions[pointIndex]))
+                    visitor(pointIndex);
+
+            return;
+        }
+
+        CellRange cellRange;
+
+        if (!getCellRange(*grid, rectangle, cellRange))
+            return;
+
+        const auto classifyCell = [grid, &rectangle](std::int32_t column, std::int32_t row) -> CellCoverage {
+            const auto cellBounds = getCellBounds(*grid, column, row);
+
+            if (cellBounds.getLeft() >= rectangle.getLeft() && cellBounds.getRight() <= rectangle.getRight() && cellBounds.getBottom() >= rectangle.getBottom() && cellBounds.getTop() <= rectangle.getTop())
+                return CellCoverage::Inside;
+
+            return CellCoverage::Intersecting;
+        };
+
+        visitGrid(*grid, cellRange, classifyCell, [&rectangle](const Vector2f& position) -> bool { return isInsideRectangle(rectangle, position); }, visitor);
+    }
+
+    /** Visits the points inside a circle */
+    template<typename Visitor>
+    void visitCircle(const std::vector<Vector2f>& positions, const SpatialIndex2D::Grid* grid, const Vector2f& center, float radius, Visitor visitor)
+    {
+        const auto radiusSquared = radius * radius;
+
+        const auto isInside = [&center, radiusSquared](const Vector2f& position) -> bool {
+            const auto dx = position.x - center.x;
+            const auto dy = position.y - center.y;
+
+            return dx * dx + dy * dy <= radiusSquared;
+        };
+
+        if (grid == nullptr) {
+            for (std::uint32_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex)
+                if (isInside(positions[pointIndex]))
+                    visitor(pointIndex);
+
+            return;
+        }
+
+        CellRange cellRange;
+
+        if (!getCellRange(*grid, Bounds(center.x - radius, center.x + radius, center.y - radius, center.y + radius), cellRange))
+            return;
+
+        const auto classifyCell = [grid, &center, radiusSquared](std::int32_t column, std::int32_t row) -> CellCoverage {
+            const auto cellBounds = getCellBounds(*grid, column, row);
+
+            // Distance from the center to the nearest point of the cell
+            const auto nearestX = std::clamp(center.x, cellBounds.getLeft(), cellBounds.getRight()) - center.x;
+            const auto nearestY = std::clamp(center.y, cellBounds.getBottom(), cellBounds.getTop()) - center.y;
+
+            if (nearestX * nearestX + nearestY * nearestY > radiusSquared)
+                return CellCoverage::Outside;
+
+            // Distance from the center to the farthest corner of the cell
+            const auto farthestX = std::max(std::abs(cellBounds.getLeft() - center.x), std::abs(cellBounds.getRight() - center.x));
+            const auto farthestY = std::max(std::abs(cellBounds.getBottom() - center.y), std::abs(cellBounds.getTop() - center.y));
+
+            if (farthestX * farthestX + farthestY * farthestY <= radiusSquared)
+                return CellCoverage::Inside;
+
+            return CellCoverage::Intersecting;
+        };
+
+        visitGrid(*grid, cellRange, classifyCell, isInside, visitor);
+    }
+
+    /** Visits the points inside a polygon */
+    template<typename Visitor>
+    void visitPolygon(const std::vector<Vector2f>& positions, const SpatialIndex2D::Grid* grid, const std::vector<Vector2f>& polygon, Visitor visitor)
+    {
+        if (polygon.size() < 3)
+            return;
+
+        const auto isInside = [&polygon](const Vector2f& position) -> bool {
+            return SpatialIndex2D::isInsidePolygon(polygon, position);
+        };
+
+        if (grid == nullptr) {
+            for (std::uint32_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex)
+                if (isInside(positions[pointIndex]))
+                    visitor(pointIndex);
+
+            return;
+        }
+
+        CellRange cellRange;
+
+        if (!getCellRange(*grid, getPolygonBounds(polygon), cellRange))
+            return;
+
+        const auto numberOfRangeColumns = static_cast<std::size_t>(cellRange._columnEnd - cellRange._columnBegin + 1);
+        const auto numberOfRangeRows    = static_cast<std::size_t>(cellRange._rowEnd - cellRange._rowBegin + 1);
+
+        // Conservatively flag the cells crossed by the polygon edges (the bounding box of each edge), only these cells need per-point tests
+        std::vector<CellCoverage> cellCoverage(numberOfRangeColumns * numberOfRangeRows, CellCoverage::Outside);
+
+        for (std::size_t vertexIndex = 0; vertexIndex < polygon.size(); ++vertexIndex) {
+            const auto& vertexA = polygon[vertexIndex];
+            const auto& vertexB = polygon[(vertexIndex + 1) % polygon.size()];
+
+            const auto columnBegin  = getColumn(*grid, std::min(vertexA.x, vertexB.x));
+            const auto columnEnd    = getColumn(*grid, std::max(vertexA.x, vertexB.x));
+            const auto rowBegin     = getRow(*grid, std::min(vertexA.y, vertexB.y));
+            const auto rowEnd       = getRow(*grid, std::max(vertexA.y, vertexB.y));
+
+            for (auto row = std::max(rowBegin, cellRange._rowBegin); row <= std::min(rowEnd, cellRange._rowEnd); ++row)
+                for (auto column = std::max(columnBegin, cellRange._columnBegin); column <= std::min(columnEnd, cellRange._columnEnd); ++column)
+                    cellCoverage[(row - cellRange._rowBegin) * numberOfRangeColumns + (column - cellRange._columnBegin)] = CellCoverage::Intersecting;
+        }
+
+        // Cells which are not crossed by an edge are either completely inside or outside, and consecutive such cells in a row share the same status
+        for (std::size_t rangeRow = 0; rangeRow < numberOfRangeRows; ++rangeRow) {
+            bool runIsKnown = false;
+            auto runCoverage = CellCoverage::Outside;
+
+            for (std::size_t rangeColumn = 0; rangeColumn < numberOfRangeColumns; ++rangeColumn) {
+                auto& coverage = cellCoverage[rangeRow * numberOfRangeColumns + rangeColumn];
+
+                if (coverage == CellCoverage::Intersecting) {
+                    runIsKnown = false;
+                    continue;
+                }
+
+                if (!runIsKnown) {
+                    const auto column       = static_cast<std::int32_t>(rangeColumn) + cellRange._columnBegin;
+                    const auto row          = static_cast<std::int32_t>(rangeRow) + cellRange._rowBegin;
+                    const auto cellCenter   = getCellBounds(*grid, column, row).getCenter();
+
+                    runCoverage = isInside(cellCenter) ? CellCoverage::Inside : CellCoverage::Outside;
+                    runIsKnown  = true;
+                }
+
+                coverage = runCoverage;
+            }
+        }
+
+        const auto classifyCell = [&cellCoverage, &cellRange, numberOfRangeColumns](std::int32_t column, std::int32_t row) -> CellCoverage {
+            return cellCoverage[(row - cellRange._rowBegin) * numberOfRangeColumns + (column - cellRange._columnBegin)];
+        };
+
+        visitGrid(*grid, cellRange, classifyCell, isInside, visitor);
+    }
+}
+
+SpatialIndex2D::SpatialIndex2D() :
+    _state(std::make_shared<State>())
+{
+}
+
+void SpatialIndex2D::build(const std::vector<Vector2f>& positions, bool async /*= false*/, std::uint32_t targetNumberOfPointsPerCell /*= 16*/)
+{
+    auto positionsCopy = std::make_shared<const std::vector<Vector2f>>(positions);
+
+    std::uint64_t generation = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+
+        generation = ++_state->_generation;
+
+        _state->_positions  = positionsCopy;
+        _state->_grid       = nullptr;
+        _state->_building   = async;
+    }
+
+    if (!async) {
+        // A synchronous build supersedes a pending background build, so threads waiting for it have to be released
+        _state->_buildFinished.notify_all();
+
+        auto grid = buildGrid(*positionsCopy, targetNumberOfPointsPerCell);
+
+        {
+            std::lock_guard<std::mutex> lock(_state->_mutex);
+
+            if (_state->_generation == generation)
+                _state->_grid = grid;
+        }
+
+        _state->_buildFinished.notify_all();
+
+        return;
+    }
+
+    // The job only holds on to the shared state, so the index may be destroyed or rebuilt while the job is running
+    QThreadPool::globalInstance()->start([state = _state, positionsCopy, generation, targetNumberOfPointsPerCell]() -> void {
+        auto grid = buildGrid(*positionsCopy, targetNumberOfPointsPerCell);
+
+        {
+            std::lock_guard<std::mutex> lock(state->_mutex);
+
+            // A superseded build discards its grid (the waiters are notified regardless and re-check whether a build is pending)
+            if (state->_generation == generation) {
+                state->_grid        = grid;
+                state->_building    = false;
+            }
+        }
+
+        state->_buildFinished.notify_all();
+    });
+}
+
+void SpatialIndex2D::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+
+        ++_state->_generation;
+
+        _state->_positions  = nullptr;
+        _state->_grid       = nullptr;
+        _state->_building   = false;
+    }
+
+    _state->_buildFinished.notify_all();
+}
+
+bool SpatialIndex2D::isBuilt() const
+{
+    std::lock_guard<std::mutex> lock(_state->_mutex);
+
+    return _state->_grid != nullptr;
+}
+
+void SpatialIndex2D::waitForBuild() const
+{
+    std::unique_lock<std::mutex> lock(_state->_mutex);
+
+    _state->_buildFinished.wait(lock, [this]() -> bool { return !_state->_building; });
+}
+
+std::uint32_t SpatialIndex2D::getNumberOfPoints() const
+{
+    std::lock_guard<std::mutex> lock(_state->_mutex);
+
+    return _state->_positions ? static_cast<std::uint32_t>(_state->_positions->size()) : 0;
+}
+
+SpatialIndex2D::Indices SpatialIndex2D::queryRectangle(const Bounds& rectangle) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    Indices indices;
+
+    if (positions)
+        visitRectangle(*positions, grid.get(), rectangle, [&indices](std::uint32_t pointIndex) -> void { indices.push_back(pointIndex); });
+
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
+}
+
+SpatialIndex2D::Indices SpatialIndex2D::queryCircle(const Vector2f& center, float radius) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    Indices indices;
+
+    if (positions)
+        visitCircle(*positions, grid.get(), center, radius, [&indices](std::uint32_t pointIndex) -> void { indices.push_back(pointIndex); });
+
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
+}
+
+SpatialIndex2D::Indices SpatialIndex2D::queryPolygon(const std::vector<Vector2f>& polygon) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    Indices indices;
+
+    if (positions)
+        visitPolygon(*positions, grid.get(), polygon, [&indices](std::uint32_t pointIndex) -> void { indices.push_back(pointIndex); });
+
+    std::sort(indices.begin(), indices.end());
+
+    return indices;
+}
+
+void SpatialIndex2D::selectRectangle(const Bounds& rectangle, Mask& mask) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    if (!positions)
+        return;
+
+    if (mask.size() < positions->size())
+        mask.resize(positions->size(), false);
+
+    visitRectangle(*positions, grid.get(), rectangle, [&mask](std::uint32_t pointIndex) -> void { mask[pointIndex] = true; });
+}
+
+void SpatialIndex2D::selectCircle(const Vector2f& center, float radius, Mask& mask) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    if (!positions)
+        return;
+
+    if (mask.size() < positions->size())
+        mask.resize(positions->size(), false);
+
+    visitCircle(*positions, grid.get(), center, radius, [&mask](std::uint32_t pointIndex) -> void { mask[pointIndex] = true; });
+}
+
+void SpatialIndex2D::selectPolygon(const std::vector<Vector2f>& polygon, Mask& mask) const
+{
+    const auto [positions, grid] = getSnapshot();
+
+    if (!positions)
+        return;
+
+    if (mask.size() < positions->size())
+        mask.resize(positions->size(), false);
+
+    visitPolygon(*positions, grid.get(), polygon, [&mask](std::uint32_t pointIndex) -> void { mask[pointIndex] = true; });
+}
+
+bool SpatialIndex2D::isInsidePolygon(const std::vector<Vector2f>& polygon, const Vector2f& point)
+{
+    bool inside = false;
+
+    for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const auto& vertexI = polygon[i];
+        const auto& vertexJ = polygon[j];
+
+        if (((vertexI.y > point.y) != (vertexJ.y > point.y)) && (point.x < (vertexJ.x - vertexI.x) * (point.y - vertexI.y) / (vertexJ.y - vertexI.y) + vertexI.x))
+            inside = !inside;
+    }
+
+    return inside;
+}
+
+std::shared_ptr<const SpatialIndex2D::Grid> SpatialIndex2D::buildGrid(const std::vector<Vector2f>& positions, std::uint32_t targetNumberOfPointsPerCell)
+{
+    auto grid = std::make_shared<Grid>();
+
+    auto left   = std::numeric_limits<float>::max();
+    auto right  = std::numeric_limits<float>::lowest();
+    auto bottom = std::numeric_limits<float>::max();
+    auto top    = std::numeric_limits<float>::lowest();
+
+    std::uint32_t numberOfFinitePoints = 0;
+
+    for (const auto& position : positions) {
+        if (!isFinite(position))
+            continue;
+
+        left    = std::min(left, position.x);
+        right   = std::max(right, position.x);
+        bottom  = std::min(bottom, position.y);
+        top     = std::max(top, position.y);
+
+        ++numberOfFinitePoints;
+    }
+
+    if (numberOfFinitePoints == 0) {
+        grid->_numberOfColumns  = 1;
+        grid->_numberOfRows     = 1;
+        grid->_cellOffsets      = { 0, 0 };
+
+        return grid;
+    }
+
+    const auto width    = right - left;
+    const auto height   = top - bottom;
+
+    const auto targetNumberOfCells = std::max<double>(1.0, static_cast<double>(numberOfFinitePoints) / std::max(1u, targetNumberOfPointsPerCell));
+
+    std::uint32_t numberOfColumns = 1, numberOfRows = 1;
+
+    if (width > 0.f && height > 0.f) {
+        numberOfColumns = static_cast<std::uint32_t>(std::clamp(std::round(std::sqrt(targetNumberOfCells * width / height)), 1.0, static_cast<double>(maximumGridResolution)));
+        numberOfRows    = static_cast<std::uint32_t>(std::clamp(std::ceil(targetNumberOfCells / numberOfColumns), 1.0, static_cast<double>(maximumGridResolution)));
+    }
+    else if (width > 0.f) {
+        numberOfColumns = static_cast<std::uint32_t>(std::min(targetNumberOfCells, static_cast<double>(maximumGridResolution)));
+    }
+    else if (height > 0.f) {
+        numberOfRows = static_cast<std::uint32_t>(std::min(targetNumberOfCells, static_cast<double>(maximumGridResolution)));
+    }
+
+    grid->_bounds.setBounds(left, right, bottom, top);
+
+    grid->_numberOfColumns  = numberOfColumns;
+    grid->_numberOfRows     = numberOfRows;
+    grid->_cellWidth        = width > 0.f ? width / numberOfColumns : 1.f;
+    grid->_cellHeight       = height > 0.f ? height / numberOfRows : 1.f;
+
+    const auto numberOfCells = static_cast<std::size_t>(numberOfColumns) * numberOfRows;
+
+    // Counting sort of the points by cell
+    std::vector<std::uint32_t> pointCells(positions.size(), static_cast<std::uint32_t>(numberOfCells));
+
+    grid->_cellOffsets.assign(numberOfCells + 1, 0);
+
+    for (std::size_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex) {
+        const auto& position = positions[pointIndex];
+
+        if (!isFinite(position))
+            continue;
+
+        const auto cellIndex = static_cast<std::uint32_t>(getRow(*grid, position.y) * numberOfColumns + getColumn(*grid, position.x));
+
+        pointCells[pointIndex] = cellIndex;
+
+        ++grid->_cellOffsets[cellIndex + 1];
+    }
+
+    for (std::size_t cellIndex = 0; cellIndex < numberOfCells; ++cellIndex)
+        grid->_cellOffsets[cellIndex + 1] += grid->_cellOffsets[cellIndex];
+
+    grid->_positions.resize(numberOfFinitePoints);
+    grid->_indices.resize(numberOfFinitePoints);
+
+    std::vector<std::uint32_t> cellCursors(grid->_cellOffsets.begin(), grid->_cellOffsets.end() - 1);
+
+    for (std::size_t pointIndex = 0; pointIndex < positions.size(); ++pointIndex) {
+        const auto cellIndex = pointCells[pointIndex];
+
+        if (cellIndex == numberOfCells)
+            continue;
+
+        const auto target = cellCursors[cellIndex]++;
+
+        grid->_positions[target]    = positions[pointIndex];
+        grid->_indices[target]      = static_cast<std::uint32_t>(pointIndex);
+    }
+
+    return grid;
+}
+
+std::pair<std::shared_ptr<const std::vector<Vector2f>>, std::shared_ptr<const SpatialIndex2D::Grid>> SpatialIndex2D::getSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(_state->_mutex);
+
+    return { _state->_positions, _state->_grid };
+}
+
+}
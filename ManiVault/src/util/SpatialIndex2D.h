@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include "graphics/Bounds.h"
+#include "graphics/Vector2f.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mv::util {
+
+/**
+ * Spatial index 2D class
+ *
+ * Uniform grid over a 2D point embedding for answering rectangle, brush (circle) and polygon (lasso) selection
+ * queries in time proportional to the number of selected points (plus the number of grid cells touched by the
+ * query shape), instead of testing every point of the embedding.
+ *
+ * Points are bucketed per grid cell with a counting sort, positions are stored in cell order so that queries read
+ * contiguous memory. Cells which lie completely inside the query shape are accepted without per-point tests.
+ *
+ * The index can be built synchronously or in a background thread; queries issued while a background build
+ * is still in progress fall back to a linear scan, so results are always correct.
+ *
+ * Points with non-finite coordinates are never selected.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT SpatialIndex2D
+{
+public:
+
+    using Indices   = std::vector<std::uint32_t>;   /** Point indices */
+    using Mask      = std::vector<bool>;            /** Per-point selection bitmap */
+
+    /** Grid cell acceleration structure (immutable once built) */
+    struct Grid
+    {
+        Bounds                      _bounds;                /** Bounds of the finite points */
+        std::uint32_t               _numberOfColumns = 0;   /** Number of grid columns */
+        std::uint32_t               _numberOfRows = 0;      /** Number of grid rows */
+        float                       _cellWidth = 1.f;       /** Width of a grid cell */
+        float                       _cellHeight = 1.f;      /** Height of a grid cell */
+        std::vector<std::uint32_t>  _cellOffsets;           /** Offset of the first point of each cell (size is number of cells + 1) */
+        std::vector<Vector2f>       _positions;             /** Point positions in cell order */
+        std::vector<std::uint32_t>  _indices;               /** Original point indices in cell order */
+    };
+
+public:
+
+    /** Default constructor */
+    SpatialIndex2D();
+
+    /**
+     * Build the index for \p positions (replaces any previous index)
+     * @param positions Point positions of the embedding
+     * @param async Build the grid in a background thread (queries fall back to a linear scan until it is finished)
+     * @param targetNumberOfPointsPerCell Average number of points per grid cell to aim for
+     */
+    void build(const std::vector<Vector2f>& positions, bool async = false, std::uint32_t targetNumberOfPointsPerCell = 16);
+
+    /** Remove all points from the index */
+    void clear();
+
+    /**
+     * Get whether the grid acceleration structure is built (always false for an empty index)
+     * @return Boolean determining whether the grid is available for queries
+     */
+    bool isBuilt() const;
+
+    /**
+     * Block until a pending background build is finished
+     */
+    void waitForBuild() const;
+
+    /**
+     * Get number of indexed points
+     * @return Number of points
+     */
+    std::uint32_t getNumberOfPoints() const;
+
+public: // Queries
+
+    /**
+     * Get indices of the points inside \p rectangle (in the coordinate frame of the positions)
+     * @param rectangle Query rectangle
+     * @return Point indices in ascending order
+     */
+    Indices queryRectangle(const Bounds& rectangle) const;
+
+    /**
+     * Get indices of the points inside the circle with \p center and \p radius (e.g. a selection brush)
+     * @param center Center of the circle
+     * @param radius Radius of the circle
+     * @return Point indices in ascending order
+     */
+    Indices queryCircle(const Vector2f& center, float radius) const;
+
+    /**
+     * Get indices of the points inside \p polygon (even-odd rule, implicitly closed)
+     * @param polygon Polygon (e.g. lasso) vertices
+     * @return Point indices in ascending order
+     */
+    Indices queryPolygon(const std::vector<Vector2f>& polygon) const;
+
+    /**
+     * Set \p mask to true for the points inside \p rectangle (\p mask is resized to the number of points if needed)
+     * @param rectangle Query rectangle
+     * @param mask Selection bitmap
+     */
+    void selectRectangle(const Bounds& rectangle, Mask& mask) const;
+
+    /**
+     * Set \p mask to true for the points inside the circle with \p center and \p radius (\p mask is resized to the number of points if needed)
+     * @param center Center of the circle
+     * @param radius Radius of the circle
+     * @param mask Selection bitmap
+     */
+    void selectCircle(const Vector2f& center, float radius, Mask& mask) const;
+
+    /**
+     * Set \p mask to true for the points inside \p polygon (\p mask is resized to the number of points if needed)
+     * @param polygon Polygon (e.g. lasso) vertices
+     * @param mask Selection bitmap
+     */
+    void selectPolygon(const std::vector<Vector2f>& polygon, Mask& mask) const;
+
+public: // Geometry helpers
+
+    /**
+     * Determine whether \p point lies inside \p polygon (even-odd rule)
+     * @param polygon Polygon vertices
+     * @param point Point to test
+     * @return Boolean determining whether the point is inside
+     */
+    static bool isInsidePolygon(const std::vector<Vector2f>& polygon, const Vector2f& point);
+
+    /**
+     * Build grid acceleration structure for \p positions
+     * @param positions Point positions
+     * @param targetNumberOfPointsPerCell Average number of points per grid cell to aim for
+     * @return Shared pointer to grid
+     */
+    static std::shared_ptr<const Grid> buildGrid(const std::vector<Vector2f>& positions, std::uint32_t targetNumberOfPointsPerCell);
+
+private:
+
+    /** Shared state between the index and a possible background build */
+    struct State
+    {
+        mutable std::mutex                              _mutex;             /** Guards the members below */
+        std::uint64_t                                   _generation = 0;    /** Incremented on each (re)build so that stale background builds are discarded */
+        std::shared_ptr<const std::vector<Vector2f>>    _positions;             /** Positions in original order (for the linear scan fallback) */
+        std::shared_ptr<const Grid>                     _grid;              /** Grid acceleration structure, nullptr while not built */
+        bool                                            _building = false;  /** Whether a background build is pending */
+        mutable std::condition_variable                 _buildFinished;     /** Notified when a background build finishes */
+    };
+
+    /**
+     * Get a consistent snapshot of the positions and grid
+     * @return Pair of positions and grid (grid is nullptr while it is being built)
+     */
+    std::pair<std::shared_ptr<const std::vector<Vector2f>>, std::shared_ptr<const Grid>> getSnapshot() const;
+
+private:
+    std::shared_ptr<State>  _state;     /** Shared index state */
+};
+
+}
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "Spillable.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace mv::util {
+
+namespace
+{
+    /** Global spillables registry */
+    struct SpillablesRegistry
+    {
+        std::mutex                  _mutex;             /** Guards the spillables */
+        std::vector<Spillable*>     _spillables;        /** Registered spillables */
+        std::atomic<std::uint64_t>  _accessClock = 1;   /** Coarse access clock */
+    };
+
+    /**
+     * Get the global spillables registry (intentionally leaked, spillables may unregister during static destruction)
+     * @return Spillables registry
+     */
+    SpillablesRegistry& getSpillablesRegistry()
+    {
+        static auto* spillablesRegistry = new SpillablesRegistry();
+
+        return *spillablesRegistry;
+    }
+}
+
+Spillable::Pin::Pin(Spillable& spillable) :
+    _spillable(spillable)
+{
+    _spillable._pinCount.fetch_add(1, std::memory_order_acq_rel);
+
+    try {
+        _spillable.reload();
+    }
+    catch (...) {
+        _spillable._pinCount.fetch_sub(1, std::memory_order_acq_rel);
+        throw;
+    }
+}
+
+Spillable::Pin::~Pin()
+{
+    _spillable._pinCount.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+Spillable::Spillable() :
+    _lastAccessTick(getAccessClock()),
+    _pinCount(0)
+{
+}
+
+Spillable::~Spillable()
+{
+    unregisterSpillable();
+}
+
+void Spillable::touch() const
+{
+    const auto accessClock = getAccessClock();
+
+    if (_lastAccessTick.load(std::memory_order_relaxed) != accessClock)
+        _lastAccessTick.store(accessClock, std::memory_order_relaxed);
+}
+
+std::uint64_t Spillable::getLastAccessTick() const
+{
+    return _lastAccessTick.load(std::memory_order_relaxed);
+}
+
+bool Spillable::isPinned() const
+{
+    return _pinCount.load(std::memory_order_acquire) > 0;
+}
+
+void Spillable::visitSpillables(const VisitFunction& visitFunction)
+{
+    auto& registry = getSpillablesRegistry();
+
+    std::lock_guard<std::mutex> lock(registry._mutex);
+
+    visitFunction(registry._spillables);
+}
+
+std::uint64_t Spillable::advanceAccessClock()
+{
+    return getSpillablesRegistry()._accessClock.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+std::uint64_t Spillable::getAccessClock()
+{
+    return getSpillablesRegistry()._accessClock.load(std::memory_order_relaxed);
+}
+
+void Spillable::registerSpillable()
+{
+    auto& registry = getSpillablesRegistry();
+
+    std::lock_guard<std::mutex> lock(registry._mutex);
+
+    if (std::find(registry._spillables.begin(), registry._spillables.end(), this) == registry._spillables.end())
+        registry._spillables.push_back(this);
+}
+
+void Spillable::unregisterSpillable()
+{
+    auto& registry = getSpillablesRegistry();
+
+    std::lock_guard<std::mutex> lock(registry._mutex);
+
+    registry._spillables.erase(std::remove(registry._spillables.begin(), registry._spillables.end(), this), registry._spillables.end());
+}
+
+}
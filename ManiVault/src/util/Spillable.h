@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QString>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace mv::util {
+
+/**
+ * Spillable class
+ *
+ * Interface for memory which the memory manager (see AbstractMemoryManager) may spill to disk when the memory
+ * budget is exceeded. The owner reloads spilled memory transparently when it is accessed, and marks each access
+ * with Spillable::touch() so that the least recently used memory is spilled first. Accesses are stamped with a
+ * coarse access clock (advanced by the memory manager), which keeps Spillable::touch() cheap enough for hot paths.
+ *
+ * Spillable memory is never spilled while it is pinned: hold a Spillable::Pin when pointers into the memory are
+ * used beyond a single access (e.g. by a worker thread).
+ *
+ * Owners register with Spillable::registerSpillable() once they are fully constructed and must call
+ * Spillable::unregisterSpillable() at the start of their destructor.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT Spillable
+{
+public:
+
+    /**
+     * Pin class
+     *
+     * Prevents spilling of a spillable for its lifetime (and reloads it when spilled). The spillable is pinned before
+     * it is reloaded, so Spillable::reload() must wait for a spill which is in progress (see Spillable::spill()).
+     *
+     * @author Thomas Kroes
+     */
+    class CORE_EXPORT Pin
+    {
+    public:
+
+        /**
+         * Construct with \p spillable
+         * @param spillable Spillable to pin
+         */
+        explicit Pin(Spillable& spillable);
+
+        /** Unpins the spillable */
+        ~Pin();
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+    private:
+        Spillable&  _spillable;     /** Pinned spillable */
+    };
+
+    /** Function which is invoked with the registered spillables */
+    using VisitFunction = std::function<void(const std::vector<Spillable*>&)>;
+
+    /** Default constructor */
+    Spillable();
+
+    /** Unregisters the spillable (if the owner did not already) */
+    virtual ~Spillable();
+
+    Spillable(const Spillable&) = delete;
+    Spillable& operator=(const Spillable&) = delete;
+
+    /**
+     * Get the spill name (unique, used to identify the spillable and its spill file)
+     * @return Spill name
+     */
+    virtual QString getSpillName() const = 0;
+
+    /**
+     * Get the number of bytes which spilling frees
+     * @return Number of resident bytes (zero when spilled)
+     */
+    virtual std::uint64_t getNumberOfResidentBytes() const = 0;
+
+    /**
+     * Get whether the memory is spilled to disk
+     * @return Boolean determining whether the memory is spilled
+     */
+    virtual bool isSpilled() const = 0;
+
+    /**
+     * Spill the memory to \p filePath and release it (does nothing when already spilled or pinned, the pin state must
+     * be checked while holding the lock which Spillable::reload() takes)
+     * @param filePath Path of the spill file
+     * @return Boolean determining whether the memory was spilled
+     * @throws std::runtime_error when the spill file cannot be written
+     */
+    virtual bool spill(const QString& filePath) = 0;
+
+    /**
+     * Reload the memory when spilled, waits for a spill which is in progress (so that a pin which is taken while the
+     * memory is being spilled sees resident memory)
+     */
+    virtual void reload() = 0;
+
+    /** Mark the memory as accessed now */
+    void touch() const;
+
+    /**
+     * Get the access clock tick of the last access
+     * @return Access clock tick
+     */
+    std::uint64_t getLastAccessTick() const;
+
+    /**
+     * Get whether the spillable is pinned
+     * @return Boolean determining whether the spillable is pinned
+     */
+    bool isPinned() const;
+
+    /**
+     * Invoke \p visitFunction with the registered spillables (spillables cannot unregister during the visit)
+     * @param visitFunction Function to invoke
+     */
+    static void visitSpillables(const VisitFunction& visitFunction);
+
+    /**
+     * Advance the (coarse) access clock, accesses within the same tick are indistinguishable
+     * @return New access clock tick
+     */
+    static std::uint64_t advanceAccessClock();
+
+    /**
+     * Get the current access clock tick
+     * @return Access clock tick
+     */
+    static std::uint64_t getAccessClock();
+
+protected:
+
+    /** Register with the memory manager (call when the owner is fully constructed) */
+    void registerSpillable();
+
+    /** Unregister from the memory manager (call at the start of the owner destructor) */
+    void unregisterSpillable();
+
+private:
+    mutable std::atomic<std::uint64_t>  _lastAccessTick;    /** Access clock tick of the last access */
+    std::atomic<std::uint32_t>          _pinCount;          /** Number of pins */
+};
+
+}
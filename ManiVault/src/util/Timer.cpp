@@ -3,13 +3,15 @@
 // Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
 
 #include "Timer.h"
+#include "Trace.h"
 
 #include <QDebug>
 
 Timer::Timer(const QString& event /*= ""*/) :
     _event(event),
     _start(),
-    _eventStart()
+    _eventStart(),
+    _traceStart(!event.isEmpty() && mv::util::Tracer::isEnabled() ? mv::util::Tracer::now() : -1)
 {
     _start = std::chrono::steady_clock::now();
 
@@ -20,6 +22,9 @@ Timer::~Timer()
 {
     if (!_event.isEmpty())
         printTotalTime();
+
+    if (_traceStart >= 0)
+        mv::util::Tracer::recordSpan("timer", "Timer", _event, _traceStart, mv::util::Tracer::now());
 }
 
 std::int64_t Timer::elapsedTime(const SteadyClock& start) const
@@ -40,6 +45,11 @@ void Timer::printElapsedTime(const QString& event, const bool& reset /*= false*/
         this->reset();
 }
 
+float Timer::getElapsedTimeMilliseconds() const
+{
+    return elapsedTimeMilliseconds(_eventStart);
+}
+
 void Timer::reset()
 {
     _eventStart = std::chrono::steady_clock::now();
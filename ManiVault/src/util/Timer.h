@@ -18,6 +18,7 @@ using MilliSeconds  = std::chrono::microseconds;
  *
  * Helper class for timing events
  * When an instance of this class goes out of scope, it prints the elapsed time (prefixed by the event name)
+ * When tracing is enabled (see mv::util::Tracer), the lifetime of a named timer is also recorded as trace span
  *
  * Code inspired by: https://stackoverflow.com/questions/2808398/easily-measure-elapsed-time
  *
@@ -59,6 +60,12 @@ public: // Timer functions
      */
     void printElapsedTime(const QString& event, const bool& reset = false);
 
+    /**
+     * Returns the elapsed time since the last reset
+     * @return Elapsed time in milliseconds
+     */
+    float getElapsedTimeMilliseconds() const;
+
     /** Resets the start time of the timer */
     void reset();
 
@@ -71,4 +78,5 @@ private:
     QString         _event;             /** Name of the event */
     SteadyClock     _start;             /** Global start time */
     SteadyClock     _eventStart;        /** Event start time */
+    std::int64_t    _traceStart;        /** Trace span start time (negative when not traced) */
 };
\ No newline at end of file
@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#include "Trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace mv::util {
+
+namespace
+{
+    /** Recorded span */
+    struct TraceEvent
+    {
+        const char*     _category   = nullptr;  /** Span category */
+        const char*     _name       = nullptr;  /** Span name */
+        QString         _detail;                /** Span detail */
+        std::int64_t    _start      = 0;        /** Start time in nanoseconds since the tracer epoch */
+        std::int64_t    _end        = 0;        /** End time in nanoseconds since the tracer epoch */
+    };
+
+    /** Number of events per chunk of a thread buffer */
+    constexpr std::uint32_t numberOfEventsPerChunk = 4096;
+
+    /** Maximum number of chunks per thread buffer */
+    constexpr std::uint32_t maximumNumberOfChunks = Tracer::maximumNumberOfEventsPerThread / numberOfEventsPerChunk;
+
+    /** Fixed size block of events, chunks never move so the exporter can read them while the owning thread appends */
+    using TraceChunk = std::array<TraceEvent, numberOfEventsPerChunk>;
+
+    /**
+     * Per-thread event buffer
+     *
+     * Only the owning thread writes events; it publishes them by incrementing the number of events (release), the
+     * exporter reads the number of events (acquire) and then the published events. When the trace is cleared, the
+     * generation of the tracer is incremented and the owning thread rewinds its buffer before it appends a new event.
+     */
+    struct TraceBuffer
+    {
+        std::uint32_t                                               _threadIndex = 0;       /** Sequential thread index (exported as thread identifier) */
+        QString                                                     _threadName;            /** Thread name */
+        std::array<std::atomic<TraceChunk*>, maximumNumberOfChunks> _chunks = {};           /** Event chunks (allocated on demand) */
+        std::atomic<std::uint32_t>                                  _numberOfEvents = 0;    /** Number of published events */
+        std::atomic<std::uint64_t>                                  _generation = 0;        /** Tracer generation the events belong to */
+
+        /** Free the event chunks */
+        ~TraceBuffer()
+        {
+            for (auto& chunk : _chunks)
+                delete chunk.load();
+        }
+    };
+
+    /** Global tracer state */
+    struct TracerState
+    {
+        std::atomic<bool>                           _enabled = false;               /** Whether spans are recorded */
+        std::atomic<std::uint64_t>                  _generation = 0;                /** Incremented when the trace is cleared */
+        std::atomic<std::uint64_t>                  _numberOfDroppedSpans = 0;      /** Number of spans dropped because a buffer was full */
+        std::chrono::steady_clock::time_point       _epoch = std::chrono::steady_clock::now();  /** Trace time origin */
+        std::mutex                                  _mutex;                         /** Guards the buffers list, clearing and exporting */
+        std::vector<std::unique_ptr<TraceBuffer>>   _buffers;                       /** Buffers of all threads which recorded spans (outlive their thread) */
+    };
+
+    /**
+     * Get the global tracer state (intentionally leaked, spans may be recorded during static destruction)
+     * @return Tracer state
+     */
+    TracerState& getTracerState()
+    {
+        static auto* tracerState = new TracerState();
+
+        return *tracerState;
+    }
+
+    /**
+     * Get the buffer of the calling thread (registered with the tracer upon first use)
+     * @return Trace buffer
+     */
+    TraceBuffer& getThreadTraceBuffer()
+    {
+        thread_local TraceBuffer* traceBuffer = nullptr;
+
+        if (traceBuffer == nullptr) {
+            auto& tracerState = getTracerState();
+
+            auto newTraceBuffer = std::make_unique<TraceBuffer>();
+
+            const auto isMainThread = QCoreApplication::instance() != nullptr && QCoreApplication::instance()->thread() == QThread::currentThread();
+
+            std::lock_guard<std::mutex> lock(tracerState._mutex);
+
+            newTraceBuffer->_threadIndex    = static_cast<std::uint32_t>(tracerState._buffers.size()) + 1;
+            newTraceBuffer->_threadName     = isMainThread ? QString("Main thread") : QThread::currentThread()->objectName();
+            newTraceBuffer->_generation     = tracerState._generation.load();
+
+            if (newTraceBuffer->_threadName.isEmpty())
+                newTraceBuffer->_threadName = QString("Thread %1").arg(newTraceBuffer->_threadIndex);
+
+            traceBuffer = tracerState._buffers.emplace_back(std::move(newTraceBuffer)).get();
+        }
+
+        return *traceBuffer;
+    }
+
+    /**
+     * Append \p string to \p json as JSON string literal
+     * @param json Output JSON
+     * @param string String to escape
+     */
+    void appendJsonString(QByteArray& json, const QByteArray& string)
+    {
+        json.append('"');
+
+        for (const auto character : string) {
+            switch (character) {
+                case '"':   json.append("\\\"");    break;
+                case '\\':  json.append("\\\\");    break;
+                case '\n':  json.append("\\n");     break;
+                case '\r':  json.append("\\r");     break;
+                case '\t':  json.append("\\t");     break;
+
+                default:
+                {
+                    if (static_cast<unsigned char>(character) < 0x20)
+                        json.append(QString("\\u%1").arg(static_cast<int>(character), 4, 16, QChar('0')).toLatin1());
+                    else
+                        json.append(character);
+
+                    break;
+                }
+            }
+        }
+
+        json.append('"');
+    }
+
+    /**
+     * Convert trace time to Chrome trace time
+     * @param time Time in nanoseconds
+     * @return Time in microseconds
+     */
+    QByteArray toMicroseconds(std::int64_t time)
+    {
+        return QByteArray::number(static_cast<double>(time) / 1000.0, 'f', 3);
+    }
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    getTracerState()._enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Tracer::isEnabled()
+{
+    return getTracerState()._enabled.load(std::memory_order_relaxed);
+}
+
+void Tracer::clear()
+{
+    auto& tracerState = getTracerState();
+
+    std::lock_guard<std::mutex> lock(tracerState._mutex);
+
+    tracerState._generation++;
+    tracerState._numberOfDroppedSpans = 0;
+}
+
+std::int64_t Tracer::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - getTracerState()._epoch).count();
+}
+
+void Tracer::recordSpan(const char* category, const char* name, const QString& detail, std::int64_t start, std::int64_t end)
+{
+    auto& tracerState   = getTracerState();
+    auto& traceBuffer   = getThreadTraceBuffer();
+
+    const auto generation = tracerState._generation.load(std::memory_order_acquire);
+
+    // Rewind the buffer when the trace was cleared (the chunks are reused)
+    if (traceBuffer._generation.load(std::memory_order_relaxed) != generation) {
+        traceBuffer._numberOfEvents.store(0, std::memory_order_relaxed);
+        traceBuffer._generation.store(generation, std::memory_order_release);
+    }
+
+    const auto eventIndex = traceBuffer._numberOfEvents.load(std::memory_order_relaxed);
+
+    if (eventIndex >= maximumNumberOfEventsPerThread) {
+        tracerState._numberOfDroppedSpans.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& chunk = traceBuffer._chunks[eventIndex / numberOfEventsPerChunk];
+
+    if (chunk.load(std::memory_order_relaxed) == nullptr)
+        chunk.store(new TraceChunk(), std::memory_order_release);
+
+    auto& traceEvent = (*chunk.load(std::memory_order_relaxed))[eventIndex % numberOfEventsPerChunk];
+
+    traceEvent._category    = category;
+    traceEvent._name        = name;
+    traceEvent._detail      = detail;
+    traceEvent._start       = start;
+    traceEvent._end         = end;
+
+    traceBuffer._numberOfEvents.store(eventIndex + 1, std::memory_order_release);
+}
+
+std::uint64_t Tracer::getNumberOfDroppedSpans()
+{
+    return getTracerState()._numberOfDroppedSpans.load(std::memory_order_relaxed);
+}
+
+QByteArray Tracer::toChromeTraceJson()
+{
+    auto& tracerState = getTracerState();
+
+    std::lock_guard<std::mutex> lock(tracerState._mutex);
+
+    const auto generation   = tracerState._generation.load();
+    const auto processId    = QByteArray::number(QCoreApplication::applicationPid());
+
+    QByteArray json;
+
+    json.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    auto isFirstEvent = true;
+
+    const auto beginEvent = [&json, &isFirstEvent]() -> void {
+        if (!isFirstEvent)
+            json.append(",\n");
+
+        isFirstEvent = false;
+    };
+
+    for (const auto& traceBuffer : tracerState._buffers) {
+        const auto threadId = QByteArray::number(traceBuffer->_threadIndex);
+
+        beginEvent();
+
+        json.append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + processId + ",\"tid\":" + threadId + ",\"args\":{\"name\":");
+        appendJsonString(json, traceBuffer->_threadName.toUtf8());
+        json.append("}}");
+
+        // Skip buffers which have not been rewound since the last clear
+        if (traceBuffer->_generation.load(std::memory_order_acquire) != generation)
+            continue;
+
+        const auto numberOfEvents = traceBuffer->_numberOfEvents.load(std::memory_order_acquire);
+
+        for (std::uint32_t eventIndex = 0; eventIndex < numberOfEvents; eventIndex++) {
+            const auto& traceEvent = (*traceBuffer->_chunks[eventIndex / numberOfEventsPerChunk].load(std::memory_order_acquire))[eventIndex % numberOfEventsPerChunk];
+
+            beginEvent();
+
+            json.append("{\"ph\":\"X\",\"name\":");
+            appendJsonString(json, traceEvent._name);
+            json.append(",\"cat\":");
+            appendJsonString(json, traceEvent._category);
+            json.append(",\"ts\":" + toMicroseconds(traceEvent._start) + ",\"dur\":" + toMicroseconds(traceEvent._end - traceEvent._start));
+            json.append(",\"pid\":" + processId + ",\"tid\":" + threadId);
+
+            if (!traceEvent._detail.isEmpty()) {
+                json.append(",\"args\":{\"detail\":");
+                appendJsonString(json, traceEvent._detail.toUtf8());
+                json.append('}');
+            }
+
+            json.append('}');
+        }
+    }
+
+    json.append("],\"otherData\":{\"droppedSpans\":" + QByteArray::number(static_cast<qulonglong>(tracerState._numberOfDroppedSpans.load())) + "}}");
+
+    return json;
+}
+
+void Tracer::exportChromeTrace(const QString& filePath)
+{
+    QFile traceFile(filePath);
+
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        throw std::runtime_error(QString("Unable to open %1 for writing: %2").arg(filePath, traceFile.errorString()).toStdString());
+
+    const auto json = toChromeTraceJson();
+
+    if (traceFile.write(json) != json.size())
+        throw std::runtime_error(QString("Unable to write trace to %1: %2").arg(filePath, traceFile.errorString()).toStdString());
+}
+
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: LGPL-3.0-or-later 
+// A corresponding LICENSE file is located in the root directory of this source tree 
+// Copyright (C) 2023 BioVault (Biomedical Visual Analytics Unit LUMC - TU Delft) 
+
+#pragma once
+
+#include "ManiVaultGlobals.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+namespace mv::util {
+
+/**
+ * Tracer class
+ *
+ * Records timed spans (name, category, thread and optional detail) for performance analysis and exports
+ * them in the Chrome trace event format, which can be inspected with chrome://tracing or https://ui.perfetto.dev
+ *
+ * Each thread appends to its own buffer without locking, so spans can be recorded from worker threads
+ * as well. Recording is disabled by default; when disabled, a span costs a single relaxed atomic load.
+ * Each thread records at most Tracer::maximumNumberOfEventsPerThread spans per trace, excess spans are
+ * counted as dropped.
+ *
+ * Span names and categories are not copied and must therefore be string literals (or otherwise outlive
+ * the tracer), variable information goes into the span detail.
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT Tracer
+{
+public:
+
+    /** Maximum number of spans that a single thread records per trace */
+    static constexpr std::uint32_t maximumNumberOfEventsPerThread = 1 << 18;
+
+    /**
+     * Enable or disable recording of spans (spans which are in progress when disabled are still recorded)
+     * @param enabled Whether to record spans
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * Get whether spans are recorded
+     * @return Boolean determining whether spans are recorded
+     */
+    static bool isEnabled();
+
+    /** Discard all recorded spans */
+    static void clear();
+
+    /**
+     * Get the current trace time
+     * @return Time in nanoseconds since the tracer epoch
+     */
+    static std::int64_t now();
+
+    /**
+     * Record a span on the calling thread, for spans that do not fit a scope (e.g. the lifetime of a task)
+     * @param category Span category (string literal)
+     * @param name Span name (string literal)
+     * @param detail Span detail (exported as argument)
+     * @param start Start time in nanoseconds since the tracer epoch, see Tracer::now()
+     * @param end End time in nanoseconds since the tracer epoch, see Tracer::now()
+     */
+    static void recordSpan(const char* category, const char* name, const QString& detail, std::int64_t start, std::int64_t end);
+
+    /**
+     * Get the number of spans that were dropped because a thread buffer was full
+     * @return Number of dropped spans
+     */
+    static std::uint64_t getNumberOfDroppedSpans();
+
+    /**
+     * Get the recorded spans in the Chrome trace event (JSON) format
+     * @return Chrome trace JSON
+     */
+    static QByteArray toChromeTraceJson();
+
+    /**
+     * Export the recorded spans to \p filePath in the Chrome trace event (JSON) format
+     * @param filePath Path of the trace file
+     * @throws std::runtime_error when the file cannot be written
+     */
+    static void exportChromeTrace(const QString& filePath);
+};
+
+/**
+ * Trace span class
+ *
+ * Records the time between its construction and destruction as a span, when tracing is enabled at construction
+ *
+ * Use the MV_TRACE_SCOPE and MV_TRACE_SCOPE_DETAIL macros to trace a scope
+ *
+ * @author Thomas Kroes
+ */
+class CORE_EXPORT TraceSpan
+{
+public:
+
+    /**
+     * Construct with \p category and \p name
+     * @param category Span category (string literal)
+     * @param name Span name (string literal)
+     */
+    TraceSpan(const char* category, const char* name) :
+        _category(category),
+        _name(name),
+        _detail(),
+        _start(Tracer::isEnabled() ? Tracer::now() : -1)
+    {
+    }
+
+    /** Records the span (if active) */
+    ~TraceSpan()
+    {
+        if (isActive())
+            Tracer::recordSpan(_category, _name, _detail, _start, Tracer::now());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * Get whether the span is recorded
+     * @return Boolean determining whether the span is recorded
+     */
+    bool isActive() const {
+        return _start >= 0;
+    }
+
+    /**
+     * Set the span detail
+     * @param detail Span detail (exported as argument)
+     */
+    void setDetail(const QString& detail) {
+        _detail = detail;
+    }
+
+private:
+    const char*     _category;      /** Span category */
+    const char*     _name;          /** Span name */
+    QString         _detail;        /** Span detail */
+    std::int64_t    _start;         /** Start time in nanoseconds since the tracer epoch (negative when inactive) */
+};
+
+}
+
+#define MV_TRACE_CONCATENATE_IMPLEMENTATION(a, b) a##b
+#define MV_TRACE_CONCATENATE(a, b) MV_TRACE_CONCATENATE_IMPLEMENTATION(a, b)
+
+/** Trace the enclosing scope as span \p name in \p category */
+#define MV_TRACE_SCOPE(category, name) mv::util::TraceSpan MV_TRACE_CONCATENATE(traceSpan, __LINE__)(category, name)
+
+/** Trace the enclosing scope as span \p name in \p category, \p detail is only evaluated when tracing is enabled */
+#define MV_TRACE_SCOPE_DETAIL(category, name, detail) \
+    mv::util::TraceSpan MV_TRACE_CONCATENATE(traceSpan, __LINE__)(category, name); \
+    if (MV_TRACE_CONCATENATE(traceSpan, __LINE__).isActive()) MV_TRACE_CONCATENATE(traceSpan, __LINE__).setDetail(detail)
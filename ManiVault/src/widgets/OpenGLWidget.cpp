@@ -1,5 +1,7 @@
 #include "OpenGLWidget.h"
 
+#include "util/Trace.h"
+
 #include <QSurfaceFormat>
 #include <QWindow>
 #include <QScreen>
@@ -80,6 +82,8 @@ void OpenGLWidget::resizeGL(int w, int h)
 /** Function called by QOpenGLWidget when the widget was instructed to repaint. */
 void OpenGLWidget::paintGL()
 {
+    MV_TRACE_SCOPE_DETAIL("render", "Frame", objectName());
+
     onWidgetRendered();
 }
 